@@ -281,7 +281,80 @@ function activate(context) {
 
 	let createPackage = vscode.commands.registerCommand('exos-component-extension.createPackage', function (uri) {
 
-		function createComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, destination) {
+		/**
+		 * Select optional template features (C API, C Interface and C++ Class, only the process modes and the recorder for Python, only the process modes and the trace for JavaScript) and create the component
+		 */
+		function pickFeaturesAndCreateComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, destination) {
+			let pickFeatures = [];
+			let pickRecord = {label: "record", detail:"Recorder for received and published datasets (ring of memory mapped segment files), enabled with --record <path> in the .exospkg Runtime service, replayed without DMR with --replay <path>"};
+			let pickTrace = {label: "trace", detail:"Flight recorder of process(), received datasets, callbacks and publishes, dumped for Perfetto (Chrome Trace Event JSON) on SIGUSR1 or above a latency threshold, enabled with --trace <path>"};
+			pickFeatures.push({label: "process", detail:"Blocking, non-blocking and adaptive process modes, with the CPU load and the latency of received datasets measured in process() (exos_<type>_process.h)"});
+			if(selectedLinuxType.label == "Python Module" || selectedLinuxType.label == "JavaScript Module") {
+				if(selectedLinuxType.label == "Python Module") {
+					pickFeatures.push(pickRecord);
+				}
+				else {
+					pickFeatures.push({label: pickTrace.label, detail:`${pickTrace.detail}, traces the native side of the N-API module. SIGUSR1 no longer starts the Node.js inspector`});
+				}
+				vscode.window.showQuickPick(pickFeatures,{title:`Select optional features for the Linux template (none selected is default${selectedLinuxType.label == "JavaScript Module" ? ", recording and replay are not available for JavaScript" : ""})`, canPickMany:true}).then(selectedFeatures => {
+
+					if(!selectedFeatures)
+						return;
+
+					pickBuildProfileAndCreateComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, destination, selectedFeatures);
+				});
+				return;
+			}
+
+			if(selectedLinuxType.label != "C API") {
+				pickFeatures.push({label: "soa", detail:"Structure-of-arrays mirrors for datasets that are arrays of structures"});
+				pickFeatures.push(pickRecord);
+				pickFeatures.push({label: "mirror", detail:"Latest value of every dataset in shared memory, read lock-free by other processes with the generated read-only accessors (exos_<type>_mirror.h)"});
+				pickFeatures.push({label: "metrics", detail:"Prometheus/OpenMetrics exporter for dataset rates, latency and callback histograms, send buffers and connection state, enabled with --metrics-port <port> in the .exospkg Runtime service"});
+				pickFeatures.push(pickTrace);
+				pickFeatures.push({label: "profile", detail:"Change-frequency profile of every dataset member, reported at exit with the members ranked by changes and a suggested split into datasets with fewer bytes sent, enabled with --profile <path>"});
+				if(selectedASType.label == "C API") {
+					pickFeatures.push({label: "probe", detail:"Round trip probe on a hidden datamodel instance: the AR Cyclic FUB (C API) sends a probe every ProbePeriod and shows round trip time, uplink/downlink latency and lost probes"});
+				}
+			}
+			if(selectedASType.label == "C API") {
+				pickFeatures.push({label: "budget", detail:"Work budget per cycle for the AR Cyclic FUB (C API): BudgetTime and BudgetBytes limit the datasets delivered and published per cycle, the rest is deferred round-robin to the next cycle"});
+			}
+			if(selectedLinuxType.label == "C Interface") {
+				pickFeatures.push({label: "gateway", detail:"Shared memory fan-out of the datasets to local consumers, with client libraries for C, C++, Node.js and Python that need no DMR connection"});
+			}
+			pickFeatures.push({label: "rt", detail:"Real-time execution profile (SCHED_FIFO, CPU affinity, mlockall, timerfd cycle, jitter report), configured in the .exospkg Runtime service, includes the process modes"});
+			pickFeatures.push({label: "epoll", detail:"Event loop (epoll) where termination, wakeups, an optional processing cycle and your own file descriptors share one wait, includes the process modes. LIMITATION: exOS has no file descriptor for the DMR, so without a cycle time set in the main, Ctrl-C/SIGTERM, wakeups and your file descriptors are only handled after the next DMR cycle"});
+			pickFeatures.push({label: "loadgen", detail:"Load generator (<type>_loadgen next to build.sh) acting as AR: publishes with set rates, bursts, value distributions and mutation ratios, and reports throughput, response latency and PASS/FAIL against a latency budget"});
+
+			vscode.window.showQuickPick(pickFeatures,{title:`Select optional features for the Linux template (none selected is default)`, canPickMany:true}).then(selectedFeatures => {
+
+				if(!selectedFeatures)
+					return;
+
+				pickBuildProfileAndCreateComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, destination, selectedFeatures);
+			});
+		}
+
+		/**
+		 * Select the build profile of the compiled Linux sources (passed to build.sh in the .exospkg BuildCommand Arguments) and create the component
+		 */
+		function pickBuildProfileAndCreateComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, destination, selectedFeatures) {
+			let pickBuildProfile = [];
+			pickBuildProfile.push({label: "Release", detail:"Optimized with link time optimization (default)"});
+			pickBuildProfile.push({label: "RelWithDebInfo", detail:"Optimized for the CPU of the target (EXOS_MARCH, default x86-64-v2) with debug information"});
+			pickBuildProfile.push({label: "Debug", detail:"No optimization, with debug information"});
+
+			vscode.window.showQuickPick(pickBuildProfile,{title:`Select the build profile, add pgo after it in the .exospkg BuildCommand Arguments for profile-guided optimization (needs the record or loadgen feature)`}).then(selectedBuildProfile => {
+
+				if(!selectedBuildProfile)
+					return;
+
+				createComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, destination, selectedFeatures, selectedBuildProfile);
+			});
+		}
+
+		function createComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, destination, selectedFeatures, selectedBuildProfile) {
 			let stats = fs.statSync(uri.fsPath);
 			let makeComponentPath = uri.fsPath;
 			if (!stats.isDirectory()) {
@@ -378,6 +451,8 @@ function activate(context) {
 				return "";
 			}
 
+			let buildProfile = selectedBuildProfile ? selectedBuildProfile.label : undefined;
+
 			try
 			{
 				switch(selectedLinuxType.label) {
@@ -388,7 +463,9 @@ function activate(context) {
 							packaging:selectedPackaging.label,
 							templateLinux:convertLabel2Template(selectedLinuxType.label), 
 							templateAR:convertLabel2Template(selectedASType.label),
-							destinationDirectory:destination
+							destinationDirectory:destination,
+							features:Array.isArray(selectedFeatures) ? selectedFeatures.map(feature => feature.label) : [],
+							buildProfile:buildProfile
 						});
 						templateC.makeComponent(makeComponentPath);
 						break;
@@ -397,7 +474,9 @@ function activate(context) {
 							let templateSWIG = new ExosComponentSWIG(uri.fsPath, selectedStructure.label,{
 								packaging:selectedPackaging.label,
 								templateAR:convertLabel2Template(selectedASType.label),
-								destinationDirectory:destination
+								destinationDirectory:destination,
+								features:Array.isArray(selectedFeatures) ? selectedFeatures.map(feature => feature.label) : [],
+								buildProfile:buildProfile
 							});
 							templateSWIG.makeComponent(makeComponentPath);
 						}
@@ -416,7 +495,9 @@ function activate(context) {
 							let templateNAPI = new ExosComponentNAPI(uri.fsPath, selectedStructure.label,{
 								packaging:selectedPackaging.label,
 								templateAR:convertLabel2Template(selectedASType.label),
-								destinationDirectory:destination
+								destinationDirectory:destination,
+								features:Array.isArray(selectedFeatures) ? selectedFeatures.map(feature => feature.label) : [],
+								buildProfile:buildProfile
 							});
 							templateNAPI.makeComponent(makeComponentPath);
 						}
@@ -563,11 +644,11 @@ function activate(context) {
 										if(!destination)
 											return;
 
-										createComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, destination);
+										pickFeaturesAndCreateComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, destination);
 									});
 								}
 								else {
-									createComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, "");
+									pickFeaturesAndCreateComponent(uri, selectedStructure, selectedASType, selectedLinuxType, selectedPackaging, "");
 								}
 							});
 						})
@@ -766,6 +847,48 @@ function activate(context) {
 	});
 	context.subscriptions.push(updateComponent);
 
+	let analyzeLayout = vscode.commands.registerCommand('exos-component-extension.analyzeLayout', function (uri) {
+
+		let availableStructures = Datamodel.getDatatypeList(uri.fsPath);
+		if(!Array.isArray(availableStructures) || availableStructures.length == 0)
+		{
+			vscode.window.showErrorMessage(`The file ${path.basename(uri.fsPath)} has no structure definitions!`);
+			return;
+		}
+
+		let pickStructureList = [];
+		for(let struct of availableStructures) {
+			if(struct.members.length > 0) {
+				pickStructureList.push({label:struct.name, detail:`datasets: ${struct.members.join(", ")}`})
+			}
+			else {
+				pickStructureList.push({label:struct.name});
+			}
+		}
+		vscode.window.showQuickPick(pickStructureList,{title:"Select datatype to analyze"}).then(selectedStructure => {
+
+			if(!selectedStructure)
+				return;
+
+			vscode.window.showInputBox({prompt:"Publishes per second for each dataset used to weight the report, e.g. Values=100, Config=0.5 (datasets not listed are weighted with 1)", value:""}).then(rates => {
+
+				if(rates === undefined)
+					return;
+
+				try {
+					let datamodel = new Datamodel(uri.fsPath, selectedStructure.label);
+					let report = datamodel.makeLayoutReport(Datamodel.parseLayoutRates(rates));
+					vscode.workspace.openTextDocument({content:report, language:"plaintext"}).then(document => {
+						vscode.window.showTextDocument(document);
+					});
+				} catch (error) {
+					vscode.window.showErrorMessage(error);
+				}
+			});
+		});
+	});
+	context.subscriptions.push(analyzeLayout);
+
 }
 exports.activate = activate;
 
@@ -249,10 +249,11 @@ class ExosComponent extends Component {
             this._fileName = fileName;
             this._typeFileName = `${typeName}.typ`;
 
-            this._typFile = {name:this._typeFileName, contents:fs.readFileSync(fileName).toString(), description:`${typeName} datamodel declaration`}
             this._SG4Includes = [`${typeName.substr(0,10)}.h`];
 
             this._datamodel = new Datamodel(fileName, typeName, this._SG4Includes);
+            //copy of the .typ file for the AR library, with the generated tags of the publish groups (the selected file is left unchanged)
+            this._typFile = {name:this._typeFileName, contents:this._datamodel.fileContents, description:`${typeName} datamodel declaration`}
             
             this._iecProgram = this._exospackage.getNewIECProgram(`${typeName.substr(0,10)}_0`,`${typeName} application`);
 
@@ -266,6 +267,15 @@ class ExosComponent extends Component {
             this._linuxPackage = this._exospackage.getNewLinuxPackage("Linux", `${typeName} Linux resources`);
             this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._datamodel.headerFile);
             this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._datamodel.sourceFile);
+
+            if (this._datamodel.qosFile != undefined) {
+                this._cLibrary.addNewFileObj(this._datamodel.qosFile);
+                this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._datamodel.qosFile);
+            }
+            if (this._datamodel.groupFile != undefined) {
+                this._cLibrary.addNewFileObj(this._datamodel.groupFile);
+                this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._datamodel.groupFile);
+            }
         }
         else
         {
@@ -384,10 +394,23 @@ class ExosComponentUpdate extends ComponentUpdate {
                 this._cLibrary = this._exospackage.getNewCLibrary(this._typeName.substr(0,10), `${this._typeName} exOS library`);
                 this._linuxPackage = this._exospackage.getNewLinuxPackage("Linux",`${this._typeName} Linux resources`);
 
+                //the .typ file is only rewritten if new publish groups need their generated tags
+                if (this._datamodel.groupTagsAdded) {
+                    this._cLibrary.addNewFileObj({name:path.basename(this._fileName), contents:this._datamodel.fileContents, description:`${this._typeName} datamodel declaration`});
+                }
                 this._cLibrary.addNewFileObj(this._datamodel.headerFile);
                 this._cLibrary.addNewFileObj(this._datamodel.sourceFile);
                 this._linuxPackage.addNewFileObj(this._datamodel.headerFile);
                 this._linuxPackage.addNewFileObj(this._datamodel.sourceFile);
+
+                if (this._datamodel.qosFile != undefined) {
+                    this._cLibrary.addNewFileObj(this._datamodel.qosFile);
+                    this._linuxPackage.addNewFileObj(this._datamodel.qosFile);
+                }
+                if (this._datamodel.groupFile != undefined) {
+                    this._cLibrary.addNewFileObj(this._datamodel.groupFile);
+                    this._linuxPackage.addNewFileObj(this._datamodel.groupFile);
+                }
             }
         }
 
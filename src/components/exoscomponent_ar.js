@@ -29,8 +29,9 @@ class ExosComponentAR extends ExosComponent {
      * @param {*} fileName 
      * @param {*} typeName 
      * @param {string} template `c-static` | `cpp` | `c-api` | `deploy-only` - default: `c-api` 
+     * @param {string[]} [features] optional template features for AR: `budget` and `probe` (only `c-api`) - default: none
      */
-    constructor(fileName, typeName, template) {
+    constructor(fileName, typeName, template, features) {
         
         super(fileName, typeName, template);
 
@@ -48,7 +49,7 @@ class ExosComponentAR extends ExosComponent {
                 break;
             case "c-api":
             default:
-                this._templateAR = new TemplateARDynamic(this._datamodel);
+                this._templateAR = new TemplateARDynamic(this._datamodel, features);
                 break;
         }
     }
@@ -58,6 +59,9 @@ class ExosComponentAR extends ExosComponent {
         this._cLibrary.addNewFileObj(this._templateAR.libraryFun);
         this._cLibrary.addNewFileObj(this._templateAR.librarySource);
         this._cLibrary.addNewFileObj(this._templateAR.heap.heapSource);
+        if (this._templateAR.probe != undefined) {
+            this._cLibrary.addNewFileObj(this._templateAR.probe.probeHeader);
+        }
 
         switch(this._template)
         {
@@ -68,6 +72,7 @@ class ExosComponentAR extends ExosComponent {
             case "cpp":
                 this._cLibrary.addNewFileObj(this._templateAR.datasetHeader);
                 this._cLibrary.addNewFileObj(this._templateAR.datamodelHeader);
+                this._cLibrary.addNewFileObj(this._datamodel.reflectionFile);
                 this._cLibrary.addNewFileObj(this._templateAR.datamodelSource);
                 this._cLibrary.addNewFileObj(this._templateAR.loggerHeader);
                 this._cLibrary.addNewFileObj(this._templateAR.loggerSource);
@@ -124,6 +129,7 @@ class ExosComponentARUpdate extends ExosComponentUpdate {
                         this._templateAR = new TemplateARCpp(this._datamodel);
                         this._cLibrary.addNewFileObj(this._templateAR.datasetHeader);
                         this._cLibrary.addNewFileObj(this._templateAR.datamodelHeader);
+                        this._cLibrary.addNewFileObj(this._datamodel.reflectionFile);
                         this._cLibrary.addNewFileObj(this._templateAR.datamodelSource);
                         this._cLibrary.addNewFileObj(this._templateAR.loggerHeader);
                         this._cLibrary.addNewFileObj(this._templateAR.loggerSource);
@@ -133,8 +139,18 @@ class ExosComponentARUpdate extends ExosComponentUpdate {
                         break;
                     case "c-api":
                         if(updateAll == true) {
-                            this._templateAR = new TemplateARDynamic(this._datamodel);
+                            let features = [];
+                            if(this._exospackage.exospkg.componentOptions.features) {
+                                features = this._exospackage.exospkg.componentOptions.features.split(",");
+                            }
+                            this._templateAR = new TemplateARDynamic(this._datamodel, features);
                             this._cLibrary.addNewFileObj(this._templateAR.librarySource);
+                            if (this._templateAR.probe != undefined) {
+                                this._cLibrary.addNewFileObj(this._templateAR.probe.probeHeader);
+                            }
+                            if(features.includes("budget") || features.includes("probe")) {
+                                this._cLibrary.addNewFileObj(this._templateAR.libraryFun);
+                            }
                         }
                         break;
                     default:
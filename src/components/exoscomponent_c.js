@@ -11,9 +11,13 @@ const { TemplateLinuxC } = require('./templates/linux/template_linux_c');
 const { TemplateLinuxStaticCLib } = require('./templates/linux/template_linux_static_c_lib');
 const { TemplateLinuxCpp } = require('./templates/linux/template_linux_cpp');
 const { BuildOptions } = require('./templates/linux/template_linux_build');
+const { TemplateLinuxRealtime } = require('./templates/linux/template_linux_realtime');
+const { TemplateLinuxLoadgen } = require('./templates/linux/template_linux_loadgen');
 const { ExosComponentAR, ExosComponentARUpdate } = require('./exoscomponent_ar');
 const { EXOS_COMPONENT_VERSION } = require("./exoscomponent");
 const { ExosPkg } = require('../exospkg');
+const { TemplateProbe } = require('./templates/template_probe');
+const { Template } = require('./templates/template');
 
 const path = require('path');
 
@@ -23,6 +27,8 @@ const path = require('path');
  * @property {string} destinationDirectory destination for the packaging. default: `/home/user/{typeName.toLowerCase()}`
  * @property {string} templateAR template used for AR: `c-static` | `cpp` | `c-api` | `deploy-only` - default: `c-api`
  * @property {string} templateLinux template used for Linux: `c-static` | `cpp` | `c-api` - default: `c-api`
+ * @property {string[]} features optional template features: `soa` and `record` for Linux (only `c-static` and `cpp`), `gateway` for Linux (only `c-static`), `mirror`, `metrics`, `trace` and `profile` for Linux (only `c-static` and `cpp`), `rt`, `epoll`, `loadgen` and `process` for Linux (`rt` and `epoll` imply `process`), `budget` for AR (only `c-api`), `probe` for AR `c-api` together with Linux `c-static` or `cpp` (other combinations are rejected) - default: none
+ * @property {string} buildProfile build profile passed to the build script in the .exospkg BuildCommand Arguments: `Debug` | `Release` | `RelWithDebInfo` - default: `Release`
  */
 class ExosComponentC extends ExosComponentAR {
 
@@ -45,7 +51,7 @@ class ExosComponentC extends ExosComponentAR {
      */
     constructor(fileName, typeName, options) {
         
-        let _options = {packaging: `none`, destinationDirectory: `/home/user/${typeName.toLowerCase()}`, templateAR: "c-api", templateLinux: "c-api"};
+        let _options = {packaging: `none`, destinationDirectory: `/home/user/${typeName.toLowerCase()}`, templateAR: "c-api", templateLinux: "c-api", features: [], buildProfile: "Release"};
 
         if(options) {
             if(options.destinationDirectory) {
@@ -60,9 +66,20 @@ class ExosComponentC extends ExosComponentAR {
             if(options.packaging) {
                 _options.packaging = options.packaging;
             }
+            if(Array.isArray(options.features)) {
+                _options.features = options.features;
+            }
+            if(options.buildProfile) {
+                _options.buildProfile = options.buildProfile;
+            }
+        }
+
+        //the probe needs both ends, which only exist in these templates
+        if (_options.features.includes("probe") && (_options.templateAR != "c-api" || !["c-static", "cpp"].includes(_options.templateLinux))) {
+            throw (`ExosComponentC: the probe feature needs the AR template c-api and the Linux template c-static or cpp, not ${_options.templateAR} and ${_options.templateLinux}`);
         }
 
-        super(fileName, typeName, _options.templateAR);
+        super(fileName, typeName, _options.templateAR, _options.features);
         this._options = _options;
 
         if(this._options.packaging == "none") {
@@ -72,14 +89,14 @@ class ExosComponentC extends ExosComponentAR {
         switch(this._options.templateLinux)
         {
             case "c-static":
-                this._templateLinux = new TemplateLinuxStaticCLib(this._datamodel);
+                this._templateLinux = new TemplateLinuxStaticCLib(this._datamodel, this._options.features);
                 break;
             case "cpp":
-                this._templateLinux = new TemplateLinuxCpp(this._datamodel);
+                this._templateLinux = new TemplateLinuxCpp(this._datamodel, this._options.features);
                 break;
             case "c-api":
             default:
-                this._templateLinux = new TemplateLinuxC(this._datamodel);
+                this._templateLinux = new TemplateLinuxC(this._datamodel, this._options.features);
                 break;
         }
         
@@ -101,6 +118,7 @@ class ExosComponentC extends ExosComponentAR {
             case "cpp":
                 this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.datasetHeader);
                 this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.datamodelHeader);
+                this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._datamodel.reflectionFile);
                 this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.datamodelSource);
                 this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.loggerHeader);
                 this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.loggerSource);
@@ -110,12 +128,74 @@ class ExosComponentC extends ExosComponentAR {
                 break;
         }
 
+        if (this._templateLinux.processHeaderName !== undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._datamodel.processFile);
+        }
+        if (this._templateLinux.soa != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.soa.soaHeader);
+        }
+        if (this._templateLinux.mirror != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.mirror.mirrorHeader);
+        }
+        if (this._templateLinux.probe != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.probe.probeHeader);
+        }
+        if (this._templateLinux.profile != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.profile.profileHeader);
+        }
+
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.mainSource);
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.termination.terminationHeader);
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.termination.terminationSource);
+        if (this._templateLinux.realtime != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.realtime.realtimeHeader);
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.realtime.realtimeSource);
+        }
+        if (this._templateLinux.recorder != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.recorder.recorderHeader);
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.recorder.recorderSource);
+        }
+        if (this._templateLinux.gateway != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.gateway.gatewayHeader);
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.gateway.gatewaySource);
+            // client libraries for the local consumers, the C and C++ clients are built with gateway.c
+            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.clientHeader);
+            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.clientSource);
+            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.clientCppHeader);
+            this._linuxPackage.addNewTransferFileObj(this._templateLinux.gateway.clientJs, "Ignore");
+            this._linuxPackage.addNewTransferFileObj(this._templateLinux.gateway.clientPython, "Ignore");
+        }
+        if (this._templateLinux.metrics != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.metrics.metricsHeader);
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.metrics.metricsSource);
+        }
+        if (this._templateLinux.trace != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.trace.traceHeader);
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.trace.traceSource);
+        }
+        if (this._templateLinux.loadgen != undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateLinux.loadgen.loadgenSource);
+        }
 
         
         this._templateBuild.options.executable.sourceFiles = [this._templateLinux.termination.terminationSource.name, this._templateLinux.mainSource.name]
+        if (this._templateLinux.realtime != undefined) {
+            this._templateBuild.options.executable.sourceFiles.push(this._templateLinux.realtime.realtimeSource.name)
+        }
+        if (this._templateLinux.recorder != undefined) {
+            this._templateBuild.options.executable.sourceFiles.push(this._templateLinux.recorder.recorderSource.name)
+        }
+        if (this._templateLinux.gateway != undefined) {
+            this._templateBuild.options.executable.sourceFiles.push(this._templateLinux.gateway.gatewaySource.name)
+        }
+        if (this._templateLinux.metrics != undefined) {
+            this._templateBuild.options.executable.sourceFiles.push(this._templateLinux.metrics.metricsSource.name)
+            // the metrics are served from an exporter thread
+            this._templateBuild.options.linkLibraries += " pthread";
+        }
+        if (this._templateLinux.trace != undefined) {
+            this._templateBuild.options.executable.sourceFiles.push(this._templateLinux.trace.traceSource.name)
+        }
         if (this._datamodel != undefined) {
             this._templateBuild.options.executable.sourceFiles.push(this._datamodel.sourceFile.name)
         }
@@ -125,21 +205,43 @@ class ExosComponentC extends ExosComponentAR {
         if (this._templateLinux.loggerSource != undefined) {
             this._templateBuild.options.executable.sourceFiles.push(this._templateLinux.loggerSource.name)
         }
+        if (this._templateLinux.loadgen != undefined) {
+            // the load generator is a separate executable, built from its own main and the datamodel source
+            this._templateBuild.options.executable.tools.push({executableName: TemplateLinuxLoadgen.executableName(this._datamodel), sourceFiles: [this._templateLinux.loadgen.loadgenSource.name, this._datamodel.sourceFile.name], linkLibraries: "m"});
+        }
+        // the real-time execution profile is configured with the arguments of the Runtime service
+        let runtimeArguments = this._templateLinux.realtime != undefined ? ` ${TemplateLinuxRealtime.defaultArguments}` : "";
         if(this._options.packaging == "deb") {
             this._templateBuild.options.debPackage.enable = true;
             this._templateBuild.options.debPackage.destination = this._options.destinationDirectory;
-            this._exospackage.exospkg.addService("Runtime", `./${this._templateBuild.options.executable.executableName}`, this._templateBuild.options.debPackage.destination);
+            this._exospackage.exospkg.addService("Runtime", `./${this._templateBuild.options.executable.executableName}${runtimeArguments}`, this._templateBuild.options.debPackage.destination);
         }
         else {
             this._templateBuild.options.debPackage.enable = false;
             this._exospackage.exospkg.addService("Startup", `chmod +x ${this._templateBuild.options.executable.executableName}`);
-            this._exospackage.exospkg.addService("Runtime", `./${this._templateBuild.options.executable.executableName}`);
+            this._exospackage.exospkg.addService("Runtime", `./${this._templateBuild.options.executable.executableName}${runtimeArguments}`);
+        }
+
+        // the build profile is passed after $(EXOS_VERSION), adding pgo as third argument rebuilds with profile-guided optimization
+        this._templateBuild.options.buildType = this._options.buildProfile;
+        this._linuxBuild.args += ` ${this._options.buildProfile}`;
+        // only a replay or the load generator does a fixed amount of work without the AR application
+        this._templateBuild.options.pgo.enable = this._templateLinux.recorder != undefined || this._templateLinux.loadgen != undefined;
+        if (this._templateBuild.options.pgo.enable) {
+            this._templateBuild.options.pgo.trainCommand = this._makeTrainCommand();
+            this._gitIgnore.contents += `${this._templateBuild.options.pgo.profileDirectory}/\n`;
+        }
+        else {
+            this._templateBuild.options.pgo.missingWorkload = `No training workload for the profile-guided optimization, generate the component with the record feature (replay of a recording) or the loadgen feature (load generator)`;
         }
 
         this._templateBuild.makeBuildFiles();
 
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateBuild.CMakeLists);
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateBuild.buildScript);
+        if (this._templateBuild.options.pgo.enable) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateBuild.trainScript);
+        }
         
         if(this._options.packaging == "deb") {
             this._linuxPackage.addExistingTransferDebFile(this._templateBuild.options.debPackage.fileName, this._templateBuild.options.debPackage.packageName, `${this._typeName} debian package`);
@@ -148,12 +250,22 @@ class ExosComponentC extends ExosComponentAR {
         else {
             this._linuxPackage.addExistingTransferFile(this._templateBuild.options.executable.executableName, "Restart", `${this._typeName} application`);
         }
+        for (const tool of this._templateBuild.options.executable.tools) {
+            this._linuxPackage.addExistingFile(tool.executableName, `${this._typeName} ${tool.executableName}`);
+        }
 
-        if (this._templateAR != undefined)
+        if (this._templateAR != undefined) {
             this._exospackage.exospkg.addDatamodelInstance(`${this._templateAR.template.datamodelInstanceName}`);
+            if (this._options.features.includes("probe")) {
+                this._exospackage.exospkg.addDatamodelInstance(TemplateProbe.datamodelInstanceName(this._templateAR.template));
+            }
+        }
 
         this._exospackage.exospkg.setComponentGenerator("ExosComponentC", EXOS_COMPONENT_VERSION, []);
         this._exospackage.exospkg.addGeneratorOption("templateLinux",this._options.templateLinux);
+        if (this._options.features.length > 0) {
+            this._exospackage.exospkg.addGeneratorOption("features",this._options.features);
+        }
 
         if(this._options.packaging == "deb") {
             this._exospackage.exospkg.addGeneratorOption("exportLinux",[this._templateBuild.options.debPackage.fileName]);
@@ -167,6 +279,37 @@ class ExosComponentC extends ExosComponentAR {
         else
             super.makeComponent(location);
     }
+
+    /**
+     * Training workload of the profile-guided optimization: a replay of a recording with the `record` feature,
+     * otherwise the load generator of the `loadgen` feature
+     * 
+     * @returns {string} shell commands of the `pgo_train.sh`
+     */
+    _makeTrainCommand() {
+        let executable = this._templateBuild.options.executable.executableName;
+        let out = "";
+
+        if (this._templateLinux.recorder != undefined) {
+            out += `# Replay a recording of the application in production as fast as possible, without the DMR.\n`;
+            out += `# Record it on the target with --record and copy the segment files to training/${this._typeName}.0 ..\n`;
+            out += `if [ ! -f training/${this._typeName}.0 ] ; then\n`;
+            out += `    echo "ERROR: No recording found in training/${this._typeName}.0"\n`;
+            out += `    exit 1\n`;
+            out += `fi\n`;
+            out += `./${executable} --replay training/${this._typeName} --replay-speed 0`;
+        }
+        else {
+            out += `# Run the application against the synthetic load of the load generator, needs a running DMR\n`;
+            out += `./${executable} &\n`;
+            out += `APPLICATION=$!\n`;
+            out += `./${TemplateLinuxLoadgen.executableName(this._datamodel)} --duration 10\n`;
+            out += `kill $APPLICATION\n`;
+            out += `wait $APPLICATION`;
+        }
+
+        return out;
+    }
 }
 
 class ExosComponentCUpdate extends ExosComponentARUpdate {
@@ -191,37 +334,118 @@ class ExosComponentCUpdate extends ExosComponentARUpdate {
      
         if(this._exosPkgParseResults.componentFound == true && this._exosPkgParseResults.componentErrors.length == 0) {
             if(this._exospackage.exospkg.componentOptions.templateLinux) {
-                this._options = {packaging: "", destinationDirectory: "", templateAR: "", templateLinux: this._exospackage.exospkg.componentOptions.templateLinux};
+                this._options = {packaging: "", destinationDirectory: "", templateAR: "", templateLinux: this._exospackage.exospkg.componentOptions.templateLinux, features: []};
+                if(this._exospackage.exospkg.componentOptions.features) {
+                    this._options.features = this._exospackage.exospkg.componentOptions.features.split(",");
+                }
                
                 switch(this._options.templateLinux)
                 {
                     case "c-static":
-                        this._templateLinux = new TemplateLinuxStaticCLib(this._datamodel);
+                        this._templateLinux = new TemplateLinuxStaticCLib(this._datamodel, this._options.features);
                         this._linuxPackage.addNewFileObj(this._templateLinux.staticLibraryHeader);
                         this._linuxPackage.addNewFileObj(this._templateLinux.staticLibrarySource);
+                        if (this._templateLinux.soa != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.soa.soaHeader);
+                        }
+                        if (this._templateLinux.recorder != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.recorder.recorderHeader);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.recorder.recorderSource);
+                        }
+                        if (this._templateLinux.gateway != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.gatewayHeader);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.gatewaySource);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.clientHeader);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.clientSource);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.clientCppHeader);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.clientJs);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.gateway.clientPython);
+                        }
+                        if (this._templateLinux.mirror != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.mirror.mirrorHeader);
+                        }
+                        if (this._templateLinux.probe != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.probe.probeHeader);
+                        }
+                        if (this._templateLinux.profile != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.profile.profileHeader);
+                        }
+                        if (this._templateLinux.metrics != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.metrics.metricsHeader);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.metrics.metricsSource);
+                        }
+                        if (this._templateLinux.trace != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.trace.traceHeader);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.trace.traceSource);
+                        }
                         if(updateAll) {
                             this._linuxPackage.addNewFileObj(this._templateLinux.mainSource);
+                            if (this._templateLinux.realtime != undefined) {
+                                this._linuxPackage.addNewFileObj(this._templateLinux.realtime.realtimeHeader);
+                                this._linuxPackage.addNewFileObj(this._templateLinux.realtime.realtimeSource);
+                            }
                         }
                         break;
                     case "cpp":
-                        this._templateLinux = new TemplateLinuxCpp(this._datamodel);
+                        this._templateLinux = new TemplateLinuxCpp(this._datamodel, this._options.features);
                         this._linuxPackage.addNewFileObj(this._templateLinux.datasetHeader);
                         this._linuxPackage.addNewFileObj(this._templateLinux.datamodelHeader);
+                        this._linuxPackage.addNewFileObj(this._datamodel.reflectionFile);
+                        if (this._templateLinux.soa != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.soa.soaHeader);
+                        }
+                        if (this._templateLinux.recorder != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.recorder.recorderHeader);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.recorder.recorderSource);
+                        }
+                        if (this._templateLinux.mirror != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.mirror.mirrorHeader);
+                        }
+                        if (this._templateLinux.probe != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.probe.probeHeader);
+                        }
+                        if (this._templateLinux.profile != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.profile.profileHeader);
+                        }
+                        if (this._templateLinux.metrics != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.metrics.metricsHeader);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.metrics.metricsSource);
+                        }
+                        if (this._templateLinux.trace != undefined) {
+                            this._linuxPackage.addNewFileObj(this._templateLinux.trace.traceHeader);
+                            this._linuxPackage.addNewFileObj(this._templateLinux.trace.traceSource);
+                        }
                         this._linuxPackage.addNewFileObj(this._templateLinux.datamodelSource);
                         this._linuxPackage.addNewFileObj(this._templateLinux.loggerHeader);
                         this._linuxPackage.addNewFileObj(this._templateLinux.loggerSource);
                         if(updateAll) {
                             this._linuxPackage.addNewFileObj(this._templateLinux.mainSource);
+                            if (this._templateLinux.realtime != undefined) {
+                                this._linuxPackage.addNewFileObj(this._templateLinux.realtime.realtimeHeader);
+                                this._linuxPackage.addNewFileObj(this._templateLinux.realtime.realtimeSource);
+                            }
                         }
                         break;
                     case "c-api":
                         if(updateAll) {
-                            this._templateLinux = new TemplateLinuxC(this._datamodel);
+                            this._templateLinux = new TemplateLinuxC(this._datamodel, this._options.features);
                             this._linuxPackage.addNewFileObj(this._templateLinux.mainSource);
+                            if (this._templateLinux.realtime != undefined) {
+                                this._linuxPackage.addNewFileObj(this._templateLinux.realtime.realtimeHeader);
+                                this._linuxPackage.addNewFileObj(this._templateLinux.realtime.realtimeSource);
+                            }
                         }
                     default:
                         break;
                 }
+                // the process mode header follows the datamodel, also when the application sources are kept
+                if (Template.processModes(this._options.features)) {
+                    this._linuxPackage.addNewFileObj(this._datamodel.processFile);
+                }
+                // the load generator follows the datamodel, also when the application sources are kept
+                if (this._options.features.includes("loadgen")) {
+                    this._linuxPackage.addNewFileObj(new TemplateLinuxLoadgen(this._datamodel).loadgenSource);
+                }
                 
             }
             else {
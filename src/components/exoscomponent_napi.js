@@ -21,6 +21,8 @@ const path = require('path');
  * @property {string} destinationDirectory destination of the generated executable in Linux. default: `/home/user/{typeName.toLowerCase()}`
  * @property {string} templateAR template used for AR: `c-static` | `cpp` | `c-api` - default: `c-api`
  * @property {boolean} includeNodeModules include additional `node_modules` in the package - default: `true`
+ * @property {string} buildProfile build profile passed to the build script in the .exospkg BuildCommand Arguments: `Debug` | `Release` | `RelWithDebInfo` - default: `Release`
+ * @property {string[]} features optional template features for Linux: `process` and `trace` - default: none
  */
 
 class ExosComponentNAPI extends ExosComponentAR {
@@ -38,7 +40,7 @@ class ExosComponentNAPI extends ExosComponentAR {
       * @param {ExosComponentNAPIOptions} options 
       */
      constructor(fileName, typeName, options) {
-        let _options = {packaging:"deb", destinationDirectory: `/home/user/${typeName.toLowerCase()}`, templateAR: "c-api", includeNodeModules: true};
+        let _options = {packaging:"deb", destinationDirectory: `/home/user/${typeName.toLowerCase()}`, templateAR: "c-api", includeNodeModules: true, buildProfile: "Release", features: []};
 
         if(options) {
             if(options.destinationDirectory) {
@@ -54,6 +56,12 @@ class ExosComponentNAPI extends ExosComponentAR {
             if(options.packaging) {
                 _options.packaging = options.packaging;
             }
+            if(options.buildProfile) {
+                _options.buildProfile = options.buildProfile;
+            }
+            if(Array.isArray(options.features)) {
+                _options.features = options.features;
+            }
         }
 
         super(fileName, typeName, _options.templateAR);
@@ -66,7 +74,7 @@ class ExosComponentNAPI extends ExosComponentAR {
         }
 
         this._templateBuild = new TemplateLinuxBuild(typeName);
-        this._templateNAPI = new TemplateLinuxNAPI(this._datamodel);
+        this._templateNAPI = new TemplateLinuxNAPI(this._datamodel, this._options.features);
     }
 
     makeComponent(location) {
@@ -84,11 +92,24 @@ class ExosComponentNAPI extends ExosComponentAR {
             this._templateBuild.options.napi.includeNodeModules = false;
         }
 
+        // the build profile is passed after $(EXOS_VERSION), adding pgo as third argument rebuilds with profile-guided optimization
+        this._templateBuild.options.buildType = this._options.buildProfile;
+        this._linuxBuild.args += ` ${this._options.buildProfile}`;
+        // there is no training workload that runs without the AR application
+        this._templateBuild.options.pgo.missingWorkload = `No training workload for the profile-guided optimization of N-API modules, it needs the record or loadgen feature of the C API, C Interface or C++ Class templates`;
+
         this._templateBuild.makeBuildFiles();
 
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateBuild.CMakeLists);
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateBuild.buildScript);
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateNAPI.librarySource);
+        if (this._templateNAPI.processHeaderName !== undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._datamodel.processFile);
+        }
+        if (this._templateNAPI.trace !== undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateNAPI.trace.traceHeader);
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateNAPI.trace.traceSource);
+        }
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateNAPI.gypFile);
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateNAPI.packageJson);
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateNAPI.packageLockJson);
@@ -110,6 +131,9 @@ class ExosComponentNAPI extends ExosComponentAR {
         this._exospackage.exospkg.addDatamodelInstance(`${this._templateAR.template.datamodelInstanceName}`);
 
         this._exospackage.exospkg.setComponentGenerator("ExosComponentNAPI", EXOS_COMPONENT_VERSION, []);
+        if (this._options.features.length > 0) {
+            this._exospackage.exospkg.addGeneratorOption("features",this._options.features);
+        }
 
         if(this._options.packaging == "deb") {
             this._exospackage.exospkg.addGeneratorOption("exportLinux",[this._templateBuild.options.debPackage.fileName,
@@ -138,8 +162,19 @@ class ExosComponentNAPIUpdate extends ExosComponentARUpdate {
         super(exospkgFileName, updateAll);
      
         if(this._exosPkgParseResults.componentFound == true && this._exosPkgParseResults.componentErrors.length == 0) {
-            this._templateNAPI = new TemplateLinuxNAPI(this._datamodel);
+            let features = [];
+            if(this._exospackage.exospkg.componentOptions.features) {
+                features = this._exospackage.exospkg.componentOptions.features.split(",");
+            }
+            this._templateNAPI = new TemplateLinuxNAPI(this._datamodel, features);
             this._linuxPackage.addNewFileObj(this._templateNAPI.librarySource);
+            if (this._templateNAPI.processHeaderName !== undefined) {
+                this._linuxPackage.addNewFileObj(this._datamodel.processFile);
+            }
+            if (this._templateNAPI.trace !== undefined) {
+                this._linuxPackage.addNewFileObj(this._templateNAPI.trace.traceHeader);
+                this._linuxPackage.addNewFileObj(this._templateNAPI.trace.traceSource);
+            }
             if(updateAll) {
                 this._linuxPackage.addNewFileObj(this._templateNAPI.JsMain);
             }
@@ -20,6 +20,8 @@ const path = require('path');
  * @property {string} packaging  package format: `deb` | `none` - default: `deb`
  * @property {string} destinationDirectory destination of the generated executable in Linux. default: `/home/user/{typeName.toLowerCase()}`
  * @property {string} templateAR template used for AR: `c-static` | `cpp` | `c-api` - default: `c-static` 
+ * @property {string} buildProfile build profile passed to the build script in the .exospkg BuildCommand Arguments: `Debug` | `Release` | `RelWithDebInfo` - default: `Release`
+ * @property {string[]} features optional template features for Linux: `process` | `record` - default: none
  */
 
 class ExosComponentSWIG extends ExosComponentAR {
@@ -39,7 +41,7 @@ class ExosComponentSWIG extends ExosComponentAR {
      */
     constructor(fileName, typeName, options) {
 
-        let _options = {packaging:"deb", destinationDirectory: `/home/user/${typeName.toLowerCase()}`, templateAR: "c-static"};
+        let _options = {packaging:"deb", destinationDirectory: `/home/user/${typeName.toLowerCase()}`, templateAR: "c-static", buildProfile: "Release", features: []};
 
         if(options) {
             if(options.destinationDirectory) {
@@ -51,6 +53,12 @@ class ExosComponentSWIG extends ExosComponentAR {
             if(options.packaging) {
                 _options.packaging = options.packaging;
             }
+            if(options.buildProfile) {
+                _options.buildProfile = options.buildProfile;
+            }
+            if(Array.isArray(options.features)) {
+                _options.features = options.features;
+            }
         }
 
         super(fileName, typeName, _options.templateAR);
@@ -61,7 +69,7 @@ class ExosComponentSWIG extends ExosComponentAR {
         }
 
         this._templateBuild = new TemplateLinuxBuild(typeName);
-        this._templateSWIG = new TemplateLinuxSWIG(this._datamodel);
+        this._templateSWIG = new TemplateLinuxSWIG(this._datamodel, this._options.features);
 
         this._gitIgnore.contents += "__pycache__/\n";
         this._gitIgnore.contents += "*.pyc\n";
@@ -73,11 +81,21 @@ class ExosComponentSWIG extends ExosComponentAR {
        
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateSWIG.staticLibraryHeader);
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateSWIG.staticLibrarySource);
+        if (this._templateSWIG.processHeaderName !== undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._datamodel.processFile);
+        }
+        if (this._templateSWIG.recorder !== undefined) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateSWIG.recorder.recorderHeader);
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateSWIG.recorder.recorderSource);
+        }
         
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateSWIG.swigInclude);
         
         this._templateBuild.options.swigPython.enable = true;
         this._templateBuild.options.swigPython.sourceFiles = [this._templateSWIG.staticLibrarySource.name, this._templateSWIG.swigInclude.name, this._datamodel.sourceFile.name];
+        if (this._templateSWIG.recorder !== undefined) {
+            this._templateBuild.options.swigPython.sourceFiles.push(this._templateSWIG.recorder.recorderSource.name);
+        }
         if(this._options.packaging == "deb") {
             this._templateBuild.options.debPackage.enable = true;
             this._templateBuild.options.debPackage.destination = this._options.destinationDirectory;
@@ -86,10 +104,26 @@ class ExosComponentSWIG extends ExosComponentAR {
             this._templateBuild.options.debPackage.enable = false;
         }
 
+        // the build profile is passed after $(EXOS_VERSION), adding pgo as third argument rebuilds with profile-guided optimization
+        this._templateBuild.options.buildType = this._options.buildProfile;
+        this._linuxBuild.args += ` ${this._options.buildProfile}`;
+        // only a replay does a fixed amount of work without the AR application
+        this._templateBuild.options.pgo.enable = this._templateSWIG.recorder !== undefined;
+        if (this._templateBuild.options.pgo.enable) {
+            this._templateBuild.options.pgo.trainCommand = this._makeTrainCommand();
+            this._gitIgnore.contents += `${this._templateBuild.options.pgo.profileDirectory}/\n`;
+        }
+        else {
+            this._templateBuild.options.pgo.missingWorkload = `No training workload for the profile-guided optimization of SWIG Python modules, generate the component with the record feature (replay of a recording)`;
+        }
+
         this._templateBuild.makeBuildFiles();
 
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateBuild.CMakeLists);
         this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateBuild.buildScript);
+        if (this._templateBuild.options.pgo.enable) {
+            this._linuxPackage.addNewBuildFileObj(this._linuxBuild, this._templateBuild.trainScript);
+        }
         
         this._linuxPackage.addNewTransferFileObj(this._templateSWIG.pythonMain, "Restart");
 
@@ -108,6 +142,9 @@ class ExosComponentSWIG extends ExosComponentAR {
         this._exospackage.exospkg.addDatamodelInstance(`${this._templateAR.template.datamodelInstanceName}`);
 
         this._exospackage.exospkg.setComponentGenerator("ExosComponentSWIG", EXOS_COMPONENT_VERSION, []);
+        if (this._options.features.length > 0) {
+            this._exospackage.exospkg.addGeneratorOption("features",this._options.features);
+        }
 
         if(this._options.packaging == "deb") {
             this._exospackage.exospkg.addGeneratorOption("exportLinux",[this._templateBuild.options.debPackage.fileName,
@@ -121,6 +158,26 @@ class ExosComponentSWIG extends ExosComponentAR {
 
         super.makeComponent(location);
     }
+
+    /**
+     * Training workload of the profile-guided optimization: a replay of a recording with the `record` feature,
+     * running the python script with the module of the build folder
+     * 
+     * @returns {string} shell commands of the `pgo_train.sh`
+     */
+    _makeTrainCommand() {
+        let out = "";
+
+        out += `# Replay a recording of the application in production as fast as possible, without the DMR.\n`;
+        out += `# Record it on the target with --record and copy the segment files to training/${this._typeName}.0 ..\n`;
+        out += `if [ ! -f training/${this._typeName}.0 ] ; then\n`;
+        out += `    echo "ERROR: No recording found in training/${this._typeName}.0"\n`;
+        out += `    exit 1\n`;
+        out += `fi\n`;
+        out += `PYTHONPATH=build python3 ${this._templateSWIG.pythonMain.name} --replay training/${this._typeName} --replay-speed 0`;
+
+        return out;
+    }
 }
 
 class ExosComponentSWIGUpdate extends ExosComponentARUpdate {
@@ -134,10 +191,21 @@ class ExosComponentSWIGUpdate extends ExosComponentARUpdate {
         super(exospkgFileName, updateAll);
      
         if(this._exosPkgParseResults.componentFound == true && this._exosPkgParseResults.componentErrors.length == 0) {
-            this._templateSWIG = new TemplateLinuxSWIG(this._datamodel);
+            let features = [];
+            if(this._exospackage.exospkg.componentOptions.features) {
+                features = this._exospackage.exospkg.componentOptions.features.split(",");
+            }
+            this._templateSWIG = new TemplateLinuxSWIG(this._datamodel, features);
 
             this._linuxPackage.addNewFileObj(this._templateSWIG.staticLibraryHeader);
             this._linuxPackage.addNewFileObj(this._templateSWIG.staticLibrarySource);
+            if (this._templateSWIG.processHeaderName !== undefined) {
+                this._linuxPackage.addNewFileObj(this._datamodel.processFile);
+            }
+            if (this._templateSWIG.recorder !== undefined) {
+                this._linuxPackage.addNewFileObj(this._templateSWIG.recorder.recorderHeader);
+                this._linuxPackage.addNewFileObj(this._templateSWIG.recorder.recorderSource);
+            }
             this._linuxPackage.addNewFileObj(this._templateSWIG.swigInclude);
 
             if(updateAll) {
@@ -167,6 +167,10 @@ class TemplateARCpp extends TemplateCppLib {
             out += `\n`;
             out += `    inst->Connected = ${template.datamodel.varName}->isConnected;\n`;
             out += `    inst->Operational = ${template.datamodel.varName}->isOperational;\n`;
+            out += `    inst->InSync = ${template.datamodel.varName}->syncInfo().inSync;\n`;
+            out += `    inst->MissedDmrCycles = ${template.datamodel.varName}->syncInfo().missedDmrCycles;\n`;
+            out += `    inst->MissedArCycles = ${template.datamodel.varName}->syncInfo().missedArCycles;\n`;
+            out += `    inst->SyncChanges = ${template.datamodel.varName}->syncInfo().syncChanges;\n`;
             out += `}\n`;
             out += `\n`;
             out += `_BUR_PUBLIC void ${template.datamodel.structName}Exit(struct ${template.datamodel.structName}Exit *inst)\n`;
@@ -203,6 +207,10 @@ class TemplateARCpp extends TemplateCppLib {
             out += `        Connected : BOOL;\n`;
             out += `        Operational : BOOL;\n`;
             out += `        Error : BOOL;\n`;
+            out += `        InSync : BOOL; (*Datamodel is in sync with the DMR*)\n`;
+            out += `        MissedDmrCycles : UDINT; (*Cycles missed by the DMR*)\n`;
+            out += `        MissedArCycles : UDINT; (*Cycles missed by AR*)\n`;
+            out += `        SyncChanges : UDINT; (*Number of sync state changes*)\n`;
             out += `    END_VAR\n`;
             out += `    VAR\n`;
             out += `        _Start : BOOL;\n`;
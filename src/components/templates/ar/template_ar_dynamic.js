@@ -8,8 +8,9 @@
  */
 
 const { Datamodel, GeneratedFileObj } = require('../../../datamodel');
-const { Template, ApplicationTemplate } = require('../template');
+const { Template, ApplicationTemplate, TemplateFeature } = require('../template');
 const {TemplateARHeap } = require('./template_ar_heap');
+const { TemplateProbe } = require('../template_probe');
 
 class TemplateARDynamic extends Template {
 
@@ -42,6 +43,12 @@ class TemplateARDynamic extends Template {
      */
     heap;
 
+    /**
+     * round trip probe, only created with the `probe` feature
+     * @type {TemplateProbe}
+     */
+    probe;
+
     /**
      * {@linkcode TemplateARDynamic} Generate source code for dynamic AR C-Library and ST-Application
      * 
@@ -54,11 +61,25 @@ class TemplateARDynamic extends Template {
      * Using {@linkcode TemplateARHeap}
      * - `heap.heapSource` declaring the dynamic heap
      * 
+     * With the `budget` feature, the work done after `exos_datamodel_process()` (delivering received datasets
+     * and publishing changed datasets) is bounded by the `BudgetTime` and `BudgetBytes` inputs of the Cyclic FUB.
+     * Datasets that do not fit into the budget are deferred to the next cycle, continuing round-robin where the budget was exceeded.
+     * 
+     * Datasets with QoS annotations in the .typ file use the `Datamodel.qosFile` header: the deadband is applied in `datasetEvent()`,
+     * conflated (`LATEST`) updates and publishes deferred by their `RATE` are handled in the Cyclic FUB, in order of priority.
+     * 
+     * With the `probe` feature, the Cyclic FUB sends round trip probes to the Linux application every `ProbePeriod`,
+     * and outputs the round trip time and the one-way estimates, see {@linkcode TemplateProbe}
+     * 
      * @param {Datamodel} datamodel
+     * @param {TemplateFeature[]} [features] optional features to generate
      */
-    constructor(datamodel) {
-        super(datamodel,false);
+    constructor(datamodel, features) {
+        super(datamodel, false, undefined, features);
 
+        if (this.features.includes("probe")) {
+            this.probe = new TemplateProbe(datamodel, false);
+        }
         this.librarySource = {name:`${this.datamodel.typeName.toLowerCase()}.c`, contents:this._generateSource(), description:`${this.datamodel.typeName} library source`};
         this.libraryFun = {name:`${this.datamodel.typeName.substr(0,10)}.fun`, contents:this._generateFun(), description:`${this.datamodel.typeName} function blocks`}; // Avoid Error in AS: The name of the .fun file is not equal to the name of the library.	(9348)
         this.iecProgramVar = {name:`${this.datamodel.typeName}.var`, contents:this._generateIECProgramVar(), description:`${this.datamodel.typeName} variable declaration`};
@@ -71,6 +92,36 @@ class TemplateARDynamic extends Template {
      */
     _generateSource() {
 
+        /**
+         * @param {ApplicationTemplateDataset[]} datasets 
+         * @returns {ApplicationTemplateDataset[]} the datasets in order of their `PRIO` annotation, the others are NORMAL
+         */
+        function priorityOrder(datasets) {
+            let priority = dataset => Datamodel.QOS_PRIORITIES.indexOf(dataset.qos !== undefined ? dataset.qos.priority : "NORMAL");
+            return [...datasets].sort((a, b) => priority(a) - priority(b));
+        }
+
+        /**
+         * @param {ApplicationTemplate} template 
+         * @param {ApplicationTemplateDataset} dataset 
+         * @param {string} indent 
+         * @param {string} datasetHandle pointer to the `exos_dataset_handle_t`
+         * @param {string} datamodelHandle pointer to the `exos_datamodel_handle_t`
+         * @returns {string} publish of a changed dataset, deferred to the flush in the Cyclic FUB if it is within its `RATE`
+         */
+        function generatePublish(template, dataset, indent, datasetHandle, datamodelHandle) {
+            if (dataset.qos === undefined || dataset.qos.rate == 0) {
+                return `${indent}exos_dataset_publish(${datasetHandle});\n`;
+            }
+            let out = "";
+            out += `${indent}//quality of service: publishes within the rate are deferred\n`;
+            out += `${indent}if (exos_qos_publish(&${template.handle.name}->${dataset.varName}_qos, exos_datamodel_get_nettime(${datamodelHandle})))\n`;
+            out += `${indent}{\n`;
+            out += `${indent}    exos_dataset_publish(${datasetHandle});\n`;
+            out += `${indent}}\n`;
+            return out;
+        }
+
         /**
          * @param {ApplicationTemplate} template 
          * @returns {string}
@@ -82,6 +133,15 @@ class TemplateARDynamic extends Template {
             out += `#define EXOS_ASSERT_CALLBACK inst->_state = 255;\n`;
             out += `#include "exos_log.h"\n`;
             out += `#include "${template.headerName}"\n`;
+            if (groupHeaderName !== undefined) {
+                out += `#include "${groupHeaderName}"\n`;
+            }
+            if (probeHeaderName !== undefined) {
+                out += `#include "${probeHeaderName}"\n`;
+            }
+            if (qosHeaderName !== undefined) {
+                out += `#include "${qosHeaderName}"\n`;
+            }
             out += `#include <string.h>\n`;
             out += `\n`;
         
@@ -115,6 +175,37 @@ class TemplateARDynamic extends Template {
                     out += `    exos_dataset_handle_t ${dataset.varName};\n`;
                 }
             }
+
+            if (budget) {
+                out += `\n    //work budget per cycle, see processWorkBudget()\n`;
+                out += `    int32_t budget_start;\n`;
+                out += `    UDINT budget_bytes;\n`;
+                out += `    UDINT budget_next;\n`;
+                for (let dataset of template.datasets) {
+                    if (dataset.isSub) {
+                        out += `    BOOL ${dataset.varName}_received;\n`;
+                    }
+                }
+            }
+            if (probeHeaderName !== undefined) {
+                out += `\n    //round trip probe to the Linux application, see ${probeHeaderName}\n`;
+                out += `    exos_probe_t probe;\n`;
+            }
+            if (template.groups.length > 0) {
+                out += `\n    //publish groups, see exos_group_t\n`;
+                for (let group of template.groups) {
+                    out += `    exos_group_t group_${group.name};\n`;
+                }
+            }
+            if (qosHeaderName !== undefined) {
+                out += `\n    //quality of service from the .typ annotations, see ${qosHeaderName}\n`;
+                for (let dataset of qosDatasets) {
+                    out += `    exos_qos_t ${dataset.varName}_qos;\n`;
+                    if (dataset.qos.filters.length > 0) {
+                        out += `    ${Template.qosDeadbandPrefix(template, dataset)}_t ${dataset.varName}_deadband;\n`;
+                    }
+                }
+            }
         
             out += `} ${template.handle.dataType};\n\n`;
             return out;
@@ -146,11 +237,50 @@ class TemplateARDynamic extends Template {
                     }
                     out += `if(0 == strcmp(dataset->name, "${dataset.structName}"))\n`;
                     out += `        {\n`;
-                    if(Datamodel.isScalarType(dataset) && (dataset.arraySize == 0)) {
-                        out += `            inst->p${template.datamodel.structName}->${dataset.structName} = *(${dataset.dataType} *)dataset->data;\n`;
+                    let group = Template.datasetGroup(template, dataset);
+                    if (group !== undefined && group.tag === dataset) {
+                        out += `            //publish group ${group.name}: deliver the members to p${template.datamodel.structName} if all of them were received before this tag\n`;
+                        out += `            if (exos_group_tag(&${template.handle.name}->group_${group.name}, ${template.handle.name}->data.${dataset.structName}))\n`;
+                        out += `            {\n`;
+                        for (let member of group.members) {
+                            out += `                memcpy(&inst->p${template.datamodel.structName}->${member.structName}, &${template.handle.name}->data.${member.structName}, sizeof(${template.handle.name}->data.${member.structName}));\n`;
+                        }
+                        out += `                inst->p${template.datamodel.structName}->${dataset.structName} = ${template.handle.name}->data.${dataset.structName};\n`;
+                        out += `            }\n`;
+                    }
+                    else if (group !== undefined) {
+                        out += `            //publish group ${group.name}: member received, delivered when the tag arrives\n`;
+                        out += `            exos_group_received(&${template.handle.name}->group_${group.name}, ${group.members.indexOf(dataset)});\n`;
                     }
                     else {
-                        out += `            memcpy(&inst->p${template.datamodel.structName}->${dataset.structName}, dataset->data, dataset->size);\n`;
+                        if (dataset.qos !== undefined && dataset.qos.deadband > 0) {
+                            out += `            //quality of service: skip updates within the deadband\n`;
+                            out += `            if (!exos_qos_deadband(&${template.handle.name}->${dataset.varName}_qos, (double)${template.handle.name}->data.${dataset.structName}))\n`;
+                            out += `            {\n`;
+                            out += `                break;\n`;
+                            out += `            }\n`;
+                        }
+                        if (dataset.qos !== undefined && dataset.qos.filters.length > 0) {
+                            out += `            //quality of service: skip updates where only members within their deadband changed\n`;
+                            out += `            if (!${Template.qosDeadbandPrefix(template, dataset)}_filter(&${template.handle.name}->${dataset.varName}_deadband, &${template.handle.name}->${dataset.varName}_qos, &${template.handle.name}->data.${dataset.structName}))\n`;
+                            out += `            {\n`;
+                            out += `                break;\n`;
+                            out += `            }\n`;
+                        }
+                        if (budget) {
+                            out += `            //delivered to p${template.datamodel.structName} within the work budget of the Cyclic FUB\n`;
+                            out += `            ${template.handle.name}->${dataset.varName}_received = true;\n`;
+                        }
+                        else if (dataset.qos !== undefined && dataset.qos.latest) {
+                            out += `            //quality of service: the latest value is delivered to p${template.datamodel.structName} in the Cyclic FUB\n`;
+                            out += `            ${template.handle.name}->${dataset.varName}_qos.changed = true;\n`;
+                        }
+                        else if(Datamodel.isScalarType(dataset) && (dataset.arraySize == 0)) {
+                            out += `            inst->p${template.datamodel.structName}->${dataset.structName} = *(${dataset.dataType} *)dataset->data;\n`;
+                        }
+                        else {
+                            out += `            memcpy(&inst->p${template.datamodel.structName}->${dataset.structName}, dataset->data, dataset->size);\n`;
+                        }
                     }
                     out += `        }\n`;
                 }
@@ -251,6 +381,9 @@ class TemplateARDynamic extends Template {
             out += `        }\n`;
             out += `        break;\n`;
             out += `    case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:\n`;
+            out += `        INFO("application sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);\n\n`;
+            out += `        inst->InSync = datamodel->sync_info.in_sync;\n`;
+            out += `        inst->SyncChanges++;\n`;
             out += `        break;\n\n`;
             out += `    default:\n`;
             out += `        break;\n\n`;
@@ -296,6 +429,21 @@ class TemplateARDynamic extends Template {
                     out += `    EXOS_ASSERT_OK(exos_dataset_init(${dataset.varName}, ${template.datamodel.varName}, "${dataset.structName}", &${template.handle.name}->data.${dataset.structName}, sizeof(${template.handle.name}->data.${dataset.structName})));\n`;
                 }
             }
+            for (let group of template.groups) {
+                out += `    exos_group_init(&${template.handle.name}->group_${group.name}, ${group.members.length});\n`;
+            }
+            if (qosHeaderName !== undefined) {
+                out += `    //quality of service from the .typ annotations: rate (us), latest, deadband, relative, hysteresis\n`;
+                for (let dataset of qosDatasets) {
+                    out += `    exos_qos_init(&${template.handle.name}->${dataset.varName}_qos, ${dataset.qos.rate}, ${dataset.qos.latest}, ${dataset.qos.deadband}, ${dataset.qos.relative}, ${dataset.qos.hysteresis});\n`;
+                    if (dataset.qos.filters.length > 0) {
+                        out += `    ${Template.qosDeadbandPrefix(template, dataset)}_init(&${template.handle.name}->${dataset.varName}_deadband);\n`;
+                    }
+                }
+            }
+            if (probeHeaderName !== undefined) {
+                out += `    EXOS_ASSERT_OK(exos_probe_init(&${template.handle.name}->probe));\n`;
+            }
             out += `    \n`;
             out += `    inst->Handle = (UDINT)${template.handle.name};\n`;
             out += `}\n\n`;
@@ -325,7 +473,9 @@ class TemplateARDynamic extends Template {
             out += `        return;\n`;
             out += `    }\n\n`;
         
-            out += `    ${template.datamodel.dataType} *data = &${template.handle.name}->data;\n`;
+            if (!budget || template.groups.some(group => group.isPub)) {
+                out += `    ${template.datamodel.dataType} *data = &${template.handle.name}->data;\n`;
+            }
             out += `    exos_datamodel_handle_t *${template.datamodel.varName} = &${template.handle.name}->${template.datamodel.varName};\n`;
             out += `    //the user context of the datamodel points to the ${template.datamodel.structName}Cyclic instance\n`;
             out += `    ${template.datamodel.varName}->user_context = inst; //set it cyclically in case the program using the FUB is retransferred\n`;
@@ -361,7 +511,14 @@ class TemplateARDynamic extends Template {
             out += `        inst->Disconnected = 1;\n`;
             out += `        inst->Connected = 0;\n`;
             out += `        inst->Operational = 0;\n`;
-            out += `        inst->Aborted = 0;\n\n`;
+            out += `        inst->Aborted = 0;\n`;
+            out += `        inst->InSync = 0;\n\n`;
+            if (budget) {
+                out += `        inst->CycleTime = 0;\n`;
+                out += `        inst->CycleBytes = 0;\n`;
+                out += `        inst->PeakCycleTime = 0;\n`;
+                out += `        inst->Deferred = 0;\n\n`;
+            }
             out += `        if (inst->Enable)\n`;
             out += `        {\n`;
             out += `            inst->_state = 10;\n`;
@@ -386,6 +543,9 @@ class TemplateARDynamic extends Template {
                     out += `        EXOS_ASSERT_OK(exos_dataset_connect(${dataset.varName}, EXOS_DATASET_PUBLISH, datasetEvent));\n`;
                 }   
             }
+            if (probeHeaderName !== undefined) {
+                out += `        EXOS_ASSERT_OK(exos_probe_connect(&${template.handle.name}->probe));\n`;
+            }
             out += `\n        inst->Active = true;\n`;
             out += `        break;\n\n`;
         
@@ -396,6 +556,9 @@ class TemplateARDynamic extends Template {
             out += `            if (inst->_state == 100)\n`;
             out += `            {\n`;
             out += `                EXOS_ASSERT_OK(exos_datamodel_set_operational(${template.datamodel.varName}));\n`;
+            if (probeHeaderName !== undefined) {
+                out += `                EXOS_ASSERT_OK(exos_probe_set_operational(&${template.handle.name}->probe));\n`;
+            }
             out += `                inst->_state = 101;\n`;
             out += `            }\n`;
             out += `        }\n`;
@@ -403,16 +566,81 @@ class TemplateARDynamic extends Template {
             out += `        {\n`;
             out += `            inst->_state = 100;\n`;
             out += `        }\n\n`;
+            if (budget) {
+                out += `        ${template.handle.name}->budget_start = exos_datamodel_get_nettime(${template.datamodel.varName});\n`;
+            }
             out += `        EXOS_ASSERT_OK(exos_datamodel_process(${template.datamodel.varName}));\n`;
+            out += `        inst->InSync = ${template.datamodel.varName}->sync_info.in_sync;\n`;
+            out += `        inst->MissedDmrCycles = ${template.datamodel.varName}->sync_info.missed_dmr_cycles;\n`;
+            out += `        inst->MissedArCycles = ${template.datamodel.varName}->sync_info.missed_ar_cycles;\n`;
+            if (probeHeaderName !== undefined) {
+                out += `\n`;
+                out += `        //round trip probe: echo of the Linux application, and the next request after ProbePeriod\n`;
+                out += `        EXOS_ASSERT_OK(exos_probe_process(&${template.handle.name}->probe, inst->ProbePeriod));\n`;
+                out += `        inst->ProbeRequests = ${template.handle.name}->probe.stats.requests;\n`;
+                out += `        inst->ProbeReplies = ${template.handle.name}->probe.stats.replies;\n`;
+                out += `        inst->ProbeLost = ${template.handle.name}->probe.stats.lost;\n`;
+                out += `        inst->ProbeRtt = ${template.handle.name}->probe.stats.rtt;\n`;
+                out += `        inst->ProbeRttMin = ${template.handle.name}->probe.stats.rtt_min;\n`;
+                out += `        inst->ProbeRttMax = ${template.handle.name}->probe.stats.rtt_max;\n`;
+                out += `        inst->ProbeRttAvg = ${template.handle.name}->probe.stats.rtt_avg;\n`;
+                out += `        inst->ProbeUplink = ${template.handle.name}->probe.stats.uplink;\n`;
+                out += `        inst->ProbeDownlink = ${template.handle.name}->probe.stats.downlink;\n`;
+            }
+            let dispatch = budget ? [] : qosDatasets.filter(dataset => dataset.qos.latest);
+            if (dispatch.length > 0) {
+                out += `        //quality of service: conflated updates, in order of priority\n`;
+                for (let dataset of dispatch) {
+                    out += `        if (exos_qos_dispatch(&${template.handle.name}->${dataset.varName}_qos))\n`;
+                    out += `        {\n`;
+                    out += `            memcpy(&inst->p${template.datamodel.structName}->${dataset.structName}, &${template.handle.name}->data.${dataset.structName}, sizeof(${template.handle.name}->data.${dataset.structName}));\n`;
+                    out += `        }\n`;
+                }
+                out += `\n`;
+            }
             out += `        //put your cyclic code here!\n\n`;
-            for (let dataset of template.datasets) {
-                if (dataset.isPub) {        
+            let flush = qosDatasets.filter(dataset => dataset.qos.rate > 0);
+            if (flush.length > 0) {
+                out += `        //quality of service: deferred publishes, in order of priority\n`;
+                for (let dataset of flush) {
+                    out += `        if (exos_qos_flush(&${template.handle.name}->${dataset.varName}_qos, exos_datamodel_get_nettime(${template.datamodel.varName})))\n`;
+                    out += `        {\n`;
+                    out += `            exos_dataset_publish(${dataset.varName});\n`;
+                    out += `        }\n`;
+                }
+                out += `\n`;
+            }
+            if (budget) {
+                out += `        //deliver received and publish changed datasets within the work budget\n`;
+                out += `        processWorkBudget(inst, ${template.handle.name});\n`;
+            }
+            for (let group of template.groups) {
+                if (group.isPub) {
+                    let changed = group.members.map(member => (Datamodel.isScalarType(member) && member.arraySize == 0)
+                        ? `(inst->p${template.datamodel.structName}->${member.structName} != data->${member.structName})`
+                        : `(0 != memcmp(&inst->p${template.datamodel.structName}->${member.structName}, &data->${member.structName}, sizeof(data->${member.structName})))`);
+                    out += `        //publish group ${group.name} as soon as a member changed: all members, then the next sequence number in ${group.tag.structName}\n`;
+                    out += `        if (${changed.join("\n            || ")})\n`;
+                    out += `        {\n`;
+                    for (let member of group.members) {
+                        out += `            memcpy(&data->${member.structName}, &inst->p${template.datamodel.structName}->${member.structName}, sizeof(data->${member.structName}));\n`;
+                        out += `            exos_dataset_publish(${member.varName});\n`;
+                    }
+                    out += `            data->${group.tag.structName} = exos_group_next(&${template.handle.name}->group_${group.name});\n`;
+                    out += `            inst->p${template.datamodel.structName}->${group.tag.structName} = data->${group.tag.structName};\n`;
+                    out += `            exos_dataset_publish(${group.tag.varName});\n`;
+                    out += `        }\n`;
+                }
+            }
+            //in order of priority, datasets without annotations are NORMAL
+            for (let dataset of priorityOrder(template.datasets)) {
+                if (dataset.isPub && !budget && Template.datasetGroup(template, dataset) === undefined) {        
                     if(Datamodel.isScalarType(dataset) && (dataset.arraySize == 0)) {
                         out += `        //publish the ${dataset.varName} dataset as soon as there are changes\n`;
                         out += `        if (inst->p${template.datamodel.structName}->${dataset.structName} != data->${dataset.structName})\n`;
                         out += `        {\n`;
                         out += `            data->${dataset.structName} = inst->p${template.datamodel.structName}->${dataset.structName};\n`;
-                        out += `            exos_dataset_publish(${dataset.varName});\n`;
+                        out += generatePublish(template, dataset, `            `, dataset.varName, template.datamodel.varName);
                         out += `        }\n`;
                     } 
                     else {
@@ -420,7 +648,7 @@ class TemplateARDynamic extends Template {
                         out += `        if (0 != memcmp(&inst->p${template.datamodel.structName}->${dataset.structName}, &data->${dataset.structName}, sizeof(data->${dataset.structName})))\n`;
                         out += `        {\n`;
                         out += `            memcpy(&data->${dataset.structName}, &inst->p${template.datamodel.structName}->${dataset.structName}, sizeof(data->${dataset.structName}));\n`;
-                        out += `            exos_dataset_publish(${dataset.varName});\n`;
+                        out += generatePublish(template, dataset, `            `, dataset.varName, template.datamodel.varName);
                         out += `        }\n`;
                     }
                 }   
@@ -428,7 +656,11 @@ class TemplateARDynamic extends Template {
             out += `\n        break;\n\n`;
             out += `    case 255:\n`;
             out += `        //disconnect the datamodel\n`;
-            out += `        EXOS_ASSERT_OK(exos_datamodel_disconnect(${template.datamodel.varName}));\n\n`;
+            out += `        EXOS_ASSERT_OK(exos_datamodel_disconnect(${template.datamodel.varName}));\n`;
+            if (probeHeaderName !== undefined) {
+                out += `        EXOS_ASSERT_OK(exos_probe_disconnect(&${template.handle.name}->probe));\n`;
+            }
+            out += `\n`;
             out += `        inst->Active = false;\n`;
             out += `        inst->_state = 254;\n`;
             out += `        //no break\n\n`;
@@ -466,6 +698,14 @@ class TemplateARDynamic extends Template {
             out += `    exos_datamodel_handle_t *${template.datamodel.varName} = &${template.handle.name}->${template.datamodel.varName};\n`;
             out += `\n`;
             out += `    EXOS_ASSERT_OK(exos_datamodel_delete(${template.datamodel.varName}));\n\n`;
+            if (probeHeaderName !== undefined) {
+                out += `    if (${template.handle.name}->probe.stats.requests > 0)\n`;
+                out += `    {\n`;
+                out += `        INFO("probe: %u requests, %u replies, %u lost, round trip %d/%d/%d us (min/avg/max)", ${template.handle.name}->probe.stats.requests, ${template.handle.name}->probe.stats.replies, ${template.handle.name}->probe.stats.lost,\n`;
+                out += `             ${template.handle.name}->probe.stats.rtt_min, ${template.handle.name}->probe.stats.rtt_avg, ${template.handle.name}->probe.stats.rtt_max);\n`;
+                out += `    }\n`;
+                out += `    EXOS_ASSERT_OK(exos_probe_delete(&${template.handle.name}->probe));\n\n`;
+            }
         
             out += `    //finish with deleting the log\n`;
             out += `    exos_log_delete(&${template.handle.name}->${template.logname});\n`;
@@ -477,6 +717,128 @@ class TemplateARDynamic extends Template {
             return out;
         }        
 
+        /**
+         * @param {ApplicationTemplate} template 
+         * @returns {string}
+         */
+        function generateBudget(template) {
+            let out = "";
+            let model = template.datamodel.structName;
+            let items = template.datasets.filter(dataset => (dataset.isSub || dataset.isPub) && Template.datasetGroup(template, dataset) === undefined);
+
+            for (let dataset of items) {
+                let scalar = Datamodel.isScalarType(dataset) && (dataset.arraySize == 0);
+                let fub = `inst->p${model}->${dataset.structName}`;
+                let data = `${template.handle.name}->data.${dataset.structName}`;
+
+                out += `//${dataset.structName}: returns true if there is work pending (used for counting the deferred datasets)\n`;
+                out += `static BOOL pending${dataset.structName}(struct ${model}Cyclic *inst, ${template.handle.dataType} *${template.handle.name})\n{\n`;
+                let pending = [];
+                if (dataset.isSub) pending.push(`${template.handle.name}->${dataset.varName}_received`);
+                if (dataset.isPub) pending.push(scalar ? `(${fub} != ${data})` : `(0 != memcmp(&${fub}, &${data}, sizeof(${data})))`);
+                out += `    return ${pending.join(" || ")};\n`;
+                out += `}\n\n`;
+
+                out += `//${dataset.structName}: deliver and publish, returns the number of bytes copied\n`;
+                out += `static UDINT process${dataset.structName}(struct ${model}Cyclic *inst, ${template.handle.dataType} *${template.handle.name})\n{\n`;
+                out += `    UDINT bytes = 0;\n\n`;
+                if (dataset.isSub) {
+                    out += `    if (${template.handle.name}->${dataset.varName}_received)\n`;
+                    out += `    {\n`;
+                    out += `        ${template.handle.name}->${dataset.varName}_received = false;\n`;
+                    if (scalar) {
+                        out += `        ${fub} = ${data};\n`;
+                    }
+                    else {
+                        out += `        memcpy(&${fub}, &${data}, sizeof(${data}));\n`;
+                    }
+                    out += `        bytes += sizeof(${data});\n`;
+                    out += `    }\n`;
+                }
+                if (dataset.isPub) {
+                    out += `    //publish the ${dataset.varName} dataset as soon as there are changes\n`;
+                    if (scalar) {
+                        out += `    if (${fub} != ${data})\n`;
+                        out += `    {\n`;
+                        out += `        ${data} = ${fub};\n`;
+                    }
+                    else {
+                        out += `    if (0 != memcmp(&${fub}, &${data}, sizeof(${data})))\n`;
+                        out += `    {\n`;
+                        out += `        memcpy(&${data}, &${fub}, sizeof(${data}));\n`;
+                    }
+                    out += generatePublish(template, dataset, `        `, `&${template.handle.name}->${dataset.varName}`, `&${template.handle.name}->${template.datamodel.varName}`);
+                    out += `        bytes += sizeof(${data});\n`;
+                    out += `    }\n`;
+                }
+                out += `    return bytes;\n`;
+                out += `}\n\n`;
+            }
+
+            out += `//returns true if the time (us) or bytes of this cycle exceed BudgetTime or BudgetBytes (0 = no limit)\n`;
+            out += `static BOOL budgetExceeded(struct ${model}Cyclic *inst, ${template.handle.dataType} *${template.handle.name})\n{\n`;
+            out += `    UDINT elapsed = (UDINT)(exos_datamodel_get_nettime(&${template.handle.name}->${template.datamodel.varName}) - ${template.handle.name}->budget_start);\n\n`;
+            out += `    if (inst->BudgetTime > 0 && elapsed >= inst->BudgetTime)\n`;
+            out += `        return true;\n`;
+            out += `    if (inst->BudgetBytes > 0 && ${template.handle.name}->budget_bytes >= inst->BudgetBytes)\n`;
+            out += `        return true;\n`;
+            out += `    return false;\n`;
+            out += `}\n\n`;
+
+            out += `/* Deliver received and publish changed datasets until the budget of this cycle is exceeded.\n`;
+            out += `   exos_datamodel_process() is counted in the budget, but cannot be interrupted, so it is the work after it that is bounded.\n`;
+            out += `   At least one dataset is handled each cycle, starting with the one that was deferred first in the previous cycle (round-robin),\n`;
+            out += `   so that a dataset exceeding the budget on its own still gets through and no dataset is starved. */\n`;
+            out += `static void processWorkBudget(struct ${model}Cyclic *inst, ${template.handle.dataType} *${template.handle.name})\n{\n`;
+            out += `    const UDINT count = ${items.length};\n`;
+            out += `    UDINT i;\n`;
+            out += `    BOOL deferring = false;\n\n`;
+            out += `    ${template.handle.name}->budget_bytes = 0;\n`;
+            out += `    inst->Deferred = 0;\n\n`;
+            out += `    for (i = 0; i < count; i++)\n`;
+            out += `    {\n`;
+            out += `        UDINT item = (${template.handle.name}->budget_next + i) % count;\n\n`;
+            out += `        if (!deferring && i > 0 && budgetExceeded(inst, ${template.handle.name}))\n`;
+            out += `        {\n`;
+            out += `            deferring = true;\n`;
+            out += `        }\n\n`;
+            out += `        switch (item)\n`;
+            out += `        {\n`;
+            items.forEach((dataset, index) => {
+                out += `        case ${index}:\n`;
+                out += `            if (deferring)\n`;
+                out += `            {\n`;
+                out += `                if (pending${dataset.structName}(inst, ${template.handle.name}))\n`;
+                out += `                {\n`;
+                out += `                    if (0 == inst->Deferred)\n`;
+                out += `                        ${template.handle.name}->budget_next = item;\n`;
+                out += `                    inst->Deferred++;\n`;
+                out += `                }\n`;
+                out += `            }\n`;
+                out += `            else\n`;
+                out += `            {\n`;
+                out += `                ${template.handle.name}->budget_bytes += process${dataset.structName}(inst, ${template.handle.name});\n`;
+                out += `            }\n`;
+                out += `            break;\n`;
+            });
+            out += `        }\n`;
+            out += `    }\n\n`;
+            out += `    inst->CycleTime = (UDINT)(exos_datamodel_get_nettime(&${template.handle.name}->${template.datamodel.varName}) - ${template.handle.name}->budget_start);\n`;
+            out += `    inst->CycleBytes = ${template.handle.name}->budget_bytes;\n`;
+            out += `    if (inst->CycleTime > inst->PeakCycleTime)\n`;
+            out += `    {\n`;
+            out += `        inst->PeakCycleTime = inst->CycleTime;\n`;
+            out += `    }\n`;
+            out += `}\n\n`;
+
+            return out;
+        }
+
+        const budget = this.features.includes("budget");
+        const groupHeaderName = this.template.groups.length > 0 ? this.datamodel.groupFile.name : undefined;
+        const probeHeaderName = this.probe !== undefined ? this.probe.probeHeader.name : undefined;
+        const qosDatasets = Template.qosDatasets(this.template.datasets);
+        const qosHeaderName = qosDatasets.length > 0 ? this.datamodel.qosFile.name : undefined;
         let out = "";
     
         out += generateIncludes(this.template);
@@ -484,6 +846,10 @@ class TemplateARDynamic extends Template {
         out += generateHandle(this.template);
     
         out += generateCallbacks(this.template);
+
+        if (budget) {
+            out += generateBudget(this.template);
+        }
     
         out += generateInit(this.template);
     
@@ -537,6 +903,17 @@ class TemplateARDynamic extends Template {
             out += `    //Auto connect:\n`;
             out += `    //${template.datamodel.structName}Cyclic_0.Enable := ExComponentInfo_0.Operational; // Component has been deployed and started up successfully\n`;
             out += `    \n`;
+            if (budget) {
+                out += `    //Work budget per cycle (0 = no limit), datasets that do not fit are deferred to the next cycle:\n`;
+                out += `    //${template.datamodel.structName}Cyclic_0.BudgetTime := 200; // us, compare with CycleTime and PeakCycleTime\n`;
+                out += `    //${template.datamodel.structName}Cyclic_0.BudgetBytes := 4096; // compare with CycleBytes\n`;
+                out += `    \n`;
+            }
+            if (probe) {
+                out += `    //Round trip probe to the Linux application (0 = every 10 ms), compare ProbeRtt with ProbeRttMax and ProbeLost:\n`;
+                out += `    //${template.datamodel.structName}Cyclic_0.ProbePeriod := 100000; // us\n`;
+                out += `    \n`;
+            }
             out += `    ${template.datamodel.structName}Cyclic_0(Handle := ${template.datamodel.structName}Init_0.Handle, p${template.datamodel.structName} := ADR(${template.datamodel.structName}_0));\n`;
             out += `    \n`;
             out += `    ExComponentInfo_0(ExTargetLink := ADR(${template.targetName}), ExComponentLink := ADR(${template.aliasName}), Enable := TRUE);\n`;
@@ -553,6 +930,8 @@ class TemplateARDynamic extends Template {
         
             return out;
         }
+        const budget = this.features.includes("budget");
+        const probe = this.features.includes("probe");
         return generateIECProgramST(this.template);
     }
 
@@ -583,6 +962,13 @@ class TemplateARDynamic extends Template {
             out += `		Handle : UDINT;\n`;
             out += `		Start : BOOL;\n`;
             out += `		p${template.datamodel.structName} : REFERENCE TO ${template.datamodel.structName};\n`;
+            if (budget) {
+                out += `		BudgetTime : UDINT; (*Max. time (us) per cycle for processing the datasets, 0 = no limit*)\n`;
+                out += `		BudgetBytes : UDINT; (*Max. bytes per cycle delivered and published, 0 = no limit*)\n`;
+            }
+            if (probe) {
+                out += `		ProbePeriod : UDINT; (*Time (us) between round trip probes, 0 = 10000*)\n`;
+            }
             out += `	END_VAR\n`;
             out += `	VAR_OUTPUT\n`;
             out += `		Active : BOOL;\n`;
@@ -591,6 +977,27 @@ class TemplateARDynamic extends Template {
             out += `		Connected : BOOL;\n`;
             out += `		Operational : BOOL;\n`;
             out += `		Aborted : BOOL;\n`;
+            out += `		InSync : BOOL; (*Datamodel is in sync with the DMR*)\n`;
+            out += `		MissedDmrCycles : UDINT; (*Cycles missed by the DMR*)\n`;
+            out += `		MissedArCycles : UDINT; (*Cycles missed by AR*)\n`;
+            out += `		SyncChanges : UDINT; (*Number of sync state changes*)\n`;
+            if (budget) {
+                out += `		CycleTime : UDINT; (*Time (us) used in the last cycle*)\n`;
+                out += `		CycleBytes : UDINT; (*Bytes delivered and published in the last cycle*)\n`;
+                out += `		PeakCycleTime : UDINT; (*Max. CycleTime since enabled*)\n`;
+                out += `		Deferred : UDINT; (*Datasets with pending work deferred to the next cycle*)\n`;
+            }
+            if (probe) {
+                out += `		ProbeRequests : UDINT; (*Round trip probes sent*)\n`;
+                out += `		ProbeReplies : UDINT; (*Round trip probes echoed by Linux*)\n`;
+                out += `		ProbeLost : UDINT; (*Round trip probes not echoed before the next one*)\n`;
+                out += `		ProbeRtt : DINT; (*Last round trip time (us)*)\n`;
+                out += `		ProbeRttMin : DINT; (*Min. round trip time (us)*)\n`;
+                out += `		ProbeRttMax : DINT; (*Max. round trip time (us)*)\n`;
+                out += `		ProbeRttAvg : DINT; (*Average round trip time (us)*)\n`;
+                out += `		ProbeUplink : DINT; (*Last time (us) from AR to Linux, estimated from the nettime*)\n`;
+                out += `		ProbeDownlink : DINT; (*Last time (us) from Linux to AR, estimated from the nettime*)\n`;
+            }
             out += `	END_VAR\n`;
             out += `	VAR\n`;
             out += `		_state : USINT;\n`;
@@ -609,6 +1016,8 @@ class TemplateARDynamic extends Template {
         
             return out;
         }
+        const budget = this.features.includes("budget");
+        const probe = this.features.includes("probe");
         return generateFun(this.template);
     }
 }
@@ -95,6 +95,10 @@ class TemplateARStaticCLib extends TemplateStaticCLib {
             out += `		Connected : BOOL;\n`;
             out += `		Operational : BOOL;\n`;
             out += `		Error : BOOL;\n`;
+            out += `		InSync : BOOL; (*Datamodel is in sync with the DMR*)\n`;
+            out += `		MissedDmrCycles : UDINT; (*Cycles missed by the DMR*)\n`;
+            out += `		MissedArCycles : UDINT; (*Cycles missed by AR*)\n`;
+            out += `		SyncChanges : UDINT; (*Number of sync state changes*)\n`;
             out += `	END_VAR\n`;
             out += `	VAR\n`;
             out += `		_Handle : UDINT;\n`;
@@ -313,6 +317,10 @@ class TemplateARStaticCLib extends TemplateStaticCLib {
             out += `    }\n`;
             out += `    inst->Connected = ${template.datamodel.varName}->is_connected;\n`;
             out += `    inst->Operational = ${template.datamodel.varName}->is_operational;\n`;
+            out += `    inst->InSync = ${template.datamodel.varName}->is_in_sync;\n`;
+            out += `    inst->MissedDmrCycles = ${template.datamodel.varName}->missed_dmr_cycles;\n`;
+            out += `    inst->MissedArCycles = ${template.datamodel.varName}->missed_ar_cycles;\n`;
+            out += `    inst->SyncChanges = ${template.datamodel.varName}->sync_changes;\n`;
             out += `}\n\n`;
         
             out += `UINT _EXIT ProgramExit(unsigned long phase)\n`;
@@ -37,6 +37,12 @@ const {GeneratedFileObj} = require('../../../datamodel')
  * @property {BuildOptionsStaticLibrary} staticLibrary build options for creating a static library, if enabled, the `executable` will be linked to this library
  * @property {string} executableName name of the executable. default: `name`. in case `debPackage`is disabled, this file is copied out and needs to be added as existing file to the LinuxPackage
  * @property {string[]} sourceFiles list of source files used to build the executable. default: [] 
+ * @property {BuildOptionsTool[]} tools command line tools built along with the executable, e.g. the load generator of the `loadgen` feature. default: []
+ * 
+ * @typedef {Object} BuildOptionsTool
+ * @property {string} executableName name of the tool. it is copied out next to the build script, but not installed with the `debPackage`
+ * @property {string[]} sourceFiles list of source files used to build the tool
+ * @property {string} [linkLibraries] libraries linked in addition to the `linkLibraries` of the build options
  * 
  * @typedef {Object} BuildOptionsSWIGPython
  * @property {boolean} enable whether or not a SWIG python module should be created. mutually exclusive with `executable`, `js`, `python` and `napi`. default: `false`
@@ -58,9 +64,17 @@ const {GeneratedFileObj} = require('../../../datamodel')
  * @property {boolean} enable whether or not a nodejs module should be created. mutually exclusive with `executable`, `napi`, `python` , and `swigPython`. default: `false`
  * @property {boolean} includeNodeModules `true` if the `node_modules` folder should be added to the package. default: `true`
  * 
+ * @typedef {Object} BuildOptionsPGO
+ * @property {boolean} enable add the two-stage profile-guided optimization to the build script, run with `pgo` as third parameter, and generate the {@linkcode TemplateLinuxBuild.trainScript}. default: `false`
+ * @property {string} trainCommand shell commands of the training workload, run from the folder of the build script. It should do the same amount of work in every run, and run in the build environment. default: `""`
+ * @property {string} missingWorkload message of the build script when `pgo` is passed as third parameter, but `enable` is `false` as there is no such workload. default: `""` (`pgo` is ignored)
+ * @property {string} profileDirectory folder of the profile data, relative to the build script. default: `pgo`
+ * 
  * @typedef {Object} BuildOptions
  * @property {boolean} checkVersion add additional code in the build.sh to check the version of exos-data-eth against the first parameter passed to the build script (only if a parameter is passed). default: `true`
- * @property {string} buildType  `Debug` | `Release` | `RelWithDebInfo` | `MinSizeRel`. default: `Debug`
+ * @property {string} buildType build profile used if no profile is passed as second parameter to the build script: `Debug` | `Release` (with link time optimization) | `RelWithDebInfo` (with `-march` set to `march`). default: `Debug`
+ * @property {string} march CPU of the target for the `RelWithDebInfo` profile, overridden with `EXOS_MARCH` in the environment of the build script. default: `x86-64-v2`
+ * @property {BuildOptionsPGO} pgo build options for the profile-guided optimization of the `executable`, `swigPython` and `napi` builds
  * @property {string} linkLibraries set which libraries to link .default `zmq exos-api`
  * @property {BuildOptionsExecutable} executable build options for creating an executable
  * @property {BuildOptionsSWIGPython} swigPython build options for creating a SWIG python module
@@ -96,6 +110,12 @@ class TemplateLinuxBuild {
      */
     buildScript;
 
+    /**
+     * training workload of the profile-guided optimization, run by the build script. The contents of this file is generated with {@linkcode makeBuildFiles} if `pgo` is enabled
+     * @type {GeneratedFileObj}
+     */
+    trainScript;
+
     /**
      *  {@linkcode TemplateLinuxBuild} Linux Build template class
      * 
@@ -103,6 +123,7 @@ class TemplateLinuxBuild {
      * 
      * - {@linkcode CMakeLists} cmake build script
      * - {@linkcode buildScript} build shell script
+     * - {@linkcode trainScript} training workload of the profile-guided optimization (only with `pgo` enabled)
      * 
      * The file objects will have `name` and `description` at creation of the class.
      * 
@@ -113,11 +134,13 @@ class TemplateLinuxBuild {
         this.options = {
             checkVersion: true,
             buildType: "Debug",
+            march: "x86-64-v2",
             linkLibraries: "zmq exos-api",
             executable: {
                 enable: false,
                 executableName: name.toLowerCase(),
                 sourceFiles: [],
+                tools: [],
                 staticLibrary: {
                     enable: false,
                     libraryName: `lib${name.toLowerCase()}`,
@@ -144,6 +167,12 @@ class TemplateLinuxBuild {
                 enable: false,
                 includeNodeModules: true
             },
+            pgo: {
+                enable: false,
+                trainCommand: "",
+                missingWorkload: "",
+                profileDirectory: "pgo"
+            },
             debPackage: {
                 enable: true,
                 version: {
@@ -162,6 +191,7 @@ class TemplateLinuxBuild {
         }
         this.CMakeLists = {name:"CMakeLists.txt", contents:"", description:"CMake build file script"};
         this.buildScript = {name:"build.sh", contents:"", description:"build file shell script"};
+        this.trainScript = {name:"pgo_train.sh", contents:"", description:"profile-guided optimization training workload"};
     }
 
     /**
@@ -171,6 +201,19 @@ class TemplateLinuxBuild {
     makeBuildFiles() {
         this.CMakeLists.contents = this._generateCMakeLists();
         this.buildScript.contents = this._generateShBuild();
+        if(this.options.pgo.enable) {
+            this.trainScript.contents = this._generateShTrain();
+        }
+    }
+
+    /**
+     * @returns {boolean} whether sources are compiled, and the build profiles apply
+     */
+    _compiled() {
+        if(this.options.napi.enable) {
+            return true;
+        }
+        return !this.options.js.enable && (this.options.swigPython.enable || this.options.executable.enable);
     }
 
     /**
@@ -181,11 +224,16 @@ class TemplateLinuxBuild {
     _generateCMakeLists() {
         let out = "";
 
-        out += `cmake_minimum_required(VERSION 3.0)\n`;
+        out += `cmake_minimum_required(VERSION 3.9)\n`;
         out += `\n`;
         out += `project(${this.name.toLowerCase()})\n`;
         out += `\n`;
-        out += `set(CMAKE_BUILD_TYPE ${this.options.buildType})\n`;
+        if(this._compiled() && !this.options.napi.enable) {
+            out += this._generateCMakeProfiles();
+        }
+        else {
+            out += `set(CMAKE_BUILD_TYPE ${this.options.buildType})\n`;
+        }
 
         if(this.options.napi.enable) {
             
@@ -285,6 +333,20 @@ class TemplateLinuxBuild {
             if(linklibs != "")
                 out += `target_link_libraries(${this.options.executable.executableName} ${linklibs})\n`;
 
+            for (const tool of this.options.executable.tools) {
+                out += `\n`;
+                out += `add_executable(${tool.executableName}`;
+                for (const source of tool.sourceFiles) {
+                    out += ` ${source}`;
+                }
+                out += `)\n`;
+                out += `target_include_directories(${tool.executableName} PUBLIC ..)\n`;
+
+                let toollibs = [this.options.linkLibraries, tool.linkLibraries || ""].join(" ").trim();
+                if(toollibs != "")
+                    out += `target_link_libraries(${tool.executableName} ${toollibs})\n`;
+            }
+
             if(this.options.debPackage.enable) {
                 out += `\n`;
                 out += `install(TARGETS ${this.options.executable.executableName} RUNTIME DESTINATION ${this.options.debPackage.destination})\n`;
@@ -318,6 +380,56 @@ class TemplateLinuxBuild {
         return out;
     }
 
+    /**
+     * Build profile and profile-guided optimization of the CMake build, set by the build script
+     * 
+     * @returns {string} part of the `CMakeLists.txt` selecting the compiler and linker flags
+     */
+    _generateCMakeProfiles() {
+        let out = "";
+
+        out += `# Build profile, passed by build.sh: Debug, Release (with link time optimization)\n`;
+        out += `# or RelWithDebInfo (with -march=\${EXOS_MARCH} for the CPU of the target)\n`;
+        out += `set(EXOS_BUILD_PROFILE ${this.options.buildType} CACHE STRING "Debug, Release or RelWithDebInfo")\n`;
+        out += `set(EXOS_MARCH ${this.options.march} CACHE STRING "CPU of the target for RelWithDebInfo")\n`;
+        out += `set(CMAKE_BUILD_TYPE \${EXOS_BUILD_PROFILE})\n`;
+        out += `\n`;
+        out += `if(EXOS_BUILD_PROFILE STREQUAL "Release")\n`;
+        out += `    include(CheckIPOSupported)\n`;
+        out += `    check_ipo_supported(RESULT EXOS_LTO OUTPUT EXOS_LTO_ERROR)\n`;
+        out += `    if(EXOS_LTO)\n`;
+        out += `        set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)\n`;
+        out += `    else()\n`;
+        out += `        message(WARNING "Link time optimization is not supported: \${EXOS_LTO_ERROR}")\n`;
+        out += `    endif()\n`;
+        out += `elseif(EXOS_BUILD_PROFILE STREQUAL "RelWithDebInfo")\n`;
+        out += `    include(CheckCCompilerFlag)\n`;
+        out += `    check_c_compiler_flag(-march=\${EXOS_MARCH} EXOS_MARCH_SUPPORTED)\n`;
+        out += `    if(EXOS_MARCH_SUPPORTED)\n`;
+        out += `        add_compile_options(-march=\${EXOS_MARCH})\n`;
+        out += `    else()\n`;
+        out += `        message(WARNING "-march=\${EXOS_MARCH} is not supported by the compiler, set EXOS_MARCH to the CPU of the target")\n`;
+        out += `    endif()\n`;
+        out += `endif()\n`;
+
+        if(this.options.pgo.enable) {
+            out += `\n`;
+            out += `# Profile-guided optimization, passed by build.sh: none, generate (instrumented build) or use (build with the profile)\n`;
+            out += `set(EXOS_PGO none CACHE STRING "none, generate or use")\n`;
+            out += `set(EXOS_PGO_DIRECTORY \${CMAKE_CURRENT_SOURCE_DIR}/${this.options.pgo.profileDirectory})\n`;
+            out += `if(EXOS_PGO STREQUAL "generate")\n`;
+            out += `    add_compile_options(-fprofile-generate=\${EXOS_PGO_DIRECTORY} -fprofile-update=atomic)\n`;
+            out += `    set(CMAKE_EXE_LINKER_FLAGS "\${CMAKE_EXE_LINKER_FLAGS} -fprofile-generate=\${EXOS_PGO_DIRECTORY}")\n`;
+            out += `    set(CMAKE_MODULE_LINKER_FLAGS "\${CMAKE_MODULE_LINKER_FLAGS} -fprofile-generate=\${EXOS_PGO_DIRECTORY}")\n`;
+            out += `elseif(EXOS_PGO STREQUAL "use")\n`;
+            out += `    add_compile_options(-fprofile-use=\${EXOS_PGO_DIRECTORY} -fprofile-correction -Wno-missing-profile)\n`;
+            out += `endif()\n`;
+        }
+        out += `\n`;
+
+        return out;
+    }
+
     /**
      * Use the build `options` to configure the buildscript
      * 
@@ -363,6 +475,28 @@ class TemplateLinuxBuild {
             out += `\n`;
         }
 
+        if(this._compiled()) {
+            out += `# Build profile, passed as second parameter (after $(EXOS_VERSION) in the .exospkg BuildCommand Arguments):\n`;
+            out += `#   Debug           no optimization, with debug information\n`;
+            out += `#   Release         optimized with link time optimization\n`;
+            out += `#   RelWithDebInfo  optimized for the CPU of the target (EXOS_MARCH), with debug information\n`;
+            if(this.options.pgo.enable) {
+                out += `# Passing pgo as third parameter rebuilds with profile-guided optimization, trained with ${this.trainScript.name}\n`;
+            }
+            out += `BUILD_PROFILE=\${2:-${this.options.buildType}}\n`;
+            out += `case "$BUILD_PROFILE" in\n`;
+            out += `    Debug|Release|RelWithDebInfo) ;;\n`;
+            out += `    *)\n`;
+            out += `        echo "ERROR: Unknown build profile $BUILD_PROFILE, use Debug, Release or RelWithDebInfo"\n`;
+            out += `        exit 1\n`;
+            out += `        ;;\n`;
+            out += `esac\n`;
+            out += `EXOS_MARCH=\${EXOS_MARCH:-${this.options.march}}\n`;
+            out += `PACKAGE_DIR=$(pwd)\n`;
+            out += `echo "Build profile: $BUILD_PROFILE"\n`;
+            out += `\n`;
+        }
+
         if(this.options.napi.enable || this.options.js.enable) {
             
             out += `finalize() {\n`;
@@ -380,14 +514,26 @@ class TemplateLinuxBuild {
                 out += `rm -f l_*.node\n`;
             out += `rm -f *.deb\n\n`;
         
-            out += `npm install\n`;
-            out += `if [ "$?" -ne 0 ] ; then\n`;
-            out += `    cd build\n\n`;
-            out += `    finalize 2\n`;
-            out += `fi\n\n`;
-        
-            if (this.options.napi.enable)
-                out += `cp -f build/Release/l_*.node .\n\n`;
+            if (this.options.napi.enable) {
+                out += `# Build the module, the profile-guided optimization (none, generate or use) is passed as parameter\n`;
+                out += `compile() {\n`;
+                out += `    EXOS_PGO=$1 npm install\n`;
+                out += `    if [ "$?" -ne 0 ] ; then\n`;
+                out += `        cd build\n\n`;
+                out += `        finalize 2\n`;
+                out += `    fi\n\n`;
+                out += `    cp -f build/Release/l_*.node .\n`;
+                out += `}\n\n`;
+                out += `export EXOS_BUILD_PROFILE=$BUILD_PROFILE EXOS_MARCH\n\n`;
+                out += this._generateShCompile();
+            }
+            else {
+                out += `npm install\n`;
+                out += `if [ "$?" -ne 0 ] ; then\n`;
+                out += `    cd build\n\n`;
+                out += `    finalize 2\n`;
+                out += `fi\n\n`;
+            }
             
             if(this.options.napi.includeNodeModules || this.options.js.includeNodeModules) {
                 out += `mkdir -p node_modules #make sure the folder exists even if no submodules are needed\n\n`;
@@ -416,21 +562,44 @@ class TemplateLinuxBuild {
             out += `mkdir build > /dev/null 2>&1\n`;
             out += `rm -rf build/*\n\n`;
             out += `cd build\n\n`;
-            //cmake
-            if(this.options.swigPython.enable) {
-                out += `cmake -Wno-dev ..\n`;
+            if(this._compiled()) {
+                let cmake = this.options.swigPython.enable ? `cmake -Wno-dev` : `cmake`;
+                out += `# Build in the build folder, the profile-guided optimization (none, generate or use) is passed as parameter\n`;
+                out += `compile() {\n`;
+                out += `    rm -rf ./*\n`;
+                out += `    ${cmake} -DEXOS_BUILD_PROFILE=$BUILD_PROFILE -DEXOS_MARCH=$EXOS_MARCH${this.options.pgo.enable ? ` -DEXOS_PGO=$1` : ``} ..\n`;
+                out += `    if [ "$?" -ne 0 ] ; then\n`;
+                out += `        finalize 2\n`;
+                out += `    fi\n\n`;
+                out += `    make\n`;
+                out += `    if [ "$?" -ne 0 ] ; then\n`;
+                out += `        finalize 3\n`;
+                out += `    fi\n\n`;
+                if(this.options.swigPython.enable) {
+                    out += `    cp -f ${this.options.swigPython.soFileName} ..\n`;
+                    out += `    cp -f ${this.options.swigPython.pyFileName} ..\n`;
+                }
+                else {
+                    out += `    cp -f ${this.options.executable.executableName} ..\n`;
+                    for (const tool of this.options.executable.tools) {
+                        out += `    cp -f ${tool.executableName} ..\n`;
+                    }
+                }
+                out += `}\n\n`;
+                out += this._generateShCompile();
             }
             else {
+                //cmake
                 out += `cmake ..\n`;
+                //make
+                out += `if [ "$?" -ne 0 ] ; then\n`;
+                out += `    finalize 2\n`;
+                out += `fi\n\n`;
+                out += `make\n`;
+                out += `if [ "$?" -ne 0 ] ; then\n`;
+                out += `    finalize 3\n`;
+                out += `fi\n\n`;
             }
-            //make
-            out += `if [ "$?" -ne 0 ] ; then\n`;
-            out += `    finalize 2\n`;
-            out += `fi\n\n`;
-            out += `make\n`;
-            out += `if [ "$?" -ne 0 ] ; then\n`;
-            out += `    finalize 3\n`;
-            out += `fi\n\n`;
         }    
         
         //pack
@@ -442,17 +611,81 @@ class TemplateLinuxBuild {
             out += `cp -f ${this.options.debPackage.fileName} ..\n\n`;
         }
         
-        if(this.options.swigPython.enable) {
-            out += `cp -f ${this.options.swigPython.soFileName} ..\n\n`;
-            out += `cp -f ${this.options.swigPython.pyFileName} ..\n\n`;
+        if(!this._compiled() && this.options.executable.enable) {
+            out += `cp -f ${this.options.executable.executableName} ..\n\n`;
         }
-        else {
-            if(this.options.executable.enable) {
-                out += `cp -f ${this.options.executable.executableName} ..\n\n`;
+
+        out += `finalize 0\n`;
+
+        return out;
+    }
+
+    /**
+     * The compile step of the build script, calling the `compile()` function of the build script once,
+     * or three times with the training workload in between for the profile-guided optimization
+     * 
+     * @returns {string} part of the build script running the build
+     */
+    _generateShCompile() {
+        let out = "";
+
+        if(!this.options.pgo.enable) {
+            if(this.options.pgo.missingWorkload != "") {
+                out += `if [ "$3" = "pgo" ] ; then\n`;
+                out += `    echo "ERROR: ${this.options.pgo.missingWorkload}"\n`;
+                out += `    cd "$PACKAGE_DIR/build"\n`;
+                out += `    finalize 5\n`;
+                out += `fi\n\n`;
             }
+            out += `compile none\n\n`;
+            return out;
         }
 
-        out += `finalize 0\n`;
+        out += `# Run the training workload from the package folder, and get its CPU time in ms in PGO_CPU_TIME\n`;
+        out += `pgo_train() {\n`;
+        out += `    PGO_TIMES=$(cd "$PACKAGE_DIR" && sh ./${this.trainScript.name} 1>&2 && times)\n`;
+        out += `    if [ "$?" -ne 0 ] ; then\n`;
+        out += `        echo "ERROR: The training workload ${this.trainScript.name} failed"\n`;
+        out += `        cd "$PACKAGE_DIR/build"\n`;
+        out += `        finalize 5\n`;
+        out += `    fi\n`;
+        out += `    PGO_CPU_TIME=$(echo "$PGO_TIMES" | tail -n 1 | awk '{ split($1, u, /[ms]/); split($2, s, /[ms]/); printf "%d", (u[1] * 60 + u[2] + s[1] * 60 + s[2]) * 1000 }')\n`;
+        out += `}\n\n`;
+
+        out += `if [ "$3" = "pgo" ] ; then\n`;
+        out += `    echo "PGO: measuring the training workload without profile-guided optimization"\n`;
+        out += `    compile none\n`;
+        out += `    pgo_train\n`;
+        out += `    PGO_BASELINE=$PGO_CPU_TIME\n\n`;
+        out += `    echo "PGO: training the instrumented build"\n`;
+        out += `    rm -rf "$PACKAGE_DIR/${this.options.pgo.profileDirectory}"\n`;
+        out += `    compile generate\n`;
+        out += `    pgo_train\n\n`;
+        out += `    echo "PGO: measuring the training workload with profile-guided optimization"\n`;
+        out += `    compile use\n`;
+        out += `    pgo_train\n\n`;
+        out += `    echo "PGO: training workload CPU time $PGO_BASELINE ms without and $PGO_CPU_TIME ms with profile-guided optimization, speedup $(awk -v a=$PGO_BASELINE -v b=$PGO_CPU_TIME 'BEGIN { if (b > 0) printf "%.2fx", a / b; else print "unknown" }')"\n`;
+        out += `else\n`;
+        out += `    compile none\n`;
+        out += `fi\n\n`;
+
+        return out;
+    }
+
+    /**
+     * Use the `pgo` build options to create the training workload of the profile-guided optimization
+     * 
+     * @returns {string} `pgo_train.sh`: the contents of the training workload script
+     */
+    _generateShTrain() {
+        let out = "";
+
+        out += `#!/bin/sh\n\n`;
+        out += `# Training workload of the profile-guided optimization, run from this folder by ${this.buildScript.name} when pgo is passed as third parameter.\n`;
+        out += `# It runs three times: with the regular build, with the instrumented build recording the profile to ${this.options.pgo.profileDirectory}/,\n`;
+        out += `# and with the build optimized from that profile. The CPU time of the first and the last run gives the reported speedup,\n`;
+        out += `# so the workload should do the same amount of work in every run, and exit with 0 when done.\n\n`;
+        out += `${this.options.pgo.trainCommand}\n`;
 
         return out;
     }
@@ -7,8 +7,10 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-const { Template, ApplicationTemplate } = require('../template')
+const { Template, ApplicationTemplate, TemplateFeature } = require('../template')
 const { TemplateLinuxTermination } = require('./template_linux_termination');
+const { TemplateLinuxRealtime } = require('./template_linux_realtime');
+const { TemplateLinuxLoadgen } = require('./template_linux_loadgen');
 const { Datamodel, GeneratedFileObj } = require('../../../datamodel');
 
 class TemplateLinuxC extends Template {
@@ -18,6 +20,36 @@ class TemplateLinuxC extends Template {
      */
     termination;
 
+    /**
+     * only with the `rt` feature
+     * @type {TemplateLinuxRealtime}
+     */
+    realtime;
+
+    /**
+     * only with the `loadgen` feature
+     * @type {TemplateLinuxLoadgen}
+     */
+    loadgen;
+
+    /**
+     * main loop built on the event loop of {@linkcode termination} (`epoll` feature)
+     * @type {boolean}
+     */
+    eventLoop;
+
+    /**
+     * name of the process mode header, only with the `process` feature
+     * @type {string}
+     */
+    processHeaderName;
+
+    /**
+     * name of the quality of service header, only if the .typ file has QoS annotations
+     * @type {string}
+     */
+    qosHeaderName;
+
     /**
      * main sourcefile for the application
      * @type {GeneratedFileObj}
@@ -31,13 +63,37 @@ class TemplateLinuxC extends Template {
      * 
      * Using {@linkcode TemplateLinuxTermination}:
      * - `termination.terminationHeader` termination handling header
-     * - `termination.terminationSource` termination handling source code
+     * - `termination.terminationSource` termination handling source code, with the `epoll` feature including the event loop
+     * 
+     * Using {@linkcode TemplateLinuxRealtime} (only with the `rt` feature):
+     * - `realtime.realtimeHeader` real-time execution profile header
+     * - `realtime.realtimeSource` real-time execution profile source code
+     * 
+     * Using {@linkcode TemplateLinuxLoadgen} (only with the `loadgen` feature):
+     * - `loadgen.loadgenSource` load generator, built as a separate executable
+     * 
+     * Datasets with QoS annotations in the .typ file use the `Datamodel.qosFile` header: deadband and latest-value conflation in the
+     * `datasetEvent()` callback, and a `publish_<dataset>()` function rate limiting the publishes, flushed in the main loop
      * 
      * @param {Datamodel} datamodel
+     * @param {TemplateFeature[]} [features] optional features to generate
      */
-    constructor(datamodel) {
-        super(datamodel, true);
-        this.termination = new TemplateLinuxTermination();
+    constructor(datamodel, features) {
+        super(datamodel, true, undefined, features);
+        this.eventLoop = datamodel != undefined && this.features.includes("epoll");
+        if (datamodel != undefined && this.features.includes("process")) {
+            this.processHeaderName = this.datamodel.processFile.name;
+        }
+        if (datamodel != undefined && Template.qosDatasets(this.template.datasets).length > 0) {
+            this.qosHeaderName = this.datamodel.qosFile.name;
+        }
+        this.termination = new TemplateLinuxTermination(this.eventLoop);
+        if (datamodel != undefined && this.features.includes("rt")) {
+            this.realtime = new TemplateLinuxRealtime();
+        }
+        if (datamodel != undefined && this.features.includes("loadgen")) {
+            this.loadgen = new TemplateLinuxLoadgen(datamodel);
+        }
 
         if (datamodel == undefined) {
             this.mainSource = {name:`main.c`, contents:this._generateSourceNoDatamodel(), description:"Linux application"};
@@ -81,34 +137,60 @@ class TemplateLinuxC extends Template {
     _generateSource() {
         /**
          * @param {ApplicationTemplate} template 
+         * @param {string} [processHeaderName] implement the process modes using this header
+         * @param {string} [qosHeaderName] implement the quality of service using this header
          * @returns {string}
          */
-        function generateIncludes(template) {
+        function generateIncludes(template, processHeaderName, qosHeaderName) {
             let out = "";
         
             out += `#define EXOS_ASSERT_LOG &${template.logname}\n`;
             out += `#include "exos_log.h"\n`;
-            out += `#include "${template.headerName}"\n\n`;
+            out += `#include "${template.headerName}"\n`;
+            if (processHeaderName !== undefined) {
+                out += `#include "${processHeaderName}"\n`;
+            }
+            if (qosHeaderName !== undefined) {
+                out += `#include "${qosHeaderName}"\n`;
+            }
+            out += `\n`;
         
             out += `#define SUCCESS(_format_, ...) exos_log_success(&${template.logname}, EXOS_LOG_TYPE_USER, _format_, ##__VA_ARGS__);\n`;
             out += `#define INFO(_format_, ...) exos_log_info(&${template.logname}, EXOS_LOG_TYPE_USER, _format_, ##__VA_ARGS__);\n`;
             out += `#define VERBOSE(_format_, ...) exos_log_debug(&${template.logname}, EXOS_LOG_TYPE_USER + EXOS_LOG_TYPE_VERBOSE, _format_, ##__VA_ARGS__);\n`;
             out += `#define ERROR(_format_, ...) exos_log_error(&${template.logname}, _format_, ##__VA_ARGS__);\n`;
-            out += `\nexos_log_handle_t ${template.logname};\n\n`;
+            out += `\nexos_log_handle_t ${template.logname};\n`;
+            if (processHeaderName !== undefined) {
+                out += `exos_process_t process;\n`;
+            }
+            if (qosHeaderName !== undefined) {
+                out += `\n//quality of service from the .typ annotations, see ${qosHeaderName}\n`;
+                for (let dataset of Template.qosDatasets(template.datasets)) {
+                    out += `exos_qos_t ${dataset.varName}_qos;\n`;
+                    if (dataset.qos.filters.length > 0) {
+                        out += `${Template.qosDeadbandPrefix(template, dataset)}_t ${dataset.varName}_deadband;\n`;
+                    }
+                }
+            }
+            out += `\n`;
         
             return out;
         }
         
         /**
          * @param {ApplicationTemplate} template 
+         * @param {boolean} processModes measure the latency of the received datasets
          * @returns {string}
          */
-        function generateCallbacks(template) {
+        function generateCallbacks(template, processModes) {
             let out = "";
             out += `static void datasetEvent(exos_dataset_handle_t *dataset, EXOS_DATASET_EVENT_TYPE event_type, void *info)\n{\n`;
             out += `    switch (event_type)\n    {\n`;
             out += `    case EXOS_DATASET_EVENT_UPDATED:\n`;
             out += `        VERBOSE("dataset %s updated! latency (us):%i", dataset->name, (exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime));\n`;
+            if (processModes) {
+                out += `        exos_process_latency(&process, exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime);\n`;
+            }
             out += `        //handle each subscription dataset separately\n`;
             var atleastone = false;
             for (let dataset of template.datasets) {
@@ -122,7 +204,27 @@ class TemplateLinuxC extends Template {
                     }
                     out += `if(0 == strcmp(dataset->name,"${dataset.structName}"))\n`;
                     out += `        {\n`;
-                    out += `            ${Datamodel.convertPlcType(dataset.dataType)} *${dataset.varName} = (${Datamodel.convertPlcType(dataset.dataType)} *)dataset->data;\n`;
+                    if (dataset.qos !== undefined && dataset.qos.deadband > 0) {
+                        out += `            //quality of service: skip updates within the deadband\n`;
+                        out += `            if (!exos_qos_deadband(&${dataset.varName}_qos, (double)*(${Datamodel.convertPlcType(dataset.dataType)} *)dataset->data))\n`;
+                        out += `            {\n`;
+                        out += `                break;\n`;
+                        out += `            }\n`;
+                    }
+                    if (dataset.qos !== undefined && dataset.qos.filters.length > 0) {
+                        out += `            //quality of service: skip updates where only members within their deadband changed\n`;
+                        out += `            if (!${Template.qosDeadbandPrefix(template, dataset)}_filter(&${dataset.varName}_deadband, &${dataset.varName}_qos, (${Datamodel.convertPlcType(dataset.dataType)} *)dataset->data))\n`;
+                        out += `            {\n`;
+                        out += `                break;\n`;
+                        out += `            }\n`;
+                    }
+                    if (dataset.qos !== undefined && dataset.qos.latest) {
+                        out += `            //quality of service: the latest value is handled in the main loop\n`;
+                        out += `            ${dataset.varName}_qos.changed = true;\n`;
+                    }
+                    else {
+                        out += `            ${Datamodel.convertPlcType(dataset.dataType)} *${dataset.varName} = (${Datamodel.convertPlcType(dataset.dataType)} *)dataset->data;\n`;
+                    }
                     out += `        }\n`;
                 }
             }
@@ -210,21 +312,35 @@ class TemplateLinuxC extends Template {
             out += `        }\n`;
             out += `        break;\n`;
             out += `    case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:\n`;
+            out += `        INFO("application sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);\n`;
             out += `        break;\n\n`;
             out += `    default:\n`;
             out += `        break;\n\n`;
             out += `    }\n\n`;
            
             out += `}\n\n`;
+
+            for (let dataset of Template.qosDatasets(template.datasets)) {
+                if (dataset.qos.rate > 0) {
+                    out += `//quality of service: publish ${dataset.varName} with this instead of exos_dataset_publish(), publishes within the rate are deferred to the main loop\n`;
+                    out += `static inline void publish_${dataset.varName}(exos_dataset_handle_t *${dataset.varName})\n{\n`;
+                    out += `    if (exos_qos_publish(&${dataset.varName}_qos, exos_datamodel_get_nettime(${dataset.varName}->datamodel)))\n`;
+                    out += `    {\n`;
+                    out += `        EXOS_ASSERT_OK(exos_dataset_publish(${dataset.varName}));\n`;
+                    out += `    }\n`;
+                    out += `}\n\n`;
+                }
+            }
         
             return out;
         }
 
         /**
          * @param {ApplicationTemplate} template 
+         * @param {boolean} processModes select the process mode
          * @returns {string}
          */
-        function generateInit(template) {
+        function generateInit(template, processModes) {
             let out = "";
         
             out += `    ${template.datamodel.structName} data;\n\n`;
@@ -243,6 +359,23 @@ class TemplateLinuxC extends Template {
             out += `    //set the user_context to access custom data in the callbacks\n`;
             out += `    ${template.datamodel.varName}.user_context = NULL; //user defined\n`;
             out += `    ${template.datamodel.varName}.user_tag = 0; //user defined\n\n`;
+            if (processModes) {
+                out += `    //process mode: EXOS_PROCESS_BLOCKING (wait for the next DMR cycle), EXOS_PROCESS_NON_BLOCKING (for your own loop)\n`;
+                out += `    //or EXOS_PROCESS_ADAPTIVE (poll for a window in us after each DMR cycle, then wait). process.stats holds the measurements:\n`;
+                out += `    //cpu_load (percent) of this thread, latency_avg and latency_max (us) of the received datasets\n`;
+                out += `    exos_process_set_mode(&process, EXOS_PROCESS_BLOCKING, 0);\n\n`;
+            }
+            let qosDatasets = Template.qosDatasets(template.datasets);
+            if (qosDatasets.length > 0) {
+                out += `    //quality of service from the .typ annotations: rate (us), latest, deadband, relative, hysteresis\n`;
+                for (let dataset of qosDatasets) {
+                    out += `    exos_qos_init(&${dataset.varName}_qos, ${dataset.qos.rate}, ${dataset.qos.latest}, ${dataset.qos.deadband}, ${dataset.qos.relative}, ${dataset.qos.hysteresis});\n`;
+                    if (dataset.qos.filters.length > 0) {
+                        out += `    ${Template.qosDeadbandPrefix(template, dataset)}_init(&${dataset.varName}_deadband);\n`;
+                    }
+                }
+                out += `\n`;
+            }
         
             for (let dataset of template.datasets) {
                 if (dataset.isSub || dataset.isPub) {
@@ -276,12 +409,45 @@ class TemplateLinuxC extends Template {
 
         /**
          * @param {ApplicationTemplate} template 
+         * @param {boolean} realtime wait for the cycle of the real-time execution profile
+         * @param {boolean} processModes process in the selected process mode
          * @returns {string}
          */
-        function generateCyclic(template) {
+        function generateCyclic(template, realtime, processModes) {
             var out = "";
+            if (realtime) {
+                out += `        rt_wait_cycle();\n`;
+            }
+            let qosDatasets = Template.qosDatasets(template.datasets);
+            let flush = qosDatasets.filter(dataset => dataset.qos.rate > 0);
+            if (flush.length > 0) {
+                out += `        //quality of service: deferred publishes, in order of priority\n`;
+                for (let dataset of flush) {
+                    out += `        if (exos_qos_flush(&${dataset.varName}_qos, exos_datamodel_get_nettime(&${template.datamodel.varName})))\n`;
+                    out += `        {\n`;
+                    out += `            EXOS_ASSERT_OK(exos_dataset_publish(&${dataset.varName}));\n`;
+                    out += `        }\n`;
+                }
+            }
+            if (processModes) {
+                out += `        EXOS_ASSERT_OK(exos_process_begin(&process, &${template.datamodel.varName}));\n`;
+            }
             out += `        EXOS_ASSERT_OK(exos_datamodel_process(&${template.datamodel.varName}));\n`;
+            if (processModes) {
+                out += `        exos_process_end(&process);\n`;
+            }
             out += `        exos_log_process(&${template.logname});\n\n`;
+            let dispatch = qosDatasets.filter(dataset => dataset.qos.latest);
+            if (dispatch.length > 0) {
+                out += `        //quality of service: conflated updates, in order of priority\n`;
+                for (let dataset of dispatch) {
+                    out += `        if (exos_qos_dispatch(&${dataset.varName}_qos))\n`;
+                    out += `        {\n`;
+                    out += `            //handle the latest data.${dataset.structName} here\n`;
+                    out += `        }\n`;
+                }
+                out += `\n`;
+            }
             out += `        //put your cyclic code here!\n\n`;
         
             return out;
@@ -291,10 +457,16 @@ class TemplateLinuxC extends Template {
          * @param {ApplicationTemplate} template 
          * @returns {string}
          */
-        function generateExit(template) {
+        function generateExit(template, realtime, eventLoop) {
             var out = "";
         
             out += `\n`;
+            if (eventLoop) {
+                out += `    event_loop_close();\n`;
+            }
+            if (realtime) {
+                out += `    rt_report();\n\n`;
+            }
             out += `    EXOS_ASSERT_OK(exos_datamodel_delete(&${template.datamodel.varName}));\n\n`;
         
             out += `    //finish with deleting the log\n`;
@@ -307,22 +479,76 @@ class TemplateLinuxC extends Template {
         let out = "";
         out += `#include <unistd.h>\n`;
         out += `#include <string.h>\n`;
-        out += `#include "${this.termination.terminationHeader.name}"\n\n`;
-        out += generateIncludes(this.template);
+        out += `#include "${this.termination.terminationHeader.name}"\n`;
+        if (this.realtime != undefined) {
+            out += `#include "${this.realtime.realtimeHeader.name}"\n`;
+        }
+        out += `\n`;
+        out += generateIncludes(this.template, this.processHeaderName, this.qosHeaderName);
     
-        out += generateCallbacks(this.template);
+        out += generateCallbacks(this.template, this.processHeaderName !== undefined);
     
         //declarations
-        out += `int main()\n{\n`
+        if (this.realtime != undefined) {
+            out += `int main(int argc, char **argv)\n{\n`
+        }
+        else {
+            out += `int main()\n{\n`
+        }
     
-        out += generateInit(this.template);
+        out += generateInit(this.template, this.processHeaderName !== undefined);
     
         out += `    catch_termination();\n`;
+        if (this.realtime != undefined) {
+            out += `\n`;
+            out += `    //real-time execution profile, set with the command line arguments after the datamodel is connected (see ${this.realtime.realtimeHeader.name})\n`;
+            out += `    rt_setup(argc, argv);\n`;
+            if (!this.eventLoop) {
+                out += `    if (rt_cycle_time() > 0)\n`;
+                out += `    {\n`;
+                out += `        //the cycles are given by the timer\n`;
+                out += `        exos_process_set_mode(&process, EXOS_PROCESS_NON_BLOCKING, 0);\n`;
+                out += `    }\n`;
+            }
+        }
+        if (this.eventLoop) {
+            out += `\n`;
+            out += `    //termination, wakeups and your own file descriptors share one wait (see ${this.termination.terminationHeader.name}).\n`;
+            out += `    //exOS has no file descriptor for the DMR, so exos_datamodel_process() can't be part of that wait:\n`;
+            out += `    //without a cycle, the loop waits in the blocking exos_datamodel_process() so Ctrl-C, SIGTERM, wakeups and your file descriptors wait for the next DMR cycle.\n`;
+            out += `    //with a cycle, the loop waits in epoll and processes the datamodel non-blocking on the timer, polling the DMR every cycle\n`;
+            out += `    uint32_t cycle_time = 0; //us, e.g. 1000 to process the datamodel every 1000 us\n\n`;
+            out += `    event_loop_init();\n`;
+            if (this.realtime != undefined) {
+                out += `    if (rt_cycle_time() > 0)\n`;
+                out += `    {\n`;
+                out += `        exos_process_set_mode(&process, EXOS_PROCESS_NON_BLOCKING, 0);\n`;
+                out += `        event_loop_add(rt_timer_fd(), EPOLLIN, NULL, NULL);\n`;
+                out += `    }\n`;
+                out += `    else if (cycle_time > 0)\n`;
+            }
+            else {
+                out += `    if (cycle_time > 0)\n`;
+            }
+            out += `    {\n`;
+            out += `        exos_process_set_mode(&process, EXOS_PROCESS_NON_BLOCKING, 0);\n`;
+            out += `        event_loop_set_cycle(cycle_time);\n`;
+            out += `    }\n`;
+            out += `    //event_loop_add(fd, EPOLLIN, on_event, NULL); //sockets, timers, inotify watches ..\n\n`;
+        }
     
         //main loop
         out += `    while (true)\n    {\n`;
     
-        out += generateCyclic(this.template);
+        if (this.eventLoop) {
+            out += `        if (event_loop_wait())\n`;
+            out += `        {\n`;
+            out += generateCyclic(this.template, this.realtime != undefined, this.processHeaderName !== undefined).replace(/^ {8}/gm, "            ").replace(/\n\n$/, "\n");
+            out += `        }\n`;
+        }
+        else {
+            out += generateCyclic(this.template, this.realtime != undefined, this.processHeaderName !== undefined);
+        }
         out += `        if (is_terminated())\n`;
         out += `        {\n`;
         out += `            SUCCESS("${this.template.datamodel.structName} application terminated, closing..");\n`;
@@ -332,7 +558,7 @@ class TemplateLinuxC extends Template {
     
         //unregister
     
-        out += generateExit(this.template);
+        out += generateExit(this.template, this.realtime != undefined, this.eventLoop);
     
         out += `    return 0;\n`
         out += `}\n`
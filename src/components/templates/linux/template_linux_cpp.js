@@ -8,9 +8,14 @@
  */
 
 const { Datamodel, GeneratedFileObj } = require('../../../datamodel');
-const { Template, ApplicationTemplate } = require('../template')
+const { Template, ApplicationTemplate, TemplateFeature } = require('../template')
 const { TemplateLinuxTermination } = require('./template_linux_termination');
+const { TemplateLinuxRealtime } = require('./template_linux_realtime');
+const { TemplateLinuxLoadgen } = require('./template_linux_loadgen');
 const { TemplateCppLib } = require('../template_cpp_lib');
+const { TemplateLinuxMetrics } = require('./template_linux_metrics');
+const { TemplateLinuxTrace } = require('./template_linux_trace');
+const { TemplateLinuxProfile } = require('./template_linux_profile');
 
 class TemplateLinuxCpp extends TemplateCppLib {
 
@@ -19,6 +24,24 @@ class TemplateLinuxCpp extends TemplateCppLib {
      */
     termination;
 
+    /**
+     * only with the `rt` feature
+     * @type {TemplateLinuxRealtime}
+     */
+    realtime;
+
+    /**
+     * only with the `loadgen` feature
+     * @type {TemplateLinuxLoadgen}
+     */
+    loadgen;
+
+    /**
+     * main loop built on the event loop of {@linkcode termination} (`epoll` feature)
+     * @type {boolean}
+     */
+    eventLoop;
+
     /**
      * main sourcefile for the application
      * @type {GeneratedFileObj}
@@ -40,33 +63,152 @@ class TemplateLinuxCpp extends TemplateCppLib {
      * 
      * Using {@linkcode TemplateLinuxTermination}:
      * - `termination.terminationHeader` termination handling header
-     * - `termination.terminationSource` termination handling source code
+     * - `termination.terminationSource` termination handling source code, with the `epoll` feature including the event loop
+     * 
+     * Using {@linkcode TemplateSoa} (only with the `soa` feature):
+     * - `soa.soaHeader` structure-of-arrays mirrors
+     * 
+     * Using {@linkcode TemplateLinuxRealtime} (only with the `rt` feature):
+     * - `realtime.realtimeHeader` real-time execution profile header
+     * - `realtime.realtimeSource` real-time execution profile source code
+     * 
+     * Using {@linkcode TemplateLinuxLoadgen} (only with the `loadgen` feature):
+     * - `loadgen.loadgenSource` load generator, built as a separate executable
+     * 
+     * Using {@linkcode TemplateLinuxRecorder} (only with the `record` feature):
+     * - `recorder.recorderHeader` dataset traffic recorder header
+     * - `recorder.recorderSource` dataset traffic recorder source code
+     * 
+     * Using {@linkcode TemplateLinuxMirror} (only with the `mirror` feature):
+     * - `mirror.mirrorHeader` latest value mirror, with the read-only accessors for other processes
+     * 
+     * Using {@linkcode TemplateLinuxMetrics} (only with the `metrics` feature):
+     * - `metrics.metricsHeader` OpenMetrics exporter header
+     * - `metrics.metricsSource` OpenMetrics exporter source code
+     * 
+     * Using {@linkcode TemplateLinuxTrace} (only with the `trace` feature):
+     * - `trace.traceHeader` processing timeline trace header
+     * - `trace.traceSource` processing timeline trace source code
+     * 
+     * Using {@linkcode TemplateProbe} (only with the `probe` feature):
+     * - `probe.probeHeader` round trip probe answering the requests of the AR library
+     * 
+     * Using {@linkcode TemplateLinuxProfile} (only with the `profile` feature):
+     * - `profile.profileHeader` change-frequency profile of the dataset members
      * 
      * @param {Datamodel} datamodel
+     * @param {TemplateFeature[]} [features] optional features to generate
      */
-    constructor(datamodel) {
+    constructor(datamodel, features) {
         /**
          * @param {ApplicationTemplate} template 
          * @param {string} legend
          * @param {string} terminationHeaderName
+         * @param {string} [realtimeHeaderName] generate the real-time execution profile using this header
+         * @param {boolean} [eventLoop] main loop built on the event loop of the termination header
+         * @param {string} [recorderHeaderName] record the dataset traffic using this header
+         * @param {string} [metricsHeaderName] export the metrics using this header
+         * @param {string} [traceHeaderName] trace the processing timeline using this header
+         * @param {string} [profileHeaderName] profile the changes of the dataset members using this header
+         * @param {boolean} [processModes] show how to select the process mode
          */
-        function _generateMainLinux(template, legend, terminationHeaderName) {
+        function _generateMainLinux(template, legend, terminationHeaderName, realtimeHeaderName, eventLoop, recorderHeaderName, metricsHeaderName, traceHeaderName, profileHeaderName, processModes) {
             let out = "";
         
             out += `#include <string>\n`;
             out += `#include <csignal>\n`;
             out += `#include "${template.datamodel.className}.hpp"\n`;
             out += `#include "${terminationHeaderName}"\n`;
+            if (realtimeHeaderName !== undefined) {
+                out += `#include "${realtimeHeaderName}"\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `#include "${recorderHeaderName}"\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `#include "${metricsHeaderName}"\n`;
+            }
+            if (traceHeaderName !== undefined) {
+                out += `#include "${traceHeaderName}"\n`;
+            }
             out += `\n`;
             out += legend;
             out += `\n\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `// configuration of the datamodel (${template.headerName.replace(".h", ".c")}), used as schema of the recording\n`;
+                out += `extern "C" const char config_${template.datamodel.structName.toLowerCase()}[];\n`;
+                out += `\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `// the datasets in the metrics, in the order of the dataset index\n`;
+                out += TemplateLinuxMetrics.generateDatasetNames(template);
+                out += `\n`;
+            }
             out += `int main(int argc, char ** argv)\n`;
             out += `{\n`;            
             out += `    catch_termination();\n`;
             out += `    \n`;
+            if (recorderHeaderName !== undefined) {
+                out += `    // record the dataset traffic if started with --record <path>, replay a recording with --replay <path> (see ${recorderHeaderName})\n`;
+                out += `    rec_setup(argc, argv, config_${template.datamodel.structName.toLowerCase()});\n`;
+                out += `    rec_replay_setup(argc, argv, config_${template.datamodel.structName.toLowerCase()});\n`;
+                out += `    \n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `    // export the metrics if started with --metrics-port <port>, --metrics-socket <path> or --metrics-file <path> (see ${metricsHeaderName})\n`;
+                out += `    metrics_setup(argc, argv, "${template.datamodelInstanceName}", ${TemplateLinuxMetrics.datasetNamesArray(template)}, sizeof(${TemplateLinuxMetrics.datasetNamesArray(template)}) / sizeof(${TemplateLinuxMetrics.datasetNamesArray(template)}[0]));\n`;
+                out += `    \n`;
+            }
+            if (traceHeaderName !== undefined) {
+                out += `    // trace the processing timeline if started with --trace <path>, dumped on SIGUSR1 or above --trace-threshold <us> (see ${traceHeaderName})\n`;
+                out += `    trace_setup(argc, argv);\n`;
+                out += `    \n`;
+            }
             out += `    ${template.datamodel.className} ${template.datamodel.varName};\n`;
+            if (profileHeaderName !== undefined) {
+                out += `    // profile the changes of the dataset members if started with --profile <path>, reported when ${template.datamodel.varName} is destroyed (see ${profileHeaderName})\n`;
+                out += `    ${TemplateLinuxProfile.profilePrefix(template)}_setup(${template.datamodel.varName}.profile(), argc, argv);\n`;
+            }
             out += `    ${template.datamodel.varName}.connect();\n`;
+            if (processModes) {
+                out += `    // ${template.datamodel.varName}.setProcessMode(EXOS_PROCESS_ADAPTIVE, 500);\n`;
+            }
             out += `    \n`;
+            if (realtimeHeaderName !== undefined) {
+                out += `    // real-time execution profile, set with the command line arguments after the datamodel is connected (see ${realtimeHeaderName})\n`;
+                out += `    rt_setup(argc, argv);\n`;
+                if (!eventLoop) {
+                    out += `    if (rt_cycle_time() > 0) {\n`;
+                    out += `        // the cycles are given by the timer\n`;
+                    out += `        ${template.datamodel.varName}.setProcessMode(EXOS_PROCESS_NON_BLOCKING);\n`;
+                    out += `    }\n`;
+                }
+                out += `    \n`;
+            }
+            if (eventLoop) {
+                out += `    // termination, wakeups and your own file descriptors share one wait (see ${terminationHeaderName}).\n`;
+                out += `    // exOS has no file descriptor for the DMR, so process() can't be part of that wait:\n`;
+                out += `    // without a cycle, the loop waits in the blocking process() so Ctrl-C, SIGTERM, wakeups and your file descriptors wait for the next DMR cycle.\n`;
+                out += `    // with a cycle, the loop waits in epoll and processes the datamodel non-blocking on the timer, polling the DMR every cycle\n`;
+                out += `    uint32_t cycleTime = 0; // us, e.g. 1000 to process the datamodel every 1000 us\n`;
+                out += `    \n`;
+                out += `    event_loop_init();\n`;
+                if (realtimeHeaderName !== undefined) {
+                    out += `    if (rt_cycle_time() > 0) {\n`;
+                    out += `        ${template.datamodel.varName}.setProcessMode(EXOS_PROCESS_NON_BLOCKING);\n`;
+                    out += `        event_loop_add(rt_timer_fd(), EPOLLIN, NULL, NULL);\n`;
+                    out += `    }\n`;
+                    out += `    else if (cycleTime > 0) {\n`;
+                }
+                else {
+                    out += `    if (cycleTime > 0) {\n`;
+                }
+                out += `        ${template.datamodel.varName}.setProcessMode(EXOS_PROCESS_NON_BLOCKING);\n`;
+                out += `        event_loop_set_cycle(cycleTime);\n`;
+                out += `    }\n`;
+                out += `    // event_loop_add(fd, EPOLLIN, [] (int fd, uint32_t events, void *context) { ... }, nullptr); // sockets, timers, inotify watches ..\n`;
+                out += `    \n`;
+            }
             out += `    ${template.datamodel.varName}.onConnectionChange([&] () {\n`;
             out += `        if (${template.datamodel.varName}.connectionState == EXOS_STATE_CONNECTED) {\n`;
             out += `            // Datamodel connected\n`;
@@ -86,22 +228,62 @@ class TemplateLinuxCpp extends TemplateCppLib {
             }
             out += `\n`;
             out += `    while(!is_terminated()) {\n`;
+            if (eventLoop && recorderHeaderName !== undefined) {
+                out += `        // a replay is timed by process()\n`;
+                out += `        if (!rec_replaying() && !event_loop_wait())\n`;
+                out += `            continue;\n`;
+                out += `        \n`;
+            }
+            else if (eventLoop) {
+                out += `        if (!event_loop_wait())\n`;
+                out += `            continue;\n`;
+                out += `        \n`;
+            }
+            if (realtimeHeaderName !== undefined) {
+                out += `        rt_wait_cycle();\n`;
+                out += `        \n`;
+            }
             out += `        // trigger callbacks\n`;
             out += `        ${template.datamodel.varName}.process();\n`;
             out += `        \n`;
-            out += `        // publish datasets\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `        if (rec_replay_finished())\n`;
+                out += `            break;\n`;
+                out += `        \n`;
+            }
+            out += `        // publish datasets: modify() publishes once in the next process(), publish() immediately\n`;
             out += `        \n`;
             out += `        if (${template.datamodel.varName}.isConnected) {\n`;
             for (let dataset of template.datasets) {
                 if (dataset.isPub) {
-                    out += `            // ${template.datamodel.varName}.${dataset.structName}.value = ...\n`;
-                    out += `            // ${template.datamodel.varName}.${dataset.structName}.publish();\n`;
+                    if (TemplateCppLib.modifiedDatasets(template).includes(dataset)) {
+                        out += `            // ${template.datamodel.varName}.${dataset.structName}.modify() = ...\n`;
+                    }
+                    else {
+                        out += `            // ${template.datamodel.varName}.${dataset.structName}.value = ...\n`;
+                        out += `            // ${template.datamodel.varName}.${dataset.structName}.publish();\n`;
+                    }
                     out += `            \n`;
                 }
             }
             out += `        }\n`;
             out += `    }\n`;
             out += `\n`;
+            if (eventLoop) {
+                out += `    event_loop_close();\n`;
+            }
+            if (realtimeHeaderName !== undefined) {
+                out += `    rt_report();\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `    rec_close();\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `    metrics_close();\n`;
+            }
+            if (eventLoop || realtimeHeaderName !== undefined || recorderHeaderName !== undefined || metricsHeaderName !== undefined) {
+                out += `\n`;
+            }
             out += `    return 0;\n`;
             out += `}\n`;
         
@@ -134,13 +316,20 @@ class TemplateLinuxCpp extends TemplateCppLib {
         }
         
         
-        super(datamodel,true);
-        this.termination = new TemplateLinuxTermination();
+        super(datamodel, true, features);
+        this.eventLoop = datamodel != undefined && this.features.includes("epoll");
+        this.termination = new TemplateLinuxTermination(this.eventLoop);
+        if (datamodel != undefined && this.features.includes("rt")) {
+            this.realtime = new TemplateLinuxRealtime();
+        }
+        if (datamodel != undefined && this.features.includes("loadgen")) {
+            this.loadgen = new TemplateLinuxLoadgen(datamodel);
+        }
         if (datamodel == undefined) {
             this.mainSource = {name:`main.cpp`, contents:_generateMainLinuxNoDatamodel(this.termination.terminationHeader.name), description:"Linux application"};
         }
         else {
-            this.mainSource = {name:`${this.datamodel.typeName.toLowerCase()}.cpp`, contents:_generateMainLinux(this.template,this.datamodelLegend,this.termination.terminationHeader.name), description:"Linux application"};
+            this.mainSource = {name:`${this.datamodel.typeName.toLowerCase()}.cpp`, contents:_generateMainLinux(this.template,this.datamodelLegend,this.termination.terminationHeader.name,this.realtime != undefined ? this.realtime.realtimeHeader.name : undefined,this.eventLoop,this.recorder != undefined ? this.recorder.recorderHeader.name : undefined,this.metrics != undefined ? this.metrics.metricsHeader.name : undefined,this.trace != undefined ? this.trace.traceHeader.name : undefined,this.profile != undefined ? this.profile.profileHeader.name : undefined,this.processHeaderName !== undefined), description:"Linux application"};
         }
 
     }
@@ -0,0 +1,1491 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const { Datamodel, GeneratedFileObj } = require('../../../datamodel');
+const { ApplicationTemplate, ApplicationTemplateDataset } = require('../template');
+
+class TemplateLinuxGateway {
+
+    /**
+     * shared memory gateway header, used by the gateway application and the C and C++ clients
+     * @type {GeneratedFileObj}
+     */
+    gatewayHeader;
+
+    /**
+     * shared memory gateway source code
+     * @type {GeneratedFileObj}
+     */
+    gatewaySource;
+
+    /**
+     * C client library header
+     * @type {GeneratedFileObj}
+     */
+    clientHeader;
+
+    /**
+     * C client library source code
+     * @type {GeneratedFileObj}
+     */
+    clientSource;
+
+    /**
+     * C++ client class (header only)
+     * @type {GeneratedFileObj}
+     */
+    clientCppHeader;
+
+    /**
+     * Node.js client module
+     * @type {GeneratedFileObj}
+     */
+    clientJs;
+
+    /**
+     * Python client module
+     * @type {GeneratedFileObj}
+     */
+    clientPython;
+
+    /**
+     * {@linkcode TemplateLinuxGateway} Generate code for fanning out the datasets of a Linux application to local consumers (`gateway` feature)
+     *
+     * The gateway application (the `c-static` template) connects to the DMR once and writes every received and published dataset
+     * to a broadcast ring in POSIX shared memory. Any number of local consumers read the rings without locks, using the generated
+     * client libraries, which have the `value` and `on_change`/`onChange` API of the datamodel libraries, without connecting to the DMR.
+     *
+     * Generates following {@link GeneratedFileObj} objects
+     * - {@linkcode gatewayHeader}
+     * - {@linkcode gatewaySource}
+     * - {@linkcode clientHeader}
+     * - {@linkcode clientSource}
+     * - {@linkcode clientCppHeader}
+     * - {@linkcode clientJs}
+     * - {@linkcode clientPython}
+     *
+     * @param {Datamodel} datamodel
+     * @param {ApplicationTemplate} template Linux template of the datamodel
+     */
+    constructor(datamodel, template) {
+        this.gatewayHeader = {name:"gateway.h", contents:this._generateGatewayHeader(), description:"Shared memory gateway header"};
+        this.gatewaySource = {name:"gateway.c", contents:this._generateGatewaySource(), description:"Shared memory gateway source"};
+
+        let typeName = datamodel.typeName;
+        let layout = datamodel.analyzeLayout(Datamodel.LAYOUT_PLATFORMS.GPOS);
+        this.clientHeader = {name:`lib${typeName.toLowerCase()}_gateway.h`, contents:this._generateClientHeader(template), description:`${typeName} gateway client header`};
+        this.clientSource = {name:`lib${typeName.toLowerCase()}_gateway.c`, contents:this._generateClientSource(template, this.clientHeader.name), description:`${typeName} gateway client source`};
+        this.clientCppHeader = {name:`${typeName}Gateway.hpp`, contents:this._generateClientCpp(template), description:`${typeName} gateway client class`};
+        this.clientJs = {name:`${typeName.toLowerCase()}_gateway.js`, contents:this._generateClientJs(template, layout), description:`${typeName} gateway client module`};
+        this.clientPython = {name:`${typeName.toLowerCase()}_gateway.py`, contents:this._generateClientPython(template, layout), description:`${typeName} gateway client module`};
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @returns {string} default name of the shared memory object, as used by `gw_open()`
+     */
+    static sharedMemoryName(template) {
+        return `/exos-gw-${template.datamodelInstanceName}`;
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @param {function(ApplicationTemplateDataset):string} size C expression for the size of a published or received dataset
+     * @param {string} indent
+     * @returns {string} `gw_dataset_t` initializers of all datasets, in the order of the dataset index
+     */
+    static datasetTable(template, size, indent) {
+        let out = "";
+        for (let dataset of template.datasets) {
+            out += `${indent}{"${dataset.structName}", ${dataset.isPub || dataset.isSub ? size(dataset) : "0"}},\n`;
+        }
+        return out;
+    }
+
+    _generateGatewayHeader() {
+        function generateGatewayHeader() {
+            let out = "";
+
+            out += `#ifndef _GATEWAY_H_\n`;
+            out += `#define _GATEWAY_H_\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `extern "C" {\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#include <stdbool.h>\n`;
+            out += `#include <stdint.h>\n`;
+            out += `#include <stddef.h>\n`;
+            out += `\n`;
+            out += `/* Shared memory fan-out of the datasets to local consumers, configured with command line arguments (Runtime service in the .exospkg):\n`;
+            out += `    --gateway-name <name>       name of the POSIX shared memory object (default: /exos-gw-<datamodel instance>)\n`;
+            out += `    --gateway-slots <2..1024>   updates kept per dataset (default: 16)\n`;
+            out += `\n`;
+            out += `   The gateway application writes every received and published dataset to a broadcast ring of the dataset in shared\n`;
+            out += `   memory, and wakes the waiting consumers once per process(). Consumers map the object read-only and read the rings\n`;
+            out += `   without locks: each slot carries a sequence number that is odd while the slot is written, and a consumer that falls\n`;
+            out += `   more than the number of slots behind continues with the oldest slot and counts the updates it lost. As consumers\n`;
+            out += `   never write to the shared memory, any number of them cost the gateway nothing and add no DMR connections.\n`;
+            out += `\n`;
+            out += `   Layout: a gw_header_t, a gw_ring_t per dataset (in the order of the dataset index), then the slots of each ring.\n`;
+            out += `   A slot is a gw_slot_t followed by the value, padded to 64 bytes.\n`;
+            out += `   The gateway writes from one thread, the thread calling process(). Consumers use the gw_client_* functions or the\n`;
+            out += `   generated client libraries: lib<type>_gateway.h (C), <Type>Gateway.hpp (C++), <type>_gateway.js (Node.js) and\n`;
+            out += `   <type>_gateway.py (Python). */\n`;
+            out += `\n`;
+            out += `#define GW_MAGIC 0x45584757 /* "WGXE" */\n`;
+            out += `#define GW_VERSION 1\n`;
+            out += `#define GW_NAME_LENGTH 40\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    uint32_t magic;\n`;
+            out += `    uint32_t version;\n`;
+            out += `    uint32_t datasets;\n`;
+            out += `    uint32_t slots;\n`;
+            out += `    uint64_t size;        /* size of the shared memory object */\n`;
+            out += `    uint32_t wakeup;      /* futex, incremented after each process() of the gateway */\n`;
+            out += `    uint32_t operational; /* the gateway is operational, 0 after it disconnected or exited */\n`;
+            out += `    int32_t nettime;      /* nettime of the last process() */\n`;
+            out += `    int32_t pid;          /* process id of the gateway */\n`;
+            out += `    uint64_t cycles;      /* number of process() */\n`;
+            out += `} gw_header_t;\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    char name[GW_NAME_LENGTH];\n`;
+            out += `    uint32_t size;   /* size of the value, 0 if the dataset is neither published nor received */\n`;
+            out += `    uint32_t stride; /* size of a slot, including the gw_slot_t and padding */\n`;
+            out += `    uint64_t offset; /* first slot from the start of the object */\n`;
+            out += `    uint64_t head;   /* number of updates written, the latest one is in slot (head - 1) % slots */\n`;
+            out += `} gw_ring_t;\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    uint64_t sequence; /* 2 * update + 1 while written, 2 * update + 2 when complete */\n`;
+            out += `    int32_t nettime;\n`;
+            out += `    uint32_t size;\n`;
+            out += `} gw_slot_t;\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    const char *name;\n`;
+            out += `    uint32_t size; /* 0 if the dataset is neither published nor received */\n`;
+            out += `} gw_dataset_t;\n`;
+            out += `\n`;
+            out += `/* read the command line arguments, before gw_open() */\n`;
+            out += `void gw_setup(int argc, char **argv);\n`;
+            out += `/* create the shared memory object with a ring for each dataset (in the order of the dataset index), returns true if created or open */\n`;
+            out += `bool gw_open(const char *instance, const gw_dataset_t *datasets, uint16_t count);\n`;
+            out += `/* write an update of a dataset to its ring */\n`;
+            out += `void gw_update(uint16_t index, int32_t nettime, const void *data, size_t size);\n`;
+            out += `/* end of a process(): wake the waiting consumers */\n`;
+            out += `void gw_cycle(int32_t nettime, bool operational);\n`;
+            out += `/* mark the object as closed for the consumers and remove it */\n`;
+            out += `void gw_close(void);\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    const gw_header_t *header;\n`;
+            out += `    uint64_t *cursor;  /* next update to read of each dataset */\n`;
+            out += `    uint8_t *scratch;  /* a slot is copied here and checked, before it is copied to the value */\n`;
+            out += `    uint32_t wakeup;\n`;
+            out += `    uint64_t lost;     /* updates overwritten before they were read */\n`;
+            out += `} gw_client_t;\n`;
+            out += `\n`;
+            out += `/* map the object read-only, returns false if it does not exist or its datasets differ (name and size). The latest update of each dataset is read first */\n`;
+            out += `bool gw_client_open(gw_client_t *client, const char *name, const gw_dataset_t *datasets, uint16_t count);\n`;
+            out += `/* read the next update of a dataset into value, returns false if there is none */\n`;
+            out += `bool gw_client_read(gw_client_t *client, uint16_t index, void *value, size_t size, int32_t *nettime);\n`;
+            out += `/* wait until the gateway completed a process() since the last wait, or the timeout (ms, -1 infinite) expired. Returns true if it did */\n`;
+            out += `bool gw_client_wait(gw_client_t *client, int timeout_ms);\n`;
+            out += `/* true as long as the gateway that created the object is running */\n`;
+            out += `bool gw_client_alive(const gw_client_t *client);\n`;
+            out += `void gw_client_close(gw_client_t *client);\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `}\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#endif // _GATEWAY_H_\n`;
+
+            return out;
+        }
+        return generateGatewayHeader();
+    }
+
+    _generateGatewaySource() {
+        function generateGatewaySource() {
+            let out = "";
+
+            out += `#define _GNU_SOURCE\n`;
+            out += `#include <stdio.h>\n`;
+            out += `#include <stdlib.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `#include <errno.h>\n`;
+            out += `#include <fcntl.h>\n`;
+            out += `#include <limits.h>\n`;
+            out += `#include <signal.h>\n`;
+            out += `#include <time.h>\n`;
+            out += `#include <unistd.h>\n`;
+            out += `#include <sys/mman.h>\n`;
+            out += `#include <sys/stat.h>\n`;
+            out += `#include <sys/syscall.h>\n`;
+            out += `#include <linux/futex.h>\n`;
+            out += `#include "gateway.h"\n`;
+            out += `\n`;
+            out += `#define GW_ALIGN(_size_) (((_size_) + 63) & ~(uint64_t)63)\n`;
+            out += `\n`;
+            out += `static struct\n`;
+            out += `{\n`;
+            out += `    char name[256];\n`;
+            out += `    uint32_t slots;\n`;
+            out += `    gw_header_t *header;\n`;
+            out += `} gw = {.slots = 16};\n`;
+            out += `\n`;
+            out += `static const char *get_argument(int argc, char **argv, const char *name)\n`;
+            out += `{\n`;
+            out += `    for (int i = 1; i < argc - 1; i++)\n`;
+            out += `    {\n`;
+            out += `        if (0 == strcmp(argv[i], name))\n`;
+            out += `            return argv[i + 1];\n`;
+            out += `    }\n`;
+            out += `    return NULL;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static gw_ring_t *gw_rings(const gw_header_t *header)\n`;
+            out += `{\n`;
+            out += `    return (gw_ring_t *)((uint8_t *)header + sizeof(gw_header_t));\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static gw_slot_t *gw_slot(const gw_header_t *header, const gw_ring_t *ring, uint64_t update)\n`;
+            out += `{\n`;
+            out += `    return (gw_slot_t *)((uint8_t *)header + ring->offset + (update % header->slots) * ring->stride);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void gw_default_name(char *name, size_t size, const char *instance)\n`;
+            out += `{\n`;
+            out += `    snprintf(name, size, "/exos-gw-%s", instance);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void gw_setup(int argc, char **argv)\n`;
+            out += `{\n`;
+            out += `    const char *name = get_argument(argc, argv, "--gateway-name");\n`;
+            out += `    const char *slots = get_argument(argc, argv, "--gateway-slots");\n`;
+            out += `\n`;
+            out += `    if (NULL != name)\n`;
+            out += `    {\n`;
+            out += `        snprintf(gw.name, sizeof(gw.name), "%s%s", '/' == name[0] ? "" : "/", name);\n`;
+            out += `    }\n`;
+            out += `    if (NULL != slots)\n`;
+            out += `    {\n`;
+            out += `        gw.slots = (uint32_t)strtoul(slots, NULL, 0);\n`;
+            out += `        if (gw.slots < 2 || gw.slots > 1024)\n`;
+            out += `        {\n`;
+            out += `            fprintf(stderr, "gateway: --gateway-slots must be 2..1024, using 16\\n");\n`;
+            out += `            gw.slots = 16;\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool gw_open(const char *instance, const gw_dataset_t *datasets, uint16_t count)\n`;
+            out += `{\n`;
+            out += `    uint64_t offset, size;\n`;
+            out += `    gw_header_t *header;\n`;
+            out += `    gw_ring_t *rings;\n`;
+            out += `    int fd;\n`;
+            out += `\n`;
+            out += `    if (NULL != gw.header)\n`;
+            out += `        return true;\n`;
+            out += `\n`;
+            out += `    if ('\\0' == gw.name[0])\n`;
+            out += `        gw_default_name(gw.name, sizeof(gw.name), instance);\n`;
+            out += `\n`;
+            out += `    offset = GW_ALIGN(sizeof(gw_header_t) + count * sizeof(gw_ring_t));\n`;
+            out += `    size = offset;\n`;
+            out += `    for (uint16_t i = 0; i < count; i++)\n`;
+            out += `    {\n`;
+            out += `        size += GW_ALIGN(sizeof(gw_slot_t) + datasets[i].size) * (0 != datasets[i].size ? gw.slots : 0);\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    // a new object, consumers of a previous gateway keep their mapping until they see it closed\n`;
+            out += `    shm_unlink(gw.name);\n`;
+            out += `    fd = shm_open(gw.name, O_RDWR | O_CREAT | O_EXCL, 0644);\n`;
+            out += `    if (fd < 0)\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "gateway: cannot create %s: %s\\n", gw.name, strerror(errno));\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `    if (0 != ftruncate(fd, (off_t)size))\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "gateway: cannot size %s: %s\\n", gw.name, strerror(errno));\n`;
+            out += `        close(fd);\n`;
+            out += `        shm_unlink(gw.name);\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `    header = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);\n`;
+            out += `    close(fd);\n`;
+            out += `    if (MAP_FAILED == header)\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "gateway: cannot map %s: %s\\n", gw.name, strerror(errno));\n`;
+            out += `        shm_unlink(gw.name);\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    header->version = GW_VERSION;\n`;
+            out += `    header->datasets = count;\n`;
+            out += `    header->slots = gw.slots;\n`;
+            out += `    header->size = size;\n`;
+            out += `    header->pid = getpid();\n`;
+            out += `    rings = gw_rings(header);\n`;
+            out += `    for (uint16_t i = 0; i < count; i++)\n`;
+            out += `    {\n`;
+            out += `        snprintf(rings[i].name, sizeof(rings[i].name), "%s", datasets[i].name);\n`;
+            out += `        rings[i].size = datasets[i].size;\n`;
+            out += `        rings[i].stride = (uint32_t)GW_ALIGN(sizeof(gw_slot_t) + datasets[i].size);\n`;
+            out += `        rings[i].offset = offset;\n`;
+            out += `        offset += rings[i].stride * (0 != datasets[i].size ? gw.slots : 0);\n`;
+            out += `    }\n`;
+            out += `    // consumers check the magic before anything else\n`;
+            out += `    __atomic_store_n(&header->magic, GW_MAGIC, __ATOMIC_RELEASE);\n`;
+            out += `\n`;
+            out += `    gw.header = header;\n`;
+            out += `    return true;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void gw_update(uint16_t index, int32_t nettime, const void *data, size_t size)\n`;
+            out += `{\n`;
+            out += `    gw_ring_t *ring;\n`;
+            out += `    gw_slot_t *slot;\n`;
+            out += `    uint64_t update;\n`;
+            out += `\n`;
+            out += `    if (NULL == gw.header || index >= gw.header->datasets)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    ring = &gw_rings(gw.header)[index];\n`;
+            out += `    if (size != ring->size)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    update = ring->head;\n`;
+            out += `    slot = gw_slot(gw.header, ring, update);\n`;
+            out += `    __atomic_store_n(&slot->sequence, 2 * update + 1, __ATOMIC_RELAXED);\n`;
+            out += `    __atomic_thread_fence(__ATOMIC_RELEASE);\n`;
+            out += `    slot->nettime = nettime;\n`;
+            out += `    slot->size = (uint32_t)size;\n`;
+            out += `    memcpy(slot + 1, data, size);\n`;
+            out += `    __atomic_store_n(&slot->sequence, 2 * update + 2, __ATOMIC_RELEASE);\n`;
+            out += `    __atomic_store_n(&ring->head, update + 1, __ATOMIC_RELEASE);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void gw_cycle(int32_t nettime, bool operational)\n`;
+            out += `{\n`;
+            out += `    if (NULL == gw.header)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    gw.header->nettime = nettime;\n`;
+            out += `    gw.header->operational = operational;\n`;
+            out += `    gw.header->cycles++;\n`;
+            out += `    __atomic_add_fetch(&gw.header->wakeup, 1, __ATOMIC_RELEASE);\n`;
+            out += `    syscall(SYS_futex, &gw.header->wakeup, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void gw_close(void)\n`;
+            out += `{\n`;
+            out += `    if (NULL == gw.header)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    __atomic_store_n(&gw.header->operational, 0, __ATOMIC_RELEASE);\n`;
+            out += `    __atomic_store_n(&gw.header->pid, 0, __ATOMIC_RELEASE);\n`;
+            out += `    __atomic_add_fetch(&gw.header->wakeup, 1, __ATOMIC_RELEASE);\n`;
+            out += `    syscall(SYS_futex, &gw.header->wakeup, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);\n`;
+            out += `\n`;
+            out += `    munmap(gw.header, gw.header->size);\n`;
+            out += `    gw.header = NULL;\n`;
+            out += `    shm_unlink(gw.name);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool gw_client_open(gw_client_t *client, const char *name, const gw_dataset_t *datasets, uint16_t count)\n`;
+            out += `{\n`;
+            out += `    char shm_name[256];\n`;
+            out += `    const gw_header_t *header;\n`;
+            out += `    const gw_ring_t *rings;\n`;
+            out += `    struct stat st;\n`;
+            out += `    uint32_t scratch = 0;\n`;
+            out += `    int fd;\n`;
+            out += `\n`;
+            out += `    memset(client, 0, sizeof(*client));\n`;
+            out += `    snprintf(shm_name, sizeof(shm_name), "%s%s", '/' == name[0] ? "" : "/", name);\n`;
+            out += `\n`;
+            out += `    fd = shm_open(shm_name, O_RDONLY, 0);\n`;
+            out += `    if (fd < 0)\n`;
+            out += `        return false;\n`;
+            out += `    if (0 != fstat(fd, &st) || st.st_size < (off_t)sizeof(gw_header_t))\n`;
+            out += `    {\n`;
+            out += `        close(fd);\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `    header = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);\n`;
+            out += `    close(fd);\n`;
+            out += `    if (MAP_FAILED == header)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    if (GW_MAGIC != __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) || GW_VERSION != header->version ||\n`;
+            out += `        header->size != (uint64_t)st.st_size || count != header->datasets)\n`;
+            out += `    {\n`;
+            out += `        munmap((void *)header, (size_t)st.st_size);\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `    rings = gw_rings(header);\n`;
+            out += `    for (uint16_t i = 0; i < count; i++)\n`;
+            out += `    {\n`;
+            out += `        if (rings[i].size != datasets[i].size || 0 != strncmp(rings[i].name, datasets[i].name, GW_NAME_LENGTH))\n`;
+            out += `        {\n`;
+            out += `            fprintf(stderr, "gateway: %s has dataset %.*s (%u bytes) where %s (%u bytes) is expected\\n", shm_name,\n`;
+            out += `                    GW_NAME_LENGTH, rings[i].name, rings[i].size, datasets[i].name, datasets[i].size);\n`;
+            out += `            munmap((void *)header, (size_t)st.st_size);\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `        if (rings[i].size > scratch)\n`;
+            out += `            scratch = rings[i].size;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    client->cursor = calloc(count, sizeof(uint64_t));\n`;
+            out += `    client->scratch = malloc(scratch + 1);\n`;
+            out += `    if (NULL == client->cursor || NULL == client->scratch)\n`;
+            out += `    {\n`;
+            out += `        free(client->cursor);\n`;
+            out += `        free(client->scratch);\n`;
+            out += `        munmap((void *)header, (size_t)st.st_size);\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `    // the latest update of each dataset is read first\n`;
+            out += `    for (uint16_t i = 0; i < count; i++)\n`;
+            out += `    {\n`;
+            out += `        uint64_t head = __atomic_load_n(&rings[i].head, __ATOMIC_ACQUIRE);\n`;
+            out += `        client->cursor[i] = head > 0 ? head - 1 : 0;\n`;
+            out += `    }\n`;
+            out += `    client->wakeup = __atomic_load_n(&header->wakeup, __ATOMIC_ACQUIRE);\n`;
+            out += `    client->header = header;\n`;
+            out += `    return true;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool gw_client_read(gw_client_t *client, uint16_t index, void *value, size_t size, int32_t *nettime)\n`;
+            out += `{\n`;
+            out += `    const gw_ring_t *ring;\n`;
+            out += `    uint64_t head, update;\n`;
+            out += `\n`;
+            out += `    if (NULL == client->header || index >= client->header->datasets)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    ring = &gw_rings(client->header)[index];\n`;
+            out += `    if (size != ring->size)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);\n`;
+            out += `    update = client->cursor[index];\n`;
+            out += `    if (head - update > client->header->slots)\n`;
+            out += `    {\n`;
+            out += `        client->lost += head - client->header->slots - update;\n`;
+            out += `        update = head - client->header->slots;\n`;
+            out += `    }\n`;
+            out += `    for (; update < head; update++)\n`;
+            out += `    {\n`;
+            out += `        const gw_slot_t *slot = gw_slot(client->header, ring, update);\n`;
+            out += `        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);\n`;
+            out += `        int32_t slot_nettime = slot->nettime;\n`;
+            out += `\n`;
+            out += `        if (2 * update + 2 == sequence)\n`;
+            out += `        {\n`;
+            out += `            memcpy(client->scratch, slot + 1, size);\n`;
+            out += `            __atomic_thread_fence(__ATOMIC_ACQUIRE);\n`;
+            out += `            if (__atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == sequence)\n`;
+            out += `            {\n`;
+            out += `                memcpy(value, client->scratch, size);\n`;
+            out += `                if (NULL != nettime)\n`;
+            out += `                    *nettime = slot_nettime;\n`;
+            out += `                client->cursor[index] = update + 1;\n`;
+            out += `                return true;\n`;
+            out += `            }\n`;
+            out += `        }\n`;
+            out += `        // overwritten while (or before) it was read\n`;
+            out += `        client->lost++;\n`;
+            out += `    }\n`;
+            out += `    client->cursor[index] = update;\n`;
+            out += `    return false;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool gw_client_wait(gw_client_t *client, int timeout_ms)\n`;
+            out += `{\n`;
+            out += `    uint32_t wakeup;\n`;
+            out += `\n`;
+            out += `    if (NULL == client->header)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    wakeup = __atomic_load_n(&client->header->wakeup, __ATOMIC_ACQUIRE);\n`;
+            out += `    if (wakeup == client->wakeup && timeout_ms != 0)\n`;
+            out += `    {\n`;
+            out += `        struct timespec timeout = {.tv_sec = timeout_ms / 1000, .tv_nsec = (timeout_ms % 1000) * 1000000L};\n`;
+            out += `        syscall(SYS_futex, &client->header->wakeup, FUTEX_WAIT, wakeup, timeout_ms < 0 ? NULL : &timeout, NULL, 0);\n`;
+            out += `        wakeup = __atomic_load_n(&client->header->wakeup, __ATOMIC_ACQUIRE);\n`;
+            out += `    }\n`;
+            out += `    if (wakeup == client->wakeup)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    client->wakeup = wakeup;\n`;
+            out += `    return true;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool gw_client_alive(const gw_client_t *client)\n`;
+            out += `{\n`;
+            out += `    int32_t pid;\n`;
+            out += `\n`;
+            out += `    if (NULL == client->header)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    pid = __atomic_load_n(&client->header->pid, __ATOMIC_ACQUIRE);\n`;
+            out += `    return 0 != pid && (0 == kill(pid, 0) || EPERM == errno);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void gw_client_close(gw_client_t *client)\n`;
+            out += `{\n`;
+            out += `    if (NULL != client->header)\n`;
+            out += `        munmap((void *)client->header, client->header->size);\n`;
+            out += `    free(client->cursor);\n`;
+            out += `    free(client->scratch);\n`;
+            out += `    memset(client, 0, sizeof(*client));\n`;
+            out += `}\n`;
+
+            return out;
+        }
+        return generateGatewaySource();
+    }
+
+    _generateClientHeader(template) {
+
+        /**
+         * @param {ApplicationTemplate} template
+         * @returns {string}
+         */
+        function generateClientHeader(template) {
+            let lib = `${template.datamodel.libStructName}Gateway`;
+            let guard = `_LIB${template.datamodel.structName.toUpperCase()}_GATEWAY_H_`;
+            let out = "";
+
+            out += `#ifndef ${guard}\n`;
+            out += `#define ${guard}\n`;
+            out += `\n`;
+            out += `#include "${template.headerName}"\n`;
+            out += `\n`;
+            out += `/* Client of the ${template.datamodel.structName} gateway: the datasets of the gateway application in shared memory, without a DMR connection.\n`;
+            out += `\n`;
+            out += `   connect() maps the gateway (name NULL: ${TemplateLinuxGateway.sharedMemoryName(template)}), process() calls on_change for every\n`;
+            out += `   update of a dataset since the last process(), in order, and wait() blocks until the gateway processed its next cycle\n`;
+            out += `   or the timeout (ms, -1 infinite) expired. If the gateway is not running, process() connects as soon as it is.\n`;
+            out += `   Updates that were overwritten before they were read are counted in lost_updates (see gateway.h for the slots). */\n`;
+            out += `\n`;
+            out += `typedef void (*${lib}_event_cb)(void);\n`;
+            out += `typedef void (*${lib}_method_fn)(void);\n`;
+            out += `typedef bool (*${lib}_connect_fn)(const char *name);\n`;
+            out += `typedef bool (*${lib}_wait_fn)(int timeout_ms);\n`;
+            out += `typedef int32_t (*${lib}_get_nettime_fn)(void);\n`;
+            out += `\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    out += `typedef struct ${lib}${dataset.structName}\n`;
+                    out += `{\n`;
+                    out += `    ${lib}_event_cb on_change;\n`;
+                    out += `    int32_t nettime;\n`;
+                    out += `    ${Datamodel.convertPlcType(dataset.dataType)} value${TemplateLinuxGateway._dimensions(dataset)};\n`;
+                    out += `} ${lib}${dataset.structName}_t;\n\n`;
+                }
+            }
+            out += `typedef struct ${lib}\n`;
+            out += `{\n`;
+            out += `    ${lib}_connect_fn connect;\n`;
+            out += `    ${lib}_method_fn disconnect;\n`;
+            out += `    ${lib}_method_fn process;\n`;
+            out += `    ${lib}_wait_fn wait;\n`;
+            out += `    ${lib}_method_fn dispose;\n`;
+            out += `    ${lib}_get_nettime_fn get_nettime;\n`;
+            out += `    ${lib}_event_cb on_connected;\n`;
+            out += `    ${lib}_event_cb on_disconnected;\n`;
+            out += `    bool is_connected;\n`;
+            out += `    bool is_operational;\n`;
+            out += `    uint64_t lost_updates;\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    out += `    ${lib}${dataset.structName}_t ${dataset.structName};\n`;
+                }
+            }
+            out += `} ${lib}_t;\n\n`;
+
+            out += `#ifdef __cplusplus\n`;
+            out += `extern "C" {\n`;
+            out += `#endif\n`;
+            out += `${lib}_t *${lib}_init(void);\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `}\n`;
+            out += `#endif\n`;
+            out += `#endif // ${guard}\n`;
+
+            return out;
+        }
+        return generateClientHeader(template);
+    }
+
+    _generateClientSource(template, clientHeaderName) {
+
+        /**
+         * @param {ApplicationTemplate} template
+         * @param {string} clientHeaderName
+         * @returns {string}
+         */
+        function generateClientSource(template, clientHeaderName) {
+            let lib = `${template.datamodel.libStructName}Gateway`;
+            let handle = `${template.datamodel.handleName}Gateway`;
+            let ext = `${handle}.ext_${template.datamodel.varName}`;
+            let out = "";
+
+            out += `#define _GNU_SOURCE\n`;
+            out += `#include <stdio.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `#include <time.h>\n`;
+            out += `#include "${clientHeaderName}"\n`;
+            out += `#include "gateway.h"\n`;
+            out += `\n`;
+            out += `typedef struct ${lib}Handle\n`;
+            out += `{\n`;
+            out += `    ${lib}_t ext_${template.datamodel.varName};\n`;
+            out += `    gw_client_t client;\n`;
+            out += `    char name[256];\n`;
+            out += `} ${lib}Handle_t;\n\n`;
+            out += `static ${lib}Handle_t ${handle};\n\n`;
+
+            out += `//the datasets of the gateway, in the order of the dataset index\n`;
+            out += `static const gw_dataset_t ${lib}_datasets[] = {\n`;
+            out += TemplateLinuxGateway.datasetTable(template, dataset => `sizeof(${ext}.${dataset.structName}.value)`, "    ");
+            out += `};\n\n`;
+
+            out += `static bool ${lib}_open(void)\n`;
+            out += `{\n`;
+            out += `    if (${ext}.is_connected)\n`;
+            out += `        return true;\n`;
+            out += `    if ('\\0' == ${handle}.name[0] || !gw_client_open(&${handle}.client, ${handle}.name, ${lib}_datasets, sizeof(${lib}_datasets) / sizeof(${lib}_datasets[0])))\n`;
+            out += `        return false;\n\n`;
+            out += `    ${ext}.is_connected = true;\n`;
+            out += `    if (NULL != ${ext}.on_connected)\n`;
+            out += `    {\n`;
+            out += `        ${ext}.on_connected();\n`;
+            out += `    }\n`;
+            out += `    return true;\n`;
+            out += `}\n\n`;
+
+            out += `static void ${lib}_close(void)\n`;
+            out += `{\n`;
+            out += `    if (!${ext}.is_connected)\n`;
+            out += `        return;\n\n`;
+            out += `    gw_client_close(&${handle}.client);\n`;
+            out += `    ${ext}.is_connected = false;\n`;
+            out += `    ${ext}.is_operational = false;\n`;
+            out += `    if (NULL != ${ext}.on_disconnected)\n`;
+            out += `    {\n`;
+            out += `        ${ext}.on_disconnected();\n`;
+            out += `    }\n`;
+            out += `}\n\n`;
+
+            out += `static bool ${lib}_connect(const char *name)\n`;
+            out += `{\n`;
+            out += `    snprintf(${handle}.name, sizeof(${handle}.name), "%s", NULL != name ? name : "${TemplateLinuxGateway.sharedMemoryName(template)}");\n`;
+            out += `    return ${lib}_open();\n`;
+            out += `}\n\n`;
+
+            out += `static void ${lib}_disconnect(void)\n`;
+            out += `{\n`;
+            out += `    ${lib}_close();\n`;
+            out += `    ${handle}.name[0] = '\\0';\n`;
+            out += `}\n\n`;
+
+            out += `static void ${lib}_process(void)\n`;
+            out += `{\n`;
+            out += `    if (!${lib}_open())\n`;
+            out += `        return;\n\n`;
+            out += `    if (!gw_client_alive(&${handle}.client))\n`;
+            out += `    {\n`;
+            out += `        //the gateway exited, connect to the next one in a later process()\n`;
+            out += `        ${lib}_close();\n`;
+            out += `        return;\n`;
+            out += `    }\n`;
+            out += `    ${ext}.is_operational = 0 != ${handle}.client.header->operational;\n\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    out += `    while (gw_client_read(&${handle}.client, ${template.datasets.indexOf(dataset)}, &${ext}.${dataset.structName}.value, sizeof(${ext}.${dataset.structName}.value), &${ext}.${dataset.structName}.nettime))\n`;
+                    out += `    {\n`;
+                    out += `        if (NULL != ${ext}.${dataset.structName}.on_change)\n`;
+                    out += `        {\n`;
+                    out += `            ${ext}.${dataset.structName}.on_change();\n`;
+                    out += `        }\n`;
+                    out += `    }\n`;
+                }
+            }
+            out += `    ${ext}.lost_updates = ${handle}.client.lost;\n`;
+            out += `}\n\n`;
+
+            out += `static bool ${lib}_wait(int timeout_ms)\n`;
+            out += `{\n`;
+            out += `    if (!${ext}.is_connected)\n`;
+            out += `    {\n`;
+            out += `        //retry in the next process()\n`;
+            out += `        struct timespec delay = {.tv_sec = 0, .tv_nsec = (timeout_ms < 0 || timeout_ms > 100 ? 100 : timeout_ms) * 1000000L};\n`;
+            out += `        nanosleep(&delay, NULL);\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `    return gw_client_wait(&${handle}.client, timeout_ms);\n`;
+            out += `}\n\n`;
+
+            out += `static int32_t ${lib}_get_nettime(void)\n`;
+            out += `{\n`;
+            out += `    if (!${ext}.is_connected)\n`;
+            out += `        return 0;\n`;
+            out += `    return ${handle}.client.header->nettime;\n`;
+            out += `}\n\n`;
+
+            out += `static void ${lib}_dispose(void)\n`;
+            out += `{\n`;
+            out += `    ${lib}_disconnect();\n`;
+            out += `}\n\n`;
+
+            out += `${lib}_t *${lib}_init(void)\n`;
+            out += `{\n`;
+            out += `    memset(&${handle}, 0, sizeof(${handle}));\n\n`;
+            out += `    ${ext}.connect = ${lib}_connect;\n`;
+            out += `    ${ext}.disconnect = ${lib}_disconnect;\n`;
+            out += `    ${ext}.process = ${lib}_process;\n`;
+            out += `    ${ext}.wait = ${lib}_wait;\n`;
+            out += `    ${ext}.dispose = ${lib}_dispose;\n`;
+            out += `    ${ext}.get_nettime = ${lib}_get_nettime;\n`;
+            out += `    return &${ext};\n`;
+            out += `}\n`;
+
+            return out;
+        }
+        return generateClientSource(template, clientHeaderName);
+    }
+
+    _generateClientCpp(template) {
+
+        /**
+         * @param {ApplicationTemplate} template
+         * @returns {string}
+         */
+        function generateClientCpp(template) {
+            let className = `${template.datamodel.structName}Gateway`;
+            let out = "";
+
+            out += `#ifndef _${className.toUpperCase()}_H_\n`;
+            out += `#define _${className.toUpperCase()}_H_\n`;
+            out += `\n`;
+            out += `#include <string>\n`;
+            out += `#include <functional>\n`;
+            out += `#include <thread>\n`;
+            out += `#include <chrono>\n`;
+            out += `\n`;
+            out += `extern "C" {\n`;
+            out += `    #include "${template.headerName}"\n`;
+            out += `    #include "gateway.h"\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `/* Client of the ${template.datamodel.structName} gateway: the datasets of the gateway application in shared memory, without a DMR connection.\n`;
+            out += `\n`;
+            out += `   connect() maps the gateway (default ${TemplateLinuxGateway.sharedMemoryName(template)}), process() calls onChange for every\n`;
+            out += `   update of a dataset since the last process(), in order, and wait() blocks until the gateway processed its next cycle\n`;
+            out += `   or the timeout (ms, -1 infinite) expired. If the gateway is not running, process() connects as soon as it is. */\n`;
+            out += `\n`;
+            out += `template <typename T>\n`;
+            out += `class ${className}Dataset\n`;
+            out += `{\n`;
+            out += `    friend class ${className};\n`;
+            out += `    std::function<void()> _onChange = [](){};\n`;
+            out += `\n`;
+            out += `public:\n`;
+            out += `    T value = {};\n`;
+            out += `    int32_t nettime = 0;\n`;
+            out += `    void onChange(std::function<void()> f) {_onChange = std::move(f);};\n`;
+            out += `};\n`;
+            out += `\n`;
+            out += `class ${className}\n`;
+            out += `{\n`;
+            out += `    gw_client_t client = {};\n`;
+            out += `    std::string name;\n`;
+            out += `    std::function<void()> _onConnectionChange = [](){};\n`;
+            out += `\n`;
+            out += `    bool open() {\n`;
+            out += `        if (isConnected) {\n`;
+            out += `            return true;\n`;
+            out += `        }\n`;
+            out += `        // the datasets of the gateway, in the order of the dataset index\n`;
+            out += `        const gw_dataset_t datasets[] = {\n`;
+            out += TemplateLinuxGateway.datasetTable(template, dataset => `sizeof(${dataset.structName}.value)`, "            ");
+            out += `        };\n`;
+            out += `        if (name.empty() || !gw_client_open(&client, name.c_str(), datasets, sizeof(datasets) / sizeof(datasets[0]))) {\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `        isConnected = true;\n`;
+            out += `        _onConnectionChange();\n`;
+            out += `        return true;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    void close() {\n`;
+            out += `        if (!isConnected) {\n`;
+            out += `            return;\n`;
+            out += `        }\n`;
+            out += `        gw_client_close(&client);\n`;
+            out += `        isConnected = false;\n`;
+            out += `        isOperational = false;\n`;
+            out += `        _onConnectionChange();\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `public:\n`;
+            out += `    ${className}() = default;\n`;
+            out += `    ${className}(const ${className}&) = delete;\n`;
+            out += `    ${className}& operator=(const ${className}&) = delete;\n`;
+            out += `    ~${className}() {disconnect();};\n`;
+            out += `\n`;
+            out += `    bool connect(const std::string &gatewayName = "${TemplateLinuxGateway.sharedMemoryName(template)}") {\n`;
+            out += `        name = gatewayName;\n`;
+            out += `        return open();\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    void disconnect() {\n`;
+            out += `        close();\n`;
+            out += `        name.clear();\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    void process() {\n`;
+            out += `        if (!open()) {\n`;
+            out += `            return;\n`;
+            out += `        }\n`;
+            out += `        if (!gw_client_alive(&client)) {\n`;
+            out += `            // the gateway exited, connect to the next one in a later process()\n`;
+            out += `            close();\n`;
+            out += `            return;\n`;
+            out += `        }\n`;
+            out += `        isOperational = 0 != client.header->operational;\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    out += `        while (gw_client_read(&client, ${template.datasets.indexOf(dataset)}, &${dataset.structName}.value, sizeof(${dataset.structName}.value), &${dataset.structName}.nettime)) {\n`;
+                    out += `            ${dataset.structName}._onChange();\n`;
+                    out += `        }\n`;
+                }
+            }
+            out += `        lostUpdates = client.lost;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    bool wait(int timeoutMs) {\n`;
+            out += `        if (!isConnected) {\n`;
+            out += `            // retry in the next process()\n`;
+            out += `            std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs < 0 || timeoutMs > 100 ? 100 : timeoutMs));\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `        return gw_client_wait(&client, timeoutMs);\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    int32_t getNettime() {\n`;
+            out += `        return isConnected ? client.header->nettime : 0;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    void onConnectionChange(std::function<void()> f) {_onConnectionChange = std::move(f);};\n`;
+            out += `\n`;
+            out += `    bool isConnected = false;\n`;
+            out += `    bool isOperational = false;\n`;
+            out += `    uint64_t lostUpdates = 0;\n`;
+            out += `\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    out += `    ${className}Dataset<${TemplateLinuxGateway._cppValueType(dataset)}> ${dataset.structName};\n`;
+                }
+            }
+            out += `};\n`;
+            out += `\n`;
+            out += `#endif\n`;
+
+            return out;
+        }
+        return generateClientCpp(template);
+    }
+
+    _generateClientJs(template, layout) {
+
+        /**
+         * @param {ApplicationTemplate} template
+         * @param {LayoutAnalysis} layout GPOS layout of the datamodel
+         * @returns {string}
+         */
+        function generateClientJs(template, layout) {
+            let className = `${template.datamodel.structName}Gateway`;
+            let decode = TemplateLinuxGateway._decoder(layout, {
+                BOOL: o => `buffer.readUInt8(${o}) != 0`,
+                USINT: o => `buffer.readUInt8(${o})`,
+                SINT: o => `buffer.readInt8(${o})`,
+                BYTE: o => `buffer.readInt8(${o})`,
+                UINT: o => `buffer.readUInt16LE(${o})`,
+                INT: o => `buffer.readInt16LE(${o})`,
+                UDINT: o => `buffer.readUInt32LE(${o})`,
+                DINT: o => `buffer.readInt32LE(${o})`,
+                REAL: o => `buffer.readFloatLE(${o})`,
+                LREAL: o => `buffer.readDoubleLE(${o})`,
+                enum: o => `buffer.readInt32LE(${o})`,
+                STRING: (o, length) => `gwString(buffer, ${o}, ${length})`,
+                struct: (o, type) => `decode${type}(buffer, ${o})`,
+                array: (o, count, size, element) => `gwArray(${count}, i => ${element(`${o} + i * ${size}`)})`
+            });
+            let out = "";
+
+            out += `/* Client of the ${template.datamodel.structName} gateway: the datasets of the gateway application in shared memory, without a DMR connection.\n`;
+            out += `\n`;
+            out += `   connect() opens the gateway (default ${TemplateLinuxGateway.sharedMemoryName(template)}), process() calls the onChange callback for\n`;
+            out += `   every update of a dataset since the last process(), in order. Call process() cyclically, e.g. with setInterval().\n`;
+            out += `   If the gateway is not running, process() connects as soon as it is. The shared memory is read with pread(),\n`;
+            out += `   the layout of the values is the one of the datamodel on this platform (GPOS).\n`;
+            out += `\n`;
+            out += `   const { ${className} } = require('./${template.datamodel.structName.toLowerCase()}_gateway');\n`;
+            out += `   let gateway = new ${className}();\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    out += `   gateway.${dataset.structName}.onChange(() => console.log(gateway.${dataset.structName}.value));\n`;
+                    break;
+                }
+            }
+            out += `   gateway.connect();\n`;
+            out += `   setInterval(() => gateway.process(), 10);\n`;
+            out += `*/\n`;
+            out += `\n`;
+            out += `const fs = require('fs');\n`;
+            out += `\n`;
+            out += `const GW_MAGIC = 0x45584757;\n`;
+            out += `const GW_VERSION = 1;\n`;
+            out += `const GW_NAME_LENGTH = 40;\n`;
+            out += `const GW_HEADER_SIZE = 48;\n`;
+            out += `const GW_RING_SIZE = 64;\n`;
+            out += `const GW_SLOT_SIZE = 16;\n`;
+            out += `\n`;
+            out += `function gwString(buffer, offset, length) {\n`;
+            out += `    let end = buffer.indexOf(0, offset);\n`;
+            out += `    return buffer.toString('latin1', offset, end < 0 || end > offset + length ? offset + length : end);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `function gwArray(count, element) {\n`;
+            out += `    let array = new Array(count);\n`;
+            out += `    for (let i = 0; i < count; i++) {\n`;
+            out += `        array[i] = element(i);\n`;
+            out += `    }\n`;
+            out += `    return array;\n`;
+            out += `}\n`;
+            out += `\n`;
+            for (let type of layout.types.filter(type => type.dataType != template.datamodel.structName)) {
+                out += `function decode${type.dataType}(buffer, offset) {\n`;
+                out += `    return {\n`;
+                for (let member of type.members) {
+                    out += `        ${member.name}: ${decode(member, `offset + ${member.offset}`)},\n`;
+                }
+                out += `    };\n`;
+                out += `}\n`;
+                out += `\n`;
+            }
+            out += `class ${className}Dataset {\n`;
+            out += `    constructor(name, index, size, decode) {\n`;
+            out += `        this.name = name;\n`;
+            out += `        this.index = index;\n`;
+            out += `        this.size = size;\n`;
+            out += `        this.decode = decode;\n`;
+            out += `        this.value = undefined;\n`;
+            out += `        this.nettime = 0;\n`;
+            out += `        this._onChange = () => {};\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    onChange(f) {\n`;
+            out += `        this._onChange = f;\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `class ${className} {\n`;
+            out += `    constructor() {\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    let size = TemplateLinuxGateway._datasetSize(layout, dataset);
+                    out += `        this.${dataset.structName} = new ${className}Dataset("${dataset.structName}", ${template.datasets.indexOf(dataset)}, ${size}, (buffer, offset) => ${decode(TemplateLinuxGateway._member(dataset), "offset")});\n`;
+                }
+            }
+            out += `        this._datasets = [\n`;
+            for (let dataset of template.datasets) {
+                out += `            ${dataset.isPub || dataset.isSub ? `this.${dataset.structName}` : `{name: "${dataset.structName}", size: 0}`},\n`;
+            }
+            out += `        ];\n`;
+            out += `        this._name = undefined;\n`;
+            out += `        this._fd = undefined;\n`;
+            out += `        this._onConnectionChange = () => {};\n`;
+            out += `        this.isConnected = false;\n`;
+            out += `        this.isOperational = false;\n`;
+            out += `        this.lostUpdates = 0;\n`;
+            out += `        this.nettime = 0;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    _open() {\n`;
+            out += `        if (this.isConnected) {\n`;
+            out += `            return true;\n`;
+            out += `        }\n`;
+            out += `        if (this._name === undefined) {\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `        let fd;\n`;
+            out += `        try {\n`;
+            out += `            fd = fs.openSync(\`/dev/shm\${this._name}\`, 'r');\n`;
+            out += `        }\n`;
+            out += `        catch (e) {\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `        let count = this._datasets.length;\n`;
+            out += `        let header = Buffer.alloc(GW_HEADER_SIZE + count * GW_RING_SIZE);\n`;
+            out += `        if (fs.readSync(fd, header, 0, header.length, 0) != header.length || header.readUInt32LE(0) != GW_MAGIC\n`;
+            out += `            || header.readUInt32LE(4) != GW_VERSION || header.readUInt32LE(8) != count) {\n`;
+            out += `            fs.closeSync(fd);\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `        this._slots = header.readUInt32LE(12);\n`;
+            out += `        this._rings = [];\n`;
+            out += `        for (let i = 0; i < count; i++) {\n`;
+            out += `            let ring = GW_HEADER_SIZE + i * GW_RING_SIZE;\n`;
+            out += `            let name = gwString(header, ring, GW_NAME_LENGTH);\n`;
+            out += `            let size = header.readUInt32LE(ring + GW_NAME_LENGTH);\n`;
+            out += `            if (name != this._datasets[i].name || size != this._datasets[i].size) {\n`;
+            out += `                console.error(\`gateway: \${this._name} has dataset \${name} (\${size} bytes) where \${this._datasets[i].name} (\${this._datasets[i].size} bytes) is expected\`);\n`;
+            out += `                fs.closeSync(fd);\n`;
+            out += `                return false;\n`;
+            out += `            }\n`;
+            out += `            let head = Number(header.readBigUInt64LE(ring + GW_NAME_LENGTH + 16));\n`;
+            out += `            this._rings.push({\n`;
+            out += `                stride: header.readUInt32LE(ring + GW_NAME_LENGTH + 4),\n`;
+            out += `                offset: Number(header.readBigUInt64LE(ring + GW_NAME_LENGTH + 8)),\n`;
+            out += `                // the latest update is read first\n`;
+            out += `                cursor: head > 0 ? head - 1 : 0,\n`;
+            out += `                slot: Buffer.alloc(GW_SLOT_SIZE + size)\n`;
+            out += `            });\n`;
+            out += `        }\n`;
+            out += `        this._header = header;\n`;
+            out += `        this._sequence = Buffer.alloc(8);\n`;
+            out += `        this._fd = fd;\n`;
+            out += `        this.isConnected = true;\n`;
+            out += `        this._onConnectionChange();\n`;
+            out += `        return true;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    _close() {\n`;
+            out += `        if (!this.isConnected) {\n`;
+            out += `            return;\n`;
+            out += `        }\n`;
+            out += `        fs.closeSync(this._fd);\n`;
+            out += `        this._fd = undefined;\n`;
+            out += `        this.isConnected = false;\n`;
+            out += `        this.isOperational = false;\n`;
+            out += `        this._onConnectionChange();\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    _alive(pid) {\n`;
+            out += `        try {\n`;
+            out += `            process.kill(pid, 0);\n`;
+            out += `            return true;\n`;
+            out += `        }\n`;
+            out += `        catch (e) {\n`;
+            out += `            return e.code == 'EPERM';\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    connect(name = "${TemplateLinuxGateway.sharedMemoryName(template)}") {\n`;
+            out += `        this._name = name.startsWith('/') ? name : \`/\${name}\`;\n`;
+            out += `        return this._open();\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    disconnect() {\n`;
+            out += `        this._close();\n`;
+            out += `        this._name = undefined;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    process() {\n`;
+            out += `        if (!this._open()) {\n`;
+            out += `            return;\n`;
+            out += `        }\n`;
+            out += `        let header = this._header;\n`;
+            out += `        fs.readSync(this._fd, header, 0, header.length, 0);\n`;
+            out += `        let pid = header.readInt32LE(36);\n`;
+            out += `        if (pid == 0 || !this._alive(pid)) {\n`;
+            out += `            // the gateway exited, connect to the next one in a later process()\n`;
+            out += `            this._close();\n`;
+            out += `            return;\n`;
+            out += `        }\n`;
+            out += `        this.isOperational = header.readUInt32LE(28) != 0;\n`;
+            out += `        this.nettime = header.readInt32LE(32);\n`;
+            out += `        for (let i = 0; i < this._datasets.length; i++) {\n`;
+            out += `            let dataset = this._datasets[i];\n`;
+            out += `            let ring = this._rings[i];\n`;
+            out += `            if (dataset.size == 0) {\n`;
+            out += `                continue;\n`;
+            out += `            }\n`;
+            out += `            let head = Number(header.readBigUInt64LE(GW_HEADER_SIZE + i * GW_RING_SIZE + GW_NAME_LENGTH + 16));\n`;
+            out += `            if (head - ring.cursor > this._slots) {\n`;
+            out += `                this.lostUpdates += head - this._slots - ring.cursor;\n`;
+            out += `                ring.cursor = head - this._slots;\n`;
+            out += `            }\n`;
+            out += `            for (; ring.cursor < head; ring.cursor++) {\n`;
+            out += `                // the slot is valid if its sequence number is the same before and after reading it\n`;
+            out += `                let position = ring.offset + (ring.cursor % this._slots) * ring.stride;\n`;
+            out += `                fs.readSync(this._fd, ring.slot, 0, ring.slot.length, position);\n`;
+            out += `                fs.readSync(this._fd, this._sequence, 0, 8, position);\n`;
+            out += `                let sequence = Number(ring.slot.readBigUInt64LE(0));\n`;
+            out += `                if (sequence != 2 * ring.cursor + 2 || Number(this._sequence.readBigUInt64LE(0)) != sequence) {\n`;
+            out += `                    this.lostUpdates++;\n`;
+            out += `                    continue;\n`;
+            out += `                }\n`;
+            out += `                dataset.value = dataset.decode(ring.slot, GW_SLOT_SIZE);\n`;
+            out += `                dataset.nettime = ring.slot.readInt32LE(8);\n`;
+            out += `                dataset._onChange();\n`;
+            out += `            }\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    onConnectionChange(f) {\n`;
+            out += `        this._onConnectionChange = f;\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `module.exports = { ${className} };\n`;
+
+            return out;
+        }
+        return generateClientJs(template, layout);
+    }
+
+    _generateClientPython(template, layout) {
+
+        /**
+         * @param {ApplicationTemplate} template
+         * @param {LayoutAnalysis} layout GPOS layout of the datamodel
+         * @returns {string}
+         */
+        function generateClientPython(template, layout) {
+            let className = `${template.datamodel.structName}Gateway`;
+            let formats = {BOOL: "?", USINT: "B", SINT: "b", BYTE: "b", UINT: "H", INT: "h", UDINT: "I", DINT: "i", REAL: "f", LREAL: "d", enum: "i"};
+            let scalar = type => o => `_${type}.unpack_from(buffer, ${o})[0]`;
+            let decode = TemplateLinuxGateway._decoder(layout, {
+                BOOL: scalar("BOOL"), USINT: scalar("USINT"), SINT: scalar("SINT"), BYTE: scalar("BYTE"), UINT: scalar("UINT"),
+                INT: scalar("INT"), UDINT: scalar("UDINT"), DINT: scalar("DINT"), REAL: scalar("REAL"), LREAL: scalar("LREAL"), enum: scalar("DINT"),
+                STRING: (o, length) => `_string(buffer, ${o}, ${length})`,
+                struct: (o, type) => `_decode_${type}(buffer, ${o})`,
+                array: (o, count, size, element, member) => {
+                    let format = formats[member.type == "enum" ? "enum" : member.dataType];
+                    if (format !== undefined) {
+                        return `list(struct.unpack_from("<${count}${format}", buffer, ${o}))`;
+                    }
+                    return `[${element(`${o} + i * ${size}`)} for i in range(${count})]`;
+                }
+            });
+            let out = "";
+
+            out += `"""Client of the ${template.datamodel.structName} gateway: the datasets of the gateway application in shared memory, without a DMR connection.\n`;
+            out += `\n`;
+            out += `connect() maps the gateway (default ${TemplateLinuxGateway.sharedMemoryName(template)}), process() calls the on_change callback for\n`;
+            out += `every update of a dataset since the last process(), in order, and wait() sleeps until the gateway processed its\n`;
+            out += `next cycle or the timeout (ms) expired. If the gateway is not running, process() connects as soon as it is.\n`;
+            out += `Structures are delivered as SimpleNamespace objects, arrays as lists.\n`;
+            out += `\n`;
+            out += `    from ${template.datamodel.structName.toLowerCase()}_gateway import ${className}\n`;
+            out += `    gateway = ${className}()\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    out += `    gateway.${dataset.structName}.on_change = lambda: print(gateway.${dataset.structName}.value)\n`;
+                    break;
+                }
+            }
+            out += `    gateway.connect()\n`;
+            out += `    while True:\n`;
+            out += `        gateway.wait(100)\n`;
+            out += `        gateway.process()\n`;
+            out += `"""\n`;
+            out += `\n`;
+            out += `import mmap\n`;
+            out += `import os\n`;
+            out += `import struct\n`;
+            out += `import time\n`;
+            out += `from types import SimpleNamespace\n`;
+            out += `\n`;
+            out += `GW_MAGIC = 0x45584757\n`;
+            out += `GW_VERSION = 1\n`;
+            out += `GW_NAME_LENGTH = 40\n`;
+            out += `GW_HEADER_SIZE = 48\n`;
+            out += `GW_RING_SIZE = 64\n`;
+            out += `GW_SLOT_SIZE = 16\n`;
+            out += `\n`;
+            out += `_HEADER = struct.Struct("<IIIIQIIiiQ")\n`;
+            out += `_RING = struct.Struct("<40sIIQQ")\n`;
+            out += `_SLOT = struct.Struct("<QiI")\n`;
+            out += `_HEAD = struct.Struct("<Q")\n`;
+            for (let type of Object.keys(formats).filter(type => type != "enum")) {
+                out += `_${type} = struct.Struct("<${formats[type]}")\n`;
+            }
+            out += `\n`;
+            out += `\n`;
+            out += `def _string(buffer, offset, length):\n`;
+            out += `    value = bytes(buffer[offset:offset + length])\n`;
+            out += `    return value.split(b"\\0", 1)[0].decode("latin-1")\n`;
+            out += `\n`;
+            for (let type of layout.types.filter(type => type.dataType != template.datamodel.structName)) {
+                out += `\n`;
+                out += `def _decode_${type.dataType}(buffer, offset):\n`;
+                out += `    value = SimpleNamespace()\n`;
+                for (let member of type.members) {
+                    out += `    value.${member.name} = ${decode(member, `offset + ${member.offset}`)}\n`;
+                }
+                out += `    return value\n`;
+                out += `\n`;
+            }
+            out += `\n`;
+            out += `class ${className}Dataset:\n`;
+            out += `    def __init__(self, name, size, decode):\n`;
+            out += `        self.name = name\n`;
+            out += `        self.size = size\n`;
+            out += `        self.decode = decode\n`;
+            out += `        self.value = None\n`;
+            out += `        self.nettime = 0\n`;
+            out += `        self.on_change = None\n`;
+            out += `\n`;
+            out += `\n`;
+            out += `class ${className}:\n`;
+            out += `    def __init__(self):\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    let size = TemplateLinuxGateway._datasetSize(layout, dataset);
+                    out += `        self.${dataset.structName} = ${className}Dataset("${dataset.structName}", ${size}, lambda buffer, offset: ${decode(TemplateLinuxGateway._member(dataset), "offset")})\n`;
+                }
+            }
+            out += `        self._datasets = [\n`;
+            for (let dataset of template.datasets) {
+                out += `            ${dataset.isPub || dataset.isSub ? `self.${dataset.structName}` : `${className}Dataset("${dataset.structName}", 0, None)`},\n`;
+            }
+            out += `        ]\n`;
+            out += `        self._name = None\n`;
+            out += `        self._shm = None\n`;
+            out += `        self._wakeup = 0\n`;
+            out += `        self.on_connection_change = None\n`;
+            out += `        self.is_connected = False\n`;
+            out += `        self.is_operational = False\n`;
+            out += `        self.lost_updates = 0\n`;
+            out += `        self.nettime = 0\n`;
+            out += `\n`;
+            out += `    def _open(self):\n`;
+            out += `        if self.is_connected:\n`;
+            out += `            return True\n`;
+            out += `        if self._name is None:\n`;
+            out += `            return False\n`;
+            out += `        try:\n`;
+            out += `            with open("/dev/shm" + self._name, "rb") as file:\n`;
+            out += `                shm = mmap.mmap(file.fileno(), 0, mmap.MAP_SHARED, mmap.PROT_READ)\n`;
+            out += `        except (OSError, ValueError):\n`;
+            out += `            return False\n`;
+            out += `        magic, version, count, slots, size, wakeup = _HEADER.unpack_from(shm, 0)[:6]\n`;
+            out += `        if magic != GW_MAGIC or version != GW_VERSION or count != len(self._datasets) or size != len(shm):\n`;
+            out += `            shm.close()\n`;
+            out += `            return False\n`;
+            out += `        self._rings = []\n`;
+            out += `        for i, dataset in enumerate(self._datasets):\n`;
+            out += `            name, size, stride, offset, head = _RING.unpack_from(shm, GW_HEADER_SIZE + i * GW_RING_SIZE)\n`;
+            out += `            name = name.split(b"\\0", 1)[0].decode("latin-1")\n`;
+            out += `            if name != dataset.name or size != dataset.size:\n`;
+            out += `                print("gateway: {} has dataset {} ({} bytes) where {} ({} bytes) is expected".format(self._name, name, size, dataset.name, dataset.size))\n`;
+            out += `                shm.close()\n`;
+            out += `                return False\n`;
+            out += `            # the latest update is read first\n`;
+            out += `            self._rings.append([stride, offset, head - 1 if head > 0 else 0])\n`;
+            out += `        self._shm = shm\n`;
+            out += `        self._slots = slots\n`;
+            out += `        self._wakeup = wakeup\n`;
+            out += `        self.is_connected = True\n`;
+            out += `        if self.on_connection_change is not None:\n`;
+            out += `            self.on_connection_change()\n`;
+            out += `        return True\n`;
+            out += `\n`;
+            out += `    def _close(self):\n`;
+            out += `        if not self.is_connected:\n`;
+            out += `            return\n`;
+            out += `        self._shm.close()\n`;
+            out += `        self._shm = None\n`;
+            out += `        self.is_connected = False\n`;
+            out += `        self.is_operational = False\n`;
+            out += `        if self.on_connection_change is not None:\n`;
+            out += `            self.on_connection_change()\n`;
+            out += `\n`;
+            out += `    def connect(self, name="${TemplateLinuxGateway.sharedMemoryName(template)}"):\n`;
+            out += `        self._name = name if name.startswith("/") else "/" + name\n`;
+            out += `        return self._open()\n`;
+            out += `\n`;
+            out += `    def disconnect(self):\n`;
+            out += `        self._close()\n`;
+            out += `        self._name = None\n`;
+            out += `\n`;
+            out += `    def process(self):\n`;
+            out += `        if not self._open():\n`;
+            out += `            return\n`;
+            out += `        shm = self._shm\n`;
+            out += `        operational, nettime, pid = _HEADER.unpack_from(shm, 0)[6:9]\n`;
+            out += `        if pid == 0 or not _alive(pid):\n`;
+            out += `            # the gateway exited, connect to the next one in a later process()\n`;
+            out += `            self._close()\n`;
+            out += `            return\n`;
+            out += `        self.is_operational = operational != 0\n`;
+            out += `        self.nettime = nettime\n`;
+            out += `        for i, dataset in enumerate(self._datasets):\n`;
+            out += `            if dataset.size == 0:\n`;
+            out += `                continue\n`;
+            out += `            ring = self._rings[i]\n`;
+            out += `            stride, offset, cursor = ring\n`;
+            out += `            head = _HEAD.unpack_from(shm, GW_HEADER_SIZE + i * GW_RING_SIZE + GW_NAME_LENGTH + 16)[0]\n`;
+            out += `            if head - cursor > self._slots:\n`;
+            out += `                self.lost_updates += head - self._slots - cursor\n`;
+            out += `                cursor = head - self._slots\n`;
+            out += `            while cursor < head:\n`;
+            out += `                # the slot is valid if its sequence number is the same before and after reading it\n`;
+            out += `                position = offset + (cursor % self._slots) * stride\n`;
+            out += `                sequence, slot_nettime, size = _SLOT.unpack_from(shm, position)\n`;
+            out += `                value = shm[position + GW_SLOT_SIZE:position + GW_SLOT_SIZE + dataset.size]\n`;
+            out += `                valid = sequence == 2 * cursor + 2 and _HEAD.unpack_from(shm, position)[0] == sequence\n`;
+            out += `                cursor += 1\n`;
+            out += `                if not valid:\n`;
+            out += `                    self.lost_updates += 1\n`;
+            out += `                    continue\n`;
+            out += `                ring[2] = cursor\n`;
+            out += `                dataset.value = dataset.decode(value, 0)\n`;
+            out += `                dataset.nettime = slot_nettime\n`;
+            out += `                if dataset.on_change is not None:\n`;
+            out += `                    dataset.on_change()\n`;
+            out += `            ring[2] = cursor\n`;
+            out += `\n`;
+            out += `    def wait(self, timeout_ms):\n`;
+            out += `        """sleep until the gateway processed its next cycle (polled every ms), returns True if it did"""\n`;
+            out += `        end = time.monotonic() + timeout_ms / 1000\n`;
+            out += `        while True:\n`;
+            out += `            if self.is_connected:\n`;
+            out += `                wakeup = _HEADER.unpack_from(self._shm, 0)[5]\n`;
+            out += `                if wakeup != self._wakeup:\n`;
+            out += `                    self._wakeup = wakeup\n`;
+            out += `                    return True\n`;
+            out += `            if time.monotonic() >= end:\n`;
+            out += `                return False\n`;
+            out += `            time.sleep(0.001)\n`;
+            out += `\n`;
+            out += `\n`;
+            out += `def _alive(pid):\n`;
+            out += `    try:\n`;
+            out += `        os.kill(pid, 0)\n`;
+            out += `        return True\n`;
+            out += `    except PermissionError:\n`;
+            out += `        return True\n`;
+            out += `    except OSError:\n`;
+            out += `        return False\n`;
+
+            return out;
+        }
+        return generateClientPython(template, layout);
+    }
+
+    /**
+     * @param {ApplicationTemplateDataset} dataset
+     * @returns {string} array and string dimensions of the C declaration of the value, e.g. `[3][81]`
+     */
+    static _dimensions(dataset) {
+        // array comes before string length in c (unlike AS typ editor where it would be: STRING[80][0..1])
+        let out = dataset.arraySize > 0 ? `[${parseInt(dataset.arraySize)}]` : "";
+        if (dataset.dataType.includes("STRING")) {
+            out += `[${parseInt(dataset.stringLength)}]`;
+        }
+        return out;
+    }
+
+    /**
+     * @param {ApplicationTemplateDataset} dataset
+     * @returns {string} C++ type of the value, as in the dataset class of the C++ template
+     */
+    static _cppValueType(dataset) {
+        let dataType = dataset.dataType.includes("STRING") ? "char" : dataset.dataType;
+        if (Datamodel.isScalarType(dataset)) {
+            dataType = Datamodel.convertPlcType(dataType);
+        }
+        return `${dataType}${TemplateLinuxGateway._dimensions(dataset)}`;
+    }
+
+    /**
+     * @param {ApplicationTemplateDataset} dataset
+     * @returns {{dataType:string, type:string, arraySize:number, stringLength:number}} the dataset as member of the datamodel structure
+     */
+    static _member(dataset) {
+        return {dataType: dataset.dataType, type: dataset.type, arraySize: dataset.arraySize, stringLength: dataset.stringLength > 0 ? dataset.stringLength : 0};
+    }
+
+    /**
+     * @param {LayoutAnalysis} layout
+     * @param {ApplicationTemplateDataset} dataset
+     * @returns {number} size of the value
+     */
+    static _datasetSize(layout, dataset) {
+        return layout.datasets.find(item => item.name == dataset.structName).size;
+    }
+
+    /**
+     * Create a function that returns the expression decoding a member (or dataset) at a given offset, using the layout of its type
+     *
+     * @param {LayoutAnalysis} layout
+     * @param {Object.<string, function>} expressions expression of each scalar type, `enum`, `STRING`, `struct` and `array`
+     * @returns {function(Object, string):string}
+     */
+    static _decoder(layout, expressions) {
+        let types = {};
+        for (let type of layout.types) {
+            types[type.dataType] = type;
+        }
+        let platform = Datamodel.LAYOUT_PLATFORMS[layout.platform];
+
+        function element(member, offset) {
+            if (member.dataType.includes("STRING")) {
+                return expressions.STRING(offset, member.stringLength);
+            }
+            if (types[member.dataType] !== undefined) {
+                return expressions.struct(offset, member.dataType);
+            }
+            if (expressions[member.dataType] !== undefined && member.type != "enum") {
+                return expressions[member.dataType](offset);
+            }
+            return expressions.enum(offset);
+        }
+
+        function elementSize(member) {
+            if (member.dataType.includes("STRING")) {
+                return member.stringLength;
+            }
+            if (types[member.dataType] !== undefined) {
+                return types[member.dataType].size;
+            }
+            return Datamodel.getScalarLayout(member.type == "enum" ? "enum" : member.dataType, platform).size;
+        }
+
+        return (member, offset) => {
+            if (member.arraySize > 0) {
+                return expressions.array(offset, member.arraySize, elementSize(member), o => element(member, o), member);
+            }
+            return element(member, offset);
+        };
+    }
+}
+
+module.exports = {TemplateLinuxGateway};
@@ -0,0 +1,782 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const { Datamodel, GeneratedFileObj } = require('../../../datamodel');
+const { Template, ApplicationTemplate } = require('../template');
+
+class TemplateLinuxLoadgen {
+
+    /**
+     * load generator source, built as a separate executable
+     * @type {GeneratedFileObj}
+     */
+    loadgenSource;
+
+    /**
+     * {@linkcode TemplateLinuxLoadgen} Generate a synthetic load generator for the datamodel (`loadgen` feature)
+     *
+     * The load generator is a command line tool that connects to the datamodel instance as the other side of the
+     * application, i.e. in place of AR. It publishes the datasets the application subscribes to with configurable
+     * rates, bursts, value distributions and mutation ratios, and validates that the datasets published by the
+     * application respond within a latency budget. At the end it prints a report with the throughput and latency
+     * of every dataset and PASS or FAIL, which is also its exit code.
+     *
+     * The values are generated member by member from the structure of the `config_*` schema of the datamodel.
+     * As it takes the place of AR, the load generator is meant for a DMR without the AR program, e.g. the host
+     * emulation of the DMR or a target where the program is not running.
+     *
+     * Generates following {@link GeneratedFileObj}
+     * - {@linkcode loadgenSource}
+     *
+     * @param {Datamodel} datamodel
+     */
+    constructor(datamodel) {
+        let template = new Template(datamodel, true).template;
+        this.loadgenSource = {name:`${datamodel.typeName.toLowerCase()}_loadgen.c`, contents:this._generateLoadgenSource(datamodel, template), description:`${datamodel.typeName} load generator`};
+    }
+
+    /**
+     * @param {Datamodel} datamodel
+     * @returns {string} name of the load generator executable, e.g. `myapplication_loadgen`
+     */
+    static executableName(datamodel) {
+        return `${datamodel.typeName.toLowerCase()}_loadgen`;
+    }
+
+    /**
+     * @param {Datamodel} datamodel
+     * @param {ApplicationTemplate} template Linux template of the datamodel
+     * @returns {string} `[typeName]_loadgen.c`
+     */
+    _generateLoadgenSource(datamodel, template) {
+
+        /**
+         * @param {string} dataType IEC type
+         * @returns {number[]|undefined} range of an integer type as stored in C, undefined for other types
+         */
+        function integerRange(dataType) {
+            switch (dataType) {
+                case "USINT": return [0, 255];
+                case "BYTE":
+                case "SINT": return [-128, 127];
+                case "UINT": return [0, 65535];
+                case "INT": return [-32768, 32767];
+                case "UDINT": return [0, 4294967295];
+                case "DINT": return [-2147483648, 2147483647];
+                default: return undefined;
+            }
+        }
+
+        /**
+         * The statements changing the members of a value, walking the `config_*` schema of the datamodel
+         *
+         * @param {Object} node node of the schema (`struct`, `variable` or `enum`)
+         * @param {string} lvalue C expression of the value
+         * @param {{leaves:number, uses:Set<string>}} counter members generated so far, the index of a member is its phase in the distribution,
+         * and the value helpers used by them
+         * @param {number} depth array nesting, for the loop variables
+         * @param {string} indent
+         * @returns {string}
+         */
+        function generateMutate(node, lvalue, counter, depth, indent) {
+            let out = "";
+            let attributes = node.attributes;
+            let arraySize = attributes.arraySize > 0 ? attributes.arraySize : 0;
+            let member = arraySize > 0 ? `${lvalue}[i${depth}]` : lvalue;
+            let k = `${counter.leaves}${[...Array(depth + (arraySize > 0 ? 1 : 0)).keys()].map(i => ` + i${i}`).join("")}`;
+
+            if (arraySize > 0) {
+                out += `${indent}for (uint32_t i${depth} = 0; i${depth} < ${arraySize}; i${depth}++)\n`;
+                out += `${indent}{\n`;
+                indent += "    ";
+            }
+
+            if (node.name == "struct") {
+                for (let child of node.children) {
+                    out += generateMutate(child, `${member}.${child.attributes.name}`, counter, depth + (arraySize > 0 ? 1 : 0), indent);
+                }
+            }
+            else {
+                let type = Datamodel.convertPlcType(attributes.dataType);
+                let range = integerRange(attributes.dataType);
+                counter.leaves++;
+                out += `${indent}if (loadgen_mutates(dataset))\n`;
+                if (node.name == "enum") {
+                    counter.uses.add("integer");
+                    out += `${indent}    ${member} = (${type})loadgen_enum_${attributes.dataType}[(uint32_t)loadgen_integer(dataset, ${k}, 0, ${node.children.length - 1})];\n`;
+                }
+                else if (attributes.dataType == "STRING") {
+                    counter.uses.add("string");
+                    out += `${indent}    loadgen_string(dataset, ${k}, ${member}, sizeof(${member}));\n`;
+                }
+                else if (attributes.dataType == "BOOL") {
+                    out += `${indent}    ${member} = loadgen_value(dataset, ${k}) >= 0.5;\n`;
+                }
+                else if (range !== undefined) {
+                    counter.uses.add("integer");
+                    out += `${indent}    ${member} = (${type})loadgen_integer(dataset, ${k}, ${range[0]}.0, ${range[1]}.0);\n`;
+                }
+                else {
+                    counter.uses.add("real");
+                    out += `${indent}    ${member} = (${type})loadgen_real(dataset, ${k});\n`;
+                }
+            }
+
+            if (arraySize > 0) {
+                out += `${indent.slice(4)}}\n`;
+            }
+            return out;
+        }
+
+        /**
+         * @param {Object} node node of the schema
+         * @param {Object.<string, number[]>} enums values of the enums found so far, by enum type
+         */
+        function collectEnums(node, enums) {
+            if (node.name == "enum") {
+                enums[node.attributes.dataType] = node.children.map(value => value.attributes.value);
+            }
+            else if (node.name == "struct") {
+                for (let child of node.children) {
+                    collectEnums(child, enums);
+                }
+            }
+        }
+
+        /**
+         * @param {Datamodel} datamodel
+         * @param {ApplicationTemplate} template
+         * @returns {string}
+         */
+        function generateLoadgenSource(datamodel, template) {
+            let structName = template.datamodel.structName;
+            let executable = TemplateLinuxLoadgen.executableName(datamodel);
+            let datasets = template.datasets.filter(dataset => !dataset.isPrivate && (dataset.isPub || dataset.isSub));
+            let nodes = Object.fromEntries(datamodel.dataset.children.map(node => [node.attributes.name, node]));
+            let enums = {};
+            let uses = new Set();
+            let mutates = "";
+            let out = "";
+
+            for (let dataset of datasets) {
+                collectEnums(nodes[dataset.structName], enums);
+            }
+            for (let dataset of datasets.filter(dataset => dataset.isSub)) {
+                let counter = {leaves: 0, uses: uses};
+                mutates += `static void loadgen_mutate_${dataset.structName}(loadgen_dataset_t *dataset)\n`;
+                mutates += `{\n`;
+                mutates += generateMutate(nodes[dataset.structName], `data.${dataset.structName}`, counter, 0, "    ");
+                mutates += `}\n`;
+                mutates += `\n`;
+                if (counter.leaves > 0) {
+                    uses.add("value");
+                }
+            }
+
+            out += `/* Load generator for the ${structName} datamodel, generated from its config_${structName.toLowerCase()} schema\n`;
+            out += `\n`;
+            out += `   Connects to the datamodel instance ${template.datamodelInstanceName} as the other side of the application, i.e. in place of\n`;
+            out += `   AR, so it must not be used while the AR program is connected to the instance. It publishes the datasets the\n`;
+            out += `   application subscribes to (${datasets.filter(dataset => dataset.isSub).map(dataset => dataset.structName).join(", ") || "none"}) and validates that the datasets\n`;
+            out += `   published by the application (${datasets.filter(dataset => dataset.isPub).map(dataset => dataset.structName).join(", ") || "none"}) respond within the latency budget.\n`;
+            out += `\n`;
+            out += `   usage: ./${executable} [options], where the options for a dataset apply to all published datasets without <dataset>=\n`;
+            out += `       --duration <s>                   run time in seconds (default 10)\n`;
+            out += `       --warmup <ms>                    time before the responses are validated (default 1000)\n`;
+            out += `       --rate [<dataset>=]<Hz>          publishes per second, 0 for none (default 100)\n`;
+            out += `       --burst [<dataset>=]<n>@<ms>     additionally publish <n> values back to back every <ms> (default none)\n`;
+            out += `       --dist [<dataset>=]<name>        value distribution: constant, uniform, normal, ramp or sine (default uniform)\n`;
+            out += `       --mutate [<dataset>=]<ratio>     fraction of the members changed in each publish, 0..1 (default 1)\n`;
+            out += `       --trigger <dataset>[,..]         published datasets that request a response (default all)\n`;
+            out += `       --expect <dataset>[,..]          received datasets that must respond (default all)\n`;
+            out += `       --budget <us>                    latency budget of a response (default 10000)\n`;
+            out += `       --percentile <p>                 percentile of the responses that must be within the budget (default 100)\n`;
+            out += `       --seed <n>                       seed of the random values (default 1)\n`;
+            out += `\n`;
+            out += `   The distributions give a value in [0, 1) for each member, mapped to the range of integers, to -1000..1000 for\n`;
+            out += `   REAL and LREAL, to the length of a STRING and to the values of an enum: constant is 0.5, uniform is random,\n`;
+            out += `   normal is random around 0.5 (standard deviation 0.15), ramp steps by 0.01 per publish and sine has a period\n`;
+            out += `   of 1 s, shifted by the index of the member. The first publish sets all members, then each member changes with\n`;
+            out += `   the probability of the mutation ratio.\n`;
+            out += `\n`;
+            out += `   A publish of a trigger dataset is a request to every expected dataset. The next value of an expected dataset\n`;
+            out += `   published by the application at or after the nettime of its oldest pending request answers all pending\n`;
+            out += `   requests, and the latency is the time from that request until the value is received. Requests not answered\n`;
+            out += `   within the budget are missed. The run passes if every expected dataset responded, and the percentile of its\n`;
+            out += `   responses, a timeout counted as a response above the budget, is within the budget.\n`;
+            out += `   The exit code is 0 if the run passed, 1 if it failed and 2 if the options or the connection are invalid. */\n`;
+            out += `\n`;
+            out += `#include <stdio.h>\n`;
+            out += `#include <stdlib.h>\n`;
+            out += `#include <stdint.h>\n`;
+            out += `#include <stdbool.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `#include <math.h>\n`;
+            out += `#include <time.h>\n`;
+            out += `#include <signal.h>\n`;
+            out += `#include "${template.headerName}"\n`;
+            out += `\n`;
+            out += `typedef enum\n`;
+            out += `{\n`;
+            out += `    LOADGEN_CONSTANT,\n`;
+            out += `    LOADGEN_UNIFORM,\n`;
+            out += `    LOADGEN_NORMAL,\n`;
+            out += `    LOADGEN_RAMP,\n`;
+            out += `    LOADGEN_SINE\n`;
+            out += `} loadgen_distribution_t;\n`;
+            out += `\n`;
+            out += `typedef struct loadgen_dataset\n`;
+            out += `{\n`;
+            out += `    const char *name;\n`;
+            out += `    void *value;\n`;
+            out += `    size_t size;\n`;
+            out += `    bool publish;   /* subscribed by the application */\n`;
+            out += `    bool subscribe; /* published by the application */\n`;
+            out += `    void (*mutate)(struct loadgen_dataset *dataset);\n`;
+            out += `    exos_dataset_handle_t handle;\n`;
+            out += `\n`;
+            out += `    double rate;\n`;
+            out += `    uint32_t burst;\n`;
+            out += `    uint32_t burst_period_ms;\n`;
+            out += `    loadgen_distribution_t distribution;\n`;
+            out += `    double ratio;\n`;
+            out += `    bool trigger;\n`;
+            out += `    bool expect;\n`;
+            out += `\n`;
+            out += `    uint64_t publishes;\n`;
+            out += `    uint64_t scheduled; /* publishes due at the rate so far */\n`;
+            out += `    uint64_t bursts;\n`;
+            out += `    uint64_t errors;\n`;
+            out += `    int64_t next_burst_us;\n`;
+            out += `\n`;
+            out += `    uint64_t received;\n`;
+            out += `    uint64_t responses;\n`;
+            out += `    uint64_t answered; /* requests */\n`;
+            out += `    uint64_t missed;   /* requests not answered within the budget */\n`;
+            out += `    uint64_t timeouts; /* responses that did not come within the budget */\n`;
+            out += `    uint64_t pending;  /* requests since the last response */\n`;
+            out += `    int64_t pending_us;\n`;
+            out += `    int32_t pending_nettime;\n`;
+            out += `    int64_t *latencies;\n`;
+            out += `    size_t latency_count;\n`;
+            out += `    size_t latency_size;\n`;
+            out += `} loadgen_dataset_t;\n`;
+            out += `\n`;
+            out += `static ${structName} data;\n`;
+            out += `static exos_datamodel_handle_t datamodel;\n`;
+            out += `static volatile sig_atomic_t terminated = 0;\n`;
+            out += `static bool aborted = false;\n`;
+            out += `static bool validating = false;\n`;
+            out += `static double loadgen_time = 0;\n`;
+            out += `static uint64_t random_state = 1;\n`;
+            out += `static int64_t budget_us = 10000;\n`;
+            out += `static double percentile = 100;\n`;
+            out += `\n`;
+            for (let [type, values] of Object.entries(enums)) {
+                out += `static const int32_t loadgen_enum_${type}[] = {${values.join(", ")}};\n`;
+            }
+            if (Object.keys(enums).length > 0) {
+                out += `\n`;
+            }
+
+            out += `static int64_t loadgen_now_us(void)\n`;
+            out += `{\n`;
+            out += `    struct timespec ts;\n`;
+            out += `    clock_gettime(CLOCK_MONOTONIC, &ts);\n`;
+            out += `    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `/* xorshift64*, uniform in [0, 1) */\n`;
+            out += `static double loadgen_random(void)\n`;
+            out += `{\n`;
+            out += `    random_state ^= random_state >> 12;\n`;
+            out += `    random_state ^= random_state << 25;\n`;
+            out += `    random_state ^= random_state >> 27;\n`;
+            out += `    return (double)((random_state * 2685821657736338717ULL) >> 11) / 9007199254740992.0;\n`;
+            out += `}\n`;
+            out += `\n`;
+            if (uses.has("value")) {
+                out += `/* the value in [0, 1) of member k in the distribution of the dataset */\n`;
+                out += `static double loadgen_value(const loadgen_dataset_t *dataset, uint32_t k)\n`;
+                out += `{\n`;
+                out += `    double value;\n`;
+                out += `\n`;
+                out += `    switch (dataset->distribution)\n`;
+                out += `    {\n`;
+                out += `    case LOADGEN_CONSTANT:\n`;
+                out += `        return 0.5;\n`;
+                out += `    case LOADGEN_NORMAL:\n`;
+                out += `        value = 0.5 + 0.15 * sqrt(-2.0 * log(1.0 - loadgen_random())) * cos(2.0 * M_PI * loadgen_random());\n`;
+                out += `        return value < 0.0 ? 0.0 : value > 0.999999 ? 0.999999 : value;\n`;
+                out += `    case LOADGEN_RAMP:\n`;
+                out += `        return fmod((double)(dataset->publishes + k) * 0.01, 1.0);\n`;
+                out += `    case LOADGEN_SINE:\n`;
+                out += `        return 0.5 + 0.499999 * sin(2.0 * M_PI * (loadgen_time + k * 0.01));\n`;
+                out += `    default:\n`;
+                out += `        return loadgen_random();\n`;
+                out += `    }\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `static bool loadgen_mutates(const loadgen_dataset_t *dataset)\n`;
+                out += `{\n`;
+                out += `    return 0 == dataset->publishes || dataset->ratio >= 1.0 || loadgen_random() < dataset->ratio;\n`;
+                out += `}\n`;
+                out += `\n`;
+            }
+            if (uses.has("integer")) {
+                out += `static double loadgen_integer(const loadgen_dataset_t *dataset, uint32_t k, double min, double max)\n`;
+                out += `{\n`;
+                out += `    double value = min + floor(loadgen_value(dataset, k) * (max - min + 1.0));\n`;
+                out += `    return value > max ? max : value;\n`;
+                out += `}\n`;
+                out += `\n`;
+            }
+            if (uses.has("real")) {
+                out += `static double loadgen_real(const loadgen_dataset_t *dataset, uint32_t k)\n`;
+                out += `{\n`;
+                out += `    return -1000.0 + 2000.0 * loadgen_value(dataset, k);\n`;
+                out += `}\n`;
+                out += `\n`;
+            }
+            if (uses.has("string")) {
+                out += `static void loadgen_string(const loadgen_dataset_t *dataset, uint32_t k, char *value, size_t size)\n`;
+                out += `{\n`;
+                out += `    size_t length = (size_t)(loadgen_value(dataset, k) * (double)(size - 1));\n`;
+                out += `    for (size_t i = 0; i < length; i++)\n`;
+                out += `        value[i] = (char)('a' + (k + i + dataset->publishes) % 26);\n`;
+                out += `    value[length] = '\\0';\n`;
+                out += `}\n`;
+                out += `\n`;
+            }
+            out += mutates;
+
+            out += `static loadgen_dataset_t datasets[] = {\n`;
+            for (let dataset of datasets) {
+                let mutate = dataset.isSub ? `loadgen_mutate_${dataset.structName}` : "NULL";
+                out += `    {.name = "${dataset.structName}", .value = &data.${dataset.structName}, .size = sizeof(data.${dataset.structName}), .publish = ${dataset.isSub}, .subscribe = ${dataset.isPub}, .mutate = ${mutate}},\n`;
+            }
+            out += `};\n`;
+            out += `#define LOADGEN_DATASETS (sizeof(datasets) / sizeof(datasets[0]))\n`;
+            out += `\n`;
+
+            out += `static loadgen_dataset_t *loadgen_find(const char *name, size_t length)\n`;
+            out += `{\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        if (strlen(datasets[i].name) == length && 0 == strncmp(datasets[i].name, name, length))\n`;
+            out += `            return &datasets[i];\n`;
+            out += `    }\n`;
+            out += `    return NULL;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `/* applies the option value to the dataset named in <dataset>=<value>, or to all published datasets */\n`;
+            out += `static bool loadgen_dataset_option(const char *option, const char *arg, bool (*apply)(loadgen_dataset_t *dataset, const char *value))\n`;
+            out += `{\n`;
+            out += `    const char *separator = strchr(arg, '=');\n`;
+            out += `    bool valid = true;\n`;
+            out += `\n`;
+            out += `    if (NULL != separator)\n`;
+            out += `    {\n`;
+            out += `        loadgen_dataset_t *dataset = loadgen_find(arg, (size_t)(separator - arg));\n`;
+            out += `        if (NULL == dataset || !dataset->publish)\n`;
+            out += `        {\n`;
+            out += `            fprintf(stderr, "%s: no published dataset %.*s\\n", option, (int)(separator - arg), arg);\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `        valid = apply(dataset, separator + 1);\n`;
+            out += `    }\n`;
+            out += `    else\n`;
+            out += `    {\n`;
+            out += `        for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `        {\n`;
+            out += `            if (datasets[i].publish)\n`;
+            out += `                valid = apply(&datasets[i], arg) && valid;\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `    if (!valid)\n`;
+            out += `        fprintf(stderr, "%s: invalid value %s\\n", option, arg);\n`;
+            out += `    return valid;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static bool loadgen_apply_rate(loadgen_dataset_t *dataset, const char *value)\n`;
+            out += `{\n`;
+            out += `    char *end;\n`;
+            out += `    dataset->rate = strtod(value, &end);\n`;
+            out += `    return end != value && '\\0' == *end && dataset->rate >= 0;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static bool loadgen_apply_burst(loadgen_dataset_t *dataset, const char *value)\n`;
+            out += `{\n`;
+            out += `    return 2 == sscanf(value, "%u@%u", &dataset->burst, &dataset->burst_period_ms) && dataset->burst_period_ms > 0;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static bool loadgen_apply_distribution(loadgen_dataset_t *dataset, const char *value)\n`;
+            out += `{\n`;
+            out += `    static const char *names[] = {"constant", "uniform", "normal", "ramp", "sine"};\n`;
+            out += `    for (uint32_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)\n`;
+            out += `    {\n`;
+            out += `        if (0 == strcmp(names[i], value))\n`;
+            out += `        {\n`;
+            out += `            dataset->distribution = (loadgen_distribution_t)i;\n`;
+            out += `            return true;\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `    return false;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static bool loadgen_apply_ratio(loadgen_dataset_t *dataset, const char *value)\n`;
+            out += `{\n`;
+            out += `    char *end;\n`;
+            out += `    dataset->ratio = strtod(value, &end);\n`;
+            out += `    return end != value && '\\0' == *end && dataset->ratio >= 0 && dataset->ratio <= 1;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `/* sets trigger (published datasets) or expect (received datasets) for the datasets in the list, and clears it for the others */\n`;
+            out += `static bool loadgen_dataset_list(const char *option, const char *arg, bool published)\n`;
+            out += `{\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        if (published)\n`;
+            out += `            datasets[i].trigger = false;\n`;
+            out += `        else\n`;
+            out += `            datasets[i].expect = false;\n`;
+            out += `    }\n`;
+            out += `    while ('\\0' != *arg)\n`;
+            out += `    {\n`;
+            out += `        size_t length = strcspn(arg, ",");\n`;
+            out += `        loadgen_dataset_t *dataset = loadgen_find(arg, length);\n`;
+            out += `        if (NULL == dataset || (published ? !dataset->publish : !dataset->subscribe))\n`;
+            out += `        {\n`;
+            out += `            fprintf(stderr, "%s: no %s dataset %.*s\\n", option, published ? "published" : "received", (int)length, arg);\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `        if (published)\n`;
+            out += `            dataset->trigger = true;\n`;
+            out += `        else\n`;
+            out += `            dataset->expect = true;\n`;
+            out += `        arg += length;\n`;
+            out += `        if (',' == *arg)\n`;
+            out += `            arg++;\n`;
+            out += `    }\n`;
+            out += `    return true;\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `static void loadgen_request(int64_t now)\n`;
+            out += `{\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        loadgen_dataset_t *dataset = &datasets[i];\n`;
+            out += `        if (!dataset->expect)\n`;
+            out += `            continue;\n`;
+            out += `        if (0 == dataset->pending)\n`;
+            out += `        {\n`;
+            out += `            dataset->pending_us = now;\n`;
+            out += `            dataset->pending_nettime = exos_datamodel_get_nettime(&datamodel);\n`;
+            out += `        }\n`;
+            out += `        dataset->pending++;\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void loadgen_publish(loadgen_dataset_t *dataset, int64_t now)\n`;
+            out += `{\n`;
+            out += `    dataset->mutate(dataset);\n`;
+            out += `    if (EXOS_ERROR_OK != exos_dataset_publish(&dataset->handle))\n`;
+            out += `    {\n`;
+            out += `        dataset->errors++;\n`;
+            out += `        return;\n`;
+            out += `    }\n`;
+            out += `    dataset->publishes++;\n`;
+            out += `    if (validating && dataset->trigger)\n`;
+            out += `        loadgen_request(now);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void loadgen_response(loadgen_dataset_t *dataset, int32_t nettime)\n`;
+            out += `{\n`;
+            out += `    // a value published before the oldest pending request does not answer it\n`;
+            out += `    if (0 == dataset->pending || (int32_t)(nettime - dataset->pending_nettime) < 0)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    if (dataset->latency_count == dataset->latency_size)\n`;
+            out += `    {\n`;
+            out += `        size_t size = dataset->latency_size > 0 ? 2 * dataset->latency_size : 1024;\n`;
+            out += `        int64_t *latencies = realloc(dataset->latencies, size * sizeof(int64_t));\n`;
+            out += `        if (NULL == latencies)\n`;
+            out += `            return;\n`;
+            out += `        dataset->latencies = latencies;\n`;
+            out += `        dataset->latency_size = size;\n`;
+            out += `    }\n`;
+            out += `    dataset->latencies[dataset->latency_count++] = loadgen_now_us() - dataset->pending_us;\n`;
+            out += `    dataset->responses++;\n`;
+            out += `    dataset->answered += dataset->pending;\n`;
+            out += `    dataset->pending = 0;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void loadgen_timeouts(int64_t now)\n`;
+            out += `{\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        loadgen_dataset_t *dataset = &datasets[i];\n`;
+            out += `        if (dataset->pending > 0 && now - dataset->pending_us > budget_us)\n`;
+            out += `        {\n`;
+            out += `            dataset->missed += dataset->pending;\n`;
+            out += `            dataset->timeouts++;\n`;
+            out += `            dataset->pending = 0;\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `static void datamodelEvent(exos_datamodel_handle_t *handle, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info)\n`;
+            out += `{\n`;
+            out += `    if (EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED == event_type && EXOS_STATE_ABORTED == handle->connection_state)\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "datamodel %s aborted: %s\\n", handle->name, exos_get_error_string(handle->error));\n`;
+            out += `        aborted = true;\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void datasetEvent(exos_dataset_handle_t *handle, EXOS_DATASET_EVENT_TYPE event_type, void *info)\n`;
+            out += `{\n`;
+            out += `    loadgen_dataset_t *dataset = (loadgen_dataset_t *)handle->user_context;\n`;
+            out += `\n`;
+            out += `    if (EXOS_DATASET_EVENT_UPDATED != event_type || !dataset->subscribe)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    dataset->received++;\n`;
+            out += `    if (validating && dataset->expect)\n`;
+            out += `        loadgen_response(dataset, handle->nettime);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void loadgen_terminate(int signal)\n`;
+            out += `{\n`;
+            out += `    terminated = 1;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static int loadgen_compare(const void *a, const void *b)\n`;
+            out += `{\n`;
+            out += `    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;\n`;
+            out += `    return x < y ? -1 : x > y;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `/* the latency (us) of the response at the percentile p, INT64_MAX if it is a timeout */\n`;
+            out += `static int64_t loadgen_percentile(const loadgen_dataset_t *dataset, double p)\n`;
+            out += `{\n`;
+            out += `    uint64_t count = dataset->latency_count + dataset->timeouts;\n`;
+            out += `    uint64_t index = (uint64_t)ceil(p / 100.0 * (double)count);\n`;
+            out += `\n`;
+            out += `    index = index > 0 ? index - 1 : 0;\n`;
+            out += `    return index < dataset->latency_count ? dataset->latencies[index] : INT64_MAX;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `/* prints the report and returns true if the run passed */\n`;
+            out += `static bool loadgen_report(double seconds)\n`;
+            out += `{\n`;
+            out += `    bool passed = !aborted;\n`;
+            out += `\n`;
+            out += `    printf("load generator ${template.datamodelInstanceName}: %.1f s, latency budget %lld us at p%g\\n", seconds, (long long)budget_us, percentile);\n`;
+            out += `    printf("published:\\n");\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        loadgen_dataset_t *dataset = &datasets[i];\n`;
+            out += `        if (!dataset->publish)\n`;
+            out += `            continue;\n`;
+            out += `        printf("    %-20s %8llu publishes %10.1f/s %12.1f kB/s, %llu bursts, %llu errors%s\\n", dataset->name, (unsigned long long)dataset->publishes,\n`;
+            out += `               dataset->publishes / seconds, dataset->publishes * dataset->size / seconds / 1000.0, (unsigned long long)dataset->bursts,\n`;
+            out += `               (unsigned long long)dataset->errors, dataset->trigger ? "" : " (no trigger)");\n`;
+            out += `    }\n`;
+            out += `    printf("received:\\n");\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        loadgen_dataset_t *dataset = &datasets[i];\n`;
+            out += `        int64_t checked;\n`;
+            out += `        double sum = 0;\n`;
+            out += `        if (!dataset->subscribe)\n`;
+            out += `            continue;\n`;
+            out += `\n`;
+            out += `        printf("    %-20s %8llu received %10.1f/s", dataset->name, (unsigned long long)dataset->received, dataset->received / seconds);\n`;
+            out += `        if (!dataset->expect)\n`;
+            out += `        {\n`;
+            out += `            printf(" (not expected)\\n");\n`;
+            out += `            continue;\n`;
+            out += `        }\n`;
+            out += `        printf(", %llu responses to %llu requests, %llu missed", (unsigned long long)dataset->responses, (unsigned long long)dataset->answered,\n`;
+            out += `               (unsigned long long)dataset->missed);\n`;
+            out += `        if (0 == dataset->responses)\n`;
+            out += `        {\n`;
+            out += `            printf(": FAIL (no response)\\n");\n`;
+            out += `            passed = false;\n`;
+            out += `            continue;\n`;
+            out += `        }\n`;
+            out += `        qsort(dataset->latencies, dataset->latency_count, sizeof(int64_t), loadgen_compare);\n`;
+            out += `        for (size_t j = 0; j < dataset->latency_count; j++)\n`;
+            out += `            sum += (double)dataset->latencies[j];\n`;
+            out += `        checked = loadgen_percentile(dataset, percentile);\n`;
+            out += `        printf("\\n        latency us: min %lld avg %.0f p50 %lld p99 %lld max %lld", (long long)dataset->latencies[0], sum / dataset->latency_count,\n`;
+            out += `               (long long)loadgen_percentile(dataset, 50), (long long)loadgen_percentile(dataset, 99), (long long)dataset->latencies[dataset->latency_count - 1]);\n`;
+            out += `        if (checked > budget_us)\n`;
+            out += `        {\n`;
+            out += `            if (INT64_MAX == checked)\n`;
+            out += `                printf(": FAIL (p%g timed out)\\n", percentile);\n`;
+            out += `            else\n`;
+            out += `                printf(": FAIL (p%g %lld us)\\n", percentile, (long long)checked);\n`;
+            out += `            passed = false;\n`;
+            out += `        }\n`;
+            out += `        else\n`;
+            out += `        {\n`;
+            out += `            printf(": ok\\n");\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `    if (aborted)\n`;
+            out += `        printf("datamodel connection aborted\\n");\n`;
+            out += `    printf("result: %s\\n", passed ? "PASS" : "FAIL");\n`;
+            out += `    fflush(stdout);\n`;
+            out += `    return passed;\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `int main(int argc, char **argv)\n`;
+            out += `{\n`;
+            out += `    double duration = 10;\n`;
+            out += `    int64_t warmup_us = 1000000;\n`;
+            out += `    int64_t start, now;\n`;
+            out += `    bool passed;\n`;
+            out += `\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        datasets[i].rate = 100;\n`;
+            out += `        datasets[i].distribution = LOADGEN_UNIFORM;\n`;
+            out += `        datasets[i].ratio = 1;\n`;
+            out += `        datasets[i].trigger = datasets[i].publish;\n`;
+            out += `        datasets[i].expect = datasets[i].subscribe;\n`;
+            out += `    }\n`;
+            out += `    for (int i = 1; i < argc; i++)\n`;
+            out += `    {\n`;
+            out += `        const char *option = argv[i];\n`;
+            out += `        const char *arg = i + 1 < argc ? argv[i + 1] : NULL;\n`;
+            out += `        bool valid;\n`;
+            out += `\n`;
+            out += `        if (NULL == arg)\n`;
+            out += `            valid = false;\n`;
+            out += `        else if (0 == strcmp(option, "--duration"))\n`;
+            out += `            valid = (duration = atof(arg)) > 0;\n`;
+            out += `        else if (0 == strcmp(option, "--warmup"))\n`;
+            out += `            valid = (warmup_us = atoll(arg) * 1000) >= 0;\n`;
+            out += `        else if (0 == strcmp(option, "--rate"))\n`;
+            out += `            valid = loadgen_dataset_option(option, arg, loadgen_apply_rate);\n`;
+            out += `        else if (0 == strcmp(option, "--burst"))\n`;
+            out += `            valid = loadgen_dataset_option(option, arg, loadgen_apply_burst);\n`;
+            out += `        else if (0 == strcmp(option, "--dist"))\n`;
+            out += `            valid = loadgen_dataset_option(option, arg, loadgen_apply_distribution);\n`;
+            out += `        else if (0 == strcmp(option, "--mutate"))\n`;
+            out += `            valid = loadgen_dataset_option(option, arg, loadgen_apply_ratio);\n`;
+            out += `        else if (0 == strcmp(option, "--trigger"))\n`;
+            out += `            valid = loadgen_dataset_list(option, arg, true);\n`;
+            out += `        else if (0 == strcmp(option, "--expect"))\n`;
+            out += `            valid = loadgen_dataset_list(option, arg, false);\n`;
+            out += `        else if (0 == strcmp(option, "--budget"))\n`;
+            out += `            valid = (budget_us = atoll(arg)) > 0;\n`;
+            out += `        else if (0 == strcmp(option, "--percentile"))\n`;
+            out += `            valid = (percentile = atof(arg)) > 0 && percentile <= 100;\n`;
+            out += `        else if (0 == strcmp(option, "--seed"))\n`;
+            out += `            valid = (random_state = strtoull(arg, NULL, 0)) != 0;\n`;
+            out += `        else\n`;
+            out += `            valid = false;\n`;
+            out += `\n`;
+            out += `        if (!valid)\n`;
+            out += `        {\n`;
+            out += `            fprintf(stderr, "usage: %s [--duration <s>] [--warmup <ms>] [--rate [<dataset>=]<Hz>] [--burst [<dataset>=]<n>@<ms>]\\n"\n`;
+            out += `                            "    [--dist [<dataset>=]constant|uniform|normal|ramp|sine] [--mutate [<dataset>=]<ratio>] [--trigger <dataset>[,..]]\\n"\n`;
+            out += `                            "    [--expect <dataset>[,..]] [--budget <us>] [--percentile <p>] [--seed <n>]\\n", argv[0]);\n`;
+            out += `            return 2;\n`;
+            out += `        }\n`;
+            out += `        i++;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    if (EXOS_ERROR_OK != exos_datamodel_init(&datamodel, "${template.datamodelInstanceName}", "${executable}"))\n`;
+            out += `        return 2;\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        if (EXOS_ERROR_OK != exos_dataset_init(&datasets[i].handle, &datamodel, datasets[i].name, datasets[i].value, datasets[i].size))\n`;
+            out += `            return 2;\n`;
+            out += `        datasets[i].handle.user_context = &datasets[i];\n`;
+            out += `    }\n`;
+            out += `    if (EXOS_ERROR_OK != exos_datamodel_connect_${structName.toLowerCase()}(&datamodel, datamodelEvent))\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "cannot connect to ${template.datamodelInstanceName}\\n");\n`;
+            out += `        return 2;\n`;
+            out += `    }\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        EXOS_DATASET_TYPE type = (datasets[i].publish ? EXOS_DATASET_PUBLISH : 0) | (datasets[i].subscribe ? EXOS_DATASET_SUBSCRIBE : 0);\n`;
+            out += `        if (EXOS_ERROR_OK != exos_dataset_connect(&datasets[i].handle, type, datasetEvent))\n`;
+            out += `        {\n`;
+            out += `            fprintf(stderr, "cannot connect dataset %s\\n", datasets[i].name);\n`;
+            out += `            return 2;\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `    exos_datamodel_set_operational(&datamodel);\n`;
+            out += `\n`;
+            out += `    signal(SIGINT, loadgen_terminate);\n`;
+            out += `    signal(SIGTERM, loadgen_terminate);\n`;
+            out += `\n`;
+            out += `    start = loadgen_now_us();\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `        datasets[i].next_burst_us = start + (int64_t)datasets[i].burst_period_ms * 1000;\n`;
+            out += `    while (!terminated && !aborted)\n`;
+            out += `    {\n`;
+            out += `        exos_datamodel_process(&datamodel);\n`;
+            out += `\n`;
+            out += `        now = loadgen_now_us();\n`;
+            out += `        loadgen_time = (now - start) / 1e6;\n`;
+            out += `        if (loadgen_time >= duration)\n`;
+            out += `            break;\n`;
+            out += `        validating = now - start >= warmup_us;\n`;
+            out += `\n`;
+            out += `        for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `        {\n`;
+            out += `            loadgen_dataset_t *dataset = &datasets[i];\n`;
+            out += `            if (!dataset->publish)\n`;
+            out += `                continue;\n`;
+            out += `\n`;
+            out += `            while (dataset->scheduled < (uint64_t)(loadgen_time * dataset->rate))\n`;
+            out += `            {\n`;
+            out += `                dataset->scheduled++;\n`;
+            out += `                loadgen_publish(dataset, now);\n`;
+            out += `            }\n`;
+            out += `            if (dataset->burst > 0 && now >= dataset->next_burst_us)\n`;
+            out += `            {\n`;
+            out += `                for (uint32_t j = 0; j < dataset->burst; j++)\n`;
+            out += `                    loadgen_publish(dataset, now);\n`;
+            out += `                dataset->bursts++;\n`;
+            out += `                dataset->next_burst_us += (int64_t)dataset->burst_period_ms * 1000;\n`;
+            out += `            }\n`;
+            out += `        }\n`;
+            out += `        loadgen_timeouts(now);\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    passed = loadgen_report((loadgen_now_us() - start) / 1e6);\n`;
+            out += `\n`;
+            out += `    exos_datamodel_disconnect(&datamodel);\n`;
+            out += `    for (size_t i = 0; i < LOADGEN_DATASETS; i++)\n`;
+            out += `    {\n`;
+            out += `        exos_dataset_delete(&datasets[i].handle);\n`;
+            out += `        free(datasets[i].latencies);\n`;
+            out += `    }\n`;
+            out += `    exos_datamodel_delete(&datamodel);\n`;
+            out += `    return passed ? 0 : 1;\n`;
+            out += `}\n`;
+
+            return out;
+        }
+        return generateLoadgenSource(datamodel, template);
+    }
+}
+
+module.exports = {TemplateLinuxLoadgen};
@@ -0,0 +1,713 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const {GeneratedFileObj} = require('../../../datamodel')
+const {ApplicationTemplate} = require('../template')
+
+class TemplateLinuxMetrics {
+
+    /**
+     * OpenMetrics exporter header
+     * @type {GeneratedFileObj}
+     */
+    metricsHeader;
+
+    /**
+     * OpenMetrics exporter source code
+     * @type {GeneratedFileObj}
+     */
+    metricsSource;
+
+    /**
+     * {@linkcode TemplateLinuxMetrics} Generate code for exporting the metrics of Linux applications to Prometheus (`metrics` feature)
+     *
+     * The exporter is enabled with command line arguments, i.e. in the `Runtime` service of the .exospkg. It serves the
+     * metrics over HTTP on a TCP port or a UNIX socket, in the OpenMetrics or Prometheus text format, or writes them to a
+     * file for the textfile collector of the node exporter.
+     * The dataset counters, the latency and callback histograms, the send buffer high-water marks, the connection state
+     * and the sync diagnostics are collected without locks in the thread calling process(), and formatted in an exporter thread.
+     *
+     * Generates following {@link GeneratedFileObj} objects
+     * - {@linkcode metricsHeader}
+     * - {@linkcode metricsSource}
+     */
+    constructor() {
+        this.metricsHeader = {name:"metrics.h", contents:this._generateMetricsHeader(), description:"OpenMetrics exporter header"};
+        this.metricsSource = {name:"metrics.c", contents:this._generateMetricsSource(), description:"OpenMetrics exporter source"};
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @returns {string} name of the array with the dataset names passed to `metrics_setup()`
+     */
+    static datasetNamesArray(template) {
+        return `${template.datamodel.varName}_metrics_datasets`;
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @returns {string} array with the names of the datasets in the order of the dataset index, NULL for datasets that are neither published nor received
+     */
+    static generateDatasetNames(template) {
+        let out = "";
+
+        out += `static const char *const ${TemplateLinuxMetrics.datasetNamesArray(template)}[] = {\n`;
+        for (let dataset of template.datasets) {
+            out += `    ${(dataset.isPub || dataset.isSub) ? `"${dataset.structName}"` : "NULL"},\n`;
+        }
+        out += `};\n`;
+
+        return out;
+    }
+
+    _generateMetricsHeader() {
+        function generateMetricsHeader() {
+            let out = "";
+
+            out += `#ifndef _METRICS_H_\n`;
+            out += `#define _METRICS_H_\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `extern "C" {\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#include <stdbool.h>\n`;
+            out += `#include <stdint.h>\n`;
+            out += `#include <stddef.h>\n`;
+            out += `\n`;
+            out += `/* OpenMetrics exporter, enabled with command line arguments (Runtime service in the .exospkg):\n`;
+            out += `    --metrics-port <port>         serve the metrics over HTTP on this TCP port, e.g. http://localhost:<port>/metrics\n`;
+            out += `    --metrics-address <address>   IPv4 address of --metrics-port (default: 127.0.0.1, 0.0.0.0 for all interfaces)\n`;
+            out += `    --metrics-socket <path>       serve the metrics over HTTP on this UNIX socket\n`;
+            out += `    --metrics-file <path>         write the metrics to this file, e.g. for the textfile collector of the node exporter\n`;
+            out += `    --metrics-interval <ms>       interval of writing --metrics-file (default: 5000)\n`;
+            out += `\n`;
+            out += `   The metrics are collected by the thread calling process(), without locks or system calls (apart from reading the\n`;
+            out += `   clock around the callbacks): each value has this single writer, and the exporter thread reads it with a relaxed\n`;
+            out += `   atomic load. The exporter thread formats the metrics when they are scraped or written, so that scraping never\n`;
+            out += `   delays process(). Clients accepting application/openmetrics-text get OpenMetrics 1.0, other clients and the file\n`;
+            out += `   the Prometheus text format 0.0.4.\n`;
+            out += `\n`;
+            out += `   Series, labeled with datamodel and dataset:\n`;
+            out += `    exos_dataset_updates_total, exos_dataset_received_bytes_total       received datasets\n`;
+            out += `    exos_dataset_publishes_total, exos_dataset_published_bytes_total    published datasets\n`;
+            out += `    exos_dataset_latency_seconds                                        histogram of the latency (nettime) of received datasets\n`;
+            out += `    exos_dataset_callback_seconds                                       histogram of the execution time of the callbacks\n`;
+            out += `    exos_dataset_send_buffer_used_max, exos_dataset_send_buffer_free_min  send buffer high-water marks\n`;
+            out += `   labeled with datamodel:\n`;
+            out += `    exos_datamodel_connection_state{state="..."}                       1 for the current connection state\n`;
+            out += `    exos_datamodel_missed_dmr_cycles, exos_datamodel_missed_ar_cycles   sync diagnostics\n`;
+            out += `*/\n`;
+            out += `\n`;
+            out += `/* start the exporter if --metrics-port, --metrics-socket or --metrics-file is given, returns true if exporting.\n`;
+            out += `   The dataset names are in the order of the dataset index, NULL for datasets that are neither published nor received */\n`;
+            out += `bool metrics_setup(int argc, char **argv, const char *datamodel, const char *const *datasets, uint16_t count);\n`;
+            out += `\n`;
+            out += `/* received dataset, latency (us) from its nettime */\n`;
+            out += `void metrics_updated(uint16_t dataset, int32_t latency, size_t size);\n`;
+            out += `\n`;
+            out += `/* published dataset */\n`;
+            out += `void metrics_published(uint16_t dataset, size_t size);\n`;
+            out += `\n`;
+            out += `/* send buffer of a dataset, after it was published or delivered */\n`;
+            out += `void metrics_send_buffer(uint16_t dataset, uint32_t buffer_free, uint32_t buffer_used);\n`;
+            out += `\n`;
+            out += `/* start of a callback, returns CLOCK_MONOTONIC (ns), or 0 if not exporting */\n`;
+            out += `int64_t metrics_callback_begin(void);\n`;
+            out += `\n`;
+            out += `/* end of a callback started with metrics_callback_begin() */\n`;
+            out += `void metrics_callback_end(uint16_t dataset, int64_t begin);\n`;
+            out += `\n`;
+            out += `/* connection state of the datamodel (EXOS_CONNECTION_STATE) */\n`;
+            out += `void metrics_connection(int state);\n`;
+            out += `\n`;
+            out += `/* sync diagnostics of the datamodel */\n`;
+            out += `void metrics_sync(uint32_t missed_dmr_cycles, uint32_t missed_ar_cycles);\n`;
+            out += `\n`;
+            out += `/* stop the exporter, --metrics-file is written a last time */\n`;
+            out += `void metrics_close(void);\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `}\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#endif//_METRICS_H_\n`;
+            return out;
+        }
+        return generateMetricsHeader();
+    }
+
+    _generateMetricsSource() {
+        function generateMetricsSource() {
+            let out = "";
+
+            out += `#define _GNU_SOURCE\n`;
+            out += `#include "metrics.h"\n`;
+            out += `#include <stdio.h>\n`;
+            out += `#include <stdlib.h>\n`;
+            out += `#include <stdarg.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `#include <errno.h>\n`;
+            out += `#include <fcntl.h>\n`;
+            out += `#include <poll.h>\n`;
+            out += `#include <pthread.h>\n`;
+            out += `#include <signal.h>\n`;
+            out += `#include <time.h>\n`;
+            out += `#include <unistd.h>\n`;
+            out += `#include <arpa/inet.h>\n`;
+            out += `#include <netinet/in.h>\n`;
+            out += `#include <sys/socket.h>\n`;
+            out += `#include <sys/un.h>\n`;
+            out += `\n`;
+            out += `#define METRICS_BUCKETS 12\n`;
+            out += `\n`;
+            out += `/* upper bounds of the histogram buckets (ns), followed by +Inf */\n`;
+            out += `static const int64_t bucket_bound[METRICS_BUCKETS] = {10000, 50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000, 25000000, 50000000, 100000000};\n`;
+            out += `static const char *const bucket_label[METRICS_BUCKETS] = {"1e-05", "5e-05", "0.0001", "0.00025", "0.0005", "0.001", "0.0025", "0.005", "0.01", "0.025", "0.05", "0.1"};\n`;
+            out += `\n`;
+            out += `static const char *const connection_states[] = {"DISCONNECTED", "CONNECTED", "OPERATIONAL", "ABORTED"};\n`;
+            out += `\n`;
+            out += `/* values with a single writer (the thread calling process()), read by the exporter thread */\n`;
+            out += `#define METRICS_ADD(_value_, _add_) __atomic_store_n(&(_value_), (_value_) + (_add_), __ATOMIC_RELAXED)\n`;
+            out += `#define METRICS_SET(_value_, _new_) __atomic_store_n(&(_value_), (_new_), __ATOMIC_RELAXED)\n`;
+            out += `#define METRICS_GET(_value_) __atomic_load_n(&(_value_), __ATOMIC_RELAXED)\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    uint64_t bucket[METRICS_BUCKETS + 1]; /* observations per bucket (not cumulative), the last one above all bounds */\n`;
+            out += `    uint64_t sum;                         /* ns */\n`;
+            out += `} metrics_histogram_t;\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    const char *name;\n`;
+            out += `    uint64_t updates;\n`;
+            out += `    uint64_t received_bytes;\n`;
+            out += `    uint64_t publishes;\n`;
+            out += `    uint64_t published_bytes;\n`;
+            out += `    uint64_t send_buffer_events;\n`;
+            out += `    uint32_t send_buffer_used_max;\n`;
+            out += `    uint32_t send_buffer_free_min;\n`;
+            out += `    metrics_histogram_t latency;\n`;
+            out += `    metrics_histogram_t callback;\n`;
+            out += `} metrics_dataset_t;\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    char *data;\n`;
+            out += `    size_t length;\n`;
+            out += `    size_t size;\n`;
+            out += `} metrics_text_t;\n`;
+            out += `\n`;
+            out += `static struct\n`;
+            out += `{\n`;
+            out += `    const char *datamodel;\n`;
+            out += `    metrics_dataset_t *datasets;\n`;
+            out += `    uint16_t count;\n`;
+            out += `    int connection_state;\n`;
+            out += `    uint32_t missed_dmr_cycles;\n`;
+            out += `    uint32_t missed_ar_cycles;\n`;
+            out += `\n`;
+            out += `    int listen_fd[2]; /* TCP and UNIX socket */\n`;
+            out += `    int wake_fd[2];   /* pipe stopping the exporter thread */\n`;
+            out += `    char socket_path[sizeof(((struct sockaddr_un *)0)->sun_path)];\n`;
+            out += `    char file[4096];\n`;
+            out += `    int interval; /* ms */\n`;
+            out += `    pthread_t thread;\n`;
+            out += `    bool running;\n`;
+            out += `} metrics = {.listen_fd = {-1, -1}, .wake_fd = {-1, -1}};\n`;
+            out += `\n`;
+            out += `static int64_t clock_ns(void)\n`;
+            out += `{\n`;
+            out += `    struct timespec ts;\n`;
+            out += `    clock_gettime(CLOCK_MONOTONIC, &ts);\n`;
+            out += `    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static const char *get_argument(int argc, char **argv, const char *name)\n`;
+            out += `{\n`;
+            out += `    for (int i = 1; i < argc - 1; i++)\n`;
+            out += `    {\n`;
+            out += `        if (0 == strcmp(argv[i], name))\n`;
+            out += `            return argv[i + 1];\n`;
+            out += `    }\n`;
+            out += `    return NULL;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void observe(metrics_histogram_t *histogram, int64_t ns)\n`;
+            out += `{\n`;
+            out += `    int i = 0;\n`;
+            out += `\n`;
+            out += `    if (ns < 0)\n`;
+            out += `        ns = 0;\n`;
+            out += `    while (i < METRICS_BUCKETS && ns > bucket_bound[i])\n`;
+            out += `        i++;\n`;
+            out += `    METRICS_ADD(histogram->bucket[i], 1);\n`;
+            out += `    METRICS_ADD(histogram->sum, (uint64_t)ns);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `/* formatting, in the exporter thread */\n`;
+            out += `\n`;
+            out += `static void append(metrics_text_t *text, const char *format, ...)\n`;
+            out += `{\n`;
+            out += `    va_list args;\n`;
+            out += `    int length;\n`;
+            out += `\n`;
+            out += `    if (NULL == text->data && 0 != text->size)\n`;
+            out += `        return; // out of memory before\n`;
+            out += `\n`;
+            out += `    va_start(args, format);\n`;
+            out += `    length = vsnprintf(text->data + text->length, text->size - text->length, format, args);\n`;
+            out += `    va_end(args);\n`;
+            out += `    if (length < 0)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    if (text->length + (size_t)length >= text->size)\n`;
+            out += `    {\n`;
+            out += `        size_t size = 2 * (text->size + (size_t)length) + 4096;\n`;
+            out += `        char *data = realloc(text->data, size);\n`;
+            out += `        if (NULL == data)\n`;
+            out += `        {\n`;
+            out += `            free(text->data);\n`;
+            out += `            text->data = NULL;\n`;
+            out += `            text->size = 1;\n`;
+            out += `            return;\n`;
+            out += `        }\n`;
+            out += `        text->data = data;\n`;
+            out += `        text->size = size;\n`;
+            out += `\n`;
+            out += `        va_start(args, format);\n`;
+            out += `        vsnprintf(text->data + text->length, text->size - text->length, format, args);\n`;
+            out += `        va_end(args);\n`;
+            out += `    }\n`;
+            out += `    text->length += (size_t)length;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void family(metrics_text_t *text, bool openmetrics, const char *name, const char *type, const char *help)\n`;
+            out += `{\n`;
+            out += `    // the Prometheus text format names a counter like its samples, OpenMetrics without the _total suffix\n`;
+            out += `    const char *suffix = (!openmetrics && 0 == strcmp(type, "counter")) ? "_total" : "";\n`;
+            out += `\n`;
+            out += `    append(text, "# TYPE %s%s %s\\n", name, suffix, type);\n`;
+            out += `    append(text, "# HELP %s%s %s\\n", name, suffix, help);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void counter(metrics_text_t *text, bool openmetrics, const char *name, const char *help, size_t offset)\n`;
+            out += `{\n`;
+            out += `    family(text, openmetrics, name, "counter", help);\n`;
+            out += `    for (uint16_t i = 0; i < metrics.count; i++)\n`;
+            out += `    {\n`;
+            out += `        metrics_dataset_t *dataset = &metrics.datasets[i];\n`;
+            out += `        if (NULL != dataset->name)\n`;
+            out += `        {\n`;
+            out += `            uint64_t value = __atomic_load_n((uint64_t *)((uint8_t *)dataset + offset), __ATOMIC_RELAXED);\n`;
+            out += `            append(text, "%s_total{datamodel=\\"%s\\",dataset=\\"%s\\"} %llu\\n", name, metrics.datamodel, dataset->name, (unsigned long long)value);\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void histogram(metrics_text_t *text, bool openmetrics, const char *name, const char *help, size_t offset)\n`;
+            out += `{\n`;
+            out += `    family(text, openmetrics, name, "histogram", help);\n`;
+            out += `    for (uint16_t i = 0; i < metrics.count; i++)\n`;
+            out += `    {\n`;
+            out += `        metrics_dataset_t *dataset = &metrics.datasets[i];\n`;
+            out += `        metrics_histogram_t *values = (metrics_histogram_t *)((uint8_t *)dataset + offset);\n`;
+            out += `        uint64_t count = 0;\n`;
+            out += `\n`;
+            out += `        if (NULL == dataset->name)\n`;
+            out += `            continue;\n`;
+            out += `\n`;
+            out += `        for (int b = 0; b <= METRICS_BUCKETS; b++)\n`;
+            out += `        {\n`;
+            out += `            count += METRICS_GET(values->bucket[b]);\n`;
+            out += `            append(text, "%s_bucket{datamodel=\\"%s\\",dataset=\\"%s\\",le=\\"%s\\"} %llu\\n", name, metrics.datamodel, dataset->name,\n`;
+            out += `                   b < METRICS_BUCKETS ? bucket_label[b] : "+Inf", (unsigned long long)count);\n`;
+            out += `        }\n`;
+            out += `        append(text, "%s_count{datamodel=\\"%s\\",dataset=\\"%s\\"} %llu\\n", name, metrics.datamodel, dataset->name, (unsigned long long)count);\n`;
+            out += `        append(text, "%s_sum{datamodel=\\"%s\\",dataset=\\"%s\\"} %.9f\\n", name, metrics.datamodel, dataset->name, (double)METRICS_GET(values->sum) / 1e9);\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void format(metrics_text_t *text, bool openmetrics)\n`;
+            out += `{\n`;
+            out += `    int state = METRICS_GET(metrics.connection_state);\n`;
+            out += `\n`;
+            out += `    counter(text, openmetrics, "exos_dataset_updates", "Datasets received", offsetof(metrics_dataset_t, updates));\n`;
+            out += `    counter(text, openmetrics, "exos_dataset_received_bytes", "Bytes of the received datasets", offsetof(metrics_dataset_t, received_bytes));\n`;
+            out += `    counter(text, openmetrics, "exos_dataset_publishes", "Datasets published", offsetof(metrics_dataset_t, publishes));\n`;
+            out += `    counter(text, openmetrics, "exos_dataset_published_bytes", "Bytes of the published datasets", offsetof(metrics_dataset_t, published_bytes));\n`;
+            out += `    histogram(text, openmetrics, "exos_dataset_latency_seconds", "Latency of the received datasets, from their nettime", offsetof(metrics_dataset_t, latency));\n`;
+            out += `    histogram(text, openmetrics, "exos_dataset_callback_seconds", "Execution time of the callbacks of the received datasets", offsetof(metrics_dataset_t, callback));\n`;
+            out += `\n`;
+            out += `    family(text, openmetrics, "exos_dataset_send_buffer_used_max", "gauge", "Highest number of used entries in the send buffer");\n`;
+            out += `    for (uint16_t i = 0; i < metrics.count; i++)\n`;
+            out += `    {\n`;
+            out += `        metrics_dataset_t *dataset = &metrics.datasets[i];\n`;
+            out += `        if (NULL != dataset->name && 0 != METRICS_GET(dataset->send_buffer_events))\n`;
+            out += `            append(text, "exos_dataset_send_buffer_used_max{datamodel=\\"%s\\",dataset=\\"%s\\"} %u\\n", metrics.datamodel, dataset->name, METRICS_GET(dataset->send_buffer_used_max));\n`;
+            out += `    }\n`;
+            out += `    family(text, openmetrics, "exos_dataset_send_buffer_free_min", "gauge", "Lowest number of free entries in the send buffer");\n`;
+            out += `    for (uint16_t i = 0; i < metrics.count; i++)\n`;
+            out += `    {\n`;
+            out += `        metrics_dataset_t *dataset = &metrics.datasets[i];\n`;
+            out += `        if (NULL != dataset->name && 0 != METRICS_GET(dataset->send_buffer_events))\n`;
+            out += `            append(text, "exos_dataset_send_buffer_free_min{datamodel=\\"%s\\",dataset=\\"%s\\"} %u\\n", metrics.datamodel, dataset->name, METRICS_GET(dataset->send_buffer_free_min));\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    family(text, openmetrics, "exos_datamodel_connection_state", "gauge", "Connection state of the datamodel, 1 for the current state");\n`;
+            out += `    for (int s = 0; s < (int)(sizeof(connection_states) / sizeof(connection_states[0])); s++)\n`;
+            out += `    {\n`;
+            out += `        append(text, "exos_datamodel_connection_state{datamodel=\\"%s\\",state=\\"%s\\"} %d\\n", metrics.datamodel, connection_states[s], s == state ? 1 : 0);\n`;
+            out += `    }\n`;
+            out += `    family(text, openmetrics, "exos_datamodel_missed_dmr_cycles", "gauge", "Missed DMR cycles of the sync diagnostics");\n`;
+            out += `    append(text, "exos_datamodel_missed_dmr_cycles{datamodel=\\"%s\\"} %u\\n", metrics.datamodel, METRICS_GET(metrics.missed_dmr_cycles));\n`;
+            out += `    family(text, openmetrics, "exos_datamodel_missed_ar_cycles", "gauge", "Missed AR cycles of the sync diagnostics");\n`;
+            out += `    append(text, "exos_datamodel_missed_ar_cycles{datamodel=\\"%s\\"} %u\\n", metrics.datamodel, METRICS_GET(metrics.missed_ar_cycles));\n`;
+            out += `\n`;
+            out += `    if (openmetrics)\n`;
+            out += `        append(text, "# EOF\\n");\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void write_file(void)\n`;
+            out += `{\n`;
+            out += `    metrics_text_t text = {0};\n`;
+            out += `    char temporary[sizeof(metrics.file) + 8];\n`;
+            out += `    FILE *file;\n`;
+            out += `\n`;
+            out += `    format(&text, false);\n`;
+            out += `    if (NULL == text.data)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    // the textfile collector must not read a partly written file\n`;
+            out += `    snprintf(temporary, sizeof(temporary), "%s.tmp", metrics.file);\n`;
+            out += `    file = fopen(temporary, "w");\n`;
+            out += `    if (NULL != file)\n`;
+            out += `    {\n`;
+            out += `        bool written = text.length == fwrite(text.data, 1, text.length, file);\n`;
+            out += `        if (0 == fclose(file) && written)\n`;
+            out += `            rename(temporary, metrics.file);\n`;
+            out += `        else\n`;
+            out += `            unlink(temporary);\n`;
+            out += `    }\n`;
+            out += `    free(text.data);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void serve(int listen_fd)\n`;
+            out += `{\n`;
+            out += `    static const char *const content_type[] = {"text/plain; version=0.0.4; charset=utf-8", "application/openmetrics-text; version=1.0.0; charset=utf-8"};\n`;
+            out += `    struct timeval timeout = {.tv_sec = 1, .tv_usec = 0};\n`;
+            out += `    metrics_text_t text = {0};\n`;
+            out += `    char request[4096];\n`;
+            out += `    char header[256];\n`;
+            out += `    size_t received = 0;\n`;
+            out += `    bool openmetrics;\n`;
+            out += `    int fd;\n`;
+            out += `\n`;
+            out += `    fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);\n`;
+            out += `    if (fd < 0)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    // a client that does not send its request within the timeout gets the Prometheus text format\n`;
+            out += `    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));\n`;
+            out += `    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));\n`;
+            out += `    while (received < sizeof(request) - 1)\n`;
+            out += `    {\n`;
+            out += `        ssize_t length = recv(fd, request + received, sizeof(request) - 1 - received, 0);\n`;
+            out += `        if (length <= 0)\n`;
+            out += `            break;\n`;
+            out += `        received += (size_t)length;\n`;
+            out += `        request[received] = '\\0';\n`;
+            out += `        if (NULL != strstr(request, "\\r\\n\\r\\n"))\n`;
+            out += `            break;\n`;
+            out += `    }\n`;
+            out += `    request[received] = '\\0';\n`;
+            out += `    openmetrics = NULL != strstr(request, "application/openmetrics-text");\n`;
+            out += `\n`;
+            out += `    format(&text, openmetrics);\n`;
+            out += `    if (NULL != text.data)\n`;
+            out += `    {\n`;
+            out += `        int length = snprintf(header, sizeof(header), "HTTP/1.1 200 OK\\r\\nContent-Type: %s\\r\\nContent-Length: %zu\\r\\nConnection: close\\r\\n\\r\\n",\n`;
+            out += `                              content_type[openmetrics], text.length);\n`;
+            out += `        if (length > 0 && send(fd, header, (size_t)length, MSG_NOSIGNAL) == length)\n`;
+            out += `        {\n`;
+            out += `            size_t sent = 0;\n`;
+            out += `            while (sent < text.length)\n`;
+            out += `            {\n`;
+            out += `                ssize_t chunk = send(fd, text.data + sent, text.length - sent, MSG_NOSIGNAL);\n`;
+            out += `                if (chunk <= 0)\n`;
+            out += `                    break;\n`;
+            out += `                sent += (size_t)chunk;\n`;
+            out += `            }\n`;
+            out += `        }\n`;
+            out += `        free(text.data);\n`;
+            out += `    }\n`;
+            out += `    close(fd);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void *exporter(void *arg)\n`;
+            out += `{\n`;
+            out += `    int64_t next_write = clock_ns() + (int64_t)metrics.interval * 1000000;\n`;
+            out += `\n`;
+            out += `    (void)arg;\n`;
+            out += `\n`;
+            out += `    while (true)\n`;
+            out += `    {\n`;
+            out += `        struct pollfd fds[3] = {{.fd = metrics.wake_fd[0], .events = POLLIN},\n`;
+            out += `                                {.fd = metrics.listen_fd[0], .events = POLLIN},\n`;
+            out += `                                {.fd = metrics.listen_fd[1], .events = POLLIN}};\n`;
+            out += `        int timeout = -1;\n`;
+            out += `\n`;
+            out += `        if ('\\0' != metrics.file[0])\n`;
+            out += `        {\n`;
+            out += `            int64_t remaining = next_write - clock_ns();\n`;
+            out += `            timeout = remaining > 0 ? (int)(remaining / 1000000) + 1 : 0;\n`;
+            out += `        }\n`;
+            out += `        if (poll(fds, 3, timeout) < 0 && EINTR != errno)\n`;
+            out += `            break;\n`;
+            out += `\n`;
+            out += `        if (fds[0].revents & POLLIN)\n`;
+            out += `            break;\n`;
+            out += `        for (int i = 1; i < 3; i++)\n`;
+            out += `        {\n`;
+            out += `            if (fds[i].revents & POLLIN)\n`;
+            out += `                serve(fds[i].fd);\n`;
+            out += `        }\n`;
+            out += `        if ('\\0' != metrics.file[0] && clock_ns() >= next_write)\n`;
+            out += `        {\n`;
+            out += `            write_file();\n`;
+            out += `            next_write += (int64_t)metrics.interval * 1000000;\n`;
+            out += `            if (next_write < clock_ns())\n`;
+            out += `                next_write = clock_ns() + (int64_t)metrics.interval * 1000000;\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `    return NULL;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static int listen_tcp(const char *address, const char *port)\n`;
+            out += `{\n`;
+            out += `    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_port = htons((uint16_t)atoi(port))};\n`;
+            out += `    int enable = 1;\n`;
+            out += `    int fd;\n`;
+            out += `\n`;
+            out += `    if (1 != inet_pton(AF_INET, address, &addr.sin_addr))\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "metrics: invalid --metrics-address %s\\n", address);\n`;
+            out += `        return -1;\n`;
+            out += `    }\n`;
+            out += `    fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);\n`;
+            out += `    if (fd < 0)\n`;
+            out += `        return -1;\n`;
+            out += `    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));\n`;
+            out += `    if (0 != bind(fd, (struct sockaddr *)&addr, sizeof(addr)) || 0 != listen(fd, 8))\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "metrics: cannot listen on %s:%s: %s\\n", address, port, strerror(errno));\n`;
+            out += `        close(fd);\n`;
+            out += `        return -1;\n`;
+            out += `    }\n`;
+            out += `    return fd;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static int listen_unix(const char *path)\n`;
+            out += `{\n`;
+            out += `    struct sockaddr_un addr = {.sun_family = AF_UNIX};\n`;
+            out += `    int fd;\n`;
+            out += `\n`;
+            out += `    if (strlen(path) >= sizeof(addr.sun_path))\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "metrics: --metrics-socket %s is too long\\n", path);\n`;
+            out += `        return -1;\n`;
+            out += `    }\n`;
+            out += `    strcpy(addr.sun_path, path);\n`;
+            out += `    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);\n`;
+            out += `    if (fd < 0)\n`;
+            out += `        return -1;\n`;
+            out += `    unlink(path);\n`;
+            out += `    if (0 != bind(fd, (struct sockaddr *)&addr, sizeof(addr)) || 0 != listen(fd, 8))\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "metrics: cannot listen on %s: %s\\n", path, strerror(errno));\n`;
+            out += `        close(fd);\n`;
+            out += `        return -1;\n`;
+            out += `    }\n`;
+            out += `    snprintf(metrics.socket_path, sizeof(metrics.socket_path), "%s", path);\n`;
+            out += `    return fd;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void close_all(void)\n`;
+            out += `{\n`;
+            out += `    for (int i = 0; i < 2; i++)\n`;
+            out += `    {\n`;
+            out += `        if (metrics.listen_fd[i] >= 0)\n`;
+            out += `            close(metrics.listen_fd[i]);\n`;
+            out += `        if (metrics.wake_fd[i] >= 0)\n`;
+            out += `            close(metrics.wake_fd[i]);\n`;
+            out += `        metrics.listen_fd[i] = -1;\n`;
+            out += `        metrics.wake_fd[i] = -1;\n`;
+            out += `    }\n`;
+            out += `    if ('\\0' != metrics.socket_path[0])\n`;
+            out += `        unlink(metrics.socket_path);\n`;
+            out += `    metrics.socket_path[0] = '\\0';\n`;
+            out += `    metrics.file[0] = '\\0';\n`;
+            out += `    free(metrics.datasets);\n`;
+            out += `    metrics.datasets = NULL;\n`;
+            out += `    metrics.count = 0;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool metrics_setup(int argc, char **argv, const char *datamodel, const char *const *datasets, uint16_t count)\n`;
+            out += `{\n`;
+            out += `    const char *port = get_argument(argc, argv, "--metrics-port");\n`;
+            out += `    const char *address = get_argument(argc, argv, "--metrics-address");\n`;
+            out += `    const char *socket_path = get_argument(argc, argv, "--metrics-socket");\n`;
+            out += `    const char *file = get_argument(argc, argv, "--metrics-file");\n`;
+            out += `    const char *interval = get_argument(argc, argv, "--metrics-interval");\n`;
+            out += `    sigset_t all, previous;\n`;
+            out += `\n`;
+            out += `    if (metrics.running || (NULL == port && NULL == socket_path && NULL == file))\n`;
+            out += `        return metrics.running;\n`;
+            out += `\n`;
+            out += `    metrics.datasets = calloc(count, sizeof(metrics_dataset_t));\n`;
+            out += `    if (NULL == metrics.datasets)\n`;
+            out += `        return false;\n`;
+            out += `    for (uint16_t i = 0; i < count; i++)\n`;
+            out += `    {\n`;
+            out += `        metrics.datasets[i].name = datasets[i];\n`;
+            out += `        metrics.datasets[i].send_buffer_free_min = UINT32_MAX;\n`;
+            out += `    }\n`;
+            out += `    metrics.count = count;\n`;
+            out += `    metrics.datamodel = datamodel;\n`;
+            out += `    metrics.interval = NULL != interval ? atoi(interval) : 5000;\n`;
+            out += `    if (metrics.interval <= 0)\n`;
+            out += `        metrics.interval = 5000;\n`;
+            out += `\n`;
+            out += `    if (NULL != port)\n`;
+            out += `        metrics.listen_fd[0] = listen_tcp(NULL != address ? address : "127.0.0.1", port);\n`;
+            out += `    if (NULL != socket_path)\n`;
+            out += `        metrics.listen_fd[1] = listen_unix(socket_path);\n`;
+            out += `    if (NULL != file)\n`;
+            out += `        snprintf(metrics.file, sizeof(metrics.file), "%s", file);\n`;
+            out += `\n`;
+            out += `    if ((metrics.listen_fd[0] < 0 && metrics.listen_fd[1] < 0 && NULL == file) || 0 != pipe2(metrics.wake_fd, O_CLOEXEC))\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "metrics: not exporting\\n");\n`;
+            out += `        close_all();\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    // signals are handled by the application threads\n`;
+            out += `    sigfillset(&all);\n`;
+            out += `    pthread_sigmask(SIG_SETMASK, &all, &previous);\n`;
+            out += `    metrics.running = 0 == pthread_create(&metrics.thread, NULL, exporter, NULL);\n`;
+            out += `    pthread_sigmask(SIG_SETMASK, &previous, NULL);\n`;
+            out += `    if (!metrics.running)\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "metrics: cannot start the exporter thread, not exporting\\n");\n`;
+            out += `        close_all();\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    if (metrics.listen_fd[0] >= 0)\n`;
+            out += `        printf("metrics: serving http://%s:%s/metrics\\n", NULL != address ? address : "127.0.0.1", port);\n`;
+            out += `    if (metrics.listen_fd[1] >= 0)\n`;
+            out += `        printf("metrics: serving on %s\\n", socket_path);\n`;
+            out += `    if (NULL != file)\n`;
+            out += `        printf("metrics: writing %s every %d ms\\n", file, metrics.interval);\n`;
+            out += `    return true;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void metrics_updated(uint16_t dataset, int32_t latency, size_t size)\n`;
+            out += `{\n`;
+            out += `    metrics_dataset_t *values;\n`;
+            out += `\n`;
+            out += `    if (NULL == metrics.datasets || dataset >= metrics.count)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    values = &metrics.datasets[dataset];\n`;
+            out += `    METRICS_ADD(values->updates, 1);\n`;
+            out += `    METRICS_ADD(values->received_bytes, size);\n`;
+            out += `    observe(&values->latency, (int64_t)latency * 1000);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void metrics_published(uint16_t dataset, size_t size)\n`;
+            out += `{\n`;
+            out += `    metrics_dataset_t *values;\n`;
+            out += `\n`;
+            out += `    if (NULL == metrics.datasets || dataset >= metrics.count)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    values = &metrics.datasets[dataset];\n`;
+            out += `    METRICS_ADD(values->publishes, 1);\n`;
+            out += `    METRICS_ADD(values->published_bytes, size);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void metrics_send_buffer(uint16_t dataset, uint32_t buffer_free, uint32_t buffer_used)\n`;
+            out += `{\n`;
+            out += `    metrics_dataset_t *values;\n`;
+            out += `\n`;
+            out += `    if (NULL == metrics.datasets || dataset >= metrics.count)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    values = &metrics.datasets[dataset];\n`;
+            out += `    if (buffer_used > values->send_buffer_used_max)\n`;
+            out += `        METRICS_SET(values->send_buffer_used_max, buffer_used);\n`;
+            out += `    if (buffer_free < values->send_buffer_free_min)\n`;
+            out += `        METRICS_SET(values->send_buffer_free_min, buffer_free);\n`;
+            out += `    METRICS_ADD(values->send_buffer_events, 1);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `int64_t metrics_callback_begin(void)\n`;
+            out += `{\n`;
+            out += `    if (NULL == metrics.datasets)\n`;
+            out += `        return 0;\n`;
+            out += `    return clock_ns();\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void metrics_callback_end(uint16_t dataset, int64_t begin)\n`;
+            out += `{\n`;
+            out += `    if (NULL == metrics.datasets || dataset >= metrics.count || 0 == begin)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    observe(&metrics.datasets[dataset].callback, clock_ns() - begin);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void metrics_connection(int state)\n`;
+            out += `{\n`;
+            out += `    METRICS_SET(metrics.connection_state, state);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void metrics_sync(uint32_t missed_dmr_cycles, uint32_t missed_ar_cycles)\n`;
+            out += `{\n`;
+            out += `    METRICS_SET(metrics.missed_dmr_cycles, missed_dmr_cycles);\n`;
+            out += `    METRICS_SET(metrics.missed_ar_cycles, missed_ar_cycles);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void metrics_close(void)\n`;
+            out += `{\n`;
+            out += `    if (!metrics.running)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    // the exporter thread ends when the pipe becomes readable\n`;
+            out += `    if (1 != write(metrics.wake_fd[1], "", 1))\n`;
+            out += `    {\n`;
+            out += `        close(metrics.wake_fd[1]);\n`;
+            out += `        metrics.wake_fd[1] = -1;\n`;
+            out += `    }\n`;
+            out += `    pthread_join(metrics.thread, NULL);\n`;
+            out += `    metrics.running = false;\n`;
+            out += `\n`;
+            out += `    if ('\\0' != metrics.file[0])\n`;
+            out += `        write_file();\n`;
+            out += `    close_all();\n`;
+            out += `}\n`;
+            return out;
+        }
+        return generateMetricsSource();
+    }
+}
+
+module.exports = {TemplateLinuxMetrics};
@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const { Datamodel, GeneratedFileObj } = require('../../../datamodel');
+const { ApplicationTemplate, ApplicationTemplateDataset } = require('../template');
+
+class TemplateLinuxMirror {
+
+    /**
+     * latest value mirror header, with the writer and the read-only accessors
+     * @type {GeneratedFileObj}
+     */
+    mirrorHeader;
+
+    /**
+     * {@linkcode TemplateLinuxMirror} Generate a latest value mirror of the datasets in shared memory (`mirror` feature)
+     *
+     * The application writes every received and published dataset to its slot in a POSIX shared memory object,
+     * laid out as the datamodel structure with a sequence number (seqlock) and the nettime per dataset.
+     * Other processes (dashboards, diagnostic tools, watchdogs) map the mirror read-only and read a consistent copy
+     * of a dataset at their own rate, without system calls and without the DMR or the writing application.
+     *
+     * The header is plain C with `static inline` functions, and can be included from C++.
+     *
+     * Generates following {@link GeneratedFileObj}
+     * - {@linkcode mirrorHeader}
+     *
+     * @param {Datamodel} datamodel
+     * @param {ApplicationTemplate} template Linux template of the datamodel
+     */
+    constructor(datamodel, template) {
+        let layout = datamodel.analyzeLayout(Datamodel.LAYOUT_PLATFORMS.GPOS);
+        this.mirrorHeader = {name:`exos_${datamodel.typeName.toLowerCase()}_mirror.h`, contents:this._generateMirrorHeader(template, TemplateLinuxMirror.layoutHash(layout)), description:`${datamodel.typeName} latest value mirror`};
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @returns {string} prefix of the mirror types and functions, e.g. `exos_myapplication_mirror`
+     */
+    static mirrorPrefix(template) {
+        return `exos_${template.datamodel.structName.toLowerCase()}_mirror`;
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @returns {string} name of the define with the name of the shared memory object, e.g. `EXOS_MYAPPLICATION_MIRROR_NAME`
+     */
+    static mirrorNameDefine(template) {
+        return `${TemplateLinuxMirror.mirrorPrefix(template).toUpperCase()}_NAME`;
+    }
+
+    /**
+     * @param {LayoutAnalysis} layout
+     * @returns {number} FNV-1a hash of the names, types, sizes and offsets of the datamodel layout
+     */
+    static layoutHash(layout) {
+        let description = JSON.stringify({
+            types: layout.types.map(type => [type.dataType, type.size, type.members.map(member => [member.name, member.dataType, member.offset, member.size])]),
+            datasets: layout.datasets.map(dataset => [dataset.name, dataset.dataType, dataset.size])
+        });
+        let hash = 0x811c9dc5;
+        for (let i = 0; i < description.length; i++) {
+            hash ^= description.charCodeAt(i);
+            hash = Math.imul(hash, 0x01000193);
+        }
+        return hash >>> 0;
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @param {number} layoutHash see {@linkcode layoutHash}
+     * @returns {string} `exos_[typeName]_mirror.h`
+     */
+    _generateMirrorHeader(template, layoutHash) {
+
+        /**
+         * @param {ApplicationTemplate} template
+         * @param {number} layoutHash
+         * @returns {string}
+         */
+        function generateMirrorHeader(template, layoutHash) {
+            let prefix = TemplateLinuxMirror.mirrorPrefix(template);
+            let PREFIX = prefix.toUpperCase();
+            let datasets = template.datasets.filter(dataset => dataset.isPub || dataset.isSub);
+            let out = "";
+
+            /**
+             * @param {ApplicationTemplateDataset} dataset
+             * @returns {string} array and string dimensions of the value, e.g. `[3][81]`
+             */
+            function dimensions(dataset) {
+                // array comes before string length in c (unlike AS typ editor where it would be: STRING[80][0..1])
+                let out = dataset.arraySize > 0 ? `[${parseInt(dataset.arraySize)}]` : "";
+                if (dataset.dataType.includes("STRING")) {
+                    out += `[${parseInt(dataset.stringLength)}]`;
+                }
+                return out;
+            }
+
+            out += `#ifndef _${PREFIX}_H_\n`;
+            out += `#define _${PREFIX}_H_\n`;
+            out += `\n`;
+            out += `#include <stdbool.h>\n`;
+            out += `#include <stdint.h>\n`;
+            out += `#include <stddef.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `#include <errno.h>\n`;
+            out += `#include <fcntl.h>\n`;
+            out += `#include <signal.h>\n`;
+            out += `#include <unistd.h>\n`;
+            out += `#include <sys/mman.h>\n`;
+            out += `#include <sys/stat.h>\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `extern "C" {\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#include "${template.headerName}"\n`;
+            out += `\n`;
+            out += `/* Latest value mirror of the ${template.datamodel.structName} datasets in shared memory\n`;
+            out += `\n`;
+            out += `   The application writes every received and published dataset to its slot in the POSIX shared memory object\n`;
+            out += `   ${PREFIX}_NAME. Any other process maps the mirror read-only with ${prefix}_open(), and reads\n`;
+            out += `   a consistent copy of a dataset with ${prefix}_read_<dataset>() at its own rate, without system calls\n`;
+            out += `   and without involving the DMR or the application: the sequence number of a slot is odd while the slot is\n`;
+            out += `   written, and a read is repeated if the sequence number changed meanwhile.\n`;
+            out += `\n`;
+            out += `   The slots are laid out as the datamodel structure. ${PREFIX}_LAYOUT identifies the layout (a hash of\n`;
+            out += `   the types, sizes and offsets), so that a mirror of another version of the datamodel is not opened. */\n`;
+            out += `\n`;
+            out += `#ifndef ${PREFIX}_NAME\n`;
+            out += `#define ${PREFIX}_NAME "/exos-mirror-${template.datamodelInstanceName}"\n`;
+            out += `#endif\n`;
+            out += `#define ${PREFIX}_MAGIC 0x584d5845 /* "EXMX" */\n`;
+            out += `#define ${PREFIX}_LAYOUT 0x${layoutHash.toString(16).padStart(8, "0")}u\n`;
+            out += `#define ${PREFIX}_RETRIES 1000 /* attempts of a read while the slot is written */\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    uint32_t sequence; /* 2 * number of updates, odd while the slot is written */\n`;
+            out += `    int32_t nettime;   /* nettime of the dataset */\n`;
+            out += `} ${prefix}_stamp_t;\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    uint32_t magic;\n`;
+            out += `    uint32_t layout;\n`;
+            out += `    uint32_t size;\n`;
+            out += `    int32_t pid; /* process id of the writer, 0 after it removed the mirror */\n`;
+            out += `} ${prefix}_header_t;\n`;
+            out += `\n`;
+            out += `typedef struct ${prefix}\n`;
+            out += `{\n`;
+            out += `    ${prefix}_header_t header;\n`;
+            for (let dataset of datasets) {
+                out += `    struct\n`;
+                out += `    {\n`;
+                out += `        ${prefix}_stamp_t stamp;\n`;
+                out += `        ${Datamodel.convertPlcType(dataset.dataType)} value${dimensions(dataset)};\n`;
+                out += `    } ${dataset.structName} __attribute__((aligned(64)));\n`;
+            }
+            out += `} ${prefix}_t;\n`;
+            out += `\n`;
+
+            out += `/* create the mirror (writer), returns NULL if it cannot be created */\n`;
+            out += `static inline ${prefix}_t *${prefix}_create(const char *name)\n`;
+            out += `{\n`;
+            out += `    ${prefix}_t *mirror;\n`;
+            out += `    int fd;\n`;
+            out += `\n`;
+            out += `    // a new object, readers of a previous mirror keep their mapping until they see it removed\n`;
+            out += `    shm_unlink(name);\n`;
+            out += `    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);\n`;
+            out += `    if (fd < 0)\n`;
+            out += `        return NULL;\n`;
+            out += `    if (0 != ftruncate(fd, sizeof(${prefix}_t)))\n`;
+            out += `    {\n`;
+            out += `        close(fd);\n`;
+            out += `        shm_unlink(name);\n`;
+            out += `        return NULL;\n`;
+            out += `    }\n`;
+            out += `    mirror = (${prefix}_t *)mmap(NULL, sizeof(${prefix}_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);\n`;
+            out += `    close(fd);\n`;
+            out += `    if (MAP_FAILED == (void *)mirror)\n`;
+            out += `    {\n`;
+            out += `        shm_unlink(name);\n`;
+            out += `        return NULL;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    // touch all pages now, so that writing a dataset does not fault\n`;
+            out += `    memset((void *)mirror, 0, sizeof(${prefix}_t));\n`;
+            out += `    mirror->header.layout = ${PREFIX}_LAYOUT;\n`;
+            out += `    mirror->header.size = sizeof(${prefix}_t);\n`;
+            out += `    mirror->header.pid = getpid();\n`;
+            out += `    // readers check the magic before anything else\n`;
+            out += `    __atomic_store_n(&mirror->header.magic, ${PREFIX}_MAGIC, __ATOMIC_RELEASE);\n`;
+            out += `    return mirror;\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* write a dataset by its dataset index (writer), ignored if the mirror is NULL or the size differs */\n`;
+            out += `static inline void ${prefix}_write(${prefix}_t *mirror, uint16_t index, int32_t nettime, const void *data, size_t size)\n`;
+            out += `{\n`;
+            out += `    static const struct\n`;
+            out += `    {\n`;
+            out += `        size_t stamp;\n`;
+            out += `        size_t value;\n`;
+            out += `        size_t size;\n`;
+            out += `    } slots[] = {\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    out += `        {offsetof(${prefix}_t, ${dataset.structName}.stamp), offsetof(${prefix}_t, ${dataset.structName}.value), sizeof(((${prefix}_t *)0)->${dataset.structName}.value)},\n`;
+                }
+                else {
+                    out += `        {0, 0, 0}, // ${dataset.structName}\n`;
+                }
+            }
+            out += `    };\n`;
+            out += `    ${prefix}_stamp_t *stamp;\n`;
+            out += `    uint32_t sequence;\n`;
+            out += `\n`;
+            out += `    if (NULL == mirror || index >= sizeof(slots) / sizeof(slots[0]) || 0 == slots[index].size || size != slots[index].size)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    stamp = (${prefix}_stamp_t *)((uint8_t *)mirror + slots[index].stamp);\n`;
+            out += `    sequence = stamp->sequence;\n`;
+            out += `    __atomic_store_n(&stamp->sequence, sequence + 1, __ATOMIC_RELAXED);\n`;
+            out += `    __atomic_thread_fence(__ATOMIC_RELEASE);\n`;
+            out += `    stamp->nettime = nettime;\n`;
+            out += `    memcpy((uint8_t *)mirror + slots[index].value, data, size);\n`;
+            out += `    __atomic_store_n(&stamp->sequence, sequence + 2, __ATOMIC_RELEASE);\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* mark the mirror as removed for the readers, unmap and remove it (writer) */\n`;
+            out += `static inline void ${prefix}_destroy(${prefix}_t *mirror, const char *name)\n`;
+            out += `{\n`;
+            out += `    if (NULL == mirror)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    __atomic_store_n(&mirror->header.pid, 0, __ATOMIC_RELEASE);\n`;
+            out += `    munmap((void *)mirror, sizeof(${prefix}_t));\n`;
+            out += `    shm_unlink(name);\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* map the mirror read-only, returns NULL if it does not exist or has another layout */\n`;
+            out += `static inline const ${prefix}_t *${prefix}_open(const char *name)\n`;
+            out += `{\n`;
+            out += `    const ${prefix}_t *mirror;\n`;
+            out += `    struct stat st;\n`;
+            out += `    int fd;\n`;
+            out += `\n`;
+            out += `    fd = shm_open(name, O_RDONLY, 0);\n`;
+            out += `    if (fd < 0)\n`;
+            out += `        return NULL;\n`;
+            out += `    if (0 != fstat(fd, &st) || st.st_size != (off_t)sizeof(${prefix}_t))\n`;
+            out += `    {\n`;
+            out += `        close(fd);\n`;
+            out += `        return NULL;\n`;
+            out += `    }\n`;
+            out += `    mirror = (const ${prefix}_t *)mmap(NULL, sizeof(${prefix}_t), PROT_READ, MAP_SHARED, fd, 0);\n`;
+            out += `    close(fd);\n`;
+            out += `    if (MAP_FAILED == (const void *)mirror)\n`;
+            out += `        return NULL;\n`;
+            out += `\n`;
+            out += `    if (${PREFIX}_MAGIC != __atomic_load_n(&mirror->header.magic, __ATOMIC_ACQUIRE) || ${PREFIX}_LAYOUT != mirror->header.layout ||\n`;
+            out += `        sizeof(${prefix}_t) != mirror->header.size)\n`;
+            out += `    {\n`;
+            out += `        munmap((void *)mirror, sizeof(${prefix}_t));\n`;
+            out += `        return NULL;\n`;
+            out += `    }\n`;
+            out += `    return mirror;\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* unmap a mirror opened with ${prefix}_open() */\n`;
+            out += `static inline void ${prefix}_close(const ${prefix}_t *mirror)\n`;
+            out += `{\n`;
+            out += `    if (NULL != mirror)\n`;
+            out += `        munmap((void *)mirror, sizeof(${prefix}_t));\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* true as long as the writer has not removed the mirror and is running */\n`;
+            out += `static inline bool ${prefix}_alive(const ${prefix}_t *mirror)\n`;
+            out += `{\n`;
+            out += `    int32_t pid = __atomic_load_n(&mirror->header.pid, __ATOMIC_ACQUIRE);\n`;
+            out += `    return 0 != pid && (0 == kill(pid, 0) || EPERM == errno);\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* copy a consistent value of a slot, returns false if the slot was never written or was written during all retries (value is then undefined) */\n`;
+            out += `static inline bool ${prefix}_read_slot(const ${prefix}_stamp_t *stamp, const void *source, void *value, size_t size, int32_t *nettime)\n`;
+            out += `{\n`;
+            out += `    for (int i = 0; i < ${PREFIX}_RETRIES; i++)\n`;
+            out += `    {\n`;
+            out += `        uint32_t sequence = __atomic_load_n(&stamp->sequence, __ATOMIC_ACQUIRE);\n`;
+            out += `        int32_t slot_nettime;\n`;
+            out += `\n`;
+            out += `        if (0 == sequence)\n`;
+            out += `            return false;\n`;
+            out += `        if (sequence & 1)\n`;
+            out += `            continue;\n`;
+            out += `\n`;
+            out += `        slot_nettime = stamp->nettime;\n`;
+            out += `        memcpy(value, source, size);\n`;
+            out += `        __atomic_thread_fence(__ATOMIC_ACQUIRE);\n`;
+            out += `        if (__atomic_load_n(&stamp->sequence, __ATOMIC_RELAXED) == sequence)\n`;
+            out += `        {\n`;
+            out += `            if (NULL != nettime)\n`;
+            out += `                *nettime = slot_nettime;\n`;
+            out += `            return true;\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `    return false;\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* number of updates of a dataset since the mirror was created */\n`;
+            out += `#define ${PREFIX}_UPDATES(_mirror_, _dataset_) (__atomic_load_n(&(_mirror_)->_dataset_.stamp.sequence, __ATOMIC_ACQUIRE) / 2)\n`;
+            out += `\n`;
+
+            for (let dataset of datasets) {
+                let type = Datamodel.convertPlcType(dataset.dataType);
+                let parameter = dimensions(dataset) != "" ? `${type} value${dimensions(dataset)}` : `${type} *value`;
+                out += `static inline bool ${prefix}_read_${dataset.structName}(const ${prefix}_t *mirror, ${parameter}, int32_t *nettime)\n`;
+                out += `{\n`;
+                out += `    return ${prefix}_read_slot(&mirror->${dataset.structName}.stamp, &mirror->${dataset.structName}.value, value, sizeof(mirror->${dataset.structName}.value), nettime);\n`;
+                out += `}\n`;
+                out += `\n`;
+            }
+
+            out += `#ifdef __cplusplus\n`;
+            out += `}\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#endif // _${PREFIX}_H_\n`;
+
+            return out;
+        }
+        return generateMirrorHeader(template, layoutHash);
+    }
+}
+
+module.exports = {TemplateLinuxMirror};
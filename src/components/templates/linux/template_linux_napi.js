@@ -8,7 +8,8 @@
  */
 
 const { Datamodel, GeneratedFileObj } = require('../../../datamodel');
-const { Template, ApplicationTemplate } = require('../template')
+const { Template, ApplicationTemplate, TemplateFeature } = require('../template')
+const { TemplateLinuxTrace } = require('./template_linux_trace');
 
 class iteratorChar {
     constructor() {
@@ -91,6 +92,18 @@ class TemplateLinuxNAPI extends Template {
      */
     packageLockJson;
 
+    /**
+     * name of the process mode header, only used with the `process` feature
+     * @type {string}
+     */
+    processHeaderName;
+
+    /**
+     * processing timeline trace, only used with the `trace` feature
+     * @type {TemplateLinuxTrace}
+     */
+    trace;
+
     /**
      * Class that implements a N-API wrapper for the given exOS Datamodel, i.e. creates a native binding of exOS datasets for the nodejs platform
      * 
@@ -101,10 +114,24 @@ class TemplateLinuxNAPI extends Template {
      * - {@linkcode packageJson}
      * - {@linkcode packageLockJson}
      * 
+     * With the `process` feature, `setProcessMode()` and `processStats()` select and measure the process mode using the `Datamodel.processFile` header
+     * 
+     * Using {@linkcode TemplateLinuxTrace} (only with the `trace` feature), the native side is traced: the cyclic process, the received datasets,
+     * the onChange dispatch to JavaScript and the publish methods
+     * - `trace.traceHeader` processing timeline trace header
+     * - `trace.traceSource` processing timeline trace source code
+     * 
      * @param {Datamodel} datamodel 
+     * @param {TemplateFeature[]} [features] optional features to generate
      */
-    constructor(datamodel) {
-        super(datamodel, true, true); //create recursive template.dataset info
+    constructor(datamodel, features) {
+        super(datamodel, true, true, features); //create recursive template.dataset info
+        if (this.features.includes("process")) {
+            this.processHeaderName = this.datamodel.processFile.name;
+        }
+        if (this.features.includes("trace")) {
+            this.trace = new TemplateLinuxTrace();
+        }
         this.gypFile = {name:"binding.gyp", contents:this._generateGyp(), description:`${this.datamodel.typeName} build file`};
         this.librarySource = {name:`lib${this.datamodel.typeName.toLowerCase()}.c`, contents:this._generateLibTemplate(), description:`${this.datamodel.typeName} N-API wrapper`};
         this.JsMain = {name:`${this.datamodel.typeName.toLowerCase()}.js`, contents:this._generateJSMain(), description:`${this.datamodel.typeName} main javascript application`};
@@ -113,7 +140,7 @@ class TemplateLinuxNAPI extends Template {
     }
 
     _generateGyp() {
-        function generateGyp(typName, sourceFileName) {
+        function generateGyp(typName, sourceFileNames) {
             let out = "";
         
             out += `{\n`;
@@ -122,7 +149,7 @@ class TemplateLinuxNAPI extends Template {
             out += `      "target_name": "l_${typName}",\n`;
             out += `      "sources": [\n`;
             out += `        "lib${typName.toLowerCase()}.c",\n`;
-            out += `        "${sourceFileName}"\n`;
+            out += sourceFileNames.map(name => `        "${name}"`).join(`,\n`) + `\n`;
             out += `      ],\n`;
             out += `      "include_dirs": [\n`;
             out += `        '/usr/include'\n`;
@@ -132,14 +159,46 @@ class TemplateLinuxNAPI extends Template {
             out += `          '-lexos-api',\n`;
             out += `          '-lzmq'\n`;
             out += `        ]\n`;
-            out += `      }\n`;
+            out += `      },\n`;
+            out += `      # Build profile and profile-guided optimization, passed by build.sh in the environment\n`;
+            out += `      "variables": {\n`;
+            out += `        "exos_build_profile%": "<!(echo \${EXOS_BUILD_PROFILE:-Release})",\n`;
+            out += `        "exos_march%": "<!(echo \${EXOS_MARCH:-x86-64-v2})",\n`;
+            out += `        "exos_pgo%": "<!(echo \${EXOS_PGO:-none})",\n`;
+            out += `        "exos_pgo_dir%": "<!(pwd)/pgo"\n`;
+            out += `      },\n`;
+            out += `      "conditions": [\n`;
+            out += `        ['exos_build_profile=="Debug"', {\n`;
+            out += `          "cflags!": ["-O3"],\n`;
+            out += `          "cflags": ["-O0", "-g"]\n`;
+            out += `        }],\n`;
+            out += `        ['exos_build_profile=="Release"', {\n`;
+            out += `          "cflags": ["-flto"],\n`;
+            out += `          "ldflags": ["-flto", "-O3"]\n`;
+            out += `        }],\n`;
+            out += `        ['exos_build_profile=="RelWithDebInfo"', {\n`;
+            out += `          "cflags!": ["-O3"],\n`;
+            out += `          "cflags": ["-O2", "-g", "-march=<(exos_march)"]\n`;
+            out += `        }],\n`;
+            out += `        ['exos_pgo=="generate"', {\n`;
+            out += `          "cflags": ["-fprofile-generate=<(exos_pgo_dir)", "-fprofile-update=atomic"],\n`;
+            out += `          "ldflags": ["-fprofile-generate=<(exos_pgo_dir)"]\n`;
+            out += `        }],\n`;
+            out += `        ['exos_pgo=="use"', {\n`;
+            out += `          "cflags": ["-fprofile-use=<(exos_pgo_dir)", "-fprofile-correction", "-Wno-missing-profile"]\n`;
+            out += `        }]\n`;
+            out += `      ]\n`;
             out += `    }\n`;
             out += `  ]\n`;
             out += `}\n`;
         
             return out;
         }
-        return generateGyp(this.datamodel.typeName, this.datamodel.sourceFile.name);
+        let sourceFileNames = [this.datamodel.sourceFile.name];
+        if (this.trace !== undefined) {
+            sourceFileNames.push(this.trace.traceSource.name);
+        }
+        return generateGyp(this.datamodel.typeName, sourceFileNames);
     }
 
     _generatePackageLockJSON() {
@@ -189,8 +248,10 @@ class TemplateLinuxNAPI extends Template {
 
         /**
          * @param {ApplicationTemplate} template 
+         * @param {boolean} processModes generate the process mode methods
+         * @param {string} [traceHeaderName] document the command line arguments of the trace
          */
-        function generateJSMain(template) {
+        function generateJSMain(template, processModes, traceHeaderName) {
 
             /**
              * @param {ApplicationTemplate} template 
@@ -304,12 +365,39 @@ class TemplateLinuxNAPI extends Template {
                 out += ` * @property {${template.datamodel.structName}DatamodelLogMethod} debug\n`;
                 out += ` * @property {${template.datamodel.structName}DatamodelLogMethod} verbose\n`;
                 out += ` * \n`;
+                out += ` * @typedef {Object} ${template.datamodel.structName}SyncInfo\n`;
+                out += ` * @property {boolean} inSync datamodel is in sync with the DMR\n`;
+                out += ` * @property {number} missedDmrCycles cycles missed by the DMR\n`;
+                out += ` * @property {number} missedArCycles cycles missed by AR\n`;
+                out += ` * @property {string} processMode \`Blocking\`|\`NonBlocking\`\n`;
+                out += ` * @property {number} syncChanges number of sync state changes\n`;
+                out += ` * @property {number} syncChangedNettime nettime of the last sync state change\n`;
+                out += ` * \n`;
+                if (processModes) {
+                    out += ` * @typedef {Object} ${template.datamodel.structName}ProcessStats\n`;
+                    out += ` * @property {number} cycles number of process cycles since the mode was set\n`;
+                    out += ` * @property {number} blocked number of process cycles waiting for the DMR\n`;
+                    out += ` * @property {number} updates number of received datasets\n`;
+                    out += ` * @property {number} cpuTime CPU time (us) used by the process thread since the mode was set\n`;
+                    out += ` * @property {number} wallTime wall time (us) since the mode was set\n`;
+                    out += ` * @property {number} cpuLoad CPU use (percent) of the process thread\n`;
+                    out += ` * @property {number} latencyAvg average delivery latency (us) of received datasets\n`;
+                    out += ` * @property {number} latencyMax maximum delivery latency (us) of received datasets\n`;
+                    out += ` * \n`;
+                }
                 out += ` * @typedef {Object} ${template.datamodel.structName}\n`;
                 out += ` * @property {function():number} nettime get current nettime\n`;
                 out += ` * @property {${template.datamodel.structName}DataModelCallback} onConnectionChange event fired when \`connectionState\` changes \n`;
                 out += ` * @property {string} connectionState \`Connected\`|\`Operational\`|\`Disconnected\`|\`Aborted\` - used in the \`onConnectionChange\` event\n`;
                 out += ` * @property {boolean} isConnected\n`;
                 out += ` * @property {boolean} isOperational\n`;
+                out += ` * @property {${template.datamodel.structName}DataModelCallback} onSyncChange event fired when the sync state to the DMR changes\n`;
+                out += ` * @property {boolean} isInSync true if the datamodel is in sync with the DMR - used in the \`onSyncChange\` event\n`;
+                out += ` * @property {function():${template.datamodel.structName}SyncInfo} syncInfo get the current sync diagnostics\n`;
+                if (processModes) {
+                    out += ` * @property {function(string, number=):void} setProcessMode \`Blocking\`|\`NonBlocking\`|\`Adaptive\` and the spin window (us) for \`Adaptive\`\n`;
+                    out += ` * @property {function():${template.datamodel.structName}ProcessStats} processStats get the CPU and latency statistics of the current process mode\n`;
+                }
                 out += ` * @property {${template.datamodel.structName}DatamodelLog} log\n`;
                 out += ` * @property {${template.datamodel.structName}Datamodel} datamodel\n`;
                 out += ` * \n`;
@@ -336,9 +424,27 @@ class TemplateLinuxNAPI extends Template {
                 out += `    ${template.datamodel.varName}.onConnectionChange(() => {\n`;
                 out += `        ${template.datamodel.varName}.connectionState : (string) "Connected", "Operational", "Disconnected" or "Aborted" \n`;
                 out += `    })\n`;
+                out += `    ${template.datamodel.varName}.onSyncChange(() => {\n`;
+                out += `        ${template.datamodel.varName}.isInSync : (bool) datamodel is in sync with the DMR\n`;
+                out += `    })\n`;
                 out += `\nboolean values:\n`
                 out += `    ${template.datamodel.varName}.isConnected\n`;
                 out += `    ${template.datamodel.varName}.isOperational\n`;
+                out += `    ${template.datamodel.varName}.isInSync\n`;
+                out += `\nsync diagnostics:\n`
+                out += `    ${template.datamodel.varName}.syncInfo() : {inSync, missedDmrCycles, missedArCycles, processMode, syncChanges, syncChangedNettime}\n`;
+                if (processModes) {
+                    out += `\nprocess modes:\n`
+                    out += `    ${template.datamodel.varName}.setProcessMode("Blocking") : wait for the next DMR cycle in each cycle (default)\n`;
+                    out += `    ${template.datamodel.varName}.setProcessMode("NonBlocking") : never wait, lowest latency at full CPU load\n`;
+                    out += `    ${template.datamodel.varName}.setProcessMode("Adaptive", spinWindow) : do not wait for spinWindow (us) after a DMR cycle, then wait\n`;
+                    out += `    ${template.datamodel.varName}.processStats() : {cycles, blocked, updates, cpuTime, wallTime, cpuLoad, latencyAvg, latencyMax}\n`;
+                }
+                if (traceHeaderName !== undefined) {
+                    out += `\nprocessing timeline trace (native side, see ${traceHeaderName}):\n`
+                    out += `    node ${template.datamodel.structName.toLowerCase()}.js --trace <path> [--trace-threshold <us>] : keep a trace, dumped to <path>.<n>.json above the threshold\n`;
+                    out += `    kill -USR1 <pid> : dump the trace now, SIGUSR1 no longer starts the Node.js inspector (use --inspect instead)\n`;
+                }
                 out += `\nlogging methods:\n`
                 out += `    ${template.datamodel.varName}.log.error(string)\n`;
                 out += `    ${template.datamodel.varName}.log.warning(string)\n`;
@@ -377,6 +483,15 @@ class TemplateLinuxNAPI extends Template {
                             out += `        ${template.datamodel.varName}.datamodel.${dataset.structName}.latency : (int32_t) time in us between publish and arrival\n`;
                             out += `    })\n`;
                         }
+                        if (Template.qosHasDeadband(dataset)) {
+                            if (dataset.qos.filters.length > 0) {
+                                out += `    ${template.datamodel.varName}.datamodel.${dataset.structName}.deadband(member, deadband, relative, hysteresis) : change the deadband of a member at runtime, e.g. "${dataset.qos.filters[0].access.substring(1)}"\n`;
+                            }
+                            else {
+                                out += `    ${template.datamodel.varName}.datamodel.${dataset.structName}.deadband(deadband, relative, hysteresis) : change the deadband at runtime\n`;
+                            }
+                            out += `    ${template.datamodel.varName}.datamodel.${dataset.structName}.suppressed() : (number) updates not delivered because of a deadband\n`;
+                        }
                         out += `    ${template.datamodel.varName}.datamodel.${dataset.structName}.onConnectionChange(() => {\n`;
                         out += `        ${template.datamodel.varName}.datamodel.${dataset.structName}.connectionState : (string) "Connected", "Operational", "Disconnected" or "Aborted"\n`;
                         out += `    });\n`;
@@ -442,15 +557,36 @@ class TemplateLinuxNAPI extends Template {
             return out;
         }
 
-        return generateJSMain(this.template);
+        return generateJSMain(this.template, this.processHeaderName !== undefined, this.trace !== undefined ? this.trace.traceHeader.name : undefined);
     }
 
     _generateLibTemplate() {
 
         /**
          * @param {ApplicationTemplate} template 
+         * @param {string} [qosHeaderName] implement the quality of service using this header
+         * @param {string} [processHeaderName] implement the process modes using this header
+         * @param {string} [traceHeaderName] trace cyclic(), the received datasets, the onChange dispatch and the publish methods using this header
          */
-        function generateLibTemplate(template) {
+        function generateLibTemplate(template, qosHeaderName, processHeaderName, traceHeaderName) {
+
+            /**
+             * call the JavaScript onChange callback with a copy of the dataset
+             * @param {ApplicationTemplateDataset} dataset 
+             * @param {string} handle expression of the `exos_dataset_handle_t *`
+             */
+            function generateOnChangeCall(dataset, handle) {
+                let out = "";
+                out += `            if (${dataset.structName}.onchange_cb != NULL)\n`;
+                out += `            {\n`;
+                out += `                callback_context_t *ctx = create_callback_context(${handle});\n`;
+                out += `                \n`;
+                out += `                napi_acquire_threadsafe_function(${dataset.structName}.onchange_cb);\n`;
+                out += `                napi_call_threadsafe_function(${dataset.structName}.onchange_cb, ctx, napi_tsfn_blocking);\n`;
+                out += `                napi_release_threadsafe_function(${dataset.structName}.onchange_cb, napi_tsfn_release);\n`;
+                out += `            }\n`;
+                return out;
+            }
 
             /**
              * @param {ApplicationTemplate} template 
@@ -462,6 +598,12 @@ class TemplateLinuxNAPI extends Template {
                 out += `    switch (event_type)\n    {\n`;
                 out += `    case EXOS_DATASET_EVENT_UPDATED:\n`;
                 out += `        VERBOSE("dataset %s updated! latency (us):%i", dataset->name, (exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime));\n`;
+                if (processHeaderName !== undefined) {
+                    out += `        exos_process_latency(&${template.datamodel.varName}_process, exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime);\n`;
+                }
+                if (traceHeaderName !== undefined) {
+                    out += `        trace_received(dataset->name, exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime);\n`;
+                }
                 var atleastone = false;
                 for (let dataset of template.datasets) {
                     if (dataset.isSub) {
@@ -474,14 +616,27 @@ class TemplateLinuxNAPI extends Template {
                         }
                         out += `if(0 == strcmp(dataset->name,"${dataset.structName}"))\n`;
                         out += `        {\n`;
-                        out += `            if (${dataset.structName}.onchange_cb != NULL)\n`;
-                        out += `            {\n`;
-                        out += `                callback_context_t *ctx = create_callback_context(dataset);\n`;
-                        out += `                \n`;
-                        out += `                napi_acquire_threadsafe_function(${dataset.structName}.onchange_cb);\n`;
-                        out += `                napi_call_threadsafe_function(${dataset.structName}.onchange_cb, ctx, napi_tsfn_blocking);\n`;
-                        out += `                napi_release_threadsafe_function(${dataset.structName}.onchange_cb, napi_tsfn_release);\n`;
-                        out += `            }\n`;
+                        if (dataset.qos !== undefined && dataset.qos.deadband > 0) {
+                            out += `            //quality of service: skip updates within the deadband\n`;
+                            out += `            if (!exos_qos_deadband(&${dataset.structName}_qos, (double)exos_data.${dataset.structName}))\n`;
+                            out += `            {\n`;
+                            out += `                break;\n`;
+                            out += `            }\n`;
+                        }
+                        if (dataset.qos !== undefined && dataset.qos.filters.length > 0) {
+                            out += `            //quality of service: skip updates where only members within their deadband changed\n`;
+                            out += `            if (!${Template.qosDeadbandPrefix(template, dataset)}_filter(&${dataset.structName}_deadband, &${dataset.structName}_qos, &exos_data.${dataset.structName}))\n`;
+                            out += `            {\n`;
+                            out += `                break;\n`;
+                            out += `            }\n`;
+                        }
+                        if (dataset.qos !== undefined && dataset.qos.latest) {
+                            out += `            //quality of service: the latest value is delivered in cyclic()\n`;
+                            out += `            ${dataset.structName}_qos.changed = true;\n`;
+                        }
+                        else {
+                            out += generateOnChangeCall(dataset, "dataset");
+                        }
                         out += `        }\n`;
                     }
                 }
@@ -572,6 +727,15 @@ class TemplateLinuxNAPI extends Template {
                 out += `        }\n`;
                 out += `        break;\n`;
                 out += `    case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:\n`;
+                out += `        INFO("application ${template.datamodel.structName} sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);\n`;
+                out += `        ${template.datamodel.varName}_sync_changes++;\n`;
+                out += `        ${template.datamodel.varName}_sync_changed_nettime = exos_datamodel_get_nettime(datamodel);\n\n`;
+                out += `        if (${template.datamodel.varName}.syncchange_cb != NULL)\n`;
+                out += `        {\n`;
+                out += `            napi_acquire_threadsafe_function(${template.datamodel.varName}.syncchange_cb);\n`;
+                out += `            napi_call_threadsafe_function(${template.datamodel.varName}.syncchange_cb, NULL, napi_tsfn_blocking);\n`;
+                out += `            napi_release_threadsafe_function(${template.datamodel.varName}.syncchange_cb, napi_tsfn_release);\n`;
+                out += `        }\n`;
                 out += `        break;\n\n`;
                 out += `    default:\n`;
                 out += `        break;\n\n`;
@@ -703,6 +867,23 @@ class TemplateLinuxNAPI extends Template {
                 out += `        throw_fatal_exception_callbacks(env, "EINVAL", "Can't call onConnectionChange callback - ${template.datamodel.varName}");\n`;
                 out += `}\n\n`;
             
+                out += `static void ${template.datamodel.varName}_syncchange_js_cb(napi_env env, napi_value js_cb, void *context, void *data)\n`;
+                out += `{\n`;
+                out += `    napi_value in_sync, undefined;\n\n`;
+            
+                out += `    napi_get_undefined(env, &undefined);\n`;
+                out += `    napi_get_boolean(env, ${template.datamodel.varName}_datamodel.sync_info.in_sync, &in_sync);\n\n`;
+            
+                out += `    if (napi_ok != napi_get_reference_value(env, ${template.datamodel.varName}.ref, &${template.datamodel.varName}.object_value))\n`;
+                out += `        napi_throw_error(env, "EINVAL", "Can't get reference - ${template.datamodel.varName} ");\n\n`;
+            
+                out += `    if (napi_ok != napi_set_named_property(env, ${template.datamodel.varName}.object_value, "isInSync", in_sync))\n`;
+                out += `        napi_throw_error(env, "EINVAL", "Can't set isInSync property - ${template.datamodel.varName}");\n\n`;
+            
+                out += `    if (napi_ok != napi_call_function(env, undefined, js_cb, 0, NULL, NULL))\n`;
+                out += `        throw_fatal_exception_callbacks(env, "EINVAL", "Can't call onSyncChange callback - ${template.datamodel.varName}");\n`;
+                out += `}\n\n`;
+            
                 out += `static void ${template.datamodel.varName}_onprocessed_js_cb(napi_env env, napi_value js_cb, void *context, void *data)\n`;
                 out += `{\n`;
                 out += `    napi_value undefined;\n\n`;
@@ -905,7 +1086,10 @@ class TemplateLinuxNAPI extends Template {
                         //the ctx_value is where the generateValuesSubscribeItem should start, and as we dont actually have a datatype
                         //we need to cast the ctx->pData according to its type (eg. arrays should be kept as pointers, scalars dereferenced..)
                         let ctx_value = "";
-                        if (dataset.arraySize > 0 || dataset.dataType == "STRING") {
+                        if (dataset.arraySize > 0 && dataset.dataType == "STRING") {
+                            ctx_value = `((char (*)[${parseInt(dataset.stringLength)}])ctx->pData)`;
+                        }
+                        else if (dataset.arraySize > 0 || dataset.dataType == "STRING") {
                             ctx_value = `((${Datamodel.convertPlcType(dataset.dataType)} *)ctx->pData)`;
                         }
                         else {
@@ -937,6 +1121,10 @@ class TemplateLinuxNAPI extends Template {
                         if (out2.includes(", &__value")) { out += `    double __value;\n` }
 
                         out += `    napi_value undefined, netTime, latency;\n`;
+                        if (traceHeaderName !== undefined) {
+                            out += `\n    //the span covers the conversion to JavaScript and the onChange callback\n`;
+                            out += `    trace_begin("${dataset.structName}", "callback", 0);\n`;
+                        }
                         out += `    napi_get_undefined(env, &undefined);\n\n`;
                         out += `    if (napi_ok != napi_get_reference_value(env, ${dataset.structName}.ref, &${dataset.structName}.object_value))\n`;
                         out += `    {\n`;
@@ -956,6 +1144,9 @@ class TemplateLinuxNAPI extends Template {
                         out += `    }\n\n`;
                         out += `    if (napi_ok != napi_call_function(env, undefined, js_cb, 0, NULL, NULL))\n`;
                         out += `        throw_fatal_exception_callbacks(env, "EINVAL", "Can't call onChange callback");\n\n`;
+                        if (traceHeaderName !== undefined) {
+                            out += `    trace_end("${dataset.structName}", "callback", 0);\n`;
+                        }
                         out += `    \n`;
                         out += `    free(ctx);\n`;
                         out += `}\n\n`;
@@ -976,6 +1167,10 @@ class TemplateLinuxNAPI extends Template {
                 out += `{\n`;
                 out += `    return init_napi_onchange(env, info, "${template.datamodel.structName} connection change", ${template.datamodel.varName}_connonchange_js_cb, &${template.datamodel.varName}.connectiononchange_cb);\n`;
                 out += `}\n\n`;
+                out += `static napi_value ${template.datamodel.varName}_syncchange_init(napi_env env, napi_callback_info info)\n`;
+                out += `{\n`;
+                out += `    return init_napi_onchange(env, info, "${template.datamodel.structName} sync change", ${template.datamodel.varName}_syncchange_js_cb, &${template.datamodel.varName}.syncchange_cb);\n`;
+                out += `}\n\n`;
                 out += `static napi_value ${template.datamodel.varName}_onprocessed_init(napi_env env, napi_callback_info info)\n`;
                 out += `{\n`;
                 out += `    return init_napi_onchange(env, info, "${template.datamodel.structName} onProcessed", ${template.datamodel.varName}_onprocessed_js_cb, &${template.datamodel.varName}.onprocessed_cb);\n`;
@@ -1158,7 +1353,12 @@ class TemplateLinuxNAPI extends Template {
                         objectIdx.reset();
                         out2 = generateValuesPublishItem(true, `${dataset.structName}.value`, `exos_data.${dataset.structName}`, dataset);
 
-                        out += `static napi_value ${dataset.structName}_publish_method(napi_env env, napi_callback_info info)\n`;
+                        if (traceHeaderName !== undefined) {
+                            out += `static napi_value ${dataset.structName}_publish_value(napi_env env, napi_callback_info info)\n`;
+                        }
+                        else {
+                            out += `static napi_value ${dataset.structName}_publish_method(napi_env env, napi_callback_info info)\n`;
+                        }
                         out += `{\n`;
                         // check what variables to declare for the publish process in "out2" variable.
                         if (out2.includes("&object")) {
@@ -1192,10 +1392,106 @@ class TemplateLinuxNAPI extends Template {
 
                         out += out2;
 
-                        out += `    exos_dataset_publish(&${dataset.structName}_dataset);\n`;
+                        if (dataset.qos !== undefined && dataset.qos.rate > 0) {
+                            out += `    //quality of service: publishes within the rate are deferred to cyclic()\n`;
+                            out += `    if (exos_qos_publish(&${dataset.structName}_qos, exos_datamodel_get_nettime(&${template.datamodel.varName}_datamodel)))\n`;
+                            out += `    {\n`;
+                            out += `        exos_dataset_publish(&${dataset.structName}_dataset);\n`;
+                            out += `    }\n`;
+                        }
+                        else {
+                            out += `    exos_dataset_publish(&${dataset.structName}_dataset);\n`;
+                        }
                         out += `    return NULL;\n`;
                         out += `}\n\n`;
+                        if (traceHeaderName !== undefined) {
+                            out += `//the span covers the conversion from JavaScript and the publish (or its deferral)\n`;
+                            out += `static napi_value ${dataset.structName}_publish_method(napi_env env, napi_callback_info info)\n`;
+                            out += `{\n`;
+                            out += `    napi_value result;\n\n`;
+                            out += `    trace_begin("${dataset.structName}", "publish", 0);\n`;
+                            out += `    result = ${dataset.structName}_publish_value(env, info);\n`;
+                            out += `    trace_end("${dataset.structName}", "publish", 0);\n`;
+                            out += `    return result;\n`;
+                            out += `}\n\n`;
+                        }
+                    }
+                }
+
+                return out;
+            }
+
+            /**
+             * runtime access to the deadbands of the datasets: `deadband([member,] deadband[, relative[, hysteresis]])` and `suppressed()`
+             * @param {ApplicationTemplate} template 
+             */
+            function generateQosMethods(template) {
+                let out = "";
+
+                for (let dataset of template.datasets.filter(Template.qosHasDeadband)) {
+                    let members = dataset.qos.filters.length > 0;
+                    let arg = members ? 1 : 0;
+
+                    out += `// quality of service: ${dataset.structName}.deadband(${members ? "member, " : ""}deadband[, relative[, hysteresis]])\n`;
+                    out += `static napi_value ${dataset.structName}_deadband_method(napi_env env, napi_callback_info info)\n`;
+                    out += `{\n`;
+                    out += `    napi_value argv[${arg + 3}];\n`;
+                    out += `    size_t argc = ${arg + 3};\n`;
+                    if (members) {
+                        out += `    char member[81] = {};\n`;
+                    }
+                    out += `    exos_qos_filter_t *filter = NULL;\n`;
+                    out += `    double deadband = 0;\n`;
+                    out += `    double hysteresis = 0;\n`;
+                    out += `    bool relative = false;\n\n`;
+                    out += `    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);\n`;
+                    if (members) {
+                        out += `    if (argc < 1 || napi_ok != napi_get_value_string_utf8(env, argv[0], member, sizeof(member), NULL))\n`;
+                        out += `    {\n`;
+                        out += `        napi_throw_error(env, "EINVAL", "Expected the member name as string");\n`;
+                        out += `        return NULL;\n`;
+                        out += `    }\n`;
+                        dataset.qos.filters.forEach((filter, i) => {
+                            out += `    ${i > 0 ? "else " : ""}if (0 == strcmp(member, "${filter.access.substring(1)}"))\n`;
+                            out += `    {\n`;
+                            out += `        filter = &${dataset.structName}_deadband.${filter.name};\n`;
+                            out += `    }\n`;
+                        });
+                        out += `    if (NULL == filter)\n`;
+                        out += `    {\n`;
+                        out += `        napi_throw_error(env, "EINVAL", "Member has no deadband");\n`;
+                        out += `        return NULL;\n`;
+                        out += `    }\n`;
+                    }
+                    else {
+                        out += `    filter = &${dataset.structName}_qos.filter;\n`;
                     }
+                    out += `    if (argc < ${arg + 1} || napi_ok != napi_get_value_double(env, argv[${arg}], &deadband))\n`;
+                    out += `    {\n`;
+                    out += `        napi_throw_error(env, "EINVAL", "Expected the deadband as number");\n`;
+                    out += `        return NULL;\n`;
+                    out += `    }\n`;
+                    out += `    if (argc > ${arg + 1})\n`;
+                    out += `    {\n`;
+                    out += `        napi_get_value_bool(env, argv[${arg + 1}], &relative);\n`;
+                    out += `    }\n`;
+                    out += `    if (argc > ${arg + 2})\n`;
+                    out += `    {\n`;
+                    out += `        napi_get_value_double(env, argv[${arg + 2}], &hysteresis);\n`;
+                    out += `    }\n\n`;
+                    out += `    filter->deadband = deadband;\n`;
+                    out += `    filter->relative = relative;\n`;
+                    out += `    filter->hysteresis = hysteresis;\n`;
+                    out += `    return NULL;\n`;
+                    out += `}\n\n`;
+
+                    out += `// quality of service: ${dataset.structName}.suppressed() number of updates not delivered because of a deadband\n`;
+                    out += `static napi_value ${dataset.structName}_suppressed_method(napi_env env, napi_callback_info info)\n`;
+                    out += `{\n`;
+                    out += `    napi_value suppressed;\n\n`;
+                    out += `    napi_create_uint32(env, ${dataset.structName}_qos.suppressed, &suppressed);\n`;
+                    out += `    return suppressed;\n`;
+                    out += `}\n\n`;
                 }
 
                 return out;
@@ -1344,16 +1640,145 @@ class TemplateLinuxNAPI extends Template {
                 out += `    }\n`;
                 out += `}\n\n`;
             
+                let qosDatasets = Template.qosDatasets(template.datasets);
+                let flush = qosDatasets.filter(dataset => dataset.qos.rate > 0);
+                let dispatch = qosDatasets.filter(dataset => dataset.qos.latest);
+
                 out += `static void cyclic(uv_idle_t * handle) \n`;
                 out += `{\n`;
                 out += `    int dummy = 0;\n`;
+                if (flush.length > 0 || traceHeaderName !== undefined) {
+                    out += `    int32_t nettime = exos_datamodel_get_nettime(&${template.datamodel.varName}_datamodel);\n\n`;
+                }
+                if (traceHeaderName !== undefined) {
+                    out += `    trace_process_begin(nettime);\n\n`;
+                }
+                if (flush.length > 0) {
+                    out += `    //quality of service: deferred publishes, in order of priority\n`;
+                    for (let dataset of flush) {
+                        out += `    if (exos_qos_flush(&${dataset.structName}_qos, nettime))\n`;
+                        out += `    {\n`;
+                        out += `        exos_dataset_publish(&${dataset.structName}_dataset);\n`;
+                        if (traceHeaderName !== undefined) {
+                            out += `        trace_instant("${dataset.structName}", "publish", nettime);\n`;
+                        }
+                        out += `    }\n`;
+                    }
+                    out += `\n`;
+                }
+                if (processHeaderName !== undefined) {
+                    out += `    exos_process_begin(&${template.datamodel.varName}_process, &${template.datamodel.varName}_datamodel);\n`;
+                }
                 out += `    exos_datamodel_process(&${template.datamodel.varName}_datamodel);\n`;
+                if (processHeaderName !== undefined) {
+                    out += `    exos_process_end(&${template.datamodel.varName}_process);\n`;
+                }
+                if (dispatch.length > 0) {
+                    out += `\n`;
+                    out += `    //quality of service: conflated updates, in order of priority\n`;
+                    for (let dataset of dispatch) {
+                        out += `    if (exos_qos_dispatch(&${dataset.structName}_qos))\n`;
+                        out += `    {\n`;
+                        out += generateOnChangeCall(dataset, `&${dataset.structName}_dataset`).replace(/^ {8}/gm, "    ");
+                        out += `    }\n`;
+                    }
+                    out += `\n`;
+                }
                 out += `    napi_acquire_threadsafe_function(${template.datamodel.varName}.onprocessed_cb);\n`;
                 out += `    napi_call_threadsafe_function(${template.datamodel.varName}.onprocessed_cb, &dummy, napi_tsfn_blocking);\n`;
                 out += `    napi_release_threadsafe_function(${template.datamodel.varName}.onprocessed_cb, napi_tsfn_release);\n`;
                 out += `    exos_log_process(&logger);\n`;
+                if (traceHeaderName !== undefined) {
+                    out += `\n    trace_process_end(exos_datamodel_get_nettime(&${template.datamodel.varName}_datamodel));\n`;
+                }
                 out += `}\n\n`;
             
+                out += `//read sync diagnostics for DataModel\n`;
+                out += `static napi_value get_sync_info(napi_env env, napi_callback_info info)\n`;
+                out += `{\n`;
+                out += `    napi_value syncInfo, value;\n\n`;
+                out += `    if (napi_ok != napi_create_object(env, &syncInfo))\n`;
+                out += `        return NULL;\n\n`;
+                out += `    napi_get_boolean(env, ${template.datamodel.varName}_datamodel.sync_info.in_sync, &value);\n`;
+                out += `    napi_set_named_property(env, syncInfo, "inSync", value);\n`;
+                out += `    napi_create_uint32(env, ${template.datamodel.varName}_datamodel.sync_info.missed_dmr_cycles, &value);\n`;
+                out += `    napi_set_named_property(env, syncInfo, "missedDmrCycles", value);\n`;
+                out += `    napi_create_uint32(env, ${template.datamodel.varName}_datamodel.sync_info.missed_ar_cycles, &value);\n`;
+                out += `    napi_set_named_property(env, syncInfo, "missedArCycles", value);\n`;
+                out += `    napi_create_string_utf8(env, ${template.datamodel.varName}_datamodel.sync_info.process_mode == EXOS_DATAMODEL_PROCESS_NON_BLOCKING ? "NonBlocking" : "Blocking", NAPI_AUTO_LENGTH, &value);\n`;
+                out += `    napi_set_named_property(env, syncInfo, "processMode", value);\n`;
+                out += `    napi_create_uint32(env, ${template.datamodel.varName}_sync_changes, &value);\n`;
+                out += `    napi_set_named_property(env, syncInfo, "syncChanges", value);\n`;
+                out += `    napi_create_int32(env, ${template.datamodel.varName}_sync_changed_nettime, &value);\n`;
+                out += `    napi_set_named_property(env, syncInfo, "syncChangedNettime", value);\n\n`;
+                out += `    return syncInfo;\n`;
+                out += `}\n\n`;
+
+                if (processHeaderName !== undefined) {
+                    out += `//select the process mode for DataModel: setProcessMode(mode[, spinWindow])\n`;
+                    out += `static napi_value set_process_mode(napi_env env, napi_callback_info info)\n`;
+                    out += `{\n`;
+                    out += `    napi_value argv[2];\n`;
+                    out += `    size_t argc = 2;\n`;
+                    out += `    char mode[16] = {};\n`;
+                    out += `    uint32_t spin_window = 0;\n\n`;
+                    out += `    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);\n`;
+                    out += `    if (argc < 1 || napi_ok != napi_get_value_string_utf8(env, argv[0], mode, sizeof(mode), NULL))\n`;
+                    out += `    {\n`;
+                    out += `        napi_throw_error(env, "EINVAL", "Expected the process mode as string");\n`;
+                    out += `        return NULL;\n`;
+                    out += `    }\n`;
+                    out += `    if (argc > 1 && napi_ok != napi_get_value_uint32(env, argv[1], &spin_window))\n`;
+                    out += `    {\n`;
+                    out += `        napi_throw_error(env, "EINVAL", "Expected the spin window (us) as number");\n`;
+                    out += `        return NULL;\n`;
+                    out += `    }\n\n`;
+                    out += `    if (0 == strcmp(mode, "Blocking"))\n`;
+                    out += `    {\n`;
+                    out += `        exos_process_set_mode(&${template.datamodel.varName}_process, EXOS_PROCESS_BLOCKING, 0);\n`;
+                    out += `    }\n`;
+                    out += `    else if (0 == strcmp(mode, "NonBlocking"))\n`;
+                    out += `    {\n`;
+                    out += `        exos_process_set_mode(&${template.datamodel.varName}_process, EXOS_PROCESS_NON_BLOCKING, 0);\n`;
+                    out += `    }\n`;
+                    out += `    else if (0 == strcmp(mode, "Adaptive"))\n`;
+                    out += `    {\n`;
+                    out += `        exos_process_set_mode(&${template.datamodel.varName}_process, EXOS_PROCESS_ADAPTIVE, spin_window);\n`;
+                    out += `    }\n`;
+                    out += `    else\n`;
+                    out += `    {\n`;
+                    out += `        napi_throw_error(env, "EINVAL", "Expected \\"Blocking\\", \\"NonBlocking\\" or \\"Adaptive\\"");\n`;
+                    out += `    }\n`;
+                    out += `    return NULL;\n`;
+                    out += `}\n\n`;
+
+                    out += `//read the process statistics for DataModel\n`;
+                    out += `static napi_value get_process_stats(napi_env env, napi_callback_info info)\n`;
+                    out += `{\n`;
+                    out += `    exos_process_stats_t *stats = &${template.datamodel.varName}_process.stats;\n`;
+                    out += `    napi_value processStats, value;\n\n`;
+                    out += `    if (napi_ok != napi_create_object(env, &processStats))\n`;
+                    out += `        return NULL;\n\n`;
+                    out += `    napi_create_uint32(env, stats->cycles, &value);\n`;
+                    out += `    napi_set_named_property(env, processStats, "cycles", value);\n`;
+                    out += `    napi_create_uint32(env, stats->blocked, &value);\n`;
+                    out += `    napi_set_named_property(env, processStats, "blocked", value);\n`;
+                    out += `    napi_create_uint32(env, stats->updates, &value);\n`;
+                    out += `    napi_set_named_property(env, processStats, "updates", value);\n`;
+                    out += `    napi_create_double(env, (double)stats->cpu_time, &value);\n`;
+                    out += `    napi_set_named_property(env, processStats, "cpuTime", value);\n`;
+                    out += `    napi_create_double(env, (double)stats->wall_time, &value);\n`;
+                    out += `    napi_set_named_property(env, processStats, "wallTime", value);\n`;
+                    out += `    napi_create_double(env, stats->cpu_load, &value);\n`;
+                    out += `    napi_set_named_property(env, processStats, "cpuLoad", value);\n`;
+                    out += `    napi_create_double(env, stats->latency_avg, &value);\n`;
+                    out += `    napi_set_named_property(env, processStats, "latencyAvg", value);\n`;
+                    out += `    napi_create_int32(env, stats->latency_max, &value);\n`;
+                    out += `    napi_set_named_property(env, processStats, "latencyMax", value);\n\n`;
+                    out += `    return processStats;\n`;
+                    out += `}\n\n`;
+                }
+            
                 out += `//read nettime for DataModel\n`;
                 out += `static napi_value get_net_time(napi_env env, napi_callback_info info)\n`;
                 out += `{\n`;
@@ -1497,6 +1922,12 @@ class TemplateLinuxNAPI extends Template {
                         out2 += `    napi_set_named_property(env, ${dataset.structName}.value, "nettime", undefined);\n`;
                         out2 += `    napi_set_named_property(env, ${dataset.structName}.value, "latency", undefined);\n`;
                     }
+                    if (Template.qosHasDeadband(dataset)) {
+                        out2 += `    napi_create_function(env, NULL, 0, ${dataset.structName}_deadband_method, NULL, &${dataset.structName}_set_deadband);\n`;
+                        out2 += `    napi_set_named_property(env, ${dataset.structName}.value, "deadband", ${dataset.structName}_set_deadband);\n`;
+                        out2 += `    napi_create_function(env, NULL, 0, ${dataset.structName}_suppressed_method, NULL, &${dataset.structName}_get_suppressed);\n`;
+                        out2 += `    napi_set_named_property(env, ${dataset.structName}.value, "suppressed", ${dataset.structName}_get_suppressed);\n`;
+                    }
                     if (dataset.isPub) {
                         out3 += `    napi_create_function(env, NULL, 0, ${dataset.structName}_publish_method, NULL, &${dataset.structName}_publish);\n`;
                         out3 += `    napi_set_named_property(env, ${dataset.structName}.value, "publish", ${dataset.structName}_publish);\n`;
@@ -1516,13 +1947,51 @@ class TemplateLinuxNAPI extends Template {
                     }
                 }
             
+                if (traceHeaderName !== undefined) {
+                    out += `//trace_setup() with the command line of node, i.e. process.argv\n`;
+                    out += `static void trace_setup_process_argv(napi_env env)\n`;
+                    out += `{\n`;
+                    out += `    napi_value global, process, argv, arg;\n`;
+                    out += `    uint32_t argc = 0;\n`;
+                    out += `    char **args;\n\n`;
+                    out += `    if (napi_ok != napi_get_global(env, &global) ||\n`;
+                    out += `        napi_ok != napi_get_named_property(env, global, "process", &process) ||\n`;
+                    out += `        napi_ok != napi_get_named_property(env, process, "argv", &argv) ||\n`;
+                    out += `        napi_ok != napi_get_array_length(env, argv, &argc))\n`;
+                    out += `    {\n`;
+                    out += `        return;\n`;
+                    out += `    }\n\n`;
+                    out += `    args = calloc(argc + 1, sizeof(char *));\n`;
+                    out += `    for (uint32_t i = 0; i < argc; i++)\n`;
+                    out += `    {\n`;
+                    out += `        size_t length = 0;\n`;
+                    out += `        if (napi_ok != napi_get_element(env, argv, i, &arg) || napi_ok != napi_get_value_string_utf8(env, arg, NULL, 0, &length))\n`;
+                    out += `        {\n`;
+                    out += `            length = 0;\n`;
+                    out += `        }\n`;
+                    out += `        args[i] = calloc(length + 1, 1);\n`;
+                    out += `        if (length > 0)\n`;
+                    out += `        {\n`;
+                    out += `            napi_get_value_string_utf8(env, arg, args[i], length + 1, NULL);\n`;
+                    out += `        }\n`;
+                    out += `    }\n\n`;
+                    out += `    //the path is copied, the arguments are not kept\n`;
+                    out += `    trace_setup((int)argc, args);\n\n`;
+                    out += `    for (uint32_t i = 0; i < argc; i++)\n`;
+                    out += `    {\n`;
+                    out += `        free(args[i]);\n`;
+                    out += `    }\n`;
+                    out += `    free(args);\n`;
+                    out += `}\n\n`;
+                }
+
                 //prototype    
                 out += `// init of module, called at "require"\n`;
                 out += `static napi_value init_${template.datamodel.varName}(napi_env env, napi_value exports)\n{\n`;
             
                 // declarations
                 out += `    napi_value `;
-                out += `${template.datamodel.varName}_conn_change, ${template.datamodel.varName}_onprocessed,`;
+                out += `${template.datamodel.varName}_conn_change, ${template.datamodel.varName}_sync_change, ${template.datamodel.varName}_onprocessed,`;
                 let atleastone = false;
                 for (let i = 0; i < template.datasets.length; i++) {
                     if (template.datasets[i].isSub || template.datasets[i].isPub) {
@@ -1569,6 +2038,10 @@ class TemplateLinuxNAPI extends Template {
                     out += `;\n`;
                     atleastone = false;
                 }
+
+                for (let dataset of template.datasets.filter(Template.qosHasDeadband)) {
+                    out += `    napi_value ${dataset.structName}_set_deadband, ${dataset.structName}_get_suppressed;\n`;
+                }
             
                 for (let i = 0; i < template.datasets.length; i++) {
                     if (template.datasets[i].isPub || template.datasets[i].isSub) {
@@ -1588,7 +2061,10 @@ class TemplateLinuxNAPI extends Template {
                 }
             
                 // base variables needed
-                out += `\n    napi_value dataModel, getNetTime, undefined, def_bool, def_number, def_string;\n`;
+                out += `\n    napi_value dataModel, getNetTime, getSyncInfo, undefined, def_bool, def_number, def_string;\n`;
+                if (processHeaderName !== undefined) {
+                    out += `    napi_value setProcessMode, getProcessStats;\n`;
+                }
                 out += `    napi_value log, logError, logWarning, logSuccess, logInfo, logDebug, logVerbose;\n`;
             
                 if (out_structs.includes("&object")) {
@@ -1651,6 +2127,17 @@ class TemplateLinuxNAPI extends Template {
                 out += `    napi_set_named_property(env, ${template.datamodel.varName}.value, "connectionState", def_string);\n`;
                 out += `    napi_set_named_property(env, ${template.datamodel.varName}.value, "isConnected", def_bool);\n`;
                 out += `    napi_set_named_property(env, ${template.datamodel.varName}.value, "isOperational", def_bool);\n`;
+                out += `    napi_create_function(env, NULL, 0, ${template.datamodel.varName}_syncchange_init, NULL, &${template.datamodel.varName}_sync_change); \n`;
+                out += `    napi_set_named_property(env, ${template.datamodel.varName}.value, "onSyncChange", ${template.datamodel.varName}_sync_change); \n`;
+                out += `    napi_set_named_property(env, ${template.datamodel.varName}.value, "isInSync", def_bool);\n`;
+                out += `    napi_create_function(env, NULL, 0, get_sync_info, NULL, &getSyncInfo);\n`;
+                out += `    napi_set_named_property(env, ${template.datamodel.varName}.value, "syncInfo", getSyncInfo);\n`;
+                if (processHeaderName !== undefined) {
+                    out += `    napi_create_function(env, NULL, 0, set_process_mode, NULL, &setProcessMode);\n`;
+                    out += `    napi_set_named_property(env, ${template.datamodel.varName}.value, "setProcessMode", setProcessMode);\n`;
+                    out += `    napi_create_function(env, NULL, 0, get_process_stats, NULL, &getProcessStats);\n`;
+                    out += `    napi_set_named_property(env, ${template.datamodel.varName}.value, "processStats", getProcessStats);\n`;
+                }
                 out += `    napi_create_function(env, NULL, 0, ${template.datamodel.varName}_onprocessed_init, NULL, &${template.datamodel.varName}_onprocessed); \n`;
                 out += `    napi_set_named_property(env, ${template.datamodel.varName}.value, "onProcessed", ${template.datamodel.varName}_onprocessed); \n`;
                 out += `    napi_create_function(env, NULL, 0, get_net_time, NULL, &getNetTime);\n`;
@@ -1709,7 +2196,24 @@ class TemplateLinuxNAPI extends Template {
                         out += `    ${template.datasets[i].structName}_dataset.user_tag = 0; \n\n`;
                     }
                 }
+
+                let qosDatasets = Template.qosDatasets(template.datasets);
+                if (qosDatasets.length > 0) {
+                    out += `    // quality of service from the .typ annotations: rate (us), latest, deadband, relative, hysteresis\n`;
+                    for (let dataset of qosDatasets) {
+                        out += `    exos_qos_init(&${dataset.structName}_qos, ${dataset.qos.rate}, ${dataset.qos.latest}, ${dataset.qos.deadband}, ${dataset.qos.relative}, ${dataset.qos.hysteresis});\n`;
+                        if (dataset.qos.filters.length > 0) {
+                            out += `    ${Template.qosDeadbandPrefix(template, dataset)}_init(&${dataset.structName}_deadband);\n`;
+                        }
+                    }
+                    out += `\n`;
+                }
             
+                if (traceHeaderName !== undefined) {
+                    out += `    //trace the processing timeline if started with --trace <path>, dumped on SIGUSR1 or above --trace-threshold <us> (see ${traceHeaderName})\n`;
+                    out += `    trace_setup_process_argv(env);\n\n`;
+                }
+
                 // register the datamodel & logger
                 out += `    if (EXOS_ERROR_OK != exos_log_init(&logger, "${template.datamodel.structName}_0"))\n`;
                 out += `    {\n`;
@@ -1717,7 +2221,7 @@ class TemplateLinuxNAPI extends Template {
                 out += `    } \n\n`;
                 out += `    INFO("${template.datamodel.structName} starting!")\n`;
                 out += `    // exOS register datamodel\n`;
-                out += `    if (EXOS_ERROR_OK != exos_datamodel_connect_${template.datamodel.varName}(&${template.datamodel.varName}_datamodel, datamodelEvent)) \n`;
+                out += `    if (EXOS_ERROR_OK != exos_datamodel_connect_${template.datamodel.structName.toLowerCase()}(&${template.datamodel.varName}_datamodel, datamodelEvent)) \n`;
                 out += `    {\n`;
                 out += `        napi_throw_error(env, "EINVAL", "Can't connect ${template.datamodel.structName}"); \n`;
                 out += `    } \n\n`;
@@ -1783,7 +2287,16 @@ class TemplateLinuxNAPI extends Template {
             out += `#include <stdint.h>\n`;
             out += `#include <exos_api.h>\n`;
             out += `#include <exos_log.h>\n`;
-            out += `#include "exos_${template.datamodel.varName}.h"\n`;
+            out += `#include "${template.headerName}"\n`;
+            if (qosHeaderName !== undefined) {
+                out += `#include "${qosHeaderName}"\n`;
+            }
+            if (processHeaderName !== undefined) {
+                out += `#include "${processHeaderName}"\n`;
+            }
+            if (traceHeaderName !== undefined) {
+                out += `#include "${traceHeaderName}"\n`;
+            }
             out += `#include <uv.h>\n`;
             out += `#include <unistd.h>\n`;
             out += `#include <string.h>\n`;
@@ -1806,6 +2319,7 @@ class TemplateLinuxNAPI extends Template {
             out += `    napi_threadsafe_function onchange_cb;\n`;
             out += `    napi_threadsafe_function connectiononchange_cb;\n`;
             out += `    napi_threadsafe_function onprocessed_cb; //used only for datamodel\n`;
+            out += `    napi_threadsafe_function syncchange_cb;  //used only for datamodel\n`;
             out += `    napi_value object_value; //volatile placeholder.\n`;
             out += `    napi_value value;        //volatile placeholder.\n`;
             out += `} obj_handles;\n`;
@@ -1832,6 +2346,12 @@ class TemplateLinuxNAPI extends Template {
                 if (dataset.isSub || dataset.isPub) { out += `obj_handles ${dataset.structName} = {};\n`; }
             }
             out += `\n`;
+            out += `static uint32_t ${template.datamodel.varName}_sync_changes = 0;\n`;
+            out += `static int32_t ${template.datamodel.varName}_sync_changed_nettime = 0;\n`;
+            if (processHeaderName !== undefined) {
+                out += `static exos_process_t ${template.datamodel.varName}_process = {};\n`;
+            }
+            out += `\n`;
             out += `napi_deferred deferred = NULL;\n`;
             out += `uv_idle_t cyclic_h;\n`;
             out += `\n`;
@@ -1840,6 +2360,12 @@ class TemplateLinuxNAPI extends Template {
             for (let dataset of template.datasets) {
                 if (dataset.isSub || dataset.isPub) { out += `exos_dataset_handle_t ${dataset.structName}_dataset;\n`; }
             }
+            for (let dataset of Template.qosDatasets(template.datasets)) {
+                out += `exos_qos_t ${dataset.structName}_qos;\n`;
+                if (dataset.qos.filters.length > 0) {
+                    out += `${Template.qosDeadbandPrefix(template, dataset)}_t ${dataset.structName}_deadband;\n`;
+                }
+            }
             out += `\n`;
             out += `// error handling (Node.js)\n`;
             out += `static void throw_fatal_exception_callbacks(napi_env env, const char *defaultCode, const char *defaultMessage)\n`;
@@ -1874,6 +2400,8 @@ class TemplateLinuxNAPI extends Template {
         
             out += generateValuesPublishMethods(template);
         
+            out += generateQosMethods(template);
+        
             out += generateLogCleanUpHookCyclic(template);
         
             out += generateInitFunction(template);
@@ -1884,7 +2412,7 @@ class TemplateLinuxNAPI extends Template {
             return out;
         }
 
-        return generateLibTemplate(this.template);
+        return generateLibTemplate(this.template, Template.qosDatasets(this.template.datasets).length > 0 ? this.datamodel.qosFile.name : undefined, this.processHeaderName, this.trace !== undefined ? this.trace.traceHeader.name : undefined);
     }
 }
 
@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const { Datamodel, GeneratedFileObj } = require('../../../datamodel');
+const { ApplicationTemplate, ApplicationTemplateDataset } = require('../template');
+
+class TemplateLinuxProfile {
+
+    /**
+     * change-frequency profile header
+     * @type {GeneratedFileObj}
+     */
+    profileHeader;
+
+    /**
+     * {@linkcode TemplateLinuxProfile} Generate a change-frequency profiler of the dataset members (`profile` feature)
+     *
+     * Started with `--profile <path>`, every received and published value is compared with the previous value of the
+     * dataset member by member, using the offsets of the generated datamodel structure. Structure members are flattened,
+     * and the elements of an array dataset are counted separately. When the application exits, a report ranks the members
+     * of each dataset by the number of changes, and suggests a partition into smaller datasets with fewer bytes sent.
+     *
+     * The header is plain C with `static inline` functions, and can be included from C++.
+     *
+     * Generates following {@link GeneratedFileObj}
+     * - {@linkcode profileHeader}
+     *
+     * @param {Datamodel} datamodel
+     * @param {ApplicationTemplate} template Linux template of the datamodel
+     */
+    constructor(datamodel, template) {
+        let layout = datamodel.analyzeLayout(Datamodel.LAYOUT_PLATFORMS.GPOS);
+        this.profileHeader = {name:`exos_${datamodel.typeName.toLowerCase()}_profile.h`, contents:this._generateProfileHeader(template, layout), description:`${datamodel.typeName} change-frequency profile`};
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @returns {string} prefix of the profile types and functions, e.g. `exos_myapplication_profile`
+     */
+    static profilePrefix(template) {
+        return `exos_${template.datamodel.structName.toLowerCase()}_profile`;
+    }
+
+    /**
+     * The members of a dataset that are compared separately: the (flattened) members of a structure,
+     * the elements of an array, or the value itself
+     *
+     * @param {ApplicationTemplateDataset} dataset
+     * @param {LayoutAnalysis} layout
+     * @returns {{name:string, access:string}[]} name in the report, and the access of the member within the dataset value, e.g. `.Config.Gain` or `[3]`
+     */
+    static members(dataset, layout) {
+        let members = [];
+
+        function flatten(type, prefix) {
+            for (let member of type.members) {
+                let nested = member.arraySize == 0 ? layout.types.find(other => other.dataType == member.dataType) : undefined;
+                if (nested !== undefined) {
+                    flatten(nested, `${prefix}${member.name}.`);
+                }
+                else {
+                    members.push({name: `${prefix}${member.name}`, access: `.${prefix}${member.name}`});
+                }
+            }
+        }
+
+        if (dataset.arraySize > 0) {
+            for (let i = 0; i < dataset.arraySize; i++) {
+                members.push({name: `[${i}]`, access: `[${i}]`});
+            }
+        }
+        else {
+            let type = layout.types.find(type => type.dataType == dataset.dataType);
+            if (type !== undefined) {
+                flatten(type, "");
+            }
+            else {
+                members.push({name: dataset.structName, access: ""});
+            }
+        }
+        return members;
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @param {LayoutAnalysis} layout
+     * @returns {string} `exos_[typeName]_profile.h`
+     */
+    _generateProfileHeader(template, layout) {
+
+        /**
+         * @param {ApplicationTemplate} template
+         * @param {LayoutAnalysis} layout
+         * @returns {string}
+         */
+        function generateProfileHeader(template, layout) {
+            let prefix = TemplateLinuxProfile.profilePrefix(template);
+            let PREFIX = prefix.toUpperCase();
+            let structName = template.datamodel.structName;
+            let datasets = template.datasets.filter(dataset => dataset.isPub || dataset.isSub);
+            let out = "";
+
+            out += `#ifndef _${PREFIX}_H_\n`;
+            out += `#define _${PREFIX}_H_\n`;
+            out += `\n`;
+            out += `#include <stdbool.h>\n`;
+            out += `#include <stdint.h>\n`;
+            out += `#include <stddef.h>\n`;
+            out += `#include <stdio.h>\n`;
+            out += `#include <stdlib.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `extern "C" {\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#include "${template.headerName}"\n`;
+            out += `\n`;
+            out += `/* Change-frequency profile of the ${structName} datasets, enabled with a command line argument (Runtime service in the .exospkg):\n`;
+            out += `    --profile <path>    profile the received and published datasets, and write the report to <path> (- for stdout) at exit\n`;
+            out += `\n`;
+            out += `   Every received and published value is compared with the previous value of the dataset (separately per direction),\n`;
+            out += `   member by member: the members of structures are flattened, and the elements of an array dataset are compared\n`;
+            out += `   separately. The report ranks the members of each dataset by the number of changes, and suggests a partition into\n`;
+            out += `   datasets of members with a similar change frequency, which minimizes the bytes sent if each of them is only\n`;
+            out += `   published when one of its members changed. The suggestion is calculated from the changes of the last\n`;
+            out += `   ${PREFIX}_WINDOW values, with ${PREFIX}_OVERHEAD bytes per message in addition to the members, and\n`;
+            out += `   without the padding of the new structures. */\n`;
+            out += `\n`;
+            out += `#ifndef ${PREFIX}_WINDOW\n`;
+            out += `#define ${PREFIX}_WINDOW 1024 /* values whose changes are kept for the suggested partition */\n`;
+            out += `#endif\n`;
+            out += `#ifndef ${PREFIX}_OVERHEAD\n`;
+            out += `#define ${PREFIX}_OVERHEAD 64 /* bytes sent per dataset message besides the value */\n`;
+            out += `#endif\n`;
+            out += `#ifndef ${PREFIX}_PARTITION_MEMBERS\n`;
+            out += `#define ${PREFIX}_PARTITION_MEMBERS 256 /* no partition is suggested for datasets with more members */\n`;
+            out += `#endif\n`;
+            out += `#define ${PREFIX}_DATASETS ${template.datasets.length}\n`;
+            out += `#define ${PREFIX}_RECEIVED 0\n`;
+            out += `#define ${PREFIX}_PUBLISHED 1\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    const char *name;\n`;
+            out += `    size_t offset; /* within the dataset value */\n`;
+            out += `    size_t size;\n`;
+            out += `} ${prefix}_member_t;\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    uint64_t values;  /* received or published values */\n`;
+            out += `    uint64_t changed; /* values in which at least one member changed */\n`;
+            out += `    uint64_t bytes;   /* bytes of the changed members */\n`;
+            out += `    uint64_t head;    /* values compared with the previous one, the last ones are in the window */\n`;
+            out += `} ${prefix}_state_t;\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    const char *name;\n`;
+            out += `    const ${prefix}_member_t *members;\n`;
+            out += `    uint32_t count; /* members */\n`;
+            out += `    uint32_t words; /* 64 bit words of a value in the window, one bit per member */\n`;
+            out += `    size_t size;    /* size of the value */\n`;
+            out += `    size_t state;   /* offsets of the two directions in ${prefix}_t */\n`;
+            out += `    size_t changes;\n`;
+            out += `    size_t previous;\n`;
+            out += `    size_t window;\n`;
+            out += `} ${prefix}_dataset_t;\n`;
+            out += `\n`;
+
+            out += `typedef struct ${prefix}\n`;
+            out += `{\n`;
+            out += `    bool enabled;\n`;
+            out += `    char path[4096];\n`;
+            for (let dataset of datasets) {
+                let count = TemplateLinuxProfile.members(dataset, layout).length;
+                out += `    struct\n`;
+                out += `    {\n`;
+                out += `        ${prefix}_state_t state[2];\n`;
+                out += `        uint64_t changes[2][${count}];\n`;
+                out += `        uint8_t previous[2][sizeof(((${structName} *)0)->${dataset.structName})];\n`;
+                out += `        uint64_t window[2][${PREFIX}_WINDOW][${Math.ceil(count / 64)}];\n`;
+                out += `    } ${dataset.structName};\n`;
+            }
+            out += `} ${prefix}_t;\n`;
+            out += `\n`;
+
+            out += `/* the members and the state offsets of a dataset by its dataset index, NULL if it is not profiled */\n`;
+            out += `static inline const ${prefix}_dataset_t *${prefix}_dataset(uint16_t index)\n`;
+            out += `{\n`;
+            for (let dataset of datasets) {
+                out += `    static const ${prefix}_member_t members_${dataset.structName}[] = {\n`;
+                for (let member of TemplateLinuxProfile.members(dataset, layout)) {
+                    out += `        {"${member.name}", offsetof(${structName}, ${dataset.structName}${member.access}) - offsetof(${structName}, ${dataset.structName}), sizeof(((${structName} *)0)->${dataset.structName}${member.access})},\n`;
+                }
+                out += `    };\n`;
+            }
+            out += `    static const ${prefix}_dataset_t datasets[] = {\n`;
+            for (let dataset of template.datasets) {
+                if (dataset.isPub || dataset.isSub) {
+                    let count = TemplateLinuxProfile.members(dataset, layout).length;
+                    out += `        {"${dataset.structName}", members_${dataset.structName}, ${count}, ${Math.ceil(count / 64)}, sizeof(((${structName} *)0)->${dataset.structName}),\n`;
+                    out += `         offsetof(${prefix}_t, ${dataset.structName}.state), offsetof(${prefix}_t, ${dataset.structName}.changes), offsetof(${prefix}_t, ${dataset.structName}.previous), offsetof(${prefix}_t, ${dataset.structName}.window)},\n`;
+                }
+                else {
+                    out += `        {NULL, NULL, 0, 0, 0, 0, 0, 0, 0}, // ${dataset.structName}\n`;
+                }
+            }
+            out += `    };\n`;
+            out += `\n`;
+            out += `    if (index >= sizeof(datasets) / sizeof(datasets[0]) || NULL == datasets[index].name)\n`;
+            out += `        return NULL;\n`;
+            out += `    return &datasets[index];\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* allocate the profile (disabled), returns NULL if there is not enough memory */\n`;
+            out += `static inline ${prefix}_t *${prefix}_create(void)\n`;
+            out += `{\n`;
+            out += `    return (${prefix}_t *)calloc(1, sizeof(${prefix}_t));\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* enable the profile if started with --profile <path>, returns true if enabled */\n`;
+            out += `static inline bool ${prefix}_setup(${prefix}_t *profile, int argc, char **argv)\n`;
+            out += `{\n`;
+            out += `    if (NULL == profile)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    for (int i = 1; i < argc - 1; i++)\n`;
+            out += `    {\n`;
+            out += `        if (0 == strcmp(argv[i], "--profile"))\n`;
+            out += `        {\n`;
+            out += `            snprintf(profile->path, sizeof(profile->path), "%s", argv[i + 1]);\n`;
+            out += `            profile->enabled = true;\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `    return profile->enabled;\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* compare a received or published value with the previous one, ignored if the profile is NULL or disabled */\n`;
+            out += `static inline void ${prefix}_update(${prefix}_t *profile, uint16_t index, int direction, const void *data, size_t size)\n`;
+            out += `{\n`;
+            out += `    const ${prefix}_dataset_t *dataset;\n`;
+            out += `    ${prefix}_state_t *state;\n`;
+            out += `    uint64_t *changes;\n`;
+            out += `    uint64_t *row;\n`;
+            out += `    uint8_t *previous;\n`;
+            out += `\n`;
+            out += `    if (NULL == profile || !profile->enabled || (${PREFIX}_RECEIVED != direction && ${PREFIX}_PUBLISHED != direction))\n`;
+            out += `        return;\n`;
+            out += `    dataset = ${prefix}_dataset(index);\n`;
+            out += `    if (NULL == dataset || size != dataset->size)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    state = (${prefix}_state_t *)((uint8_t *)profile + dataset->state) + direction;\n`;
+            out += `    previous = (uint8_t *)profile + dataset->previous + direction * dataset->size;\n`;
+            out += `    state->values++;\n`;
+            out += `    if (1 == state->values)\n`;
+            out += `    {\n`;
+            out += `        memcpy(previous, data, size);\n`;
+            out += `        return;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    changes = (uint64_t *)((uint8_t *)profile + dataset->changes) + direction * dataset->count;\n`;
+            out += `    row = (uint64_t *)((uint8_t *)profile + dataset->window) + ((size_t)direction * ${PREFIX}_WINDOW + state->head % ${PREFIX}_WINDOW) * dataset->words;\n`;
+            out += `    memset(row, 0, dataset->words * sizeof(uint64_t));\n`;
+            out += `    state->head++;\n`;
+            out += `\n`;
+            out += `    //most values are either unchanged, or changed in a few members\n`;
+            out += `    if (0 == memcmp(previous, data, size))\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    state->changed++;\n`;
+            out += `    for (uint32_t i = 0; i < dataset->count; i++)\n`;
+            out += `    {\n`;
+            out += `        const ${prefix}_member_t *member = &dataset->members[i];\n`;
+            out += `        if (0 != memcmp(previous + member->offset, (const uint8_t *)data + member->offset, member->size))\n`;
+            out += `        {\n`;
+            out += `            changes[i]++;\n`;
+            out += `            state->bytes += member->size;\n`;
+            out += `            row[i / 64] |= (uint64_t)1 << (i % 64);\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `    memcpy(previous, data, size);\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* report of one direction of a dataset, with the members ranked by changes and the suggested partition */\n`;
+            out += `static inline void ${prefix}_report_dataset(const ${prefix}_t *profile, const ${prefix}_dataset_t *dataset, int direction, FILE *out)\n`;
+            out += `{\n`;
+            out += `    const ${prefix}_state_t *state = (const ${prefix}_state_t *)((const uint8_t *)profile + dataset->state) + direction;\n`;
+            out += `    const uint64_t *changes = (const uint64_t *)((const uint8_t *)profile + dataset->changes) + direction * dataset->count;\n`;
+            out += `    const uint64_t *window = (const uint64_t *)((const uint8_t *)profile + dataset->window) + (size_t)direction * ${PREFIX}_WINDOW * dataset->words;\n`;
+            out += `    uint32_t rows = state->head < ${PREFIX}_WINDOW ? (uint32_t)state->head : ${PREFIX}_WINDOW;\n`;
+            out += `    uint32_t *order;\n`;
+            out += `    uint32_t *split;\n`;
+            out += `    uint32_t *starts;\n`;
+            out += `    uint64_t *best;\n`;
+            out += `    uint8_t *hit;\n`;
+            out += `\n`;
+            out += `    if (0 == state->values)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    fprintf(out, "%s %s: %llu values of %zu bytes, %llu with changes, %llu bytes changed\\n", dataset->name, ${PREFIX}_RECEIVED == direction ? "received" : "published",\n`;
+            out += `            (unsigned long long)state->values, dataset->size, (unsigned long long)state->changed, (unsigned long long)state->bytes);\n`;
+            out += `\n`;
+            out += `    order = (uint32_t *)malloc(dataset->count * sizeof(uint32_t));\n`;
+            out += `    if (NULL == order)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    //rank the members by changes, members with the same number of changes keep their order\n`;
+            out += `    for (uint32_t i = 0; i < dataset->count; i++)\n`;
+            out += `    {\n`;
+            out += `        uint32_t j = i;\n`;
+            out += `        while (j > 0 && changes[order[j - 1]] < changes[i])\n`;
+            out += `        {\n`;
+            out += `            order[j] = order[j - 1];\n`;
+            out += `            j--;\n`;
+            out += `        }\n`;
+            out += `        order[j] = i;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    fprintf(out, "      rank      changes    rate    bytes  member\\n");\n`;
+            out += `    for (uint32_t i = 0; i < dataset->count; i++)\n`;
+            out += `    {\n`;
+            out += `        const ${prefix}_member_t *member = &dataset->members[order[i]];\n`;
+            out += `        fprintf(out, "    %6u %12llu %6.1f%% %8zu  %s\\n", i + 1, (unsigned long long)changes[order[i]],\n`;
+            out += `                state->values > 1 ? 100.0 * (double)changes[order[i]] / (double)(state->values - 1) : 0.0, member->size, member->name);\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    if (0 == rows || dataset->count < 2 || dataset->count > ${PREFIX}_PARTITION_MEMBERS)\n`;
+            out += `    {\n`;
+            out += `        free(order);\n`;
+            out += `        return;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    best = (uint64_t *)malloc((dataset->count + 1) * sizeof(uint64_t));\n`;
+            out += `    split = (uint32_t *)malloc((dataset->count + 1) * sizeof(uint32_t));\n`;
+            out += `    starts = (uint32_t *)malloc(dataset->count * sizeof(uint32_t));\n`;
+            out += `    hit = (uint8_t *)malloc(rows);\n`;
+            out += `    if (NULL == best || NULL == split || NULL == starts || NULL == hit)\n`;
+            out += `    {\n`;
+            out += `        free(order);\n`;
+            out += `        free(best);\n`;
+            out += `        free(split);\n`;
+            out += `        free(starts);\n`;
+            out += `        free(hit);\n`;
+            out += `        return;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    //best[j]: fewest bytes for the j most changed members, split into datasets of consecutive ranks,\n`;
+            out += `    //where a dataset is sent in each value of the window in which one of its members changed\n`;
+            out += `    best[0] = 0;\n`;
+            out += `    for (uint32_t j = 1; j <= dataset->count; j++)\n`;
+            out += `        best[j] = UINT64_MAX;\n`;
+            out += `    for (uint32_t i = 0; i < dataset->count; i++)\n`;
+            out += `    {\n`;
+            out += `        uint64_t sent = 0;\n`;
+            out += `        size_t bytes = ${PREFIX}_OVERHEAD;\n`;
+            out += `\n`;
+            out += `        memset(hit, 0, rows);\n`;
+            out += `        for (uint32_t j = i; j < dataset->count; j++)\n`;
+            out += `        {\n`;
+            out += `            uint32_t member = order[j];\n`;
+            out += `            uint64_t cost;\n`;
+            out += `\n`;
+            out += `            bytes += dataset->members[member].size;\n`;
+            out += `            for (uint32_t row = 0; row < rows; row++)\n`;
+            out += `            {\n`;
+            out += `                if (!hit[row] && (window[row * dataset->words + member / 64] >> (member % 64) & 1))\n`;
+            out += `                {\n`;
+            out += `                    hit[row] = 1;\n`;
+            out += `                    sent++;\n`;
+            out += `                }\n`;
+            out += `            }\n`;
+            out += `            cost = best[i] + sent * bytes;\n`;
+            out += `            if (cost < best[j + 1])\n`;
+            out += `            {\n`;
+            out += `                best[j + 1] = cost;\n`;
+            out += `                split[j + 1] = i;\n`;
+            out += `            }\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    {\n`;
+            out += `        uint64_t whole = (uint64_t)rows * (dataset->size + ${PREFIX}_OVERHEAD);\n`;
+            out += `        uint32_t groups = 0;\n`;
+            out += `\n`;
+            out += `        //the first member of each dataset of the partition, from the last one\n`;
+            out += `        for (uint32_t j = dataset->count; j > 0; j = split[j])\n`;
+            out += `            starts[groups++] = split[j];\n`;
+            out += `\n`;
+            out += `        fprintf(out, "    suggested partition of the last %u values: %llu bytes instead of %llu as one dataset (%.1f%%)\\n", rows,\n`;
+            out += `                (unsigned long long)best[dataset->count], (unsigned long long)whole, whole > 0 ? 100.0 * (double)best[dataset->count] / (double)whole : 0.0);\n`;
+            out += `        for (uint32_t g = 0; g < groups; g++)\n`;
+            out += `        {\n`;
+            out += `            uint32_t first = starts[groups - 1 - g];\n`;
+            out += `            uint32_t end = g + 1 < groups ? starts[groups - 2 - g] : dataset->count;\n`;
+            out += `            size_t bytes = 0;\n`;
+            out += `            uint64_t sent = 0;\n`;
+            out += `\n`;
+            out += `            memset(hit, 0, rows);\n`;
+            out += `            for (uint32_t j = first; j < end; j++)\n`;
+            out += `            {\n`;
+            out += `                bytes += dataset->members[order[j]].size;\n`;
+            out += `                for (uint32_t row = 0; row < rows; row++)\n`;
+            out += `                {\n`;
+            out += `                    if (!hit[row] && (window[row * dataset->words + order[j] / 64] >> (order[j] % 64) & 1))\n`;
+            out += `                    {\n`;
+            out += `                        hit[row] = 1;\n`;
+            out += `                        sent++;\n`;
+            out += `                    }\n`;
+            out += `                }\n`;
+            out += `            }\n`;
+            out += `            fprintf(out, "    %s %u: %zu bytes, sent %llu times:", ${PREFIX}_RECEIVED == direction ? "SUB" : "PUB", g + 1, bytes, (unsigned long long)sent);\n`;
+            out += `            for (uint32_t j = first; j < end; j++)\n`;
+            out += `                fprintf(out, " %s", dataset->members[order[j]].name);\n`;
+            out += `            fprintf(out, "\\n");\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    free(order);\n`;
+            out += `    free(best);\n`;
+            out += `    free(split);\n`;
+            out += `    free(starts);\n`;
+            out += `    free(hit);\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* write the report of all datasets */\n`;
+            out += `static inline void ${prefix}_report(const ${prefix}_t *profile, FILE *out)\n`;
+            out += `{\n`;
+            out += `    if (NULL == profile)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    fprintf(out, "change-frequency profile of ${template.datamodelInstanceName}\\n");\n`;
+            out += `    for (uint16_t index = 0; index < ${PREFIX}_DATASETS; index++)\n`;
+            out += `    {\n`;
+            out += `        const ${prefix}_dataset_t *dataset = ${prefix}_dataset(index);\n`;
+            out += `        if (NULL != dataset)\n`;
+            out += `        {\n`;
+            out += `            ${prefix}_report_dataset(profile, dataset, ${PREFIX}_RECEIVED, out);\n`;
+            out += `            ${prefix}_report_dataset(profile, dataset, ${PREFIX}_PUBLISHED, out);\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* write the report to the path given with --profile, returns false if disabled or the file cannot be written */\n`;
+            out += `static inline bool ${prefix}_write(const ${prefix}_t *profile)\n`;
+            out += `{\n`;
+            out += `    FILE *out;\n`;
+            out += `\n`;
+            out += `    if (NULL == profile || !profile->enabled)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    if (0 == strcmp(profile->path, "-"))\n`;
+            out += `    {\n`;
+            out += `        ${prefix}_report(profile, stdout);\n`;
+            out += `        fflush(stdout);\n`;
+            out += `        return true;\n`;
+            out += `    }\n`;
+            out += `    out = fopen(profile->path, "w");\n`;
+            out += `    if (NULL == out)\n`;
+            out += `        return false;\n`;
+            out += `    ${prefix}_report(profile, out);\n`;
+            out += `    return 0 == fclose(out);\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `/* write the report if enabled, and free the profile */\n`;
+            out += `static inline void ${prefix}_destroy(${prefix}_t *profile)\n`;
+            out += `{\n`;
+            out += `    if (NULL == profile)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    if (profile->enabled && !${prefix}_write(profile))\n`;
+            out += `        fprintf(stderr, "cannot write the profile to %s\\n", profile->path);\n`;
+            out += `    free(profile);\n`;
+            out += `}\n`;
+            out += `\n`;
+
+            out += `#ifdef __cplusplus\n`;
+            out += `}\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#endif // _${PREFIX}_H_\n`;
+
+            return out;
+        }
+        return generateProfileHeader(template, layout);
+    }
+}
+
+module.exports = {TemplateLinuxProfile};
@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const {GeneratedFileObj} = require('../../../datamodel')
+
+class TemplateLinuxRealtime {
+
+    /**
+     * real-time execution profile header
+     * @type {GeneratedFileObj}
+     */
+    realtimeHeader;
+
+    /**
+     * real-time execution profile source code
+     * @type {GeneratedFileObj}
+     */
+    realtimeSource;
+
+    /**
+     * default command line arguments for the `Runtime` service in the .exospkg
+     * @type {string}
+     */
+    static defaultArguments = "--rt-priority 80 --rt-cpu 1";
+
+    /**
+     * {@linkcode TemplateLinuxRealtime} Generate code for running Linux applications with a real-time execution profile (`rt` feature)
+     *
+     * The profile is configured with command line arguments, i.e. in the `Runtime` service of the .exospkg:
+     * `SCHED_FIFO` priority, CPU affinity, locked and prefaulted memory and an optional `timerfd` cycle.
+     * The wakeup latency (or cycle time, without `timerfd`) of the main loop is measured and the percentiles are reported at shutdown.
+     *
+     * Generates following {@link GeneratedFileObj} objects
+     * - {@linkcode realtimeHeader}
+     * - {@linkcode realtimeSource}
+     */
+    constructor() {
+        this.realtimeHeader = {name:"realtime.h", contents:this._generateRealtimeHeader(), description:"Real-time execution profile header"};
+        this.realtimeSource = {name:"realtime.c", contents:this._generateRealtimeSource(), description:"Real-time execution profile source"};
+    }
+
+    _generateRealtimeHeader() {
+        function generateRealtimeHeader() {
+            let out = "";
+
+            out += `#ifndef _REALTIME_H_\n`;
+            out += `#define _REALTIME_H_\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `extern "C" {\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#include <stdbool.h>\n`;
+            out += `#include <stdint.h>\n`;
+            out += `\n`;
+            out += `/* Real-time execution profile, configured with command line arguments (Runtime service in the .exospkg):\n`;
+            out += `    --rt-priority <1..99>   run the main thread with SCHED_FIFO at this priority (default: normal scheduling)\n`;
+            out += `    --rt-cpu <n>            pin the main thread to CPU n, preferably a core isolated with isolcpus=n (default: any CPU)\n`;
+            out += `    --rt-cycle <us>         align the cycles to a timerfd with this period (default: cycles are given by process())\n`;
+            out += `    --rt-prefault <kB>      prefault this amount of stack and heap (default: 512)\n`;
+            out += `\n`;
+            out += `   All memory is locked with mlockall(). Priority and affinity apply to the calling thread and to threads it creates\n`;
+            out += `   afterwards, so call rt_setup() after the datamodel is connected to keep the exOS threads at normal scheduling.\n`;
+            out += `   Errors are reported on stderr, and the application continues without the failing setting.\n`;
+            out += `*/\n`;
+            out += `void rt_setup(int argc, char **argv);\n`;
+            out += `\n`;
+            out += `/* cycle time (us) given with --rt-cycle, 0 if the cycles are given by process() */\n`;
+            out += `uint32_t rt_cycle_time();\n`;
+            out += `\n`;
+            out += `/* timerfd of --rt-cycle, -1 if not used. Can be waited for in an event loop, followed by rt_wait_cycle() */\n`;
+            out += `int rt_timer_fd();\n`;
+            out += `\n`;
+            out += `/* call once per cycle: waits for the next timerfd expiry and measures the wakeup latency,\n`;
+            out += `   or without --rt-cycle, measures the cycle time */\n`;
+            out += `void rt_wait_cycle();\n`;
+            out += `\n`;
+            out += `/* print the percentiles of the measurements to stdout */\n`;
+            out += `void rt_report();\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `}\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#endif//_REALTIME_H_\n`;
+
+            return out;
+        }
+        return generateRealtimeHeader();
+    }
+
+    _generateRealtimeSource() {
+        function generateRealtimeSource() {
+            let out = "";
+
+            out += `#define _GNU_SOURCE\n`;
+            out += `#include "realtime.h"\n`;
+            out += `#include <stdio.h>\n`;
+            out += `#include <stdlib.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `#include <unistd.h>\n`;
+            out += `#include <sched.h>\n`;
+            out += `#include <malloc.h>\n`;
+            out += `#include <time.h>\n`;
+            out += `#include <sys/mman.h>\n`;
+            out += `#include <sys/timerfd.h>\n`;
+            out += `\n`;
+            out += `// measurements in 1us buckets, larger values are counted in the last bucket\n`;
+            out += `#define RT_HISTOGRAM_SIZE 100000\n`;
+            out += `\n`;
+            out += `static uint32_t cycle_time = 0;\n`;
+            out += `static int timer_fd = -1;\n`;
+            out += `static int64_t next_expiry = 0;\n`;
+            out += `static int64_t last_wakeup = 0;\n`;
+            out += `\n`;
+            out += `static uint32_t histogram[RT_HISTOGRAM_SIZE];\n`;
+            out += `static uint64_t samples = 0;\n`;
+            out += `static uint64_t overruns = 0;\n`;
+            out += `static int64_t sample_min = 0;\n`;
+            out += `static int64_t sample_max = 0;\n`;
+            out += `\n`;
+            out += `static int64_t now_us()\n`;
+            out += `{\n`;
+            out += `    struct timespec ts;\n`;
+            out += `    clock_gettime(CLOCK_MONOTONIC, &ts);\n`;
+            out += `    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void add_sample(int64_t us)\n`;
+            out += `{\n`;
+            out += `    if (us < 0)\n`;
+            out += `        us = 0;\n`;
+            out += `    if (0 == samples || us < sample_min)\n`;
+            out += `        sample_min = us;\n`;
+            out += `    if (us > sample_max)\n`;
+            out += `        sample_max = us;\n`;
+            out += `    histogram[us < RT_HISTOGRAM_SIZE ? us : RT_HISTOGRAM_SIZE - 1]++;\n`;
+            out += `    samples++;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void prefault(size_t size)\n`;
+            out += `{\n`;
+            out += `    size_t page = (size_t)sysconf(_SC_PAGESIZE);\n`;
+            out += `    volatile char *heap;\n`;
+            out += `    volatile char *stack;\n`;
+            out += `\n`;
+            out += `    // keep freed memory in the process, so that the prefaulted heap is reused instead of returned to the system\n`;
+            out += `    mallopt(M_TRIM_THRESHOLD, -1);\n`;
+            out += `    mallopt(M_MMAP_MAX, 0);\n`;
+            out += `\n`;
+            out += `    // touch one byte per page (volatile, so that it is not optimized away)\n`;
+            out += `    heap = malloc(size);\n`;
+            out += `    if (NULL != heap)\n`;
+            out += `    {\n`;
+            out += `        for (size_t i = 0; i < size; i += page)\n`;
+            out += `            heap[i] = 0;\n`;
+            out += `        free((void *)heap);\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    stack = alloca(size);\n`;
+            out += `    for (size_t i = 0; i < size; i += page)\n`;
+            out += `        stack[i] = 0;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static long get_argument(int argc, char **argv, const char *name, long value)\n`;
+            out += `{\n`;
+            out += `    for (int i = 1; i < argc - 1; i++)\n`;
+            out += `    {\n`;
+            out += `        if (0 == strcmp(argv[i], name))\n`;
+            out += `            return strtol(argv[i + 1], NULL, 0);\n`;
+            out += `    }\n`;
+            out += `    return value;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void rt_setup(int argc, char **argv)\n`;
+            out += `{\n`;
+            out += `    long priority = get_argument(argc, argv, "--rt-priority", 0);\n`;
+            out += `    long cpu = get_argument(argc, argv, "--rt-cpu", -1);\n`;
+            out += `    long cycle = get_argument(argc, argv, "--rt-cycle", 0);\n`;
+            out += `    long prefault_kb = get_argument(argc, argv, "--rt-prefault", 512);\n`;
+            out += `\n`;
+            out += `    if (0 != mlockall(MCL_CURRENT | MCL_FUTURE))\n`;
+            out += `        perror("rt: mlockall failed");\n`;
+            out += `    if (prefault_kb > 0)\n`;
+            out += `        prefault((size_t)prefault_kb * 1024);\n`;
+            out += `\n`;
+            out += `    if (cpu >= 0)\n`;
+            out += `    {\n`;
+            out += `        cpu_set_t cpus;\n`;
+            out += `        CPU_ZERO(&cpus);\n`;
+            out += `        CPU_SET(cpu, &cpus);\n`;
+            out += `        if (0 != sched_setaffinity(0, sizeof(cpus), &cpus))\n`;
+            out += `            perror("rt: sched_setaffinity failed");\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    if (priority > 0)\n`;
+            out += `    {\n`;
+            out += `        struct sched_param param = {.sched_priority = (int)priority};\n`;
+            out += `        if (0 != sched_setscheduler(0, SCHED_FIFO, &param))\n`;
+            out += `            perror("rt: sched_setscheduler failed");\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    if (cycle > 0)\n`;
+            out += `    {\n`;
+            out += `        struct itimerspec spec = {};\n`;
+            out += `\n`;
+            out += `        // absolute expiry times, so that the wakeup latency is measured against the exact expiry\n`;
+            out += `        timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);\n`;
+            out += `        next_expiry = now_us() + cycle;\n`;
+            out += `        spec.it_value.tv_sec = next_expiry / 1000000;\n`;
+            out += `        spec.it_value.tv_nsec = (next_expiry % 1000000) * 1000;\n`;
+            out += `        spec.it_interval.tv_sec = cycle / 1000000;\n`;
+            out += `        spec.it_interval.tv_nsec = (cycle % 1000000) * 1000;\n`;
+            out += `        if (timer_fd < 0 || 0 != timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, NULL))\n`;
+            out += `        {\n`;
+            out += `            perror("rt: timerfd failed");\n`;
+            out += `            if (timer_fd >= 0)\n`;
+            out += `                close(timer_fd);\n`;
+            out += `            timer_fd = -1;\n`;
+            out += `        }\n`;
+            out += `        else\n`;
+            out += `        {\n`;
+            out += `            cycle_time = (uint32_t)cycle;\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    printf("rt: priority %ld, cpu %ld, cycle %u us, prefault %ld kB\\n", priority, cpu, cycle_time, prefault_kb);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `uint32_t rt_cycle_time()\n`;
+            out += `{\n`;
+            out += `    return cycle_time;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `int rt_timer_fd()\n`;
+            out += `{\n`;
+            out += `    return timer_fd;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void rt_wait_cycle()\n`;
+            out += `{\n`;
+            out += `    if (timer_fd >= 0)\n`;
+            out += `    {\n`;
+            out += `        uint64_t expirations = 0;\n`;
+            out += `\n`;
+            out += `        // interrupted by a signal (i.e. termination) if not a full read\n`;
+            out += `        if (sizeof(expirations) != read(timer_fd, &expirations, sizeof(expirations)) || 0 == expirations)\n`;
+            out += `            return;\n`;
+            out += `\n`;
+            out += `        // with missed expirations, the latency is measured against the last one\n`;
+            out += `        next_expiry += (int64_t)(expirations - 1) * cycle_time;\n`;
+            out += `        overruns += expirations - 1;\n`;
+            out += `        add_sample(now_us() - next_expiry);\n`;
+            out += `        next_expiry += cycle_time;\n`;
+            out += `    }\n`;
+            out += `    else\n`;
+            out += `    {\n`;
+            out += `        int64_t now = now_us();\n`;
+            out += `        if (0 != last_wakeup)\n`;
+            out += `            add_sample(now - last_wakeup);\n`;
+            out += `        last_wakeup = now;\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static int64_t percentile(double p)\n`;
+            out += `{\n`;
+            out += `    uint64_t rank = (uint64_t)(p * samples);\n`;
+            out += `    uint64_t count = 0;\n`;
+            out += `\n`;
+            out += `    for (int64_t i = 0; i < RT_HISTOGRAM_SIZE; i++)\n`;
+            out += `    {\n`;
+            out += `        count += histogram[i];\n`;
+            out += `        if (count > rank)\n`;
+            out += `            return i;\n`;
+            out += `    }\n`;
+            out += `    return RT_HISTOGRAM_SIZE - 1;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void rt_report()\n`;
+            out += `{\n`;
+            out += `    if (0 == samples)\n`;
+            out += `    {\n`;
+            out += `        printf("rt: no cycles measured\\n");\n`;
+            out += `        return;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    printf("rt: %s (us) over %llu cycles, %llu overruns: min %lld, p50 %lld, p90 %lld, p99 %lld, p99.9 %lld, max %lld\\n",\n`;
+            out += `           timer_fd >= 0 ? "wakeup latency" : "cycle time", (unsigned long long)samples, (unsigned long long)overruns,\n`;
+            out += `           (long long)sample_min, (long long)percentile(0.5), (long long)percentile(0.9), (long long)percentile(0.99),\n`;
+            out += `           (long long)percentile(0.999), (long long)sample_max);\n`;
+            out += `}\n`;
+
+            return out;
+        }
+        return generateRealtimeSource();
+    }
+}
+
+module.exports = {TemplateLinuxRealtime};
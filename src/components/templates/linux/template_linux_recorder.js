@@ -0,0 +1,595 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const {GeneratedFileObj} = require('../../../datamodel')
+
+class TemplateLinuxRecorder {
+
+    /**
+     * dataset traffic recorder header
+     * @type {GeneratedFileObj}
+     */
+    recorderHeader;
+
+    /**
+     * dataset traffic recorder source code
+     * @type {GeneratedFileObj}
+     */
+    recorderSource;
+
+    /**
+     * {@linkcode TemplateLinuxRecorder} Generate code for recording the dataset traffic of Linux applications (`record` feature)
+     *
+     * The recording is enabled with command line arguments, i.e. in the `Runtime` service of the .exospkg.
+     * Received and published datasets are appended to a ring of memory mapped segment files, each starting with
+     * the `config_*` JSON of the datamodel as schema, followed by records with the dataset index, nettime,
+     * `CLOCK_MONOTONIC` time, direction and the raw value.
+     *
+     * A recording is replayed with `--replay <path>`: instead of connecting to the DMR, process() delivers the
+     * recorded datasets through the same dataset events and callbacks, in the original timing, scaled or as fast as possible.
+     *
+     * Generates following {@link GeneratedFileObj} objects
+     * - {@linkcode recorderHeader}
+     * - {@linkcode recorderSource}
+     */
+    constructor() {
+        this.recorderHeader = {name:"recorder.h", contents:this._generateRecorderHeader(), description:"Dataset traffic recorder header"};
+        this.recorderSource = {name:"recorder.c", contents:this._generateRecorderSource(), description:"Dataset traffic recorder source"};
+    }
+
+    _generateRecorderHeader() {
+        function generateRecorderHeader() {
+            let out = "";
+
+            out += `#ifndef _RECORDER_H_\n`;
+            out += `#define _RECORDER_H_\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `extern "C" {\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#include <stdbool.h>\n`;
+            out += `#include <stdint.h>\n`;
+            out += `#include <stddef.h>\n`;
+            out += `\n`;
+            out += `/* Recorder for the dataset traffic, enabled with command line arguments (Runtime service in the .exospkg):\n`;
+            out += `    --record <path>             record to the segment files <path>.0 .. <path>.<n-1> (default: not recorded)\n`;
+            out += `    --record-segments <2..64>   number of segments in the ring (default: 8)\n`;
+            out += `    --record-size <kB>          size of each segment (default: 4096)\n`;
+            out += `\n`;
+            out += `   The segments are created, mapped and prefaulted in rec_setup(), so that recording an event is a copy to memory\n`;
+            out += `   without system calls. When a segment is full, the recording continues in the next one, and the oldest segment\n`;
+            out += `   is overwritten, which bounds the storage to segments * size. The kernel writes the segments to the files in the\n`;
+            out += `   background, and they are complete when the application exits or crashes (not when the system loses power).\n`;
+            out += `\n`;
+            out += `   Each segment starts with a rec_segment_header_t, followed by the schema (the config JSON of the datamodel,\n`;
+            out += `   its children are the datasets in the order of the dataset index) and the records. Each record is a\n`;
+            out += `   rec_record_t followed by the raw dataset value, padded to 8 bytes.\n`;
+            out += `   Events are recorded from one thread, the thread calling process().\n`;
+            out += `\n`;
+            out += `   Replay, instead of connecting to the DMR:\n`;
+            out += `    --replay <path>             replay the segment files <path>.0 .. recorded with the same datamodel\n`;
+            out += `    --replay-speed <factor>     1 original timing (default), 2 twice as fast, 0.5 half as fast, 0 as fast as possible\n`;
+            out += `    --replay-step <us>          deliver the datasets received within this nettime per process() (default: one recorded cycle)\n`;
+            out += `\n`;
+            out += `   During a replay, process() delivers the recorded datasets through the same dataset events and callbacks as\n`;
+            out += `   received datasets, publishes are recorded (with --record) but not sent, and get_nettime() returns the recorded nettime.\n`;
+            out += `*/\n`;
+            out += `#define REC_MAGIC "EXOSREC1"\n`;
+            out += `#define REC_VERSION 1\n`;
+            out += `\n`;
+            out += `typedef enum\n`;
+            out += `{\n`;
+            out += `    REC_UPDATED = 1,  /* received dataset, recorded before the callbacks */\n`;
+            out += `    REC_PUBLISHED = 2, /* published dataset, recorded after the publish */\n`;
+            out += `    REC_CYCLE = 3      /* end of a process() that received datasets, without value */\n`;
+            out += `} rec_direction_t;\n`;
+            out += `\n`;
+            out += `typedef struct rec_segment_header\n`;
+            out += `{\n`;
+            out += `    char magic[8];           /* REC_MAGIC */\n`;
+            out += `    uint32_t version;        /* REC_VERSION */\n`;
+            out += `    uint32_t records_offset; /* offset of the first record, after the schema */\n`;
+            out += `    uint64_t sequence;       /* number of the segment in the recording, 0 if it was never used. The lowest is the oldest */\n`;
+            out += `    uint64_t size;           /* size of the segment */\n`;
+            out += `    uint64_t used;           /* end of the last complete record, updated after each record */\n`;
+            out += `    uint64_t records;        /* number of records in the segment */\n`;
+            out += `    int64_t realtime_offset; /* CLOCK_REALTIME - CLOCK_MONOTONIC (ns) when the segment was started */\n`;
+            out += `    uint32_t schema_size;    /* size of the schema following the header, without terminating zero */\n`;
+            out += `    uint32_t reserved;\n`;
+            out += `} rec_segment_header_t;\n`;
+            out += `\n`;
+            out += `typedef struct rec_record\n`;
+            out += `{\n`;
+            out += `    uint32_t size;      /* size of the dataset value following the record */\n`;
+            out += `    uint16_t dataset;   /* index of the dataset in the schema */\n`;
+            out += `    uint8_t direction;  /* rec_direction_t */\n`;
+            out += `    uint8_t reserved;\n`;
+            out += `    int32_t nettime;    /* nettime of the dataset (us) */\n`;
+            out += `    uint32_t reserved2;\n`;
+            out += `    int64_t monotonic;  /* CLOCK_MONOTONIC (ns) when the event was recorded */\n`;
+            out += `} rec_record_t;\n`;
+            out += `\n`;
+            out += `typedef struct rec_stats\n`;
+            out += `{\n`;
+            out += `    uint64_t records;  /* recorded events */\n`;
+            out += `    uint64_t bytes;    /* recorded bytes, including the record headers */\n`;
+            out += `    uint64_t segments; /* segments started, more than the number of segments means the oldest were overwritten */\n`;
+            out += `    uint64_t dropped;  /* events larger than a segment, which were not recorded */\n`;
+            out += `} rec_stats_t;\n`;
+            out += `\n`;
+            out += `/* open the recording if --record is given, returns true if recording. The schema is copied to each segment */\n`;
+            out += `bool rec_setup(int argc, char **argv, const char *schema);\n`;
+            out += `\n`;
+            out += `/* record a dataset event, does nothing if not recording */\n`;
+            out += `void rec_event(uint16_t dataset, rec_direction_t direction, int32_t nettime, const void *data, size_t size);\n`;
+            out += `\n`;
+            out += `/* record the end of a process() cycle, if datasets were received in it */\n`;
+            out += `void rec_cycle(int32_t nettime);\n`;
+            out += `\n`;
+            out += `/* statistics of the current recording */\n`;
+            out += `rec_stats_t rec_stats(void);\n`;
+            out += `\n`;
+            out += `/* open the replay if --replay is given, returns true if replaying. The recording must have the same schema */\n`;
+            out += `bool rec_replay_setup(int argc, char **argv, const char *schema);\n`;
+            out += `\n`;
+            out += `/* replay opened with rec_replay_setup(), also after the end of the recording */\n`;
+            out += `bool rec_replaying(void);\n`;
+            out += `\n`;
+            out += `/* end of the recording reached */\n`;
+            out += `bool rec_replay_finished(void);\n`;
+            out += `\n`;
+            out += `/* nettime of the last replayed dataset */\n`;
+            out += `int32_t rec_replay_nettime(void);\n`;
+            out += `\n`;
+            out += `/* receives the replayed datasets, with the dataset index of the schema */\n`;
+            out += `typedef void (*rec_replay_cb)(uint16_t dataset, int32_t nettime, const void *data, size_t size, void *context);\n`;
+            out += `\n`;
+            out += `/* replay the next cycle (or --replay-step), waiting for its time with --replay-speed. Returns false at the end */\n`;
+            out += `bool rec_replay_process(rec_replay_cb callback, void *context);\n`;
+            out += `\n`;
+            out += `/* replay all datasets received up to this nettime without waiting, returns the number of replayed datasets */\n`;
+            out += `uint32_t rec_replay_until(int32_t nettime, rec_replay_cb callback, void *context);\n`;
+            out += `\n`;
+            out += `/* close the recording and the replay, and print the statistics to stdout */\n`;
+            out += `void rec_close(void);\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `}\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#endif//_RECORDER_H_\n`;
+
+            return out;
+        }
+        return generateRecorderHeader();
+    }
+
+    _generateRecorderSource() {
+        function generateRecorderSource() {
+            let out = "";
+
+            out += `#define _GNU_SOURCE\n`;
+            out += `#include "recorder.h"\n`;
+            out += `#include <stdio.h>\n`;
+            out += `#include <stdlib.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `#include <unistd.h>\n`;
+            out += `#include <fcntl.h>\n`;
+            out += `#include <time.h>\n`;
+            out += `#include <sys/mman.h>\n`;
+            out += `#include <sys/stat.h>\n`;
+            out += `\n`;
+            out += `#define REC_MAX_SEGMENTS 64\n`;
+            out += `#define REC_ALIGN(_size_) (((_size_) + 7) & ~(uint64_t)7)\n`;
+            out += `\n`;
+            out += `static bool recording = false;\n`;
+            out += `static uint32_t segments = 0;\n`;
+            out += `static uint64_t segment_size = 0;\n`;
+            out += `static uint8_t *segment[REC_MAX_SEGMENTS];\n`;
+            out += `static uint32_t current = 0;\n`;
+            out += `static uint64_t position = 0;\n`;
+            out += `static bool received = false;\n`;
+            out += `static rec_stats_t stats;\n`;
+            out += `\n`;
+            out += `static bool replaying = false;\n`;
+            out += `static bool replay_finished = false;\n`;
+            out += `static double replay_speed = 1;\n`;
+            out += `static int32_t replay_step = 0;\n`;
+            out += `static uint32_t replay_segments = 0;\n`;
+            out += `static const uint8_t *replay_segment[REC_MAX_SEGMENTS];\n`;
+            out += `static uint64_t replay_size[REC_MAX_SEGMENTS];\n`;
+            out += `static uint32_t replay_current = 0;\n`;
+            out += `static uint64_t replay_position = 0;\n`;
+            out += `static int32_t replay_nettime = 0;\n`;
+            out += `static int64_t replay_started = 0;\n`;
+            out += `static int64_t replay_first = 0;\n`;
+            out += `static uint64_t replayed = 0;\n`;
+            out += `\n`;
+            out += `static int64_t clock_ns(clockid_t clock)\n`;
+            out += `{\n`;
+            out += `    struct timespec ts;\n`;
+            out += `    clock_gettime(clock, &ts);\n`;
+            out += `    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static const char *get_argument(int argc, char **argv, const char *name)\n`;
+            out += `{\n`;
+            out += `    for (int i = 1; i < argc - 1; i++)\n`;
+            out += `    {\n`;
+            out += `        if (0 == strcmp(argv[i], name))\n`;
+            out += `            return argv[i + 1];\n`;
+            out += `    }\n`;
+            out += `    return NULL;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void start_segment(uint32_t index)\n`;
+            out += `{\n`;
+            out += `    rec_segment_header_t *header = (rec_segment_header_t *)segment[index];\n`;
+            out += `\n`;
+            out += `    // invalidate the records before the segment is reused\n`;
+            out += `    __atomic_store_n(&header->used, header->records_offset, __ATOMIC_RELEASE);\n`;
+            out += `    header->records = 0;\n`;
+            out += `    header->realtime_offset = clock_ns(CLOCK_REALTIME) - clock_ns(CLOCK_MONOTONIC);\n`;
+            out += `    header->sequence = ++stats.segments;\n`;
+            out += `\n`;
+            out += `    current = index;\n`;
+            out += `    position = header->records_offset;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void unmap_segments(void)\n`;
+            out += `{\n`;
+            out += `    for (uint32_t i = 0; i < segments; i++)\n`;
+            out += `    {\n`;
+            out += `        if (NULL != segment[i])\n`;
+            out += `            munmap(segment[i], segment_size);\n`;
+            out += `        segment[i] = NULL;\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool rec_setup(int argc, char **argv, const char *schema)\n`;
+            out += `{\n`;
+            out += `    const char *path = get_argument(argc, argv, "--record");\n`;
+            out += `    const char *count = get_argument(argc, argv, "--record-segments");\n`;
+            out += `    const char *size_kb = get_argument(argc, argv, "--record-size");\n`;
+            out += `    size_t schema_size = strlen(schema);\n`;
+            out += `    uint32_t records_offset = (uint32_t)REC_ALIGN(sizeof(rec_segment_header_t) + schema_size + 1);\n`;
+            out += `\n`;
+            out += `    if (NULL == path)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    segments = NULL != count ? (uint32_t)strtoul(count, NULL, 0) : 8;\n`;
+            out += `    segment_size = (NULL != size_kb ? strtoull(size_kb, NULL, 0) : 4096) * 1024;\n`;
+            out += `    if (segments < 2 || segments > REC_MAX_SEGMENTS || segment_size < records_offset + sizeof(rec_record_t))\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "rec: invalid --record-segments or --record-size, not recording\\n");\n`;
+            out += `        segments = 0;\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    for (uint32_t i = 0; i < segments; i++)\n`;
+            out += `    {\n`;
+            out += `        char name[4096];\n`;
+            out += `        rec_segment_header_t *header;\n`;
+            out += `        int fd;\n`;
+            out += `\n`;
+            out += `        snprintf(name, sizeof(name), "%s.%u", path, i);\n`;
+            out += `        fd = open(name, O_RDWR | O_CREAT | O_TRUNC, 0644);\n`;
+            out += `        if (fd < 0 || 0 != ftruncate(fd, (off_t)segment_size))\n`;
+            out += `        {\n`;
+            out += `            perror("rec: cannot create the segment file, not recording");\n`;
+            out += `            if (fd >= 0)\n`;
+            out += `                close(fd);\n`;
+            out += `            unmap_segments();\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `        segment[i] = mmap(NULL, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);\n`;
+            out += `        close(fd);\n`;
+            out += `        if (MAP_FAILED == segment[i])\n`;
+            out += `        {\n`;
+            out += `            perror("rec: cannot map the segment file, not recording");\n`;
+            out += `            segment[i] = NULL;\n`;
+            out += `            unmap_segments();\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `\n`;
+            out += `        header = (rec_segment_header_t *)segment[i];\n`;
+            out += `        memcpy(header->magic, REC_MAGIC, sizeof(header->magic));\n`;
+            out += `        header->version = REC_VERSION;\n`;
+            out += `        header->records_offset = records_offset;\n`;
+            out += `        header->sequence = 0;\n`;
+            out += `        header->size = segment_size;\n`;
+            out += `        header->used = records_offset;\n`;
+            out += `        header->schema_size = (uint32_t)schema_size;\n`;
+            out += `        memcpy(segment[i] + sizeof(rec_segment_header_t), schema, schema_size + 1);\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    memset(&stats, 0, sizeof(stats));\n`;
+            out += `    start_segment(0);\n`;
+            out += `    recording = true;\n`;
+            out += `    printf("rec: recording to %s.0 .. %s.%u (%u segments of %llu kB)\\n", path, path, segments - 1, segments, (unsigned long long)(segment_size / 1024));\n`;
+            out += `    return true;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void rec_event(uint16_t dataset, rec_direction_t direction, int32_t nettime, const void *data, size_t size)\n`;
+            out += `{\n`;
+            out += `    rec_segment_header_t *header;\n`;
+            out += `    rec_record_t *record;\n`;
+            out += `    uint64_t length = sizeof(rec_record_t) + REC_ALIGN(size);\n`;
+            out += `\n`;
+            out += `    if (!recording)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    if (position + length > segment_size)\n`;
+            out += `    {\n`;
+            out += `        if (((rec_segment_header_t *)segment[current])->records_offset + length > segment_size)\n`;
+            out += `        {\n`;
+            out += `            stats.dropped++;\n`;
+            out += `            return;\n`;
+            out += `        }\n`;
+            out += `        start_segment((current + 1) % segments);\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    header = (rec_segment_header_t *)segment[current];\n`;
+            out += `    record = (rec_record_t *)(segment[current] + position);\n`;
+            out += `    record->size = (uint32_t)size;\n`;
+            out += `    record->dataset = dataset;\n`;
+            out += `    record->direction = (uint8_t)direction;\n`;
+            out += `    record->reserved = 0;\n`;
+            out += `    record->nettime = nettime;\n`;
+            out += `    record->reserved2 = 0;\n`;
+            out += `    record->monotonic = clock_ns(CLOCK_MONOTONIC);\n`;
+            out += `    if (size > 0)\n`;
+            out += `        memcpy(record + 1, data, size);\n`;
+            out += `\n`;
+            out += `    position += length;\n`;
+            out += `    header->records++;\n`;
+            out += `    // a reader sees the record once used covers it\n`;
+            out += `    __atomic_store_n(&header->used, position, __ATOMIC_RELEASE);\n`;
+            out += `\n`;
+            out += `    stats.records++;\n`;
+            out += `    stats.bytes += length;\n`;
+            out += `    if (REC_UPDATED == direction)\n`;
+            out += `        received = true;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void rec_cycle(int32_t nettime)\n`;
+            out += `{\n`;
+            out += `    if (!recording || !received)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    received = false;\n`;
+            out += `    rec_event(0, REC_CYCLE, nettime, NULL, 0);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `rec_stats_t rec_stats(void)\n`;
+            out += `{\n`;
+            out += `    return stats;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void unmap_replay(void)\n`;
+            out += `{\n`;
+            out += `    for (uint32_t i = 0; i < replay_segments; i++)\n`;
+            out += `        munmap((void *)replay_segment[i], replay_size[i]);\n`;
+            out += `    replay_segments = 0;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool rec_replay_setup(int argc, char **argv, const char *schema)\n`;
+            out += `{\n`;
+            out += `    const char *path = get_argument(argc, argv, "--replay");\n`;
+            out += `    const char *speed = get_argument(argc, argv, "--replay-speed");\n`;
+            out += `    const char *step = get_argument(argc, argv, "--replay-step");\n`;
+            out += `    size_t schema_size = strlen(schema);\n`;
+            out += `\n`;
+            out += `    if (NULL == path)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    replay_speed = NULL != speed ? strtod(speed, NULL) : 1;\n`;
+            out += `    replay_step = NULL != step ? (int32_t)strtol(step, NULL, 0) : 0;\n`;
+            out += `\n`;
+            out += `    // map the used segments, until the first missing file\n`;
+            out += `    for (uint32_t i = 0; i < REC_MAX_SEGMENTS; i++)\n`;
+            out += `    {\n`;
+            out += `        char name[4096];\n`;
+            out += `        const rec_segment_header_t *header;\n`;
+            out += `        struct stat st;\n`;
+            out += `        void *map;\n`;
+            out += `        int fd;\n`;
+            out += `\n`;
+            out += `        snprintf(name, sizeof(name), "%s.%u", path, i);\n`;
+            out += `        fd = open(name, O_RDONLY);\n`;
+            out += `        if (fd < 0)\n`;
+            out += `            break;\n`;
+            out += `        if (0 != fstat(fd, &st) || (size_t)st.st_size < sizeof(rec_segment_header_t))\n`;
+            out += `        {\n`;
+            out += `            close(fd);\n`;
+            out += `            continue;\n`;
+            out += `        }\n`;
+            out += `        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);\n`;
+            out += `        close(fd);\n`;
+            out += `        if (MAP_FAILED == map)\n`;
+            out += `            continue;\n`;
+            out += `\n`;
+            out += `        header = (const rec_segment_header_t *)map;\n`;
+            out += `        if (0 != memcmp(header->magic, REC_MAGIC, sizeof(header->magic)) || REC_VERSION != header->version || 0 == header->sequence ||\n`;
+            out += `            header->used > (uint64_t)st.st_size)\n`;
+            out += `        {\n`;
+            out += `            munmap(map, (size_t)st.st_size);\n`;
+            out += `            continue;\n`;
+            out += `        }\n`;
+            out += `        if (header->schema_size != schema_size || 0 != memcmp((const uint8_t *)map + sizeof(rec_segment_header_t), schema, schema_size))\n`;
+            out += `        {\n`;
+            out += `            fprintf(stderr, "rec: %s was recorded with another datamodel, not replaying\\n", name);\n`;
+            out += `            munmap(map, (size_t)st.st_size);\n`;
+            out += `            unmap_replay();\n`;
+            out += `            return false;\n`;
+            out += `        }\n`;
+            out += `\n`;
+            out += `        // keep the segments in the order they were recorded\n`;
+            out += `        uint32_t j = replay_segments;\n`;
+            out += `        while (j > 0 && ((const rec_segment_header_t *)replay_segment[j - 1])->sequence > header->sequence)\n`;
+            out += `        {\n`;
+            out += `            replay_segment[j] = replay_segment[j - 1];\n`;
+            out += `            replay_size[j] = replay_size[j - 1];\n`;
+            out += `            j--;\n`;
+            out += `        }\n`;
+            out += `        replay_segment[j] = map;\n`;
+            out += `        replay_size[j] = (uint64_t)st.st_size;\n`;
+            out += `        replay_segments++;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    if (0 == replay_segments)\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "rec: no recording found at %s.0, not replaying\\n", path);\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    replay_current = 0;\n`;
+            out += `    replay_position = ((const rec_segment_header_t *)replay_segment[0])->records_offset;\n`;
+            out += `    replay_started = 0;\n`;
+            out += `    replayed = 0;\n`;
+            out += `    replay_finished = false;\n`;
+            out += `    replaying = true;\n`;
+            out += `    printf("rec: replaying %u segments from %s (speed %g)\\n", replay_segments, path, replay_speed);\n`;
+            out += `    return true;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool rec_replaying(void)\n`;
+            out += `{\n`;
+            out += `    return replaying;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool rec_replay_finished(void)\n`;
+            out += `{\n`;
+            out += `    return replay_finished;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `int32_t rec_replay_nettime(void)\n`;
+            out += `{\n`;
+            out += `    return replay_nettime;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `// the next record, continuing in the next segment at the end of a segment\n`;
+            out += `static const rec_record_t *replay_peek(void)\n`;
+            out += `{\n`;
+            out += `    while (replay_current < replay_segments)\n`;
+            out += `    {\n`;
+            out += `        const rec_segment_header_t *header = (const rec_segment_header_t *)replay_segment[replay_current];\n`;
+            out += `\n`;
+            out += `        if (replay_position + sizeof(rec_record_t) <= header->used)\n`;
+            out += `            return (const rec_record_t *)(replay_segment[replay_current] + replay_position);\n`;
+            out += `\n`;
+            out += `        replay_current++;\n`;
+            out += `        if (replay_current < replay_segments)\n`;
+            out += `            replay_position = ((const rec_segment_header_t *)replay_segment[replay_current])->records_offset;\n`;
+            out += `    }\n`;
+            out += `    replay_finished = true;\n`;
+            out += `    return NULL;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void replay_record(const rec_record_t *record, rec_replay_cb callback, void *context)\n`;
+            out += `{\n`;
+            out += `    replay_position += sizeof(rec_record_t) + REC_ALIGN(record->size);\n`;
+            out += `    if (REC_UPDATED != record->direction)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    replay_nettime = record->nettime;\n`;
+            out += `    replayed++;\n`;
+            out += `    callback(record->dataset, record->nettime, record + 1, record->size, context);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void replay_wait(int64_t monotonic)\n`;
+            out += `{\n`;
+            out += `    struct timespec ts;\n`;
+            out += `    int64_t due;\n`;
+            out += `\n`;
+            out += `    if (0 == replay_started)\n`;
+            out += `    {\n`;
+            out += `        replay_started = clock_ns(CLOCK_MONOTONIC);\n`;
+            out += `        replay_first = monotonic;\n`;
+            out += `    }\n`;
+            out += `    if (replay_speed <= 0)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    due = replay_started + (int64_t)((double)(monotonic - replay_first) / replay_speed);\n`;
+            out += `    ts.tv_sec = due / 1000000000;\n`;
+            out += `    ts.tv_nsec = due % 1000000000;\n`;
+            out += `    // returns early on a signal, so that the application can terminate\n`;
+            out += `    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool rec_replay_process(rec_replay_cb callback, void *context)\n`;
+            out += `{\n`;
+            out += `    const rec_record_t *record;\n`;
+            out += `    int32_t until;\n`;
+            out += `\n`;
+            out += `    if (!replaying || NULL == (record = replay_peek()))\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    replay_wait(record->monotonic);\n`;
+            out += `    until = record->nettime + replay_step;\n`;
+            out += `    while (NULL != (record = replay_peek()))\n`;
+            out += `    {\n`;
+            out += `        if (0 == replay_step)\n`;
+            out += `        {\n`;
+            out += `            replay_record(record, callback, context);\n`;
+            out += `            if (REC_CYCLE == record->direction)\n`;
+            out += `                break;\n`;
+            out += `        }\n`;
+            out += `        else\n`;
+            out += `        {\n`;
+            out += `            if (REC_UPDATED == record->direction && (int32_t)(record->nettime - until) > 0)\n`;
+            out += `                break;\n`;
+            out += `            replay_record(record, callback, context);\n`;
+            out += `        }\n`;
+            out += `    }\n`;
+            out += `    return !replay_finished;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `uint32_t rec_replay_until(int32_t nettime, rec_replay_cb callback, void *context)\n`;
+            out += `{\n`;
+            out += `    const rec_record_t *record;\n`;
+            out += `    uint64_t count = replayed;\n`;
+            out += `\n`;
+            out += `    if (!replaying)\n`;
+            out += `        return 0;\n`;
+            out += `\n`;
+            out += `    while (NULL != (record = replay_peek()))\n`;
+            out += `    {\n`;
+            out += `        if (REC_UPDATED == record->direction && (int32_t)(record->nettime - nettime) > 0)\n`;
+            out += `            break;\n`;
+            out += `        replay_record(record, callback, context);\n`;
+            out += `    }\n`;
+            out += `    return (uint32_t)(replayed - count);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void rec_close(void)\n`;
+            out += `{\n`;
+            out += `    if (replaying)\n`;
+            out += `    {\n`;
+            out += `        replaying = false;\n`;
+            out += `        unmap_replay();\n`;
+            out += `        printf("rec: %llu datasets replayed\\n", (unsigned long long)replayed);\n`;
+            out += `    }\n`;
+            out += `    if (!recording)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    recording = false;\n`;
+            out += `    unmap_segments();\n`;
+            out += `    printf("rec: %llu events recorded (%llu bytes), %llu segments started, %llu dropped\\n",\n`;
+            out += `           (unsigned long long)stats.records, (unsigned long long)stats.bytes, (unsigned long long)stats.segments, (unsigned long long)stats.dropped);\n`;
+            out += `}\n`;
+
+            return out;
+        }
+        return generateRecorderSource();
+    }
+}
+
+module.exports = {TemplateLinuxRecorder};
@@ -7,9 +7,14 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-const { Template, ApplicationTemplate } = require('../template');
+const { Template, ApplicationTemplate, TemplateFeature } = require('../template');
 const { TemplateLinuxTermination } = require('./template_linux_termination');
+const { TemplateLinuxRealtime } = require('./template_linux_realtime');
+const { TemplateLinuxLoadgen } = require('./template_linux_loadgen');
 const { TemplateStaticCLib } = require('../template_static_c_lib');
+const { TemplateLinuxMetrics } = require('./template_linux_metrics');
+const { TemplateLinuxTrace } = require('./template_linux_trace');
+const { TemplateLinuxProfile } = require('./template_linux_profile');
 const { Datamodel } = require('../../../datamodel');
 
 class TemplateLinuxStaticCLib extends TemplateStaticCLib {
@@ -19,6 +24,24 @@ class TemplateLinuxStaticCLib extends TemplateStaticCLib {
      */
     termination;
 
+    /**
+     * only with the `rt` feature
+     * @type {TemplateLinuxRealtime}
+     */
+    realtime;
+
+    /**
+     * only with the `loadgen` feature
+     * @type {TemplateLinuxLoadgen}
+     */
+    loadgen;
+
+    /**
+     * main loop built on the event loop of {@linkcode termination} (`epoll` feature)
+     * @type {boolean}
+     */
+    eventLoop;
+
     /**
      * main sourcefile for the application
      * @type {GeneratedFileObj}
@@ -37,14 +60,58 @@ class TemplateLinuxStaticCLib extends TemplateStaticCLib {
      * 
      * Using {@linkcode TemplateLinuxTermination}:
      * - `termination.terminationHeader` termination handling header
-     * - `termination.terminationSource` termination handling source code
+     * - `termination.terminationSource` termination handling source code, with the `epoll` feature including the event loop
+     * 
+     * Using {@linkcode TemplateSoa} (only with the `soa` feature):
+     * - `soa.soaHeader` structure-of-arrays mirrors
+     * 
+     * Using {@linkcode TemplateLinuxRealtime} (only with the `rt` feature):
+     * - `realtime.realtimeHeader` real-time execution profile header
+     * - `realtime.realtimeSource` real-time execution profile source code
+     * 
+     * Using {@linkcode TemplateLinuxLoadgen} (only with the `loadgen` feature):
+     * - `loadgen.loadgenSource` load generator, built as a separate executable
+     * 
+     * Using {@linkcode TemplateLinuxRecorder} (only with the `record` feature):
+     * - `recorder.recorderHeader` dataset traffic recorder header
+     * - `recorder.recorderSource` dataset traffic recorder source code
+     * 
+     * Using {@linkcode TemplateLinuxGateway} (only with the `gateway` feature):
+     * - `gateway.gatewayHeader` shared memory gateway header
+     * - `gateway.gatewaySource` shared memory gateway source code
+     * - `gateway.clientHeader`, `gateway.clientSource`, `gateway.clientCppHeader`, `gateway.clientJs` and `gateway.clientPython` client libraries for local consumers
+     * 
+     * Using {@linkcode TemplateLinuxMirror} (only with the `mirror` feature):
+     * - `mirror.mirrorHeader` latest value mirror, with the read-only accessors for other processes
+     * 
+     * Using {@linkcode TemplateLinuxMetrics} (only with the `metrics` feature):
+     * - `metrics.metricsHeader` OpenMetrics exporter header
+     * - `metrics.metricsSource` OpenMetrics exporter source code
+     * 
+     * Using {@linkcode TemplateLinuxTrace} (only with the `trace` feature):
+     * - `trace.traceHeader` processing timeline trace header
+     * - `trace.traceSource` processing timeline trace source code
+     * 
+     * Using {@linkcode TemplateProbe} (only with the `probe` feature):
+     * - `probe.probeHeader` round trip probe answering the requests of the AR library
+     * 
+     * Using {@linkcode TemplateLinuxProfile} (only with the `profile` feature):
+     * - `profile.profileHeader` change-frequency profile of the dataset members
      * 
      * @param {Datamodel} datamodel
+     * @param {TemplateFeature[]} [features] optional features to generate
      */
 
-    constructor(datamodel) {
-        super(datamodel, true);
-        this.termination = new TemplateLinuxTermination();
+    constructor(datamodel, features) {
+        super(datamodel, true, features);
+        this.eventLoop = this.features.includes("epoll");
+        this.termination = new TemplateLinuxTermination(this.eventLoop);
+        if (this.features.includes("rt")) {
+            this.realtime = new TemplateLinuxRealtime();
+        }
+        if (this.features.includes("loadgen")) {
+            this.loadgen = new TemplateLinuxLoadgen(datamodel);
+        }
         this.mainSource = {name:`${this.datamodel.typeName.toLowerCase()}.c`, contents:this._generateSource(), description:"Linux application"};
     }
 
@@ -55,9 +122,18 @@ class TemplateLinuxStaticCLib extends TemplateStaticCLib {
          * @param {ApplicationTemplate} template 
          * @param {boolean} PubSubSwap 
          * @param {string} legend 
+         * @param {string} terminationHeaderName
+         * @param {string} [realtimeHeaderName] generate the real-time execution profile using this header
+         * @param {boolean} [eventLoop] main loop built on the event loop of the termination header
+         * @param {string} [recorderHeaderName] record the dataset traffic using this header
+         * @param {string} [gatewayHeaderName] configure the shared memory gateway using this header
+         * @param {string} [metricsHeaderName] export the metrics using this header
+         * @param {string} [traceHeaderName] trace the processing timeline using this header
+         * @param {string} [profileHeaderName] profile the changes of the dataset members using this header
+         * @param {boolean} [processModes] show how to select the process mode
          * @returns 
          */
-        function generateMain(template, legend, terminationHeaderName) {
+        function generateMain(template, legend, terminationHeaderName, realtimeHeaderName, eventLoop, recorderHeaderName, gatewayHeaderName, metricsHeaderName, traceHeaderName, profileHeaderName, processModes) {
             let out = "";
             let prepend = "// ";
             if(process.env.VSCODE_DEBUG_MODE) {
@@ -67,11 +143,35 @@ class TemplateLinuxStaticCLib extends TemplateStaticCLib {
             out += `#include <unistd.h>\n`;
             out += `#include "${template.libHeaderName}"\n`
             out += `#include "${terminationHeaderName}"\n`;
+            if (realtimeHeaderName !== undefined) {
+                out += `#include "${realtimeHeaderName}"\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `#include "${recorderHeaderName}"\n`;
+            }
+            if (gatewayHeaderName !== undefined) {
+                out += `#include "${gatewayHeaderName}"\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `#include "${metricsHeaderName}"\n`;
+            }
+            if (traceHeaderName !== undefined) {
+                out += `#include "${traceHeaderName}"\n`;
+            }
             out += `#include <stdio.h>\n\n`;
         
             out += legend;
         
             out += `static ${template.datamodel.libStructName}_t *${template.datamodel.varName};\n\n`
+            if (recorderHeaderName !== undefined) {
+                out += `//configuration of the datamodel (${template.headerName.replace(".h", ".c")}), used as schema of the recording\n`;
+                out += `extern const char config_${template.datamodel.structName.toLowerCase()}[];\n\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `//the datasets in the metrics, in the order of the dataset index\n`;
+                out += TemplateLinuxMetrics.generateDatasetNames(template);
+                out += `\n`;
+            }
         
         
             out += `static void on_connected_${template.datamodel.varName}(void)\n{\n`;
@@ -101,9 +201,35 @@ class TemplateLinuxStaticCLib extends TemplateStaticCLib {
                 }
             }
         
-            out += `\nint main()\n{\n`
+            if (realtimeHeaderName !== undefined || recorderHeaderName !== undefined || gatewayHeaderName !== undefined || metricsHeaderName !== undefined || traceHeaderName !== undefined || profileHeaderName !== undefined) {
+                out += `\nint main(int argc, char **argv)\n{\n`
+            }
+            else {
+                out += `\nint main()\n{\n`
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `    //record the dataset traffic if started with --record <path>, replay a recording with --replay <path> (see ${recorderHeaderName})\n`;
+                out += `    rec_setup(argc, argv, config_${template.datamodel.structName.toLowerCase()});\n`;
+                out += `    rec_replay_setup(argc, argv, config_${template.datamodel.structName.toLowerCase()});\n\n`;
+            }
+            if (gatewayHeaderName !== undefined) {
+                out += `    //forward the datasets to local consumers in shared memory, named with --gateway-name <name> (see ${gatewayHeaderName})\n`;
+                out += `    gw_setup(argc, argv);\n\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `    //export the metrics if started with --metrics-port <port>, --metrics-socket <path> or --metrics-file <path> (see ${metricsHeaderName})\n`;
+                out += `    metrics_setup(argc, argv, "${template.datamodelInstanceName}", ${TemplateLinuxMetrics.datasetNamesArray(template)}, sizeof(${TemplateLinuxMetrics.datasetNamesArray(template)}) / sizeof(${TemplateLinuxMetrics.datasetNamesArray(template)}[0]));\n\n`;
+            }
+            if (traceHeaderName !== undefined) {
+                out += `    //trace the processing timeline if started with --trace <path>, dumped on SIGUSR1 or above --trace-threshold <us> (see ${traceHeaderName})\n`;
+                out += `    trace_setup(argc, argv);\n\n`;
+            }
             out += `    //retrieve the ${template.datamodel.varName} structure\n`;
             out += `    ${template.datamodel.varName} = ${template.datamodel.libStructName}_init();\n\n`
+            if (profileHeaderName !== undefined) {
+                out += `    //profile the changes of the dataset members if started with --profile <path>, reported at dispose() (see ${profileHeaderName})\n`;
+                out += `    ${TemplateLinuxProfile.profilePrefix(template)}_setup(${template.datamodel.varName}->profile, argc, argv);\n\n`;
+            }
             out += `    //setup callbacks\n`;
             out += `    ${template.datamodel.varName}->on_connected = on_connected_${template.datamodel.varName};\n`;
             out += `    // ${template.datamodel.varName}->on_disconnected = .. ;\n`;
@@ -115,12 +241,69 @@ class TemplateLinuxStaticCLib extends TemplateStaticCLib {
                 }
             }
             out += `\n    //connect to the server\n`;
-            out += `    ${template.datamodel.varName}->connect();\n\n`;
+            out += `    ${template.datamodel.varName}->connect();\n`;
+            if (processModes) {
+                out += `    // ${template.datamodel.varName}->set_process_mode(EXOS_PROCESS_ADAPTIVE, 500);\n`;
+            }
+            out += `\n`;
+            if (realtimeHeaderName !== undefined) {
+                out += `    //real-time execution profile, set with the command line arguments after the datamodel is connected (see ${realtimeHeaderName})\n`;
+                out += `    rt_setup(argc, argv);\n`;
+                if (!eventLoop) {
+                    out += `    if (rt_cycle_time() > 0)\n`;
+                    out += `    {\n`;
+                    out += `        //the cycles are given by the timer\n`;
+                    out += `        ${template.datamodel.varName}->set_process_mode(EXOS_PROCESS_NON_BLOCKING, 0);\n`;
+                    out += `    }\n`;
+                }
+                out += `\n`;
+            }
         
             out += `    catch_termination();\n`;
+            if (eventLoop) {
+                out += `\n`;
+                out += `    //termination, wakeups and your own file descriptors share one wait (see ${terminationHeaderName}).\n`;
+                out += `    //exOS has no file descriptor for the DMR, so process() can't be part of that wait:\n`;
+                out += `    //without a cycle, the loop waits in the blocking process() so Ctrl-C, SIGTERM, wakeups and your file descriptors wait for the next DMR cycle.\n`;
+                out += `    //with a cycle, the loop waits in epoll and processes the datamodel non-blocking on the timer, polling the DMR every cycle\n`;
+                out += `    uint32_t cycle_time = 0; //us, e.g. 1000 to process the datamodel every 1000 us\n\n`;
+                out += `    event_loop_init();\n`;
+                if (realtimeHeaderName !== undefined) {
+                    out += `    if (rt_cycle_time() > 0)\n`;
+                    out += `    {\n`;
+                    out += `        ${template.datamodel.varName}->set_process_mode(EXOS_PROCESS_NON_BLOCKING, 0);\n`;
+                    out += `        event_loop_add(rt_timer_fd(), EPOLLIN, NULL, NULL);\n`;
+                    out += `    }\n`;
+                    out += `    else if (cycle_time > 0)\n`;
+                }
+                else {
+                    out += `    if (cycle_time > 0)\n`;
+                }
+                out += `    {\n`;
+                out += `        ${template.datamodel.varName}->set_process_mode(EXOS_PROCESS_NON_BLOCKING, 0);\n`;
+                out += `        event_loop_set_cycle(cycle_time);\n`;
+                out += `    }\n`;
+                out += `    //event_loop_add(fd, EPOLLIN, on_event, NULL); //sockets, timers, inotify watches ..\n\n`;
+            }
             out += `    while (!is_terminated())\n    {\n`;
+            if (eventLoop && recorderHeaderName !== undefined) {
+                out += `        //a replay is timed by process()\n`;
+                out += `        if (!rec_replaying() && !event_loop_wait())\n`;
+                out += `            continue;\n\n`;
+            }
+            else if (eventLoop) {
+                out += `        if (!event_loop_wait())\n`;
+                out += `            continue;\n\n`;
+            }
+            if (realtimeHeaderName !== undefined) {
+                out += `        rt_wait_cycle();\n\n`;
+            }
             out += `        //trigger callbacks and synchronize with AR\n`;
             out += `        ${template.datamodel.varName}->process();\n\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `        if (rec_replay_finished())\n`;
+                out += `            break;\n\n`;
+            }
             out += `        // if (${template.datamodel.varName}->is_connected)\n`;
             out += `        // {\n`;
             for (let dataset of template.datasets) {
@@ -134,15 +317,28 @@ class TemplateLinuxStaticCLib extends TemplateStaticCLib {
         
             out += `    }\n\n`;
             out += `    //shutdown\n`;
+            if (eventLoop) {
+                out += `    event_loop_close();\n`;
+            }
+            if (realtimeHeaderName !== undefined) {
+                out += `    rt_report();\n`;
+            }
             out += `    ${template.datamodel.varName}->disconnect();\n`;
-            out += `    ${template.datamodel.varName}->dispose();\n\n`;
+            out += `    ${template.datamodel.varName}->dispose();\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `    rec_close();\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `    metrics_close();\n`;
+            }
+            out += `\n`;
             out += `    return 0;\n`
             out += `}\n`
         
             return out;
         }
 
-        return generateMain(this.template, this.staticLibraryLegend, this.termination.terminationHeader.name);
+        return generateMain(this.template, this.staticLibraryLegend, this.termination.terminationHeader.name, this.realtime != undefined ? this.realtime.realtimeHeader.name : undefined, this.eventLoop, this.recorder != undefined ? this.recorder.recorderHeader.name : undefined, this.gateway != undefined ? this.gateway.gatewayHeader.name : undefined, this.metrics != undefined ? this.metrics.metricsHeader.name : undefined, this.trace != undefined ? this.trace.traceHeader.name : undefined, this.profile != undefined ? this.profile.profileHeader.name : undefined, this.processHeaderName !== undefined);
     }
 
 }
@@ -9,7 +9,7 @@
 
 const { TemplateLinuxStaticCLib } = require("./template_linux_static_c_lib");
 const { Datamodel, GeneratedFileObj } = require('../../../datamodel');
-const { ApplicationTemplate } = require('../template');
+const { Template, ApplicationTemplate, TemplateFeature } = require('../template');
 
 
 class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
@@ -37,11 +37,17 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
      * - {@linkcode staticLibrarySource} static library source code
      * - {@linkcode staticLibraryHeader} static library header
      * 
+     * With the `process` feature, `set_process_mode()` and `process_stats` are wrapped as well
+     * 
+     * With the `record` feature, the library records the dataset traffic and replays recordings (`recorder.recorderHeader`),
+     * started from the arguments of the python script with `rec_setup_args(sys.argv)`
+     * 
      * @param {Datamodel} datamodel 
+     * @param {TemplateFeature[]} [features] optional features to generate, only `process` and `record` are used
      * 
      */
-    constructor(datamodel) {
-        super(datamodel);
+    constructor(datamodel, features) {
+        super(datamodel, Array.isArray(features) ? features.filter(feature => feature == "process" || feature == "record") : []);
 
         this.swigInclude = {name:`lib${this.datamodel.typeName.toLowerCase()}.i`, contents:this._generateSwigInclude(), description:"SWIG interface file"};
         this.pythonMain = {name:`${this.datamodel.typeName.toLowerCase()}.py`, contents:this._generatePythonMain(), description:"Main python script"};
@@ -52,9 +58,11 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
          * 
          * @param {ApplicationTemplate} template 
          * @param {string} dataTypeCodeSWIG 
+         * @param {boolean} processModes wrap the process modes
+         * @param {string} [recorderHeaderName] wrap the recording and replay of this header
          * @returns {string}
          */
-        function generateSwigInclude(template, dataTypeCodeSWIG) {
+        function generateSwigInclude(template, dataTypeCodeSWIG, processModes, recorderHeaderName) {
 
             function generateSwigArrayinfo(json) {
                 let out = ``;
@@ -142,6 +150,12 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
             out += `#include <stdbool.h>\n`;
             out += `#include "${template.headerName}"\n`;
             out += `#include "${template.libHeaderName}"\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `#include "${recorderHeaderName}"\n`;
+                out += `\n`;
+                out += `//configuration of the datamodel (${template.headerName.replace(".h", ".c")}), used as schema of the recording\n`;
+                out += `extern "C" const char config_${template.datamodel.structName.toLowerCase()}[];\n`;
+            }
             out += `%}\n`;
             out += `\n`;
         
@@ -154,12 +168,18 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
             out += `{\n`;
             out += `    virtual void on_connected(void) {}\n`;
             out += `    virtual void on_disconnected(void) {}\n`;
-            out += `    virtual void on_operational(void) {}\n\n`;
+            out += `    virtual void on_operational(void) {}\n`;
+            out += `    virtual void on_sync_change(void) {}\n\n`;
             for (let dataset of template.datasets) {
                 if (dataset.isSub) {
                     out += `    virtual void on_change_${dataset.structName}() {}\n`;
                 }
             }
+            for (let group of template.groups) {
+                if (group.isSub) {
+                    out += `    virtual void on_group_change_${group.name}() {}\n`;
+                }
+            }
             out += `\n`;
             out += `    virtual ~${template.datamodel.dataType}EventHandler() {}\n`;
             out += `    ${template.datamodel.libStructName}_t *${template.datamodel.varName};\n`;
@@ -182,6 +202,10 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
             out += `{\n`;
             out += `    p${template.datamodel.dataType}EventHandler->on_operational();\n`;
             out += `}\n\n`;
+            out += `static void ${template.datamodel.libStructName}_on_sync_change()\n`;
+            out += `{\n`;
+            out += `    p${template.datamodel.dataType}EventHandler->on_sync_change();\n`;
+            out += `}\n\n`;
         
             for (let dataset of template.datasets) {
                 if (dataset.isSub) {
@@ -191,6 +215,14 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
                     out += `}\n`;
                 }
             }
+            for (let group of template.groups) {
+                if (group.isSub) {
+                    out += `static void ${template.datamodel.libStructName}_on_group_change_${group.name}()\n`;
+                    out += `{\n`;
+                    out += `    p${template.datamodel.dataType}EventHandler->on_group_change_${group.name}();\n`;
+                    out += `}\n`;
+                }
+            }
             out += `%}\n`;
             out += `\n`;
             out += `%inline %{\n`;
@@ -201,12 +233,18 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
             out += `    ${template.datamodel.varName}->on_connected = &${template.datamodel.libStructName}_on_connected;\n`;
             out += `    ${template.datamodel.varName}->on_disconnected = &${template.datamodel.libStructName}_on_disconnected;\n`;
             out += `    ${template.datamodel.varName}->on_operational = &${template.datamodel.libStructName}_on_operational;\n`;
+            out += `    ${template.datamodel.varName}->on_sync_change = &${template.datamodel.libStructName}_on_sync_change;\n`;
             out += `    \n`;
             for (let dataset of template.datasets) {
                 if (dataset.isSub) {
                     out += `    ${template.datamodel.varName}->${dataset.structName}.on_change = &${template.datamodel.libStructName}_on_change_${dataset.structName};\n`;
                 }
             }
+            for (let group of template.groups) {
+                if (group.isSub) {
+                    out += `    ${template.datamodel.varName}->${group.name}.on_group_change = &${template.datamodel.libStructName}_on_group_change_${group.name};\n`;
+                }
+            }
             out += `    \n`;
             out += `    p${template.datamodel.dataType}EventHandler->${template.datamodel.varName} = ${template.datamodel.varName};\n`;
             out += `    handler = NULL;\n`;
@@ -239,6 +277,56 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
                 } while ((idx=headerStructs.indexOf("<sai>")) > 0)
             }
             out += headerStructs; // Output the rest of the structs after handling sai
+
+            if (processModes) {
+                out += `/* process modes, see set_process_mode() */\n`;
+                out += `typedef enum exos_process_mode\n`;
+                out += `{\n`;
+                out += `    EXOS_PROCESS_BLOCKING,\n`;
+                out += `    EXOS_PROCESS_NON_BLOCKING,\n`;
+                out += `    EXOS_PROCESS_ADAPTIVE\n`;
+                out += `} exos_process_mode_t;\n\n`;
+                out += `%immutable;\n`;
+                out += `typedef struct exos_process_stats\n`;
+                out += `{\n`;
+                out += `    uint32_t cycles;\n`;
+                out += `    uint32_t blocked;\n`;
+                out += `    uint32_t updates;\n`;
+                out += `    uint64_t cpu_time;\n`;
+                out += `    uint64_t wall_time;\n`;
+                out += `    double cpu_load;\n`;
+                out += `    double latency_avg;\n`;
+                out += `    int32_t latency_max;\n`;
+                out += `} exos_process_stats_t;\n`;
+                out += `%mutable;\n\n`;
+            }
+
+            if (Template.qosDatasets(template.datasets).length > 0) {
+                out += `/* quality of service state, only the members that can be changed at runtime are exposed */\n`;
+                out += `typedef struct exos_qos_filter\n`;
+                out += `{\n`;
+                out += `    double deadband;\n`;
+                out += `    bool relative;\n`;
+                out += `    double hysteresis;\n`;
+                out += `} exos_qos_filter_t;\n\n`;
+                out += `typedef struct exos_qos\n`;
+                out += `{\n`;
+                out += `    int32_t rate;\n`;
+                out += `    bool latest;\n`;
+                out += `    exos_qos_filter_t filter;\n`;
+                out += `    uint32_t suppressed;\n`;
+                out += `} exos_qos_t;\n\n`;
+                for (let dataset of Template.qosDatasets(template.datasets)) {
+                    if (dataset.qos.filters.length > 0) {
+                        out += `typedef struct ${Template.qosDeadbandPrefix(template, dataset)}\n`;
+                        out += `{\n`;
+                        for (let filter of dataset.qos.filters) {
+                            out += `    exos_qos_filter_t ${filter.name};\n`;
+                        }
+                        out += `} ${Template.qosDeadbandPrefix(template, dataset)}_t;\n\n`;
+                    }
+                }
+            }
         
             for (let dataset of template.datasets) {
                 if (dataset.isSub || dataset.isPub ) {
@@ -263,6 +351,12 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
                         out += `    void on_change(void);\n`;
                         out += `    int32_t nettime;\n`;
                     }
+                    if (dataset.qos !== undefined) {
+                        out += `    exos_qos_t qos;\n`;
+                        if (dataset.qos.filters.length > 0) {
+                            out += `    ${Template.qosDeadbandPrefix(template, dataset)}_t deadband;\n`;
+                        }
+                    }
                     if (dataset.arraySize > 0) {
                         out += `    // array not exposed directly:`;
                     }
@@ -284,6 +378,33 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
                 }
             }
         
+            if (template.groups.length > 0) {
+                out += `/* publish group state, the members are read in on_group_change */\n`;
+                out += `%immutable;\n`;
+                out += `typedef struct exos_group\n`;
+                out += `{\n`;
+                out += `    uint32_t sequence;\n`;
+                out += `    uint32_t complete;\n`;
+                out += `    uint32_t incomplete;\n`;
+                out += `    uint32_t skipped;\n`;
+                out += `} exos_group_t;\n`;
+                out += `%mutable;\n\n`;
+                for (let group of template.groups) {
+                    out += `typedef struct ${template.datamodel.libStructName}${group.name}_group\n`;
+                    out += `{\n`;
+                    if (group.isPub) {
+                        out += `    void publish(void);\n`;
+                    }
+                    else {
+                        out += `    void on_group_change(void);\n`;
+                    }
+                    out += `%immutable;\n`;
+                    out += `    exos_group_t state;\n`;
+                    out += `%mutable;\n`;
+                    out += `} ${template.datamodel.libStructName}${group.name}_group_t;\n\n`;
+                }
+            }
+        
             out += `typedef struct ${template.datamodel.libStructName}_log\n`;
             out += `{\n`;
             out += `    void error(char *log_entry);\n`;
@@ -302,32 +423,90 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
             out += `    void set_operational(void);\n`;
             out += `    void dispose(void);\n`;
             out += `    int32_t get_nettime(void);\n`;
+            if (processModes) {
+                out += `    void set_process_mode(exos_process_mode_t mode, uint32_t spin_window);\n`;
+            }
             out += `    ${template.datamodel.libStructName}_log_t log;\n`;
             out += `    void on_connected(void);\n`;
             out += `    void on_disconnected(void);\n`;
             out += `    void on_operational(void);\n`;
+            out += `    void on_sync_change(void);\n`;
             out += `    bool is_connected;\n`;
             out += `    bool is_operational;\n`;
+            out += `%immutable;\n`;
+            out += `    bool is_in_sync;\n`;
+            out += `    uint32_t missed_dmr_cycles;\n`;
+            out += `    uint32_t missed_ar_cycles;\n`;
+            out += `    int process_mode;\n`;
+            out += `    uint32_t sync_changes;\n`;
+            out += `    int32_t sync_changed_nettime;\n`;
+            if (processModes) {
+                out += `    exos_process_stats_t process_stats;\n`;
+            }
+            out += `%mutable;\n`;
             for (let dataset of template.datasets) {
                 if (dataset.isPub || dataset.isSub) {
                     out += `    ${dataset.libDataType}_t ${dataset.structName};\n`;
                 }
             }
+            for (let group of template.groups) {
+                out += `    ${template.datamodel.libStructName}${group.name}_group_t ${group.name};\n`;
+            }
             out += `} ${template.datamodel.libStructName}_t;\n\n`;
         
             out += `${template.datamodel.libStructName}_t *${template.datamodel.libStructName}_init(void);\n`;
+
+            if (recorderHeaderName !== undefined) {
+                out += `\n`;
+                out += `/* record the dataset traffic if started with --record <path>, replay a recording with --replay <path> (see ${recorderHeaderName}),\n`;
+                out += `   the arguments are passed as a list of strings, i.e. sys.argv */\n`;
+                out += `%typemap(in) (int argc, char **argv) {\n`;
+                out += `    if (!PyList_Check($input)) {\n`;
+                out += `        PyErr_SetString(PyExc_TypeError, "expecting a list of strings");\n`;
+                out += `        SWIG_fail;\n`;
+                out += `    }\n`;
+                out += `    $1 = (int)PyList_Size($input);\n`;
+                out += `    $2 = (char **)calloc($1 + 1, sizeof(char *));\n`;
+                out += `    for (int i = 0; i < $1; i++) {\n`;
+                out += `        PyObject *arg = PyList_GetItem($input, i);\n`;
+                out += `        if (!PyUnicode_Check(arg)) {\n`;
+                out += `            PyErr_SetString(PyExc_TypeError, "expecting a list of strings");\n`;
+                out += `            SWIG_fail;\n`;
+                out += `        }\n`;
+                out += `        $2[i] = (char *)PyUnicode_AsUTF8(arg);\n`;
+                out += `    }\n`;
+                out += `}\n`;
+                out += `// also called after SWIG_fail, with argv 0 if it was not allocated\n`;
+                out += `%typemap(freearg) (int argc, char **argv) {\n`;
+                out += `    free($2);\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `%inline %{\n`;
+                out += `void rec_setup_args(int argc, char **argv)\n`;
+                out += `{\n`;
+                out += `    rec_setup(argc, argv, config_${template.datamodel.structName.toLowerCase()});\n`;
+                out += `    rec_replay_setup(argc, argv, config_${template.datamodel.structName.toLowerCase()});\n`;
+                out += `}\n`;
+                out += `%}\n`;
+                out += `\n`;
+                out += `bool rec_replaying(void);\n`;
+                out += `bool rec_replay_finished(void);\n`;
+                out += `void rec_close(void);\n`;
+            }
         
             return out;
         }
 
-        return generateSwigInclude(this.template, this.datamodel.dataTypeCodeSWIG);
+        return generateSwigInclude(this.template, this.datamodel.dataTypeCodeSWIG, this.processHeaderName !== undefined, this.recorder !== undefined ? this.recorder.recorderHeader.name : undefined);
     }
 
     _generatePythonMain() {
         /**
          * @param {ApplicationTemplate} template 
+         * @param {boolean} processModes describe the process modes
+         * @param {string} [recorderHeaderName] record and replay with the arguments, see this header
          */
-        function generatePythonMain(template) {
+        function generatePythonMain(template, processModes, recorderHeaderName) {
 
             /**
              * @param {ApplicationTemplate} template 
@@ -349,13 +528,43 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
                 out += `    ${template.datamodel.varName}.set_operational()\n`;
                 out += `    ${template.datamodel.varName}.dispose()\n`;
                 out += `    ${template.datamodel.varName}.get_nettime() : (int32_t) get current nettime\n`;
+                if (processModes) {
+                    out += `    ${template.datamodel.varName}.set_process_mode(mode, spin_window) : set how process() waits for the DMR, see process modes\n`;
+                }
                 out += `\ndef user callbacks in class ${template.datamodel.dataType}EventHandler:\n`
                 out += `    on_connected\n`;
                 out += `    on_disconnected\n`;
                 out += `    on_operational\n`;
+                out += `    on_sync_change\n`;
                 out += `\nboolean values:\n`
                 out += `    ${template.datamodel.varName}.is_connected\n`;
                 out += `    ${template.datamodel.varName}.is_operational\n`;
+                out += `\nsync diagnostics (read-only, updated in process() and before on_sync_change):\n`
+                out += `    ${template.datamodel.varName}.is_in_sync : (bool) datamodel is in sync with the DMR\n`;
+                out += `    ${template.datamodel.varName}.missed_dmr_cycles : (uint32_t) cycles missed by the DMR\n`;
+                out += `    ${template.datamodel.varName}.missed_ar_cycles : (uint32_t) cycles missed by AR\n`;
+                out += `    ${template.datamodel.varName}.process_mode : (int) 0 = blocking, 1 = non-blocking\n`;
+                out += `    ${template.datamodel.varName}.sync_changes : (uint32_t) number of sync state changes\n`;
+                out += `    ${template.datamodel.varName}.sync_changed_nettime : (int32_t) nettime of the last sync state change\n`;
+                if (processModes) {
+                    out += `\nprocess modes:\n`
+                    out += `    ${template.datamodel.libStructName}.EXOS_PROCESS_BLOCKING : process() waits for the next DMR cycle (default)\n`;
+                    out += `    ${template.datamodel.libStructName}.EXOS_PROCESS_NON_BLOCKING : process() returns immediately, lowest latency at full CPU load\n`;
+                    out += `    ${template.datamodel.libStructName}.EXOS_PROCESS_ADAPTIVE : process() returns immediately for spin_window (us) after a DMR cycle, then waits\n`;
+                    out += `    ${template.datamodel.varName}.process_stats.cycles, .blocked, .updates : (uint32_t) process() calls, calls that waited and received updates\n`;
+                    out += `    ${template.datamodel.varName}.process_stats.cpu_time, .wall_time : (uint64_t) CPU and wall time (us) since the mode was set\n`;
+                    out += `    ${template.datamodel.varName}.process_stats.cpu_load : (double) CPU use (percent) of the thread calling process()\n`;
+                    out += `    ${template.datamodel.varName}.process_stats.latency_avg, .latency_max : delivery latency (us) of received datasets\n`;
+                }
+                if (recorderHeaderName !== undefined) {
+                    out += `\nrecording and replay (see ${recorderHeaderName}):\n`
+                    out += `    ${template.datamodel.libStructName}.rec_setup_args(sys.argv) : record with --record <path>, or replay with --replay <path> instead of connecting to the DMR\n`;
+                    out += `        --replay-speed <factor> : 1 original timing (default), 0 as fast as possible, --replay-step <us> : nettime per process()\n`;
+                    out += `        during a replay, process() calls the on_change callbacks with the recorded values, and publish() does not send\n`;
+                    out += `    ${template.datamodel.libStructName}.rec_replaying() : (bool) replaying instead of connected to the DMR\n`;
+                    out += `    ${template.datamodel.libStructName}.rec_replay_finished() : (bool) end of the recording reached\n`;
+                    out += `    ${template.datamodel.libStructName}.rec_close() : close the recording and the replay, and print the statistics\n`;
+                }
                 out += `\nlogging methods:\n`
                 out += `    ${template.datamodel.varName}.log.error(str)\n`;
                 out += `    ${template.datamodel.varName}.log.warning(str)\n`;
@@ -374,6 +583,15 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
                             out += `    ${template.datamodel.dataType}EventHandler:on_change_${dataset.structName} : void(void) user callback function\n`;
                             out += `    ${template.datamodel.varName}.${dataset.structName}.nettime : (int32_t) nettime @ time of publish\n`;
                         }
+                        if (Template.qosHasDeadband(dataset)) {
+                            if (dataset.qos.deadband > 0) {
+                                out += `    ${template.datamodel.varName}.${dataset.structName}.qos.filter.deadband, .relative, .hysteresis : deadband of the value, can be changed at runtime\n`;
+                            }
+                            if (dataset.qos.filters.length > 0) {
+                                out += `    ${template.datamodel.varName}.${dataset.structName}.deadband.${dataset.qos.filters[0].name}.deadband, .relative, .hysteresis : member deadbands, can be changed at runtime\n`;
+                            }
+                            out += `    ${template.datamodel.varName}.${dataset.structName}.qos.suppressed : (uint32_t) number of updates not delivered because of a deadband\n`;
+                        }
                         out += `    ${template.datamodel.varName}.${dataset.structName}.value : (${Datamodel.convertPlcType(dataset.dataType)}`;
                         if (dataset.arraySize > 0) { // array comes before string length in c (unlike AS typ editor where it would be: STRING[80][0..1])
                             out += `[${parseInt(dataset.arraySize)}]`;
@@ -390,7 +608,25 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
                         else {
                             out += `s\n`;
                         }
+                        let group = Template.datasetGroup(template, dataset);
+                        if (group !== undefined) {
+                            out += `    ${group.tag === dataset ? "sequence number" : "member"} of publish group ${group.name}\n`;
+                        }
+                    }
+                }
+                for (let group of template.groups) {
+                    out += `\npublish group ${group.name} (${group.members.map(member => member.structName).join(", ")}):\n`;
+                    if (group.isPub) {
+                        out += `    ${template.datamodel.varName}.${group.name}.publish() : publish all members, then the next sequence number in ${group.tag.structName}\n`;
+                    }
+                    else {
+                        out += `    ${template.datamodel.dataType}EventHandler:on_group_change_${group.name} : void(void) user callback function, called once all members of a publish were received.\n`;
+                        out += `        The member values read in the callback belong to the same publish.\n`;
+                        out += `        The on_change callbacks of the members are held back and called after it\n`;
+                        out += `    ${template.datamodel.varName}.${group.name}.state.incomplete : (uint32_t) groups not delivered because a member was missing\n`;
+                        out += `    ${template.datamodel.varName}.${group.name}.state.skipped : (uint32_t) sequence numbers that were never received\n`;
                     }
+                    out += `    ${template.datamodel.varName}.${group.name}.state.complete : (uint32_t) number of ${group.isPub ? "published" : "delivered"} groups\n`;
                 }
                 out += `"""\n\n`;
             
@@ -402,7 +638,7 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
         
             out += `# Use import and sys.path.insert if this .py file is moved.\n`;
             out += `# The path should point to the directory containing _${template.datamodel.libStructName}.so\n`;
-            out += `${prepend}import sys\n`;
+            out += `${recorderHeaderName !== undefined ? "" : prepend}import sys\n`;
             out += `${prepend}sys.path.insert(1, '${template.datamodel.dataType}/Linux/build')\n`;
             out += `import ${template.datamodel.libStructName}\n\n`;
         
@@ -422,6 +658,9 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
             out += `    # def on_operational(self):\n`;
             out += `    #     self.${template.datamodel.varName}. ..\n`;
             out += `\n`;
+            out += `    # def on_sync_change(self):\n`;
+            out += `    #     self.${template.datamodel.varName}.is_in_sync ..\n`;
+            out += `\n`;
             for (let dataset of template.datasets) {
                 if (dataset.isSub) {
                     out += `    def on_change_${dataset.structName}(self):\n`;
@@ -446,7 +685,19 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
                     out += "    \n";
                 }
             }
+            for (let group of template.groups) {
+                if (group.isSub) {
+                    out += `    # def on_group_change_${group.name}(self):\n`;
+                    out += `    #     self.${template.datamodel.varName}.${group.members[0].structName}.value .. (sequence self.${template.datamodel.varName}.${group.tag.structName}.value)\n`;
+                    out += `\n`;
+                }
+            }
             out += `\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `# record the dataset traffic if started with --record <path>, replay a recording with --replay <path> (see ${recorderHeaderName})\n`;
+                out += `${template.datamodel.libStructName}.rec_setup_args(sys.argv)\n`;
+                out += `\n`;
+            }
             out += `${template.datamodel.varName} = ${template.datamodel.libStructName}.${template.datamodel.libStructName}_init()\n`;
             out += `\n`;
             out += `handler = ${template.datamodel.dataType}EventHandler()\n`;
@@ -454,8 +705,15 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
             out += `\n`;
             out += `try:\n`;
             out += `    ${template.datamodel.varName}.connect()\n`;
+            if (processModes) {
+                out += `    # ${template.datamodel.varName}.set_process_mode(${template.datamodel.libStructName}.EXOS_PROCESS_ADAPTIVE, 500)\n`;
+            }
             out += `    while True:\n`;
             out += `        ${template.datamodel.varName}.process()\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `        if ${template.datamodel.libStructName}.rec_replay_finished():\n`;
+                out += `            break\n`;
+            }
             out += `        # if ${template.datamodel.varName}.is_connected:\n`;
         
             for (let dataset of template.datasets) {
@@ -470,12 +728,15 @@ class TemplateLinuxSWIG extends TemplateLinuxStaticCLib {
             out += `\n`;
             out += `${template.datamodel.varName}.disconnect()\n`;
             out += `${template.datamodel.varName}.dispose()\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `${template.datamodel.libStructName}.rec_close()\n`;
+            }
             out += `\n`;
         
             return out;
         }
 
-        return generatePythonMain(this.template);
+        return generatePythonMain(this.template, this.processHeaderName !== undefined, this.recorder !== undefined ? this.recorder.recorderHeader.name : undefined);
     }
 }
 
@@ -22,21 +22,39 @@ class TemplateLinuxTermination {
      * @type {GeneratedFileObj}
      */
     terminationSource;
+
+    /**
+     * generate the epoll based event loop (`epoll` feature)
+     * @type {boolean}
+     */
+    eventLoop;
     
     /**
      * {@linkcode TemplateLinuxTermination} Generate code for handling Ctrl-C in Linux appliactions
      * 
+     * With `eventLoop`, the files also contain an epoll based main loop, where termination (signalfd), wakeups from other threads (eventfd),
+     * an optional processing cycle (timerfd) and file descriptors registered by the application share one wait, without extra threads.
+     * exOS has no file descriptor for the DMR, so without a cycle the loop only dispatches the ready events and the application
+     * waits in the blocking processing of the datamodel instead of a polling timeout.
+     * 
      * Generates following {@link GeneratedFileObj} objects
      * - {@linkcode terminationHeader}
      * - {@linkcode terminationSource}
+     * 
+     * @param {boolean} [eventLoop] generate the epoll based event loop
      */
-    constructor() {
+    constructor(eventLoop) {
+        this.eventLoop = eventLoop === true;
         this.terminationHeader = {name:"termination.h", contents:this._generateTerminationHeader(), description:"Handling for Ctrl-C header"};
         this.terminationSource = {name:"termination.c", contents:this._generateTerminationSource(), description:"Handling for Ctrl-C source"};
     }
 
     _generateTerminationHeader() {
-        function generateTerminationHeader() {
+        /**
+         * @param {boolean} eventLoop 
+         * @returns {string}
+         */
+        function generateTerminationHeader(eventLoop) {
             let out = "";
         
             out += `#ifndef _TERMINATION_H_\n`;
@@ -51,6 +69,45 @@ class TemplateLinuxTermination {
             out += `void catch_termination();\n`;
             out += `bool is_terminated();\n`;
             out += `\n`;
+            if (eventLoop) {
+                out += `#include <stdint.h>\n`;
+                out += `#include <sys/epoll.h>\n`;
+                out += `\n`;
+                out += `/* epoll based main loop: termination signals (signalfd), wakeups (eventfd), the processing cycle (timerfd)\n`;
+                out += `   and the file descriptors added with event_loop_add() share one wait.\n`;
+                out += `\n`;
+                out += `   exOS has no file descriptor for the DMR, so the datamodel can only be part of the wait with a cycle, where it is\n`;
+                out += `   processed non-blocking. Without a cycle (no timer and no cycle source), event_loop_wait() does not wait: it dispatches\n`;
+                out += `   the events that are ready and returns true, and the caller waits in the blocking processing of the datamodel.\n`;
+                out += `   Events and wakeups are then handled after the next DMR cycle.\n`;
+                out += `\n`;
+                out += `   event_loop_init() blocks SIGINT, SIGTERM and SIGQUIT for the calling thread and the threads it creates afterwards,\n`;
+                out += `   and receives them via signalfd. Signals delivered to other threads still terminate via catch_termination(),\n`;
+                out += `   which wakes up the loop as well.\n`;
+                out += `*/\n`;
+                out += `typedef void (*event_loop_callback_t)(int fd, uint32_t events, void *context);\n`;
+                out += `\n`;
+                out += `bool event_loop_init();\n`;
+                out += `\n`;
+                out += `/* cycle time (us) of the processing timer, 0 to stop it */\n`;
+                out += `bool event_loop_set_cycle(uint32_t cycle_time);\n`;
+                out += `\n`;
+                out += `/* callback is called from event_loop_wait() with the epoll events (EPOLLIN, ..) of fd.\n`;
+                out += `   With callback NULL, fd is an external cycle source: event_loop_wait() returns true when it is readable,\n`;
+                out += `   and the caller reads it */\n`;
+                out += `bool event_loop_add(int fd, uint32_t events, event_loop_callback_t callback, void *context);\n`;
+                out += `bool event_loop_remove(int fd);\n`;
+                out += `\n`;
+                out += `/* wake up event_loop_wait(), can be called from any thread and from signal handlers */\n`;
+                out += `void event_loop_wakeup();\n`;
+                out += `\n`;
+                out += `/* wait for and dispatch the events, returns true when the next processing cycle is due.\n`;
+                out += `   Without a cycle, only dispatches the ready events and returns true */\n`;
+                out += `bool event_loop_wait();\n`;
+                out += `\n`;
+                out += `void event_loop_close();\n`;
+                out += `\n`;
+            }
             out += `#ifdef __cplusplus\n`;
             out += `}\n`;
             out += `#endif\n`;
@@ -59,11 +116,15 @@ class TemplateLinuxTermination {
         
             return out;
         }
-        return generateTerminationHeader();
+        return generateTerminationHeader(this.eventLoop);
     }
 
     _generateTerminationSource() {
-        function generateTerminationSource() {
+        /**
+         * @param {boolean} eventLoop 
+         * @returns {string}
+         */
+        function generateTerminationSource(eventLoop) {
             let out = "";
         
             out += `#include "termination.h"\n`;
@@ -72,9 +133,32 @@ class TemplateLinuxTermination {
             out += `#include <signal.h>\n`;
             out += `#include <stdlib.h>\n`;
             out += `#include <unistd.h>\n`;
+            if (eventLoop) {
+                out += `#include <sys/signalfd.h>\n`;
+                out += `#include <sys/eventfd.h>\n`;
+                out += `#include <sys/timerfd.h>\n`;
+            }
             out += `\n`;
             out += `static bool terminate_process = false;\n`;
             out += `\n`;
+            if (eventLoop) {
+                out += `#define EVENT_LOOP_MAX_FDS 32\n`;
+                out += `\n`;
+                out += `typedef struct event_loop_fd\n`;
+                out += `{\n`;
+                out += `    int fd;\n`;
+                out += `    event_loop_callback_t callback;\n`;
+                out += `    void *context;\n`;
+                out += `} event_loop_fd_t;\n`;
+                out += `\n`;
+                out += `static int epoll_fd = -1;\n`;
+                out += `static int signal_fd = -1;\n`;
+                out += `static int event_fd = -1;\n`;
+                out += `static int cycle_fd = -1;\n`;
+                out += `static uint32_t cycle_time_us = 0;\n`;
+                out += `static event_loop_fd_t fds[EVENT_LOOP_MAX_FDS];\n`;
+                out += `\n`;
+            }
             out += `bool is_terminated()\n`;
             out += `{\n`;
             out += `    return terminate_process;\n`;
@@ -101,6 +185,9 @@ class TemplateLinuxTermination {
             out += `    case SIGTERM:\n`;
             out += `    case SIGQUIT:\n`;
             out += `        terminate_process = true;\n`;
+            if (eventLoop) {
+                out += `        event_loop_wakeup();\n`;
+            }
             out += `        break;\n`;
             out += `\n`;
             out += `    default:\n`;
@@ -129,10 +216,193 @@ class TemplateLinuxTermination {
             out += `    // Print backtrace to stderr and exit() on segfault\n`;
             out += `	signal(SIGSEGV, handle_segfault); \n`;
             out += `}\n`;
+
+            if (eventLoop) {
+                out += `\n`;
+                out += `static event_loop_fd_t *add_fd(int fd, uint32_t events, event_loop_callback_t callback, void *context)\n`;
+                out += `{\n`;
+                out += `    for (int i = 0; i < EVENT_LOOP_MAX_FDS; i++)\n`;
+                out += `    {\n`;
+                out += `        if (fds[i].fd < 0)\n`;
+                out += `        {\n`;
+                out += `            struct epoll_event event = {.events = events, .data.ptr = &fds[i]};\n`;
+                out += `\n`;
+                out += `            if (0 != epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event))\n`;
+                out += `                return NULL;\n`;
+                out += `            fds[i].fd = fd;\n`;
+                out += `            fds[i].callback = callback;\n`;
+                out += `            fds[i].context = context;\n`;
+                out += `            return &fds[i];\n`;
+                out += `        }\n`;
+                out += `    }\n`;
+                out += `    fprintf(stderr, "event_loop: more than %d file descriptors\\n", EVENT_LOOP_MAX_FDS);\n`;
+                out += `    return NULL;\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `bool event_loop_init()\n`;
+                out += `{\n`;
+                out += `    sigset_t signals;\n`;
+                out += `\n`;
+                out += `    for (int i = 0; i < EVENT_LOOP_MAX_FDS; i++)\n`;
+                out += `        fds[i].fd = -1;\n`;
+                out += `\n`;
+                out += `    sigemptyset(&signals);\n`;
+                out += `    sigaddset(&signals, SIGINT);\n`;
+                out += `    sigaddset(&signals, SIGTERM);\n`;
+                out += `    sigaddset(&signals, SIGQUIT);\n`;
+                out += `\n`;
+                out += `    epoll_fd = epoll_create1(EPOLL_CLOEXEC);\n`;
+                out += `    event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);\n`;
+                out += `    signal_fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);\n`;
+                out += `    if (epoll_fd < 0 || event_fd < 0 || signal_fd < 0 || 0 != pthread_sigmask(SIG_BLOCK, &signals, NULL) ||\n`;
+                out += `        NULL == add_fd(event_fd, EPOLLIN, NULL, NULL) || NULL == add_fd(signal_fd, EPOLLIN, NULL, NULL))\n`;
+                out += `    {\n`;
+                out += `        perror("event_loop: init failed");\n`;
+                out += `        event_loop_close();\n`;
+                out += `        return false;\n`;
+                out += `    }\n`;
+                out += `    return true;\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `bool event_loop_set_cycle(uint32_t cycle_time)\n`;
+                out += `{\n`;
+                out += `    struct itimerspec spec = {};\n`;
+                out += `\n`;
+                out += `    cycle_time_us = cycle_time;\n`;
+                out += `    if (epoll_fd < 0)\n`;
+                out += `        return false;\n`;
+                out += `\n`;
+                out += `    if (cycle_fd < 0)\n`;
+                out += `    {\n`;
+                out += `        cycle_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);\n`;
+                out += `        if (cycle_fd < 0 || NULL == add_fd(cycle_fd, EPOLLIN, NULL, NULL))\n`;
+                out += `        {\n`;
+                out += `            perror("event_loop: cycle timer failed");\n`;
+                out += `            return false;\n`;
+                out += `        }\n`;
+                out += `    }\n`;
+                out += `\n`;
+                out += `    spec.it_value.tv_sec = cycle_time / 1000000;\n`;
+                out += `    spec.it_value.tv_nsec = (cycle_time % 1000000) * 1000;\n`;
+                out += `    spec.it_interval = spec.it_value;\n`;
+                out += `    return 0 == timerfd_settime(cycle_fd, 0, &spec, NULL);\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `bool event_loop_add(int fd, uint32_t events, event_loop_callback_t callback, void *context)\n`;
+                out += `{\n`;
+                out += `    if (epoll_fd < 0)\n`;
+                out += `        return false;\n`;
+                out += `    return NULL != add_fd(fd, events, callback, context);\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `bool event_loop_remove(int fd)\n`;
+                out += `{\n`;
+                out += `    for (int i = 0; i < EVENT_LOOP_MAX_FDS; i++)\n`;
+                out += `    {\n`;
+                out += `        if (fds[i].fd == fd)\n`;
+                out += `        {\n`;
+                out += `            // events of this fd that are already collected in event_loop_wait() are skipped\n`;
+                out += `            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);\n`;
+                out += `            fds[i].fd = -1;\n`;
+                out += `            return true;\n`;
+                out += `        }\n`;
+                out += `    }\n`;
+                out += `    return false;\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `void event_loop_wakeup()\n`;
+                out += `{\n`;
+                out += `    uint64_t one = 1;\n`;
+                out += `\n`;
+                out += `    if (event_fd >= 0 && sizeof(one) != write(event_fd, &one, sizeof(one)))\n`;
+                out += `        return; // counter overflow, the loop is woken up anyway\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `static bool has_cycle()\n`;
+                out += `{\n`;
+                out += `    if (cycle_time_us > 0)\n`;
+                out += `        return true;\n`;
+                out += `\n`;
+                out += `    for (int i = 0; i < EVENT_LOOP_MAX_FDS; i++)\n`;
+                out += `    {\n`;
+                out += `        if (fds[i].fd >= 0 && NULL == fds[i].callback && fds[i].fd != signal_fd && fds[i].fd != event_fd && fds[i].fd != cycle_fd)\n`;
+                out += `            return true;\n`;
+                out += `    }\n`;
+                out += `    return false;\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `bool event_loop_wait()\n`;
+                out += `{\n`;
+                out += `    struct epoll_event events[EVENT_LOOP_MAX_FDS];\n`;
+                out += `    bool cycle = !has_cycle();\n`;
+                out += `    int count;\n`;
+                out += `\n`;
+                out += `    if (epoll_fd < 0)\n`;
+                out += `    {\n`;
+                out += `        // no event loop, fall back to a sleeping cycle or to the blocking processing of the caller\n`;
+                out += `        if (cycle_time_us > 0)\n`;
+                out += `            usleep(cycle_time_us);\n`;
+                out += `        return !terminate_process;\n`;
+                out += `    }\n`;
+                out += `\n`;
+                out += `    // without a cycle, the caller waits for the DMR, so only the ready events are dispatched\n`;
+                out += `    count = epoll_wait(epoll_fd, events, EVENT_LOOP_MAX_FDS, cycle ? 0 : -1);\n`;
+                out += `    for (int i = 0; i < count; i++)\n`;
+                out += `    {\n`;
+                out += `        event_loop_fd_t *entry = (event_loop_fd_t *)events[i].data.ptr;\n`;
+                out += `        uint64_t value;\n`;
+                out += `\n`;
+                out += `        if (entry->fd < 0)\n`;
+                out += `        {\n`;
+                out += `            continue;\n`;
+                out += `        }\n`;
+                out += `        else if (entry->fd == signal_fd)\n`;
+                out += `        {\n`;
+                out += `            struct signalfd_siginfo info;\n`;
+                out += `            if (sizeof(info) == read(signal_fd, &info, sizeof(info)))\n`;
+                out += `                terminate_process = true;\n`;
+                out += `        }\n`;
+                out += `        else if (entry->fd == event_fd)\n`;
+                out += `        {\n`;
+                out += `            if (sizeof(value) != read(event_fd, &value, sizeof(value)))\n`;
+                out += `                continue;\n`;
+                out += `        }\n`;
+                out += `        else if (entry->fd == cycle_fd)\n`;
+                out += `        {\n`;
+                out += `            // expirations missed while processing are merged into this cycle\n`;
+                out += `            if (sizeof(value) == read(cycle_fd, &value, sizeof(value)))\n`;
+                out += `                cycle = true;\n`;
+                out += `        }\n`;
+                out += `        else if (NULL == entry->callback)\n`;
+                out += `        {\n`;
+                out += `            cycle = true;\n`;
+                out += `        }\n`;
+                out += `        else\n`;
+                out += `        {\n`;
+                out += `            entry->callback(entry->fd, events[i].events, entry->context);\n`;
+                out += `        }\n`;
+                out += `    }\n`;
+                out += `    return cycle && !terminate_process;\n`;
+                out += `}\n`;
+                out += `\n`;
+                out += `void event_loop_close()\n`;
+                out += `{\n`;
+                out += `    int *internal[] = {&cycle_fd, &signal_fd, &event_fd, &epoll_fd};\n`;
+                out += `\n`;
+                out += `    for (int i = 0; i < EVENT_LOOP_MAX_FDS; i++)\n`;
+                out += `        fds[i].fd = -1;\n`;
+                out += `    for (size_t i = 0; i < sizeof(internal) / sizeof(internal[0]); i++)\n`;
+                out += `    {\n`;
+                out += `        if (*internal[i] >= 0)\n`;
+                out += `            close(*internal[i]);\n`;
+                out += `        *internal[i] = -1;\n`;
+                out += `    }\n`;
+                out += `}\n`;
+            }
         
             return out;
         }
-        return generateTerminationSource();
+        return generateTerminationSource(this.eventLoop);
     }
 }
 
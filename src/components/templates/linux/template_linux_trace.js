@@ -0,0 +1,406 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const {GeneratedFileObj} = require('../../../datamodel')
+
+class TemplateLinuxTrace {
+
+    /**
+     * processing timeline trace header
+     * @type {GeneratedFileObj}
+     */
+    traceHeader;
+
+    /**
+     * processing timeline trace source code
+     * @type {GeneratedFileObj}
+     */
+    traceSource;
+
+    /**
+     * {@linkcode TemplateLinuxTrace} Generate code for tracing the processing timeline of Linux applications (`trace` feature)
+     *
+     * The trace is enabled with command line arguments, i.e. in the `Runtime` service of the .exospkg. Each process(),
+     * received dataset, callback and publish is recorded as an event in a lock-free ring of the calling thread, and the
+     * last events of all threads are dumped in the Chrome Trace Event format (for Perfetto or chrome://tracing) on SIGUSR1,
+     * with `trace_dump()`, or when a process() or the latency of a received dataset exceeds a threshold.
+     *
+     * Generates following {@link GeneratedFileObj} objects
+     * - {@linkcode traceHeader}
+     * - {@linkcode traceSource}
+     */
+    constructor() {
+        this.traceHeader = {name:"trace.h", contents:this._generateTraceHeader(), description:"Processing timeline trace header"};
+        this.traceSource = {name:"trace.c", contents:this._generateTraceSource(), description:"Processing timeline trace source"};
+    }
+
+    _generateTraceHeader() {
+        function generateTraceHeader() {
+            let out = "";
+
+            out += `#ifndef _TRACE_H_\n`;
+            out += `#define _TRACE_H_\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `extern "C" {\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#include <stdbool.h>\n`;
+            out += `#include <stdint.h>\n`;
+            out += `\n`;
+            out += `/* Flight recorder of the processing timeline, enabled with command line arguments (Runtime service in the .exospkg):\n`;
+            out += `    --trace <path>              keep a trace and write it to <path>.<n>.json when dumped (default: not traced)\n`;
+            out += `    --trace-events <n>          events kept per thread, rounded up to a power of two (default: 16384)\n`;
+            out += `    --trace-threshold <us>      dump when a process() takes longer, or a dataset is received with a higher latency (default: 0, off)\n`;
+            out += `    --trace-dumps <n>           number of dump files, the oldest one is overwritten (default: 8)\n`;
+            out += `\n`;
+            out += `   Every thread that records an event gets its own ring, written without locks or system calls (apart from reading\n`;
+            out += `   the clock): each slot carries a sequence number that is odd while the slot is written, and a dump skips the slots\n`;
+            out += `   overwritten while it reads them. A dump contains the last events of all threads in the Chrome Trace Event format,\n`;
+            out += `   which is opened in https://ui.perfetto.dev or chrome://tracing.\n`;
+            out += `\n`;
+            out += `   A dump is written at the end of the process() in which the threshold was exceeded (at most one per second),\n`;
+            out += `   after SIGUSR1 was received, or by calling trace_dump(). Events are recorded with trace_begin() / trace_end()\n`;
+            out += `   around a span, and trace_instant() for a point in time. The names are not copied, and have to stay valid. */\n`;
+            out += `\n`;
+            out += `/* read the command line arguments and start tracing if --trace is given, returns true if tracing */\n`;
+            out += `bool trace_setup(int argc, char **argv);\n`;
+            out += `\n`;
+            out += `/* span in the calling thread, value is shown in the arguments of the event */\n`;
+            out += `void trace_begin(const char *name, const char *category, int64_t value);\n`;
+            out += `void trace_end(const char *name, const char *category, int64_t value);\n`;
+            out += `\n`;
+            out += `/* point in time in the calling thread */\n`;
+            out += `void trace_instant(const char *name, const char *category, int64_t value);\n`;
+            out += `\n`;
+            out += `/* span of a process(), a triggered or requested dump is written at its end */\n`;
+            out += `void trace_process_begin(int32_t nettime);\n`;
+            out += `void trace_process_end(int32_t nettime);\n`;
+            out += `\n`;
+            out += `/* received dataset with its latency (us), checked against --trace-threshold */\n`;
+            out += `void trace_received(const char *name, int32_t latency);\n`;
+            out += `\n`;
+            out += `/* write the events of all threads to the next dump file now, returns true if written */\n`;
+            out += `bool trace_dump(const char *reason);\n`;
+            out += `\n`;
+            out += `#ifdef __cplusplus\n`;
+            out += `}\n`;
+            out += `#endif\n`;
+            out += `\n`;
+            out += `#endif // _TRACE_H_\n`;
+            return out;
+        }
+        return generateTraceHeader();
+    }
+
+    _generateTraceSource() {
+        function generateTraceSource() {
+            let out = "";
+
+            out += `#define _GNU_SOURCE\n`;
+            out += `#include "trace.h"\n`;
+            out += `#include <stdio.h>\n`;
+            out += `#include <stdlib.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `#include <signal.h>\n`;
+            out += `#include <time.h>\n`;
+            out += `#include <unistd.h>\n`;
+            out += `#include <sys/syscall.h>\n`;
+            out += `\n`;
+            out += `#define TRACE_HOLDOFF_NS 1000000000LL\n`;
+            out += `\n`;
+            out += `typedef struct\n`;
+            out += `{\n`;
+            out += `    uint64_t sequence; /* 2 * event + 1 while written, 2 * event + 2 when complete */\n`;
+            out += `    int64_t time;      /* CLOCK_MONOTONIC (ns) */\n`;
+            out += `    const char *name;\n`;
+            out += `    const char *category;\n`;
+            out += `    int64_t value;\n`;
+            out += `    char phase; /* B, E or i */\n`;
+            out += `} trace_event_t;\n`;
+            out += `\n`;
+            out += `typedef struct trace_ring\n`;
+            out += `{\n`;
+            out += `    struct trace_ring *next;\n`;
+            out += `    pid_t tid;\n`;
+            out += `    uint64_t head; /* number of events written */\n`;
+            out += `    trace_event_t events[];\n`;
+            out += `} trace_ring_t;\n`;
+            out += `\n`;
+            out += `static struct\n`;
+            out += `{\n`;
+            out += `    bool enabled;\n`;
+            out += `    char path[4096];\n`;
+            out += `    uint32_t size; /* events per ring, power of two */\n`;
+            out += `    int64_t threshold;\n`;
+            out += `    uint32_t dumps;\n`;
+            out += `    uint32_t dumped;\n`;
+            out += `    trace_ring_t *rings;\n`;
+            out += `    int64_t process_begin;\n`;
+            out += `    int64_t last_trigger;\n`;
+            out += `    char trigger[64];\n`;
+            out += `    volatile sig_atomic_t requested;\n`;
+            out += `} trace = {0};\n`;
+            out += `\n`;
+            out += `static __thread trace_ring_t *thread_ring;\n`;
+            out += `\n`;
+            out += `static int64_t clock_ns(void)\n`;
+            out += `{\n`;
+            out += `    struct timespec ts;\n`;
+            out += `    clock_gettime(CLOCK_MONOTONIC, &ts);\n`;
+            out += `    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static const char *get_argument(int argc, char **argv, const char *name)\n`;
+            out += `{\n`;
+            out += `    for (int i = 1; i < argc - 1; i++)\n`;
+            out += `    {\n`;
+            out += `        if (0 == strcmp(argv[i], name))\n`;
+            out += `            return argv[i + 1];\n`;
+            out += `    }\n`;
+            out += `    return NULL;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void handle_request(int signal)\n`;
+            out += `{\n`;
+            out += `    (void)signal;\n`;
+            out += `    trace.requested = 1;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `/* the ring of the calling thread, created on its first event */\n`;
+            out += `static trace_ring_t *get_ring(void)\n`;
+            out += `{\n`;
+            out += `    trace_ring_t *ring = thread_ring;\n`;
+            out += `\n`;
+            out += `    if (NULL != ring)\n`;
+            out += `        return ring;\n`;
+            out += `\n`;
+            out += `    ring = calloc(1, sizeof(trace_ring_t) + trace.size * sizeof(trace_event_t));\n`;
+            out += `    if (NULL == ring)\n`;
+            out += `        return NULL;\n`;
+            out += `    ring->tid = (pid_t)syscall(SYS_gettid);\n`;
+            out += `\n`;
+            out += `    // rings are added to the front of the list and never removed, so a dump can walk it at any time\n`;
+            out += `    ring->next = __atomic_load_n(&trace.rings, __ATOMIC_RELAXED);\n`;
+            out += `    while (!__atomic_compare_exchange_n(&trace.rings, &ring->next, ring, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))\n`;
+            out += `        ;\n`;
+            out += `    thread_ring = ring;\n`;
+            out += `    return ring;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void record(char phase, const char *name, const char *category, int64_t value, int64_t time)\n`;
+            out += `{\n`;
+            out += `    trace_ring_t *ring = get_ring();\n`;
+            out += `    trace_event_t *event;\n`;
+            out += `    uint64_t head;\n`;
+            out += `\n`;
+            out += `    if (NULL == ring)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    head = ring->head;\n`;
+            out += `    event = &ring->events[head & (trace.size - 1)];\n`;
+            out += `    __atomic_store_n(&event->sequence, 2 * head + 1, __ATOMIC_RELAXED);\n`;
+            out += `    __atomic_thread_fence(__ATOMIC_RELEASE);\n`;
+            out += `    event->time = time;\n`;
+            out += `    event->name = name;\n`;
+            out += `    event->category = category;\n`;
+            out += `    event->value = value;\n`;
+            out += `    event->phase = phase;\n`;
+            out += `    __atomic_store_n(&event->sequence, 2 * head + 2, __ATOMIC_RELEASE);\n`;
+            out += `    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void write_string(FILE *file, const char *string)\n`;
+            out += `{\n`;
+            out += `    fputc('"', file);\n`;
+            out += `    for (; NULL != string && '\\0' != *string; string++)\n`;
+            out += `    {\n`;
+            out += `        if ('"' == *string || '\\\\' == *string)\n`;
+            out += `            fprintf(file, "\\\\%c", *string);\n`;
+            out += `        else if ((unsigned char)*string < 0x20)\n`;
+            out += `            fprintf(file, "\\\\u%04x", *string);\n`;
+            out += `        else\n`;
+            out += `            fputc(*string, file);\n`;
+            out += `    }\n`;
+            out += `    fputc('"', file);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `static void write_events(FILE *file, trace_ring_t *ring, bool *first)\n`;
+            out += `{\n`;
+            out += `    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);\n`;
+            out += `    uint64_t event = head > trace.size ? head - trace.size : 0;\n`;
+            out += `    pid_t pid = getpid();\n`;
+            out += `\n`;
+            out += `    for (; event < head; event++)\n`;
+            out += `    {\n`;
+            out += `        trace_event_t *slot = &ring->events[event & (trace.size - 1)];\n`;
+            out += `        trace_event_t copy;\n`;
+            out += `        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);\n`;
+            out += `\n`;
+            out += `        if (2 * event + 2 != sequence)\n`;
+            out += `            continue; // overwritten since the head was read\n`;
+            out += `        copy = *slot;\n`;
+            out += `        __atomic_thread_fence(__ATOMIC_ACQUIRE);\n`;
+            out += `        if (sequence != __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED))\n`;
+            out += `            continue;\n`;
+            out += `\n`;
+            out += `        fprintf(file, "%s\\n{\\"name\\":", *first ? "" : ",");\n`;
+            out += `        write_string(file, copy.name);\n`;
+            out += `        fprintf(file, ",\\"cat\\":");\n`;
+            out += `        write_string(file, copy.category);\n`;
+            out += `        fprintf(file, ",\\"ph\\":\\"%c\\",\\"ts\\":%lld.%03lld,\\"pid\\":%d,\\"tid\\":%d,%s\\"args\\":{\\"value\\":%lld}}", copy.phase,\n`;
+            out += `                (long long)(copy.time / 1000), (long long)(copy.time % 1000), (int)pid, (int)ring->tid,\n`;
+            out += `                'i' == copy.phase ? "\\"s\\":\\"t\\"," : "", (long long)copy.value);\n`;
+            out += `        *first = false;\n`;
+            out += `    }\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool trace_setup(int argc, char **argv)\n`;
+            out += `{\n`;
+            out += `    const char *path = get_argument(argc, argv, "--trace");\n`;
+            out += `    const char *events = get_argument(argc, argv, "--trace-events");\n`;
+            out += `    const char *threshold = get_argument(argc, argv, "--trace-threshold");\n`;
+            out += `    const char *dumps = get_argument(argc, argv, "--trace-dumps");\n`;
+            out += `    struct sigaction action = {0};\n`;
+            out += `    long size;\n`;
+            out += `\n`;
+            out += `    if (trace.enabled || NULL == path)\n`;
+            out += `        return trace.enabled;\n`;
+            out += `\n`;
+            out += `    size = NULL != events ? atol(events) : 16384;\n`;
+            out += `    if (size < 64 || size > (1L << 24))\n`;
+            out += `        size = 16384;\n`;
+            out += `    trace.size = 64;\n`;
+            out += `    while (trace.size < (uint32_t)size)\n`;
+            out += `        trace.size *= 2;\n`;
+            out += `    trace.threshold = NULL != threshold ? (int64_t)atol(threshold) * 1000 : 0;\n`;
+            out += `    trace.dumps = NULL != dumps && atoi(dumps) > 0 ? (uint32_t)atoi(dumps) : 8;\n`;
+            out += `    snprintf(trace.path, sizeof(trace.path), "%s", path);\n`;
+            out += `\n`;
+            out += `    action.sa_handler = handle_request;\n`;
+            out += `    action.sa_flags = SA_RESTART;\n`;
+            out += `    sigemptyset(&action.sa_mask);\n`;
+            out += `    sigaction(SIGUSR1, &action, NULL);\n`;
+            out += `\n`;
+            out += `    trace.enabled = true;\n`;
+            out += `    printf("trace: %u events per thread, dumped to %s.<0..%u>.json on SIGUSR1", trace.size, trace.path, trace.dumps - 1);\n`;
+            out += `    if (trace.threshold > 0)\n`;
+            out += `        printf(" or above %lld us", (long long)(trace.threshold / 1000));\n`;
+            out += `    printf("\\n");\n`;
+            out += `    return true;\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void trace_begin(const char *name, const char *category, int64_t value)\n`;
+            out += `{\n`;
+            out += `    if (trace.enabled)\n`;
+            out += `        record('B', name, category, value, clock_ns());\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void trace_end(const char *name, const char *category, int64_t value)\n`;
+            out += `{\n`;
+            out += `    if (trace.enabled)\n`;
+            out += `        record('E', name, category, value, clock_ns());\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void trace_instant(const char *name, const char *category, int64_t value)\n`;
+            out += `{\n`;
+            out += `    if (trace.enabled)\n`;
+            out += `        record('i', name, category, value, clock_ns());\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void trace_process_begin(int32_t nettime)\n`;
+            out += `{\n`;
+            out += `    if (!trace.enabled)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    trace.process_begin = clock_ns();\n`;
+            out += `    record('B', "process", "process", nettime, trace.process_begin);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void trace_received(const char *name, int32_t latency)\n`;
+            out += `{\n`;
+            out += `    if (!trace.enabled)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    record('i', name, "received", latency, clock_ns());\n`;
+            out += `    if (trace.threshold > 0 && (int64_t)latency * 1000 > trace.threshold && '\\0' == trace.trigger[0])\n`;
+            out += `        snprintf(trace.trigger, sizeof(trace.trigger), "%s latency %d us", name, latency);\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `void trace_process_end(int32_t nettime)\n`;
+            out += `{\n`;
+            out += `    int64_t now;\n`;
+            out += `\n`;
+            out += `    if (!trace.enabled)\n`;
+            out += `        return;\n`;
+            out += `\n`;
+            out += `    now = clock_ns();\n`;
+            out += `    record('E', "process", "process", nettime, now);\n`;
+            out += `    if (trace.threshold > 0 && now - trace.process_begin > trace.threshold && '\\0' == trace.trigger[0])\n`;
+            out += `        snprintf(trace.trigger, sizeof(trace.trigger), "process %lld us", (long long)((now - trace.process_begin) / 1000));\n`;
+            out += `\n`;
+            out += `    if (trace.requested)\n`;
+            out += `    {\n`;
+            out += `        trace.requested = 0;\n`;
+            out += `        trace_dump("SIGUSR1");\n`;
+            out += `    }\n`;
+            out += `    else if ('\\0' != trace.trigger[0] && now - trace.last_trigger >= TRACE_HOLDOFF_NS)\n`;
+            out += `    {\n`;
+            out += `        trace.last_trigger = now;\n`;
+            out += `        trace_dump(trace.trigger);\n`;
+            out += `    }\n`;
+            out += `    trace.trigger[0] = '\\0';\n`;
+            out += `}\n`;
+            out += `\n`;
+            out += `bool trace_dump(const char *reason)\n`;
+            out += `{\n`;
+            out += `    char path[sizeof(trace.path) + 16];\n`;
+            out += `    char temporary[sizeof(path) + 8];\n`;
+            out += `    bool first = true;\n`;
+            out += `    uint32_t dump;\n`;
+            out += `    FILE *file;\n`;
+            out += `\n`;
+            out += `    if (!trace.enabled)\n`;
+            out += `        return false;\n`;
+            out += `\n`;
+            out += `    dump = __atomic_fetch_add(&trace.dumped, 1, __ATOMIC_RELAXED);\n`;
+            out += `    snprintf(path, sizeof(path), "%s.%u.json", trace.path, dump % trace.dumps);\n`;
+            out += `    snprintf(temporary, sizeof(temporary), "%s.tmp", path);\n`;
+            out += `    file = fopen(temporary, "w");\n`;
+            out += `    if (NULL == file)\n`;
+            out += `    {\n`;
+            out += `        fprintf(stderr, "trace: cannot write %s\\n", temporary);\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `\n`;
+            out += `    fprintf(file, "{\\"displayTimeUnit\\":\\"ms\\",\\"otherData\\":{\\"reason\\":");\n`;
+            out += `    write_string(file, reason);\n`;
+            out += `    fprintf(file, "},\\"traceEvents\\":[");\n`;
+            out += `    for (trace_ring_t *ring = __atomic_load_n(&trace.rings, __ATOMIC_ACQUIRE); NULL != ring; ring = ring->next)\n`;
+            out += `    {\n`;
+            out += `        write_events(file, ring, &first);\n`;
+            out += `    }\n`;
+            out += `    fprintf(file, "\\n]}\\n");\n`;
+            out += `\n`;
+            out += `    if (0 != fclose(file) || 0 != rename(temporary, path))\n`;
+            out += `    {\n`;
+            out += `        unlink(temporary);\n`;
+            out += `        fprintf(stderr, "trace: cannot write %s\\n", path);\n`;
+            out += `        return false;\n`;
+            out += `    }\n`;
+            out += `    printf("trace: %s written (%s)\\n", path, reason);\n`;
+            out += `    return true;\n`;
+            out += `}\n`;
+            return out;
+        }
+        return generateTraceSource();
+    }
+}
+
+module.exports = {TemplateLinuxTrace};
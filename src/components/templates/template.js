@@ -42,6 +42,24 @@ const {Datamodel, Dataset} = require('../../datamodel');
  * @property {boolean} isPub set via the comment to `true` if the dataset should be published. (platform dependent - this is `(*PUB*)` for AR and `(*SUB*)` for GPOS)
  * @property {boolean} isSub set via the comment to `true` if the dataset should be subscribed to. (platform dependent - this is `(*SUB*)` for AR and `(*PUB*)`for GPOS)
  * @property {boolean} isPrivate set to true if the comment includes the word `private`
+ * @property {ApplicationTemplateQos} [qos] quality of service from the annotations in the comment, resolved for this platform. Undefined if there is nothing to apply
+ * 
+ * @typedef {Object} ApplicationTemplateQos
+ * @property {number} rate minimum interval (us) between two publishes of this application, 0 for no limit
+ * @property {boolean} latest conflate received updates, so that only the latest value is delivered per process()
+ * @property {number} deadband minimum change of a received value before it is delivered, 0 to deliver every update
+ * @property {boolean} relative the deadband (and hysteresis) is given in percent of the last delivered value
+ * @property {number} hysteresis additional change needed when a received value reverses the direction of the last delivered change
+ * @property {QosMemberFilter[]} filters deadband filters of the members of a received structure dataset
+ * @property {string} priority `HIGH` | `NORMAL` | `LOW` order of the deferred publishes and conflated updates in process()
+ * 
+ * @typedef {Object} ApplicationTemplateGroup
+ * @property {string} name name of the publish group, from the `GROUP=<name>` annotations => `odom`
+ * @property {string} snapshotType typename of the member snapshot in `Datamodel.groupFile` => `MyApplicationodom_snapshot_t`
+ * @property {ApplicationTemplateDataset} tag the `UDINT` dataset carrying the sequence number of the group
+ * @property {ApplicationTemplateDataset[]} members the member datasets, their index is the member index in `exos_group_t`
+ * @property {boolean} isPub the group is published by this application
+ * @property {boolean} isSub the group is received by this application
  * 
  * @typedef {Object} ApplicationTemplate
  * @property {string} targetName default name of the target, set in the TP => `gTarget_0`
@@ -54,6 +72,25 @@ const {Datamodel, Dataset} = require('../../datamodel');
  * @property {ApplicationTemplateHandle} handle handle structure for used for AR libraries (to overcome downloads)
  * @property {ApplicationTemplateDatamodel} datamodel datamodel related types and instance names for the application
  * @property {ApplicationTemplateDataset[]} datasets dataset type and instance names for the application  
+ * @property {ApplicationTemplateGroup[]} groups publish groups of the datasets, see `Datamodel.publishGroups`
+ * 
+ * Optional template features that can be enabled by the component generator:
+ * 
+ * @typedef {"soa"|"budget"|"rt"|"epoll"|"record"|"gateway"|"mirror"|"metrics"|"trace"|"profile"|"probe"|"loadgen"|"process"} TemplateFeature
+ * - `soa` generate structure-of-arrays mirrors (with conversion kernels) for datasets that are arrays of structures
+ * - `budget` bound the work per cycle of the AR `c-api` library with the `BudgetTime` and `BudgetBytes` inputs of the Cyclic FUB
+ * - `rt` real-time execution profile for the Linux `c-api`, `c-static` and `cpp` executables, configured with command line arguments
+ * - `epoll` epoll based main loop for the Linux `c-api`, `c-static` and `cpp` executables, sharing one wait for termination, processing and application file descriptors. Without a cycle the main still blocks in the DMR processing, and the events are only handled after each DMR cycle
+ * - `record` recorder for the received and published datasets of the Linux `c-static` and `cpp` executables, enabled with command line arguments
+ * - `gateway` shared memory fan-out of the datasets of the Linux `c-static` executable to local consumers, with client libraries for C, C++, Node.js and Python
+ * - `mirror` latest value mirror of the datasets of the Linux `c-static` and `cpp` executables in shared memory, with read-only accessors for other processes
+ * - `metrics` OpenMetrics exporter for the dataset traffic, latencies and connection state of the Linux `c-static` and `cpp` executables, enabled with command line arguments
+ * - `trace` flight recorder of the processing timeline of the Linux `c-static` and `cpp` executables, dumped in the Chrome Trace Event format
+ * - `profile` change-frequency profile of the members of the received and published datasets of the Linux `c-static` and `cpp` executables, enabled with command line arguments
+ * - `probe` round trip probe between the AR `c-api` library and the Linux `c-static` and `cpp` executables, measuring latency, jitter and lost probes
+ * - `loadgen` synthetic load generator for the Linux `c-api`, `c-static` and `cpp` executables, built next to them as a separate command line tool
+ * - `process` blocking, non-blocking and adaptive process modes with CPU and latency measurements for the Linux templates (`Datamodel.processFile`),
+ *   implied by `rt` and `epoll`, which switch the processing to non-blocking when a cycle is set
  */
 class Template
 {
@@ -87,6 +124,12 @@ class Template
      */
     isLinux;
 
+    /**
+     * Optional features enabled for this template, empty if none
+     * @type {TemplateFeature[]}
+     */
+    features;
+
     /**
      * Create an {@link ApplicationTemplate} object from the given {@link Datamodel} for Linux or AR.
      * The generated {@link ApplicationTemplate} is platform specific
@@ -96,8 +139,9 @@ class Template
      * @param {Datamodel} datamodel existing {@link Datamodel} class that should be used for this template 
      * @param {boolean} Linux generate structure for Linux (`true`), otherwise AR (`false`) when used in Linux, the `datasets[].isPub` and `datasets[].isSub` are reversed
      * @param {boolean} [recurse] generate a recursive template structure for datasets (at all sublevels) - with this you get `datasets[].datasets[].datasets[]` and so on
+     * @param {TemplateFeature[]} [features] optional features to generate, see {@link TemplateFeature}
      */
-    constructor(datamodel, Linux, recurse) {
+    constructor(datamodel, Linux, recurse, features) {
         
         /**
          * create the template structure form the Dataset structure
@@ -148,6 +192,25 @@ class Template
                         object["isPrivate"] = false;
                     }
                     if (child.attributes.hasOwnProperty("stringLength")) { object["stringLength"] = child.attributes.stringLength; }
+                    let filters = object["isSub"] ? Datamodel.qosMemberFilters(child) : [];
+                    if (child.attributes.qos !== undefined || filters.length > 0) {
+                        // PUB options apply to the AR publisher and the Linux subscriber, SUB options the other way round
+                        let annotations = child.attributes.qos !== undefined ? child.attributes.qos : {priority: "NORMAL"};
+                        let published = Linux ? annotations.sub : annotations.pub;
+                        let received = object["isSub"] ? (Linux ? annotations.pub : annotations.sub) : undefined;
+                        let qos = {
+                            rate: object["isPub"] && published !== undefined ? published.rate : 0,
+                            latest: received !== undefined ? received.latest : false,
+                            deadband: received !== undefined ? received.deadband : 0,
+                            relative: received !== undefined ? received.relative : false,
+                            hysteresis: received !== undefined ? received.hysteresis : 0,
+                            filters: filters,
+                            priority: annotations.priority
+                        };
+                        if (qos.rate > 0 || qos.latest || qos.deadband > 0 || qos.filters.length > 0) {
+                            object["qos"] = qos;
+                        }
+                    }
                     
                     if(recurse !== undefined && recurse)
                     {
@@ -183,7 +246,8 @@ class Template
                     handleName: "",
                     className: ""
                 },
-                datasets: []
+                datasets: [],
+                groups: []
             }
             template.targetName = "gTarget_0";
             template.logname = "logger";
@@ -211,16 +275,98 @@ class Template
             template.datamodel.handleName = "h_" + types.attributes.dataType;
     
             readDatasets(template.datasets,types, recurse);
+
+            for (let group of Datamodel.publishGroups(types)) {
+                let tag = template.datasets.find(dataset => dataset.structName == group.tag);
+                template.groups.push({
+                    name: group.name,
+                    snapshotType: `${types.attributes.dataType}${group.name}_snapshot_t`,
+                    tag: tag,
+                    members: group.members.map(name => template.datasets.find(dataset => dataset.structName == name)),
+                    isPub: tag.isPub,
+                    isSub: tag.isSub
+                });
+            }
         
             return template;
         }
 
         this.isLinux = Linux;
+        this.features = Array.isArray(features) ? features.slice() : [];
+        if (Linux && !this.features.includes("process") && Template.processModes(this.features)) {
+            this.features.push("process");
+        }
         this.datamodel = datamodel;
         if (datamodel != undefined)
             this.template = configTemplate(this.datamodel.dataset, this.datamodel.headerFile.name, Linux, recurse);
     }
 
+    /**
+     * @param {TemplateFeature[]} features 
+     * @returns {boolean} true if the Linux templates generate the process modes, with the `process` feature or implied by `rt` and `epoll`
+     */
+    static processModes(features) {
+        return ["process", "rt", "epoll"].some(feature => features.includes(feature));
+    }
+
+    /**
+     * @param {ApplicationTemplateDataset[]} datasets 
+     * @returns {ApplicationTemplateDataset[]} the datasets with quality of service, in the order of their priority
+     */
+    static qosDatasets(datasets) {
+        return datasets.filter(dataset => dataset.qos !== undefined)
+            .sort((a, b) => Datamodel.QOS_PRIORITIES.indexOf(a.qos.priority) - Datamodel.QOS_PRIORITIES.indexOf(b.qos.priority));
+    }
+
+    /**
+     * @param {ApplicationTemplateDataset} dataset 
+     * @returns {boolean} true if received updates of the dataset are filtered with a deadband, on the value or its members
+     */
+    static qosHasDeadband(dataset) {
+        return dataset.isSub && dataset.qos !== undefined && (dataset.qos.deadband > 0 || dataset.qos.filters.length > 0);
+    }
+
+    /**
+     * @param {ApplicationTemplate} template 
+     * @param {ApplicationTemplateDataset} dataset 
+     * @returns {string} prefix of the member deadband type and functions in `Datamodel.qosFile`, e.g. `MyApplicationConfig_deadband`
+     */
+    static qosDeadbandPrefix(template, dataset) {
+        return `${template.datamodel.structName}${dataset.structName}_deadband`;
+    }
+
+    /**
+     * @param {ApplicationTemplate} template 
+     * @param {ApplicationTemplateDataset} dataset 
+     * @returns {ApplicationTemplateGroup} the publish group the dataset is a member or the tag of, `undefined` if none
+     */
+    static datasetGroup(template, dataset) {
+        return template.groups.find(group => group.tag === dataset || group.members.includes(dataset));
+    }
+
+    /**
+     * @param {ApplicationTemplateQos} qos 
+     * @returns {string[]} description of the quality of service, one line per option, used in the legends
+     */
+    static qosDescription(qos) {
+        let lines = [];
+        if (qos.rate > 0) lines.push(`published at most every ${qos.rate}us, publishes within the interval are deferred to process()`);
+        if (qos.latest) lines.push(`updates are conflated, the latest value is delivered in process()`);
+        function deadband(filter) {
+            let unit = filter.relative ? "%" : "";
+            return `deadband ${filter.deadband}${unit}` + (filter.hysteresis > 0 ? `, hysteresis ${filter.hysteresis}${unit}` : "");
+        }
+        if (qos.deadband > 0) lines.push(`updates within the ${deadband(qos)} are not delivered`);
+        if (qos.filters.length > 0) {
+            lines.push(`updates are only delivered if a member moved out of its deadband, or any other member changed:`);
+            for (let filter of qos.filters) {
+                lines.push(`    ${filter.access.substring(1)} ${deadband(filter)}`);
+            }
+        }
+        lines.push(`priority ${qos.priority}`);
+        return lines;
+    }
+
 }
 
 const fs = require('fs');
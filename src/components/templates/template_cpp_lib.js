@@ -7,8 +7,15 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 
-const { Template, ApplicationTemplate } = require('./template')
+const { Template, ApplicationTemplate, TemplateFeature } = require('./template')
 const { Datamodel, GeneratedFileObj } = require('../../datamodel');
+const { TemplateSoa } = require('./template_soa');
+const { TemplateLinuxRecorder } = require('./linux/template_linux_recorder');
+const { TemplateLinuxMirror } = require('./linux/template_linux_mirror');
+const { TemplateLinuxMetrics } = require('./linux/template_linux_metrics');
+const { TemplateLinuxTrace } = require('./linux/template_linux_trace');
+const { TemplateProbe } = require('./template_probe');
+const { TemplateLinuxProfile } = require('./linux/template_linux_profile');
 
 class TemplateCppLib extends Template {
     
@@ -43,6 +50,66 @@ class TemplateCppLib extends Template {
      */
     datamodelLegend;
 
+    /**
+     * structure-of-arrays mirrors, only created with the `soa` feature
+     * @type {TemplateSoa}
+     */
+    soa;
+
+    /**
+     * name of the quality of service header, if any dataset has QoS annotations for this platform
+     * @type {string}
+     */
+    qosHeaderName;
+
+    /**
+     * name of the process mode header, only used on Linux with the `process` feature
+     * @type {string}
+     */
+    processHeaderName;
+
+    /**
+     * name of the publish group header, if the datamodel has publish groups
+     * @type {string}
+     */
+    groupHeaderName;
+
+    /**
+     * dataset traffic recorder, only created on Linux with the `record` feature
+     * @type {TemplateLinuxRecorder}
+     */
+    recorder;
+
+    /**
+     * latest value mirror of the datasets in shared memory, only created on Linux with the `mirror` feature
+     * @type {TemplateLinuxMirror}
+     */
+    mirror;
+
+    /**
+     * OpenMetrics exporter, only created on Linux with the `metrics` feature
+     * @type {TemplateLinuxMetrics}
+     */
+    metrics;
+
+    /**
+     * processing timeline trace, only created on Linux with the `trace` feature
+     * @type {TemplateLinuxTrace}
+     */
+    trace;
+
+    /**
+     * round trip probe echoing the requests of AR, only created on Linux with the `probe` feature
+     * @type {TemplateProbe}
+     */
+    probe;
+
+    /**
+     * change-frequency profile of the dataset members, only created on Linux with the `profile` feature
+     * @type {TemplateLinuxProfile}
+     */
+    profile;
+
     /**
      * {@linkcode TemplateCppLib} Generate C++ Datamodel template for Linux and AR
      * 
@@ -56,13 +123,66 @@ class TemplateCppLib extends Template {
      * 
      * - {@linkcode datamodelLegend} code comment to be added to the implementing source code - describing the library interface
      * 
+     * With the `soa` feature, datasets that are arrays of structures use a dataset class with a `soa()` mirror written via `soaModify()`, see {@linkcode TemplateSoa}
+     * 
+     * Datasets with QoS annotations in the .typ file use a dataset class with rate limiting, deadband and latest-value conflation (`Datamodel.qosFile`)
+     * 
+     * On Linux with the `process` feature, `setProcessMode()` selects a blocking, non-blocking or adaptive `process()` using the `Datamodel.processFile` header
+     * 
+     * Publish groups are members of the datamodel class with `publish()` or `onGroupChange()` and a consistent `snapshot`, using the `Datamodel.groupFile` header
+     * 
+     * Datasets written via `modify()` are published once by the next `process()`, counted in `publishStats()`
+     * 
+     * With the `record` feature on Linux, received and published datasets are recorded, and a recording can be replayed instead of the DMR, see {@linkcode TemplateLinuxRecorder}
+     * 
+     * With the `mirror` feature on Linux, the latest value of each received and published dataset is kept in shared memory, see {@linkcode TemplateLinuxMirror}
+     * 
+     * With the `metrics` feature on Linux, the dataset traffic, latencies, callback times and connection state are exported to Prometheus, see {@linkcode TemplateLinuxMetrics}
+     * 
+     * With the `trace` feature on Linux, process(), received datasets, callbacks and publishes are traced and dumped in the Chrome Trace Event format, see {@linkcode TemplateLinuxTrace}
+     * 
+     * With the `probe` feature on Linux, process() echoes the round trip probes of AR, with the measurements in `probeStats()`, see {@linkcode TemplateProbe}
+     * 
+     * With the `profile` feature on Linux, the changes of the members of received and published datasets are counted in `profile()`, see {@linkcode TemplateLinuxProfile}
+     * 
      * @param {Datamodel} datamodel 
      * @param {boolean} Linux true if generated for Linux, false for AR
+     * @param {TemplateFeature[]} [features] optional features to generate
      */
-    constructor(datamodel, Linux) {
-        super(datamodel, Linux);
+    constructor(datamodel, Linux, features) {
+        super(datamodel, Linux, false, features);
         
         if (datamodel != undefined) {
+            if (this.features.includes("soa")) {
+                this.soa = new TemplateSoa(datamodel, Linux);
+            }
+            if (Template.qosDatasets(this.template.datasets).length > 0) {
+                this.qosHeaderName = this.datamodel.qosFile.name;
+            }
+            if (Linux && this.features.includes("process")) {
+                this.processHeaderName = this.datamodel.processFile.name;
+            }
+            if (this.template.groups.length > 0) {
+                this.groupHeaderName = this.datamodel.groupFile.name;
+            }
+            if (Linux && this.features.includes("record")) {
+                this.recorder = new TemplateLinuxRecorder();
+            }
+            if (Linux && this.features.includes("mirror")) {
+                this.mirror = new TemplateLinuxMirror(datamodel, this.template);
+            }
+            if (Linux && this.features.includes("metrics")) {
+                this.metrics = new TemplateLinuxMetrics();
+            }
+            if (Linux && this.features.includes("trace")) {
+                this.trace = new TemplateLinuxTrace();
+            }
+            if (Linux && this.features.includes("probe")) {
+                this.probe = new TemplateProbe(datamodel, true);
+            }
+            if (Linux && this.features.includes("profile")) {
+                this.profile = new TemplateLinuxProfile(datamodel, this.template);
+            }
             this.datasetHeader = {name: `${this.template.datamodel.datasetClassName}.hpp`, contents:this._generateDatasetHeader(), description:`${this.datamodel.typeName} dataset class`}
             this.loggerHeader = {name: `${this.template.loggerClassName}.hpp`, contents:this._generateLoggerHeader(), description:`${this.datamodel.typeName} logger class`}
             this.loggerSource = {name: `${this.template.loggerClassName}.cpp`, contents:this._generateLoggerSource(), description:`${this.datamodel.typeName} logger class implementation`}
@@ -78,9 +198,20 @@ class TemplateCppLib extends Template {
     _generateDatasetHeader() {
         /**
          * @param {ApplicationTemplate} template 
+         * @param {string} [soaHeaderName] generate the structure-of-arrays dataset class using this header
+         * @param {string} [qosHeaderName] generate the quality of service dataset class using this header
+         * @param {string} [processHeaderName] measure the latency of received datasets using this header
+         * @param {string} [groupHeaderName] generate the publish group classes using this header
+         * @param {string} [recorderHeaderName] record the received and published values using this header
+         * @param {string} [mirrorHeaderName] write the received and published values to the latest value mirror using this header
+         * @param {string} [metricsHeaderName] count the received and published values and time the callback for the metrics using this header
+         * @param {string} [traceHeaderName] trace the received and published values and the callback using this header
          * @returns {string}
          */
-        function generateExosDataSetHeader(template) {
+        function generateExosDataSetHeader(template, soaHeaderName, qosHeaderName, processHeaderName, groupHeaderName, recorderHeaderName, mirrorHeaderName, metricsHeaderName, traceHeaderName, profileHeaderName) {
+
+            let mirrorPrefix = TemplateLinuxMirror.mirrorPrefix(template);
+            let profilePrefix = TemplateLinuxProfile.profilePrefix(template);
 
             let out = "";
         
@@ -95,11 +226,30 @@ class TemplateCppLib extends Template {
             out += `#include <iostream>\n`;
             out += `#include <string.h>\n`;
             out += `#include <functional>\n`;
+            out += `#include <memory>\n`;
             out += `\n`;
             out += `extern "C" {\n`;
             out += `    #include "${template.headerName}"\n`;
             out += `}\n`;
             out += `\n`;
+            if (processHeaderName !== undefined) {
+                out += `#include "${processHeaderName}"\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `#include "${recorderHeaderName}"\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `#include "${mirrorHeaderName}"\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `#include "${metricsHeaderName}"\n`;
+            }
+            if (traceHeaderName !== undefined) {
+                out += `#include "${traceHeaderName}"\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `#include "${profileHeaderName}"\n`;
+            }
             out += `#include "${template.loggerClassName}.hpp"\n`;
             out += `#define exos_assert_ok(_plog_,_exp_)                                                                                                    \\\n`;
             out += `    do                                                                                                                                  \\\n`;
@@ -120,19 +270,79 @@ class TemplateCppLib extends Template {
             out += `    exos_dataset_handle_t dataset = {};\n`;
             out += `    ${template.loggerClassName}* log;\n`;
             out += `    std::function<void()> _onChange = [](){};\n`;
+            out += `    bool _modified = false;\n`;
+            out += `    bool _tracked = false; // modify() was used, keep the last published value\n`;
+            out += `    std::unique_ptr<uint8_t[]> _published;\n`;
+            if (processHeaderName !== undefined) {
+                out += `    exos_process_t* process = nullptr;\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `    ${mirrorPrefix}_t* mirror = nullptr;\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `    ${profilePrefix}_t* profile = nullptr;\n`;
+            }
             out += `    void datasetEvent(exos_dataset_handle_t *dataset, EXOS_DATASET_EVENT_TYPE event_type, void *info) {\n`;
             out += `        switch (event_type)\n`;
             out += `        {\n`;
             out += `            case EXOS_DATASET_EVENT_UPDATED:\n`;
             out += `                log->verbose << "dataset " << dataset->name << " updated! latency (us):" << (exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime) << std::endl;\n`;
+            if (processHeaderName !== undefined) {
+                out += `                if (process != nullptr) {\n`;
+                out += `                    exos_process_latency(process, exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime);\n`;
+                out += `                }\n`;
+            }
             out += `                nettime = dataset->nettime;\n`;
-            out += `                _onChange();\n`;
+            if (soaHeaderName !== undefined) {
+                out += `                _received();\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `                rec_event((uint16_t)dataset->user_tag, REC_UPDATED, dataset->nettime, dataset->data, dataset->size);\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `                ${mirrorPrefix}_write(mirror, (uint16_t)dataset->user_tag, dataset->nettime, dataset->data, dataset->size);\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `                metrics_updated((uint16_t)dataset->user_tag, exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime, dataset->size);\n`;
+            }
+            if (traceHeaderName !== undefined) {
+                out += `                trace_received(dataset->name, exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime);\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `                ${profilePrefix}_update(profile, (uint16_t)dataset->user_tag, ${profilePrefix.toUpperCase()}_RECEIVED, dataset->data, dataset->size);\n`;
+            }
+            if (metricsHeaderName !== undefined || traceHeaderName !== undefined) {
+                out += `                {\n`;
+                if (metricsHeaderName !== undefined) {
+                    out += `                    int64_t begin = metrics_callback_begin();\n`;
+                }
+                if (traceHeaderName !== undefined) {
+                    out += `                    trace_begin(dataset->name, "callback", 0);\n`;
+                }
+                out += `                    _onChange();\n`;
+                if (traceHeaderName !== undefined) {
+                    out += `                    trace_end(dataset->name, "callback", 0);\n`;
+                }
+                if (metricsHeaderName !== undefined) {
+                    out += `                    metrics_callback_end((uint16_t)dataset->user_tag, begin);\n`;
+                }
+                out += `                }\n`;
+            }
+            else {
+                out += `                _onChange();\n`;
+            }
             out += `                break;\n`;
             out += `            case EXOS_DATASET_EVENT_PUBLISHED:\n`;
             out += `                log->verbose << "dataset " << dataset->name << "  published to local server for distribution! send buffer free:" << dataset->send_buffer.free << std::endl;\n`;
+            if (metricsHeaderName !== undefined) {
+                out += `                metrics_send_buffer((uint16_t)dataset->user_tag, dataset->send_buffer.free, dataset->send_buffer.used);\n`;
+            }
             out += `                break;\n`;
             out += `            case EXOS_DATASET_EVENT_DELIVERED:\n`;
             out += `                log->verbose << "dataset " << dataset->name << " delivered to remote server for distribution! send buffer free:" << dataset->send_buffer.free << std::endl;\n`;
+            if (metricsHeaderName !== undefined) {
+                out += `                metrics_send_buffer((uint16_t)dataset->user_tag, dataset->send_buffer.free, dataset->send_buffer.used);\n`;
+            }
             out += `                break;\n`;
             out += `            case EXOS_DATASET_EVENT_CONNECTION_CHANGED:\n`;
             out += `                log->info << "dataset " << dataset->name << " changed state to " << exos_get_state_string(dataset->connection_state) << std::endl;\n`;
@@ -157,6 +367,13 @@ class TemplateCppLib extends Template {
             out += `        inst->datasetEvent(dataset, event_type, info);\n`;
             out += `    }\n`;
             out += `\n`;
+            if (soaHeaderName !== undefined) {
+                out += `protected:\n`;
+                out += `    // hooks of a derived dataset, called for a received value before the onChange callback, and before a value is published\n`;
+                out += `    std::function<void()> _received = [](){};\n`;
+                out += `    std::function<void()> _publishing = [](){};\n`;
+                out += `\n`;
+            }
             out += `public:\n`;
             out += `    ${template.datamodel.datasetClassName}() {};\n`;
             out += `    \n`;
@@ -171,20 +388,299 @@ class TemplateCppLib extends Template {
             out += `        exos_assert_ok(log, exos_dataset_connect(&dataset, type, &${template.datamodel.datasetClassName}::_datasetEvent));\n`;
             out += `    };\n`;
             out += `    void publish() {\n`;
-            out += `        exos_dataset_publish(&dataset);\n`;
+            if (soaHeaderName !== undefined) {
+                out += `        _publishing();\n`;
+            }
+            out += `        _modified = false;\n`;
+            out += `        if (_tracked) {\n`;
+            out += `            if (!_published) {\n`;
+            out += `                _published.reset(new uint8_t[sizeof(T)]);\n`;
+            out += `            }\n`;
+            out += `            memcpy(_published.get(), &value, sizeof(T));\n`;
+            out += `        }\n`;
+            let forward = (nettime, indent) => {
+                let out = "";
+                if (recorderHeaderName !== undefined) {
+                    out += `${indent}rec_event((uint16_t)dataset.user_tag, REC_PUBLISHED, ${nettime}, &value, sizeof(value));\n`;
+                }
+                if (mirrorHeaderName !== undefined) {
+                    out += `${indent}${mirrorPrefix}_write(mirror, (uint16_t)dataset.user_tag, ${nettime}, &value, sizeof(value));\n`;
+                }
+                if (profileHeaderName !== undefined) {
+                    out += `${indent}${profilePrefix}_update(profile, (uint16_t)dataset.user_tag, ${profilePrefix.toUpperCase()}_PUBLISHED, &value, sizeof(value));\n`;
+                }
+                return out;
+            };
+            let published = "";
+            if (metricsHeaderName !== undefined) {
+                published += `            metrics_published((uint16_t)dataset.user_tag, sizeof(value));\n`;
+            }
+            if (traceHeaderName !== undefined) {
+                published += `            trace_instant(dataset.name, "publish", exos_datamodel_get_nettime(dataset.datamodel));\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                let replayed = ["recorded", mirrorHeaderName !== undefined ? "mirrored" : undefined, profileHeaderName !== undefined ? "profiled" : undefined].filter(action => action !== undefined);
+                out += `        // during a replay, the published value is only ${replayed.length > 1 ? `${replayed.slice(0, -1).join(", ")} and ${replayed[replayed.length - 1]}` : replayed[0]}\n`;
+                out += `        if (rec_replaying()) {\n`;
+                out += forward(`rec_replay_nettime()`, `            `);
+                out += `        }\n`;
+                out += `        else if (EXOS_ERROR_OK == exos_dataset_publish(&dataset)) {\n`;
+                out += forward(`exos_datamodel_get_nettime(dataset.datamodel)`, `            `);
+                out += published;
+                out += `        }\n`;
+            }
+            else if (mirrorHeaderName !== undefined || profileHeaderName !== undefined || published != "") {
+                out += `        if (EXOS_ERROR_OK == exos_dataset_publish(&dataset)) {\n`;
+                out += forward(`exos_datamodel_get_nettime(dataset.datamodel)`, `            `);
+                out += published;
+                out += `        }\n`;
+            }
+            else {
+                out += `        exos_dataset_publish(&dataset);\n`;
+            }
             out += `    };\n`;
+            out += `    // the value for writing, marked as modified and published once in the next datamodel process(),\n`;
+            out += `    // unless it equals the last published value. Writes to value itself are not tracked and need publish()\n`;
+            out += `    T& modify() {_tracked = true; _modified = true; return value;};\n`;
+            out += `    void modify(std::function<void(T&)> f) {f(value); _tracked = true; _modified = true;};\n`;
+            out += `    bool modified() const {return _modified;};\n`;
+            out += `    // the value equals the last published value, so publishing it again would not change anything\n`;
+            out += `    bool unchanged() const {return _published && 0 == memcmp(_published.get(), &value, sizeof(T));};\n`;
+            out += `    // clear the modified mark without publishing\n`;
+            out += `    void discard() {_modified = false;};\n`;
             out += `    void onChange(std::function<void()> f) {_onChange = std::move(f);};\n`;
+            if (processHeaderName !== undefined) {
+                out += `    void measureLatency(exos_process_t *_process) {process = _process;};\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `    // index of the dataset in the schema of the recording\n`;
+                out += `    void recordIndex(uint16_t index) {dataset.user_tag = index;};\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `    // write the received and published values to the slot of the dataset index in the mirror\n`;
+                out += `    void mirrorTo(${mirrorPrefix}_t *_mirror, uint16_t index) {mirror = _mirror; dataset.user_tag = index;};\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `    // count the changes of the members of the received and published values in the profile, by dataset index\n`;
+                out += `    void profileTo(${profilePrefix}_t *_profile, uint16_t index) {profile = _profile; dataset.user_tag = index;};\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `    // index of the dataset in the metrics\n`;
+                out += `    void metricsIndex(uint16_t index) {dataset.user_tag = index;};\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `    // deliver a replayed value through the dataset event, as if it was received from the DMR\n`;
+                out += `    void replay(int32_t _nettime, const void *data, size_t size) {\n`;
+                out += `        if (size == sizeof(value)) {\n`;
+                out += `            memcpy(&value, data, size);\n`;
+                out += `            dataset.nettime = _nettime;\n`;
+                out += `            datasetEvent(&dataset, EXOS_DATASET_EVENT_UPDATED, nullptr);\n`;
+                out += `        }\n`;
+                out += `    };\n`;
+            }
             out += `    \n`;
             out += `    ~${template.datamodel.datasetClassName}() {\n`;
             out += `        exos_assert_ok(log, exos_dataset_delete(&dataset));\n`;
             out += `    };\n`;
             out += `};\n`;
             out += `\n`;
+            if (soaHeaderName !== undefined) {
+                out += `#include "${soaHeaderName}"\n`;
+                out += `\n`;
+                out += `// dataset with a structure-of-arrays mirror S of the array-of-structures value T\n`;
+                out += `// the mirror is loaded from a received value before the onChange callback. soa() only reads it, writes go through\n`;
+                out += `// soaModify(), which stores the mirror back to value when its scope ends and marks the dataset as modified like modify().\n`;
+                out += `// publish() stores a mirror that is still open for writing, also when called through the base class\n`;
+                out += `template <typename T, typename S>\n`;
+                out += `class ${template.datamodel.structName}SoaDataset : public ${template.datamodel.datasetClassName}<T>\n`;
+                out += `{\n`;
+                out += `private:\n`;
+                out += `    S _soa = {};\n`;
+                out += `    bool _soaWritten = false;\n`;
+                out += `    void store() {\n`;
+                out += `        if (_soaWritten) {\n`;
+                out += `            exos_soa_store(_soa, this->value);\n`;
+                out += `            _soaWritten = false;\n`;
+                out += `        }\n`;
+                out += `    };\n`;
+                out += `\n`;
+                out += `public:\n`;
+                out += `    // write access to the mirror, e.g. {auto soa = dataset.soaModify(); soa->X[0] = 1;}\n`;
+                out += `    class Modify\n`;
+                out += `    {\n`;
+                out += `    private:\n`;
+                out += `        ${template.datamodel.structName}SoaDataset *_dataset;\n`;
+                out += `\n`;
+                out += `    public:\n`;
+                out += `        Modify(${template.datamodel.structName}SoaDataset *dataset) : _dataset(dataset) {_dataset->_soaWritten = true;};\n`;
+                out += `        Modify(Modify &&other) : _dataset(other._dataset) {other._dataset = nullptr;};\n`;
+                out += `        Modify(const Modify &) = delete;\n`;
+                out += `        Modify &operator=(const Modify &) = delete;\n`;
+                out += `        ~Modify() {\n`;
+                out += `            if (_dataset != nullptr) {\n`;
+                out += `                _dataset->store();\n`;
+                out += `                _dataset->modify();\n`;
+                out += `            }\n`;
+                out += `        };\n`;
+                out += `        S *operator->() {return &_dataset->_soa;};\n`;
+                out += `        S &operator*() {return _dataset->_soa;};\n`;
+                out += `    };\n`;
+                out += `\n`;
+                out += `    ${template.datamodel.structName}SoaDataset() {\n`;
+                out += `        this->_received = [this] () {\n`;
+                out += `            exos_soa_load(_soa, this->value);\n`;
+                out += `            _soaWritten = false;\n`;
+                out += `        };\n`;
+                out += `        this->_publishing = [this] () {store();};\n`;
+                out += `    };\n`;
+                out += `    const S& soa() const {return _soa;};\n`;
+                out += `    Modify soaModify() {return Modify(this);};\n`;
+                out += `    void soaModify(std::function<void(S&)> f) {\n`;
+                out += `        Modify soa(this);\n`;
+                out += `        f(*soa);\n`;
+                out += `    };\n`;
+                out += `};\n`;
+                out += `\n`;
+            }
+            if (qosHeaderName !== undefined) {
+                out += `#include "${qosHeaderName}"\n`;
+                out += `\n`;
+                out += `// dataset D with the quality of service from the .typ annotations: publish() rate limit, deadband and latest-value conflation\n`;
+                out += `// deferred publishes and conflated updates are handled in the datamodel process(), via flush() and dispatch()\n`;
+                out += `// F holds the deadbands of the members of a structure dataset\n`;
+                out += `template <typename D, typename F = exos_qos_no_members>\n`;
+                out += `class ${template.datamodel.structName}QosDataset : public D\n`;
+                out += `{\n`;
+                out += `private:\n`;
+                out += `    exos_qos_t _qos = {};\n`;
+                out += `    F _deadbands = {};\n`;
+                out += `    exos_datamodel_handle_t *_datamodel = nullptr;\n`;
+                out += `    std::function<void()> _onQosChange = [](){};\n`;
+                out += `\n`;
+                out += `public:\n`;
+                out += `    ${template.datamodel.structName}QosDataset() {\n`;
+                out += `        exos_qos_members_init(_deadbands);\n`;
+                out += `        D::onChange([this] () {\n`;
+                out += `            if (!exos_qos_deadband_value(&_qos, this->value) || !exos_qos_members(_deadbands, &_qos, this->value)) {\n`;
+                out += `                return;\n`;
+                out += `            }\n`;
+                out += `            if (_qos.latest) {\n`;
+                out += `                _qos.changed = true;\n`;
+                out += `                return;\n`;
+                out += `            }\n`;
+                out += `            _onQosChange();\n`;
+                out += `        });\n`;
+                out += `    };\n`;
+                out += `    void qos(int32_t rate, bool latest, double deadband, bool relative, double hysteresis) {\n`;
+                out += `        exos_qos_init(&_qos, rate, latest, deadband, relative, hysteresis);\n`;
+                out += `    };\n`;
+                out += `    // change the deadband of the value at runtime, 0 delivers every update\n`;
+                out += `    void deadband(double deadband, bool relative = false, double hysteresis = 0) {\n`;
+                out += `        _qos.filter.deadband = deadband;\n`;
+                out += `        _qos.filter.relative = relative;\n`;
+                out += `        _qos.filter.hysteresis = hysteresis;\n`;
+                out += `    };\n`;
+                out += `    // the deadbands of the members, which can be changed at runtime\n`;
+                out += `    F& deadbands() {return _deadbands;};\n`;
+                out += `    // number of updates that were not delivered because of a deadband\n`;
+                out += `    uint32_t suppressed() const {return _qos.suppressed;};\n`;
+                out += `    void init(exos_datamodel_handle_t *datamodel, const char *browse_name, ${template.loggerClassName}* _log) {\n`;
+                out += `        _datamodel = datamodel;\n`;
+                out += `        D::init(datamodel, browse_name, _log);\n`;
+                out += `    };\n`;
+                out += `    void publish() {\n`;
+                out += `        if (exos_qos_publish(&_qos, exos_datamodel_get_nettime(_datamodel))) {\n`;
+                out += `            D::publish();\n`;
+                out += `        }\n`;
+                out += `    };\n`;
+                out += `    void flush(int32_t nettime) {\n`;
+                out += `        if (exos_qos_flush(&_qos, nettime)) {\n`;
+                out += `            D::publish();\n`;
+                out += `        }\n`;
+                out += `    };\n`;
+                out += `    void dispatch() {\n`;
+                out += `        if (exos_qos_dispatch(&_qos)) {\n`;
+                out += `            _onQosChange();\n`;
+                out += `        }\n`;
+                out += `    };\n`;
+                out += `    void onChange(std::function<void()> f) {_onQosChange = std::move(f);};\n`;
+                out += `};\n`;
+                out += `\n`;
+            }
+            if (groupHeaderName !== undefined) {
+                out += `#include "${groupHeaderName}"\n`;
+                out += `\n`;
+                out += `// member dataset D of a publish group, marked as received in the group state.\n`;
+                out += `// Its onChange callback is held back until the group is complete, so that it never sees members of different publishes\n`;
+                out += `template <typename D>\n`;
+                out += `class ${template.datamodel.structName}GroupDataset : public D\n`;
+                out += `{\n`;
+                out += `private:\n`;
+                out += `    exos_group_t *_group = nullptr;\n`;
+                out += `    uint32_t _member = 0;\n`;
+                out += `    std::function<void()> _onMemberChange = [](){};\n`;
+                out += `\n`;
+                out += `public:\n`;
+                out += `    ${template.datamodel.structName}GroupDataset() {\n`;
+                out += `        D::onChange([this] () {\n`;
+                out += `            if (_group != nullptr) {\n`;
+                out += `                exos_group_received(_group, _member);\n`;
+                out += `            }\n`;
+                out += `        });\n`;
+                out += `    };\n`;
+                out += `    void group(exos_group_t *group, uint32_t member) {_group = group; _member = member;};\n`;
+                out += `    void deliver() {_onMemberChange();};\n`;
+                out += `    void onChange(std::function<void()> f) {_onMemberChange = std::move(f);};\n`;
+                out += `};\n`;
+                out += `\n`;
+                out += `// publish group with the member snapshot S\n`;
+                out += `// publish() publishes all members, then the next sequence number in the tag dataset\n`;
+                out += `// the receiver copies the members to snapshot and calls onGroupChange, then the onChange callbacks of the members,\n`;
+                out += `// once the tag arrives after all members\n`;
+                out += `template <typename S>\n`;
+                out += `class ${template.datamodel.structName}Group\n`;
+                out += `{\n`;
+                out += `private:\n`;
+                out += `    exos_group_t _state = {};\n`;
+                out += `    std::function<void()> _publish = [](){};\n`;
+                out += `    std::function<void(S&)> _copy = [](S&){};\n`;
+                out += `    std::function<void()> _deliver = [](){};\n`;
+                out += `    std::function<void()> _onGroupChange = [](){};\n`;
+                out += `\n`;
+                out += `public:\n`;
+                out += `    S snapshot = {};\n`;
+                out += `    void init(uint32_t members, std::function<void()> publish) {\n`;
+                out += `        exos_group_init(&_state, members);\n`;
+                out += `        _publish = std::move(publish);\n`;
+                out += `    };\n`;
+                out += `    void init(uint32_t members, std::function<void(S&)> copy, std::function<void()> deliver) {\n`;
+                out += `        exos_group_init(&_state, members);\n`;
+                out += `        _copy = std::move(copy);\n`;
+                out += `        _deliver = std::move(deliver);\n`;
+                out += `    };\n`;
+                out += `    exos_group_t *state() {return &_state;};\n`;
+                out += `    uint32_t next() {return exos_group_next(&_state);};\n`;
+                out += `    void tag(uint32_t sequence) {\n`;
+                out += `        if (exos_group_tag(&_state, sequence)) {\n`;
+                out += `            _copy(snapshot);\n`;
+                out += `            snapshot.sequence = sequence;\n`;
+                out += `            _onGroupChange();\n`;
+                out += `            _deliver();\n`;
+                out += `        }\n`;
+                out += `    };\n`;
+                out += `    void publish() {_publish();};\n`;
+                out += `    void onGroupChange(std::function<void()> f) {_onGroupChange = std::move(f);};\n`;
+                out += `    uint32_t complete() const {return _state.complete;};\n`;
+                out += `    uint32_t incomplete() const {return _state.incomplete;};\n`;
+                out += `    uint32_t skipped() const {return _state.skipped;};\n`;
+                out += `};\n`;
+                out += `\n`;
+            }
             out += `#endif\n`;
         
             return out;
         }
-        return generateExosDataSetHeader(this.template);
+        return generateExosDataSetHeader(this.template, this.soa !== undefined ? this.soa.soaHeader.name : undefined, this.qosHeaderName, this.processHeaderName, this.groupHeaderName, this.recorder !== undefined ? this.recorder.recorderHeader.name : undefined, this.mirror !== undefined ? this.mirror.mirrorHeader.name : undefined, this.metrics !== undefined ? this.metrics.metricsHeader.name : undefined, this.trace !== undefined ? this.trace.traceHeader.name : undefined, this.profile !== undefined ? this.profile.profileHeader.name : undefined);
     }
 
     /**
@@ -343,9 +839,16 @@ class TemplateCppLib extends Template {
     _generateDatamodelHeader() {
         /**
          * @param {ApplicationTemplate} template 
+         * @param {string} reflectionHeaderName name of the reflection header generated by the {@link Datamodel}
+         * @param {boolean} soa use the structure-of-arrays dataset class for arrays of structures
+         * @param {boolean} processModes generate setProcessMode() and processStats()
+         * @param {boolean} record replay recorded datasets in process()
+         * @param {boolean} mirror keep the latest value of the datasets in the shared memory mirror
+         * @param {string} [probeHeaderName] echo the round trip probes using this header
+         * @param {boolean} profile count the changes of the dataset members in the profile
          * @returns {string}
          */
-        function generateExosDataModelHeader(template) {
+        function generateExosDataModelHeader(template, reflectionHeaderName, soa, processModes, record, mirror, probeHeaderName, profile) {
         
             let out = "";
         
@@ -357,18 +860,71 @@ class TemplateCppLib extends Template {
             out += `#include <string.h>\n`;
             out += `#include <functional>\n`;
             out += `#include "${template.datamodel.datasetClassName}.hpp"\n`;
+            out += `#include "${reflectionHeaderName}"\n`;
+            if (probeHeaderName !== undefined) {
+                out += `#include "${probeHeaderName}"\n`;
+            }
             out += `\n`;
             out += `class ${template.datamodel.className}\n`;
             out += `{\n`;
+            out += `public:\n`;
+            out += `    struct SyncInfo\n`;
+            out += `    {\n`;
+            out += `        bool inSync = false;\n`;
+            out += `        uint32_t missedDmrCycles = 0;\n`;
+            out += `        uint32_t missedArCycles = 0;\n`;
+            out += `        EXOS_DATAMODEL_PROCESS_MODE processMode = EXOS_DATAMODEL_PROCESS_BLOCKING;\n`;
+            out += `        uint32_t syncChanges = 0; // number of sync state changes\n`;
+            out += `        int32_t syncChangedNettime = 0; // nettime of the last sync state change\n`;
+            out += `    };\n`;
+            out += `    struct PublishStats\n`;
+            out += `    {\n`;
+            out += `        uint32_t published = 0; // modified datasets published by process()\n`;
+            out += `        uint32_t suppressed = 0; // modified datasets not published by process(), as their value equals the last published value\n`;
+            out += `    };\n`;
+            out += `\n`;
             out += `private:\n`;
             out += `    exos_datamodel_handle_t datamodel = {};\n`;
+            out += `    SyncInfo _syncInfo;\n`;
+            out += `    PublishStats _publishStats;\n`;
+            if (processModes) {
+                out += `    exos_process_t _process = {};\n`;
+            }
+            if (mirror) {
+                out += `    ${TemplateLinuxMirror.mirrorPrefix(template)}_t* _mirror = nullptr;\n`;
+            }
+            if (probeHeaderName !== undefined) {
+                out += `    exos_probe_t _probe = {};\n`;
+            }
+            if (profile) {
+                out += `    ${TemplateLinuxProfile.profilePrefix(template)}_t* _profile = nullptr;\n`;
+            }
             out += `    std::function<void()> _onConnectionChange = [](){};\n`;
+            out += `    std::function<void()> _onSyncChange = [](){};\n`;
             out += `\n`;
+            out += `    void readSyncInfo();\n`;
+            out += `    template <typename D>\n`;
+            out += `    void publishModified(D &dataset) {\n`;
+            out += `        if (!dataset.modified()) {\n`;
+            out += `            return;\n`;
+            out += `        }\n`;
+            out += `        if (dataset.unchanged()) {\n`;
+            out += `            dataset.discard();\n`;
+            out += `            _publishStats.suppressed++;\n`;
+            out += `        }\n`;
+            out += `        else {\n`;
+            out += `            dataset.publish();\n`;
+            out += `            _publishStats.published++;\n`;
+            out += `        }\n`;
+            out += `    };\n`;
             out += `    void datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info);\n`;
             out += `    static void _datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info) {\n`;
             out += `        ${template.datamodel.className}* inst = static_cast<${template.datamodel.className}*>(datamodel->user_context);\n`;
             out += `        inst->datamodelEvent(datamodel, event_type, info);\n`;
             out += `    }\n`;
+            if (record) {
+                out += `    static void _replay(uint16_t index, int32_t nettime, const void *data, size_t size, void *context);\n`;
+            }
             out += `\n`;
             out += `public:\n`;
             out += `    ${template.datamodel.className}();\n`;
@@ -378,6 +934,19 @@ class TemplateCppLib extends Template {
             out += `    void setOperational();\n`;
             out += `    int getNettime();\n`;
             out += `    void onConnectionChange(std::function<void()> f) {_onConnectionChange = std::move(f);};\n`;
+            out += `    void onSyncChange(std::function<void()> f) {_onSyncChange = std::move(f);};\n`;
+            out += `    const SyncInfo &syncInfo() const {return _syncInfo;};\n`;
+            out += `    const PublishStats &publishStats() const {return _publishStats;};\n`;
+            if (processModes) {
+                out += `    void setProcessMode(exos_process_mode_t mode, uint32_t spinWindow = 0) {exos_process_set_mode(&_process, mode, spinWindow);};\n`;
+                out += `    const exos_process_stats_t &processStats() const {return _process.stats;};\n`;
+            }
+            if (probeHeaderName !== undefined) {
+                out += `    const exos_probe_stats_t &probeStats() const {return _probe.stats;};\n`;
+            }
+            if (profile) {
+                out += `    ${TemplateLinuxProfile.profilePrefix(template)}_t *profile() {return _profile;};\n`;
+            }
             out += `\n`;
             out += `    bool isOperational = false;\n`;
             out += `    bool isConnected = false;\n`;
@@ -394,9 +963,23 @@ class TemplateCppLib extends Template {
                     if(Datamodel.isScalarType(dataset)){
                         dataType = Datamodel.convertPlcType(dataType);
                     }
-                    out += `    ${template.datamodel.datasetClassName}<${dataType}${dataset.arraySize > 0 ? '['+dataset.arraySize+']' : ''}${dataset.stringLength && dataset.stringLength > 0 ? '['+dataset.stringLength+']' : ''}> ${dataset.structName};\n`;
+                    let datasetClass = `${template.datamodel.datasetClassName}<${dataType}${dataset.arraySize > 0 ? '['+dataset.arraySize+']' : ''}${dataset.stringLength && dataset.stringLength > 0 ? '['+dataset.stringLength+']' : ''}>`;
+                    if (soa && TemplateSoa.isSoaDataset(dataset)) {
+                        datasetClass = `${template.datamodel.structName}SoaDataset<${dataType}[${dataset.arraySize}], ${TemplateSoa.soaTypeName(template, dataset)}>`;
+                    }
+                    if (dataset.qos !== undefined) {
+                        datasetClass = `${template.datamodel.structName}QosDataset<${datasetClass}${dataset.qos.filters.length > 0 ? `, ${Template.qosDeadbandPrefix(template, dataset)}_t` : ""}>`;
+                    }
+                    let group = Template.datasetGroup(template, dataset);
+                    if (group !== undefined && group.isSub && group.tag !== dataset) {
+                        datasetClass = `${template.datamodel.structName}GroupDataset<${datasetClass}>`;
+                    }
+                    out += `    ${datasetClass} ${dataset.structName};\n`;
                 }
             }
+            for (let group of template.groups) {
+                out += `    ${template.datamodel.structName}Group<${group.snapshotType}> ${group.name};\n`;
+            }
             out += `\n`;
             out += `    ~${template.datamodel.className}();\n`;
             out += `};\n`;
@@ -405,7 +988,7 @@ class TemplateCppLib extends Template {
         
             return out;
         }
-        return generateExosDataModelHeader(this.template);
+        return generateExosDataModelHeader(this.template, this.datamodel.reflectionFile.name, this.soa !== undefined, this.processHeaderName !== undefined, this.recorder !== undefined, this.mirror !== undefined, this.probe !== undefined ? this.probe.probeHeader.name : undefined, this.profile !== undefined);
     }
 
     /**
@@ -415,10 +998,19 @@ class TemplateCppLib extends Template {
         /**
          * 
          * @param {ApplicationTemplate} template 
-         * @param {string} aliasName 
+         * @param {boolean} processModes implement the process modes
+         * @param {boolean} record set the dataset indexes of the recording and replay recorded datasets
+         * @param {string} [mirrorHeaderName] create the latest value mirror of this header and write the datasets to it
+         * @param {boolean} metrics set the dataset indexes of the metrics and update the connection state and sync diagnostics
+         * @param {boolean} trace trace process() and dump the trace at its end
+         * @param {boolean} probe echo the round trip probes in process()
+         * @param {string} [profileHeaderName] create the change-frequency profile of this header and count the changes of the datasets in it
          * @returns 
          */
-        function generateExosDataModelCpp(template) {
+        function generateExosDataModelCpp(template, processModes, record, mirrorHeaderName, metrics, trace, probe, profileHeaderName) {
+
+            let mirrorPrefix = TemplateLinuxMirror.mirrorPrefix(template);
+            let profilePrefix = TemplateLinuxProfile.profilePrefix(template);
         
             let out = "";
         
@@ -432,15 +1024,97 @@ class TemplateCppLib extends Template {
             out += `\n`;
             out += `    exos_assert_ok((&log), exos_datamodel_init(&datamodel, "${template.datamodelInstanceName}", "${template.aliasName}"));\n`;
             out += `    datamodel.user_context = this;\n`;
+            if (probe) {
+                out += `    exos_assert_ok((&log), exos_probe_init(&_probe));\n`;
+            }
             out += `\n`;
+            if (mirrorHeaderName !== undefined) {
+                out += `    // other processes read the latest value of the datasets from the mirror (see ${mirrorHeaderName})\n`;
+                out += `    _mirror = ${mirrorPrefix}_create(${TemplateLinuxMirror.mirrorNameDefine(template)});\n`;
+                out += `    if (nullptr == _mirror) {\n`;
+                out += `        log.error << "cannot create the mirror " << ${TemplateLinuxMirror.mirrorNameDefine(template)} << std::endl;\n`;
+                out += `    }\n`;
+                out += `\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `    // the profile is enabled with ${profilePrefix}_setup(profile(), ..) (see ${profileHeaderName})\n`;
+                out += `    _profile = ${profilePrefix}_create();\n`;
+                out += `    if (nullptr == _profile) {\n`;
+                out += `        log.error << "cannot allocate the profile" << std::endl;\n`;
+                out += `    }\n`;
+                out += `\n`;
+            }
             for (let dataset of template.datasets) {
                 if (dataset.isPub || dataset.isSub) {
                     out += `    ${dataset.structName}.init(&datamodel, "${dataset.structName}", &log);\n`;
+                    if (processModes && dataset.isSub) {
+                        out += `    ${dataset.structName}.measureLatency(&_process);\n`;
+                    }
+                    if (record) {
+                        out += `    ${dataset.structName}.recordIndex(${template.datasets.indexOf(dataset)});\n`;
+                    }
+                    if (mirrorHeaderName !== undefined) {
+                        out += `    ${dataset.structName}.mirrorTo(_mirror, ${template.datasets.indexOf(dataset)});\n`;
+                    }
+                    if (profileHeaderName !== undefined) {
+                        out += `    ${dataset.structName}.profileTo(_profile, ${template.datasets.indexOf(dataset)});\n`;
+                    }
+                    if (metrics) {
+                        out += `    ${dataset.structName}.metricsIndex(${template.datasets.indexOf(dataset)});\n`;
+                    }
+                }
+            }
+            let qosDatasets = Template.qosDatasets(template.datasets);
+            if (qosDatasets.length > 0) {
+                out += `\n`;
+                out += `    // quality of service from the .typ annotations: rate (us), latest, deadband, relative, hysteresis\n`;
+                for (let dataset of qosDatasets) {
+                    out += `    ${dataset.structName}.qos(${dataset.qos.rate}, ${dataset.qos.latest}, ${dataset.qos.deadband}, ${dataset.qos.relative}, ${dataset.qos.hysteresis});\n`;
+                }
+            }
+            for (let group of template.groups) {
+                out += `\n`;
+                if (group.isPub) {
+                    out += `    // publish group ${group.name}: the members, then the next sequence number in ${group.tag.structName}\n`;
+                    out += `    ${group.name}.init(${group.members.length}, [this] () {\n`;
+                    for (let member of group.members) {
+                        out += `        ${member.structName}.publish();\n`;
+                    }
+                    out += `        ${group.tag.structName}.value = ${group.name}.next();\n`;
+                    out += `        ${group.tag.structName}.publish();\n`;
+                    out += `    });\n`;
+                }
+                else {
+                    out += `    // publish group ${group.name}: the members are copied to the snapshot once ${group.tag.structName} arrives after all of them\n`;
+                    out += `    ${group.name}.init(${group.members.length}, [this] (${group.snapshotType} &snapshot) {\n`;
+                    for (let member of group.members) {
+                        out += `        memcpy(&snapshot.${member.structName}, &${member.structName}.value, sizeof(snapshot.${member.structName}));\n`;
+                    }
+                    out += `    }, [this] () {\n`;
+                    for (let member of group.members) {
+                        out += `        ${member.structName}.deliver();\n`;
+                    }
+                    out += `    });\n`;
+                    group.members.forEach((member, index) => {
+                        out += `    ${member.structName}.group(${group.name}.state(), ${index});\n`;
+                    });
+                    out += `    ${group.tag.structName}.onChange([this] () {${group.name}.tag(${group.tag.structName}.value);});\n`;
                 }
             }
             out += `}\n`;
             out += `\n`;
             out += `void ${template.datamodel.className}::connect() {\n`;
+            if (record) {
+                out += `    if (rec_replaying()) {\n`;
+                out += `        // replaying instead of connecting to the DMR\n`;
+                out += `        datamodel.connection_state = EXOS_STATE_CONNECTED;\n`;
+                out += `        datamodelEvent(&datamodel, EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED, nullptr);\n`;
+                out += `        datamodel.connection_state = EXOS_STATE_OPERATIONAL;\n`;
+                out += `        datamodelEvent(&datamodel, EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED, nullptr);\n`;
+                out += `        return;\n`;
+                out += `    }\n`;
+                out += `\n`;
+            }
             out += `    exos_assert_ok((&log), exos_datamodel_connect_${template.datamodel.structName.toLowerCase()}(&datamodel, &${template.datamodel.className}::_datamodelEvent));\n`;
             out += `\n`;
             for (let dataset of template.datasets) {
@@ -454,31 +1128,151 @@ class TemplateCppLib extends Template {
                     out += `    ${dataset.structName}.connect((EXOS_DATASET_TYPE)EXOS_DATASET_SUBSCRIBE);\n`;
                 }
             }
+            if (probe) {
+                out += `\n`;
+                out += `    // round trip probe of AR, in its own datamodel\n`;
+                out += `    exos_assert_ok((&log), exos_probe_connect(&_probe));\n`;
+            }
             out += `}\n`;
             out += `\n`;
             out += `void ${template.datamodel.className}::disconnect() {\n`;
+            if (record) {
+                out += `    if (rec_replaying()) {\n`;
+                out += `        return;\n`;
+                out += `    }\n`;
+            }
             out += `    exos_assert_ok((&log), exos_datamodel_disconnect(&datamodel));\n`;
+            if (probe) {
+                out += `    exos_assert_ok((&log), exos_probe_disconnect(&_probe));\n`;
+            }
             out += `}\n`;
             out += `\n`;
             out += `void ${template.datamodel.className}::setOperational() {\n`;
+            if (record) {
+                out += `    if (rec_replaying()) {\n`;
+                out += `        return;\n`;
+                out += `    }\n`;
+            }
             out += `    exos_assert_ok((&log), exos_datamodel_set_operational(&datamodel));\n`;
+            if (probe) {
+                out += `    exos_assert_ok((&log), exos_probe_set_operational(&_probe));\n`;
+            }
             out += `}\n`;
             out += `\n`;
             out += `void ${template.datamodel.className}::process() {\n`;
-            out += `    exos_assert_ok((&log), exos_datamodel_process(&datamodel));\n`;
+            if (trace) {
+                out += `    trace_process_begin(exos_datamodel_get_nettime(&datamodel));\n`;
+                out += `\n`;
+            }
+            let flush = qosDatasets.filter(dataset => dataset.qos.rate > 0);
+            if (flush.length > 0) {
+                out += `    // quality of service: deferred publishes, in order of priority\n`;
+                out += `    int32_t nettime = exos_datamodel_get_nettime(&datamodel);\n`;
+                for (let dataset of flush) {
+                    out += `    ${dataset.structName}.flush(nettime);\n`;
+                }
+                out += `\n`;
+            }
+            let modified = TemplateCppLib.modifiedDatasets(template);
+            if (modified.length > 0) {
+                out += `    // datasets changed with modify(), published once per cycle in declaration order\n`;
+                out += `    if (isConnected) {\n`;
+                for (let dataset of modified) {
+                    out += `        publishModified(${dataset.structName});\n`;
+                }
+                out += `    }\n`;
+                out += `\n`;
+            }
+            let dmr = "";
+            if (processModes) {
+                dmr += `    exos_assert_ok((&log), exos_process_begin(&_process, &datamodel));\n`;
+            }
+            dmr += `    exos_assert_ok((&log), exos_datamodel_process(&datamodel));\n`;
+            if (processModes) {
+                dmr += `    exos_process_end(&_process);\n`;
+            }
+            dmr += `    readSyncInfo();\n`;
+            if (probe) {
+                dmr += `    // echo the round trip probes of AR right away\n`;
+                dmr += `    exos_assert_ok((&log), exos_probe_process(&_probe));\n`;
+            }
+            if (record) {
+                out += `    if (rec_replaying()) {\n`;
+                out += `        // deliver the next recorded cycle instead of processing the DMR\n`;
+                out += `        rec_replay_process(&${template.datamodel.className}::_replay, this);\n`;
+                out += `        rec_cycle(rec_replay_nettime());\n`;
+                out += `    }\n`;
+                out += `    else {\n`;
+                out += dmr.replace(/^    /gm, `        `);
+                out += `        rec_cycle(exos_datamodel_get_nettime(&datamodel));\n`;
+                out += `    }\n`;
+            }
+            else {
+                out += dmr;
+            }
+            let dispatch = qosDatasets.filter(dataset => dataset.qos.latest);
+            if (dispatch.length > 0) {
+                out += `\n`;
+                out += `    // quality of service: conflated updates, in order of priority\n`;
+                for (let dataset of dispatch) {
+                    out += `    ${dataset.structName}.dispatch();\n`;
+                }
+                out += `\n`;
+            }
             out += `    log.process();\n`;
+            if (trace) {
+                out += `\n`;
+                out += `    // a dump of the trace is written here, if requested or above the threshold\n`;
+                out += `    trace_process_end(exos_datamodel_get_nettime(&datamodel));\n`;
+            }
             out += `}\n`;
             out += `\n`;
             out += `int ${template.datamodel.className}::getNettime() {\n`;
+            if (record) {
+                out += `    if (rec_replaying()) {\n`;
+                out += `        return rec_replay_nettime();\n`;
+                out += `    }\n`;
+            }
             out += `    return exos_datamodel_get_nettime(&datamodel);\n`;
             out += `}\n`;
             out += `\n`;
+            if (record) {
+                out += `// deliver a replayed dataset with the dataset index of the recording\n`;
+                out += `void ${template.datamodel.className}::_replay(uint16_t index, int32_t nettime, const void *data, size_t size, void *context) {\n`;
+                out += `    ${template.datamodel.className}* inst = static_cast<${template.datamodel.className}*>(context);\n`;
+                out += `    switch (index) {\n`;
+                for (let dataset of template.datasets) {
+                    if (dataset.isSub) {
+                        out += `        case ${template.datasets.indexOf(dataset)}:\n`;
+                        out += `            inst->${dataset.structName}.replay(nettime, data, size);\n`;
+                        out += `            break;\n`;
+                    }
+                }
+                out += `        default:\n`;
+                out += `            break;\n`;
+                out += `    }\n`;
+                out += `}\n`;
+                out += `\n`;
+            }
+            out += `void ${template.datamodel.className}::readSyncInfo() {\n`;
+            out += `    _syncInfo.inSync = datamodel.sync_info.in_sync;\n`;
+            out += `    _syncInfo.missedDmrCycles = datamodel.sync_info.missed_dmr_cycles;\n`;
+            out += `    _syncInfo.missedArCycles = datamodel.sync_info.missed_ar_cycles;\n`;
+            out += `    _syncInfo.processMode = datamodel.sync_info.process_mode;\n`;
+            if (metrics) {
+                out += `    metrics_sync(datamodel.sync_info.missed_dmr_cycles, datamodel.sync_info.missed_ar_cycles);\n`;
+            }
+            out += `}\n`;
+            out += `\n`;
             out += `void ${template.datamodel.className}::datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info) {\n`;
             out += `    switch (event_type)\n`;
             out += `    {\n`;
             out += `    case EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED:\n`;
             out += `        log.info << "application changed state to " << exos_get_state_string(datamodel->connection_state) << std::endl;\n`;
             out += `        connectionState = datamodel->connection_state;\n`;
+            if (metrics) {
+                out += `        metrics_connection(datamodel->connection_state);\n`;
+            }
             out += `        _onConnectionChange();\n`;
             out += `        switch (datamodel->connection_state)\n`;
             out += `        {\n`;
@@ -501,6 +1295,11 @@ class TemplateCppLib extends Template {
             out += `        }\n`;
             out += `        break;\n`;
             out += `    case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:\n`;
+            out += `        log.info << "application sync state changed to " << (datamodel->sync_info.in_sync ? "in sync" : "out of sync") << ", missed DMR cycles: " << datamodel->sync_info.missed_dmr_cycles << ", missed AR cycles: " << datamodel->sync_info.missed_ar_cycles << std::endl;\n`;
+            out += `        readSyncInfo();\n`;
+            out += `        _syncInfo.syncChanges++;\n`;
+            out += `        _syncInfo.syncChangedNettime = exos_datamodel_get_nettime(datamodel);\n`;
+            out += `        _onSyncChange();\n`;
             out += `        break;\n\n`;
             out += `    default:\n`;
             out += `        break;\n\n`;
@@ -510,11 +1309,21 @@ class TemplateCppLib extends Template {
             out += `${template.datamodel.className}::~${template.datamodel.className}()\n`;
             out += `{\n`;
             out += `    exos_assert_ok((&log), exos_datamodel_delete(&datamodel));\n`;
+            if (probe) {
+                out += `    exos_assert_ok((&log), exos_probe_delete(&_probe));\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `    ${mirrorPrefix}_destroy(_mirror, ${TemplateLinuxMirror.mirrorNameDefine(template)});\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `    // the report is written here, if started with --profile <path>\n`;
+                out += `    ${profilePrefix}_destroy(_profile);\n`;
+            }
             out += `}\n`;
         
             return out;
         }
-        return generateExosDataModelCpp(this.template);
+        return generateExosDataModelCpp(this.template, this.processHeaderName !== undefined, this.recorder !== undefined, this.mirror !== undefined ? this.mirror.mirrorHeader.name : undefined, this.metrics !== undefined, this.trace !== undefined, this.probe !== undefined, this.profile !== undefined ? this.profile.profileHeader.name : undefined);
     }
 
     /**
@@ -527,9 +1336,13 @@ class TemplateCppLib extends Template {
          * @param {ApplicationTemplate} template
          * 
          * @param {boolean} isLinux 
+         * @param {boolean} soa describe the structure-of-arrays mirrors
+         * @param {boolean} probe describe the round trip probe
+         * @param {boolean} profile describe the change-frequency profile
+         * @param {boolean} processModes describe the process modes
          * @returns {string}
          */
-        function genenerateLegend(template, isLinux) {
+        function genenerateLegend(template, isLinux, soa, probe, profile, processModes) {
             let dmDelim = isLinux ? "." : "->";
             let out = "";
         
@@ -546,9 +1359,44 @@ class TemplateCppLib extends Template {
             out += `    ${template.datamodel.varName}${dmDelim}onConnectionChange([&] () {\n`;
             out += `        // ${template.datamodel.varName}${dmDelim}connectionState ...\n`;
             out += `    })\n`;
+            out += `    ${template.datamodel.varName}${dmDelim}onSyncChange([&] () {\n`;
+            out += `        // ${template.datamodel.varName}${dmDelim}syncInfo().inSync ...\n`;
+            out += `    })\n`;
             out += `\nboolean values:\n`
             out += `    ${template.datamodel.varName}${dmDelim}isConnected\n`;
             out += `    ${template.datamodel.varName}${dmDelim}isOperational\n`;
+            out += `\nsync diagnostics (updated in process() and before onSyncChange):\n`
+            out += `    ${template.datamodel.varName}${dmDelim}syncInfo().inSync : (bool) datamodel is in sync with the DMR\n`;
+            out += `    ${template.datamodel.varName}${dmDelim}syncInfo().missedDmrCycles : (uint32_t) cycles missed by the DMR\n`;
+            out += `    ${template.datamodel.varName}${dmDelim}syncInfo().missedArCycles : (uint32_t) cycles missed by AR\n`;
+            out += `    ${template.datamodel.varName}${dmDelim}syncInfo().processMode : (EXOS_DATAMODEL_PROCESS_MODE) current process mode\n`;
+            out += `    ${template.datamodel.varName}${dmDelim}syncInfo().syncChanges : (uint32_t) number of sync state changes\n`;
+            out += `    ${template.datamodel.varName}${dmDelim}syncInfo().syncChangedNettime : (int32_t) nettime of the last sync state change\n`;
+            if (processModes) {
+                out += `\nprocess modes:\n`
+                out += `    ${template.datamodel.varName}${dmDelim}setProcessMode(EXOS_PROCESS_BLOCKING) : process() blocks until the next DMR cycle (default)\n`;
+                out += `    ${template.datamodel.varName}${dmDelim}setProcessMode(EXOS_PROCESS_NON_BLOCKING) : process() returns immediately, for use in your own loop\n`;
+                out += `    ${template.datamodel.varName}${dmDelim}setProcessMode(EXOS_PROCESS_ADAPTIVE, 500) : process() polls for 500us after each DMR cycle, then blocks\n`;
+                out += `    ${template.datamodel.varName}${dmDelim}processStats() : (exos_process_stats_t) measurements of the current mode, updated in process()\n`;
+                out += `        processStats().cpu_load : (double) CPU use (percent) of the thread calling process()\n`;
+                out += `        processStats().latency_avg, processStats().latency_max : delivery latency (us) of the received datasets\n`;
+            }
+            if (probe) {
+                out += `\nround trip probe (the requests of AR are echoed in process()):\n`
+                out += `    ${template.datamodel.varName}${dmDelim}probeStats() : (exos_probe_stats_t) measurements of the probe, updated in process()\n`;
+                out += `        probeStats().requests, probeStats().lost : (uint32_t) requests received, and skipped sequence numbers\n`;
+                out += `        probeStats().uplink : (int32_t) time (us) from AR to Linux of the last request\n`;
+            }
+            if (profile) {
+                out += `\nchange-frequency profile (enabled with --profile <path>, reported when the datamodel is destroyed):\n`
+                out += `    ${template.datamodel.varName}${dmDelim}profile() : (${TemplateLinuxProfile.profilePrefix(template)}_t *) changes of the dataset members\n`;
+                out += `        ${TemplateLinuxProfile.profilePrefix(template)}_report(${template.datamodel.varName}${dmDelim}profile(), stdout) : report the members ranked by changes now\n`;
+            }
+            if (TemplateCppLib.modifiedDatasets(template).length > 0) {
+                out += `\npublish on modify (datasets changed with modify() are published once in the next process(), if their value changed):\n`
+                out += `    ${template.datamodel.varName}${dmDelim}publishStats().published : (uint32_t) modified datasets published by process()\n`;
+                out += `    ${template.datamodel.varName}${dmDelim}publishStats().suppressed : (uint32_t) modified datasets not published, as their value equals the last published value\n`;
+            }
             out += `\nlogging methods:\n`
             out += `    ${template.datamodel.varName}${dmDelim}log.error << "some value:" << 1 << std::endl;\n`;
             out += `    ${template.datamodel.varName}${dmDelim}log.warning << "some value:" << 1 << std::endl;\n`;
@@ -556,12 +1404,20 @@ class TemplateCppLib extends Template {
             out += `    ${template.datamodel.varName}${dmDelim}log.info << "some value:" << 1 << std::endl;\n`;
             out += `    ${template.datamodel.varName}${dmDelim}log.debug << "some value:" << 1 << std::endl;\n`;
             out += `    ${template.datamodel.varName}${dmDelim}log.verbose << "some value:" << 1 << std::endl;\n`;  
+            out += `\ntype reflection:\n`
+            out += `    exos_reflection::for_each_member(${template.datamodel.varName}${dmDelim}<dataset>.value, [&] (const exos_reflection::MemberInfo &member, auto &field) {\n`;
+            out += `        // member.name, member.offset, member.arraySize ...\n`;
+            out += `    })\n`;
             for (let dataset of template.datasets) {
                 if (dataset.isSub || dataset.isPub) {
                     out += `\ndataset ${dataset.structName}:\n`;
                     
                     if (dataset.isPub) {
                         out += `    ${template.datamodel.varName}${dmDelim}${dataset.structName}.publish()\n`;
+                        if (TemplateCppLib.modifiedDatasets(template).includes(dataset)) {
+                            out += `    ${template.datamodel.varName}${dmDelim}${dataset.structName}.modify() : value for writing, published once in the next process() if it changed\n`;
+                            out += `        (compared with the last published value, writes to value itself are not tracked)\n`;
+                        }
                     }
                     if (dataset.isSub) {
                         out += `    ${template.datamodel.varName}${dmDelim}${dataset.structName}.onChange([&] () {\n`;
@@ -585,13 +1441,69 @@ class TemplateCppLib extends Template {
                     else {
                         out += `s\n`;
                     }
+                    if (soa && TemplateSoa.isSoaDataset(dataset)) {
+                        out += `    ${template.datamodel.varName}${dmDelim}${dataset.structName}.soa() : (${TemplateSoa.soaTypeName(template, dataset)}) structure-of-arrays mirror, one array per member\n`;
+                        if (dataset.isSub) {
+                            out += `        loaded from value before the onChange callback\n`;
+                        }
+                        if (dataset.isPub) {
+                            out += `    ${template.datamodel.varName}${dmDelim}${dataset.structName}.soaModify() : write access to the mirror, stored to value and marked as modified at the end of the scope\n`;
+                        }
+                    }
+                    if (dataset.qos !== undefined) {
+                        out += `    quality of service:\n`;
+                        for (let line of Template.qosDescription(dataset.qos)) {
+                            out += `        ${line}\n`;
+                        }
+                        if (dataset.qos.deadband > 0) {
+                            out += `    ${template.datamodel.varName}${dmDelim}${dataset.structName}.deadband(double deadband, bool relative, double hysteresis) : change the deadband at runtime\n`;
+                        }
+                        if (dataset.qos.filters.length > 0) {
+                            out += `    ${template.datamodel.varName}${dmDelim}${dataset.structName}.deadbands() : (${Template.qosDeadbandPrefix(template, dataset)}_t&) member deadbands, e.g. deadbands().${dataset.qos.filters[0].name}.deadband\n`;
+                        }
+                        if (Template.qosHasDeadband(dataset)) {
+                            out += `    ${template.datamodel.varName}${dmDelim}${dataset.structName}.suppressed() : (uint32_t) number of updates not delivered because of a deadband\n`;
+                        }
+                    }
+                    let group = Template.datasetGroup(template, dataset);
+                    if (group !== undefined) {
+                        out += `    ${group.tag === dataset ? "sequence number" : "member"} of publish group ${group.name}\n`;
+                    }
+                }
+            }
+            for (let group of template.groups) {
+                out += `\npublish group ${group.name} (${group.members.map(member => member.structName).join(", ")}):\n`;
+                if (group.isPub) {
+                    out += `    ${template.datamodel.varName}${dmDelim}${group.name}.publish() : publish all members, then the next sequence number in ${group.tag.structName}\n`;
+                }
+                else {
+                    out += `    ${template.datamodel.varName}${dmDelim}${group.name}.onGroupChange([&] () {\n`;
+                    out += `        ${template.datamodel.varName}${dmDelim}${group.name}.snapshot.${group.members[0].structName} ...\n`;
+                    out += `    })\n`;
+                    out += `    ${template.datamodel.varName}${dmDelim}${group.name}.snapshot : (${group.snapshotType}) consistent copy of the members, with the sequence number\n`;
+                    out += `    the onChange callbacks of the members are held back and called after onGroupChange\n`;
+                    out += `    ${template.datamodel.varName}${dmDelim}${group.name}.incomplete() : (uint32_t) groups not delivered because a member was missing\n`;
+                    out += `    ${template.datamodel.varName}${dmDelim}${group.name}.skipped() : (uint32_t) sequence numbers that were never received\n`;
                 }
+                out += `    ${template.datamodel.varName}${dmDelim}${group.name}.complete() : (uint32_t) number of ${group.isPub ? "published" : "delivered"} groups\n`;
             }
             out += `*/\n\n`;
         
             return out;
         }
-        return genenerateLegend(this.template, this.isLinux);
+        return genenerateLegend(this.template, this.isLinux, this.soa !== undefined, this.probe !== undefined, this.profile !== undefined, this.processHeaderName !== undefined);
+    }
+
+    /**
+     * Published datasets that `process()` publishes after `modify()`, in declaration order.
+     * 
+     * Members and tags of publish groups are left out, they are published with the group.
+     * 
+     * @param {ApplicationTemplate} template 
+     * @returns {ApplicationTemplateDataset[]}
+     */
+    static modifiedDatasets(template) {
+        return template.datasets.filter(dataset => dataset.isPub && Template.datasetGroup(template, dataset) === undefined);
     }
 }
 
@@ -0,0 +1,349 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const { Datamodel, GeneratedFileObj } = require('../../datamodel');
+const { Template, ApplicationTemplate } = require('./template')
+
+class TemplateProbe extends Template {
+
+    /**
+     * header with the round trip probe
+     * @type {GeneratedFileObj}
+     */
+    probeHeader;
+
+    /**
+     * {@linkcode TemplateProbe} Generate the round trip probe between AR and Linux (`probe` feature)
+     *
+     * The probe is a hidden datamodel instance next to the one of the application, so that the datatype in the .typ file
+     * stays as it is. It has two datasets: `ProbeRequest`, published by AR, and `ProbeReply`, published by Linux.
+     * AR stamps a sequence number and its nettime in the request periodically, Linux echoes it right away from the thread
+     * calling process(), adding its own nettime, and AR measures the round trip time when the reply arrives.
+     * As the nettime is the same on AR and Linux, the one-way times are estimated from the nettimes of the echo.
+     *
+     * The header is plain C with inline functions, generated for the side given with `Linux`, and for C++ it is included as is.
+     *
+     * Generates following {@link GeneratedFileObj}
+     * - {@linkcode probeHeader}
+     *
+     * @param {Datamodel} datamodel
+     * @param {boolean} Linux true if generated for Linux (echoing the requests), false for AR (sending the requests)
+     */
+    constructor(datamodel, Linux) {
+        super(datamodel, Linux);
+
+        this.probeHeader = {name:`exos_${this.datamodel.typeName.toLowerCase()}_probe.h`, contents:this._generateProbeHeader(Linux), description:`${this.datamodel.typeName} round trip probe`};
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @returns {string} name of the hidden datamodel instance of the probe, to be declared in the .exospkg
+     */
+    static datamodelInstanceName(template) {
+        return `${template.datamodelInstanceName}_Probe`;
+    }
+
+    /**
+     * @param {boolean} Linux
+     * @returns {string} `exos_[typename]_probe.h`
+     */
+    _generateProbeHeader(Linux) {
+
+        /**
+         * @returns {string} configuration of the probe datamodel, in the format of the configuration generated by the {@link Datamodel}
+         */
+        function probeConfig() {
+            let infoId = 0;
+            let stamp = (name, comment) => {
+                let dataset = {name: "struct", attributes: {name: name, dataType: "ExosProbeStamp", comment: comment, info: `<infoId${++infoId}>`}, children: []};
+                for (let [member, dataType] of [["Sequence", "UDINT"], ["RequestNettime", "DINT"], ["EchoNettime", "DINT"]]) {
+                    dataset.children.push({name: "variable", attributes: {name: member, dataType: dataType, info: `<infoId${++infoId}>`}});
+                }
+                return dataset;
+            };
+            let probe = {name: "struct", attributes: {name: "<NAME>", dataType: "ExosProbe", info: `<infoId${infoId}>`}, children: []};
+            probe.children.push(stamp("ProbeRequest", "PUB"));
+            probe.children.push(stamp("ProbeReply", "SUB"));
+            return JSON.stringify(probe).split('"').join('\\"');
+        }
+
+        /**
+         * @param {ApplicationTemplate} template
+         * @param {boolean} Linux
+         * @returns {string}
+         */
+        function generateProbeHeader(template, Linux) {
+            let guard = `_EXOS_COMP_${template.datamodel.structName.toUpperCase()}_PROBE_H_`;
+            let out = "";
+
+            out += `#ifndef ${guard}\n`;
+            out += `#define ${guard}\n\n`;
+            out += `#include <stdint.h>\n`;
+            out += `#include <stdbool.h>\n`;
+            out += `#include <string.h>\n`;
+            out += `#include "exos_api.h"\n\n`;
+
+            out += `/*Round trip probe of the ${template.datamodel.structName} datamodel, in the hidden datamodel instance ${TemplateProbe.datamodelInstanceName(template)}:\n`;
+            out += `    ProbeRequest    published by AR every period, with the next sequence number and the nettime of AR\n`;
+            out += `    ProbeReply      published by Linux as soon as the request is received in process(), with the nettime of Linux added\n`;
+            out += `The round trip time is measured by AR when the reply of the last request arrives. The nettime is the same on AR and Linux,\n`;
+            out += `so the time from AR to Linux (uplink) and back (downlink) is estimated from the nettime of the echo.\n`;
+            out += `A request that is not answered before the next one is sent is counted as lost (by AR), as well as sequence numbers\n`;
+            out += `that never arrived (by Linux)\n`;
+            out += `*/\n`;
+            out += `typedef struct ExosProbeStamp\n{\n`;
+            out += `    uint32_t Sequence;\n`;
+            out += `    int32_t RequestNettime;\n`;
+            out += `    int32_t EchoNettime;\n`;
+            out += `} ExosProbeStamp;\n\n`;
+
+            out += `typedef struct ExosProbe\n{\n`;
+            out += `    ExosProbeStamp ProbeRequest;\n`;
+            out += `    ExosProbeStamp ProbeReply;\n`;
+            out += `} ExosProbe;\n\n`;
+
+            out += `/*Measurements since the probe was initialized:\n`;
+            if (Linux) {
+                out += `    requests        requests received\n`;
+                out += `    replies         requests echoed\n`;
+                out += `    lost            sequence numbers that were skipped\n`;
+                out += `    uplink          time (us) from AR to Linux of the last request\n`;
+                out += `The round trip times and the downlink are measured on AR, and are 0 here\n`;
+            }
+            else {
+                out += `    requests        requests published\n`;
+                out += `    replies         replies received to the last request\n`;
+                out += `    lost            requests not answered before the next one was published\n`;
+                out += `    rtt             round trip time (us) of the last reply, rtt_min, rtt_max and rtt_avg since the start\n`;
+                out += `    uplink          time (us) from AR to Linux of the last reply\n`;
+                out += `    downlink        time (us) from Linux to AR of the last reply\n`;
+            }
+            out += `*/\n`;
+            out += `typedef struct exos_probe_stats\n{\n`;
+            out += `    uint32_t requests;\n`;
+            out += `    uint32_t replies;\n`;
+            out += `    uint32_t lost;\n`;
+            out += `    int32_t rtt;\n`;
+            out += `    int32_t rtt_min;\n`;
+            out += `    int32_t rtt_max;\n`;
+            out += `    int32_t rtt_avg;\n`;
+            out += `    int32_t uplink;\n`;
+            out += `    int32_t downlink;\n`;
+            out += `} exos_probe_stats_t;\n\n`;
+
+            out += `typedef struct exos_probe\n{\n`;
+            out += `    exos_datamodel_handle_t datamodel;\n`;
+            out += `    exos_dataset_handle_t request;\n`;
+            out += `    exos_dataset_handle_t reply;\n`;
+            out += `    ExosProbe data;\n`;
+            out += `    exos_probe_stats_t stats;\n`;
+            if (!Linux) {
+                out += `\n`;
+                out += `    int32_t next_request;\n`;
+                out += `    bool pending;\n`;
+                out += `    int64_t rtt_sum;\n`;
+            }
+            out += `} exos_probe_t;\n\n`;
+
+            if (!Linux) {
+                out += `/*default time (us) between two requests*/\n`;
+                out += `#define EXOS_PROBE_PERIOD 10000\n\n`;
+            }
+
+            out += `static inline void exos_probe_datamodel_event(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info)\n{\n`;
+            out += `    //the connection state is read from the datamodel handle in exos_probe_process()\n`;
+            out += `}\n\n`;
+
+            out += `static inline void exos_probe_dataset_event(exos_dataset_handle_t *dataset, EXOS_DATASET_EVENT_TYPE event_type, void *info)\n{\n`;
+            out += `    exos_probe_t *probe = (exos_probe_t *)dataset->user_context;\n`;
+            if (Linux) {
+                out += `\n`;
+                out += `    if (EXOS_DATASET_EVENT_UPDATED != event_type || dataset != &probe->request)\n`;
+                out += `    {\n`;
+                out += `        return;\n`;
+                out += `    }\n\n`;
+                out += `    if (0 != probe->stats.requests && probe->data.ProbeRequest.Sequence > probe->data.ProbeReply.Sequence + 1)\n`;
+                out += `    {\n`;
+                out += `        probe->stats.lost += probe->data.ProbeRequest.Sequence - probe->data.ProbeReply.Sequence - 1;\n`;
+                out += `    }\n`;
+                out += `    probe->stats.requests++;\n\n`;
+                out += `    //echo the request right away, from the thread calling process()\n`;
+                out += `    probe->data.ProbeReply = probe->data.ProbeRequest;\n`;
+                out += `    probe->data.ProbeReply.EchoNettime = exos_datamodel_get_nettime(dataset->datamodel);\n`;
+                out += `    probe->stats.uplink = probe->data.ProbeReply.EchoNettime - probe->data.ProbeReply.RequestNettime;\n`;
+                out += `    if (EXOS_ERROR_OK == exos_dataset_publish(&probe->reply))\n`;
+                out += `    {\n`;
+                out += `        probe->stats.replies++;\n`;
+                out += `    }\n`;
+            }
+            else {
+                out += `    int32_t nettime;\n\n`;
+                out += `    if (EXOS_DATASET_EVENT_UPDATED != event_type || dataset != &probe->reply)\n`;
+                out += `    {\n`;
+                out += `        return;\n`;
+                out += `    }\n\n`;
+                out += `    //only the reply to the last request is measured, the ones before were counted as lost\n`;
+                out += `    if (!probe->pending || probe->data.ProbeReply.Sequence != probe->data.ProbeRequest.Sequence)\n`;
+                out += `    {\n`;
+                out += `        return;\n`;
+                out += `    }\n\n`;
+                out += `    nettime = exos_datamodel_get_nettime(dataset->datamodel);\n`;
+                out += `    probe->pending = false;\n`;
+                out += `    probe->stats.replies++;\n`;
+                out += `    probe->stats.rtt = nettime - probe->data.ProbeReply.RequestNettime;\n`;
+                out += `    probe->stats.uplink = probe->data.ProbeReply.EchoNettime - probe->data.ProbeReply.RequestNettime;\n`;
+                out += `    probe->stats.downlink = nettime - probe->data.ProbeReply.EchoNettime;\n`;
+                out += `    if (1 == probe->stats.replies || probe->stats.rtt < probe->stats.rtt_min)\n`;
+                out += `    {\n`;
+                out += `        probe->stats.rtt_min = probe->stats.rtt;\n`;
+                out += `    }\n`;
+                out += `    if (probe->stats.rtt > probe->stats.rtt_max)\n`;
+                out += `    {\n`;
+                out += `        probe->stats.rtt_max = probe->stats.rtt;\n`;
+                out += `    }\n`;
+                out += `    probe->rtt_sum += probe->stats.rtt;\n`;
+                out += `    probe->stats.rtt_avg = (int32_t)(probe->rtt_sum / probe->stats.replies);\n`;
+            }
+            out += `}\n\n`;
+
+            out += `static inline EXOS_ERROR_CODE exos_probe_init(exos_probe_t *probe)\n{\n`;
+            out += `    EXOS_ERROR_CODE error;\n\n`;
+            out += `    memset(probe, 0, sizeof(*probe));\n`;
+            out += `    error = exos_datamodel_init(&probe->datamodel, "${TemplateProbe.datamodelInstanceName(template)}", "${template.aliasName}_Probe");\n`;
+            out += `    if (EXOS_ERROR_OK != error)\n`;
+            out += `    {\n`;
+            out += `        return error;\n`;
+            out += `    }\n`;
+            out += `    error = exos_dataset_init(&probe->request, &probe->datamodel, "ProbeRequest", &probe->data.ProbeRequest, sizeof(probe->data.ProbeRequest));\n`;
+            out += `    if (EXOS_ERROR_OK != error)\n`;
+            out += `    {\n`;
+            out += `        return error;\n`;
+            out += `    }\n`;
+            out += `    error = exos_dataset_init(&probe->reply, &probe->datamodel, "ProbeReply", &probe->data.ProbeReply, sizeof(probe->data.ProbeReply));\n`;
+            out += `    if (EXOS_ERROR_OK != error)\n`;
+            out += `    {\n`;
+            out += `        return error;\n`;
+            out += `    }\n\n`;
+            out += `    probe->request.user_context = probe;\n`;
+            out += `    probe->reply.user_context = probe;\n`;
+            out += `    return EXOS_ERROR_OK;\n`;
+            out += `}\n\n`;
+
+            out += `static inline EXOS_ERROR_CODE exos_probe_connect(exos_probe_t *probe)\n{\n`;
+            out += `    static const char config[] = "${probeConfig()}";\n`;
+            out += `    ExosProbe data;\n`;
+            out += `    exos_dataset_info_t datasets[] = {\n`;
+            out += `        {EXOS_DATASET_BROWSE_NAME_INIT,{}},\n`;
+            let members = [];
+            for (let dataset of ["ProbeRequest", "ProbeReply"]) {
+                members.push(dataset);
+                for (let member of ["Sequence", "RequestNettime", "EchoNettime"]) {
+                    members.push(`${dataset}.${member}`);
+                }
+            }
+            out += members.map(member => `        {EXOS_DATASET_BROWSE_NAME(${member}),{}}`).join(",\n") + `\n`;
+            out += `    };\n`;
+            out += `    EXOS_ERROR_CODE error;\n\n`;
+            out += `    exos_datamodel_calc_dataset_info(datasets, sizeof(datasets));\n\n`;
+            out += `    error = exos_datamodel_connect(&probe->datamodel, config, datasets, sizeof(datasets), exos_probe_datamodel_event);\n`;
+            out += `    if (EXOS_ERROR_OK != error)\n`;
+            out += `    {\n`;
+            out += `        return error;\n`;
+            out += `    }\n`;
+            if (Linux) {
+                out += `    //processed right after the datamodel of the application, without waiting for another DMR cycle\n`;
+                out += `    error = exos_datamodel_set_process_mode(&probe->datamodel, EXOS_DATAMODEL_PROCESS_NON_BLOCKING);\n`;
+                out += `    if (EXOS_ERROR_OK != error)\n`;
+                out += `    {\n`;
+                out += `        return error;\n`;
+                out += `    }\n`;
+            }
+            out += `    error = exos_dataset_connect(&probe->request, ${Linux ? "EXOS_DATASET_SUBSCRIBE" : "EXOS_DATASET_PUBLISH"}, exos_probe_dataset_event);\n`;
+            out += `    if (EXOS_ERROR_OK != error)\n`;
+            out += `    {\n`;
+            out += `        return error;\n`;
+            out += `    }\n`;
+            out += `    return exos_dataset_connect(&probe->reply, ${Linux ? "EXOS_DATASET_PUBLISH" : "EXOS_DATASET_SUBSCRIBE"}, exos_probe_dataset_event);\n`;
+            out += `}\n\n`;
+
+            out += `static inline EXOS_ERROR_CODE exos_probe_set_operational(exos_probe_t *probe)\n{\n`;
+            out += `    return exos_datamodel_set_operational(&probe->datamodel);\n`;
+            out += `}\n\n`;
+
+            if (Linux) {
+                out += `/*receive and echo the requests, call after the exos_datamodel_process() of the application*/\n`;
+                out += `static inline EXOS_ERROR_CODE exos_probe_process(exos_probe_t *probe)\n{\n`;
+                out += `    return exos_datamodel_process(&probe->datamodel);\n`;
+                out += `}\n\n`;
+            }
+            else {
+                out += `/*receive the replies and publish the next request after period (us, 0 = EXOS_PROBE_PERIOD),\n`;
+                out += `  call after the exos_datamodel_process() of the application*/\n`;
+                out += `static inline EXOS_ERROR_CODE exos_probe_process(exos_probe_t *probe, uint32_t period)\n{\n`;
+                out += `    EXOS_ERROR_CODE error;\n`;
+                out += `    int32_t nettime;\n\n`;
+                out += `    //handle online download of the library\n`;
+                out += `    probe->request.user_context = probe;\n`;
+                out += `    probe->reply.user_context = probe;\n`;
+                out += `    if (NULL != probe->datamodel.datamodel_event_callback && probe->datamodel.datamodel_event_callback != exos_probe_datamodel_event)\n`;
+                out += `    {\n`;
+                out += `        probe->datamodel.datamodel_event_callback = exos_probe_datamodel_event;\n`;
+                out += `    }\n`;
+                out += `    if (NULL != probe->reply.dataset_event_callback && probe->reply.dataset_event_callback != exos_probe_dataset_event)\n`;
+                out += `    {\n`;
+                out += `        probe->request.dataset_event_callback = exos_probe_dataset_event;\n`;
+                out += `        probe->reply.dataset_event_callback = exos_probe_dataset_event;\n`;
+                out += `    }\n\n`;
+                out += `    error = exos_datamodel_process(&probe->datamodel);\n`;
+                out += `    if (EXOS_ERROR_OK != error || EXOS_STATE_OPERATIONAL != probe->datamodel.connection_state)\n`;
+                out += `    {\n`;
+                out += `        return error;\n`;
+                out += `    }\n\n`;
+                out += `    nettime = exos_datamodel_get_nettime(&probe->datamodel);\n`;
+                out += `    if (0 != probe->stats.requests && (int32_t)(nettime - probe->next_request) < 0)\n`;
+                out += `    {\n`;
+                out += `        return EXOS_ERROR_OK;\n`;
+                out += `    }\n`;
+                out += `    if (probe->pending)\n`;
+                out += `    {\n`;
+                out += `        probe->stats.lost++;\n`;
+                out += `    }\n\n`;
+                out += `    probe->data.ProbeRequest.Sequence++;\n`;
+                out += `    probe->data.ProbeRequest.RequestNettime = nettime;\n`;
+                out += `    probe->data.ProbeRequest.EchoNettime = 0;\n`;
+                out += `    error = exos_dataset_publish(&probe->request);\n`;
+                out += `    if (EXOS_ERROR_OK != error)\n`;
+                out += `    {\n`;
+                out += `        return error;\n`;
+                out += `    }\n`;
+                out += `    probe->next_request = nettime + (int32_t)(0 != period ? period : EXOS_PROBE_PERIOD);\n`;
+                out += `    probe->pending = true;\n`;
+                out += `    probe->stats.requests++;\n`;
+                out += `    return EXOS_ERROR_OK;\n`;
+                out += `}\n\n`;
+            }
+
+            out += `static inline EXOS_ERROR_CODE exos_probe_disconnect(exos_probe_t *probe)\n{\n`;
+            out += `    return exos_datamodel_disconnect(&probe->datamodel);\n`;
+            out += `}\n\n`;
+
+            out += `static inline EXOS_ERROR_CODE exos_probe_delete(exos_probe_t *probe)\n{\n`;
+            out += `    return exos_datamodel_delete(&probe->datamodel);\n`;
+            out += `}\n\n`;
+
+            out += `#endif // ${guard}\n`;
+
+            return out;
+        }
+
+        return generateProbeHeader(this.template, Linux);
+    }
+}
+
+module.exports = {TemplateProbe};
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2021 B&R Danmark
+ * All rights reserved
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+const { Datamodel, GeneratedFileObj, Dataset } = require('../../datamodel');
+const { Template, ApplicationTemplate, ApplicationTemplateDataset } = require('./template')
+
+/**
+ * A member of an array-of-structures dataset, flattened to a single structure-of-arrays field
+ *
+ * @typedef {Object} SoaField
+ * @property {string} name flattened member name, e.g. `Ack_Id` for `.Ack.Id`
+ * @property {string} access access path of the member within one array element, e.g. `.Ack.Id` or `.Sub[j].Value`
+ * @property {string} cType C type of the member, e.g. `double`
+ * @property {number[]} loops sizes of nested structure arrays within the element, each with its own loop index (`j`, `k`, ..)
+ * @property {number[]} extent trailing dimensions of the member itself (scalar arrays and strings), which are copied as one block
+ */
+
+class TemplateSoa extends Template {
+
+    /**
+     * header with structure-of-arrays types and conversion kernels
+     * @type {GeneratedFileObj}
+     */
+    soaHeader;
+
+    /**
+     * {@linkcode TemplateSoa} Generate structure-of-arrays (SoA) mirrors for datasets that are arrays of structures
+     *
+     * Datasets like `Values : ARRAY[0..999] OF Value_typ` are transferred in the AR array-of-structures layout,
+     * where scanning a single member strides through memory. For each of these datasets, a SoA type with one (aligned)
+     * array per member is generated, along with kernels converting the dataset from AoS to SoA and back.
+     *
+     * The header is plain C, and for C++ it also declares `exos_soa_load()` and `exos_soa_store()` overloads used by the C++ dataset class.
+     *
+     * Generates following {@link GeneratedFileObj}
+     * - {@linkcode soaHeader}
+     *
+     * @param {Datamodel} datamodel
+     * @param {boolean} Linux true if generated for Linux, false for AR
+     */
+    constructor(datamodel, Linux) {
+        super(datamodel, Linux);
+
+        this.soaHeader = {name:`exos_${this.datamodel.typeName.toLowerCase()}_soa.h`, contents:this._generateSoaHeader(), description:`${this.datamodel.typeName} structure-of-arrays mirrors`};
+    }
+
+    /**
+     * @param {ApplicationTemplateDataset} dataset
+     * @returns {boolean} true if the dataset is an array of structures, and gets a SoA mirror
+     */
+    static isSoaDataset(dataset) {
+        return (dataset.isPub || dataset.isSub) && dataset.type == "struct" && dataset.arraySize > 0;
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @param {ApplicationTemplateDataset} dataset
+     * @returns {string} name of the SoA type for the given dataset, e.g. `MyApplicationValues_soa_t`
+     */
+    static soaTypeName(template, dataset) {
+        return `${template.datamodel.structName}${dataset.structName}_soa_t`;
+    }
+
+    /**
+     * @param {ApplicationTemplate} template
+     * @param {ApplicationTemplateDataset} dataset
+     * @returns {string} prefix of the conversion kernels for the given dataset, e.g. `MyApplicationValues`
+     */
+    static soaFunctionPrefix(template, dataset) {
+        return `${template.datamodel.structName}${dataset.structName}`;
+    }
+
+    /**
+     * Flatten all members of one array element to {@link SoaField} objects
+     *
+     * @param {Dataset[]} children members of the structure
+     * @param {string} prefix
+     * @param {string} access
+     * @param {number[]} loops
+     * @returns {SoaField[]}
+     */
+    static _flattenMembers(children, prefix, access, loops) {
+        const loopIndexes = "jklmnopq";
+        let fields = [];
+        for (let child of children) {
+            let name = child.attributes.name;
+            let arraySize = child.attributes.arraySize > 0 ? child.attributes.arraySize : 0;
+
+            if (child.name == "struct") {
+                if (arraySize > 0) {
+                    if (loops.length >= loopIndexes.length) throw(`SoA: member "${name}" has too many nested structure arrays`);
+                    fields = fields.concat(TemplateSoa._flattenMembers(child.children, `${prefix}${name}_`, `${access}.${name}[${loopIndexes[loops.length]}]`, loops.concat([arraySize])));
+                }
+                else {
+                    fields = fields.concat(TemplateSoa._flattenMembers(child.children, `${prefix}${name}_`, `${access}.${name}`, loops));
+                }
+            }
+            else {
+                let extent = [];
+                if (arraySize > 0) extent.push(arraySize);
+                if (child.attributes.dataType == "STRING") extent.push(child.attributes.stringLength);
+                fields.push({
+                    name: `${prefix}${name}`,
+                    access: `${access}.${name}`,
+                    cType: child.name == "enum" ? child.attributes.dataType : Datamodel.convertPlcType(child.attributes.dataType),
+                    loops: loops,
+                    extent: extent
+                });
+            }
+        }
+        return fields;
+    }
+
+    /**
+     * @returns {string} `exos_[typeName]_soa.h`
+     */
+    _generateSoaHeader() {
+
+        /**
+         * @param {ApplicationTemplate} template
+         * @param {Dataset} dataset datamodel {@link Dataset} of the top level structure
+         * @param {string} headerName
+         * @returns {string}
+         */
+        function generateSoaHeader(template, types, headerName) {
+
+            /**
+             * generate the code copying one field in the direction aos->soa or soa->aos
+             * @param {SoaField} field
+             * @param {boolean} toSoa
+             */
+            function copyField(field, toSoa) {
+                const loopIndexes = "jklmnopq";
+                let indent = "        ";
+                let out = "";
+                let soaIdx = "[i]";
+                for (let l = 0; l < field.loops.length; l++) {
+                    out += `${indent}for (${loopIndexes[l]} = 0; ${loopIndexes[l]} < ${field.loops[l]}; ${loopIndexes[l]}++)\n`;
+                    soaIdx += `[${loopIndexes[l]}]`;
+                    indent += "    ";
+                }
+                let soa = `soa->${field.name}${soaIdx}`;
+                let aos = `aos[i]${field.access}`;
+                if (field.extent.length > 0) {
+                    out += toSoa ? `${indent}memcpy(${soa}, ${aos}, sizeof(${soa}));\n` : `${indent}memcpy(${aos}, ${soa}, sizeof(${soa}));\n`;
+                }
+                else {
+                    out += toSoa ? `${indent}${soa} = ${aos};\n` : `${indent}${aos} = ${soa};\n`;
+                }
+                return out;
+            }
+
+            let guard = `_EXOS_COMP_${template.datamodel.structName.toUpperCase()}_SOA_H_`;
+            let out = "";
+
+            out += `#ifndef ${guard}\n`;
+            out += `#define ${guard}\n\n`;
+            out += `#include <string.h>\n`;
+            out += `#include "${headerName}"\n\n`;
+
+            out += `#ifndef EXOS_SOA_ALIGNED\n`;
+            out += `#if defined(__GNUC__)\n`;
+            out += `#define EXOS_SOA_ALIGNED __attribute__((aligned(32)))\n`;
+            out += `#else\n`;
+            out += `#define EXOS_SOA_ALIGNED\n`;
+            out += `#endif\n`;
+            out += `#endif\n\n`;
+
+            let overloads = "";
+            for (let dataset of template.datasets) {
+                if (!TemplateSoa.isSoaDataset(dataset)) continue;
+
+                let member = types.children.find(child => child.attributes.name == dataset.structName);
+                let fields = TemplateSoa._flattenMembers(member.children, "", "", []);
+                let maxLoops = Math.max(0, ...fields.map(field => field.loops.length));
+                let typeName = TemplateSoa.soaTypeName(template, dataset);
+                let prefix = TemplateSoa.soaFunctionPrefix(template, dataset);
+                let indexes = "i" + "jklmnopq".slice(0, maxLoops).split("").map(idx => `, ${idx}`).join("");
+
+                out += `/* ${dataset.structName} : ARRAY[0..${dataset.arraySize - 1}] OF ${dataset.dataType} - one array per member */\n`;
+                out += `typedef struct ${typeName.replace(/_t$/, "")}\n`;
+                out += `{\n`;
+                for (let field of fields) {
+                    out += `    ${field.cType} ${field.name}[${dataset.arraySize}]${field.loops.map(l => `[${l}]`).join("")}${field.extent.map(e => `[${e}]`).join("")} EXOS_SOA_ALIGNED;\n`;
+                }
+                out += `} ${typeName};\n\n`;
+
+                for (let toSoa of [true, false]) {
+                    if (toSoa) {
+                        out += `static inline void ${prefix}_aos_to_soa(const ${dataset.dataType} *aos, ${typeName} *soa)\n`;
+                    }
+                    else {
+                        out += `static inline void ${prefix}_soa_to_aos(const ${typeName} *soa, ${dataset.dataType} *aos)\n`;
+                    }
+                    out += `{\n`;
+                    out += `    size_t ${indexes};\n`;
+                    // one loop per member, so that each member is written/read as one contiguous stream
+                    for (let field of fields) {
+                        out += `    for (i = 0; i < ${dataset.arraySize}; i++)\n`;
+                        out += copyField(field, toSoa);
+                    }
+                    out += `}\n\n`;
+                }
+
+                overloads += `inline void exos_soa_load(${typeName} &soa, const ${dataset.dataType} *aos) { ${prefix}_aos_to_soa(aos, &soa); }\n`;
+                overloads += `inline void exos_soa_store(const ${typeName} &soa, ${dataset.dataType} *aos) { ${prefix}_soa_to_aos(&soa, aos); }\n`;
+            }
+
+            if (overloads != "") {
+                out += `#ifdef __cplusplus\n`;
+                out += overloads;
+                out += `#endif\n\n`;
+            }
+
+            out += `#endif // ${guard}\n`;
+
+            return out;
+        }
+
+        return generateSoaHeader(this.template, this.datamodel.dataset, this.datamodel.headerFile.name);
+    }
+}
+
+module.exports = {TemplateSoa};
@@ -8,7 +8,15 @@
  */
 
 const { Datamodel, GeneratedFileObj } = require('../../datamodel');
-const { Template, ApplicationTemplate } = require('./template')
+const { Template, ApplicationTemplate, TemplateFeature } = require('./template')
+const { TemplateSoa } = require('./template_soa');
+const { TemplateLinuxRecorder } = require('./linux/template_linux_recorder');
+const { TemplateLinuxGateway } = require('./linux/template_linux_gateway');
+const { TemplateLinuxMirror } = require('./linux/template_linux_mirror');
+const { TemplateLinuxMetrics } = require('./linux/template_linux_metrics');
+const { TemplateLinuxTrace } = require('./linux/template_linux_trace');
+const { TemplateProbe } = require('./template_probe');
+const { TemplateLinuxProfile } = require('./linux/template_linux_profile');
 
 class TemplateStaticCLib extends Template {
 
@@ -30,6 +38,72 @@ class TemplateStaticCLib extends Template {
      */
      staticLibraryLegend;
 
+    /**
+     * structure-of-arrays mirrors, only created with the `soa` feature
+     * @type {TemplateSoa}
+     */
+    soa;
+
+    /**
+     * name of the quality of service header, if any dataset has QoS annotations for this platform
+     * @type {string}
+     */
+    qosHeaderName;
+
+    /**
+     * name of the process mode header, only used on Linux with the `process` feature
+     * @type {string}
+     */
+    processHeaderName;
+
+    /**
+     * name of the publish group header, if the datamodel has publish groups
+     * @type {string}
+     */
+    groupHeaderName;
+
+    /**
+     * dataset traffic recorder, only created on Linux with the `record` feature
+     * @type {TemplateLinuxRecorder}
+     */
+    recorder;
+
+    /**
+     * shared memory gateway and its client libraries, only created on Linux with the `gateway` feature
+     * @type {TemplateLinuxGateway}
+     */
+    gateway;
+
+    /**
+     * latest value mirror of the datasets in shared memory, only created on Linux with the `mirror` feature
+     * @type {TemplateLinuxMirror}
+     */
+    mirror;
+
+    /**
+     * OpenMetrics exporter, only created on Linux with the `metrics` feature
+     * @type {TemplateLinuxMetrics}
+     */
+    metrics;
+
+    /**
+     * processing timeline trace, only created on Linux with the `trace` feature
+     * @type {TemplateLinuxTrace}
+     */
+    trace;
+
+    /**
+     * round trip probe echoing the requests of AR, only created on Linux with the `probe` feature
+     * @type {TemplateProbe}
+     */
+    probe;
+
+    /**
+     * change-frequency profile of the dataset members, only created on Linux with the `profile` feature
+     * @type {TemplateLinuxProfile}
+     */
+    profile;
+
     /**
      * {@linkcode TemplateStaticCLib} Generate static C library for Linux and AR
      * 
@@ -39,12 +113,69 @@ class TemplateStaticCLib extends Template {
      * - {@linkcode staticLibraryHeader}
      * - {@linkcode staticLibraryLegend}
      * 
+     * With the `soa` feature, datasets that are arrays of structures get a `soa` mirror, see {@linkcode TemplateSoa}
+     * 
+     * Datasets with QoS annotations in the .typ file use the `Datamodel.qosFile` header for rate limiting, deadband and latest-value conflation
+     * 
+     * On Linux with the `process` feature, `set_process_mode()` selects a blocking, non-blocking or adaptive `process()` using the `Datamodel.processFile` header
+     * 
+     * Publish groups get a `publish()` of all members or an `on_group_change` with a consistent snapshot, using the `Datamodel.groupFile` header
+     * 
+     * With the `record` feature on Linux, received and published datasets are recorded, and a recording can be replayed instead of the DMR, see {@linkcode TemplateLinuxRecorder}
+     * 
+     * With the `gateway` feature on Linux, received and published datasets are forwarded to local consumers in shared memory, see {@linkcode TemplateLinuxGateway}
+     * 
+     * With the `mirror` feature on Linux, the latest value of each received and published dataset is kept in shared memory, see {@linkcode TemplateLinuxMirror}
+     * 
+     * With the `metrics` feature on Linux, the dataset traffic, latencies, callback times and connection state are exported to Prometheus, see {@linkcode TemplateLinuxMetrics}
+     * 
+     * With the `trace` feature on Linux, process(), received datasets, callbacks and publishes are traced and dumped in the Chrome Trace Event format, see {@linkcode TemplateLinuxTrace}
+     * 
+     * With the `probe` feature on Linux, process() echoes the round trip probes of AR, with the measurements in `probe_stats`, see {@linkcode TemplateProbe}
+     * 
+     * With the `profile` feature on Linux, the changes of the members of received and published datasets are counted in `profile`, see {@linkcode TemplateLinuxProfile}
+     * 
      * @param {Datamodel} datamodel 
      * @param {boolean} Linux true if generated for Linux, false for AR
+     * @param {TemplateFeature[]} [features] optional features to generate
      */
-    constructor(datamodel, Linux) {
-        super(datamodel,Linux);
+    constructor(datamodel, Linux, features) {
+        super(datamodel, Linux, false, features);
+
+        if (Template.qosDatasets(this.template.datasets).length > 0) {
+            this.qosHeaderName = this.datamodel.qosFile.name;
+        }
+        if (Linux && this.features.includes("process")) {
+            this.processHeaderName = this.datamodel.processFile.name;
+        }
+        if (this.template.groups.length > 0) {
+            this.groupHeaderName = this.datamodel.groupFile.name;
+        }
 
+        if (this.features.includes("soa")) {
+            this.soa = new TemplateSoa(datamodel, Linux);
+        }
+        if (Linux && this.features.includes("record")) {
+            this.recorder = new TemplateLinuxRecorder();
+        }
+        if (Linux && this.features.includes("gateway")) {
+            this.gateway = new TemplateLinuxGateway(datamodel, this.template);
+        }
+        if (Linux && this.features.includes("mirror")) {
+            this.mirror = new TemplateLinuxMirror(datamodel, this.template);
+        }
+        if (Linux && this.features.includes("metrics")) {
+            this.metrics = new TemplateLinuxMetrics();
+        }
+        if (Linux && this.features.includes("trace")) {
+            this.trace = new TemplateLinuxTrace();
+        }
+        if (Linux && this.features.includes("probe")) {
+            this.probe = new TemplateProbe(datamodel, true);
+        }
+        if (Linux && this.features.includes("profile")) {
+            this.profile = new TemplateLinuxProfile(datamodel, this.template);
+        }
         this.staticLibrarySource = {name:`lib${this.datamodel.typeName.toLowerCase()}.c`, contents:this._generateLibSource(), description:`${this.datamodel.typeName} static library wrapper source`};
         this.staticLibraryHeader = {name:this.template.libHeaderName, contents:this._generateLibHeader(), description:`${this.datamodel.typeName} static library wrapper header`};
         this.staticLibraryLegend = this._generateLegend();
@@ -55,9 +186,56 @@ class TemplateStaticCLib extends Template {
         /**
          * 
          * @param {ApplicationTemplate} template 
+         * @param {boolean} soa generate structure-of-arrays mirrors
+         * @param {string} [qosHeaderName] implement the quality of service using this header
+         * @param {string} [processHeaderName] implement the process modes using this header
+         * @param {string} [recorderHeaderName] record the received and published datasets using this header
+         * @param {string} [gatewayHeaderName] forward the received and published datasets to the gateway using this header
+         * @param {string} [mirrorHeaderName] write the received and published datasets to the latest value mirror using this header
+         * @param {string} [metricsHeaderName] count the dataset traffic and time the callbacks for the metrics using this header
+         * @param {string} [traceHeaderName] trace process(), the received datasets, callbacks and publishes using this header
+         * @param {string} [probeHeaderName] echo the round trip probes in process() using this header
+         * @param {string} [profileHeaderName] count the changes of the received and published dataset members using this header
          * @returns {string} generated static library c code
          */
-        function generateTemplate(template) {
+        function generateTemplate(template, soa, qosHeaderName, processHeaderName, recorderHeaderName, gatewayHeaderName, mirrorHeaderName, metricsHeaderName, traceHeaderName, probeHeaderName, profileHeaderName) {
+
+            /**
+             * deliver a received dataset to the user: update the soa mirror and call on_change
+             * @param {ApplicationTemplateDataset} dataset
+             * @param {string} indent
+             */
+            function generateDeliver(dataset, indent) {
+                let out = "";
+                if (soa && TemplateSoa.isSoaDataset(dataset)) {
+                    out += `${indent}//update the structure-of-arrays mirror\n`;
+                    out += `${indent}${TemplateSoa.soaFunctionPrefix(template, dataset)}_aos_to_soa(${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.value, &${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.soa);\n\n`;
+                }
+                out += `${indent}//trigger the callback if assigned\n`;
+                out += `${indent}if (NULL != ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.on_change)\n`;
+                out += `${indent}{\n`;
+                if (metricsHeaderName !== undefined) {
+                    out += `${indent}    int64_t begin = metrics_callback_begin();\n`;
+                }
+                if (traceHeaderName !== undefined) {
+                    out += `${indent}    trace_begin("${dataset.structName}", "callback", 0);\n`;
+                }
+                out += `${indent}    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.on_change();\n`;
+                if (traceHeaderName !== undefined) {
+                    out += `${indent}    trace_end("${dataset.structName}", "callback", 0);\n`;
+                }
+                if (metricsHeaderName !== undefined) {
+                    out += `${indent}    metrics_callback_end(${template.datasets.indexOf(dataset)}, begin);\n`;
+                }
+                out += `${indent}}\n`;
+                return out;
+            }
+
+            let qosDatasets = Template.qosDatasets(template.datasets);
+            let mirrorPrefix = TemplateLinuxMirror.mirrorPrefix(template);
+            let profilePrefix = TemplateLinuxProfile.profilePrefix(template);
+            let forwarded = recorderHeaderName !== undefined || gatewayHeaderName !== undefined || mirrorHeaderName !== undefined || metricsHeaderName !== undefined || traceHeaderName !== undefined || profileHeaderName !== undefined;
+            let datasetPublish = forwarded ? `${template.datamodel.libStructName}_publish_forwarded` : "exos_dataset_publish";
             let out = "";
                 
             //includes
@@ -66,7 +244,29 @@ class TemplateStaticCLib extends Template {
         
             out += `#define EXOS_ASSERT_LOG &${template.logname}\n`;
             out += `#include "exos_log.h"\n`;
-            out += `#include "${template.libHeaderName}"\n\n`;
+            out += `#include "${template.libHeaderName}"\n`;
+            if (qosHeaderName !== undefined) {
+                out += `#include "${qosHeaderName}"\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `#include "${recorderHeaderName}"\n`;
+            }
+            if (gatewayHeaderName !== undefined) {
+                out += `#include "${gatewayHeaderName}"\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `#include "${mirrorHeaderName}"\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `#include "${metricsHeaderName}"\n`;
+            }
+            if (traceHeaderName !== undefined) {
+                out += `#include "${traceHeaderName}"\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `#include "${profileHeaderName}"\n`;
+            }
+            out += `\n`;
         
             out += `#define SUCCESS(_format_, ...) exos_log_success(&${template.logname}, EXOS_LOG_TYPE_USER, _format_, ##__VA_ARGS__);\n`;
             out += `#define INFO(_format_, ...) exos_log_info(&${template.logname}, EXOS_LOG_TYPE_USER, _format_, ##__VA_ARGS__);\n`;
@@ -83,6 +283,18 @@ class TemplateStaticCLib extends Template {
                     out += `    exos_dataset_handle_t ${dataset.varName};\n`;
                 }
             }
+            if (processHeaderName !== undefined) {
+                out += `\n    exos_process_t process;\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `\n    ${mirrorPrefix}_t *mirror;\n`;
+            }
+            if (probeHeaderName !== undefined) {
+                out += `\n    exos_probe_t probe;\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `\n    ${profilePrefix}_t *profile;\n`;
+            }
             out += `} ${template.datamodel.libStructName}Handle_t;\n\n`;
         
             out += `static ${template.datamodel.libStructName}Handle_t ${template.datamodel.handleName};\n\n`;
@@ -91,6 +303,27 @@ class TemplateStaticCLib extends Template {
             out += `    switch (event_type)\n    {\n`;
             out += `    case EXOS_DATASET_EVENT_UPDATED:\n`;
             out += `        VERBOSE("dataset %s updated! latency (us):%i", dataset->name, (exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime));\n`;
+            if (processHeaderName !== undefined) {
+                out += `        exos_process_latency(&${template.datamodel.handleName}.process, exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime);\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `        rec_event((uint16_t)dataset->user_tag, REC_UPDATED, dataset->nettime, dataset->data, dataset->size);\n`;
+            }
+            if (gatewayHeaderName !== undefined) {
+                out += `        gw_update((uint16_t)dataset->user_tag, dataset->nettime, dataset->data, dataset->size);\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `        ${mirrorPrefix}_write(${template.datamodel.handleName}.mirror, (uint16_t)dataset->user_tag, dataset->nettime, dataset->data, dataset->size);\n`;
+            }
+            if (metricsHeaderName !== undefined) {
+                out += `        metrics_updated((uint16_t)dataset->user_tag, exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime, dataset->size);\n`;
+            }
+            if (traceHeaderName !== undefined) {
+                out += `        trace_received(dataset->name, exos_datamodel_get_nettime(dataset->datamodel) - dataset->nettime);\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `        ${profilePrefix}_update(${template.datamodel.handleName}.profile, (uint16_t)dataset->user_tag, ${profilePrefix.toUpperCase()}_RECEIVED, dataset->data, dataset->size);\n`;
+            }
             out += `        //handle each subscription dataset separately\n`;
             var atleastone = false;
             for (let dataset of template.datasets) {
@@ -106,19 +339,67 @@ class TemplateStaticCLib extends Template {
                     out += `        {\n`;
                     out += `            //update the nettime\n`;
                     out += `            ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.nettime = dataset->nettime;\n\n`;
+                    let group = Template.datasetGroup(template, dataset);
+                    if (group !== undefined && group.tag === dataset) {
+                        let ext = `${template.datamodel.handleName}.ext_${template.datamodel.varName}`;
+                        out += `            //publish group ${group.name}: deliver the members as one snapshot if all of them were received before this tag\n`;
+                        out += `            if (exos_group_tag(&${ext}.${group.name}.state, ${ext}.${dataset.structName}.value))\n`;
+                        out += `            {\n`;
+                        for (let member of group.members) {
+                            out += `                memcpy(&${ext}.${group.name}.snapshot.${member.structName}, &${ext}.${member.structName}.value, sizeof(${ext}.${group.name}.snapshot.${member.structName}));\n`;
+                        }
+                        out += `                ${ext}.${group.name}.snapshot.sequence = ${ext}.${dataset.structName}.value;\n`;
+                        out += `                if (NULL != ${ext}.${group.name}.on_group_change)\n`;
+                        out += `                {\n`;
+                        out += `                    ${ext}.${group.name}.on_group_change();\n`;
+                        out += `                }\n\n`;
+                        out += `                //the callbacks of the members, held back until the group is complete\n`;
+                        for (let member of group.members) {
+                            out += generateDeliver(member, `                `);
+                        }
+                        out += `            }\n\n`;
+                    }
+                    else if (group !== undefined) {
+                        out += `            //publish group ${group.name}: member received, delivered with the snapshot when the tag arrives\n`;
+                        out += `            exos_group_received(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${group.name}.state, ${group.members.indexOf(dataset)});\n`;
+                        out += `        }\n`;
+                        continue;
+                    }
         
-                    out += `            //trigger the callback if assigned\n`;
-                    out += `            if (NULL != ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.on_change)\n`;
-                    out += `            {\n`;
-                    out += `                ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.on_change();\n`;
-                    out += `            }\n`;
+                    if (dataset.qos !== undefined && dataset.qos.deadband > 0) {
+                        out += `            //quality of service: skip updates within the deadband\n`;
+                        out += `            if (!exos_qos_deadband(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.qos, (double)${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.value))\n`;
+                        out += `            {\n`;
+                        out += `                break;\n`;
+                        out += `            }\n\n`;
+                    }
+                    if (dataset.qos !== undefined && dataset.qos.filters.length > 0) {
+                        out += `            //quality of service: skip updates where only members within their deadband changed\n`;
+                        out += `            if (!${Template.qosDeadbandPrefix(template, dataset)}_filter(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.deadband, &${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.qos, &${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.value))\n`;
+                        out += `            {\n`;
+                        out += `                break;\n`;
+                        out += `            }\n\n`;
+                    }
+                    if (dataset.qos !== undefined && dataset.qos.latest) {
+                        out += `            //quality of service: the latest value is delivered in process()\n`;
+                        out += `            ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.qos.changed = true;\n`;
+                    }
+                    else {
+                        out += generateDeliver(dataset, `            `);
+                    }
                     out += `        }\n`;
                 }
             }
             out += `        break;\n\n`;
             out += `    case EXOS_DATASET_EVENT_PUBLISHED:\n`;
+            if (metricsHeaderName !== undefined) {
+                out += `        metrics_send_buffer((uint16_t)dataset->user_tag, dataset->send_buffer.free, dataset->send_buffer.used);\n`;
+            }
             out += `        break;\n`;
             out += `    case EXOS_DATASET_EVENT_DELIVERED:\n`;
+            if (metricsHeaderName !== undefined) {
+                out += `        metrics_send_buffer((uint16_t)dataset->user_tag, dataset->send_buffer.free, dataset->send_buffer.used);\n`;
+            }
             out += `        break;\n`;
             out += `    case EXOS_DATASET_EVENT_CONNECTION_CHANGED:\n`;
             out += `        INFO("dataset %s changed state to %s", dataset->name, exos_get_state_string(dataset->connection_state));\n\n`;
@@ -138,10 +419,24 @@ class TemplateStaticCLib extends Template {
             out += `    }\n`;
             out += `}\n\n`;
         
+            out += `//copy the sync diagnostics of the datamodel to the ${template.datamodel.libStructName}_t structure\n`;
+            out += `static void ${template.datamodel.libStructName}_read_sync_info(exos_datamodel_handle_t *datamodel)\n{\n`;
+            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_in_sync = datamodel->sync_info.in_sync;\n`;
+            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.missed_dmr_cycles = datamodel->sync_info.missed_dmr_cycles;\n`;
+            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.missed_ar_cycles = datamodel->sync_info.missed_ar_cycles;\n`;
+            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.process_mode = datamodel->sync_info.process_mode;\n`;
+            if (metricsHeaderName !== undefined) {
+                out += `    metrics_sync(datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);\n`;
+            }
+            out += `}\n\n`;
+
             out += `static void ${template.datamodel.libStructName}_datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info)\n{\n`;
             out += `    switch (event_type)\n    {\n`;
             out += `    case EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED:\n`;
             out += `        INFO("application changed state to %s", exos_get_state_string(datamodel->connection_state));\n\n`;
+            if (metricsHeaderName !== undefined) {
+                out += `        metrics_connection(datamodel->connection_state);\n`;
+            }
             out += `        ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_connected = false;\n`;
             out += `        ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_operational = false;\n`;
             out += `        switch (datamodel->connection_state)\n`;
@@ -178,25 +473,169 @@ class TemplateStaticCLib extends Template {
             out += `        }\n`;
             out += `        break;\n`;
             out += `    case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:\n`;
+            out += `        INFO("application sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);\n\n`;
+            out += `        ${template.datamodel.libStructName}_read_sync_info(datamodel);\n`;
+            out += `        ${template.datamodel.handleName}.ext_${template.datamodel.varName}.sync_changes++;\n`;
+            out += `        ${template.datamodel.handleName}.ext_${template.datamodel.varName}.sync_changed_nettime = exos_datamodel_get_nettime(datamodel);\n`;
+            out += `        if (NULL != ${template.datamodel.handleName}.ext_${template.datamodel.varName}.on_sync_change)\n`;
+            out += `        {\n`;
+            out += `            ${template.datamodel.handleName}.ext_${template.datamodel.varName}.on_sync_change();\n`;
+            out += `        }\n`;
             out += `        break;\n\n`;
             out += `    default:\n`;
             out += `        break;\n\n`;
             out += `    }\n`;
             out += `}\n\n`;
         
+            //only emitted when a dataset is published through it, to keep the library free of unused functions
+            if (forwarded && template.datasets.some(dataset => dataset.isPub)) {
+                let forward = (nettime, indent) => {
+                    let out = "";
+                    if (recorderHeaderName !== undefined) {
+                        out += `${indent}rec_event((uint16_t)dataset->user_tag, REC_PUBLISHED, ${nettime}, dataset->data, dataset->size);\n`;
+                    }
+                    if (gatewayHeaderName !== undefined) {
+                        out += `${indent}gw_update((uint16_t)dataset->user_tag, ${nettime}, dataset->data, dataset->size);\n`;
+                    }
+                    if (mirrorHeaderName !== undefined) {
+                        out += `${indent}${mirrorPrefix}_write(${template.datamodel.handleName}.mirror, (uint16_t)dataset->user_tag, ${nettime}, dataset->data, dataset->size);\n`;
+                    }
+                    if (profileHeaderName !== undefined) {
+                        out += `${indent}${profilePrefix}_update(${template.datamodel.handleName}.profile, (uint16_t)dataset->user_tag, ${profilePrefix.toUpperCase()}_PUBLISHED, dataset->data, dataset->size);\n`;
+                    }
+                    return out;
+                };
+                let join = (words) => words.length > 1 ? `${words.slice(0, -1).join(", ")} and ${words[words.length - 1]}` : words[0];
+                let actions = [recorderHeaderName !== undefined ? "add it to the recording" : undefined, gatewayHeaderName !== undefined ? "forward it to the gateway" : undefined, mirrorHeaderName !== undefined ? "write it to the mirror" : undefined, metricsHeaderName !== undefined ? "count it in the metrics" : undefined, traceHeaderName !== undefined ? "trace it" : undefined, profileHeaderName !== undefined ? "profile it" : undefined].filter(action => action !== undefined);
+                let replayed = [recorderHeaderName !== undefined ? "recorded" : undefined, gatewayHeaderName !== undefined ? "forwarded" : undefined, mirrorHeaderName !== undefined ? "mirrored" : undefined, profileHeaderName !== undefined ? "profiled" : undefined].filter(action => action !== undefined);
+                out += `//publish the dataset${actions.length > 1 ? ", " : " and "}${join(actions)}`;
+                if (recorderHeaderName !== undefined) {
+                    out += `, during a replay it is only ${join(replayed)}`;
+                }
+                out += `\n`;
+                out += `static EXOS_ERROR_CODE ${datasetPublish}(exos_dataset_handle_t *dataset)\n`;
+                out += `{\n`;
+                if (recorderHeaderName !== undefined) {
+                    out += `    if (rec_replaying())\n`;
+                    out += `    {\n`;
+                    out += forward(`rec_replay_nettime()`, `        `);
+                    out += `        return EXOS_ERROR_OK;\n`;
+                    out += `    }\n\n`;
+                }
+                out += `    EXOS_ERROR_CODE err = exos_dataset_publish(dataset);\n`;
+                out += `    if (EXOS_ERROR_OK == err)\n`;
+                out += `    {\n`;
+                out += forward(`exos_datamodel_get_nettime(dataset->datamodel)`, `        `);
+                if (metricsHeaderName !== undefined) {
+                    out += `        metrics_published((uint16_t)dataset->user_tag, dataset->size);\n`;
+                }
+                if (traceHeaderName !== undefined) {
+                    out += `        trace_instant(dataset->name, "publish", exos_datamodel_get_nettime(dataset->datamodel));\n`;
+                }
+                out += `    }\n`;
+                out += `    return err;\n`;
+                out += `}\n\n`;
+            }
+
+            if (recorderHeaderName !== undefined) {
+                out += `//deliver a replayed dataset through the dataset event, as if it was received from the DMR\n`;
+                out += `static void ${template.datamodel.libStructName}_replay(uint16_t index, int32_t nettime, const void *data, size_t size, void *context)\n`;
+                out += `{\n`;
+                out += `    exos_dataset_handle_t *dataset = NULL;\n\n`;
+                out += `    switch (index)\n`;
+                out += `    {\n`;
+                for (let dataset of template.datasets) {
+                    if (dataset.isSub) {
+                        out += `    case ${template.datasets.indexOf(dataset)}:\n`;
+                        out += `        dataset = &${template.datamodel.handleName}.${dataset.varName};\n`;
+                        out += `        break;\n`;
+                    }
+                }
+                out += `    default:\n`;
+                out += `        return;\n`;
+                out += `    }\n\n`;
+                out += `    if (size != dataset->size)\n`;
+                out += `    {\n`;
+                out += `        return;\n`;
+                out += `    }\n`;
+                out += `    memcpy(dataset->data, data, size);\n`;
+                out += `    dataset->nettime = nettime;\n`;
+                out += `    ${template.datamodel.libStructName}_datasetEvent(dataset, EXOS_DATASET_EVENT_UPDATED, NULL);\n`;
+                out += `}\n\n`;
+            }
         
             for (let dataset of template.datasets) {
                 if (dataset.isPub) {
+                    let publish = `    EXOS_ASSERT_OK(${datasetPublish}(&${template.datamodel.handleName}.${dataset.varName}));\n`;
+                    if (dataset.qos !== undefined && dataset.qos.rate > 0) {
+                        publish = `    //quality of service: publishes within the rate are deferred to process()\n`;
+                        publish += `    if (exos_qos_publish(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.qos, exos_datamodel_get_nettime(&(${template.datamodel.handleName}.${template.datamodel.varName}))))\n`;
+                        publish += `    {\n`;
+                        publish += `        EXOS_ASSERT_OK(${datasetPublish}(&${template.datamodel.handleName}.${dataset.varName}));\n`;
+                        publish += `    }\n`;
+                    }
                     out += `static void ${template.datamodel.libStructName}_publish_${dataset.varName}(void)\n`;
                     out += `{\n`;
-                    out += `    EXOS_ASSERT_OK(exos_dataset_publish(&${template.datamodel.handleName}.${dataset.varName}));\n`;
+                    out += publish;
+                    out += `}\n`;
+                    if (soa && TemplateSoa.isSoaDataset(dataset)) {
+                        out += `static void ${template.datamodel.libStructName}_publish_soa_${dataset.varName}(void)\n`;
+                        out += `{\n`;
+                        out += `    ${TemplateSoa.soaFunctionPrefix(template, dataset)}_soa_to_aos(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.soa, ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.value);\n`;
+                        out += publish;
+                        out += `}\n`;
+                    }
+                }
+            }
+            for (let group of template.groups) {
+                if (group.isPub) {
+                    let ext = `${template.datamodel.handleName}.ext_${template.datamodel.varName}`;
+                    out += `static void ${template.datamodel.libStructName}_publish_group_${group.name}(void)\n`;
+                    out += `{\n`;
+                    out += `    //publish the members, then the next sequence number in the tag\n`;
+                    for (let member of group.members) {
+                        out += `    EXOS_ASSERT_OK(${datasetPublish}(&${template.datamodel.handleName}.${member.varName}));\n`;
+                    }
+                    out += `    ${ext}.${group.tag.structName}.value = exos_group_next(&${ext}.${group.name}.state);\n`;
+                    out += `    EXOS_ASSERT_OK(${datasetPublish}(&${template.datamodel.handleName}.${group.tag.varName}));\n`;
                     out += `}\n`;
                 }
             }
             out += `\n`;
         
+            if (gatewayHeaderName !== undefined) {
+                out += `//the datasets forwarded to the gateway, in the order of the dataset index\n`;
+                out += `static const gw_dataset_t ${template.datamodel.libStructName}_gateway_datasets[] = {\n`;
+                out += TemplateLinuxGateway.datasetTable(template, dataset => `sizeof(${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.value)`, `    `);
+                out += `};\n\n`;
+            }
+
             out += `static void ${template.datamodel.libStructName}_connect(void)\n`;
             out += `{\n`;
+            if (gatewayHeaderName !== undefined) {
+                out += `    //local consumers read the datasets from the gateway (see ${gatewayHeaderName})\n`;
+                out += `    gw_open("${template.datamodelInstanceName}", ${template.datamodel.libStructName}_gateway_datasets, sizeof(${template.datamodel.libStructName}_gateway_datasets) / sizeof(${template.datamodel.libStructName}_gateway_datasets[0]));\n\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `    //other processes read the latest value of the datasets from the mirror (see ${mirrorHeaderName})\n`;
+                out += `    if (NULL == ${template.datamodel.handleName}.mirror)\n`;
+                out += `    {\n`;
+                out += `        ${template.datamodel.handleName}.mirror = ${mirrorPrefix}_create(${TemplateLinuxMirror.mirrorNameDefine(template)});\n`;
+                out += `        if (NULL == ${template.datamodel.handleName}.mirror)\n`;
+                out += `        {\n`;
+                out += `            ERROR("cannot create the mirror %s", ${TemplateLinuxMirror.mirrorNameDefine(template)});\n`;
+                out += `        }\n`;
+                out += `    }\n\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `    if (rec_replaying())\n`;
+                out += `    {\n`;
+                out += `        //replaying instead of connecting to the DMR\n`;
+                out += `        ${template.datamodel.handleName}.${template.datamodel.varName}.connection_state = EXOS_STATE_OPERATIONAL;\n`;
+                out += `        ${template.datamodel.libStructName}_datamodelEvent(&(${template.datamodel.handleName}.${template.datamodel.varName}), EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED, NULL);\n`;
+                out += `        return;\n`;
+                out += `    }\n\n`;
+            }
             out += `    //connect the datamodel\n`;
             out += `    EXOS_ASSERT_OK(exos_datamodel_connect_${template.datamodel.structName.toLowerCase()}(&(${template.datamodel.handleName}.${template.datamodel.varName}), ${template.datamodel.libStructName}_datamodelEvent));\n`;
             out += `    \n`;
@@ -217,36 +656,158 @@ class TemplateStaticCLib extends Template {
                     }
                 }
             }
+            if (probeHeaderName !== undefined) {
+                out += `\n    //round trip probe of AR, in its own datamodel (see ${probeHeaderName})\n`;
+                out += `    EXOS_ASSERT_OK(exos_probe_connect(&${template.datamodel.handleName}.probe));\n`;
+            }
             out += `}\n`;
         
             out += `static void ${template.datamodel.libStructName}_disconnect(void)\n`;
             out += `{\n`;
             out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_connected = false;\n`;
-            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_operational = false;\n\n`;
+            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_operational = false;\n`;
+            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_in_sync = false;\n\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `    if (rec_replaying())\n`;
+                out += `    {\n`;
+                out += `        return;\n`;
+                out += `    }\n`;
+            }
             out += `    EXOS_ASSERT_OK(exos_datamodel_disconnect(&(${template.datamodel.handleName}.${template.datamodel.varName})));\n`;
+            if (probeHeaderName !== undefined) {
+                out += `    EXOS_ASSERT_OK(exos_probe_disconnect(&${template.datamodel.handleName}.probe));\n`;
+            }
             out += `}\n\n`;
         
             out += `static void ${template.datamodel.libStructName}_set_operational(void)\n`;
             out += `{\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `    if (rec_replaying())\n`;
+                out += `    {\n`;
+                out += `        return;\n`;
+                out += `    }\n`;
+            }
             out += `    EXOS_ASSERT_OK(exos_datamodel_set_operational(&(${template.datamodel.handleName}.${template.datamodel.varName})));\n`;
+            if (probeHeaderName !== undefined) {
+                out += `    EXOS_ASSERT_OK(exos_probe_set_operational(&${template.datamodel.handleName}.probe));\n`;
+            }
             out += `}\n\n`;
         
             out += `static void ${template.datamodel.libStructName}_process(void)\n`;
             out += `{\n`;
-            out += `    EXOS_ASSERT_OK(exos_datamodel_process(&(${template.datamodel.handleName}.${template.datamodel.varName})));\n`;
+            if (traceHeaderName !== undefined) {
+                out += `    trace_process_begin(exos_datamodel_get_nettime(&(${template.datamodel.handleName}.${template.datamodel.varName})));\n\n`;
+            }
+            let flush = qosDatasets.filter(dataset => dataset.qos.rate > 0);
+            if (flush.length > 0) {
+                out += `    //quality of service: deferred publishes, in order of priority\n`;
+                out += `    int32_t nettime = exos_datamodel_get_nettime(&(${template.datamodel.handleName}.${template.datamodel.varName}));\n`;
+                for (let dataset of flush) {
+                    out += `    if (exos_qos_flush(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.qos, nettime))\n`;
+                    out += `    {\n`;
+                    out += `        EXOS_ASSERT_OK(${datasetPublish}(&${template.datamodel.handleName}.${dataset.varName}));\n`;
+                    out += `    }\n`;
+                }
+                out += `\n`;
+            }
+            let dmr = "";
+            if (processHeaderName !== undefined) {
+                dmr += `    EXOS_ASSERT_OK(exos_process_begin(&${template.datamodel.handleName}.process, &(${template.datamodel.handleName}.${template.datamodel.varName})));\n`;
+            }
+            dmr += `    EXOS_ASSERT_OK(exos_datamodel_process(&(${template.datamodel.handleName}.${template.datamodel.varName})));\n`;
+            if (processHeaderName !== undefined) {
+                dmr += `    exos_process_end(&${template.datamodel.handleName}.process);\n`;
+                dmr += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.process_stats = ${template.datamodel.handleName}.process.stats;\n`;
+            }
+            dmr += `    ${template.datamodel.libStructName}_read_sync_info(&(${template.datamodel.handleName}.${template.datamodel.varName}));\n`;
+            if (probeHeaderName !== undefined) {
+                dmr += `    //echo the round trip probes of AR right away\n`;
+                dmr += `    EXOS_ASSERT_OK(exos_probe_process(&${template.datamodel.handleName}.probe));\n`;
+                dmr += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.probe_stats = ${template.datamodel.handleName}.probe.stats;\n`;
+            }
+            if (gatewayHeaderName !== undefined) {
+                dmr += `    gw_cycle(exos_datamodel_get_nettime(&(${template.datamodel.handleName}.${template.datamodel.varName})), ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_operational);\n`;
+            }
+            if (recorderHeaderName !== undefined) {
+                out += `    if (rec_replaying())\n`;
+                out += `    {\n`;
+                out += `        //deliver the next recorded cycle instead of processing the DMR\n`;
+                out += `        rec_replay_process(${template.datamodel.libStructName}_replay, NULL);\n`;
+                out += `        rec_cycle(rec_replay_nettime());\n`;
+                if (gatewayHeaderName !== undefined) {
+                    out += `        gw_cycle(rec_replay_nettime(), ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_operational);\n`;
+                }
+                out += `    }\n`;
+                out += `    else\n`;
+                out += `    {\n`;
+                out += dmr.replace(/^    /gm, `        `);
+                out += `        rec_cycle(exos_datamodel_get_nettime(&(${template.datamodel.handleName}.${template.datamodel.varName})));\n`;
+                out += `    }\n`;
+            }
+            else {
+                out += dmr;
+            }
+            let dispatch = qosDatasets.filter(dataset => dataset.qos.latest);
+            if (dispatch.length > 0) {
+                out += `\n`;
+                out += `    //quality of service: conflated updates, in order of priority\n`;
+                for (let dataset of dispatch) {
+                    out += `    if (exos_qos_dispatch(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.qos))\n`;
+                    out += `    {\n`;
+                    out += generateDeliver(dataset, `        `);
+                    out += `    }\n`;
+                }
+                out += `\n`;
+            }
             out += `    exos_log_process(&${template.logname});\n`;
+            if (traceHeaderName !== undefined) {
+                out += `\n`;
+                out += `    //a dump of the trace is written here, if requested or above the threshold\n`;
+                out += `    trace_process_end(exos_datamodel_get_nettime(&(${template.datamodel.handleName}.${template.datamodel.varName})));\n`;
+            }
             out += `}\n\n`;
         
             out += `static void ${template.datamodel.libStructName}_dispose(void)\n`;
             out += `{\n`;
             out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_connected = false;\n`;
-            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_operational = false;\n\n`;
+            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_operational = false;\n`;
+            out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.is_in_sync = false;\n\n`;
+            if (gatewayHeaderName !== undefined) {
+                out += `    gw_close();\n`;
+            }
+            if (mirrorHeaderName !== undefined) {
+                out += `    ${mirrorPrefix}_destroy(${template.datamodel.handleName}.mirror, ${TemplateLinuxMirror.mirrorNameDefine(template)});\n`;
+                out += `    ${template.datamodel.handleName}.mirror = NULL;\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `    //the report is written here, if started with --profile <path>\n`;
+                out += `    ${profilePrefix}_destroy(${template.datamodel.handleName}.profile);\n`;
+                out += `    ${template.datamodel.handleName}.profile = NULL;\n`;
+                out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.profile = NULL;\n`;
+            }
             out += `    EXOS_ASSERT_OK(exos_datamodel_delete(&(${template.datamodel.handleName}.${template.datamodel.varName})));\n`;
+            if (probeHeaderName !== undefined) {
+                out += `    EXOS_ASSERT_OK(exos_probe_delete(&${template.datamodel.handleName}.probe));\n`;
+            }
             out += `    exos_log_delete(&${template.logname});\n`;
             out += `}\n\n`;
         
+            if (processHeaderName !== undefined) {
+                out += `static void ${template.datamodel.libStructName}_set_process_mode(exos_process_mode_t mode, uint32_t spin_window)\n`;
+                out += `{\n`;
+                out += `    exos_process_set_mode(&${template.datamodel.handleName}.process, mode, spin_window);\n`;
+                out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.process_stats = ${template.datamodel.handleName}.process.stats;\n`;
+                out += `}\n\n`;
+            }
+        
             out += `static int32_t ${template.datamodel.libStructName}_get_nettime(void)\n`;
             out += `{\n`;
+            if (recorderHeaderName !== undefined) {
+                out += `    if (rec_replaying())\n`;
+                out += `    {\n`;
+                out += `        return rec_replay_nettime();\n`;
+                out += `    }\n`;
+            }
             out += `    return exos_datamodel_get_nettime(&(${template.datamodel.handleName}.${template.datamodel.varName}));\n`;
             out += `}\n\n`;
         
@@ -284,10 +845,35 @@ class TemplateStaticCLib extends Template {
             out += `{\n`;
         
             out += `    memset(&${template.datamodel.handleName}, 0, sizeof(${template.datamodel.handleName}));\n\n`;
+            if (qosDatasets.length > 0) {
+                out += `    //quality of service from the .typ annotations: rate (us), latest, deadband, relative, hysteresis\n`;
+                for (let dataset of qosDatasets) {
+                    out += `    exos_qos_init(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.qos, ${dataset.qos.rate}, ${dataset.qos.latest}, ${dataset.qos.deadband}, ${dataset.qos.relative}, ${dataset.qos.hysteresis});\n`;
+                    if (dataset.qos.filters.length > 0) {
+                        out += `    ${Template.qosDeadbandPrefix(template, dataset)}_init(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.deadband);\n`;
+                    }
+                }
+                out += `\n`;
+            }
+            if (template.groups.length > 0) {
+                out += `    //publish groups from the .typ annotations: number of members\n`;
+                for (let group of template.groups) {
+                    out += `    exos_group_init(&${template.datamodel.handleName}.ext_${template.datamodel.varName}.${group.name}.state, ${group.members.length});\n`;
+                }
+                out += `\n`;
+            }
         
             for (let dataset of template.datasets) {
                 if (dataset.isPub) {
                     out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.publish = ${template.datamodel.libStructName}_publish_${dataset.varName};\n`;
+                    if (soa && TemplateSoa.isSoaDataset(dataset)) {
+                        out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.publish_soa = ${template.datamodel.libStructName}_publish_soa_${dataset.varName};\n`;
+                    }
+                }
+            }
+            for (let group of template.groups) {
+                if (group.isPub) {
+                    out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.${group.name}.publish = ${template.datamodel.libStructName}_publish_group_${group.name};\n`;
                 }
             }
             out += `    \n`;
@@ -297,6 +883,9 @@ class TemplateStaticCLib extends Template {
             out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.set_operational = ${template.datamodel.libStructName}_set_operational;\n`;
             out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.dispose = ${template.datamodel.libStructName}_dispose;\n`;
             out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.get_nettime = ${template.datamodel.libStructName}_get_nettime;\n`;
+            if (processHeaderName !== undefined) {
+                out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.set_process_mode = ${template.datamodel.libStructName}_set_process_mode;\n`;
+            }
             out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.log.error = ${template.datamodel.libStructName}_log_error;\n`;
             out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.log.warning = ${template.datamodel.libStructName}_log_warning;\n`;
             out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.log.success = ${template.datamodel.libStructName}_log_success;\n`;
@@ -319,9 +908,27 @@ class TemplateStaticCLib extends Template {
                 if (dataset.isPub || dataset.isSub) {
                     out += `    EXOS_ASSERT_OK(exos_dataset_init(&${template.datamodel.handleName}.${dataset.varName}, &${template.datamodel.handleName}.${template.datamodel.varName}, "${dataset.structName}", &${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.value, sizeof(${template.datamodel.handleName}.ext_${template.datamodel.varName}.${dataset.structName}.value)));\n`;
                     out += `    ${template.datamodel.handleName}.${dataset.varName}.user_context = NULL; //not used\n`;
-                    out += `    ${template.datamodel.handleName}.${dataset.varName}.user_tag = 0; //not used\n\n`;
+                    let users = [recorderHeaderName !== undefined ? "the recording" : undefined, gatewayHeaderName !== undefined ? "the gateway" : undefined, mirrorHeaderName !== undefined ? "the mirror" : undefined, metricsHeaderName !== undefined ? "the metrics" : undefined, profileHeaderName !== undefined ? "the profile" : undefined].filter(user => user !== undefined);
+                    if (users.length > 0) {
+                        out += `    ${template.datamodel.handleName}.${dataset.varName}.user_tag = ${template.datasets.indexOf(dataset)}; //dataset index in ${users.length > 1 ? `${users.slice(0, -1).join(", ")} and ${users[users.length - 1]}` : users[0]}\n\n`;
+                    }
+                    else {
+                        out += `    ${template.datamodel.handleName}.${dataset.varName}.user_tag = 0; //not used\n\n`;
+                    }
                 }
             }
+            if (probeHeaderName !== undefined) {
+                out += `    EXOS_ASSERT_OK(exos_probe_init(&${template.datamodel.handleName}.probe));\n\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `    //the profile is enabled with ${profilePrefix}_setup() (see ${profileHeaderName})\n`;
+                out += `    ${template.datamodel.handleName}.profile = ${profilePrefix}_create();\n`;
+                out += `    if (NULL == ${template.datamodel.handleName}.profile)\n`;
+                out += `    {\n`;
+                out += `        ERROR("cannot allocate the profile");\n`;
+                out += `    }\n`;
+                out += `    ${template.datamodel.handleName}.ext_${template.datamodel.varName}.profile = ${template.datamodel.handleName}.profile;\n\n`;
+            }
             out += `    return &(${template.datamodel.handleName}.ext_${template.datamodel.varName});\n`;
             out += `}\n`;
         
@@ -330,7 +937,7 @@ class TemplateStaticCLib extends Template {
             return out;
         }
 
-        return generateTemplate(this.template);
+        return generateTemplate(this.template, this.soa !== undefined, this.qosHeaderName, this.processHeaderName, this.recorder !== undefined ? this.recorder.recorderHeader.name : undefined, this.gateway !== undefined ? this.gateway.gatewayHeader.name : undefined, this.mirror !== undefined ? this.mirror.mirrorHeader.name : undefined, this.metrics !== undefined ? this.metrics.metricsHeader.name : undefined, this.trace !== undefined ? this.trace.traceHeader.name : undefined, this.probe !== undefined ? this.probe.probeHeader.name : undefined, this.profile !== undefined ? this.profile.profileHeader.name : undefined);
 
     }
 
@@ -339,19 +946,47 @@ class TemplateStaticCLib extends Template {
         /**
          * 
          * @param {ApplicationTemplate} template 
+         * @param {string} [soaHeaderName] include structure-of-arrays mirrors from this header
+         * @param {string} [qosHeaderName] include the quality of service state from this header
+         * @param {string} [processHeaderName] include the process modes from this header
+         * @param {string} [groupHeaderName] include the publish groups from this header
+         * @param {string} [probeHeaderName] include the round trip probe from this header
+         * @param {string} [profileHeaderName] include the change-frequency profile from this header
          * @returns {string} generated static library header
          */
-        function genenerateLibHeader(template) {
+        function genenerateLibHeader(template, soaHeaderName, qosHeaderName, processHeaderName, groupHeaderName, probeHeaderName, profileHeaderName) {
             let out = "";
         
             out += `#ifndef _${template.libHeaderName.toUpperCase().replace('.', '_')}_\n`;
             out += `#define _${template.libHeaderName.toUpperCase().replace('.', '_')}_\n\n`;
         
-            out += `#include "${template.headerName}"\n\n`;
+            out += `#include "${template.headerName}"\n`;
+            if (soaHeaderName !== undefined) {
+                out += `#include "${soaHeaderName}"\n`;
+            }
+            if (qosHeaderName !== undefined) {
+                out += `#include "${qosHeaderName}"\n`;
+            }
+            if (processHeaderName !== undefined) {
+                out += `#include "${processHeaderName}"\n`;
+            }
+            if (groupHeaderName !== undefined) {
+                out += `#include "${groupHeaderName}"\n`;
+            }
+            if (probeHeaderName !== undefined) {
+                out += `#include "${probeHeaderName}"\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `#include "${profileHeaderName}"\n`;
+            }
+            out += `\n`;
         
             out += `typedef void (*${template.datamodel.libStructName}_event_cb)(void);\n`;
             out += `typedef void (*${template.datamodel.libStructName}_method_fn)(void);\n`;
             out += `typedef int32_t (*${template.datamodel.libStructName}_get_nettime_fn)(void);\n`;
+            if (processHeaderName !== undefined) {
+                out += `typedef void (*${template.datamodel.libStructName}_set_process_mode_fn)(exos_process_mode_t mode, uint32_t spin_window);\n`;
+            }
             out += `typedef void (*${template.datamodel.libStructName}_log_fn)(char *log_entry);\n\n`;
         
             for (let dataset of template.datasets) {
@@ -360,11 +995,23 @@ class TemplateStaticCLib extends Template {
                     out += `{\n`;
                     if (dataset.isPub) {
                         out += `    ${template.datamodel.libStructName}_method_fn publish;\n`;
+                        if (soaHeaderName !== undefined && TemplateSoa.isSoaDataset(dataset)) {
+                            out += `    ${template.datamodel.libStructName}_method_fn publish_soa;\n`;
+                        }
                     }
                     if (dataset.isSub) {
                         out += `    ${template.datamodel.libStructName}_event_cb on_change;\n`;
                         out += `    int32_t nettime;\n`;
                     }
+                    if (soaHeaderName !== undefined && TemplateSoa.isSoaDataset(dataset)) {
+                        out += `    ${TemplateSoa.soaTypeName(template, dataset)} soa;\n`;
+                    }
+                    if (dataset.qos !== undefined) {
+                        out += `    exos_qos_t qos;\n`;
+                        if (dataset.qos.filters.length > 0) {
+                            out += `    ${Template.qosDeadbandPrefix(template, dataset)}_t deadband;\n`;
+                        }
+                    }
                     out += `    ${Datamodel.convertPlcType(dataset.dataType)} value`;
                     if (dataset.arraySize > 0) { // array comes before string length in c (unlike AS typ editor where it would be: STRING[80][0..1])
                         out += `[${parseInt(dataset.arraySize)}]`;
@@ -377,6 +1024,19 @@ class TemplateStaticCLib extends Template {
                     out += `} ${dataset.libDataType}_t;\n\n`;
                 }
             }
+            for (let group of template.groups) {
+                out += `typedef struct ${template.datamodel.libStructName}${group.name}_group\n`;
+                out += `{\n`;
+                if (group.isPub) {
+                    out += `    ${template.datamodel.libStructName}_method_fn publish;\n`;
+                }
+                else {
+                    out += `    ${template.datamodel.libStructName}_event_cb on_group_change;\n`;
+                    out += `    ${group.snapshotType} snapshot;\n`;
+                }
+                out += `    exos_group_t state;\n`;
+                out += `} ${template.datamodel.libStructName}${group.name}_group_t;\n\n`;
+            }
             out += `typedef struct ${template.datamodel.libStructName}_log\n`;
             out += `{\n`;
             out += `    ${template.datamodel.libStructName}_log_fn error;\n`;
@@ -395,17 +1055,39 @@ class TemplateStaticCLib extends Template {
             out += `    ${template.datamodel.libStructName}_method_fn set_operational;\n`;
             out += `    ${template.datamodel.libStructName}_method_fn dispose;\n`;
             out += `    ${template.datamodel.libStructName}_get_nettime_fn get_nettime;\n`;
+            if (processHeaderName !== undefined) {
+                out += `    ${template.datamodel.libStructName}_set_process_mode_fn set_process_mode;\n`;
+            }
             out += `    ${template.datamodel.libStructName}_log_t log;\n`;  
             out += `    ${template.datamodel.libStructName}_event_cb on_connected;\n`;
             out += `    ${template.datamodel.libStructName}_event_cb on_disconnected;\n`;
             out += `    ${template.datamodel.libStructName}_event_cb on_operational;\n`;
+            out += `    ${template.datamodel.libStructName}_event_cb on_sync_change;\n`;
             out += `    bool is_connected;\n`;
             out += `    bool is_operational;\n`;
+            out += `    bool is_in_sync;\n`;
+            out += `    uint32_t missed_dmr_cycles;\n`;
+            out += `    uint32_t missed_ar_cycles;\n`;
+            out += `    EXOS_DATAMODEL_PROCESS_MODE process_mode;\n`;
+            out += `    uint32_t sync_changes;\n`;
+            out += `    int32_t sync_changed_nettime;\n`;
+            if (processHeaderName !== undefined) {
+                out += `    exos_process_stats_t process_stats;\n`;
+            }
+            if (probeHeaderName !== undefined) {
+                out += `    exos_probe_stats_t probe_stats;\n`;
+            }
+            if (profileHeaderName !== undefined) {
+                out += `    ${TemplateLinuxProfile.profilePrefix(template)}_t *profile;\n`;
+            }
             for (let dataset of template.datasets) {
                 if (dataset.isPub || dataset.isSub) {
                     out += `    ${dataset.libDataType}_t ${dataset.structName};\n`;
                 }
             }
+            for (let group of template.groups) {
+                out += `    ${template.datamodel.libStructName}${group.name}_group_t ${group.name};\n`;
+            }
             out += `} ${template.datamodel.libStructName}_t;\n\n`;
         
             out += `#ifdef __cplusplus\n`;
@@ -423,16 +1105,20 @@ class TemplateStaticCLib extends Template {
             return out;
         }
 
-        return genenerateLibHeader(this.template);
+        return genenerateLibHeader(this.template, this.soa !== undefined ? this.soa.soaHeader.name : undefined, this.qosHeaderName, this.processHeaderName, this.groupHeaderName, this.probe !== undefined ? this.probe.probeHeader.name : undefined, this.profile !== undefined ? this.profile.profileHeader.name : undefined);
     }
 
     _generateLegend() {
         /**
          * 
          * @param {ApplicationTemplate} template 
+         * @param {boolean} soa generate structure-of-arrays mirrors
+         * @param {boolean} processModes describe the process modes
+         * @param {boolean} probe describe the round trip probe
+         * @param {boolean} profile describe the change-frequency profile
          * @returns {string} comment section with help for programmers
          */
-        function genenerateLegend(template) {
+        function genenerateLegend(template, soa, processModes, probe, profile) {
             let out = "";
         
             out += `/* ${template.datamodel.libStructName}_t datamodel features:\n`;
@@ -448,9 +1134,37 @@ class TemplateStaticCLib extends Template {
             out += `    ${template.datamodel.varName}->on_connected\n`;
             out += `    ${template.datamodel.varName}->on_disconnected\n`;
             out += `    ${template.datamodel.varName}->on_operational\n`;
+            out += `    ${template.datamodel.varName}->on_sync_change\n`;
             out += `\nboolean values:\n`
             out += `    ${template.datamodel.varName}->is_connected\n`;
             out += `    ${template.datamodel.varName}->is_operational\n`;
+            out += `\nsync diagnostics (updated in process() and before on_sync_change):\n`
+            out += `    ${template.datamodel.varName}->is_in_sync : (bool) datamodel is in sync with the DMR\n`;
+            out += `    ${template.datamodel.varName}->missed_dmr_cycles : (uint32_t) cycles missed by the DMR\n`;
+            out += `    ${template.datamodel.varName}->missed_ar_cycles : (uint32_t) cycles missed by AR\n`;
+            out += `    ${template.datamodel.varName}->process_mode : (EXOS_DATAMODEL_PROCESS_MODE) current process mode\n`;
+            out += `    ${template.datamodel.varName}->sync_changes : (uint32_t) number of sync state changes\n`;
+            out += `    ${template.datamodel.varName}->sync_changed_nettime : (int32_t) nettime of the last sync state change\n`;
+            if (processModes) {
+                out += `\nprocess modes:\n`
+                out += `    ${template.datamodel.varName}->set_process_mode(EXOS_PROCESS_BLOCKING, 0) : process() blocks until the next DMR cycle (default)\n`;
+                out += `    ${template.datamodel.varName}->set_process_mode(EXOS_PROCESS_NON_BLOCKING, 0) : process() returns immediately, for use in your own loop\n`;
+                out += `    ${template.datamodel.varName}->set_process_mode(EXOS_PROCESS_ADAPTIVE, 500) : process() polls for 500us after each DMR cycle, then blocks\n`;
+                out += `    ${template.datamodel.varName}->process_stats : (exos_process_stats_t) measurements of the current mode, updated in process()\n`;
+                out += `        process_stats.cpu_load : (double) CPU use (percent) of the thread calling process()\n`;
+                out += `        process_stats.latency_avg, process_stats.latency_max : delivery latency (us) of the received datasets\n`;
+            }
+            if (probe) {
+                out += `\nround trip probe (the requests of AR are echoed in process()):\n`
+                out += `    ${template.datamodel.varName}->probe_stats : (exos_probe_stats_t) measurements of the probe, updated in process()\n`;
+                out += `        probe_stats.requests, probe_stats.lost : (uint32_t) requests received, and skipped sequence numbers\n`;
+                out += `        probe_stats.uplink : (int32_t) time (us) from AR to Linux of the last request\n`;
+            }
+            if (profile) {
+                out += `\nchange-frequency profile (enabled with --profile <path>, reported at dispose()):\n`
+                out += `    ${template.datamodel.varName}->profile : (${TemplateLinuxProfile.profilePrefix(template)}_t *) changes of the dataset members\n`;
+                out += `        ${TemplateLinuxProfile.profilePrefix(template)}_report(${template.datamodel.varName}->profile, stdout) : report the members ranked by changes now\n`;
+            }
             out += `\nlogging methods:\n`
             out += `    ${template.datamodel.varName}->log.error(char *)\n`;
             out += `    ${template.datamodel.varName}->log.warning(char *)\n`;
@@ -485,13 +1199,57 @@ class TemplateStaticCLib extends Template {
                     else {
                         out += `s\n`;
                     }
+                    if (soa && TemplateSoa.isSoaDataset(dataset)) {
+                        out += `    ${template.datamodel.varName}->${dataset.structName}.soa : (${TemplateSoa.soaTypeName(template, dataset)}) structure-of-arrays mirror, one array per member\n`;
+                        if (dataset.isSub) {
+                            out += `        updated from value before on_change is called\n`;
+                        }
+                        if (dataset.isPub) {
+                            out += `    ${template.datamodel.varName}->${dataset.structName}.publish_soa() : copy soa to value and publish\n`;
+                        }
+                    }
+                    if (dataset.qos !== undefined) {
+                        out += `    quality of service:\n`;
+                        for (let line of Template.qosDescription(dataset.qos)) {
+                            out += `        ${line}\n`;
+                        }
+                        out += `    ${template.datamodel.varName}->${dataset.structName}.qos : (exos_qos_t) quality of service state, can be changed at runtime\n`;
+                        if (dataset.qos.deadband > 0) {
+                            out += `        qos.filter.deadband, qos.filter.relative, qos.filter.hysteresis : deadband of the value\n`;
+                        }
+                        if (Template.qosHasDeadband(dataset)) {
+                            out += `        qos.suppressed : (uint32_t) number of updates not delivered because of a deadband\n`;
+                        }
+                        if (dataset.qos.filters.length > 0) {
+                            out += `    ${template.datamodel.varName}->${dataset.structName}.deadband : (${Template.qosDeadbandPrefix(template, dataset)}_t) member deadbands, can be changed at runtime\n`;
+                            out += `        deadband.${dataset.qos.filters[0].name}.deadband, .relative, .hysteresis : deadband of ${dataset.qos.filters[0].access.substring(1)}\n`;
+                        }
+                    }
+                    let group = Template.datasetGroup(template, dataset);
+                    if (group !== undefined) {
+                        out += `    ${group.tag === dataset ? "sequence number" : "member"} of publish group ${group.name}\n`;
+                    }
+                }
+            }
+            for (let group of template.groups) {
+                out += `\npublish group ${group.name} (${group.members.map(member => member.structName).join(", ")}):\n`;
+                if (group.isPub) {
+                    out += `    ${template.datamodel.varName}->${group.name}.publish() : publish all members, then the next sequence number in ${group.tag.structName}\n`;
+                }
+                else {
+                    out += `    ${template.datamodel.varName}->${group.name}.on_group_change : void(void) user callback function, called once all members of a publish were received\n`;
+                    out += `        the on_change callbacks of the members are held back and called after on_group_change\n`;
+                    out += `    ${template.datamodel.varName}->${group.name}.snapshot : (${group.snapshotType}) consistent copy of the members, with the sequence number\n`;
+                    out += `    ${template.datamodel.varName}->${group.name}.state.incomplete : (uint32_t) groups not delivered because a member was missing\n`;
+                    out += `    ${template.datamodel.varName}->${group.name}.state.skipped : (uint32_t) sequence numbers that were never received\n`;
                 }
+                out += `    ${template.datamodel.varName}->${group.name}.state.complete : (uint32_t) number of ${group.isPub ? "published" : "delivered"} groups\n`;
             }
             out += `*/\n\n`;
         
             return out;
         }
-        return genenerateLegend(this.template);
+        return genenerateLegend(this.template, this.soa !== undefined, this.processHeaderName !== undefined, this.probe !== undefined, this.profile !== undefined);
     }
 }
 
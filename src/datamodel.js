@@ -88,6 +88,21 @@ class Datamodel {
      */
     fileLines;
 
+    /**
+     * Contents of the source .typ file, with the tag datasets of the publish groups added by {@linkcode addGroupTags}.
+     * This is the .typ file the components write to the AR library, so that AR and Linux share the same datatype
+     * 
+     * @type {string}
+     */
+    fileContents;
+
+    /**
+     * {@linkcode addGroupTags} added tag datasets, so that {@linkcode fileContents} differs from the .typ file
+     * 
+     * @type {boolean}
+     */
+    groupTagsAdded;
+
     /**
      * ASCII string with C-datatype definitions of the datatype {@link typeName} - this is part of the {@link headerFile.contents}
      * 
@@ -124,6 +139,38 @@ class Datamodel {
      */
     sourceFile;
 
+    /**
+     * the generated C++ header with `constexpr` type descriptors (member names, offsets, element types, array and string sizes)
+     * for every structure and enum in the datamodel, plus a `for_each_member` visitor. Used by the C++ templates.
+     * 
+     * @type {GeneratedFileObj} 
+     */
+    reflectionFile;
+
+    /**
+     * the generated C header with the quality of service helpers used by the templates, see {@linkcode parseQos}.
+     * Only generated if a member of the datamodel has QoS annotations, otherwise `undefined`
+     * 
+     * @type {GeneratedFileObj} 
+     */
+    qosFile;
+
+    /**
+     * the generated C header with the process modes (blocking, non-blocking, adaptive) and the CPU and latency measurements
+     * used by the Linux templates around `exos_datamodel_process()`
+     * 
+     * @type {GeneratedFileObj} 
+     */
+    processFile;
+
+    /**
+     * the generated C header with the publish group state and the member snapshots, see {@linkcode publishGroups}.
+     * Only generated if the datamodel has `GROUP=` annotations, otherwise `undefined`
+     * 
+     * @type {GeneratedFileObj} 
+     */
+    groupFile;
+
     /**
      * fileName name of the file that has been parsed, e.g. ./SomeFolder/MyApplication.typ
      * 
@@ -183,12 +230,15 @@ class Datamodel {
             throw(`Datamodel: file does not exist: ${fileName}`);
         }
 
-        //read the file
-        this.fileLines = fs.readFileSync(this.fileName).toString();
-        this.fileLines = Datamodel._splitLines(this.fileLines);
+        //read the file, with the generated tags of the publish groups
+        let contents = fs.readFileSync(this.fileName).toString();
+        this.fileContents = Datamodel.addGroupTags(contents, this.typeName);
+        this.groupTagsAdded = this.fileContents != contents;
+        this.fileLines = Datamodel._splitLines(this.fileContents);
 
         this.headerFile = {name:"", contents:"", description:""};
         this.sourceFile = {name:"", contents:"", description:""};
+        this.reflectionFile = {name:"", contents:"", description:""};
 
         //create the objects that the class exposes
         //the sequence of the calls cannot be changed
@@ -201,6 +251,18 @@ class Datamodel {
         this.headerFile.description = `Generated datamodel header for ${this.typeName}`;
         this.sourceFile.name = `exos_${this.typeName.toLowerCase()}.c`;
         this.sourceFile.description = `Generated datamodel source for ${this.typeName}`;
+        this.reflectionFile.contents = this._makeReflectionHeader();
+        this.reflectionFile.name = `exos_${this.typeName.toLowerCase()}_reflection.hpp`;
+        this.reflectionFile.description = `Generated datamodel reflection header for ${this.typeName}`;
+        //publish groups alone do not need the quality of service header
+        let qosOptions = qos => qos !== undefined && (qos.priority != "NORMAL" || [qos.pub, qos.sub].some(options => options !== undefined && (options.rate > 0 || options.latest || options.deadband > 0)));
+        if (this.dataset.children.some(child => qosOptions(child.attributes.qos) || Datamodel.qosMemberFilters(child).length > 0)) {
+            this.qosFile = {name:`exos_${this.typeName.toLowerCase()}_qos.h`, contents:this._makeQosHeader(), description:`Generated datamodel quality of service header for ${this.typeName}`};
+        }
+        this.processFile = {name:`exos_${this.typeName.toLowerCase()}_process.h`, contents:this._makeProcessHeader(), description:`Generated datamodel process mode header for ${this.typeName}`};
+        if (Datamodel.publishGroups(this.dataset).length > 0) {
+            this.groupFile = {name:`exos_${this.typeName.toLowerCase()}_group.h`, contents:this._makeGroupHeader(), description:`Generated datamodel publish group header for ${this.typeName}`};
+        }
     }
 
     /**
@@ -344,6 +406,652 @@ class Datamodel {
         fileLines = fileLines.split("\n");
         return fileLines;
     }
+
+    /**
+     * Layout rules for the platforms a datamodel is used on, see {@linkcode analyzeLayout}
+     * - `GPOS`: natural alignment (gcc on x86_64 / ARM). This is also the AR layout on ARM targets
+     * - `AR`: gcc i386 ABI used on Intel AR targets, where `LREAL` members are aligned to 4 bytes
+     */
+    static LAYOUT_PLATFORMS = {
+        GPOS: {name: "GPOS", lrealAlignment: 8},
+        AR: {name: "AR", lrealAlignment: 4}
+    };
+
+    /**
+     * @returns {{size:number, alignment:number}} size and alignment of a scalar IEC type (BOOL, UDINT..) or enum on the given platform
+     * @param {string} type IEC type, like BOOL or UDINT. Anything else than the scalar types is treated as enum
+     * @param {{name:string, lrealAlignment:number}} platform one of the {@link LAYOUT_PLATFORMS}
+     */
+    static getScalarLayout(type, platform) {
+        switch (type) {
+            case "BOOL":
+            case "USINT":
+            case "SINT":
+            case "BYTE": return {size: 1, alignment: 1};
+            case "UINT":
+            case "INT": return {size: 2, alignment: 2};
+            case "UDINT":
+            case "DINT":
+            case "REAL": return {size: 4, alignment: 4};
+            case "LREAL": return {size: 8, alignment: platform.lrealAlignment};
+            default: //enum
+                return {size: 4, alignment: 4};
+        }
+    }
+
+    /**
+     * Calculate the memory layout of all structures and datasets in the datamodel for a given platform,
+     * including the padding bytes that the compiler inserts, and a proposed member order with less padding.
+     * 
+     * The proposed order sorts members by alignment (largest first), which gives the smallest size for naturally aligned types.
+     * The `reorderedSize` values assume that all nested structures are reordered as well.
+     * 
+     * @typedef {Object} MemberLayout
+     * @property {string} name member name
+     * @property {string} dataType IEC type or structure name, e.g. `UDINT` or `MyStruct`
+     * @property {number} arraySize number of array elements, 0 if not an array
+     * @property {number} stringLength allocated size of a `STRING`, 0 for other types
+     * @property {number} offset byte offset within the structure
+     * @property {number} size size of the member, including all array elements
+     * @property {number} alignment alignment of the member
+     * @property {number} paddingBefore padding bytes inserted in front of this member
+     * 
+     * @typedef {Object} TypeLayout
+     * @property {string} dataType structure name
+     * @property {number} size size of the structure (sizeof)
+     * @property {number} alignment alignment of the structure
+     * @property {MemberLayout[]} members members in declaration order
+     * @property {number} trailingPadding padding bytes after the last member
+     * @property {number} padding padding bytes in this structure (between members and trailing)
+     * @property {number} totalPadding padding bytes including the padding of nested structures
+     * @property {string[]} proposedOrder member names in the proposed order
+     * @property {number} reorderedSize size with the proposed order (applied to nested structures as well)
+     * 
+     * @typedef {Object} DatasetLayout
+     * @property {string} name dataset name
+     * @property {string} dataType IEC type or structure name
+     * @property {number} size bytes transferred per publish
+     * @property {number} padding padding bytes transferred per publish
+     * @property {number} reorderedSize bytes transferred per publish with the proposed order
+     * @property {number} rate publishes per second, used for weighting
+     * 
+     * @typedef {Object} LayoutAnalysis
+     * @property {string} platform name of the platform, `GPOS` or `AR`
+     * @property {TypeLayout[]} types layout of all structures used in the datamodel, in dependency order
+     * @property {DatasetLayout[]} datasets layout of all PUB / SUB datasets
+     * 
+     * @param {{name:string, lrealAlignment:number}} platform one of the {@link LAYOUT_PLATFORMS}
+     * @param {Object.<string, number>} [rates] publishes per second of each dataset, by dataset name. Datasets not listed are weighted with 1
+     * @returns {LayoutAnalysis}
+     */
+    analyzeLayout(platform, rates) {
+
+        let types = [];
+        let typeNames = [];
+
+        /**
+         * @param {Dataset} node
+         * @param {boolean} reordered
+         * @returns {{size:number, alignment:number, padding:number}} layout of a single element (arraySize not applied)
+         */
+        function elementLayout(node, reordered) {
+            if (node.name == "enum") {
+                return Object.assign({padding: 0}, Datamodel.getScalarLayout(node.attributes.dataType, platform));
+            }
+            if (node.name == "variable") {
+                if (node.attributes.dataType == "STRING") {
+                    return {size: node.attributes.stringLength, alignment: 1, padding: 0};
+                }
+                return Object.assign({padding: 0}, Datamodel.getScalarLayout(node.attributes.dataType, platform));
+            }
+
+            let members = node.children.map(child => {
+                let layout = elementLayout(child, reordered);
+                let count = child.attributes.arraySize > 0 ? child.attributes.arraySize : 1;
+                return {child: child, size: layout.size * count, alignment: layout.alignment, padding: layout.padding * count};
+            });
+            let ordered = members;
+            if (reordered) {
+                // stable sort, members with the same alignment keep their declaration order
+                ordered = members.map((member, index) => ({member: member, index: index}))
+                    .sort((a, b) => (b.member.alignment - a.member.alignment) || (a.index - b.index))
+                    .map(item => item.member);
+            }
+
+            let offset = 0;
+            let alignment = 1;
+            let padding = 0;
+            let memberLayouts = [];
+            for (let member of ordered) {
+                let gap = (member.alignment - (offset % member.alignment)) % member.alignment;
+                memberLayouts.push({name: member.child.attributes.name, dataType: member.child.attributes.dataType, arraySize: member.child.attributes.arraySize > 0 ? member.child.attributes.arraySize : 0, stringLength: member.child.attributes.stringLength > 0 ? member.child.attributes.stringLength : 0, offset: offset + gap, size: member.size, alignment: member.alignment, paddingBefore: gap});
+                offset += gap + member.size;
+                padding += gap + member.padding;
+                alignment = Math.max(alignment, member.alignment);
+            }
+            let trailing = (alignment - (offset % alignment)) % alignment;
+            let size = offset + trailing;
+            padding += trailing;
+
+            if (!reordered && !typeNames.includes(node.attributes.dataType)) {
+                typeNames.push(node.attributes.dataType);
+                let reorderedLayout = elementLayout(node, true);
+                let proposed = members.map((member, index) => ({member: member, index: index}))
+                    .sort((a, b) => (b.member.alignment - a.member.alignment) || (a.index - b.index))
+                    .map(item => item.member.child.attributes.name);
+                types.push({
+                    dataType: node.attributes.dataType,
+                    size: size,
+                    alignment: alignment,
+                    members: memberLayouts,
+                    trailingPadding: trailing,
+                    padding: memberLayouts.reduce((sum, member) => sum + member.paddingBefore, 0) + trailing,
+                    totalPadding: padding,
+                    proposedOrder: proposed,
+                    reorderedSize: reorderedLayout.size
+                });
+            }
+
+            return {size: size, alignment: alignment, padding: padding};
+        }
+
+        elementLayout(this.dataset, false);
+
+        let datasets = [];
+        for (let child of this.dataset.children) {
+            if (typeof child.attributes.comment !== "string" || !(child.attributes.comment.includes("PUB") || child.attributes.comment.includes("SUB"))) {
+                continue;
+            }
+            let count = child.attributes.arraySize > 0 ? child.attributes.arraySize : 1;
+            let layout = elementLayout(child, false);
+            let reorderedLayout = elementLayout(child, true);
+            let rate = 1;
+            if (rates !== undefined && typeof rates[child.attributes.name] === "number") {
+                rate = rates[child.attributes.name];
+            }
+            datasets.push({
+                name: child.attributes.name,
+                dataType: child.attributes.dataType,
+                size: layout.size * count,
+                padding: layout.padding * count,
+                reorderedSize: reorderedLayout.size * count,
+                rate: rate
+            });
+        }
+
+        // elementLayout() adds the types depth-first, so dependencies come first and the datamodel type is last
+        types = types.filter(type => type.dataType != this.typeName).concat(types.filter(type => type.dataType == this.typeName));
+
+        return {platform: platform.name, types: types, datasets: datasets};
+    }
+
+    /**
+     * Parse publish rates given as text, e.g. `Values=100, Config=0.5` (publishes per second)
+     * 
+     * @param {string} text comma separated list of `<dataset>=<rate>`
+     * @returns {Object.<string, number>} rates that can be passed to {@linkcode makeLayoutReport}
+     */
+    static parseLayoutRates(text) {
+        let rates = {};
+        if (typeof text !== "string") {
+            return rates;
+        }
+        for (let item of text.split(",")) {
+            if (item.trim() == "") {
+                continue;
+            }
+            let [name, rate] = item.split("=").map(part => part === undefined ? "" : part.trim());
+            if (name == "" || rate === undefined || rate == "" || isNaN(rate) || Number(rate) < 0) {
+                throw(`Invalid publish rate "${item.trim()}", expected <dataset>=<publishes per second>`);
+            }
+            rates[name] = Number(rate);
+        }
+        return rates;
+    }
+
+    /**
+     * Priorities of the `PRIO=` annotation, in the order they are handled
+     */
+    static QOS_PRIORITIES = ["HIGH", "NORMAL", "LOW"];
+
+    /**
+     * Quality of service of one direction of a dataset, set by the options following `PUB` or `SUB`
+     * 
+     * @typedef {Object} QosDirection
+     * @property {number} rate minimum interval (us) between two publishes, 0 for no limit
+     * @property {boolean} latest conflate received updates, so that only the latest value is delivered per process()
+     * @property {number} deadband minimum change of a received (numeric) value before it is delivered, 0 to deliver every update
+     * @property {boolean} relative the deadband (and hysteresis) is given in percent of the last delivered value
+     * @property {number} hysteresis additional change needed when a received value reverses the direction of the last delivered change
+     * 
+     * Deadband filter of a member within a structure, set by the options given without `PUB` or `SUB`
+     * 
+     * @typedef {Object} QosFilter
+     * @property {number} deadband minimum change of the member before the containing dataset is delivered
+     * @property {boolean} relative the deadband (and hysteresis) is given in percent of the last delivered value
+     * @property {number} hysteresis additional change needed when the member reverses the direction of its last delivered change
+     * 
+     * @typedef {Object} Qos
+     * @property {QosDirection} [pub] options following `PUB`, which apply to data published from AR to Linux
+     * @property {QosDirection} [sub] options following `SUB`, which apply to data published from Linux to AR
+     * @property {QosFilter} [member] deadband filter of a member within a structure, applied on the receiving side of the datasets containing it
+     * @property {string} priority `HIGH` | `NORMAL` | `LOW`
+     * @property {QosGroup} [group] publish group of the dataset, set by `GROUP=<name>` or `GROUPTAG=<name>`
+     * 
+     * @typedef {Object} QosGroup
+     * @property {string} name name of the publish group
+     * @property {boolean} tag the dataset is the `UDINT` carrying the sequence number of the group (`GROUPTAG=`), otherwise a member (`GROUP=`)
+     */
+
+    /**
+     * Parse the quality of service annotations in a member comment, for example `(*PUB RATE=10ms SUB LATEST DEADBAND=0.01 PRIO=HIGH*)`
+     * 
+     * The options `RATE=<n>us|ms|s`, `LATEST`, `DEADBAND=<n>[%]` and `HYSTERESIS=<n>` apply to the direction (`PUB` or `SUB`) they follow.
+     * `RATE` limits the publisher, whereas `LATEST`, `DEADBAND` and `HYSTERESIS` apply to the receiving side. `PRIO=HIGH|NORMAL|LOW` applies to the dataset.
+     * A `DEADBAND` ending with `%` is relative to the last delivered value, `HYSTERESIS` is given in the same unit as the `DEADBAND`.
+     * `GROUP=<name>` and `GROUPTAG=<name>` put a dataset into a publish group, see {@linkcode publishGroups}.
+     * 
+     * Members of a structure type (`nested`) can have a `DEADBAND` and `HYSTERESIS` without `PUB` or `SUB`, for example `(*DEADBAND=0.01*)`.
+     * A dataset of that structure is then only delivered if one of these members moved out of its deadband, or any other member changed.
+     * Words that are no annotations are left as comment text.
+     * 
+     * @param {string} comment comment of the member without the `(*` `*)`
+     * @param {string} name name of the member, used in error messages
+     * @param {string} dataType IEC type of the member, `DEADBAND` is only valid for numeric scalar types
+     * @param {number} arraySize number of array elements, or 0
+     * @param {boolean} [nested] the member is part of a structure type, and not a dataset
+     * @returns {Qos} the parsed annotations, or `undefined` if the comment has none
+     */
+    static parseQos(comment, name, dataType, arraySize, nested) {
+        if (typeof comment !== "string") {
+            return undefined;
+        }
+
+        let qos = {priority: "NORMAL"};
+        let direction = undefined;
+        let keyword = "";
+        let annotated = false;
+        let given = [];
+
+        /** @returns {QosDirection|QosFilter} the options the annotation applies to */
+        function option(key) {
+            let options = direction;
+            if (direction === undefined) {
+                if (!nested || !["DEADBAND", "HYSTERESIS"].includes(key)) {
+                    throw (`QoS annotation ${key} must follow PUB or SUB -> member "${name}"`);
+                }
+                if (qos.member === undefined) {
+                    qos.member = {deadband: 0, relative: false, hysteresis: 0};
+                }
+                options = qos.member;
+            }
+            if (given.includes(`${keyword}${key}`)) {
+                throw (`QoS annotation ${key} given twice${keyword != "" ? ` for ${keyword}` : ""} -> member "${name}"`);
+            }
+            given.push(`${keyword}${key}`);
+            annotated = true;
+            return options;
+        }
+
+        function numeric(key) {
+            if (arraySize > 0 || !Datamodel.isScalarType({dataType: dataType}) || ["BOOL", "STRING"].includes(dataType)) {
+                throw (`QoS annotation ${key} is only supported for numeric scalar types -> member "${name}"`);
+            }
+        }
+
+        for (let token of comment.split(/\s+/)) {
+            if (token == "PUB" || token == "SUB") {
+                keyword = token;
+                direction = {rate: 0, latest: false, deadband: 0, relative: false, hysteresis: 0};
+                qos[token.toLowerCase()] = direction;
+            }
+            else if (token == "LATEST") {
+                option(token).latest = true;
+            }
+            else if (/^[A-Z][A-Z0-9_]*=/.test(token)) {
+                let [key, value] = token.split("=");
+                switch (key) {
+                    case "RATE":
+                        option(key);
+                        let rate = /^(\d+(?:\.\d+)?)(us|ms|s)$/.exec(value);
+                        if (rate == null) {
+                            throw (`Invalid QoS annotation "${token}", expected RATE=<n>us, RATE=<n>ms or RATE=<n>s -> member "${name}"`);
+                        }
+                        direction.rate = Math.round(parseFloat(rate[1]) * {us: 1, ms: 1000, s: 1000000}[rate[2]]);
+                        if (direction.rate < 1 || direction.rate > 0x7FFFFFFF) {
+                            throw (`QoS annotation "${token}" is out of range -> member "${name}"`);
+                        }
+                        break;
+                    case "DEADBAND":
+                    case "HYSTERESIS":
+                        let options = option(key);
+                        let relative = key == "DEADBAND" && value.endsWith("%");
+                        let number = relative ? value.slice(0, -1) : value;
+                        if (number == "" || isNaN(number) || Number(number) < 0) {
+                            throw (`Invalid QoS annotation "${token}", expected a positive number${key == "DEADBAND" ? " or percentage" : ""} -> member "${name}"`);
+                        }
+                        numeric(key);
+                        if (key == "DEADBAND") {
+                            options.deadband = Number(number);
+                            options.relative = relative;
+                        }
+                        else {
+                            options.hysteresis = Number(number);
+                        }
+                        break;
+                    case "PRIO":
+                        if (!Datamodel.QOS_PRIORITIES.includes(value)) {
+                            throw (`Invalid QoS annotation "${token}", expected PRIO=${Datamodel.QOS_PRIORITIES.join("|")} -> member "${name}"`);
+                        }
+                        qos.priority = value;
+                        annotated = true;
+                        break;
+                    case "GROUP":
+                    case "GROUPTAG":
+                        if (nested) {
+                            throw (`QoS annotation ${key} is only supported for datasets -> member "${name}"`);
+                        }
+                        if (qos.group !== undefined) {
+                            throw (`QoS annotation ${key} given twice -> member "${name}"`);
+                        }
+                        if (!/^[A-Za-z_][A-Za-z0-9_]*$/.test(value)) {
+                            throw (`Invalid QoS annotation "${token}", expected ${key}=<name> with a C identifier as name -> member "${name}"`);
+                        }
+                        if (key == "GROUPTAG" && (dataType != "UDINT" || arraySize > 0)) {
+                            throw (`QoS annotation GROUPTAG is only supported for UDINT datasets -> member "${name}"`);
+                        }
+                        qos.group = {name: value, tag: key == "GROUPTAG"};
+                        annotated = true;
+                        break;
+                    default:
+                        throw (`Unknown QoS annotation "${token}" -> member "${name}"`);
+                }
+            }
+        }
+
+        for (let options of [qos.pub, qos.sub, qos.member]) {
+            if (options !== undefined && options.hysteresis > 0 && options.deadband == 0) {
+                throw (`QoS annotation HYSTERESIS requires a DEADBAND -> member "${name}"`);
+            }
+        }
+        if (qos.group !== undefined) {
+            for (let options of [qos.pub, qos.sub]) {
+                if (options !== undefined && (options.rate > 0 || options.latest || options.deadband > 0)) {
+                    throw (`QoS annotation GROUP cannot be combined with RATE, LATEST or DEADBAND, a group is published and delivered as a whole -> member "${name}"`);
+                }
+            }
+        }
+
+        return annotated ? qos : undefined;
+    }
+
+    /**
+     * @param {Qos} qos annotations returned by {@linkcode parseQos}
+     * @returns {string} normalized annotation string, e.g. `PUB RATE=10ms SUB LATEST DEADBAND=0.01 PRIO=HIGH`
+     */
+    static formatQos(qos) {
+        function formatRate(rate) {
+            if (rate % 1000000 == 0) return `${rate / 1000000}s`;
+            if (rate % 1000 == 0) return `${rate / 1000}ms`;
+            return `${rate}us`;
+        }
+
+        function formatDeadband(options) {
+            if (options.deadband > 0) tokens.push(`DEADBAND=${options.deadband}${options.relative ? "%" : ""}`);
+            if (options.hysteresis > 0) tokens.push(`HYSTERESIS=${options.hysteresis}`);
+        }
+
+        let tokens = [];
+        if (qos.member !== undefined) formatDeadband(qos.member);
+        for (let keyword of ["PUB", "SUB"]) {
+            let direction = qos[keyword.toLowerCase()];
+            if (direction === undefined) continue;
+            tokens.push(keyword);
+            if (direction.rate > 0) tokens.push(`RATE=${formatRate(direction.rate)}`);
+            if (direction.latest) tokens.push(`LATEST`);
+            formatDeadband(direction);
+        }
+        if (qos.priority != "NORMAL") tokens.push(`PRIO=${qos.priority}`);
+        if (qos.group !== undefined) tokens.push(`${qos.group.tag ? "GROUPTAG" : "GROUP"}=${qos.group.name}`);
+        return tokens.join(" ");
+    }
+
+    /**
+     * Publish group of datasets, that are published together and delivered as one consistent snapshot
+     * 
+     * @typedef {Object} PublishGroup
+     * @property {string} name name of the group from the `GROUP=<name>` annotations
+     * @property {string} tag name of the `UDINT` dataset carrying the sequence number (`GROUPTAG=<name>`)
+     * @property {string[]} members names of the member datasets, in the order of the datamodel
+     * @property {boolean} pub the group is published from AR to Linux (`PUB`), otherwise from Linux to AR (`SUB`)
+     */
+
+    /**
+     * Collect and validate the publish groups annotated on the datasets (top level members) of the datamodel, see {@linkcode parseQos}.
+     * 
+     * A group publishes all its members, and then a sequence number in its tag dataset. The receiver only delivers the members
+     * once the tag arrives and every member was received since the previous tag, so that it never sees members of different publishes.
+     * The tag is generated into the .typ file by {@linkcode addGroupTags}, as the datatype is shared between AR and Linux, and is not published on its own.
+     * 
+     * All datasets of a group must have the same direction, either `PUB` or `SUB`.
+     * 
+     * @param {Dataset} dataset the datamodel structure
+     * @returns {PublishGroup[]}
+     */
+    static publishGroups(dataset) {
+        let groups = [];
+        for (let child of dataset.children) {
+            let qos = child.attributes.qos;
+            if (qos === undefined || qos.group === undefined) continue;
+
+            let name = child.attributes.name;
+            let comment = child.attributes.comment;
+            let pub = comment.includes("PUB");
+            if (pub == comment.includes("SUB")) {
+                throw (`Publish group "${qos.group.name}" needs either PUB or SUB, not both or none -> member "${name}"`);
+            }
+            if (Datamodel.qosMemberFilters(child).length > 0) {
+                throw (`Publish group "${qos.group.name}" cannot have members with a DEADBAND -> member "${name}"`);
+            }
+            let group = groups.find(group => group.name == qos.group.name);
+            if (group === undefined) {
+                if (dataset.children.some(other => other.attributes.name == qos.group.name)) {
+                    throw (`Publish group "${qos.group.name}" has the same name as a dataset -> member "${name}"`);
+                }
+                group = {name: qos.group.name, tag: undefined, members: [], pub: pub};
+                groups.push(group);
+            }
+            if (group.pub != pub) {
+                throw (`Publish group "${group.name}" mixes PUB and SUB datasets -> member "${name}"`);
+            }
+            if (qos.group.tag) {
+                if (group.tag !== undefined) {
+                    throw (`Publish group "${group.name}" has more than one GROUPTAG -> member "${name}"`);
+                }
+                group.tag = name;
+            }
+            else {
+                group.members.push(name);
+            }
+        }
+        for (let group of groups) {
+            if (group.tag === undefined) {
+                throw (`Publish group "${group.name}" has no GROUPTAG, add a UDINT dataset with (*${group.pub ? "PUB" : "SUB"} GROUPTAG=${group.name}*)`);
+            }
+            if (group.members.length == 0 || group.members.length > 32) {
+                throw (`Publish group "${group.name}" needs 1 to 32 members, it has ${group.members.length}`);
+            }
+        }
+        return groups;
+    }
+
+    /**
+     * Add the tag datasets of the publish groups to the datamodel structure `typeName` of a .typ file.
+     * 
+     * The members of a publish group only need the `GROUP=<name>` annotation. For each group without a `GROUPTAG=<name>` dataset,
+     * a `UDINT` dataset `<name>Tag` annotated with `GROUPTAG=<name>` and the direction of the group is added at the end of the structure.
+     * Groups that already have a tag, for example from a previous generation, are left unchanged.
+     * 
+     * @param {string} contents contents of the .typ file
+     * @param {string} typeName name of the datamodel structure
+     * @returns {string} the contents with the tag datasets, unchanged if there are no tags to add
+     */
+    static addGroupTags(contents, typeName) {
+        let newline = contents.includes("\r\n") ? "\r\n" : "\n";
+        let lines = contents.split(newline);
+        let start = lines.findIndex(line => line.split(":")[0].trim() == typeName && line.includes("STRUCT"));
+        let end = lines.findIndex((line, index) => index > start && line.includes("END_STRUCT"));
+        if (start < 0 || end < 0) {
+            return contents;
+        }
+
+        let members = lines.slice(start + 1, end);
+        let groups = [];
+        let tags = [];
+        for (let line of members) {
+            let comment = line.includes("(*") ? line.substring(line.indexOf("(*")) : "";
+            let member = /\bGROUP=([A-Za-z_][A-Za-z0-9_]*)/.exec(comment);
+            let tag = /\bGROUPTAG=([A-Za-z_][A-Za-z0-9_]*)/.exec(comment);
+            if (member !== null && !groups.some(group => group.name == member[1])) {
+                groups.push({name: member[1], pub: comment.includes("PUB")});
+            }
+            if (tag !== null) {
+                tags.push(tag[1]);
+            }
+        }
+
+        let indent = members.length > 0 ? /^\s*/.exec(members[members.length - 1])[0] : "\t\t";
+        let added = [];
+        for (let group of groups.filter(group => !tags.includes(group.name))) {
+            let name = `${group.name}Tag`;
+            if (members.some(line => line.split(":")[0].trim() == name)) {
+                throw (`Publish group "${group.name}" needs the name ${name} for its generated GROUPTAG dataset -> member "${name}"`);
+            }
+            added.push(`${indent}${name} : UDINT; (*${group.pub ? "PUB" : "SUB"} GROUPTAG=${group.name}*)`);
+        }
+        if (added.length == 0) {
+            return contents;
+        }
+        lines.splice(end, 0, ...added);
+        return lines.join(newline);
+    }
+
+    /**
+     * A member of a structure dataset with a deadband filter
+     * 
+     * @typedef {Object} QosMemberFilter
+     * @property {string} name flattened member name, e.g. `Limits_Upper` for `.Limits.Upper`
+     * @property {string} access access path of the member within the dataset, e.g. `.Limits.Upper`
+     * @property {number} deadband
+     * @property {boolean} relative
+     * @property {number} hysteresis
+     */
+
+    /**
+     * Collect the deadband filters annotated on the members of a (top level) dataset, see {@linkcode parseQos}.
+     * 
+     * Members within arrays are not filtered, and neither are the members of datasets that are arrays.
+     * 
+     * @param {Dataset} dataset
+     * @returns {QosMemberFilter[]}
+     */
+    static qosMemberFilters(dataset) {
+        function collect(children, prefix, access) {
+            let filters = [];
+            for (let child of children) {
+                if (child.attributes.arraySize > 0) continue;
+                if (child.name == "struct") {
+                    filters = filters.concat(collect(child.children, `${prefix}${child.attributes.name}_`, `${access}.${child.attributes.name}`));
+                }
+                else if (child.attributes.qos !== undefined && child.attributes.qos.member !== undefined) {
+                    filters.push(Object.assign({name: `${prefix}${child.attributes.name}`, access: `${access}.${child.attributes.name}`}, child.attributes.qos.member));
+                }
+            }
+            return filters;
+        }
+
+        if (dataset.name != "struct" || dataset.attributes.arraySize > 0) {
+            return [];
+        }
+        return collect(dataset.children, "", "");
+    }
+
+    /**
+     * Generate a text report of the datamodel layout for AR and GPOS, see {@linkcode analyzeLayout}
+     * 
+     * For each structure, the offset, size and padding of every member is listed along with a proposed member order.
+     * The datasets are listed with the bytes transferred per publish, and weighted with the publish rate
+     * to show the padding bytes per second, and the bytes per second that a reordering would save.
+     * 
+     * @param {Object.<string, number>} [rates] publishes per second of each dataset, by dataset name. Datasets not listed are weighted with 1
+     * @returns {string}
+     */
+    makeLayoutReport(rates) {
+
+        function pad(value, width) {
+            return String(value).padStart(width);
+        }
+
+        let out = "";
+        out += `exOS datamodel layout report for ${this.typeName} (${path.basename(this.fileName)})\n`;
+
+        for (let platform of [Datamodel.LAYOUT_PLATFORMS.AR, Datamodel.LAYOUT_PLATFORMS.GPOS]) {
+            let analysis = this.analyzeLayout(platform, rates);
+
+            out += `\n================================================================================\n`;
+            out += `${platform.name} (LREAL aligned to ${platform.lrealAlignment} bytes)\n`;
+            out += `================================================================================\n`;
+
+            for (let type of analysis.types) {
+                out += `\n${type.dataType}: size ${type.size}, alignment ${type.alignment}, padding ${type.padding}`;
+                if (type.totalPadding != type.padding) {
+                    out += ` (${type.totalPadding} including nested structures)`;
+                }
+                out += `\n`;
+                out += `    offset   size    pad  member\n`;
+                for (let member of type.members) {
+                    let declaration = member.stringLength > 0 ? `${member.dataType}[${member.stringLength - 1}]` : member.dataType;
+                    if (member.arraySize > 0) {
+                        declaration = `ARRAY[0..${member.arraySize - 1}] OF ${declaration}`;
+                    }
+                    out += `    ${pad(member.offset, 6)} ${pad(member.size, 6)} ${pad(member.paddingBefore > 0 ? member.paddingBefore : "", 6)}  ${member.name} : ${declaration}\n`;
+                }
+                if (type.trailingPadding > 0) {
+                    out += `    ${pad(type.size - type.trailingPadding, 6)} ${pad("", 6)} ${pad(type.trailingPadding, 6)}  (trailing padding)\n`;
+                }
+                if (type.reorderedSize < type.size) {
+                    if (type.proposedOrder.join(",") == type.members.map(member => member.name).join(",")) {
+                        out += `    ! ${type.size - type.reorderedSize} bytes can be saved by reordering the nested structures (size ${type.reorderedSize})\n`;
+                    }
+                    else {
+                        out += `    ! ${type.size - type.reorderedSize} bytes can be saved with the member order: ${type.proposedOrder.join(", ")} (size ${type.reorderedSize})\n`;
+                    }
+                }
+                else if (type.padding > 0) {
+                    out += `    padding cannot be reduced by reordering the members\n`;
+                }
+            }
+
+            out += `\ndatasets (weighted with publishes per second):\n`;
+            out += `    ${"dataset".padEnd(24)} ${pad("size", 8)} ${pad("padding", 8)} ${pad("reorder", 8)} ${pad("rate/s", 8)} ${pad("bytes/s", 10)} ${pad("padding/s", 10)} ${pad("saved/s", 10)}\n`;
+            let total = {bytes: 0, padding: 0, saved: 0};
+            for (let dataset of analysis.datasets) {
+                let bytes = dataset.size * dataset.rate;
+                let padding = dataset.padding * dataset.rate;
+                let saved = (dataset.size - dataset.reorderedSize) * dataset.rate;
+                total.bytes += bytes;
+                total.padding += padding;
+                total.saved += saved;
+                out += `    ${dataset.name.padEnd(24)} ${pad(dataset.size, 8)} ${pad(dataset.padding, 8)} ${pad(dataset.reorderedSize, 8)} ${pad(dataset.rate, 8)} ${pad(bytes, 10)} ${pad(padding, 10)} ${pad(saved, 10)}\n`;
+            }
+            out += `    ${"total".padEnd(24)} ${pad("", 8)} ${pad("", 8)} ${pad("", 8)} ${pad("", 8)} ${pad(total.bytes, 10)} ${pad(total.padding, 10)} ${pad(total.saved, 10)}\n`;
+            if (total.bytes > 0) {
+                out += `\n    ${(100 * total.padding / total.bytes).toFixed(1)}% of the published bytes are padding, reordering would save ${(100 * total.saved / total.bytes).toFixed(1)}%\n`;
+            }
+        }
+
+        return out;
+    }
     /** 
      * internal function to generate the c-source file that can be accessed via the `Datamodel.sourceCode` property. `_makeJsonTypes()` must have been called prior to this method 
      * @returns {string}
@@ -478,9 +1186,14 @@ class Datamodel {
         function replacer(key, value) {
             if ((key == 'arraySize' && value == 0)
                 || (key == 'nodeId' && value == '')
-                || (key == 'comment' && value == '')) {
+                || (key == 'comment' && value == '')
+                || key == 'qos') {
               return undefined; // return undefined so JSON.stringify will omitt it
             }
+            if(key == 'comment' && this.qos !== undefined) {
+                //keep the QoS annotations next to PUB SUB
+                return Datamodel.formatQos(this.qos);
+            }
             if(key == 'comment') {
                 //clear all comments that are not purely PUB SUB
                 let commentStr = '';
@@ -575,6 +1288,621 @@ class Datamodel {
         return out;
     }
     
+    /**
+     * Internal function to generate the C++ reflection header accessible via `Datamodel.reflectionFile`. 
+     * The `_makeSource()` and `_makeDataTypes()` methods must have been called prior to this method, as it uses the `sortedStructs` to order the types.
+     * 
+     * Every structure and enum gets a `exos_reflection::TypeInfo<T>` specialization with `constexpr` member (or enumerator) tables,
+     * so that serializers, change detectors and the like can be compiled per type, rather than interpreting the JSON config at runtime.
+     * @returns {string}
+     */
+    _makeReflectionHeader() {
+
+        /** collect all struct and enum nodes (by dataType) within the dataset */
+        function _collectTypes(node, types) {
+            if ((node.name == "struct" || node.name == "enum") && !types.hasOwnProperty(node.attributes.dataType)) {
+                types[node.attributes.dataType] = node;
+            }
+            if (node.name == "struct" && Array.isArray(node.children)) {
+                for (let child of node.children) {
+                    _collectTypes(child, types);
+                }
+            }
+        }
+
+        /** return the MemberKind of a struct member */
+        function _memberKind(member) {
+            if (member.name == "struct") return "Struct";
+            if (member.name == "enum") return "Enum";
+            if (member.attributes.dataType == "STRING") return "String";
+            return "Scalar";
+        }
+
+        let types = {};
+        _collectTypes(this.dataset, types);
+
+        let guard = `_EXOS_COMP_${this.typeName.toUpperCase()}_REFLECTION_HPP_`;
+        let out = "";
+        out += `/*Automatically generated reflection header from ${path.basename(this.fileName)}*/\r\n\r\n`;
+
+        out += `#ifndef ${guard}\r\n`;
+        out += `#define ${guard}\r\n\r\n`;
+        out += `#include <cstddef>\r\n`;
+        out += `#include <type_traits>\r\n`;
+        out += `#include <utility>\r\n\r\n`;
+        out += `extern "C" {\r\n`;
+        out += `    #include "${this.headerFile.name}"\r\n`;
+        out += `}\r\n\r\n`;
+
+        // common declarations, shared by all generated reflection headers
+        out += `#ifndef _EXOS_REFLECTION_BASE_\r\n`;
+        out += `#define _EXOS_REFLECTION_BASE_\r\n\r\n`;
+        out += `namespace exos_reflection {\r\n\r\n`;
+        out += `enum class MemberKind { Scalar, String, Enum, Struct };\r\n\r\n`;
+        out += `struct MemberInfo\r\n{\r\n`;
+        out += `    const char *name;        // member name as declared in the .typ file\r\n`;
+        out += `    const char *dataType;    // IEC type (UDINT, LREAL, STRING..) or the name of the struct/enum\r\n`;
+        out += `    MemberKind kind;\r\n`;
+        out += `    std::size_t offset;      // offsetof() the member within its parent\r\n`;
+        out += `    std::size_t size;        // sizeof() the complete member (all array elements)\r\n`;
+        out += `    std::size_t elementSize; // sizeof() one array element, equal to size for non-arrays\r\n`;
+        out += `    std::size_t arraySize;   // number of array elements, 0 if not an array\r\n`;
+        out += `    std::size_t stringLength; // allocated length of a STRING (including terminator), 0 otherwise\r\n`;
+        out += `};\r\n\r\n`;
+        out += `struct EnumeratorInfo\r\n{\r\n`;
+        out += `    const char *name;\r\n`;
+        out += `    int value;\r\n`;
+        out += `};\r\n\r\n`;
+        out += `// specialized for each datamodel struct and enum - the Tag is only used to allow definitions in headers\r\n`;
+        out += `template <typename T, typename Tag = void>\r\n`;
+        out += `struct TypeInfo\r\n{\r\n`;
+        out += `    static constexpr bool reflected = false;\r\n`;
+        out += `};\r\n\r\n`;
+        out += `template <typename T>\r\n`;
+        out += `struct is_reflected : std::integral_constant<bool, TypeInfo<typename std::remove_cv<T>::type>::reflected> {};\r\n\r\n`;
+        out += `// call visitor(const MemberInfo &, member) for each member of a datamodel struct\r\n`;
+        out += `template <typename T, typename Visitor>\r\n`;
+        out += `inline void for_each_member(T &value, Visitor &&visitor)\r\n{\r\n`;
+        out += `    static_assert(is_reflected<T>::value, "for_each_member: type is not part of a generated datamodel");\r\n`;
+        out += `    TypeInfo<typename std::remove_cv<T>::type>::forEachMember(value, std::forward<Visitor>(visitor));\r\n`;
+        out += `}\r\n\r\n`;
+        out += `} // namespace exos_reflection\r\n\r\n`;
+        out += `#endif // _EXOS_REFLECTION_BASE_\r\n\r\n`;
+
+        out += `namespace exos_reflection {\r\n\r\n`;
+
+        for (let sorted of this.sortedStructs) {
+            if (!types.hasOwnProperty(sorted.name)) continue;
+            let type = types[sorted.name];
+            let typeName = type.attributes.dataType;
+            let children = Array.isArray(type.children) ? type.children : [];
+
+            out += `template <typename Tag>\r\n`;
+            out += `struct TypeInfo<${typeName}, Tag>\r\n{\r\n`;
+            out += `    static constexpr bool reflected = true;\r\n`;
+            out += `    static constexpr const char *name = "${typeName}";\r\n`;
+            out += `    static constexpr std::size_t size = sizeof(${typeName});\r\n`;
+
+            if (type.name == "enum") {
+                out += `    static constexpr std::size_t enumeratorCount = ${children.length};\r\n`;
+                out += `    static constexpr EnumeratorInfo enumerators[${children.length}] = {\r\n`;
+                for (let child of children) {
+                    out += `        {"${child.attributes.name}", ${child.attributes.name}},\r\n`;
+                }
+                out = out.slice(0, -3); //remove the last ,\r\n
+                out += `\r\n`;
+                out += `    };\r\n`;
+                out += `};\r\n\r\n`;
+                out += `template <typename Tag> constexpr const char *TypeInfo<${typeName}, Tag>::name;\r\n`;
+                out += `template <typename Tag> constexpr EnumeratorInfo TypeInfo<${typeName}, Tag>::enumerators[];\r\n\r\n`;
+            }
+            else {
+                out += `    static constexpr std::size_t memberCount = ${children.length};\r\n`;
+                out += `    static constexpr MemberInfo members[${children.length}] = {\r\n`;
+                for (let child of children) {
+                    let member = `${typeName}::${child.attributes.name}`;
+                    let arraySize = child.attributes.arraySize > 0 ? child.attributes.arraySize : 0;
+                    let stringLength = child.attributes.stringLength > 0 ? child.attributes.stringLength : 0;
+                    let elementSize = arraySize > 0 ? `sizeof(${member}[0])` : `sizeof(${member})`;
+                    out += `        {"${child.attributes.name}", "${child.attributes.dataType}", MemberKind::${_memberKind(child)}, offsetof(${typeName}, ${child.attributes.name}), sizeof(${member}), ${elementSize}, ${arraySize}, ${stringLength}},\r\n`;
+                }
+                out = out.slice(0, -3); //remove the last ,\r\n
+                out += `\r\n`;
+                out += `    };\r\n\r\n`;
+                out += `    template <typename S, typename Visitor>\r\n`;
+                out += `    static void forEachMember(S &value, Visitor &&visitor)\r\n    {\r\n`;
+                let i = 0;
+                for (let child of children) {
+                    out += `        visitor(members[${i}], value.${child.attributes.name});\r\n`;
+                    i++;
+                }
+                out += `    }\r\n`;
+                out += `};\r\n\r\n`;
+                out += `template <typename Tag> constexpr const char *TypeInfo<${typeName}, Tag>::name;\r\n`;
+                out += `template <typename Tag> constexpr MemberInfo TypeInfo<${typeName}, Tag>::members[];\r\n\r\n`;
+            }
+        }
+
+        out += `} // namespace exos_reflection\r\n\r\n`;
+        out += `#endif // ${guard}\r\n`;
+
+        return out;
+    }
+
+    /**
+     * Internal function to generate the quality of service header accessible via `Datamodel.qosFile`.
+     * 
+     * The header holds a `exos_qos_t` state with the inline functions the templates use to implement the annotations parsed by {@linkcode parseQos}.
+     * Structure datasets with member deadbands (see {@linkcode qosMemberFilters}) get a `<typeName><dataset>_deadband_t` with one filter per member.
+     * It is plain C, so it can be used from the C, C++ and N-API templates alike.
+     * @returns {string}
+     */
+    _makeQosHeader() {
+        let guard = `_EXOS_COMP_${this.typeName.toUpperCase()}_QOS_H_`;
+        let members = this.dataset.children.filter(child => Datamodel.qosMemberFilters(child).length > 0);
+        let out = "";
+
+        out += `/*Automatically generated quality of service header from ${path.basename(this.fileName)}*/\r\n\r\n`;
+        out += `#ifndef ${guard}\r\n`;
+        out += `#define ${guard}\r\n\r\n`;
+        out += `#include <stdint.h>\r\n`;
+        out += `#include <stdbool.h>\r\n`;
+        if (members.length > 0) {
+            out += `#include <string.h>\r\n`;
+            out += `#include "${this.headerFile.name}"\r\n`;
+        }
+        out += `\r\n`;
+
+        out += `/*Deadband filter of one numeric value, a received value is only delivered if it moved out of the deadband around the last delivered value:\r\n`;
+        out += `    DEADBAND=<n>    the value changed at least <n>, 0 disables the filter\r\n`;
+        out += `    DEADBAND=<n>%   the value changed at least <n> percent of the last delivered value\r\n`;
+        out += `    HYSTERESIS=<n>  a change reversing the direction of the last delivered change needs an additional <n> (in the unit of the deadband),\r\n`;
+        out += `                    so that noise around a level is not delivered as alternating updates\r\n`;
+        out += `*/\r\n`;
+        out += `typedef struct exos_qos_filter\r\n{\r\n`;
+        out += `    double deadband;\r\n`;
+        out += `    bool relative;\r\n`;
+        out += `    double hysteresis;\r\n\r\n`;
+        out += `    double reference;\r\n`;
+        out += `    int8_t direction;\r\n`;
+        out += `    bool valid;\r\n`;
+        out += `} exos_qos_filter_t;\r\n\r\n`;
+
+        out += `/*Quality of service of one dataset, configured from the annotations in the .typ file:\r\n`;
+        out += `    RATE=<time>     minimum interval between two publishes, publishes within the interval are deferred\r\n`;
+        out += `    LATEST          received updates are conflated, only the latest value is delivered in process()\r\n`;
+        out += `    DEADBAND=<n>    filter of a received numeric value, see exos_qos_filter_t\r\n`;
+        out += `    PRIO=<prio>     order (HIGH, NORMAL, LOW) of the deferred publishes and conflated updates in process()\r\n`;
+        out += `The counter suppressed holds the number of received updates that were not delivered because of a deadband\r\n`;
+        out += `*/\r\n`;
+        out += `typedef struct exos_qos\r\n{\r\n`;
+        out += `    int32_t rate;\r\n`;
+        out += `    bool latest;\r\n`;
+        out += `    exos_qos_filter_t filter;\r\n`;
+        out += `    uint32_t suppressed;\r\n\r\n`;
+        out += `    int32_t published_nettime;\r\n`;
+        out += `    bool published;\r\n`;
+        out += `    bool publish_pending;\r\n`;
+        out += `    bool changed;\r\n`;
+        out += `} exos_qos_t;\r\n\r\n`;
+
+        out += `static inline void exos_qos_filter_init(exos_qos_filter_t *filter, double deadband, bool relative, double hysteresis)\r\n{\r\n`;
+        out += `    filter->deadband = deadband;\r\n`;
+        out += `    filter->relative = relative;\r\n`;
+        out += `    filter->hysteresis = hysteresis;\r\n`;
+        out += `    filter->reference = 0;\r\n`;
+        out += `    filter->direction = 0;\r\n`;
+        out += `    filter->valid = false;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `static inline void exos_qos_init(exos_qos_t *qos, int32_t rate, bool latest, double deadband, bool relative, double hysteresis)\r\n{\r\n`;
+        out += `    qos->rate = rate;\r\n`;
+        out += `    qos->latest = latest;\r\n`;
+        out += `    exos_qos_filter_init(&qos->filter, deadband, relative, hysteresis);\r\n`;
+        out += `    qos->suppressed = 0;\r\n`;
+        out += `    qos->published_nettime = 0;\r\n`;
+        out += `    qos->published = false;\r\n`;
+        out += `    qos->publish_pending = false;\r\n`;
+        out += `    qos->changed = false;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*returns true if the dataset should be published now, otherwise the publish is deferred to exos_qos_flush()*/\r\n`;
+        out += `static inline bool exos_qos_publish(exos_qos_t *qos, int32_t nettime)\r\n{\r\n`;
+        out += `    if (qos->published && qos->rate > 0 && (int32_t)((uint32_t)nettime - (uint32_t)qos->published_nettime) < qos->rate)\r\n`;
+        out += `    {\r\n`;
+        out += `        qos->publish_pending = true;\r\n`;
+        out += `        return false;\r\n`;
+        out += `    }\r\n`;
+        out += `    qos->published_nettime = nettime;\r\n`;
+        out += `    qos->published = true;\r\n`;
+        out += `    qos->publish_pending = false;\r\n`;
+        out += `    return true;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*returns true if a deferred publish is due, in which case the (latest) dataset value should be published*/\r\n`;
+        out += `static inline bool exos_qos_flush(exos_qos_t *qos, int32_t nettime)\r\n{\r\n`;
+        out += `    return qos->publish_pending && exos_qos_publish(qos, nettime);\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*returns true if the value moved out of the deadband (and hysteresis) around the last delivered value*/\r\n`;
+        out += `static inline bool exos_qos_filter_exceeded(const exos_qos_filter_t *filter, double value)\r\n{\r\n`;
+        out += `    double change = value - filter->reference;\r\n`;
+        out += `    double scale = 1;\r\n`;
+        out += `    double band;\r\n\r\n`;
+        out += `    if (!filter->valid || filter->deadband <= 0)\r\n`;
+        out += `    {\r\n`;
+        out += `        return true;\r\n`;
+        out += `    }\r\n`;
+        out += `    if (filter->relative)\r\n`;
+        out += `    {\r\n`;
+        out += `        scale = (filter->reference < 0 ? -filter->reference : filter->reference) / 100;\r\n`;
+        out += `    }\r\n`;
+        out += `    band = filter->deadband * scale;\r\n`;
+        out += `    if ((change > 0 && filter->direction < 0) || (change < 0 && filter->direction > 0))\r\n`;
+        out += `    {\r\n`;
+        out += `        band += filter->hysteresis * scale;\r\n`;
+        out += `    }\r\n`;
+        out += `    if (change < 0)\r\n`;
+        out += `    {\r\n`;
+        out += `        change = -change;\r\n`;
+        out += `    }\r\n`;
+        out += `    return change > 0 && change >= band;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*makes a delivered value the new center of the deadband*/\r\n`;
+        out += `static inline void exos_qos_filter_accept(exos_qos_filter_t *filter, double value)\r\n{\r\n`;
+        out += `    if (filter->valid && value != filter->reference)\r\n`;
+        out += `    {\r\n`;
+        out += `        filter->direction = value > filter->reference ? 1 : -1;\r\n`;
+        out += `    }\r\n`;
+        out += `    filter->reference = value;\r\n`;
+        out += `    filter->valid = true;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*returns true if the received value should be delivered, otherwise the update is counted as suppressed*/\r\n`;
+        out += `static inline bool exos_qos_deadband(exos_qos_t *qos, double value)\r\n{\r\n`;
+        out += `    if (!exos_qos_filter_exceeded(&qos->filter, value))\r\n`;
+        out += `    {\r\n`;
+        out += `        qos->suppressed++;\r\n`;
+        out += `        return false;\r\n`;
+        out += `    }\r\n`;
+        out += `    exos_qos_filter_accept(&qos->filter, value);\r\n`;
+        out += `    return true;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*returns true (once) if conflated updates were received, in which case the latest value should be delivered*/\r\n`;
+        out += `static inline bool exos_qos_dispatch(exos_qos_t *qos)\r\n{\r\n`;
+        out += `    bool changed = qos->changed;\r\n`;
+        out += `    qos->changed = false;\r\n`;
+        out += `    return changed;\r\n`;
+        out += `}\r\n\r\n`;
+
+        let overloads = "";
+        for (let member of members) {
+            let filters = Datamodel.qosMemberFilters(member);
+            let prefix = `${this.typeName}${member.attributes.name}_deadband`;
+            let dataType = member.attributes.dataType;
+
+            out += `/*${member.attributes.name}: deadband filters of the ${dataType} members, the reference is the last delivered value*/\r\n`;
+            out += `typedef struct ${prefix}\r\n{\r\n`;
+            for (let filter of filters) {
+                out += `    exos_qos_filter_t ${filter.name};\r\n`;
+            }
+            out += `\r\n`;
+            out += `    ${dataType} reference;\r\n`;
+            out += `} ${prefix}_t;\r\n\r\n`;
+
+            out += `static inline void ${prefix}_init(${prefix}_t *deadband)\r\n{\r\n`;
+            for (let filter of filters) {
+                out += `    exos_qos_filter_init(&deadband->${filter.name}, ${filter.deadband}, ${filter.relative}, ${filter.hysteresis});\r\n`;
+            }
+            out += `    memset(&deadband->reference, 0, sizeof(deadband->reference));\r\n`;
+            out += `}\r\n\r\n`;
+
+            out += `/*returns true if a filtered member moved out of its deadband or any other member changed, otherwise the update is counted as suppressed*/\r\n`;
+            out += `static inline bool ${prefix}_filter(${prefix}_t *deadband, exos_qos_t *qos, const ${dataType} *value)\r\n{\r\n`;
+            out += `    ${dataType} masked;\r\n`;
+            out += `    bool exceeded = false;\r\n\r\n`;
+            out += `    memcpy(&masked, value, sizeof(masked));\r\n`;
+            for (let filter of filters) {
+                out += `    exceeded = exos_qos_filter_exceeded(&deadband->${filter.name}, (double)value->${filter.access.substring(1)}) || exceeded;\r\n`;
+                out += `    masked${filter.access} = deadband->reference${filter.access};\r\n`;
+            }
+            out += `\r\n`;
+            out += `    if (!exceeded && 0 == memcmp(&masked, &deadband->reference, sizeof(masked)))\r\n`;
+            out += `    {\r\n`;
+            out += `        qos->suppressed++;\r\n`;
+            out += `        return false;\r\n`;
+            out += `    }\r\n`;
+            for (let filter of filters) {
+                out += `    exos_qos_filter_accept(&deadband->${filter.name}, (double)value->${filter.access.substring(1)});\r\n`;
+            }
+            out += `    memcpy(&deadband->reference, value, sizeof(deadband->reference));\r\n`;
+            out += `    return true;\r\n`;
+            out += `}\r\n\r\n`;
+
+            overloads += `inline void exos_qos_members_init(${prefix}_t &deadband) { ${prefix}_init(&deadband); }\r\n`;
+            overloads += `inline bool exos_qos_members(${prefix}_t &deadband, exos_qos_t *qos, const ${dataType} &value) { return ${prefix}_filter(&deadband, qos, &value); }\r\n`;
+        }
+
+        out += `#ifdef __cplusplus\r\n`;
+        out += `#include <type_traits>\r\n\r\n`;
+        out += `/*deadband of any dataset value, only numeric values are filtered*/\r\n`;
+        out += `template <typename T>\r\n`;
+        out += `inline bool exos_qos_deadband_value(exos_qos_t *qos, const T &value, typename std::enable_if<std::is_arithmetic<T>::value>::type * = 0)\r\n{\r\n`;
+        out += `    return exos_qos_deadband(qos, (double)value);\r\n`;
+        out += `}\r\n\r\n`;
+        out += `template <typename T>\r\n`;
+        out += `inline bool exos_qos_deadband_value(exos_qos_t *qos, const T &value, typename std::enable_if<!std::is_arithmetic<T>::value>::type * = 0)\r\n{\r\n`;
+        out += `    return true;\r\n`;
+        out += `}\r\n\r\n`;
+        out += `/*member deadbands of a structure dataset, datasets without member deadbands use exos_qos_no_members*/\r\n`;
+        out += `struct exos_qos_no_members {};\r\n`;
+        out += `inline void exos_qos_members_init(exos_qos_no_members &) {}\r\n`;
+        out += `template <typename T>\r\n`;
+        out += `inline bool exos_qos_members(exos_qos_no_members &, exos_qos_t *, const T &) { return true; }\r\n`;
+        out += overloads;
+        out += `#endif\r\n\r\n`;
+
+        out += `#endif // ${guard}\r\n`;
+
+        return out;
+    }
+
+    /**
+     * Internal function to generate the process mode header accessible via `Datamodel.processFile`.
+     * 
+     * The header holds a `exos_process_t` state, which is updated before and after each `exos_datamodel_process()` call.
+     * It sets the process mode of the datamodel, and measures the CPU time of the processing thread and the latency of received datasets,
+     * so that the mode of a component can be chosen from measured numbers. It is plain C for Linux (uses `clock_gettime()`).
+     * @returns {string}
+     */
+    _makeProcessHeader() {
+        let guard = `_EXOS_COMP_${this.typeName.toUpperCase()}_PROCESS_H_`;
+        let out = "";
+
+        out += `/*Automatically generated process mode header from ${path.basename(this.fileName)}*/\r\n\r\n`;
+        out += `#ifndef ${guard}\r\n`;
+        out += `#define ${guard}\r\n\r\n`;
+        out += `#include <stdint.h>\r\n`;
+        out += `#include <stdbool.h>\r\n`;
+        out += `#include <time.h>\r\n`;
+        out += `#include "exos_api.h"\r\n\r\n`;
+
+        out += `/*Process modes of the application loop calling process():\r\n`;
+        out += `    EXOS_PROCESS_BLOCKING       process() blocks until the next DMR cycle, lowest CPU use (default)\r\n`;
+        out += `    EXOS_PROCESS_NON_BLOCKING   process() returns immediately, so that the application can do other work in its own loop\r\n`;
+        out += `    EXOS_PROCESS_ADAPTIVE       after each DMR cycle, process() polls without blocking for spin_window (us), then blocks again.\r\n`;
+        out += `                                Updates arriving within the window are delivered with the least latency, at the cost of CPU\r\n`;
+        out += `*/\r\n`;
+        out += `typedef enum exos_process_mode\r\n{\r\n`;
+        out += `    EXOS_PROCESS_BLOCKING,\r\n`;
+        out += `    EXOS_PROCESS_NON_BLOCKING,\r\n`;
+        out += `    EXOS_PROCESS_ADAPTIVE\r\n`;
+        out += `} exos_process_mode_t;\r\n\r\n`;
+
+        out += `/*Measurements since the mode was set:\r\n`;
+        out += `    cycles          process() calls, of which blocked calls blocked until the next DMR cycle\r\n`;
+        out += `    cpu_time        CPU time (us) of the thread calling process() within wall_time (us), cpu_load = cpu_time / wall_time in percent\r\n`;
+        out += `    latency_avg     average delivery latency (us) of the received datasets, nettime at reception minus nettime of the publish\r\n`;
+        out += `    latency_max     maximum delivery latency (us)\r\n`;
+        out += `*/\r\n`;
+        out += `typedef struct exos_process_stats\r\n{\r\n`;
+        out += `    uint32_t cycles;\r\n`;
+        out += `    uint32_t blocked;\r\n`;
+        out += `    uint32_t updates;\r\n`;
+        out += `    uint64_t cpu_time;\r\n`;
+        out += `    uint64_t wall_time;\r\n`;
+        out += `    double cpu_load;\r\n`;
+        out += `    double latency_avg;\r\n`;
+        out += `    int32_t latency_max;\r\n`;
+        out += `} exos_process_stats_t;\r\n\r\n`;
+
+        out += `typedef struct exos_process\r\n{\r\n`;
+        out += `    exos_process_mode_t mode;\r\n`;
+        out += `    uint32_t spin_window;\r\n`;
+        out += `    exos_process_stats_t stats;\r\n\r\n`;
+        out += `    EXOS_DATAMODEL_PROCESS_MODE datamodel_mode;\r\n`;
+        out += `    bool datamodel_mode_set;\r\n`;
+        out += `    int64_t spin_until;\r\n`;
+        out += `    int64_t cpu_start;\r\n`;
+        out += `    int64_t wall_start;\r\n`;
+        out += `    int64_t latency_sum;\r\n`;
+        out += `} exos_process_t;\r\n\r\n`;
+
+        out += `static inline int64_t exos_process_clock(clockid_t clock)\r\n{\r\n`;
+        out += `    struct timespec ts;\r\n`;
+        out += `    clock_gettime(clock, &ts);\r\n`;
+        out += `    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*select the mode and restart the measurements, the mode of the datamodel is changed in the next exos_process_begin()*/\r\n`;
+        out += `static inline void exos_process_set_mode(exos_process_t *process, exos_process_mode_t mode, uint32_t spin_window)\r\n{\r\n`;
+        out += `    exos_process_stats_t stats = {0};\r\n\r\n`;
+        out += `    process->mode = mode;\r\n`;
+        out += `    process->spin_window = spin_window;\r\n`;
+        out += `    process->stats = stats;\r\n`;
+        out += `    process->spin_until = 0;\r\n`;
+        out += `    process->latency_sum = 0;\r\n`;
+        out += `    process->wall_start = 0; //the clocks are read by the processing thread in exos_process_begin()\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*set the mode of the datamodel, call right before exos_datamodel_process()*/\r\n`;
+        out += `static inline EXOS_ERROR_CODE exos_process_begin(exos_process_t *process, exos_datamodel_handle_t *datamodel)\r\n{\r\n`;
+        out += `    EXOS_DATAMODEL_PROCESS_MODE mode = EXOS_DATAMODEL_PROCESS_BLOCKING;\r\n\r\n`;
+        out += `    if (0 == process->wall_start)\r\n`;
+        out += `    {\r\n`;
+        out += `        process->cpu_start = exos_process_clock(CLOCK_THREAD_CPUTIME_ID);\r\n`;
+        out += `        process->wall_start = exos_process_clock(CLOCK_MONOTONIC);\r\n`;
+        out += `    }\r\n\r\n`;
+        out += `    switch (process->mode)\r\n`;
+        out += `    {\r\n`;
+        out += `    case EXOS_PROCESS_NON_BLOCKING:\r\n`;
+        out += `        mode = EXOS_DATAMODEL_PROCESS_NON_BLOCKING;\r\n`;
+        out += `        break;\r\n`;
+        out += `    case EXOS_PROCESS_ADAPTIVE:\r\n`;
+        out += `        if (exos_process_clock(CLOCK_MONOTONIC) < process->spin_until)\r\n`;
+        out += `        {\r\n`;
+        out += `            mode = EXOS_DATAMODEL_PROCESS_NON_BLOCKING;\r\n`;
+        out += `        }\r\n`;
+        out += `        break;\r\n`;
+        out += `    default:\r\n`;
+        out += `        break;\r\n`;
+        out += `    }\r\n\r\n`;
+        out += `    if (!process->datamodel_mode_set || mode != process->datamodel_mode)\r\n`;
+        out += `    {\r\n`;
+        out += `        EXOS_ERROR_CODE error = exos_datamodel_set_process_mode(datamodel, mode);\r\n`;
+        out += `        if (EXOS_ERROR_OK != error)\r\n`;
+        out += `        {\r\n`;
+        out += `            return error;\r\n`;
+        out += `        }\r\n`;
+        out += `        process->datamodel_mode = mode;\r\n`;
+        out += `        process->datamodel_mode_set = true;\r\n`;
+        out += `    }\r\n`;
+        out += `    return EXOS_ERROR_OK;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*update the measurements, call right after exos_datamodel_process(). In adaptive mode, a blocking call returned with a new DMR cycle,\r\n`;
+        out += `  which starts the spin window*/\r\n`;
+        out += `static inline void exos_process_end(exos_process_t *process)\r\n{\r\n`;
+        out += `    int64_t now = exos_process_clock(CLOCK_MONOTONIC);\r\n\r\n`;
+        out += `    process->stats.cycles++;\r\n`;
+        out += `    if (EXOS_DATAMODEL_PROCESS_BLOCKING == process->datamodel_mode)\r\n`;
+        out += `    {\r\n`;
+        out += `        process->stats.blocked++;\r\n`;
+        out += `        if (EXOS_PROCESS_ADAPTIVE == process->mode)\r\n`;
+        out += `        {\r\n`;
+        out += `            process->spin_until = now + process->spin_window;\r\n`;
+        out += `        }\r\n`;
+        out += `    }\r\n\r\n`;
+        out += `    process->stats.wall_time = (uint64_t)(now - process->wall_start);\r\n`;
+        out += `    process->stats.cpu_time = (uint64_t)(exos_process_clock(CLOCK_THREAD_CPUTIME_ID) - process->cpu_start);\r\n`;
+        out += `    process->stats.cpu_load = process->stats.wall_time > 0 ? 100.0 * process->stats.cpu_time / process->stats.wall_time : 0;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*add the latency (us) of a received dataset, nettime at reception minus dataset->nettime*/\r\n`;
+        out += `static inline void exos_process_latency(exos_process_t *process, int32_t latency)\r\n{\r\n`;
+        out += `    process->stats.updates++;\r\n`;
+        out += `    process->latency_sum += latency;\r\n`;
+        out += `    process->stats.latency_avg = (double)process->latency_sum / process->stats.updates;\r\n`;
+        out += `    if (latency > process->stats.latency_max)\r\n`;
+        out += `    {\r\n`;
+        out += `        process->stats.latency_max = latency;\r\n`;
+        out += `    }\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `#endif // ${guard}\r\n`;
+
+        return out;
+    }
+
+    /**
+     * Internal function to generate the publish group header accessible via `Datamodel.groupFile`.
+     * 
+     * The header holds a `exos_group_t` state with the inline functions the templates use to publish and receive the groups
+     * found by {@linkcode publishGroups}, and a `<typeName><group>_snapshot_t` per group holding one consistent copy of its members.
+     * It is plain C, so it can be used from the C and C++ templates on AR and Linux alike.
+     * @returns {string}
+     */
+    _makeGroupHeader() {
+        let guard = `_EXOS_COMP_${this.typeName.toUpperCase()}_GROUP_H_`;
+        let out = "";
+
+        out += `/*Automatically generated publish group header from ${path.basename(this.fileName)}*/\r\n\r\n`;
+        out += `#ifndef ${guard}\r\n`;
+        out += `#define ${guard}\r\n\r\n`;
+        out += `#include <stdint.h>\r\n`;
+        out += `#include <stdbool.h>\r\n`;
+        out += `#include "${this.headerFile.name}"\r\n\r\n`;
+
+        out += `/*Publish group of datasets, configured from the annotations in the .typ file:\r\n`;
+        out += `    GROUP=<name>     the dataset is a member of the group\r\n`;
+        out += `    GROUPTAG=<name>  the UDINT dataset carrying the sequence number of the group, added to the .typ file by the generator\r\n`;
+        out += `The publisher publishes all members, then the next sequence number in the tag. The receiver marks the members it receives,\r\n`;
+        out += `and when the tag arrives after all members were received, the members hold one consistent publish and the group is complete.\r\n`;
+        out += `A tag arriving before all members is counted as incomplete, sequence numbers that never arrived are counted as skipped.\r\n`;
+        out += `On the publisher, complete counts the publishes of the group\r\n`;
+        out += `*/\r\n`;
+        out += `typedef struct exos_group\r\n{\r\n`;
+        out += `    uint32_t members;\r\n`;
+        out += `    uint32_t received;\r\n`;
+        out += `    uint32_t sequence;\r\n`;
+        out += `    uint32_t complete;\r\n`;
+        out += `    uint32_t incomplete;\r\n`;
+        out += `    uint32_t skipped;\r\n`;
+        out += `} exos_group_t;\r\n\r\n`;
+
+        out += `static inline void exos_group_init(exos_group_t *group, uint32_t count)\r\n{\r\n`;
+        out += `    group->members = (count >= 32) ? 0xFFFFFFFF : ((1u << count) - 1);\r\n`;
+        out += `    group->received = 0;\r\n`;
+        out += `    group->sequence = 0;\r\n`;
+        out += `    group->complete = 0;\r\n`;
+        out += `    group->incomplete = 0;\r\n`;
+        out += `    group->skipped = 0;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*mark the member (index within the group) as received*/\r\n`;
+        out += `static inline void exos_group_received(exos_group_t *group, uint32_t member)\r\n{\r\n`;
+        out += `    group->received |= 1u << member;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*returns the sequence number for the tag of the next publish, 0 is left out so that it always differs from an unpublished tag*/\r\n`;
+        out += `static inline uint32_t exos_group_next(exos_group_t *group)\r\n{\r\n`;
+        out += `    group->sequence++;\r\n`;
+        out += `    if (0 == group->sequence)\r\n`;
+        out += `    {\r\n`;
+        out += `        group->sequence++;\r\n`;
+        out += `    }\r\n`;
+        out += `    group->complete++;\r\n`;
+        out += `    return group->sequence;\r\n`;
+        out += `}\r\n\r\n`;
+
+        out += `/*returns true if all members were received since the previous tag, so that they form a consistent snapshot*/\r\n`;
+        out += `static inline bool exos_group_tag(exos_group_t *group, uint32_t sequence)\r\n{\r\n`;
+        out += `    bool complete = ((group->received & group->members) == group->members);\r\n`;
+        out += `    uint32_t distance = sequence - group->sequence;\r\n\r\n`;
+        out += `    if (0 != group->sequence && distance > 1 && distance < 0x80000000u)\r\n`;
+        out += `    {\r\n`;
+        out += `        //a sequence number below the previous one wrapped around, past the 0 that is never published\r\n`;
+        out += `        group->skipped += distance - 1 - (sequence < group->sequence ? 1 : 0);\r\n`;
+        out += `    }\r\n`;
+        out += `    group->sequence = sequence;\r\n`;
+        out += `    group->received = 0;\r\n`;
+        out += `    if (complete)\r\n`;
+        out += `    {\r\n`;
+        out += `        group->complete++;\r\n`;
+        out += `    }\r\n`;
+        out += `    else\r\n`;
+        out += `    {\r\n`;
+        out += `        group->incomplete++;\r\n`;
+        out += `    }\r\n`;
+        out += `    return complete;\r\n`;
+        out += `}\r\n\r\n`;
+
+        for (let group of Datamodel.publishGroups(this.dataset)) {
+            let prefix = `${this.typeName}${group.name}_snapshot`;
+            out += `/*${group.name}: copy of the members of the last complete group, with the sequence number of ${group.tag}*/\r\n`;
+            out += `typedef struct ${prefix}\r\n{\r\n`;
+            for (let name of group.members) {
+                let member = this.dataset.children.find(child => child.attributes.name == name);
+                out += `    ${Datamodel.convertPlcType(member.attributes.dataType)} ${name}`;
+                if (member.attributes.arraySize > 0) {
+                    out += `[${member.attributes.arraySize}]`;
+                }
+                if (member.attributes.dataType == "STRING") {
+                    out += `[${member.attributes.stringLength}]`;
+                }
+                out += `;\r\n`;
+            }
+            out += `    uint32_t sequence;\r\n`;
+            out += `} ${prefix}_t;\r\n\r\n`;
+        }
+
+        out += `#endif // ${guard}\r\n`;
+
+        return out;
+    }
+
     /**
      * Internal function to generate the C-declaration of the IEC datatype `typeName`, that can be accessible via `Datamodel.dataTypeCode` or `Datamodel.dataTypeCodeSWIG` properties.
      * 
@@ -886,6 +2214,14 @@ class Datamodel {
                     else return null;
                 }
                 
+                /** add the parsed QoS annotations (if any) to the member */
+                function _withQos(member, qos) {
+                    if (member != null && qos !== undefined) {
+                        member.attributes.qos = qos;
+                    }
+                    return member;
+                }
+
                 function plcTypeNotSupported(type)
                 {
                     switch(type)
@@ -962,12 +2298,14 @@ class Datamodel {
                         throw (`IEC Type ${type} is not supported -> member "${name}"`);
                     }
 
+                    let qos = Datamodel.parseQos(comment, name, type.includes("STRING") ? "STRING" : type, arraySize, structNestingDepth > 0);
+
                     let dataset = {dataType: type, type: "notenum"};
                     if (type.includes("STRING")) {
                         if (arraySize > 0) nestingDepth -= dimensions.length;
                         let length = _takeout(type, "[", "]");
                         if (length != null) {
-                            return {
+                            return _withQos({
                                 name: "variable",
                                 attributes: {
                                     name: name,
@@ -977,12 +2315,12 @@ class Datamodel {
                                     comment: comment,
                                     arraySize: arraySize
                                 }
-                            }
+                            }, qos);
                         }
                     }
                     else if (Datamodel.isScalarType(dataset)) {
                         if (arraySize > 0) nestingDepth -= dimensions.length;
-                        return {
+                        return _withQos({
                             name: "variable",
                             attributes: {
                                 name: name,
@@ -991,7 +2329,7 @@ class Datamodel {
                                 comment: comment,
                                 arraySize: arraySize
                             }
-                        }
+                        }, qos);
                     }
                     else {
                         //datatype detected = dig deeper
@@ -999,7 +2337,7 @@ class Datamodel {
                         let result = _parseTyp(fileLines, name, type, comment, arraySize);
                         structNestingDepth--;
                         if (arraySize > 0) nestingDepth -= dimensions.length;
-                        return result
+                        return _withQos(result, qos);
                     }
                 }
                 return null;
@@ -1105,13 +2443,17 @@ if (require.main === module) {
 
                 console.log(Datamodel.getDatatypeList(fileName));
 
+                if (process.argv.length > 4 && process.argv[4] == "layout") {
+                    process.stdout.write(datamodel.makeLayoutReport(Datamodel.parseLayoutRates(process.argv[5])));
+                }
+
         } else {
             process.stderr.write(`file '${fileName}' not found.`);
         }
 
     }
     else {
-        process.stderr.write("usage: ./Datamodel.js <filename.typ> <structname>\r\n");
+        process.stderr.write("usage: ./Datamodel.js <filename.typ> <structname> [layout [<dataset>=<rate>,..]]\r\n");
     }
 }
 
@@ -0,0 +1,111 @@
+/* Measurement of the benchmark drivers generated by benchmark.js, in C and C++
+
+   A driver runs --warmup cycles (default 200) before it measures --cycles cycles (default 2000). In each
+   cycle it calls process() of the binding, counts the received datasets with bench_update() and publishes
+   all datasets it can publish between bench_publish_begin() and bench_publish_end(). bench_report() prints
+   the line parsed by benchmark.js:
+
+       bench: updates <n> publishes <n> publish_ns <ns> cpu_ns <ns> wall_ns <ns> maxrss_kb <kB>
+
+   cpu_ns is the CPU time of the process and wall_ns the wall time of the measured cycles, publish_ns the
+   wall time spent in the publish calls. */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+typedef struct
+{
+    uint32_t warmup;
+    uint32_t cycles;
+    uint32_t cycle;
+    uint64_t updates;
+    uint64_t publishes;
+    uint64_t publish_ns;
+    uint64_t publish_start;
+    uint64_t cpu_ns;
+    uint64_t wall_ns;
+} bench_t;
+
+static inline uint64_t bench_ns(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline void bench_init(bench_t *bench, int argc, char **argv)
+{
+    memset(bench, 0, sizeof(bench_t));
+    bench->warmup = 200;
+    bench->cycles = 2000;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--warmup"))
+            bench->warmup = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (0 == strcmp(argv[i], "--cycles"))
+            bench->cycles = (uint32_t)strtoul(argv[++i], NULL, 10);
+    }
+}
+
+static inline bool bench_measuring(const bench_t *bench)
+{
+    return bench->cycle > bench->warmup;
+}
+
+/* called at the start of each cycle, false when all cycles are measured */
+static inline bool bench_cycle(bench_t *bench)
+{
+    if (bench->cycle == bench->warmup)
+    {
+        bench->cpu_ns = bench_ns(CLOCK_PROCESS_CPUTIME_ID);
+        bench->wall_ns = bench_ns(CLOCK_MONOTONIC);
+    }
+    else if (bench->cycle == bench->warmup + bench->cycles)
+    {
+        bench->cpu_ns = bench_ns(CLOCK_PROCESS_CPUTIME_ID) - bench->cpu_ns;
+        bench->wall_ns = bench_ns(CLOCK_MONOTONIC) - bench->wall_ns;
+        return false;
+    }
+    bench->cycle++;
+    return true;
+}
+
+static inline void bench_update(bench_t *bench)
+{
+    if (bench_measuring(bench))
+        bench->updates++;
+}
+
+static inline void bench_publish_begin(bench_t *bench)
+{
+    bench->publish_start = bench_ns(CLOCK_MONOTONIC);
+}
+
+static inline void bench_publish_end(bench_t *bench, uint32_t publishes)
+{
+    if (bench_measuring(bench))
+    {
+        bench->publish_ns += bench_ns(CLOCK_MONOTONIC) - bench->publish_start;
+        bench->publishes += publishes;
+    }
+}
+
+static inline void bench_report(const bench_t *bench)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    printf("bench: updates %llu publishes %llu publish_ns %llu cpu_ns %llu wall_ns %llu maxrss_kb %ld\n",
+           (unsigned long long)bench->updates, (unsigned long long)bench->publishes, (unsigned long long)bench->publish_ns,
+           (unsigned long long)bench->cpu_ns, (unsigned long long)bench->wall_ns, usage.ru_maxrss);
+    fflush(stdout);
+}
+
+#endif // _BENCH_H_
@@ -0,0 +1,336 @@
+/*
+ * Overhead of the Linux bindings under identical workloads, compared against a stored baseline:
+ *
+ *    node test/benchmark/benchmark.js [--cycles 2000] [--models a,b] [--bindings a,b] [--tolerance 25] [--update-baseline] [--keep]
+ *
+ * For every model the Linux template of every binding (c-api, c-static, cpp, napi, swig) is generated, and its
+ * generated main replaced by a driver (drivers.js) running the same workload against the DMR stand-in of the
+ * AR host emulation (test/suite/ar_host/dmr_host.c): a peer on the AR side publishes its datasets in every DMR
+ * cycle (1 ms), the driver processes the datamodel, counts the received datasets and publishes all of its datasets.
+ * The drivers measure as described in bench.h, reported per model and binding:
+ *
+ *    ns/update   CPU time of the driver per received dataset, without the time spent in publishing
+ *    ns/publish  time per publish of a dataset
+ *    CPU%        CPU load of the driver
+ *    RSS         maximum resident set size of the driver in kB (for napi and swig including the interpreter)
+ *    size        text and data in bytes of the generated sources of the binding, without the main
+ *
+ * The DMR stand-in is part of every measurement, so the numbers compare the bindings rather than the exOS API.
+ * A binding whose toolchain is missing (node headers for napi, swig and the Python headers for swig) is skipped.
+ * A value more than --tolerance percent above baseline.json is reported as a regression, and the exit code is 1.
+ * The baseline depends on the machine: when it was measured on another CPU model, regressions are only printed as
+ * warnings and the exit code stays 0. --update-baseline stores the results of this run as the new baseline.
+ */
+
+const path = require('path');
+const fs = require('fs');
+const os = require('os');
+const child_process = require('child_process');
+const { Datamodel } = require('../../src/datamodel');
+const { Template } = require('../../src/components/templates/template');
+const { TemplateLinuxC } = require('../../src/components/templates/linux/template_linux_c');
+const { TemplateLinuxStaticCLib } = require('../../src/components/templates/linux/template_linux_static_c_lib');
+const { TemplateLinuxCpp } = require('../../src/components/templates/linux/template_linux_cpp');
+const { TemplateLinuxNAPI } = require('../../src/components/templates/linux/template_linux_napi');
+const { TemplateLinuxSWIG } = require('../../src/components/templates/linux/template_linux_swig');
+const { generatedFiles, compile } = require('../suite/ar_host/ar_host');
+const drivers = require('./drivers');
+
+const dmrHost = path.resolve(__dirname, '../suite/ar_host/dmr_host.c');
+const baselineFile = path.join(__dirname, 'baseline.json');
+const bindings = ["c-api", "c-static", "cpp", "napi", "swig"];
+
+/**
+ * @param {number} datasets number of datasets, alternating published and subscribed by AR
+ * @param {number} members number of members of each dataset
+ * @returns {string} contents of `Wide.typ`, a synthetic model with many datasets of many members
+ */
+function wideTyp(datasets, members) {
+    let types = ["LREAL", "DINT", "BOOL", "UINT", "REAL", "STRING[15]", "ARRAY[0..3]OF LREAL", "USINT"];
+    let out = "";
+
+    out += `\n`;
+    out += `TYPE\n`;
+    out += `\tWideMembers_typ : \tSTRUCT \n`;
+    for (let i = 0; i < members; i++) {
+        out += `\t\tMember${i} : ${types[i % types.length]};\n`;
+    }
+    out += `\tEND_STRUCT;\n`;
+    out += `\tWide : \tSTRUCT \n`;
+    for (let i = 0; i < datasets; i++) {
+        out += `\t\tDataset${i} : WideMembers_typ; (*${i % 2 == 0 ? "PUB" : "SUB"}*)\n`;
+    }
+    out += `\tEND_STRUCT;\n`;
+    out += `END_TYPE\n`;
+
+    return out;
+}
+
+/**
+ * @param {string} workPath
+ * @returns {Object.<string, {typFile: string, typeName: string}>} the benchmarked models
+ */
+function models(workPath) {
+    let wide = path.join(workPath, "Wide.typ");
+    fs.writeFileSync(wide, wideTyp(8, 24));
+    return {
+        StringAndArray: {typFile: path.resolve(__dirname, '../suite/typfiles/StringAndArray.typ'), typeName: "StringAndArray"},
+        ros_topics_typ: {typFile: path.resolve(__dirname, '../suite/typfiles/ros_topics_typ.typ'), typeName: "ros_topics_typ"},
+        BigData: {typFile: path.resolve(__dirname, '../../src/components/templates/test/BigData.typ'), typeName: "BigData"},
+        Wide: {typFile: wide, typeName: "Wide"}
+    };
+}
+
+/**
+ * @param {string} command
+ * @param {string[]} args
+ * @returns {boolean} the command can be run
+ */
+function hasCommand(command, args) {
+    return child_process.spawnSync(command, args, {encoding: "utf8"}).status === 0;
+}
+
+/**
+ * @param {string[]} objects
+ * @returns {number} text and data in bytes of the objects
+ */
+function codeSize(objects) {
+    let size = child_process.spawnSync("size", ["-B", ...objects], {encoding: "utf8"});
+    if (size.status !== 0) {
+        return 0;
+    }
+    return size.stdout.split("\n").slice(1).filter(line => line.trim() != "").reduce((sum, line) => {
+        let [text, data] = line.trim().split(/\s+/).map(Number);
+        return sum + text + data;
+    }, 0);
+}
+
+/**
+ * Builds the driver of the binding for the model in `buildPath`
+ *
+ * @param {{typFile: string, typeName: string}} model
+ * @param {string} binding
+ * @param {string} buildPath existing directory
+ * @returns {{command: string, args: string[], size: number}|{skipped: string}}
+ */
+function buildDriver(model, binding, buildPath) {
+    let datamodel = new Datamodel(model.typFile, model.typeName, [model.typeName]);
+    let linux = new Template(datamodel, true).template;
+    let flags = [`-I${__dirname}`];
+    let files, template, sources;
+
+    switch (binding) {
+        case "c-api":
+        case "c-static":
+        case "cpp": {
+            let LinuxTemplate = {"c-api": TemplateLinuxC, "c-static": TemplateLinuxStaticCLib, "cpp": TemplateLinuxCpp}[binding];
+            let driver = {"c-api": source => drivers.rawSource(source, false), "c-static": drivers.staticCSource, "cpp": drivers.cppSource}[binding];
+            template = new LinuxTemplate(datamodel);
+            files = [...generatedFiles(datamodel), ...generatedFiles(template).filter(file => file !== template.mainSource)];
+            sources = files.filter(file => /\.(c|cpp)$/.test(file.name)).map(file => file.name);
+            files.push({name: `bench_driver.${binding == "cpp" ? "cpp" : "c"}`, contents: driver(linux)});
+            let executable = path.join(buildPath, "bench_driver");
+            compile(files, buildPath, [dmrHost], executable, undefined, [], flags);
+            return {command: executable, args: [], size: codeSize(sources.map(name => path.join(buildPath, `${name}.o`)))};
+        }
+        case "napi": {
+            let nodeInclude = path.resolve(path.dirname(process.execPath), "../include/node");
+            if (!fs.existsSync(path.join(nodeInclude, "node_api.h"))) {
+                return {skipped: `no node_api.h in ${nodeInclude}`};
+            }
+            template = new TemplateLinuxNAPI(datamodel);
+            files = [...generatedFiles(datamodel), template.librarySource];
+            sources = files.filter(file => /\.(c|cpp)$/.test(file.name)).map(file => file.name);
+            files.push({name: "bench_driver.js", contents: drivers.napiSource(linux)});
+            let addon = `l_${model.typeName}`;
+            compile(files, buildPath, [dmrHost], path.join(buildPath, `${addon}.node`), undefined, [`NODE_GYP_MODULE_NAME=${addon}`],
+                [...flags, "-fPIC", "-shared", `-I${nodeInclude}`]);
+            return {command: process.execPath, args: [path.join(buildPath, "bench_driver.js")], size: codeSize(sources.map(name => path.join(buildPath, `${name}.o`)))};
+        }
+        case "swig": {
+            if (!hasCommand("swig", ["-version"])) {
+                return {skipped: "swig not found"};
+            }
+            let includes = child_process.spawnSync("python3-config", ["--includes"], {encoding: "utf8"});
+            if (includes.status !== 0) {
+                return {skipped: "python3-config not found"};
+            }
+            template = new TemplateLinuxSWIG(datamodel);
+            files = [...generatedFiles(datamodel), ...generatedFiles(template).filter(file => file !== template.mainSource && file !== template.pythonMain)];
+            for (let file of files) {
+                fs.writeFileSync(path.join(buildPath, file.name), file.contents);
+            }
+            let wrapper = path.join(buildPath, `${template.swigInclude.name.replace(".i", "")}_wrap.cpp`);
+            let swig = child_process.spawnSync("swig", ["-c++", "-python", "-outdir", buildPath, "-o", wrapper, path.join(buildPath, template.swigInclude.name)], {encoding: "utf8"});
+            if (swig.status !== 0) {
+                throw new Error(`swig failed:\n${swig.stderr}`);
+            }
+            sources = [...files.filter(file => /\.(c|cpp)$/.test(file.name)).map(file => file.name), path.basename(wrapper)];
+            files.push({name: "bench_driver.py", contents: drivers.pythonSource(linux)});
+            compile(files, buildPath, [wrapper, dmrHost], path.join(buildPath, `_${linux.datamodel.libStructName}.so`), undefined, [],
+                [...flags, "-fPIC", "-shared", ...includes.stdout.trim().split(/\s+/)]);
+            return {command: "python3", args: [path.join(buildPath, "bench_driver.py")], size: codeSize(sources.map(name => path.join(buildPath, `${name}.o`)))};
+        }
+        default:
+            throw new Error(`unknown binding ${binding}`);
+    }
+}
+
+/**
+ * Builds the peer of the model: the AR side with the exOS API, publishing until SIGTERM
+ *
+ * @param {{typFile: string, typeName: string}} model
+ * @param {string} buildPath existing directory
+ * @returns {string} executable
+ */
+function buildPeer(model, buildPath) {
+    let datamodel = new Datamodel(model.typFile, model.typeName, [model.typeName]);
+    let files = [...generatedFiles(datamodel), {name: "peer.c", contents: drivers.rawSource(new Template(datamodel, false).template, true)}];
+    let executable = path.join(buildPath, "peer");
+    compile(files, buildPath, [dmrHost], executable, undefined, [], [`-I${__dirname}`]);
+    return executable;
+}
+
+/**
+ * Runs the driver against the peer and computes the metrics from its report
+ *
+ * @param {string} peer executable
+ * @param {{command: string, args: string[], size: number}} driver
+ * @param {number} cycles
+ * @param {string} buildPath
+ * @returns {{nsUpdate: number, nsPublish: number, cpu: number, rss: number, size: number}}
+ */
+function run(peer, driver, cycles, buildPath) {
+    let dmr = `exos-bench-${process.pid}-${path.basename(buildPath)}`;
+    let env = {...process.env, EXOS_HOST_DMR: dmr};
+    let peerProcess = child_process.spawn(peer, [], {env: env, stdio: "ignore"});
+    let result;
+    try {
+        result = child_process.spawnSync(driver.command, [...driver.args, "--cycles", `${cycles}`], {cwd: buildPath, env: env, encoding: "utf8", timeout: cycles * 20 + 60000});
+    }
+    finally {
+        peerProcess.kill("SIGTERM");
+        fs.rmSync(path.join("/dev/shm", dmr), {force: true});
+    }
+    let report = result.stdout !== null ? result.stdout.match(/^bench: updates (\d+) publishes (\d+) publish_ns (\d+) cpu_ns (\d+) wall_ns (\d+) maxrss_kb (\d+)$/m) : null;
+    if (report === null) {
+        throw new Error(`${driver.command} ${driver.args.join(" ")} failed (${result.error || `status ${result.status}`}):\n${result.stdout}${result.stderr}`);
+    }
+    let [updates, publishes, publishNs, cpuNs, wallNs, rss] = report.slice(1).map(Number);
+    return {
+        nsUpdate: updates > 0 ? Math.round((cpuNs - publishNs) / updates) : 0,
+        nsPublish: publishes > 0 ? Math.round(publishNs / publishes) : 0,
+        cpu: Math.round(cpuNs / wallNs * 1000) / 10,
+        rss: rss,
+        size: driver.size
+    };
+}
+
+/**
+ * @param {Object.<string, Object>} results per `model/binding`
+ * @param {Object} baseline as stored by --update-baseline
+ * @param {number} tolerance percent
+ * @returns {string[]} regressions
+ */
+function regressions(results, baseline, tolerance) {
+    let found = [];
+    for (let [key, result] of Object.entries(results)) {
+        let base = baseline.results !== undefined ? baseline.results[key] : undefined;
+        if (base === undefined || result.skipped !== undefined) {
+            continue;
+        }
+        for (let metric of ["nsUpdate", "nsPublish", "rss", "size"]) {
+            if (base[metric] > 0 && result[metric] > base[metric] * (1 + tolerance / 100)) {
+                found.push(`${key} ${metric} ${result[metric]} > ${base[metric]} (+${Math.round((result[metric] / base[metric] - 1) * 100)}%)`);
+                result.regressed = [...(result.regressed || []), metric];
+            }
+        }
+    }
+    return found;
+}
+
+/**
+ * @param {Object.<string, Object>} results per `model/binding`
+ * @returns {string} comparison table, regressed values marked with `!`
+ */
+function table(results) {
+    let header = ["model", "binding", "ns/update", "ns/publish", "CPU%", "RSS kB", "size B"];
+    let rows = Object.entries(results).map(([key, result]) => {
+        let [model, binding] = key.split("/");
+        if (result.skipped !== undefined) {
+            return [model, binding, `skipped: ${result.skipped}`];
+        }
+        let mark = metric => `${result[metric]}${(result.regressed || []).includes(metric) ? "!" : ""}`;
+        return [model, binding, mark("nsUpdate"), mark("nsPublish"), `${result.cpu}`, mark("rss"), mark("size")];
+    });
+    let widths = header.map((title, i) => Math.max(title.length, ...rows.filter(row => row.length > 3).map(row => row[i].length)));
+    let line = row => row.map((cell, i) => i < 2 ? cell.padEnd(widths[i]) : row.length > 3 ? cell.padStart(widths[i]) : cell).join("  ");
+    return [line(header), ...rows.map(line)].join("\n");
+}
+
+function main() {
+    let args = process.argv.slice(2);
+    let option = (name, value) => args.includes(name) ? args[args.indexOf(name) + 1] : value;
+    let cycles = parseInt(option("--cycles", "2000"));
+    let tolerance = parseFloat(option("--tolerance", "25"));
+    let workPath = fs.mkdtempSync(path.join(os.tmpdir(), "exos-benchmark-"));
+    let results = {};
+
+    try {
+        let all = models(workPath);
+        let selectedModels = option("--models", Object.keys(all).join(",")).split(",");
+        let selectedBindings = option("--bindings", bindings.join(",")).split(",");
+        for (let name of selectedModels) {
+            if (all[name] === undefined) {
+                throw new Error(`unknown model ${name}, one of ${Object.keys(all).join(", ")}`);
+            }
+            let modelPath = path.join(workPath, name);
+            fs.mkdirSync(path.join(modelPath, "peer"), {recursive: true});
+            let peer = buildPeer(all[name], path.join(modelPath, "peer"));
+            for (let binding of selectedBindings) {
+                let buildPath = path.join(modelPath, binding);
+                fs.mkdirSync(buildPath);
+                let driver = buildDriver(all[name], binding, buildPath);
+                results[`${name}/${binding}`] = driver.skipped !== undefined ? driver : run(peer, driver, cycles, buildPath);
+                console.error(`${name}/${binding} done`);
+            }
+        }
+    }
+    finally {
+        if (args.includes("--keep")) {
+            console.error(`build directory kept in ${workPath}`);
+        }
+        else {
+            fs.rmSync(workPath, {recursive: true, force: true});
+        }
+    }
+
+    let baseline = fs.existsSync(baselineFile) ? JSON.parse(fs.readFileSync(baselineFile, "utf8")) : {};
+    let found = args.includes("--update-baseline") ? [] : regressions(results, baseline, tolerance);
+    console.log(table(results));
+    if (args.includes("--update-baseline")) {
+        let stored = Object.fromEntries(Object.entries(results).filter(([, result]) => result.skipped === undefined));
+        fs.writeFileSync(baselineFile, JSON.stringify({cpu: os.cpus()[0].model, cycles: cycles, results: {...baseline.results, ...stored}}, null, 4) + "\n");
+        console.log(`\nbaseline updated in ${baselineFile}`);
+    }
+    //a baseline from another machine says little about this one, so it does not fail the run
+    let sameMachine = baseline.cpu === undefined || baseline.cpu == os.cpus()[0].model;
+    if (!sameMachine) {
+        console.log(`\nbaseline measured on ${baseline.cpu}, not on ${os.cpus()[0].model}: regressions are warnings only`);
+    }
+    if (found.length > 0) {
+        console.log(`\n${found.length} ${sameMachine ? "regressions" : "warnings"} above ${tolerance}% of the baseline:`);
+        for (let regression of found) {
+            console.log(`    ${regression}`);
+        }
+        if (sameMachine) {
+            process.exitCode = 1;
+        }
+    }
+}
+
+if (require.main === module) {
+    main();
+}
+
+module.exports = {wideTyp, models, buildDriver, buildPeer, run};
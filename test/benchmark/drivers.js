@@ -0,0 +1,328 @@
+/*
+ * Sources of the benchmark drivers, one per binding, replacing the generated main of the Linux template.
+ * Every driver runs the same workload, measured as described in bench.h: in each cycle it processes the
+ * datamodel, counts the received datasets and publishes all datasets it can publish.
+ * The peer is the AR side of the datamodel using the exOS API, publishing its datasets in every cycle.
+ */
+
+/**
+ * @typedef {import('../../src/components/templates/template').ApplicationTemplate} ApplicationTemplate
+ */
+
+/**
+ * @param {ApplicationTemplate} template
+ * @returns {{subscribed: Object[], published: Object[]}} datasets of the template, without the private ones
+ */
+function datasets(template) {
+    let visible = template.datasets.filter(dataset => !dataset.isPrivate);
+    return {subscribed: visible.filter(dataset => dataset.isSub), published: visible.filter(dataset => dataset.isPub)};
+}
+
+/**
+ * The datamodel with the exOS API, as the peer (AR side, publishing until SIGTERM) or as the `c-api` driver (Linux side)
+ *
+ * @param {ApplicationTemplate} template for AR (peer) or Linux (driver)
+ * @param {boolean} peer
+ * @returns {string} C source
+ */
+function rawSource(template, peer) {
+    let {published} = datasets(template);
+    let all = template.datasets.filter(dataset => !dataset.isPrivate && (dataset.isSub || dataset.isPub));
+    let out = "";
+
+    out += `/* Generated by benchmark.js: ${peer ? "peer" : "c-api benchmark driver"} of ${template.datamodel.structName} with the exOS API */\n`;
+    out += `\n`;
+    out += `#include <signal.h>\n`;
+    out += `#include "${template.headerName}"\n`;
+    out += `#include "bench.h"\n`;
+    out += `\n`;
+    out += `static ${template.datamodel.structName} data;\n`;
+    out += `static bench_t bench;\n`;
+    if (peer) {
+        out += `static volatile sig_atomic_t terminated = 0;\n`;
+        out += `\n`;
+        out += `static void terminate(int signal)\n`;
+        out += `{\n`;
+        out += `    terminated = 1;\n`;
+        out += `}\n`;
+    }
+    out += `\n`;
+    out += `static void datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info)\n`;
+    out += `{\n`;
+    out += `}\n`;
+    out += `\n`;
+    out += `static void datasetEvent(exos_dataset_handle_t *dataset, EXOS_DATASET_EVENT_TYPE event_type, void *info)\n`;
+    out += `{\n`;
+    out += `    if (EXOS_DATASET_EVENT_UPDATED == event_type)\n`;
+    out += `        bench_update(&bench);\n`;
+    out += `}\n`;
+    out += `\n`;
+    out += `int main(int argc, char **argv)\n`;
+    out += `{\n`;
+    out += `    exos_datamodel_handle_t datamodel;\n`;
+    for (let dataset of all) {
+        out += `    exos_dataset_handle_t ${dataset.varName};\n`;
+    }
+    out += `\n`;
+    out += `    bench_init(&bench, argc, argv);\n`;
+    out += `    exos_datamodel_init(&datamodel, "${template.datamodelInstanceName}", "${peer ? "peer" : template.aliasName}");\n`;
+    for (let dataset of all) {
+        out += `    exos_dataset_init(&${dataset.varName}, &datamodel, "${dataset.structName}", &data.${dataset.structName}, sizeof(data.${dataset.structName}));\n`;
+    }
+    out += `    exos_datamodel_connect_${template.datamodel.structName.toLowerCase()}(&datamodel, datamodelEvent);\n`;
+    for (let dataset of all) {
+        let type = [dataset.isPub ? "EXOS_DATASET_PUBLISH" : "", dataset.isSub ? "EXOS_DATASET_SUBSCRIBE" : ""].filter(t => t != "").join(" + ");
+        out += `    exos_dataset_connect(&${dataset.varName}, ${type}, datasetEvent);\n`;
+    }
+    out += `\n`;
+    if (peer) {
+        out += `    signal(SIGTERM, terminate);\n`;
+        out += `    signal(SIGINT, terminate);\n`;
+        out += `    while (!terminated)\n`;
+    }
+    else {
+        out += `    while (bench_cycle(&bench))\n`;
+    }
+    out += `    {\n`;
+    out += `        exos_datamodel_process(&datamodel);\n`;
+    out += `\n`;
+    out += `        bench_publish_begin(&bench);\n`;
+    for (let dataset of published) {
+        out += `        exos_dataset_publish(&${dataset.varName});\n`;
+    }
+    out += `        bench_publish_end(&bench, ${published.length});\n`;
+    out += `    }\n`;
+    out += `\n`;
+    out += `    exos_datamodel_delete(&datamodel);\n`;
+    if (!peer) {
+        out += `    bench_report(&bench);\n`;
+    }
+    out += `    return 0;\n`;
+    out += `}\n`;
+
+    return out;
+}
+
+/**
+ * @param {ApplicationTemplate} template for Linux
+ * @returns {string} C source of the `c-static` driver
+ */
+function staticCSource(template) {
+    let {subscribed, published} = datasets(template);
+    let handle = template.datamodel.varName;
+    let out = "";
+
+    out += `/* Generated by benchmark.js: c-static benchmark driver of ${template.datamodel.structName} */\n`;
+    out += `\n`;
+    out += `#include "${template.libHeaderName}"\n`;
+    out += `#include "bench.h"\n`;
+    out += `\n`;
+    out += `static bench_t bench;\n`;
+    out += `\n`;
+    out += `static void on_change(void)\n`;
+    out += `{\n`;
+    out += `    bench_update(&bench);\n`;
+    out += `}\n`;
+    out += `\n`;
+    out += `int main(int argc, char **argv)\n`;
+    out += `{\n`;
+    out += `    ${template.datamodel.libStructName}_t *${handle} = ${template.datamodel.libStructName}_init();\n`;
+    out += `\n`;
+    out += `    bench_init(&bench, argc, argv);\n`;
+    for (let dataset of subscribed) {
+        out += `    ${handle}->${dataset.structName}.on_change = on_change;\n`;
+    }
+    out += `    ${handle}->connect();\n`;
+    out += `\n`;
+    out += `    while (bench_cycle(&bench))\n`;
+    out += `    {\n`;
+    out += `        ${handle}->process();\n`;
+    out += `\n`;
+    out += `        bench_publish_begin(&bench);\n`;
+    for (let dataset of published) {
+        out += `        ${handle}->${dataset.structName}.publish();\n`;
+    }
+    out += `        bench_publish_end(&bench, ${published.length});\n`;
+    out += `    }\n`;
+    out += `\n`;
+    out += `    ${handle}->disconnect();\n`;
+    out += `    ${handle}->dispose();\n`;
+    out += `    bench_report(&bench);\n`;
+    out += `    return 0;\n`;
+    out += `}\n`;
+
+    return out;
+}
+
+/**
+ * @param {ApplicationTemplate} template for Linux
+ * @returns {string} C++ source of the `cpp` driver
+ */
+function cppSource(template) {
+    let {subscribed, published} = datasets(template);
+    let handle = template.datamodel.varName;
+    let out = "";
+
+    out += `/* Generated by benchmark.js: cpp benchmark driver of ${template.datamodel.structName} */\n`;
+    out += `\n`;
+    out += `#include "${template.datamodel.structName}Datamodel.hpp"\n`;
+    out += `#include "bench.h"\n`;
+    out += `\n`;
+    out += `static bench_t bench;\n`;
+    out += `\n`;
+    out += `int main(int argc, char **argv)\n`;
+    out += `{\n`;
+    out += `    bench_init(&bench, argc, argv);\n`;
+    out += `    {\n`;
+    out += `        ${template.datamodel.structName}Datamodel ${handle};\n`;
+    out += `        ${handle}.connect();\n`;
+    for (let dataset of subscribed) {
+        out += `        ${handle}.${dataset.structName}.onChange([&] () {bench_update(&bench);});\n`;
+    }
+    out += `\n`;
+    out += `        while (bench_cycle(&bench)) {\n`;
+    out += `            ${handle}.process();\n`;
+    out += `\n`;
+    out += `            bench_publish_begin(&bench);\n`;
+    for (let dataset of published) {
+        out += `            ${handle}.${dataset.structName}.publish();\n`;
+    }
+    out += `            bench_publish_end(&bench, ${published.length});\n`;
+    out += `        }\n`;
+    out += `    }\n`;
+    out += `    bench_report(&bench);\n`;
+    out += `    return 0;\n`;
+    out += `}\n`;
+
+    return out;
+}
+
+/**
+ * @param {ApplicationTemplate} template for Linux
+ * @returns {string} JavaScript source of the `napi` driver, loading `l_<Type>.node` from its directory
+ */
+function napiSource(template) {
+    let {subscribed, published} = datasets(template);
+    let handle = template.datamodel.varName;
+    let out = "";
+
+    out += `// Generated by benchmark.js: napi benchmark driver of ${template.datamodel.structName}\n`;
+    out += `\n`;
+    out += `let ${handle} = require('./l_${template.datamodel.structName}.node').${template.datamodel.structName};\n`;
+    out += `\n`;
+    out += `let option = (name, value) => process.argv.includes(name) ? parseInt(process.argv[process.argv.indexOf(name) + 1]) : value;\n`;
+    out += `let warmup = option("--warmup", 200);\n`;
+    out += `let cycles = option("--cycles", 2000);\n`;
+    out += `let cycle = 0, updates = 0, publishes = 0, publishNs = 0n, cpu, wall;\n`;
+    out += `let update = () => {\n`;
+    out += `    if (cycle > warmup) {\n`;
+    out += `        updates++;\n`;
+    out += `    }\n`;
+    out += `};\n`;
+    out += `\n`;
+    out += `// the N-API wrapper expects every callback to be set\n`;
+    out += `${handle}.onConnectionChange(() => {});\n`;
+    out += `${handle}.onSyncChange(() => {});\n`;
+    for (let dataset of template.datasets.filter(dataset => !dataset.isPrivate && (dataset.isSub || dataset.isPub))) {
+        out += `${handle}.datamodel.${dataset.structName}.onConnectionChange(() => {});\n`;
+    }
+    for (let dataset of subscribed) {
+        out += `${handle}.datamodel.${dataset.structName}.onChange(update);\n`;
+    }
+    out += `\n`;
+    out += `${handle}.onProcessed(() => {\n`;
+    out += `    if (cycle == warmup) {\n`;
+    out += `        cpu = process.cpuUsage();\n`;
+    out += `        wall = process.hrtime.bigint();\n`;
+    out += `    }\n`;
+    out += `    else if (cycle == warmup + cycles) {\n`;
+    out += `        let cpuNs = (process.cpuUsage().user - cpu.user + process.cpuUsage().system - cpu.system) * 1000;\n`;
+    out += `        let wallNs = process.hrtime.bigint() - wall;\n`;
+    out += `        console.log(\`bench: updates \${updates} publishes \${publishes} publish_ns \${publishNs} cpu_ns \${cpuNs} wall_ns \${wallNs} maxrss_kb \${process.resourceUsage().maxRSS}\`);\n`;
+    out += `        process.exit(0);\n`;
+    out += `    }\n`;
+    out += `    cycle++;\n`;
+    out += `\n`;
+    out += `    let start = process.hrtime.bigint();\n`;
+    for (let dataset of published) {
+        out += `    ${handle}.datamodel.${dataset.structName}.publish();\n`;
+    }
+    out += `    if (cycle > warmup) {\n`;
+    out += `        publishNs += process.hrtime.bigint() - start;\n`;
+    out += `        publishes += ${published.length};\n`;
+    out += `    }\n`;
+    out += `});\n`;
+
+    return out;
+}
+
+/**
+ * @param {ApplicationTemplate} template for Linux
+ * @returns {string} Python source of the `swig` driver, importing `lib<Type>` from its directory
+ */
+function pythonSource(template) {
+    let {subscribed, published} = datasets(template);
+    let handle = template.datamodel.varName;
+    let module = template.datamodel.libStructName;
+    let out = "";
+
+    out += `# Generated by benchmark.js: swig/python benchmark driver of ${template.datamodel.structName}\n`;
+    out += `\n`;
+    out += `import sys\n`;
+    out += `import time\n`;
+    out += `import resource\n`;
+    out += `import ${module}\n`;
+    out += `\n`;
+    out += `def option(name, value):\n`;
+    out += `    return int(sys.argv[sys.argv.index(name) + 1]) if name in sys.argv else value\n`;
+    out += `\n`;
+    out += `warmup = option("--warmup", 200)\n`;
+    out += `cycles = option("--cycles", 2000)\n`;
+    out += `\n`;
+    out += `class Handler(${module}.${template.datamodel.structName}EventHandler):\n`;
+    out += `    def __init__(self):\n`;
+    out += `        ${module}.${template.datamodel.structName}EventHandler.__init__(self)\n`;
+    out += `        self.measuring = False\n`;
+    out += `        self.updates = 0\n`;
+    out += `\n`;
+    out += `    def update(self):\n`;
+    out += `        if self.measuring:\n`;
+    out += `            self.updates += 1\n`;
+    out += `\n`;
+    for (let dataset of subscribed) {
+        out += `    def on_change_${dataset.structName}(self):\n`;
+        out += `        self.update()\n`;
+        out += `\n`;
+    }
+    out += `${handle} = ${module}.${module}_init()\n`;
+    out += `handler = Handler()\n`;
+    out += `${module}.add_event_handler(${handle}, handler)\n`;
+    out += `${handle}.connect()\n`;
+    out += `\n`;
+    out += `publishes = 0\n`;
+    out += `publish_ns = 0\n`;
+    out += `for cycle in range(warmup + cycles):\n`;
+    out += `    if cycle == warmup:\n`;
+    out += `        handler.measuring = True\n`;
+    out += `        cpu = time.process_time_ns()\n`;
+    out += `        wall = time.monotonic_ns()\n`;
+    out += `    ${handle}.process()\n`;
+    out += `\n`;
+    out += `    start = time.monotonic_ns()\n`;
+    for (let dataset of published) {
+        out += `    ${handle}.${dataset.structName}.publish()\n`;
+    }
+    out += `    if handler.measuring:\n`;
+    out += `        publish_ns += time.monotonic_ns() - start\n`;
+    out += `        publishes += ${published.length}\n`;
+    out += `\n`;
+    out += `cpu = time.process_time_ns() - cpu\n`;
+    out += `wall = time.monotonic_ns() - wall\n`;
+    out += `${handle}.disconnect()\n`;
+    out += `${handle}.dispose()\n`;
+    out += `print(f"bench: updates {handler.updates} publishes {publishes} publish_ns {publish_ns} cpu_ns {cpu} wall_ns {wall} maxrss_kb {resource.getrusage(resource.RUSAGE_SELF).ru_maxrss}", flush=True)\n`;
+
+    return out;
+}
+
+module.exports = {rawSource, staticCSource, cppSource, napiSource, pythonSource};
@@ -0,0 +1,192 @@
+/* Null exOS API for the microbenchmarks of microbench.js, implementing stub/exos_api.h without a DMR
+
+   Every call succeeds without doing anything beyond the state changes the generated sources rely on:
+   connect() makes a datamodel connected and a dataset operational, publish() and process() return
+   immediately, the nettime is always 0 and the logger discards everything. Nothing is ever received,
+   the microbenchmarks raise the dataset events themselves on the handles found with exos_null_dataset(),
+   so only the generated glue is measured. */
+
+#include <stdio.h>
+#include <string.h>
+#include "exos_api.h"
+#include "exos_log.h"
+#include "exos_null.h"
+
+#define EXOS_NULL_MAX_DATASETS 256
+
+static exos_dataset_handle_t *datasets[EXOS_NULL_MAX_DATASETS];
+static size_t dataset_count = 0;
+
+exos_dataset_handle_t *exos_null_dataset(const char *name)
+{
+    for (size_t i = dataset_count; i > 0; i--)
+    {
+        if (0 == strcmp(datasets[i - 1]->name, name))
+            return datasets[i - 1];
+    }
+    return NULL;
+}
+
+const char *exos_get_error_string(EXOS_ERROR_CODE error)
+{
+    return EXOS_ERROR_OK == error ? "EXOS_ERROR_OK" : "EXOS_ERROR";
+}
+
+const char *exos_get_state_string(EXOS_CONNECTION_STATE state)
+{
+    switch (state)
+    {
+    case EXOS_STATE_DISCONNECTED:
+        return "EXOS_STATE_DISCONNECTED";
+    case EXOS_STATE_CONNECTED:
+        return "EXOS_STATE_CONNECTED";
+    case EXOS_STATE_OPERATIONAL:
+        return "EXOS_STATE_OPERATIONAL";
+    default:
+        return "EXOS_STATE_ABORTED";
+    }
+}
+
+EXOS_ERROR_CODE exos_datamodel_init(exos_datamodel_handle_t *datamodel, const char *datamodel_instance_name, const char *user_alias)
+{
+    memset(datamodel, 0, sizeof(*datamodel));
+    datamodel->name = (char *)datamodel_instance_name;
+    datamodel->user_alias = (char *)user_alias;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_connect(exos_datamodel_handle_t *datamodel, const char *config, const exos_dataset_info_t *info, size_t info_size, exos_datamodel_event_cb datamodel_event_callback)
+{
+    datamodel->datamodel_event_callback = datamodel_event_callback;
+    datamodel->connection_state = EXOS_STATE_CONNECTED;
+    datamodel->sync_info.in_sync = true;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_set_operational(exos_datamodel_handle_t *datamodel)
+{
+    datamodel->connection_state = EXOS_STATE_OPERATIONAL;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_set_process_mode(exos_datamodel_handle_t *datamodel, EXOS_DATAMODEL_PROCESS_MODE mode)
+{
+    datamodel->sync_info.process_mode = mode;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_disconnect(exos_datamodel_handle_t *datamodel)
+{
+    datamodel->connection_state = EXOS_STATE_DISCONNECTED;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_delete(exos_datamodel_handle_t *datamodel)
+{
+    size_t i = 0;
+
+    while (i < dataset_count)
+    {
+        if (datasets[i]->datamodel == datamodel)
+            datasets[i] = datasets[--dataset_count];
+        else
+            i++;
+    }
+    datamodel->connection_state = EXOS_STATE_DISCONNECTED;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_process(exos_datamodel_handle_t *datamodel)
+{
+    return EXOS_ERROR_OK;
+}
+
+int32_t exos_datamodel_get_nettime(exos_datamodel_handle_t *datamodel)
+{
+    return 0;
+}
+
+void exos_datamodel_calc_dataset_info(exos_dataset_info_t *info, size_t info_size)
+{
+}
+
+EXOS_ERROR_CODE exos_dataset_init(exos_dataset_handle_t *dataset, exos_datamodel_handle_t *datamodel, const char *browse_name, const void *data, size_t size)
+{
+    memset(dataset, 0, sizeof(*dataset));
+    dataset->name = browse_name;
+    dataset->datamodel = datamodel;
+    dataset->data = (void *)data;
+    dataset->size = size;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_dataset_connect(exos_dataset_handle_t *dataset, EXOS_DATASET_TYPE type, exos_dataset_event_cb dataset_event_callback)
+{
+    if (dataset_count == EXOS_NULL_MAX_DATASETS)
+        return EXOS_ERROR_BUFFER_OVERFLOW;
+
+    datasets[dataset_count++] = dataset;
+    dataset->type = type;
+    dataset->dataset_event_callback = dataset_event_callback;
+    dataset->connection_state = EXOS_STATE_OPERATIONAL;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_dataset_publish(exos_dataset_handle_t *dataset)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_dataset_delete(exos_dataset_handle_t *dataset)
+{
+    for (size_t i = 0; i < dataset_count; i++)
+    {
+        if (datasets[i] == dataset)
+        {
+            datasets[i] = datasets[--dataset_count];
+            break;
+        }
+    }
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_init(exos_log_handle_t *log, const char *name)
+{
+    snprintf(log->name, sizeof(log->name), "%s", name);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_process(exos_log_handle_t *log)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_delete(exos_log_handle_t *log)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_error(const exos_log_handle_t *log, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_warning(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_success(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_info(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_debug(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
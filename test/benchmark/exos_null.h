@@ -0,0 +1,18 @@
+/* Null exOS API of the microbenchmarks, see exos_null.c */
+
+#ifndef _EXOS_NULL_H_
+#define _EXOS_NULL_H_
+
+#include "exos_api.h"
+
+/* the last connected dataset with the browse name, NULL if there is none */
+exos_dataset_handle_t *exos_null_dataset(const char *name);
+
+/* raises EXOS_DATASET_EVENT_UPDATED on the dataset, as the DMR does on receiving a new value */
+static inline void exos_null_updated(void *dataset)
+{
+    exos_dataset_handle_t *handle = (exos_dataset_handle_t *)dataset;
+    handle->dataset_event_callback(handle, EXOS_DATASET_EVENT_UPDATED, NULL);
+}
+
+#endif // _EXOS_NULL_H_
@@ -0,0 +1,118 @@
+/* Measurement of the microbenchmarks generated by microbench.js, in C and C++
+
+   microbench_fill() writes synthetic values into a dataset, described by the runs of its leaf members:
+   every run is a scalar, enum or STRING member with `count` elements (1 if it is not an array) at
+   `offset`, `stride` bytes apart. The value of element i of run r is v = (r + i) % 100 + 1, written as
+   BOOL v & 1, integer v, REAL v + 0.5, LREAL v + 0.25, enum 0 or STRING of stride - 1 letters 'a' + v % 26,
+   the same values as the synthetic JavaScript values of microbench.js.
+
+   microbench_measure() calls an operation once to warm up, then doubles the number of calls until they
+   take at least the minimum time (--min-time in ms, default 50). microbench_report() prints the line parsed
+   by microbench.js:
+
+       micro: <path> <dataset> <iterations> <ns> */
+
+#ifndef _MICROBENCH_H_
+#define _MICROBENCH_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct
+{
+    uint32_t offset;
+    uint32_t count;
+    uint32_t stride;
+    char kind; /* b(ool), i(nteger), f(loat), d(ouble), e(num), s(tring) */
+} microbench_run_t;
+
+typedef void (*microbench_op_t)(void *context);
+
+static inline uint64_t microbench_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t microbench_min_ns(int argc, char **argv)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (0 == strcmp(argv[i], "--min-time"))
+            return strtoull(argv[i + 1], NULL, 10) * 1000000ULL;
+    }
+    return 50000000ULL;
+}
+
+static inline void microbench_fill(void *data, const microbench_run_t *runs, size_t run_count)
+{
+    for (size_t r = 0; r < run_count; r++)
+    {
+        for (uint32_t i = 0; i < runs[r].count; i++)
+        {
+            uint8_t *element = (uint8_t *)data + runs[r].offset + (size_t)i * runs[r].stride;
+            uint32_t v = (uint32_t)((r + i) % 100 + 1);
+
+            switch (runs[r].kind)
+            {
+            case 'b':
+                *element = (uint8_t)(v & 1);
+                break;
+            case 'i':
+                if (1 == runs[r].stride)
+                    *element = (uint8_t)v;
+                else if (2 == runs[r].stride)
+                    *(uint16_t *)element = (uint16_t)v;
+                else
+                    *(uint32_t *)element = v;
+                break;
+            case 'f':
+                *(float *)element = (float)v + 0.5f;
+                break;
+            case 'd':
+                *(double *)element = (double)v + 0.25;
+                break;
+            case 'e':
+                *(int32_t *)element = 0;
+                break;
+            case 's':
+                memset(element, 'a' + v % 26, runs[r].stride - 1);
+                element[runs[r].stride - 1] = '\0';
+                break;
+            }
+        }
+    }
+}
+
+/* returns the time in ns of the measured calls, their number in *iterations */
+static inline uint64_t microbench_measure(microbench_op_t op, void *context, uint64_t min_ns, uint64_t *iterations)
+{
+    uint64_t n = 1;
+    uint64_t ns;
+
+    op(context);
+    for (;;)
+    {
+        uint64_t start = microbench_ns();
+        for (uint64_t i = 0; i < n; i++)
+            op(context);
+        ns = microbench_ns() - start;
+        if (ns >= min_ns)
+            break;
+        n *= 2;
+    }
+    *iterations = n;
+    return ns;
+}
+
+static inline void microbench_report(const char *path, const char *dataset, uint64_t iterations, uint64_t ns)
+{
+    printf("micro: %s %s %llu %llu\n", path, dataset, (unsigned long long)iterations, (unsigned long long)ns);
+    fflush(stdout);
+}
+
+#endif // _MICROBENCH_H_
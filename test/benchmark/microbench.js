@@ -0,0 +1,658 @@
+/*
+ * Microbenchmarks of the generated glue of the Linux bindings, in isolation and without a DMR:
+ *
+ *    node test/benchmark/microbench.js [--models a,b] [--bindings a,b] [--min-time 50] [--mhz 3000] [--keep]
+ *
+ * For every model the Linux template of every binding is generated and built with a microbenchmark in place of
+ * its generated main, against the null exOS API of exos_null.c (connect succeeds, publish and process return at
+ * once, nothing is received). The measured paths get synthetic values of every dataset (see microbench.h):
+ *
+ *    c-static  dispatch   the UPDATED event of a subscribed dataset, through the generated dataset event handler
+ *                         to its on_change callback
+ *    cpp       update     the UPDATED event of a subscribed Dataset<T>, through datasetEvent() to its onChange lambda
+ *    napi      onchange   the `*_onchange_js_cb` conversion of a subscribed dataset into its JavaScript value,
+ *                         including the copy of the callback context, called directly with an empty callback
+ *    napi      publish    the `*_publish_method` parsing of the JavaScript value of a published dataset, called from JavaScript
+ *    swig      accessors  reading every member of a dataset value in Python through the generated SWIG accessors,
+ *                         array members once without indexing their elements
+ *
+ * Every path is called until it took at least --min-time ms and reported per call, in cycles per call, per byte
+ * of the dataset and per leaf member of the dataset (array elements counted each). The cycles are derived from
+ * the time with the clock rate in /proc/cpuinfo, or --mhz. The glue around the path is measured in full, the
+ * logging calls included, so a path costing more than its bytes justify points to the generated code.
+ * A binding whose toolchain is missing (node headers for napi, swig and the Python headers for swig) is skipped.
+ */
+
+const path = require('path');
+const fs = require('fs');
+const os = require('os');
+const child_process = require('child_process');
+const { Datamodel } = require('../../src/datamodel');
+const { Template } = require('../../src/components/templates/template');
+const { TemplateLinuxStaticCLib } = require('../../src/components/templates/linux/template_linux_static_c_lib');
+const { TemplateLinuxCpp } = require('../../src/components/templates/linux/template_linux_cpp');
+const { TemplateLinuxNAPI } = require('../../src/components/templates/linux/template_linux_napi');
+const { TemplateLinuxSWIG } = require('../../src/components/templates/linux/template_linux_swig');
+const { generatedFiles, compile } = require('../suite/ar_host/ar_host');
+const { models } = require('./benchmark');
+
+const exosNull = path.join(__dirname, 'exos_null.c');
+const bindings = ["c-static", "cpp", "napi", "swig"];
+
+/**
+ * @typedef {import('../../src/components/templates/template').ApplicationTemplate} ApplicationTemplate
+ * @typedef {import('../../src/datamodel').LayoutAnalysis} LayoutAnalysis
+ *
+ * @typedef {Object} SyntheticDataset
+ * @property {string} name dataset name
+ * @property {boolean} isPub published by Linux
+ * @property {boolean} isSub subscribed by Linux
+ * @property {number} bytes size of the dataset
+ * @property {number} members leaf members of the dataset, array elements counted each
+ * @property {{offset: number, count: number, stride: number, kind: string}[]} runs leaf members as filled by microbench_fill()
+ * @property {*} value synthetic JavaScript value, equal to the one written by microbench_fill()
+ * @property {string[]} accessors member paths of the value, e.g. `.Ack.Id`, arrays not indexed (`""` for the value itself)
+ */
+
+/**
+ * @param {string} dataType IEC type or enum
+ * @returns {string} kind of the run, see microbench.h
+ */
+function scalarKind(dataType) {
+    switch (dataType) {
+        case "BOOL": return "b";
+        case "USINT":
+        case "SINT":
+        case "BYTE":
+        case "UINT":
+        case "INT":
+        case "UDINT":
+        case "DINT": return "i";
+        case "REAL": return "f";
+        case "LREAL": return "d";
+        case "STRING": return "s";
+        default: return "e";
+    }
+}
+
+/**
+ * The synthetic values of the visible PUB / SUB datasets, derived from the GPOS layout of the datamodel
+ *
+ * @param {ApplicationTemplate} template for Linux
+ * @param {LayoutAnalysis} layout
+ * @returns {SyntheticDataset[]}
+ */
+function syntheticDatasets(template, layout) {
+    let result = [];
+
+    for (let dataset of template.datasets.filter(dataset => !dataset.isPrivate && (dataset.isSub || dataset.isPub))) {
+        let runs = [];
+        let accessors = [];
+
+        let element = (kind, r, i, stringLength) => {
+            let v = (r + i) % 100 + 1;
+            switch (kind) {
+                case "b": return (v & 1) == 1;
+                case "i": return v;
+                case "f": return v + 0.5;
+                case "d": return v + 0.25;
+                case "s": return String.fromCharCode(97 + v % 26).repeat(stringLength - 1);
+                default: return 0;
+            }
+        };
+        let build = (dataType, arraySize, stringLength, offset, accessor) => {
+            let count = Math.max(arraySize, 1);
+            let type = layout.types.find(type => type.dataType == dataType);
+            let values = [];
+            if (type !== undefined) {
+                for (let e = 0; e < count; e++) {
+                    let object = {};
+                    for (let member of type.members) {
+                        object[member.name] = build(member.dataType, member.arraySize, member.stringLength, offset + e * type.size + member.offset,
+                            arraySize == 0 && accessor !== undefined ? `${accessor}.${member.name}` : undefined);
+                    }
+                    values.push(object);
+                }
+                if (arraySize > 0 && accessor !== undefined) {
+                    accessors.push(accessor);
+                }
+            }
+            else {
+                let kind = scalarKind(dataType);
+                let stride = kind == "s" ? stringLength : Datamodel.getScalarLayout(dataType, Datamodel.LAYOUT_PLATFORMS.GPOS).size;
+                let r = runs.length;
+                runs.push({offset: offset, count: count, stride: stride, kind: kind});
+                for (let i = 0; i < count; i++) {
+                    values.push(element(kind, r, i, stringLength));
+                }
+                if (accessor !== undefined) {
+                    accessors.push(accessor);
+                }
+            }
+            return arraySize > 0 ? values : values[0];
+        };
+
+        let value = build(dataset.dataType, dataset.arraySize || 0, dataset.stringLength || 0, 0, "");
+        result.push({
+            name: dataset.structName,
+            isPub: dataset.isPub,
+            isSub: dataset.isSub,
+            bytes: layout.datasets.find(item => item.name == dataset.structName).size,
+            members: runs.reduce((sum, run) => sum + run.count, 0),
+            runs: runs,
+            value: value,
+            accessors: accessors
+        });
+    }
+    return result;
+}
+
+/**
+ * @param {SyntheticDataset} dataset
+ * @returns {string} C definition of `runs_<dataset>` for microbench_fill()
+ */
+function runsSource(dataset) {
+    let out = "";
+
+    out += `static const microbench_run_t runs_${dataset.name}[] = {\n`;
+    for (let run of dataset.runs) {
+        out += `    {${run.offset}, ${run.count}, ${run.stride}, '${run.kind}'},\n`;
+    }
+    out += `};\n`;
+
+    return out;
+}
+
+/**
+ * @param {ApplicationTemplate} template for Linux
+ * @param {SyntheticDataset[]} datasets
+ * @returns {string} C source of the `c-static` microbenchmark
+ */
+function staticCSource(template, datasets) {
+    let handle = template.datamodel.varName;
+    let out = "";
+
+    out += `/* Generated by microbench.js: c-static microbenchmarks of ${template.datamodel.structName} */\n`;
+    out += `\n`;
+    out += `#include "${template.libHeaderName}"\n`;
+    out += `#include "exos_null.h"\n`;
+    out += `#include "microbench.h"\n`;
+    out += `\n`;
+    for (let dataset of datasets.filter(dataset => dataset.isSub)) {
+        out += runsSource(dataset);
+    }
+    out += `\n`;
+    out += `static uint64_t changes = 0;\n`;
+    out += `\n`;
+    out += `static void on_change(void)\n`;
+    out += `{\n`;
+    out += `    changes++;\n`;
+    out += `}\n`;
+    out += `\n`;
+    out += `int main(int argc, char **argv)\n`;
+    out += `{\n`;
+    out += `    ${template.datamodel.libStructName}_t *${handle} = ${template.datamodel.libStructName}_init();\n`;
+    out += `    uint64_t min_ns = microbench_min_ns(argc, argv);\n`;
+    out += `    exos_dataset_handle_t *dataset;\n`;
+    out += `    uint64_t iterations, ns;\n`;
+    out += `\n`;
+    for (let dataset of datasets.filter(dataset => dataset.isSub)) {
+        out += `    ${handle}->${dataset.name}.on_change = on_change;\n`;
+    }
+    out += `    ${handle}->connect();\n`;
+    for (let dataset of datasets.filter(dataset => dataset.isSub)) {
+        out += `\n`;
+        out += `    dataset = exos_null_dataset("${dataset.name}");\n`;
+        out += `    microbench_fill(dataset->data, runs_${dataset.name}, sizeof(runs_${dataset.name}) / sizeof(runs_${dataset.name}[0]));\n`;
+        out += `    ns = microbench_measure(exos_null_updated, dataset, min_ns, &iterations);\n`;
+        out += `    microbench_report("dispatch", "${dataset.name}", iterations, ns);\n`;
+    }
+    out += `\n`;
+    out += `    ${handle}->disconnect();\n`;
+    out += `    ${handle}->dispose();\n`;
+    out += `    return 0 == changes;\n`;
+    out += `}\n`;
+
+    return out;
+}
+
+/**
+ * @param {ApplicationTemplate} template for Linux
+ * @param {SyntheticDataset[]} datasets
+ * @returns {string} C++ source of the `cpp` microbenchmark
+ */
+function cppSource(template, datasets) {
+    let handle = template.datamodel.varName;
+    let out = "";
+
+    out += `/* Generated by microbench.js: cpp microbenchmarks of ${template.datamodel.structName} */\n`;
+    out += `\n`;
+    out += `#include "${template.datamodel.structName}Datamodel.hpp"\n`;
+    out += `extern "C" {\n`;
+    out += `    #include "exos_null.h"\n`;
+    out += `}\n`;
+    out += `#include "microbench.h"\n`;
+    out += `\n`;
+    for (let dataset of datasets.filter(dataset => dataset.isSub)) {
+        out += runsSource(dataset);
+    }
+    out += `\n`;
+    out += `int main(int argc, char **argv)\n`;
+    out += `{\n`;
+    out += `    uint64_t min_ns = microbench_min_ns(argc, argv);\n`;
+    out += `    uint64_t changes = 0;\n`;
+    out += `    exos_dataset_handle_t *dataset;\n`;
+    out += `    uint64_t iterations, ns;\n`;
+    out += `    {\n`;
+    out += `        ${template.datamodel.structName}Datamodel ${handle};\n`;
+    out += `        ${handle}.connect();\n`;
+    for (let dataset of datasets.filter(dataset => dataset.isSub)) {
+        out += `        ${handle}.${dataset.name}.onChange([&] () {changes++;});\n`;
+    }
+    for (let dataset of datasets.filter(dataset => dataset.isSub)) {
+        out += `\n`;
+        out += `        dataset = exos_null_dataset("${dataset.name}");\n`;
+        out += `        microbench_fill(dataset->data, runs_${dataset.name}, sizeof(runs_${dataset.name}) / sizeof(runs_${dataset.name}[0]));\n`;
+        out += `        ns = microbench_measure(exos_null_updated, dataset, min_ns, &iterations);\n`;
+        out += `        microbench_report("update", "${dataset.name}", iterations, ns);\n`;
+    }
+    out += `    }\n`;
+    out += `    return 0 == changes;\n`;
+    out += `}\n`;
+
+    return out;
+}
+
+/**
+ * The microbenchmark addon includes the generated library source, so that it reaches its static functions, and
+ * registers itself in place of the generated module: it initializes the generated module and adds `microbench.onChange()`.
+ *
+ * @param {ApplicationTemplate} template for Linux
+ * @param {SyntheticDataset[]} datasets
+ * @param {string} librarySource name of the generated library source
+ * @returns {string} C source of the `napi` microbenchmark addon
+ */
+function napiAddonSource(template, datasets, librarySource) {
+    let subscribed = datasets.filter(dataset => dataset.isSub);
+    let out = "";
+
+    out += `/* Generated by microbench.js: napi microbenchmark addon of ${template.datamodel.structName} */\n`;
+    out += `\n`;
+    out += `#define NAPI_VERSION 6\n`;
+    out += `#include <node_api.h>\n`;
+    out += `\n`;
+    out += `// the generated module is initialized by the microbenchmark module\n`;
+    out += `#undef NAPI_MODULE\n`;
+    out += `#define NAPI_MODULE(modname, regfunc) static napi_value (*const microbench_init_module)(napi_env, napi_value) = regfunc;\n`;
+    out += `#include "${librarySource}"\n`;
+    out += `#include "exos_null.h"\n`;
+    out += `#include "microbench.h"\n`;
+    out += `\n`;
+    for (let dataset of subscribed) {
+        out += runsSource(dataset);
+    }
+    out += `\n`;
+    out += `typedef struct\n`;
+    out += `{\n`;
+    out += `    napi_env env;\n`;
+    out += `    napi_value js_cb;\n`;
+    out += `    exos_dataset_handle_t *dataset;\n`;
+    out += `    napi_threadsafe_function_call_js onchange_js_cb;\n`;
+    out += `} microbench_onchange_t;\n`;
+    out += `\n`;
+    out += `static void microbench_onchange(void *context)\n`;
+    out += `{\n`;
+    out += `    microbench_onchange_t *onchange = (microbench_onchange_t *)context;\n`;
+    out += `    napi_handle_scope scope;\n`;
+    out += `\n`;
+    out += `    napi_open_handle_scope(onchange->env, &scope);\n`;
+    out += `    onchange->onchange_js_cb(onchange->env, onchange->js_cb, NULL, create_callback_context(onchange->dataset));\n`;
+    out += `    napi_close_handle_scope(onchange->env, scope);\n`;
+    out += `}\n`;
+    out += `\n`;
+    out += `// onChange(dataset, callback, minTime) returns [iterations, ns] of the onchange conversion of the dataset\n`;
+    out += `static napi_value microbench_onchange_method(napi_env env, napi_callback_info info)\n`;
+    out += `{\n`;
+    out += `    size_t argc = 3;\n`;
+    out += `    napi_value argv[3], result, number;\n`;
+    out += `    char name[256] = "";\n`;
+    out += `    uint32_t min_ms = 0;\n`;
+    out += `    uint64_t iterations, ns;\n`;
+    out += `    microbench_onchange_t onchange = {env, NULL, NULL, NULL};\n`;
+    out += `\n`;
+    out += `    napi_get_cb_info(env, info, &argc, argv, NULL, NULL);\n`;
+    out += `    if (argc < 3 || napi_ok != napi_get_value_string_utf8(env, argv[0], name, sizeof(name), NULL) || napi_ok != napi_get_value_uint32(env, argv[2], &min_ms))\n`;
+    out += `    {\n`;
+    out += `        napi_throw_error(env, "EINVAL", "Expected dataset name, callback and minimum time");\n`;
+    out += `        return NULL;\n`;
+    out += `    }\n`;
+    out += `    onchange.js_cb = argv[1];\n`;
+    subscribed.forEach((dataset, i) => {
+        out += `    ${i == 0 ? "if" : "else if"} (0 == strcmp(name, "${dataset.name}"))\n`;
+        out += `    {\n`;
+        out += `        onchange.dataset = &${dataset.name}_dataset;\n`;
+        out += `        onchange.onchange_js_cb = ${dataset.name}_onchange_js_cb;\n`;
+        out += `        microbench_fill(${dataset.name}_dataset.data, runs_${dataset.name}, sizeof(runs_${dataset.name}) / sizeof(runs_${dataset.name}[0]));\n`;
+        out += `    }\n`;
+    });
+    out += `    if (NULL == onchange.dataset)\n`;
+    out += `    {\n`;
+    out += `        napi_throw_error(env, "EINVAL", "No subscribed dataset with this name");\n`;
+    out += `        return NULL;\n`;
+    out += `    }\n`;
+    out += `\n`;
+    out += `    ns = microbench_measure(microbench_onchange, &onchange, (uint64_t)min_ms * 1000000ULL, &iterations);\n`;
+    out += `    napi_create_array(env, &result);\n`;
+    out += `    napi_create_double(env, (double)iterations, &number);\n`;
+    out += `    napi_set_element(env, result, 0, number);\n`;
+    out += `    napi_create_double(env, (double)ns, &number);\n`;
+    out += `    napi_set_element(env, result, 1, number);\n`;
+    out += `    return result;\n`;
+    out += `}\n`;
+    out += `\n`;
+    out += `NAPI_MODULE_INIT()\n`;
+    out += `{\n`;
+    out += `    napi_value microbench, onchange;\n`;
+    out += `\n`;
+    out += `    exports = microbench_init_module(env, exports);\n`;
+    out += `    napi_create_object(env, &microbench);\n`;
+    out += `    napi_create_function(env, NULL, 0, microbench_onchange_method, NULL, &onchange);\n`;
+    out += `    napi_set_named_property(env, microbench, "onChange", onchange);\n`;
+    out += `    napi_set_named_property(env, exports, "microbench", microbench);\n`;
+    out += `    return exports;\n`;
+    out += `}\n`;
+
+    return out;
+}
+
+/**
+ * @param {ApplicationTemplate} template for Linux
+ * @param {SyntheticDataset[]} datasets
+ * @returns {string} JavaScript source of the `napi` microbenchmark, loading `l_<Type>.node` from its directory
+ */
+function napiSource(template, datasets) {
+    let handle = template.datamodel.varName;
+    let out = "";
+
+    out += `// Generated by microbench.js: napi microbenchmarks of ${template.datamodel.structName}\n`;
+    out += `\n`;
+    out += `let addon = require('./l_${template.datamodel.structName}.node');\n`;
+    out += `let ${handle} = addon.${template.datamodel.structName};\n`;
+    out += `let minTime = process.argv.includes("--min-time") ? parseInt(process.argv[process.argv.indexOf("--min-time") + 1]) : 50;\n`;
+    out += `let changes = 0;\n`;
+    out += `let onChange = () => {changes++;};\n`;
+    out += `let report = (path, dataset, [iterations, ns]) => console.log(\`micro: \${path} \${dataset} \${iterations} \${ns}\`);\n`;
+    out += `let measure = (op) => {\n`;
+    out += `    let n = 1, ns;\n`;
+    out += `    op();\n`;
+    out += `    for (;;) {\n`;
+    out += `        let start = process.hrtime.bigint();\n`;
+    out += `        for (let i = 0; i < n; i++) {\n`;
+    out += `            op();\n`;
+    out += `        }\n`;
+    out += `        ns = Number(process.hrtime.bigint() - start);\n`;
+    out += `        if (ns >= minTime * 1e6) {\n`;
+    out += `            return [n, ns];\n`;
+    out += `        }\n`;
+    out += `        n *= 2;\n`;
+    out += `    }\n`;
+    out += `};\n`;
+    out += `\n`;
+    out += `// the N-API wrapper expects every callback to be set\n`;
+    out += `${handle}.onConnectionChange(() => {});\n`;
+    out += `${handle}.onSyncChange(() => {});\n`;
+    out += `${handle}.onProcessed(() => {});\n`;
+    for (let dataset of datasets) {
+        out += `${handle}.datamodel.${dataset.name}.onConnectionChange(() => {});\n`;
+    }
+    for (let dataset of datasets.filter(dataset => dataset.isSub)) {
+        out += `${handle}.datamodel.${dataset.name}.onChange(onChange);\n`;
+    }
+    out += `\n`;
+    for (let dataset of datasets.filter(dataset => dataset.isSub)) {
+        out += `report("onchange", "${dataset.name}", addon.microbench.onChange("${dataset.name}", onChange, minTime));\n`;
+    }
+    for (let dataset of datasets.filter(dataset => dataset.isPub)) {
+        out += `${handle}.datamodel.${dataset.name}.value = ${JSON.stringify(dataset.value)};\n`;
+        out += `report("publish", "${dataset.name}", measure(() => ${handle}.datamodel.${dataset.name}.publish()));\n`;
+    }
+    out += `\n`;
+    out += `// the generated module keeps the event loop running\n`;
+    out += `process.exit(0);\n`;
+
+    return out;
+}
+
+/**
+ * @param {ApplicationTemplate} template for Linux
+ * @param {SyntheticDataset[]} datasets
+ * @returns {string} Python source of the `swig` microbenchmark, importing `lib<Type>` from its directory
+ */
+function pythonSource(template, datasets) {
+    let handle = template.datamodel.varName;
+    let module = template.datamodel.libStructName;
+    let out = "";
+
+    out += `# Generated by microbench.js: swig/python microbenchmarks of ${template.datamodel.structName}\n`;
+    out += `\n`;
+    out += `import sys\n`;
+    out += `import time\n`;
+    out += `import ${module}\n`;
+    out += `\n`;
+    out += `min_ns = (int(sys.argv[sys.argv.index("--min-time") + 1]) if "--min-time" in sys.argv else 50) * 1000000\n`;
+    out += `\n`;
+    out += `def measure(dataset, op):\n`;
+    out += `    n = 1\n`;
+    out += `    op()\n`;
+    out += `    while True:\n`;
+    out += `        start = time.monotonic_ns()\n`;
+    out += `        for i in range(n):\n`;
+    out += `            op()\n`;
+    out += `        ns = time.monotonic_ns() - start\n`;
+    out += `        if ns >= min_ns:\n`;
+    out += `            break\n`;
+    out += `        n *= 2\n`;
+    out += `    print(f"micro: accessors {dataset} {n} {ns}", flush=True)\n`;
+    out += `\n`;
+    out += `${handle} = ${module}.${module}_init()\n`;
+    out += `${handle}.connect()\n`;
+    for (let dataset of datasets) {
+        out += `\n`;
+        out += `def read_${dataset.name}():\n`;
+        out += `    value = ${handle}.${dataset.name}.value\n`;
+        for (let accessor of dataset.accessors.filter(accessor => accessor != "")) {
+            out += `    value${accessor}\n`;
+        }
+        out += `\n`;
+        out += `measure("${dataset.name}", read_${dataset.name})\n`;
+    }
+    out += `\n`;
+    out += `${handle}.disconnect()\n`;
+    out += `${handle}.dispose()\n`;
+
+    return out;
+}
+
+/**
+ * @param {string} command
+ * @param {string[]} args
+ * @returns {boolean} the command can be run
+ */
+function hasCommand(command, args) {
+    return child_process.spawnSync(command, args, {encoding: "utf8"}).status === 0;
+}
+
+/**
+ * Builds the microbenchmark of the binding for the model in `buildPath`
+ *
+ * @param {{typFile: string, typeName: string}} model
+ * @param {string} binding
+ * @param {string} buildPath existing directory
+ * @returns {{command: string, args: string[], datasets: SyntheticDataset[]}|{skipped: string}}
+ */
+function buildMicrobench(model, binding, buildPath) {
+    let datamodel = new Datamodel(model.typFile, model.typeName, [model.typeName]);
+    let linux = new Template(datamodel, true).template;
+    let datasets = syntheticDatasets(linux, datamodel.analyzeLayout(Datamodel.LAYOUT_PLATFORMS.GPOS));
+    let flags = [`-I${__dirname}`];
+    let files, template;
+
+    switch (binding) {
+        case "c-static":
+        case "cpp": {
+            let LinuxTemplate = binding == "cpp" ? TemplateLinuxCpp : TemplateLinuxStaticCLib;
+            template = new LinuxTemplate(datamodel);
+            files = [...generatedFiles(datamodel), ...generatedFiles(template).filter(file => file !== template.mainSource)];
+            files.push(binding == "cpp" ? {name: "microbench.cpp", contents: cppSource(linux, datasets)} : {name: "microbench.c", contents: staticCSource(linux, datasets)});
+            let executable = path.join(buildPath, "microbench");
+            compile(files, buildPath, [exosNull], executable, undefined, [], flags);
+            return {command: executable, args: [], datasets: datasets};
+        }
+        case "napi": {
+            let nodeInclude = path.resolve(path.dirname(process.execPath), "../include/node");
+            if (!fs.existsSync(path.join(nodeInclude, "node_api.h"))) {
+                return {skipped: `no node_api.h in ${nodeInclude}`};
+            }
+            template = new TemplateLinuxNAPI(datamodel);
+            // the library source is included by the addon rather than compiled on its own
+            fs.writeFileSync(path.join(buildPath, template.librarySource.name), template.librarySource.contents);
+            files = [...generatedFiles(datamodel), {name: "microbench_addon.c", contents: napiAddonSource(linux, datasets, template.librarySource.name)}];
+            files.push({name: "microbench.js", contents: napiSource(linux, datasets)});
+            let addon = `l_${model.typeName}`;
+            compile(files, buildPath, [exosNull], path.join(buildPath, `${addon}.node`), undefined, [`NODE_GYP_MODULE_NAME=${addon}`],
+                [...flags, "-fPIC", "-shared", `-I${nodeInclude}`]);
+            return {command: process.execPath, args: [path.join(buildPath, "microbench.js")], datasets: datasets};
+        }
+        case "swig": {
+            if (!hasCommand("swig", ["-version"])) {
+                return {skipped: "swig not found"};
+            }
+            let includes = child_process.spawnSync("python3-config", ["--includes"], {encoding: "utf8"});
+            if (includes.status !== 0) {
+                return {skipped: "python3-config not found"};
+            }
+            template = new TemplateLinuxSWIG(datamodel);
+            files = [...generatedFiles(datamodel), ...generatedFiles(template).filter(file => file !== template.mainSource && file !== template.pythonMain)];
+            for (let file of files) {
+                fs.writeFileSync(path.join(buildPath, file.name), file.contents);
+            }
+            let wrapper = path.join(buildPath, `${template.swigInclude.name.replace(".i", "")}_wrap.cpp`);
+            let swig = child_process.spawnSync("swig", ["-c++", "-python", "-outdir", buildPath, "-o", wrapper, path.join(buildPath, template.swigInclude.name)], {encoding: "utf8"});
+            if (swig.status !== 0) {
+                throw new Error(`swig failed:\n${swig.stderr}`);
+            }
+            files.push({name: "microbench.py", contents: pythonSource(linux, datasets)});
+            compile(files, buildPath, [wrapper, exosNull], path.join(buildPath, `_${linux.datamodel.libStructName}.so`), undefined, [],
+                [...flags, "-fPIC", "-shared", ...includes.stdout.trim().split(/\s+/)]);
+            return {command: "python3", args: [path.join(buildPath, "microbench.py")], datasets: datasets};
+        }
+        default:
+            throw new Error(`unknown binding ${binding}`);
+    }
+}
+
+/**
+ * @returns {number} clock rate in MHz of the first CPU in /proc/cpuinfo, 0 if unknown
+ */
+function cpuMHz() {
+    let cpuinfo = fs.existsSync("/proc/cpuinfo") ? fs.readFileSync("/proc/cpuinfo", "utf8").match(/^cpu MHz\s*:\s*([\d.]+)/m) : null;
+    return cpuinfo !== null ? parseFloat(cpuinfo[1]) : os.cpus()[0].speed;
+}
+
+/**
+ * Runs the microbenchmark and computes the costs of every reported path
+ *
+ * @param {{command: string, args: string[], datasets: SyntheticDataset[]}} microbench
+ * @param {number} minTime ms per path
+ * @param {number} mhz
+ * @param {string} buildPath
+ * @returns {{path: string, dataset: string, bytes: number, members: number, ns: number, cycles: number, cyclesByte: number, cyclesMember: number}[]}
+ */
+function run(microbench, minTime, mhz, buildPath) {
+    let result = child_process.spawnSync(microbench.command, [...microbench.args, "--min-time", `${minTime}`], {cwd: buildPath, encoding: "utf8", timeout: 600000});
+    let reports = result.stdout !== null ? [...result.stdout.matchAll(/^micro: (\S+) (\S+) (\d+) (\d+)$/mg)] : [];
+    if (result.status !== 0 || reports.length == 0) {
+        throw new Error(`${microbench.command} ${microbench.args.join(" ")} failed (${result.error || `status ${result.status}`}):\n${result.stdout}${result.stderr}`);
+    }
+    return reports.map(([, name, datasetName, iterations, ns]) => {
+        let dataset = microbench.datasets.find(dataset => dataset.name == datasetName);
+        let nsCall = Number(ns) / Number(iterations);
+        let cycles = nsCall * mhz / 1000;
+        return {
+            path: name,
+            dataset: datasetName,
+            bytes: dataset.bytes,
+            members: dataset.members,
+            ns: Number(nsCall.toPrecision(3)),
+            cycles: Math.round(cycles),
+            cyclesByte: Number((cycles / dataset.bytes).toPrecision(3)),
+            cyclesMember: Number((cycles / dataset.members).toPrecision(3))
+        };
+    });
+}
+
+/**
+ * @param {Object.<string, Object>} results per `model/binding`, the rows of run() or `skipped`
+ * @returns {string} table of the costs per dataset
+ */
+function table(results) {
+    let header = ["model", "binding", "path", "dataset", "bytes", "members", "ns/call", "cycles", "cycles/B", "cycles/member"];
+    let rows = [];
+    for (let [key, result] of Object.entries(results)) {
+        let [model, binding] = key.split("/");
+        if (result.skipped !== undefined) {
+            rows.push([model, binding, `skipped: ${result.skipped}`]);
+            continue;
+        }
+        for (let row of result) {
+            rows.push([model, binding, row.path, row.dataset, `${row.bytes}`, `${row.members}`, `${row.ns}`, `${row.cycles}`, `${row.cyclesByte}`, `${row.cyclesMember}`]);
+        }
+    }
+    let widths = header.map((title, i) => Math.max(title.length, ...rows.filter(row => row.length > 3).map(row => row[i].length)));
+    let line = row => row.map((cell, i) => i < 4 ? cell.padEnd(widths[i]) : row.length > 3 ? cell.padStart(widths[i]) : cell).join("  ");
+    return [line(header), ...rows.map(line)].join("\n");
+}
+
+function main() {
+    let args = process.argv.slice(2);
+    let option = (name, value) => args.includes(name) ? args[args.indexOf(name) + 1] : value;
+    let minTime = parseInt(option("--min-time", "50"));
+    let mhz = parseFloat(option("--mhz", `${cpuMHz()}`));
+    let workPath = fs.mkdtempSync(path.join(os.tmpdir(), "exos-microbench-"));
+    let results = {};
+
+    try {
+        let all = models(workPath);
+        let selectedModels = option("--models", Object.keys(all).join(",")).split(",");
+        let selectedBindings = option("--bindings", bindings.join(",")).split(",");
+        for (let name of selectedModels) {
+            if (all[name] === undefined) {
+                throw new Error(`unknown model ${name}, one of ${Object.keys(all).join(", ")}`);
+            }
+            for (let binding of selectedBindings) {
+                let buildPath = path.join(workPath, name, binding);
+                fs.mkdirSync(buildPath, {recursive: true});
+                let microbench = buildMicrobench(all[name], binding, buildPath);
+                results[`${name}/${binding}`] = microbench.skipped !== undefined ? microbench : run(microbench, minTime, mhz, buildPath);
+                console.error(`${name}/${binding} done`);
+            }
+        }
+    }
+    finally {
+        if (args.includes("--keep")) {
+            console.error(`build directory kept in ${workPath}`);
+        }
+        else {
+            fs.rmSync(workPath, {recursive: true, force: true});
+        }
+    }
+
+    console.log(`cycles at ${mhz} MHz (${os.cpus()[0].model})\n`);
+    console.log(table(results));
+}
+
+if (require.main === module) {
+    main();
+}
+
+module.exports = {syntheticDatasets, buildMicrobench, run};
@@ -0,0 +1,59 @@
+const assert = require('assert');
+const path = require('path');
+const os = require('os');
+const fs = require('fs');
+const child_process = require('child_process');
+const { Datamodel } = require('../../../src/datamodel');
+const { TemplateARDynamic } = require('../../../src/components/templates/ar/template_ar_dynamic');
+
+suite('AR work budget tests (host build)', () => {
+
+    // The AR c-api library with the `budget` feature is generated from typfiles/Budget.typ and built on the host
+    // with the system C compiler, against the stub AR headers and the mock exOS API in stub/
+    // budget_host.c then drives the Cyclic FUB and checks that the budget is kept (see the mock for the simulated costs)
+    // the test is skipped if there is no C compiler
+
+    let typFile = path.resolve(__dirname, '../typfiles/Budget.typ');
+    let stubPath = path.resolve(__dirname, 'stub');
+
+    test('Generated FUB interface', function() {
+        let template = new TemplateARDynamic(new Datamodel(typFile, "Budget", ["Budget"]), ["budget"]);
+
+        assert.match(template.libraryFun.contents, /BudgetTime : UDINT;/);
+        assert.match(template.libraryFun.contents, /PeakCycleTime : UDINT;/);
+        assert.match(template.libraryFun.contents, /Deferred : UDINT;/);
+
+        let plain = new TemplateARDynamic(new Datamodel(typFile, "Budget", ["Budget"]));
+        assert.doesNotMatch(plain.libraryFun.contents, /BudgetTime/);
+        assert.doesNotMatch(plain.librarySource.contents, /processWorkBudget/);
+    });
+
+    test('Budget adherence', function() {
+        if (child_process.spawnSync("cc", ["--version"]).status !== 0) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        let datamodel = new Datamodel(typFile, "Budget", ["Budget"]);
+        let template = new TemplateARDynamic(datamodel, ["budget"]);
+
+        let buildPath = fs.mkdtempSync(path.join(os.tmpdir(), "exos-ar-budget-"));
+        try {
+            for (let file of [template.librarySource, datamodel.headerFile, datamodel.sourceFile]) {
+                fs.writeFileSync(path.join(buildPath, file.name), file.contents);
+            }
+
+            let executable = path.join(buildPath, "budget_host");
+            let build = child_process.spawnSync("cc", ["-std=gnu99", "-Wall", `-I${stubPath}`, `-I${buildPath}`,
+                path.join(buildPath, template.librarySource.name), path.join(buildPath, datamodel.sourceFile.name),
+                path.join(stubPath, "mock_exos.c"), path.resolve(__dirname, "budget_host.c"), "-o", executable], {encoding: "utf8"});
+            assert.equal(build.status, 0, build.stderr);
+
+            let run = child_process.spawnSync(executable, [], {encoding: "utf8"});
+            assert.equal(run.status, 0, run.stdout + run.stderr);
+        }
+        finally {
+            fs.rmSync(buildPath, {recursive: true, force: true});
+        }
+    });
+});
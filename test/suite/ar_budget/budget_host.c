@@ -0,0 +1,146 @@
+/* Host test of the work budget of the generated AR library (TemplateARDynamic with the `budget` feature)
+
+   Built by ar.budget.test.js from the generated budget.c and exos_budget.c, the stub headers
+   and the mock exOS API in stub/, where publishing a dataset costs 5us + 1us per 8 bytes. */
+
+#include <stdio.h>
+#include <string.h>
+#include <Budget.h>
+
+#define ITEMS 5        // datasets with work (4 PUB, 2 SUB, Config is both)
+#define MAX_ITEM 105   // cost (us) of publishing Setpoints or Samples
+#define MAX_BYTES 800  // size of Setpoints and Samples
+
+static int failures = 0;
+
+#define CHECK(_cond_, _format_, ...)                                          \
+    do                                                                        \
+    {                                                                         \
+        if (!(_cond_))                                                        \
+        {                                                                     \
+            fprintf(stderr, "FAILED line %d: " _format_ "\n", __LINE__, ##__VA_ARGS__); \
+            failures++;                                                       \
+        }                                                                     \
+    } while (0)
+
+static struct BudgetCyclic cyclic;
+static Budget data;
+static UDINT peak = 0;
+
+static void cycle(void)
+{
+    UDINT limit;
+
+    BudgetCyclic(&cyclic);
+
+    CHECK(!cyclic.Error, "Cyclic error");
+    if (cyclic.BudgetTime > 0)
+    {
+        limit = (cyclic.BudgetTime > mock_process_cost ? cyclic.BudgetTime : mock_process_cost) + MAX_ITEM;
+        CHECK(cyclic.CycleTime <= limit, "CycleTime %lu exceeds BudgetTime %lu by more than one dataset", (unsigned long)cyclic.CycleTime, (unsigned long)cyclic.BudgetTime);
+    }
+    if (cyclic.BudgetBytes > 0)
+    {
+        CHECK(cyclic.CycleBytes <= cyclic.BudgetBytes + MAX_BYTES, "CycleBytes %lu exceeds BudgetBytes %lu by more than one dataset", (unsigned long)cyclic.CycleBytes, (unsigned long)cyclic.BudgetBytes);
+    }
+    if (cyclic.CycleTime > peak)
+        peak = cyclic.CycleTime;
+    CHECK(cyclic.PeakCycleTime == peak, "PeakCycleTime %lu, expected %lu", (unsigned long)cyclic.PeakCycleTime, (unsigned long)peak);
+}
+
+static void changeAll(void)
+{
+    data.Setpoints[0] += 1.0;
+    data.Status++;
+    data.Samples[99] += 1.0;
+    data.Config.Gain += 0.5;
+}
+
+static UDINT publishedAll(void)
+{
+    return mock_publish_count("Setpoints") + mock_publish_count("Status") + mock_publish_count("Samples") + mock_publish_count("Config");
+}
+
+int main(void)
+{
+    struct BudgetInit init;
+    struct BudgetExit exit;
+    UDINT published, i, n;
+    DINT commands[50];
+
+    memset(&init, 0, sizeof(init));
+    BudgetInit(&init);
+    CHECK(init.Handle != 0, "BudgetInit failed");
+
+    memset(&cyclic, 0, sizeof(cyclic));
+    cyclic.Enable = true;
+    cyclic.Start = true;
+    cyclic.Handle = init.Handle;
+    cyclic.pBudget = &data;
+    for (i = 0; i < 3; i++)
+        cycle();
+    CHECK(cyclic.Operational, "not operational");
+
+    //no budget: everything in one cycle
+    published = publishedAll();
+    changeAll();
+    cycle();
+    CHECK(publishedAll() == published + 4, "published %lu datasets without budget, expected 4", (unsigned long)(publishedAll() - published));
+    CHECK(cyclic.Deferred == 0, "Deferred %lu without budget", (unsigned long)cyclic.Deferred);
+    CHECK(cyclic.CycleBytes == 2 * sizeof(data.Setpoints) + sizeof(data.Status) + sizeof(data.Config), "CycleBytes %lu without budget", (unsigned long)cyclic.CycleBytes);
+
+    //time budget: the remaining datasets are deferred and published in the following cycles
+    cyclic.BudgetTime = 150;
+    published = publishedAll();
+    changeAll();
+    cycle();
+    CHECK(cyclic.Deferred > 0, "nothing deferred with BudgetTime %lu", (unsigned long)cyclic.BudgetTime);
+    for (n = 1; n < ITEMS && cyclic.Deferred > 0; n++)
+        cycle();
+    CHECK(cyclic.Deferred == 0, "still %lu deferred after %lu cycles", (unsigned long)cyclic.Deferred, (unsigned long)n);
+    CHECK(publishedAll() == published + 4, "published %lu datasets with BudgetTime, expected 4", (unsigned long)(publishedAll() - published));
+
+    //round-robin: datasets changing every cycle do not starve the others
+    cyclic.BudgetTime = 120;
+    published = mock_publish_count("Config");
+    for (i = 0; i < 20; i++)
+    {
+        changeAll();
+        cycle();
+    }
+    CHECK(mock_publish_count("Config") >= published + 5, "Config only published %lu times in 20 cycles", (unsigned long)(mock_publish_count("Config") - published));
+
+    //received datasets are delivered within the budget as well
+    for (i = 0; i < 50; i++)
+        commands[i] = (DINT)(i * 3);
+    mock_receive("Commands", commands, sizeof(commands));
+    for (i = 0; i < ITEMS && 0 != memcmp(data.Commands, commands, sizeof(commands)); i++)
+    {
+        changeAll();
+        cycle();
+    }
+    CHECK(0 == memcmp(data.Commands, commands, sizeof(commands)), "Commands not delivered within %lu cycles", (unsigned long)ITEMS);
+
+    //byte budget
+    cyclic.BudgetTime = 0;
+    cyclic.BudgetBytes = 500;
+    for (i = 0; i < ITEMS; i++)
+        cycle();
+    published = publishedAll();
+    changeAll();
+    cycle();
+    CHECK(cyclic.Deferred > 0, "nothing deferred with BudgetBytes %lu", (unsigned long)cyclic.BudgetBytes);
+    for (n = 1; n < ITEMS && cyclic.Deferred > 0; n++)
+        cycle();
+    CHECK(cyclic.Deferred == 0, "still %lu deferred after %lu cycles", (unsigned long)cyclic.Deferred, (unsigned long)n);
+    CHECK(publishedAll() == published + 4, "published %lu datasets with BudgetBytes, expected 4", (unsigned long)(publishedAll() - published));
+
+    cyclic.Enable = false;
+    cycle();
+    memset(&exit, 0, sizeof(exit));
+    exit.Handle = init.Handle;
+    BudgetExit(&exit);
+
+    printf("%d failures, PeakCycleTime %lu us\n", failures, (unsigned long)cyclic.PeakCycleTime);
+    return failures ? 1 : 0;
+}
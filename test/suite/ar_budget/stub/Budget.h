@@ -0,0 +1,53 @@
+/* Host stub of the header Automation Studio generates from Budget.fun */
+
+#ifndef _BUDGET_H_
+#define _BUDGET_H_
+
+#include <bur/plctypes.h>
+#include "exos_budget.h"
+
+struct BudgetInit
+{
+    UDINT Handle;
+    USINT _state;
+};
+
+struct BudgetCyclic
+{
+    BOOL Enable;
+    UDINT Handle;
+    BOOL Start;
+    Budget *pBudget;
+    UDINT BudgetTime;
+    UDINT BudgetBytes;
+    BOOL Active;
+    BOOL Error;
+    BOOL Disconnected;
+    BOOL Connected;
+    BOOL Operational;
+    BOOL Aborted;
+    BOOL InSync;
+    UDINT MissedDmrCycles;
+    UDINT MissedArCycles;
+    UDINT SyncChanges;
+    UDINT CycleTime;
+    UDINT CycleBytes;
+    UDINT PeakCycleTime;
+    UDINT Deferred;
+    USINT _state;
+};
+
+struct BudgetExit
+{
+    UDINT Handle;
+    USINT _state;
+};
+
+_BUR_PUBLIC void BudgetInit(struct BudgetInit *inst);
+_BUR_PUBLIC void BudgetCyclic(struct BudgetCyclic *inst);
+_BUR_PUBLIC void BudgetExit(struct BudgetExit *inst);
+
+UINT TMP_alloc(UDINT size, void **memory);
+UINT TMP_free(UDINT size, void *memory);
+
+#endif // _BUDGET_H_
@@ -0,0 +1,29 @@
+/* Mock of the exOS logger for building AR library sources on the host, see mock_exos.c */
+
+#ifndef _EXOS_LOG_H_
+#define _EXOS_LOG_H_
+
+#include "exos_api.h"
+
+typedef struct
+{
+    const char *name;
+} exos_log_handle_t;
+
+typedef enum
+{
+    EXOS_LOG_TYPE_USER = 1,
+    EXOS_LOG_TYPE_SYSTEM = 2,
+    EXOS_LOG_TYPE_VERBOSE = 4
+} EXOS_LOG_TYPE;
+
+EXOS_ERROR_CODE exos_log_init(exos_log_handle_t *log, const char *name);
+EXOS_ERROR_CODE exos_log_process(exos_log_handle_t *log);
+EXOS_ERROR_CODE exos_log_delete(exos_log_handle_t *log);
+EXOS_ERROR_CODE exos_log_error(const exos_log_handle_t *log, const char *format, ...);
+EXOS_ERROR_CODE exos_log_warning(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...);
+EXOS_ERROR_CODE exos_log_success(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...);
+EXOS_ERROR_CODE exos_log_info(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...);
+EXOS_ERROR_CODE exos_log_debug(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...);
+
+#endif // _EXOS_LOG_H_
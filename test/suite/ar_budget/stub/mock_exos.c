@@ -0,0 +1,239 @@
+/* Mock of the exOS API for building AR library sources on the host
+
+   There is no server: the datamodel is operational as soon as it is connected, and the nettime
+   is a simulated clock (us) that advances with a fixed cost per exos_datamodel_process() and a
+   cost per exos_dataset_publish() depending on the size of the dataset. Updates queued with
+   mock_receive() are written to the dataset and delivered in the next exos_datamodel_process(). */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <bur/plctypes.h>
+#include "exos_api.h"
+#include "exos_log.h"
+
+#define MOCK_MAX_DATASETS 32
+#define MOCK_MAX_SIZE 4096
+
+int32_t mock_nettime = 0;
+uint32_t mock_publish_cost_base = 5;
+uint32_t mock_publish_cost_bytes = 8;
+uint32_t mock_process_cost = 10;
+
+typedef struct
+{
+    exos_dataset_handle_t *dataset;
+    uint32_t published;
+    bool received;
+    unsigned char buffer[MOCK_MAX_SIZE];
+} mock_dataset_t;
+
+static mock_dataset_t datasets[MOCK_MAX_DATASETS];
+static size_t dataset_count = 0;
+
+static mock_dataset_t *find(const char *name)
+{
+    size_t i;
+    for (i = 0; i < dataset_count; i++)
+    {
+        if (0 == strcmp(datasets[i].dataset->name, name))
+            return &datasets[i];
+    }
+    return NULL;
+}
+
+uint32_t mock_publish_count(const char *name)
+{
+    mock_dataset_t *mock = find(name);
+    return mock ? mock->published : 0;
+}
+
+void mock_receive(const char *name, const void *data, size_t size)
+{
+    mock_dataset_t *mock = find(name);
+    if (NULL == mock || size != mock->dataset->size || size > MOCK_MAX_SIZE)
+    {
+        fprintf(stderr, "mock_receive: invalid dataset %s\n", name);
+        exit(2);
+    }
+    memcpy(mock->buffer, data, size);
+    mock->received = true;
+}
+
+const char *exos_get_error_string(EXOS_ERROR_CODE error)
+{
+    return EXOS_ERROR_OK == error ? "EXOS_ERROR_OK" : "EXOS_ERROR";
+}
+
+const char *exos_get_state_string(EXOS_CONNECTION_STATE state)
+{
+    switch (state)
+    {
+    case EXOS_STATE_DISCONNECTED:
+        return "EXOS_STATE_DISCONNECTED";
+    case EXOS_STATE_CONNECTED:
+        return "EXOS_STATE_CONNECTED";
+    case EXOS_STATE_OPERATIONAL:
+        return "EXOS_STATE_OPERATIONAL";
+    default:
+        return "EXOS_STATE_ABORTED";
+    }
+}
+
+EXOS_ERROR_CODE exos_datamodel_init(exos_datamodel_handle_t *datamodel, const char *datamodel_instance_name, const char *user_alias)
+{
+    memset(datamodel, 0, sizeof(*datamodel));
+    datamodel->name = (char *)datamodel_instance_name;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_connect(exos_datamodel_handle_t *datamodel, const char *config, const exos_dataset_info_t *info, size_t info_size, exos_datamodel_event_cb datamodel_event_callback)
+{
+    datamodel->datamodel_event_callback = datamodel_event_callback;
+    datamodel->connection_state = EXOS_STATE_CONNECTED;
+    datamodel_event_callback(datamodel, EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED, NULL);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_set_operational(exos_datamodel_handle_t *datamodel)
+{
+    datamodel->connection_state = EXOS_STATE_OPERATIONAL;
+    datamodel->datamodel_event_callback(datamodel, EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED, NULL);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_disconnect(exos_datamodel_handle_t *datamodel)
+{
+    datamodel->connection_state = EXOS_STATE_DISCONNECTED;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_delete(exos_datamodel_handle_t *datamodel)
+{
+    dataset_count = 0;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_process(exos_datamodel_handle_t *datamodel)
+{
+    size_t i;
+
+    mock_nettime += mock_process_cost;
+    for (i = 0; i < dataset_count; i++)
+    {
+        exos_dataset_handle_t *dataset = datasets[i].dataset;
+        if (datasets[i].received && (dataset->type & EXOS_DATASET_SUBSCRIBE))
+        {
+            datasets[i].received = false;
+            memcpy(dataset->data, datasets[i].buffer, dataset->size);
+            dataset->nettime = mock_nettime;
+            dataset->dataset_event_callback(dataset, EXOS_DATASET_EVENT_UPDATED, NULL);
+        }
+    }
+    return EXOS_ERROR_OK;
+}
+
+int32_t exos_datamodel_get_nettime(exos_datamodel_handle_t *datamodel)
+{
+    return mock_nettime;
+}
+
+void exos_datamodel_calc_dataset_info(exos_dataset_info_t *info, size_t info_size)
+{
+}
+
+EXOS_ERROR_CODE exos_dataset_init(exos_dataset_handle_t *dataset, exos_datamodel_handle_t *datamodel, const char *browse_name, const void *data, size_t size)
+{
+    if (dataset_count >= MOCK_MAX_DATASETS)
+        return EXOS_ERROR_PARAMETER_NULL;
+
+    memset(dataset, 0, sizeof(*dataset));
+    dataset->name = browse_name;
+    dataset->datamodel = datamodel;
+    dataset->data = (void *)data;
+    dataset->size = size;
+
+    memset(&datasets[dataset_count], 0, sizeof(datasets[dataset_count]));
+    datasets[dataset_count].dataset = dataset;
+    dataset_count++;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_dataset_connect(exos_dataset_handle_t *dataset, EXOS_DATASET_TYPE type, exos_dataset_event_cb dataset_event_callback)
+{
+    dataset->type = type;
+    dataset->dataset_event_callback = dataset_event_callback;
+    dataset->connection_state = EXOS_STATE_OPERATIONAL;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_dataset_publish(exos_dataset_handle_t *dataset)
+{
+    mock_dataset_t *mock = find(dataset->name);
+    if (NULL == mock || !(dataset->type & EXOS_DATASET_PUBLISH))
+        return EXOS_ERROR_BAD_STATE;
+
+    mock->published++;
+    mock_nettime += mock_publish_cost_base + dataset->size / mock_publish_cost_bytes;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_init(exos_log_handle_t *log, const char *name)
+{
+    log->name = name;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_process(exos_log_handle_t *log)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_delete(exos_log_handle_t *log)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_error(const exos_log_handle_t *log, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%s error: ", log->name);
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_warning(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_success(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_info(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_debug(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
+
+UINT TMP_alloc(UDINT size, void **memory)
+{
+    *memory = calloc(1, size);
+    return NULL == *memory;
+}
+
+UINT TMP_free(UDINT size, void *memory)
+{
+    free(memory);
+    return 0;
+}
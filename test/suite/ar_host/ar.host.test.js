@@ -0,0 +1,442 @@
+const assert = require('assert');
+const path = require('path');
+const os = require('os');
+const fs = require('fs');
+const child_process = require('child_process');
+const { Datamodel } = require('../../../src/datamodel');
+const { TemplateARDynamic } = require('../../../src/components/templates/ar/template_ar_dynamic');
+const { TemplateARStaticCLib } = require('../../../src/components/templates/ar/template_ar_static_c_lib');
+const { TemplateLinuxStaticCLib } = require('../../../src/components/templates/linux/template_linux_static_c_lib');
+const { TemplateLinuxCpp } = require('../../../src/components/templates/linux/template_linux_cpp');
+const { TemplateLinuxNAPI } = require('../../../src/components/templates/linux/template_linux_napi');
+const { parseFun, funHeader, programSource, compile, buildAR, runHostTest } = require('./ar_host');
+
+suite('AR host emulation tests', () => {
+
+    // The AR templates generated from typfiles/Budget.typ are built as Linux executables by ar_host.js, with the
+    // task class emulation in ar_host.c and the DMR stand-in in dmr_host.c (see ar_host.js)
+    // each run uses its own shared memory object (EXOS_HOST_DMR), which is removed afterwards
+    // the build tests are skipped if there is no C compiler
+
+    let typFile = path.resolve(__dirname, '../typfiles/Budget.typ');
+
+    function hasCompiler() {
+        return child_process.spawnSync("cc", ["--version"]).status === 0 && child_process.spawnSync("c++", ["--version"]).status === 0;
+    }
+
+    test('Library header and program from the .fun', function() {
+        let template = new TemplateARDynamic(new Datamodel(typFile, "Budget", ["Budget"]));
+        let blocks = parseFun(template.libraryFun.contents);
+
+        assert.deepEqual(blocks.map(block => block.name), ["BudgetInit", "BudgetCyclic", "BudgetExit"]);
+        let cyclic = blocks.find(block => block.name == "BudgetCyclic");
+        assert.deepEqual(cyclic.members.find(member => member.name == "pBudget"), {name: "pBudget", type: "Budget", reference: true});
+
+        let header = funHeader("Budget", blocks, "exos_budget.h");
+        assert.match(header, /struct Budget \*pBudget;/);
+        assert.match(header, /_BUR_PUBLIC void BudgetCyclic\(struct BudgetCyclic \*inst\);/);
+
+        let program = programSource("Budget", blocks, "Budget", 2);
+        assert.match(program, /BudgetInit\(&BudgetInit_0\);/);
+        assert.match(program, /BudgetCyclic_0.Handle = BudgetInit_0.Handle;/);
+        assert.match(program, /{"Budget_0", 2, program_init, program_cyclic, program_exit}/);
+
+        // without an exit function block, the program disables the cyclic one
+        let staticTemplate = new TemplateARStaticCLib(new Datamodel(typFile, "Budget", ["Budget"]));
+        let staticProgram = programSource("Budget", parseFun(staticTemplate.libraryFun.contents), "Budget", 1);
+        assert.match(staticProgram, /BudgetCyclic_0.Enable = 0;/);
+    });
+
+    for (let templateAR of ["c-api", "c-static", "cpp"]) {
+        test(`AR ${templateAR} template on the host`, function() {
+            if (!hasCompiler()) {
+                this.skip();
+            }
+            this.timeout(0);
+
+            let buildPath = fs.mkdtempSync(path.join(os.tmpdir(), "exos-ar-host-"));
+            let dmr = path.basename(buildPath);
+            try {
+                let executable = buildAR(typFile, "Budget", templateAR, buildPath);
+                let run = child_process.spawnSync(executable, ["--cycles", "20", "--tc1", "2000"],
+                    {encoding: "utf8", env: {...process.env, EXOS_HOST_DMR: dmr}});
+
+                assert.equal(run.status, 0, run.stdout + run.stderr);
+                assert.match(run.stdout, /changed state to EXOS_STATE_OPERATIONAL/);
+                assert.match(run.stdout, /ar: task class 1 \(2000 us\): 20 cycles/);
+            }
+            finally {
+                fs.rmSync(buildPath, {recursive: true, force: true});
+                fs.rmSync(path.join("/dev/shm", dmr), {force: true});
+            }
+        });
+    }
+
+    test('C++ reflection of the StringAndArray members', function() {
+        if (!hasCompiler()) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // reflection_check.cpp visits every member with for_each_member and compares TypeInfo with offsetof/sizeof
+        let datamodel = new Datamodel(path.resolve(__dirname, '../typfiles/StringAndArray.typ'), "StringAndArray", ["StringAndArray"]);
+        let buildPath = fs.mkdtempSync(path.join(os.tmpdir(), "exos-ar-host-"));
+        try {
+            let executable = path.join(buildPath, "reflection_check");
+            compile([datamodel.headerFile, datamodel.reflectionFile], buildPath, [path.join(__dirname, "reflection_check.cpp")], executable);
+            let run = child_process.spawnSync(executable, [], {encoding: "utf8"});
+
+            assert.equal(run.status, 0, run.stdout + run.stderr);
+            assert.match(run.stdout, /reflection: 35 members ok/);
+        }
+        finally {
+            fs.rmSync(buildPath, {recursive: true, force: true});
+        }
+    });
+
+    test('AR and Linux end to end', function(done) {
+        if (!hasCompiler()) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // the AR program publishes its cycle count in Status (e2e_user.c), which the Linux application receives
+        runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: TemplateLinuxStaticCLib,
+            ar: {template: "c-static", user: path.join(__dirname, "e2e_user.c"), args: ["--cycles", "50", "--tc1", "2000"]},
+            check: run => {
+                assert.equal(run.arStatus, 0, run.arOutput);
+                assert.match(run.arOutput, /dmr: \w+ Status published [1-9]\d* received 0/);
+                let received = run.stdout.match(/dmr: \w+ Status published 0 received (\d+)/);
+                assert.ok(received !== null, run.stdout);
+                assert.ok(parseInt(received[1]) > 0, run.stdout);
+            }
+        }, done);
+    });
+
+    test('Publish group delivered without torn members', function(done) {
+        if (!hasCompiler()) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // the AR program publishes the Odom group of typfiles/Odometry.typ every cycle (group_user.c), the Linux application
+        // counts the group and member callbacks, and the ones that saw members of different publishes (group_receiver.c)
+        runHostTest({typFile: path.resolve(__dirname, '../typfiles/Odometry.typ'), typeName: "Odometry", LinuxTemplate: TemplateLinuxStaticCLib,
+            linux: {main: path.join(__dirname, "group_receiver.c")},
+            ar: {template: "c-api", user: path.join(__dirname, "group_user.c"), args: ["--cycles", "100", "--tc1", "2000"]},
+            check: run => {
+                assert.equal(run.arStatus, 0, run.arOutput);
+                let result = run.stdout.match(/group: (\d+) groups, (\d+) member callbacks, (\d+) torn/);
+                assert.ok(result !== null, run.stdout);
+                assert.ok(parseInt(result[1]) > 0, run.stdout);
+                assert.equal(parseInt(result[2]), 3 * parseInt(result[1]), run.stdout);
+                assert.equal(parseInt(result[3]), 0, run.stdout);
+            }
+        }, done);
+    });
+
+    test('Publish group sequence numbers across the wraparound', function() {
+        if (!hasCompiler()) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // group_check.c runs the sequence numbers of the Odom group of typfiles/Odometry.typ through the wraparound
+        let datamodel = new Datamodel(path.resolve(__dirname, '../typfiles/Odometry.typ'), "Odometry", ["Odometry"]);
+        let buildPath = fs.mkdtempSync(path.join(os.tmpdir(), "exos-ar-host-"));
+        try {
+            let executable = path.join(buildPath, "group_check");
+            compile([datamodel.headerFile, datamodel.groupFile], buildPath, [path.join(__dirname, "group_check.c")], executable);
+            let run = child_process.spawnSync(executable, [], {encoding: "utf8"});
+
+            assert.equal(run.status, 0, run.stdout + run.stderr);
+            assert.match(run.stdout, /group: 7 cases ok/);
+        }
+        finally {
+            fs.rmSync(buildPath, {recursive: true, force: true});
+        }
+    });
+
+    test('Publish on modify of changed values only', function(done) {
+        if (!hasCompiler()) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // the application writes Commands through modify() with a value that changes every 10th cycle, and only reads
+        // Config through modify() (modify_user.cpp), process() publishes the changes and suppresses the rest
+        runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: TemplateLinuxCpp,
+            linux: {main: path.join(__dirname, "modify_user.cpp")},
+            ar: {template: "c-static", args: ["--cycles", "100", "--tc1", "2000"]},
+            check: run => {
+                assert.equal(run.arStatus, 0, run.arOutput);
+                let result = run.stdout.match(/modify: (\d+) cycles, (\d+) changes, (\d+) published, (\d+) suppressed/);
+                assert.ok(result !== null, run.stdout);
+                let [cycles, changes, published, suppressed] = result.slice(1).map(value => parseInt(value));
+                assert.ok(cycles > 20, run.stdout);
+                // the first Config publish, and the writes of the last cycle may still be pending
+                assert.ok(published >= changes && published <= changes + 1, run.stdout);
+                assert.ok(published + suppressed >= 2 * cycles - 2 && published + suppressed <= 2 * cycles, run.stdout);
+                let commands = run.stdout.match(/dmr: \w+ Commands published (\d+) received 0/);
+                assert.ok(commands !== null, run.stdout);
+                assert.ok(parseInt(commands[1]) >= changes - 1 && parseInt(commands[1]) <= changes, run.stdout);
+            }
+        }, done);
+    });
+
+    test('C++ structure-of-arrays mirror round trip and publish', function(done) {
+        if (!hasCompiler()) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // the application writes the MyIntStruct mirror of typfiles/StringAndArray.typ every cycle, alternating between a
+        // soaModify() scope published through the base class, and soaModify(f) published by process() (soa_user.cpp)
+        runHostTest({typFile: path.resolve(__dirname, '../typfiles/StringAndArray.typ'), typeName: "StringAndArray", LinuxTemplate: TemplateLinuxCpp,
+            linux: {features: ["soa"], main: path.join(__dirname, "soa_user.cpp")},
+            ar: {template: "c-static", args: ["--cycles", "100", "--tc1", "2000"]},
+            check: run => {
+                assert.equal(run.arStatus, 0, run.arOutput);
+                let result = run.stdout.match(/soa: round trip (\w+), (\d+) cycles, (\d+) stored on publish, (\d+) written, (\d+) read modified, (\d+) published, (\d+) suppressed/);
+                assert.ok(result !== null, run.stdout);
+                assert.equal(result[1], "ok", run.stdout);
+                let [cycles, stored, written, readModified, published, suppressed] = result.slice(2).map(value => parseInt(value));
+                assert.ok(cycles > 20, run.stdout);
+                assert.equal(stored, Math.ceil(cycles / 2), run.stdout);
+                assert.equal(written, Math.floor(cycles / 2), run.stdout);
+                assert.equal(readModified, 0, run.stdout);
+                // the write of the last cycle may still be pending
+                assert.ok(published >= written - 1 && published <= written, run.stdout);
+                assert.ok(suppressed >= stored - 1 && suppressed <= stored, run.stdout);
+                let datasets = run.stdout.match(/dmr: \w+ MyIntStruct published (\d+) received 0/);
+                assert.ok(datasets !== null, run.stdout);
+                assert.ok(parseInt(datasets[1]) >= cycles - 1 && parseInt(datasets[1]) <= cycles, run.stdout);
+            }
+        }, done);
+    });
+
+    test('AR c-api quality of service', function(done) {
+        if (!hasCompiler()) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // the AR program writes Level and Counter of typfiles/Sensor.typ every cycle, Level is published at most every
+        // 10 ms (qos_user.c). The Linux application publishes Feedback in steps of 0.05 at most every 5 ms (qos_sender.c),
+        // of which the AR program only gets the values moved at least 1 from the last one it got
+        runHostTest({typFile: path.resolve(__dirname, '../typfiles/Sensor.typ'), typeName: "Sensor", LinuxTemplate: TemplateLinuxStaticCLib,
+            linux: {main: path.join(__dirname, "qos_sender.c")},
+            ar: {template: "c-api", user: path.join(__dirname, "qos_user.c"), args: ["--cycles", "100", "--tc1", "2000"]},
+            check: run => {
+                assert.equal(run.arStatus, 0, run.arOutput);
+                let level = run.arOutput.match(/dmr: \w+ Level published (\d+) received 0/);
+                let counter = run.arOutput.match(/dmr: \w+ Counter published (\d+) received 0/);
+                assert.ok(level !== null && counter !== null, run.arOutput);
+                // 100 cycles of 2 ms are at most 21 publishes 10 ms apart
+                assert.ok(parseInt(level[1]) > 0 && parseInt(level[1]) <= 21, run.arOutput);
+                assert.ok(parseInt(counter[1]) > 2 * parseInt(level[1]), run.arOutput);
+
+                let feedback = [...run.arOutput.matchAll(/qos: feedback ([\d.]+)/g)].map(match => parseFloat(match[1]));
+                assert.ok(feedback.length > 0, run.arOutput);
+                for (let i = 1; i < feedback.length; i++) {
+                    assert.ok(feedback[i] - feedback[i - 1] >= 1, run.arOutput);
+                }
+                let received = run.arOutput.match(/dmr: \w+ Feedback published 0 received (\d+)/);
+                assert.ok(received !== null && parseInt(received[1]) > feedback.length, run.arOutput);
+            }
+        }, done);
+    });
+
+    test('Linux gateway with a Node.js consumer', function(done) {
+        if (!hasCompiler()) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // the Linux application forwards the Status published by the AR program to the generated Node.js client
+        let gateway, consumer, changes = 0;
+        runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: TemplateLinuxStaticCLib,
+            linux: run => ({features: ["gateway"], args: ["--gateway-name", `/${run.dmr}-gw`]}),
+            ar: {template: "c-static", user: path.join(__dirname, "e2e_user.c"), args: ["--cycles", "100", "--tc1", "5000"]},
+            drive: run => {
+                const { BudgetGateway } = require(path.join(run.buildPath, "linux", "budget_gateway.js"));
+                gateway = new BudgetGateway();
+                gateway.Status.onChange(() => changes++);
+                gateway.connect(`/${run.dmr}-gw`);
+                consumer = setInterval(() => gateway.process(), 5);
+                run.runAR();
+            },
+            check: run => {
+                clearInterval(consumer);
+                gateway.process();
+                assert.ok(changes > 0, `${changes} changes`);
+                assert.ok(gateway.Status.value > 0);
+                assert.equal(gateway.isConnected, false);
+                assert.ok(!fs.existsSync(path.join("/dev/shm", `${run.dmr}-gw`)));
+            }
+        }, done);
+    });
+
+    for (let [templateLinux, LinuxTemplate] of [["c-static", TemplateLinuxStaticCLib], ["cpp", TemplateLinuxCpp]]) {
+        test(`Linux ${templateLinux} mirror with a C reader`, function(done) {
+            if (!hasCompiler()) {
+                this.skip();
+            }
+            this.timeout(0);
+
+            // the Linux application mirrors the Status published by the AR program, which mirror_reader.c reads
+            let reader;
+            runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: LinuxTemplate,
+                linux: run => ({features: ["mirror"], defines: [`EXOS_BUDGET_MIRROR_NAME="/${run.dmr}-mirror"`], reader: path.join(__dirname, "mirror_reader.c")}),
+                ar: {template: "c-static", user: path.join(__dirname, "e2e_user.c"), args: ["--tc1", "5000"]},
+                drive: run => {
+                    let program = run.runAR();
+                    reader = child_process.spawnSync(path.join(run.buildPath, "linux", "reader"), [], {encoding: "utf8"});
+                    program.kill("SIGTERM");
+                },
+                check: run => {
+                    assert.equal(reader.status, 0, reader.stdout + reader.stderr);
+                    assert.match(reader.stdout, /mirror: Status [1-9]\d* updates [1-9]\d*/);
+                    assert.ok(!fs.existsSync(path.join("/dev/shm", `${run.dmr}-mirror`)));
+                }
+            }, done);
+        });
+
+        test(`Linux ${templateLinux} metrics written to a file`, function(done) {
+            if (!hasCompiler()) {
+                this.skip();
+            }
+            this.timeout(0);
+
+            // the Linux application counts the Status published by the AR program, and writes the metrics when it exits
+            runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: LinuxTemplate,
+                linux: run => ({features: ["metrics"], args: ["--metrics-file", path.join(run.buildPath, "budget.prom")]}),
+                ar: {template: "c-static", user: path.join(__dirname, "e2e_user.c"), args: ["--cycles", "100", "--tc1", "5000"]},
+                check: run => {
+                    let metrics = fs.readFileSync(path.join(run.buildPath, "budget.prom"), "utf8");
+                    assert.match(metrics, /^exos_dataset_updates_total\{datamodel="Budget_0",dataset="Status"\} [1-9]\d*$/m);
+                    assert.match(metrics, /^exos_dataset_latency_seconds_count\{datamodel="Budget_0",dataset="Status"\} [1-9]\d*$/m);
+                    assert.match(metrics, /^# TYPE exos_datamodel_connection_state gauge$/m);
+                }
+            }, done);
+        });
+
+        test(`Linux ${templateLinux} trace dumped above the threshold`, function(done) {
+            if (!hasCompiler()) {
+                this.skip();
+            }
+            this.timeout(0);
+
+            // every process() exceeds a threshold of 1 us, so the first one with a received Status is dumped
+            runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: LinuxTemplate,
+                linux: run => ({features: ["trace"], args: ["--trace", path.join(run.buildPath, "budget"), "--trace-threshold", "1"]}),
+                ar: {template: "c-static", user: path.join(__dirname, "e2e_user.c"), args: ["--cycles", "300", "--tc1", "5000"]},
+                check: run => {
+                    let dumps = fs.readdirSync(run.buildPath).filter(file => /^budget\.\d+\.json$/.test(file));
+                    let events = dumps.flatMap(file => JSON.parse(fs.readFileSync(path.join(run.buildPath, file), "utf8")).traceEvents);
+                    assert.ok(dumps.length > 0, "no dump written");
+                    assert.ok(events.some(event => event.name == "process" && event.ph == "B"));
+                    assert.ok(events.some(event => event.name == "Status" && event.cat == "received" && event.ph == "i"));
+                    assert.ok(events.some(event => event.name == "Status" && event.cat == "callback" && event.ph == "E"));
+                }
+            }, done);
+        });
+
+        test(`Linux ${templateLinux} change-frequency profile`, function(done) {
+            if (!hasCompiler()) {
+                this.skip();
+            }
+            this.timeout(0);
+
+            // the AR program changes Setpoints[0] every cycle and Setpoints[1] every 10th cycle, which the profile ranks first
+            runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: LinuxTemplate,
+                linux: run => ({features: ["profile"], args: ["--profile", path.join(run.buildPath, "budget.txt")]}),
+                ar: {template: "c-static", user: path.join(__dirname, "profile_user.c"), args: ["--cycles", "100", "--tc1", "5000"]},
+                check: run => {
+                    let profile = fs.readFileSync(path.join(run.buildPath, "budget.txt"), "utf8");
+                    assert.match(profile, /^change-frequency profile of Budget_0$/m);
+                    assert.match(profile, /^Setpoints received: [1-9]\d* values of 800 bytes/m);
+                    assert.match(profile, /^ +1 +[1-9]\d* +[\d.]+% +8  \[0\]$/m);
+                    assert.match(profile, /^ +2 +[1-9]\d* +[\d.]+% +8  \[1\]$/m);
+                    assert.match(profile, /^ +SUB 1: 8 bytes, sent [1-9]\d* times: \[0\]$/m);
+                }
+            }, done);
+        });
+
+        test(`AR c-api and Linux ${templateLinux} round trip probe`, function(done) {
+            if (!hasCompiler()) {
+                this.skip();
+            }
+            this.timeout(0);
+
+            // the Cyclic FUB sends a probe every 10 ms (ProbePeriod 0), which the Linux application echoes
+            runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: LinuxTemplate,
+                linux: {features: ["probe"]},
+                ar: {template: "c-api", features: ["probe"], args: ["--cycles", "200", "--tc1", "2000"]},
+                check: run => {
+                    assert.equal(run.arStatus, 0, run.arOutput);
+                    assert.match(run.arOutput, /probe: [1-9]\d* requests, [1-9]\d* replies/);
+                    assert.match(run.arOutput, /dmr: \w+ ProbeReply published 0 received [1-9]/);
+                    assert.match(run.stdout, /dmr: \w+ ProbeReply published [1-9]\d* received 0/);
+                }
+            }, done);
+        });
+    }
+
+    test('Linux N-API trace dumped above the threshold', function(done) {
+        if (!hasCompiler() || !fs.existsSync(path.resolve(path.dirname(process.execPath), "../include/node/node_api.h"))) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // the onChange of Status runs in a later turn of the event loop than the process() it was received in, so
+        // there are enough cycles for a second dump (at most one per second) to contain the callbacks and publishes
+        runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: TemplateLinuxNAPI,
+            linux: run => ({features: ["trace"], main: path.join(__dirname, "napi_user.js"), args: ["--trace", path.join(run.buildPath, "budget"), "--trace-threshold", "1"]}),
+            ar: {template: "c-static", user: path.join(__dirname, "e2e_user.c"), args: ["--cycles", "600", "--tc1", "5000"]},
+            check: run => {
+                let dumps = fs.readdirSync(run.buildPath).filter(file => /^budget\.\d+\.json$/.test(file));
+                let events = dumps.flatMap(file => JSON.parse(fs.readFileSync(path.join(run.buildPath, file), "utf8")).traceEvents);
+                assert.ok(dumps.length > 0, "no dump written");
+                assert.ok(events.some(event => event.name == "process" && event.ph == "B"));
+                assert.ok(events.some(event => event.name == "Status" && event.cat == "received" && event.ph == "i"));
+                assert.ok(events.some(event => event.name == "Status" && event.cat == "callback" && event.ph == "E"));
+                assert.ok(events.some(event => event.name == "Commands" && event.cat == "publish" && event.ph == "E"));
+            }
+        }, done);
+    });
+
+    test('Linux load generator against a responding application', function(done) {
+        if (!hasCompiler()) {
+            this.skip();
+        }
+        this.timeout(0);
+
+        // the application answers every Setpoints with Commands (loadgen_responder.c), the load generator takes the
+        // place of AR, publishes Setpoints, Samples and Config, and validates the Commands against the budget
+        let options = ["--warmup", "500", "--rate", "0", "--rate", "Setpoints=50", "--rate", "Samples=20", "--burst", "Samples=5@200", "--dist", "Samples=sine",
+            "--rate", "Config=10", "--mutate", "Config=0.5", "--trigger", "Setpoints", "--expect", "Commands"];
+        let load, tight;
+        runHostTest({typFile: typFile, typeName: "Budget", LinuxTemplate: TemplateLinuxStaticCLib,
+            linux: {features: ["loadgen"], main: path.join(__dirname, "loadgen_responder.c")},
+            drive: run => {
+                let loadgen = path.join(run.buildPath, "linux", "budget_loadgen");
+                load = child_process.spawnSync(loadgen, ["--duration", "2", ...options, "--budget", "100000", "--percentile", "95"], {encoding: "utf8", env: run.env});
+                tight = child_process.spawnSync(loadgen, ["--duration", "1", ...options, "--budget", "1"], {encoding: "utf8", env: run.env});
+                run.stop();
+            },
+            check: run => {
+                assert.equal(load.status, 0, load.stdout + load.stderr);
+                assert.match(load.stdout, /Setpoints\s+[1-9]\d* publishes/);
+                assert.match(load.stdout, /Samples\s+[1-9]\d* publishes .*, [1-9]\d* bursts, 0 errors \(no trigger\)/);
+                assert.match(load.stdout, /Commands\s+[1-9]\d* received .*, [1-9]\d* responses to [1-9]\d* requests/);
+                assert.match(load.stdout, /latency us: min \d+ avg \d+ p50 \d+ p99 \d+ max \d+: ok/);
+                assert.match(load.stdout, /result: PASS/);
+                // no response is within 1 us
+                assert.equal(tight.status, 1, tight.stdout + tight.stderr);
+                assert.match(tight.stdout, /result: FAIL/);
+                assert.match(run.stdout, /responder: [1-9]\d* responses/);
+            }
+        }, done);
+    });
+});
@@ -0,0 +1,247 @@
+/* Host emulation of the AR task classes for running generated AR programs as Linux processes
+
+   The programs in ar_host_programs[] (generated by ar_host.js) are initialized, run cyclically in their
+   task class and exited on Ctrl-C, SIGTERM or after --cycles. The task classes are scheduled in one thread
+   in order of their next start, a faster task class does not preempt a running slower one.
+
+    --tc<n> <us>        cycle time of task class n (default: 10, 200, 500, 1000, 2000, 3000, 4000, 5000 ms)
+    --tolerance <us>    a cycle time violation stops the emulation if a cycle exceeds its cycle time by
+                        more than this (default: one cycle time), as AR does by entering service mode
+    --task-class <n>    run all programs in task class n (default: as generated, 1)
+    --cycles <n>        exit after n cycles of the fastest task class (default: 0, until Ctrl-C or SIGTERM)
+
+   A cycle longer than its cycle time is counted as overrun, and the starts it delays as missed cycles.
+   The execution time and start latency of each task class are printed at exit. The exit code is 2
+   after a cycle time violation.
+
+   The datasets are exchanged through the DMR stand-in (dmr_host.c) in non-blocking mode, as on AR.
+   TMP_alloc() and TMP_free() of the AR system library are provided here, and the _EXIT function of the
+   library (ProgramExit) is called after the programs have exited. */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <bur/plctypes.h>
+#include "exos_api.h"
+#include "ar_host.h"
+
+extern EXOS_DATAMODEL_PROCESS_MODE dmr_host_default_mode;
+
+typedef struct
+{
+    int64_t cycle_time; /* ns */
+    int64_t next;       /* start of the next cycle, CLOCK_MONOTONIC ns */
+    uint64_t cycles;
+    uint64_t overruns;
+    uint64_t missed;
+    int64_t exec_min;
+    int64_t exec_max;
+    int64_t exec_sum;
+    int64_t latency_max;
+    bool used;
+} task_class_t;
+
+static task_class_t task_class[AR_HOST_TASK_CLASSES];
+static volatile sig_atomic_t terminated = 0;
+
+static void handle_signal(int signal)
+{
+    terminated = 1;
+}
+
+static int64_t clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static const char *get_argument(int argc, char **argv, const char *name)
+{
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (0 == strcmp(argv[i], name))
+            return argv[i + 1];
+    }
+    return NULL;
+}
+
+/* exit function of the library, called by AR when the library is unloaded */
+__attribute__((weak)) UINT ProgramExit(unsigned long phase);
+
+__attribute__((weak)) void ar_host_user_cyclic(const char *program, void *data, uint64_t cycle)
+{
+}
+
+UINT TMP_alloc(UDINT size, void **memory)
+{
+    *memory = calloc(1, size);
+    return NULL == *memory;
+}
+
+UINT TMP_free(UDINT size, void *memory)
+{
+    free(memory);
+    return 0;
+}
+
+static void print_statistics(void)
+{
+    for (int c = 0; c < AR_HOST_TASK_CLASSES; c++)
+    {
+        task_class_t *tc = &task_class[c];
+        if (!tc->used || 0 == tc->cycles)
+            continue;
+
+        printf("ar: task class %d (%lld us): %llu cycles, %llu overruns, %llu missed, execution (us) min %lld avg %lld max %lld, start latency (us) max %lld\n",
+               c + 1, (long long)(tc->cycle_time / 1000), (unsigned long long)tc->cycles, (unsigned long long)tc->overruns,
+               (unsigned long long)tc->missed, (long long)(tc->exec_min / 1000), (long long)(tc->exec_sum / (int64_t)tc->cycles / 1000),
+               (long long)(tc->exec_max / 1000), (long long)(tc->latency_max / 1000));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static const int64_t default_cycle_ms[AR_HOST_TASK_CLASSES] = {10, 200, 500, 1000, 2000, 3000, 4000, 5000};
+    const char *tolerance_arg = get_argument(argc, argv, "--tolerance");
+    const char *task_class_arg = get_argument(argc, argv, "--task-class");
+    const char *cycles_arg = get_argument(argc, argv, "--cycles");
+    uint64_t cycles = NULL != cycles_arg ? strtoull(cycles_arg, NULL, 0) : 0;
+    int fastest = -1;
+    int violation = 0;
+    struct sigaction action;
+    int64_t start;
+
+    for (int c = 0; c < AR_HOST_TASK_CLASSES; c++)
+    {
+        char name[16];
+        const char *cycle_arg;
+
+        snprintf(name, sizeof(name), "--tc%d", c + 1);
+        cycle_arg = get_argument(argc, argv, name);
+        task_class[c].cycle_time = (NULL != cycle_arg ? strtoll(cycle_arg, NULL, 0) : default_cycle_ms[c] * 1000) * 1000;
+        if (task_class[c].cycle_time <= 0)
+        {
+            fprintf(stderr, "ar: invalid cycle time of task class %d\n", c + 1);
+            return 1;
+        }
+    }
+
+    for (size_t p = 0; p < ar_host_program_count; p++)
+    {
+        int c = (NULL != task_class_arg ? atoi(task_class_arg) : ar_host_programs[p].task_class) - 1;
+        if (c < 0 || c >= AR_HOST_TASK_CLASSES)
+        {
+            fprintf(stderr, "ar: invalid task class of %s\n", ar_host_programs[p].name);
+            return 1;
+        }
+        task_class[c].used = true;
+        if (fastest < 0 || task_class[c].cycle_time < task_class[fastest].cycle_time)
+            fastest = c;
+    }
+    if (fastest < 0)
+    {
+        fprintf(stderr, "ar: no programs\n");
+        return 1;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    // the exOS API is non-blocking on AR
+    dmr_host_default_mode = EXOS_DATAMODEL_PROCESS_NON_BLOCKING;
+
+    for (size_t p = 0; p < ar_host_program_count; p++)
+    {
+        if (NULL != ar_host_programs[p].init)
+            ar_host_programs[p].init();
+    }
+
+    start = clock_ns();
+    for (int c = 0; c < AR_HOST_TASK_CLASSES; c++)
+    {
+        task_class[c].next = start;
+        task_class[c].exec_min = INT64_MAX;
+    }
+
+    while (!terminated && (0 == cycles || task_class[fastest].cycles < cycles))
+    {
+        task_class_t *tc = NULL;
+        struct timespec ts;
+        int64_t begin, end, exec;
+        int c = 0;
+
+        // the task class that starts next, the faster one first at the same time
+        for (int i = 0; i < AR_HOST_TASK_CLASSES; i++)
+        {
+            if (task_class[i].used && (NULL == tc || task_class[i].next < tc->next))
+            {
+                tc = &task_class[i];
+                c = i;
+            }
+        }
+
+        ts.tv_sec = tc->next / 1000000000;
+        ts.tv_nsec = tc->next % 1000000000;
+        if (0 != clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL))
+            continue;
+
+        begin = clock_ns();
+        for (size_t p = 0; p < ar_host_program_count; p++)
+        {
+            int program_class = (NULL != task_class_arg ? atoi(task_class_arg) : ar_host_programs[p].task_class) - 1;
+            if (program_class == c)
+                ar_host_programs[p].cyclic();
+        }
+        end = clock_ns();
+
+        exec = end - begin;
+        tc->cycles++;
+        tc->exec_sum += exec;
+        if (exec < tc->exec_min)
+            tc->exec_min = exec;
+        if (exec > tc->exec_max)
+            tc->exec_max = exec;
+        if (begin - tc->next > tc->latency_max)
+            tc->latency_max = begin - tc->next;
+
+        if (exec > tc->cycle_time)
+        {
+            int64_t tolerance = NULL != tolerance_arg ? strtoll(tolerance_arg, NULL, 0) * 1000 : tc->cycle_time;
+
+            tc->overruns++;
+            if (exec > tc->cycle_time + tolerance)
+            {
+                fprintf(stderr, "ar: cycle time violation in task class %d: %lld us (cycle time %lld us, tolerance %lld us)\n",
+                        c + 1, (long long)(exec / 1000), (long long)(tc->cycle_time / 1000), (long long)(tolerance / 1000));
+                violation = 1;
+                break;
+            }
+        }
+
+        // the starts that passed meanwhile are missed
+        tc->next += tc->cycle_time;
+        if (tc->next < end)
+        {
+            int64_t missed = (end - tc->next) / tc->cycle_time + 1;
+            tc->missed += (uint64_t)missed;
+            tc->next += missed * tc->cycle_time;
+        }
+    }
+
+    for (size_t p = 0; p < ar_host_program_count; p++)
+    {
+        if (NULL != ar_host_programs[p].exit)
+            ar_host_programs[p].exit();
+    }
+    if (NULL != ProgramExit)
+        ProgramExit(0);
+
+    print_statistics();
+    return violation ? 2 : 0;
+}
@@ -0,0 +1,29 @@
+/* Host emulation of the AR task classes for running generated AR programs as Linux processes, see ar_host.c */
+
+#ifndef _AR_HOST_H_
+#define _AR_HOST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define AR_HOST_TASK_CLASSES 8
+
+/* a program (the _INIT, _CYCLIC and _EXIT of an AR task) in a task class 1..AR_HOST_TASK_CLASSES */
+typedef struct
+{
+    const char *name;
+    int task_class;
+    void (*init)(void);
+    void (*cyclic)(void);
+    void (*exit)(void);
+} ar_host_program_t;
+
+/* the programs of the executable, generated by ar_host.js from the .fun of the AR library */
+extern const ar_host_program_t ar_host_programs[];
+extern const size_t ar_host_program_count;
+
+/* application code of a program, called before its function blocks in each cycle with the
+   datamodel structure of the program (the variable passed to pXxx). Does nothing unless defined */
+void ar_host_user_cyclic(const char *program, void *data, uint64_t cycle);
+
+#endif // _AR_HOST_H_
@@ -0,0 +1,411 @@
+/*
+ * Builds generated AR templates as Linux executables, run by the task class emulation in ar_host.c and
+ * exchanging their datasets through the DMR stand-in in dmr_host.c, e.g. to profile them with perf:
+ *
+ *    node test/suite/ar_host/ar_host.js <file.typ> <typeName> <c-api|c-static|cpp> <buildPath> [user.c]
+ *    perf record <buildPath>/ar_host --tc1 1000
+ *
+ * The header Automation Studio generates from the .fun of the library is generated by funHeader(), and the
+ * program calling the function blocks (the generated .st) by programSource(). Application code for the
+ * program can be given as user.c, implementing ar_host_user_cyclic() of ar_host.h.
+ * Linux templates are built against the same DMR stand-in by buildLinux(), to run both sides end to end, which
+ * runHostTest() does for the tests in a temporary directory with its own DMR stand-in.
+ */
+
+const path = require('path');
+const os = require('os');
+const fs = require('fs');
+const child_process = require('child_process');
+const { Datamodel, GeneratedFileObj } = require('../../../src/datamodel');
+const { TemplateARDynamic } = require('../../../src/components/templates/ar/template_ar_dynamic');
+const { TemplateARStaticCLib } = require('../../../src/components/templates/ar/template_ar_static_c_lib');
+const { TemplateARCpp } = require('../../../src/components/templates/ar/template_ar_cpp');
+const { TemplateLinuxLoadgen } = require('../../../src/components/templates/linux/template_linux_loadgen');
+
+const stubPath = path.resolve(__dirname, 'stub');
+
+/**
+ * @typedef {Object} FunctionBlock
+ * @property {string} name
+ * @property {{name: string, type: string, reference: boolean}[]} members inputs, outputs and internal variables, in declaration order
+ */
+
+/**
+ * @param {string} contents of a .fun file
+ * @returns {FunctionBlock[]}
+ */
+function parseFun(contents) {
+    let blocks = [];
+    let text = contents.replace(/\(\*[\s\S]*?\*\)/g, "");
+    for (let block of text.matchAll(/FUNCTION_BLOCK\s+(\w+)([\s\S]*?)END_FUNCTION_BLOCK/g)) {
+        let members = [];
+        for (let section of block[2].matchAll(/\b(?:VAR_INPUT|VAR_OUTPUT|VAR)\b([\s\S]*?)\bEND_VAR\b/g)) {
+            for (let declaration of section[1].split(";")) {
+                let member = declaration.match(/^\s*(\w+)\s*:\s*(REFERENCE\s+TO\s+)?(\w+)\s*$/);
+                if (member) {
+                    members.push({name: member[1], type: member[3], reference: member[2] !== undefined});
+                }
+            }
+        }
+        blocks.push({name: block[1], members: members});
+    }
+    return blocks;
+}
+
+/**
+ * @param {string} libraryName
+ * @param {FunctionBlock[]} blocks
+ * @param {string} typeHeaderName header declaring the types of the datamodel
+ * @returns {string} `{libraryName}.h` as generated by Automation Studio for the library
+ */
+function funHeader(libraryName, blocks, typeHeaderName) {
+    let out = "";
+
+    out += `/* Generated by ar_host.js: host version of the header Automation Studio generates from ${libraryName}.fun */\n`;
+    out += `\n`;
+    out += `#ifndef _${libraryName.toUpperCase()}_H_\n`;
+    out += `#define _${libraryName.toUpperCase()}_H_\n`;
+    out += `\n`;
+    out += `#include <bur/plctypes.h>\n`;
+    out += `\n`;
+    out += `#ifdef __cplusplus\n`;
+    out += `extern "C" {\n`;
+    out += `#endif\n`;
+    out += `\n`;
+    out += `#include "${typeHeaderName}"\n`;
+    out += `\n`;
+    for (let block of blocks) {
+        out += `struct ${block.name}\n`;
+        out += `{\n`;
+        for (let member of block.members) {
+            out += member.reference ? `    struct ${member.type} *${member.name};\n` : `    ${member.type} ${member.name};\n`;
+        }
+        out += `};\n`;
+        out += `\n`;
+    }
+    for (let block of blocks) {
+        out += `_BUR_PUBLIC void ${block.name}(struct ${block.name} *inst);\n`;
+    }
+    out += `\n`;
+    out += `UINT TMP_alloc(UDINT size, void **memory);\n`;
+    out += `UINT TMP_free(UDINT size, void *memory);\n`;
+    out += `\n`;
+    out += `#ifdef __cplusplus\n`;
+    out += `}\n`;
+    out += `#endif\n`;
+    out += `\n`;
+    out += `#endif // _${libraryName.toUpperCase()}_H_\n`;
+
+    return out;
+}
+
+/**
+ * The program of the generated .st in C: `<type>Init` in _INIT, `<type>Cyclic` enabled and started in _CYCLIC
+ * with the handle of the init function block and the datamodel structure, `<type>Exit` in _EXIT
+ *
+ * @param {string} libraryName
+ * @param {FunctionBlock[]} blocks
+ * @param {string} structName datamodel structure
+ * @param {number} taskClass
+ * @returns {string} `ar_program.c`
+ */
+function programSource(libraryName, blocks, structName, taskClass) {
+    let init = blocks.find(block => block.name.endsWith("Init"));
+    let cyclic = blocks.find(block => block.name.endsWith("Cyclic"));
+    let exit = blocks.find(block => block.name.endsWith("Exit"));
+    let program = `${structName}_0`;
+    let has = (block, member) => block.members.some(m => m.name == member);
+    let out = "";
+
+    out += `/* Generated by ar_host.js: the program of ${structName}.st, run by ar_host.c in task class ${taskClass} */\n`;
+    out += `\n`;
+    out += `#include <${libraryName}.h>\n`;
+    out += `#include "ar_host.h"\n`;
+    out += `\n`;
+    for (let block of [init, cyclic, exit].filter(block => block !== undefined)) {
+        out += `static struct ${block.name} ${block.name}_0;\n`;
+    }
+    out += `static ${structName} ${program};\n`;
+    out += `static uint64_t cycle = 0;\n`;
+    out += `\n`;
+    out += `static void program_init(void)\n`;
+    out += `{\n`;
+    if (init !== undefined) {
+        out += `    ${init.name}(&${init.name}_0);\n`;
+    }
+    out += `}\n`;
+    out += `\n`;
+    out += `static void program_cyclic(void)\n`;
+    out += `{\n`;
+    out += `    ar_host_user_cyclic("${program}", &${program}, cycle++);\n`;
+    out += `\n`;
+    for (let member of ["Enable", "Start"]) {
+        if (has(cyclic, member)) {
+            out += `    ${cyclic.name}_0.${member} = 1;\n`;
+        }
+    }
+    if (init !== undefined && has(cyclic, "Handle")) {
+        out += `    ${cyclic.name}_0.Handle = ${init.name}_0.Handle;\n`;
+    }
+    out += `    ${cyclic.name}_0.p${structName} = &${program};\n`;
+    out += `    ${cyclic.name}(&${cyclic.name}_0);\n`;
+    out += `}\n`;
+    out += `\n`;
+    out += `static void program_exit(void)\n`;
+    out += `{\n`;
+    if (exit !== undefined) {
+        if (init !== undefined && has(exit, "Handle")) {
+            out += `    ${exit.name}_0.Handle = ${init.name}_0.Handle;\n`;
+        }
+        out += `    ${exit.name}(&${exit.name}_0);\n`;
+    }
+    else if (has(cyclic, "Enable")) {
+        out += `    // disabling the function block disconnects\n`;
+        out += `    ${cyclic.name}_0.Enable = 0;\n`;
+        out += `    ${cyclic.name}(&${cyclic.name}_0);\n`;
+    }
+    out += `}\n`;
+    out += `\n`;
+    out += `const ar_host_program_t ar_host_programs[] = {{"${program}", ${taskClass}, program_init, program_cyclic, program_exit}};\n`;
+    out += `const size_t ar_host_program_count = 1;\n`;
+
+    return out;
+}
+
+/**
+ * @param {Object} object template or datamodel
+ * @returns {GeneratedFileObj[]} the generated files of the object and its members (e.g. `heap`)
+ */
+function generatedFiles(object) {
+    let files = [];
+    for (let value of Object.values(object)) {
+        if (value !== null && typeof value == "object") {
+            if (typeof value.name == "string" && typeof value.contents == "string") {
+                files.push(value);
+            }
+            else if (!Array.isArray(value) && value.constructor !== Object) {
+                files.push(...generatedFiles(value));
+            }
+        }
+    }
+    return files;
+}
+
+/**
+ * @param {GeneratedFileObj[]} files
+ * @param {string} buildPath
+ * @param {string[]} extraSources additional C sources
+ * @param {string} executable
+ * @param {string} [include] header included ahead of the generated sources, as Automation Studio does with the library header
+ * @param {string[]} [defines] preprocessor definitions, e.g. `NAME=value`
+ * @param {string[]} [flags] additional compiler and linker flags, e.g. `-fPIC` and `-shared` for a shared library
+ */
+function compile(files, buildPath, extraSources, executable, include, defines = [], flags = []) {
+    let objects = [];
+    let hasCpp = false;
+
+    for (let file of files) {
+        fs.writeFileSync(path.join(buildPath, file.name), file.contents);
+    }
+    let sources = files.map(file => path.join(buildPath, file.name)).filter(name => /\.(c|cpp)$/.test(name));
+    for (let source of [...new Set(sources), ...extraSources]) {
+        let cpp = source.endsWith(".cpp");
+        let object = path.join(buildPath, path.basename(source) + ".o");
+        let includes = include !== undefined && !extraSources.includes(source) ? ["-include", include] : [];
+        let build = child_process.spawnSync(cpp ? "c++" : "cc", [cpp ? "-std=c++17" : "-std=gnu99", "-O2", "-g", "-Wall", "-Wno-unused-variable",
+            `-I${stubPath}`, `-I${__dirname}`, `-I${buildPath}`, ...defines.map(define => `-D${define}`), ...flags, ...includes, "-c", source, "-o", object], {encoding: "utf8"});
+        if (build.status !== 0) {
+            throw new Error(`compiling ${source} failed:\n${build.stderr}`);
+        }
+        objects.push(object);
+        hasCpp = hasCpp || cpp;
+    }
+    let link = child_process.spawnSync(hasCpp ? "c++" : "cc", [...flags, ...objects, "-o", executable, "-lrt", "-lm"], {encoding: "utf8"});
+    if (link.status !== 0) {
+        throw new Error(`linking ${executable} failed:\n${link.stderr}`);
+    }
+}
+
+/**
+ * Builds the AR template of the datamodel with ar_host.c and dmr_host.c as `<buildPath>/ar_host`
+ *
+ * @param {string} typFile
+ * @param {string} typeName
+ * @param {string} templateAR `c-api`, `c-static` or `cpp`
+ * @param {string} buildPath existing directory
+ * @param {Object} [options]
+ * @param {string} [options.user] C source implementing ar_host_user_cyclic()
+ * @param {number} [options.taskClass] task class of the program (default 1)
+ * @param {string[]} [options.features] template features, e.g. `budget`
+ * @returns {string} executable
+ */
+function buildAR(typFile, typeName, templateAR, buildPath, options = {}) {
+    let datamodel = new Datamodel(typFile, typeName, [typeName]);
+    let template;
+    switch (templateAR) {
+        case "c-api":
+            template = new TemplateARDynamic(datamodel, options.features);
+            break;
+        case "c-static":
+            template = new TemplateARStaticCLib(datamodel);
+            break;
+        case "cpp":
+            template = new TemplateARCpp(datamodel);
+            break;
+        default:
+            throw new Error(`unknown AR template ${templateAR}`);
+    }
+
+    let libraryName = template.libraryFun.name.replace(".fun", "");
+    let blocks = parseFun(template.libraryFun.contents);
+    let files = [...generatedFiles(datamodel), ...generatedFiles(template)];
+    files.push({name: `${libraryName}.h`, contents: funHeader(libraryName, blocks, datamodel.headerFile.name), description: "function blocks"});
+    files.push({name: "ar_program.c", contents: programSource(libraryName, blocks, template.template.datamodel.structName, options.taskClass || 1), description: "program"});
+
+    let extraSources = [path.join(__dirname, "ar_host.c"), path.join(__dirname, "dmr_host.c")];
+    if (options.user !== undefined) {
+        extraSources.push(path.resolve(options.user));
+    }
+    let executable = path.join(buildPath, "ar_host");
+    compile(files, buildPath, extraSources, executable, `${libraryName}.h`);
+    return executable;
+}
+
+/**
+ * Builds a Linux template of the datamodel with dmr_host.c as `<buildPath>/<typename>`, and with the `loadgen` feature
+ * its load generator as `<buildPath>/<typename>_loadgen`. The N-API template is built as module `l_<TypeName>.node`
+ * next to its main script, and `<buildPath>/<typename>` is a shell script starting the main script with node
+ *
+ * @param {string} typFile
+ * @param {string} typeName
+ * @param {Object} LinuxTemplate template class, e.g. `TemplateLinuxStaticCLib`
+ * @param {string} buildPath existing directory
+ * @param {Object} [options]
+ * @param {string[]} [options.features] template features, e.g. `gateway`
+ * @param {string[]} [options.defines] preprocessor definitions, e.g. `EXOS_BUDGET_MIRROR_NAME="/name"`
+ * @param {string} [options.reader] C source of a separate program using the generated headers, built as `<buildPath>/reader`
+ * @param {string} [options.main] C source replacing the generated main of the application (JavaScript with N-API)
+ * @returns {string} executable
+ */
+function buildLinux(typFile, typeName, LinuxTemplate, buildPath, options = {}) {
+    let datamodel = new Datamodel(typFile, typeName, [typeName]);
+    let template = new LinuxTemplate(datamodel, options.features);
+    if (template.JsMain !== undefined) {
+        let nodeInclude = path.resolve(path.dirname(process.execPath), "../include/node");
+        let addon = `l_${typeName}`;
+        let executable = path.join(buildPath, typeName.toLowerCase());
+        compile([...generatedFiles(datamodel), ...generatedFiles(template)], buildPath, [path.join(__dirname, "dmr_host.c")], path.join(buildPath, `${addon}.node`), undefined,
+            [...(options.defines || []), `NODE_GYP_MODULE_NAME=${addon}`], ["-fPIC", "-shared", `-I${nodeInclude}`]);
+        if (options.main !== undefined) {
+            fs.copyFileSync(path.resolve(options.main), path.join(buildPath, template.JsMain.name));
+        }
+        fs.writeFileSync(executable, `#!/bin/sh\nexec "${process.execPath}" "${path.join(buildPath, template.JsMain.name)}" "$@"\n`, {mode: 0o755});
+        return executable;
+    }
+    let loadgenSource = template.loadgen !== undefined ? template.loadgen.loadgenSource : undefined;
+    let files = [...generatedFiles(datamodel), ...generatedFiles(template)].filter(file => file !== loadgenSource && (options.main === undefined || file !== template.mainSource));
+    let extraSources = [path.join(__dirname, "dmr_host.c")];
+    if (options.main !== undefined) {
+        extraSources.push(path.resolve(options.main));
+    }
+    let executable = path.join(buildPath, typeName.toLowerCase());
+    compile(files, buildPath, extraSources, executable, undefined, options.defines);
+    if (loadgenSource !== undefined) {
+        compile([...generatedFiles(datamodel), loadgenSource], buildPath, [path.join(__dirname, "dmr_host.c")], path.join(buildPath, TemplateLinuxLoadgen.executableName(datamodel)), undefined, options.defines);
+    }
+    if (options.reader !== undefined) {
+        compile([], buildPath, [path.resolve(options.reader)], path.join(buildPath, "reader"), undefined, options.defines);
+    }
+    return executable;
+}
+
+/**
+ * @typedef {Object} HostRun
+ * @property {string} buildPath temporary directory, with the application built in `linux` and the AR program in `ar`
+ * @property {string} dmr name of the shared memory of the DMR stand-in
+ * @property {Object} env environment of the application and the AR program
+ * @property {string} linux executable of the application
+ * @property {string} [ar] executable of the AR program
+ * @property {string} stdout output of the application
+ * @property {string} arOutput output of the AR program started with `runAR()`
+ * @property {number} arStatus exit code of the AR program started with `runAR()`
+ * @property {function(): child_process.ChildProcess} runAR starts the AR program, and stops the application when it exits
+ * @property {function(): void} stop terminates the application
+ */
+
+/**
+ * Builds and runs a Linux template of the datamodel against the AR program (or what `drive` runs instead), in a
+ * temporary directory and with a DMR stand-in of its own, which are removed when the application exited
+ *
+ * @param {Object} test
+ * @param {string} test.typFile
+ * @param {string} test.typeName
+ * @param {Object} test.LinuxTemplate template class of the application, e.g. `TemplateLinuxStaticCLib`
+ * @param {Object|function(HostRun): Object} [test.linux] options of buildLinux(), and the `args` of the application
+ * @param {Object|function(HostRun): Object} [test.ar] options of buildAR(), the AR `template` and the `args` of the program. default: no AR program
+ * @param {function(HostRun): void} [test.drive] runs once the application started, and stops it. default: `runAR()`
+ * @param {function(HostRun): void} test.check assertions once the application exited
+ * @param {function(Error=): void} done callback of the test
+ */
+function runHostTest(test, done) {
+    let buildPath = fs.mkdtempSync(path.join(os.tmpdir(), "exos-ar-host-"));
+    let dmr = path.basename(buildPath);
+    let run = {buildPath: buildPath, dmr: dmr, env: {...process.env, EXOS_HOST_DMR: dmr}, stdout: "", arOutput: ""};
+    let cleanup = () => {
+        fs.rmSync(buildPath, {recursive: true, force: true});
+        fs.rmSync(path.join("/dev/shm", dmr), {force: true});
+    };
+    let linuxOptions = typeof test.linux == "function" ? test.linux(run) : (test.linux || {});
+    let arOptions = typeof test.ar == "function" ? test.ar(run) : test.ar;
+
+    try {
+        fs.mkdirSync(path.join(buildPath, "linux"));
+        run.linux = buildLinux(test.typFile, test.typeName, test.LinuxTemplate, path.join(buildPath, "linux"), linuxOptions);
+        if (arOptions !== undefined) {
+            fs.mkdirSync(path.join(buildPath, "ar"));
+            run.ar = buildAR(test.typFile, test.typeName, arOptions.template, path.join(buildPath, "ar"), arOptions);
+        }
+    }
+    catch (error) {
+        cleanup();
+        throw error;
+    }
+
+    let application = child_process.spawn(run.linux, linuxOptions.args || [], {env: run.env});
+    application.stdout.on("data", data => run.stdout += data);
+    run.stop = () => application.kill("SIGTERM");
+    run.runAR = () => {
+        let program = child_process.spawn(run.ar, arOptions.args || [], {env: run.env});
+        program.stdout.on("data", data => run.arOutput += data);
+        program.on("exit", code => {
+            run.arStatus = code;
+            run.stop();
+        });
+        return program;
+    };
+    application.on("exit", () => {
+        try {
+            test.check(run);
+            cleanup();
+            done();
+        }
+        catch (error) {
+            cleanup();
+            done(error);
+        }
+    });
+
+    (test.drive || (run => run.runAR()))(run);
+}
+
+if (require.main === module) {
+    let args = process.argv.slice(2);
+    if (args.length < 4) {
+        console.error("usage: node ar_host.js <file.typ> <typeName> <c-api|c-static|cpp> <buildPath> [user.c]");
+        process.exit(1);
+    }
+    fs.mkdirSync(args[3], {recursive: true});
+    console.log(buildAR(args[0], args[1], args[2], args[3], {user: args[4]}));
+}
+
+module.exports = {parseFun, funHeader, programSource, generatedFiles, compile, buildAR, buildLinux, runHostTest};
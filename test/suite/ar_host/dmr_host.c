@@ -0,0 +1,480 @@
+/* Host stand-in for the DMR, implementing the exOS API (stub/exos_api.h) for generated AR and Linux sources
+
+   Each datamodel instance is a POSIX shared memory object (/exos-host-<instance>, or the name in the
+   environment variable EXOS_HOST_DMR) shared by all processes on the host using the datamodel. A dataset
+   has a slot with its last published value, protected by a sequence number (odd while it is written).
+   exos_datamodel_process() delivers the slots that changed since the last process() and were published
+   by another process, so an AR program run by ar_host and a Linux application exchange their datasets.
+
+   There is no connection handshake: a datamodel is connected by exos_datamodel_connect() and operational
+   after exos_datamodel_set_operational(). In blocking mode (default, as on Linux) process() waits for the
+   next DMR cycle of EXOS_HOST_DMR_CYCLE us (default 1000), ar_host switches to non-blocking mode (as on AR).
+   The nettime is CLOCK_MONOTONIC in us, the same in all processes.
+   The published and received datasets are printed per process when the datamodel is deleted. */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include "exos_api.h"
+#include "exos_log.h"
+
+#define DMR_HOST_MAGIC "EXOSDMR1"
+#define DMR_HOST_MAX_DATASETS 64
+#define DMR_HOST_MAX_NAME 64
+#define DMR_HOST_DATA_SIZE (4 * 1024 * 1024)
+
+typedef struct
+{
+    char name[DMR_HOST_MAX_NAME];
+    uint32_t size;
+    uint32_t offset;   /* of the value in data[] */
+    uint64_t sequence; /* odd while the value is written */
+    int32_t nettime;   /* of the last publish */
+    int32_t writer;    /* pid of the last publisher */
+} dmr_host_slot_t;
+
+typedef struct
+{
+    char magic[8];
+    uint32_t slots;
+    uint32_t used; /* bytes of data[] */
+    dmr_host_slot_t slot[DMR_HOST_MAX_DATASETS];
+    uint8_t data[DMR_HOST_DATA_SIZE];
+} dmr_host_shm_t;
+
+typedef struct
+{
+    int fd;
+    dmr_host_shm_t *shm;
+    EXOS_DATAMODEL_PROCESS_MODE mode;
+    int64_t next_cycle;
+} dmr_host_datamodel_t;
+
+typedef struct
+{
+    dmr_host_slot_t *slot;
+    uint64_t sequence; /* last delivered */
+    uint32_t published;
+    uint32_t received;
+} dmr_host_dataset_t;
+
+EXOS_DATAMODEL_PROCESS_MODE dmr_host_default_mode = EXOS_DATAMODEL_PROCESS_BLOCKING;
+
+/* the datasets are kept in a list per process, so that process() can find the subscriptions of the datamodel */
+static exos_dataset_handle_t *datasets[DMR_HOST_MAX_DATASETS * 4];
+static size_t dataset_count = 0;
+
+/* print the statistics of the dataset and remove it from the list */
+static void release_dataset(size_t index)
+{
+    exos_dataset_handle_t *dataset = datasets[index];
+    dmr_host_dataset_t *state = dataset->_private;
+
+    printf("dmr: %s %s published %u received %u\n", NULL != dataset->datamodel->user_alias ? dataset->datamodel->user_alias : "",
+           dataset->name, state->published, state->received);
+    free(state);
+    dataset->_private = NULL;
+    datasets[index] = datasets[--dataset_count];
+}
+
+static int64_t monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int64_t dmr_cycle_us(void)
+{
+    const char *cycle = getenv("EXOS_HOST_DMR_CYCLE");
+    int64_t us = NULL != cycle ? strtoll(cycle, NULL, 0) : 0;
+    return us > 0 ? us : 1000;
+}
+
+const char *exos_get_error_string(EXOS_ERROR_CODE error)
+{
+    switch (error)
+    {
+    case EXOS_ERROR_OK:
+        return "EXOS_ERROR_OK";
+    case EXOS_ERROR_BAD_DATASET_SIZE:
+        return "EXOS_ERROR_BAD_DATASET_SIZE";
+    case EXOS_ERROR_BAD_STATE:
+        return "EXOS_ERROR_BAD_STATE";
+    case EXOS_ERROR_BUFFER_OVERFLOW:
+        return "EXOS_ERROR_BUFFER_OVERFLOW";
+    case EXOS_ERROR_SYSTEM:
+        return "EXOS_ERROR_SYSTEM";
+    default:
+        return "EXOS_ERROR";
+    }
+}
+
+const char *exos_get_state_string(EXOS_CONNECTION_STATE state)
+{
+    switch (state)
+    {
+    case EXOS_STATE_DISCONNECTED:
+        return "EXOS_STATE_DISCONNECTED";
+    case EXOS_STATE_CONNECTED:
+        return "EXOS_STATE_CONNECTED";
+    case EXOS_STATE_OPERATIONAL:
+        return "EXOS_STATE_OPERATIONAL";
+    default:
+        return "EXOS_STATE_ABORTED";
+    }
+}
+
+EXOS_ERROR_CODE exos_datamodel_init(exos_datamodel_handle_t *datamodel, const char *datamodel_instance_name, const char *user_alias)
+{
+    dmr_host_datamodel_t *host = calloc(1, sizeof(dmr_host_datamodel_t));
+    if (NULL == host)
+        return EXOS_ERROR_SYSTEM;
+
+    memset(datamodel, 0, sizeof(*datamodel));
+    datamodel->name = (char *)datamodel_instance_name;
+    datamodel->user_alias = (char *)user_alias;
+    host->fd = -1;
+    host->mode = dmr_host_default_mode;
+    datamodel->sync_info.process_mode = host->mode;
+    datamodel->_private = host;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_connect(exos_datamodel_handle_t *datamodel, const char *config, const exos_dataset_info_t *info, size_t info_size, exos_datamodel_event_cb datamodel_event_callback)
+{
+    dmr_host_datamodel_t *host = datamodel->_private;
+    const char *env = getenv("EXOS_HOST_DMR");
+    char name[256];
+    void *map;
+
+    if (NULL == host)
+        return EXOS_ERROR_BAD_DATAMODEL_HANDLE;
+
+    if (NULL != env)
+        snprintf(name, sizeof(name), "/%s", env);
+    else
+        snprintf(name, sizeof(name), "/exos-host-%s", datamodel->name);
+
+    host->fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+    if (host->fd < 0 || 0 != ftruncate(host->fd, sizeof(dmr_host_shm_t)))
+    {
+        perror("dmr: shm_open failed");
+        return EXOS_ERROR_SYSTEM;
+    }
+    map = mmap(NULL, sizeof(dmr_host_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, host->fd, 0);
+    if (MAP_FAILED == map)
+    {
+        perror("dmr: mmap failed");
+        return EXOS_ERROR_SYSTEM;
+    }
+    host->shm = map;
+
+    flock(host->fd, LOCK_EX);
+    if (0 != memcmp(host->shm->magic, DMR_HOST_MAGIC, sizeof(host->shm->magic)))
+    {
+        memset(host->shm, 0, offsetof(dmr_host_shm_t, data));
+        memcpy(host->shm->magic, DMR_HOST_MAGIC, sizeof(host->shm->magic));
+    }
+    flock(host->fd, LOCK_UN);
+
+    datamodel->datamodel_event_callback = datamodel_event_callback;
+    datamodel->connection_state = EXOS_STATE_CONNECTED;
+    datamodel->sync_info.in_sync = true;
+    datamodel_event_callback(datamodel, EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED, NULL);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_set_operational(exos_datamodel_handle_t *datamodel)
+{
+    if (EXOS_STATE_CONNECTED != datamodel->connection_state)
+        return EXOS_ERROR_BAD_STATE;
+
+    datamodel->connection_state = EXOS_STATE_OPERATIONAL;
+    datamodel->datamodel_event_callback(datamodel, EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED, NULL);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_set_process_mode(exos_datamodel_handle_t *datamodel, EXOS_DATAMODEL_PROCESS_MODE mode)
+{
+    dmr_host_datamodel_t *host = datamodel->_private;
+    if (NULL == host)
+        return EXOS_ERROR_BAD_DATAMODEL_HANDLE;
+
+    host->mode = mode;
+    datamodel->sync_info.process_mode = mode;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_disconnect(exos_datamodel_handle_t *datamodel)
+{
+    datamodel->connection_state = EXOS_STATE_DISCONNECTED;
+    if (NULL != datamodel->datamodel_event_callback)
+        datamodel->datamodel_event_callback(datamodel, EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED, NULL);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_delete(exos_datamodel_handle_t *datamodel)
+{
+    dmr_host_datamodel_t *host = datamodel->_private;
+    size_t i = 0;
+
+    if (NULL == host)
+        return EXOS_ERROR_BAD_DATAMODEL_HANDLE;
+
+    while (i < dataset_count)
+    {
+        if (datasets[i]->datamodel == datamodel)
+            release_dataset(i);
+        else
+            i++;
+    }
+    if (NULL != host->shm)
+        munmap(host->shm, sizeof(dmr_host_shm_t));
+    if (host->fd >= 0)
+        close(host->fd);
+    free(host);
+    datamodel->_private = NULL;
+    datamodel->connection_state = EXOS_STATE_DISCONNECTED;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_datamodel_process(exos_datamodel_handle_t *datamodel)
+{
+    dmr_host_datamodel_t *host = datamodel->_private;
+    size_t i;
+
+    if (NULL == host || NULL == host->shm)
+        return EXOS_ERROR_BAD_STATE;
+
+    if (EXOS_DATAMODEL_PROCESS_BLOCKING == host->mode)
+    {
+        // wait for the next DMR cycle
+        int64_t now = monotonic_us();
+        int64_t cycle = dmr_cycle_us();
+        struct timespec ts;
+
+        if (host->next_cycle <= now)
+            host->next_cycle = (now / cycle + 1) * cycle;
+        ts.tv_sec = host->next_cycle / 1000000;
+        ts.tv_nsec = (host->next_cycle % 1000000) * 1000;
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        host->next_cycle += cycle;
+    }
+
+    for (i = 0; i < dataset_count; i++)
+    {
+        exos_dataset_handle_t *dataset = datasets[i];
+        dmr_host_dataset_t *state = dataset->_private;
+        uint64_t before, after;
+
+        if (dataset->datamodel != datamodel || NULL == state->slot || !(dataset->type & EXOS_DATASET_SUBSCRIBE))
+            continue;
+
+        before = __atomic_load_n(&state->slot->sequence, __ATOMIC_ACQUIRE);
+        if (before == state->sequence || (before & 1) || state->slot->writer == getpid())
+            continue;
+
+        memcpy(dataset->data, host->shm->data + state->slot->offset, dataset->size);
+        dataset->nettime = state->slot->nettime;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        after = __atomic_load_n(&state->slot->sequence, __ATOMIC_RELAXED);
+        if (after != before)
+            continue; // written meanwhile, delivered in the next process()
+
+        state->sequence = before;
+        state->received++;
+        dataset->dataset_event_callback(dataset, EXOS_DATASET_EVENT_UPDATED, NULL);
+    }
+    return EXOS_ERROR_OK;
+}
+
+int32_t exos_datamodel_get_nettime(exos_datamodel_handle_t *datamodel)
+{
+    return (int32_t)monotonic_us();
+}
+
+void exos_datamodel_calc_dataset_info(exos_dataset_info_t *info, size_t info_size)
+{
+}
+
+EXOS_ERROR_CODE exos_dataset_init(exos_dataset_handle_t *dataset, exos_datamodel_handle_t *datamodel, const char *browse_name, const void *data, size_t size)
+{
+    dmr_host_dataset_t *state;
+
+    if (dataset_count >= sizeof(datasets) / sizeof(datasets[0]) || strlen(browse_name) >= DMR_HOST_MAX_NAME)
+        return EXOS_ERROR_BUFFER_OVERFLOW;
+
+    state = calloc(1, sizeof(dmr_host_dataset_t));
+    if (NULL == state)
+        return EXOS_ERROR_SYSTEM;
+
+    memset(dataset, 0, sizeof(*dataset));
+    dataset->name = browse_name;
+    dataset->datamodel = datamodel;
+    dataset->data = (void *)data;
+    dataset->size = size;
+    dataset->_private = state;
+    datasets[dataset_count++] = dataset;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_dataset_connect(exos_dataset_handle_t *dataset, EXOS_DATASET_TYPE type, exos_dataset_event_cb dataset_event_callback)
+{
+    dmr_host_datamodel_t *host = dataset->datamodel->_private;
+    dmr_host_dataset_t *state = dataset->_private;
+    dmr_host_shm_t *shm;
+    uint32_t i;
+
+    if (NULL == host || NULL == host->shm || NULL == state)
+        return EXOS_ERROR_BAD_STATE;
+    shm = host->shm;
+
+    // find the slot of the dataset, or add it
+    flock(host->fd, LOCK_EX);
+    for (i = 0; i < shm->slots; i++)
+    {
+        if (0 == strcmp(shm->slot[i].name, dataset->name))
+            break;
+    }
+    if (i == shm->slots)
+    {
+        if (i == DMR_HOST_MAX_DATASETS || shm->used + dataset->size > DMR_HOST_DATA_SIZE)
+        {
+            flock(host->fd, LOCK_UN);
+            return EXOS_ERROR_BUFFER_OVERFLOW;
+        }
+        strcpy(shm->slot[i].name, dataset->name);
+        shm->slot[i].size = (uint32_t)dataset->size;
+        shm->slot[i].offset = shm->used;
+        shm->used += (uint32_t)((dataset->size + 7) & ~(size_t)7);
+        shm->slots++;
+    }
+    flock(host->fd, LOCK_UN);
+
+    if (shm->slot[i].size != dataset->size)
+    {
+        fprintf(stderr, "dmr: dataset %s has %u bytes in the other process, %zu here\n", dataset->name, shm->slot[i].size, dataset->size);
+        return EXOS_ERROR_BAD_DATASET_SIZE;
+    }
+
+    state->slot = &shm->slot[i];
+    state->sequence = 0; // the last published value is delivered in the first process()
+    dataset->type = type;
+    dataset->dataset_event_callback = dataset_event_callback;
+    dataset->connection_state = EXOS_STATE_OPERATIONAL;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_dataset_publish(exos_dataset_handle_t *dataset)
+{
+    dmr_host_datamodel_t *host = dataset->datamodel->_private;
+    dmr_host_dataset_t *state = dataset->_private;
+    dmr_host_slot_t *slot;
+
+    if (NULL == state || NULL == state->slot || !(dataset->type & EXOS_DATASET_PUBLISH))
+        return EXOS_ERROR_BAD_STATE;
+    slot = state->slot;
+
+    __atomic_add_fetch(&slot->sequence, 1, __ATOMIC_ACQ_REL);
+    memcpy(host->shm->data + slot->offset, dataset->data, dataset->size);
+    slot->nettime = (int32_t)monotonic_us();
+    slot->writer = getpid();
+    state->sequence = __atomic_add_fetch(&slot->sequence, 1, __ATOMIC_RELEASE);
+    state->published++;
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_dataset_delete(exos_dataset_handle_t *dataset)
+{
+    size_t i;
+
+    // already released if the datamodel was deleted first
+    for (i = 0; i < dataset_count; i++)
+    {
+        if (datasets[i] == dataset)
+        {
+            release_dataset(i);
+            break;
+        }
+    }
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_init(exos_log_handle_t *log, const char *name)
+{
+    // copied, the C++ logger passes a temporary
+    snprintf(log->name, sizeof(log->name), "%s", name);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_process(exos_log_handle_t *log)
+{
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_delete(exos_log_handle_t *log)
+{
+    return EXOS_ERROR_OK;
+}
+
+static void log_print(FILE *file, const exos_log_handle_t *log, const char *level, const char *format, va_list args)
+{
+    size_t length = strlen(format);
+
+    fprintf(file, "%s %s: ", log->name, level);
+    vfprintf(file, format, args);
+    if (0 == length || '\n' != format[length - 1])
+        fprintf(file, "\n");
+}
+
+EXOS_ERROR_CODE exos_log_error(const exos_log_handle_t *log, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    log_print(stderr, log, "error", format, args);
+    va_end(args);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_warning(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    va_list args;
+    if (type & EXOS_LOG_TYPE_VERBOSE)
+        return EXOS_ERROR_OK;
+
+    va_start(args, format);
+    log_print(stdout, log, "warning", format, args);
+    va_end(args);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_success(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    log_print(stdout, log, "success", format, args);
+    va_end(args);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_info(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    log_print(stdout, log, "info", format, args);
+    va_end(args);
+    return EXOS_ERROR_OK;
+}
+
+EXOS_ERROR_CODE exos_log_debug(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...)
+{
+    return EXOS_ERROR_OK;
+}
@@ -0,0 +1,9 @@
+/* User code of the end-to-end test: the AR program publishes its cycle count in Status */
+
+#include "ar_host.h"
+#include "exos_budget.h"
+
+void ar_host_user_cyclic(const char *program, void *data, uint64_t cycle)
+{
+    ((Budget *)data)->Status = (uint32_t)cycle;
+}
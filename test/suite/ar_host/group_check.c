@@ -0,0 +1,57 @@
+/* Checks the sequence numbers of the publish group header generated from typfiles/Odometry.typ: the publisher leaves out
+   0 when its sequence number wraps around, and the receiver counts the sequence numbers it never got as skipped, also
+   across the wraparound. Prints the checked cases and exits with 1 on the first mismatch */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "exos_odometry_group.h"
+
+static int cases = 0;
+
+static void check(const char *name, uint32_t actual, uint32_t expected)
+{
+    cases++;
+    if (actual != expected)
+    {
+        printf("group: %s is %u, expected %u\n", name, actual, expected);
+        exit(1);
+    }
+}
+
+/* the skipped sequence numbers of a receiver getting the tags in order */
+static uint32_t skipped(const uint32_t *tags, int count)
+{
+    exos_group_t group;
+    int i;
+
+    exos_group_init(&group, 3);
+    for (i = 0; i < count; i++)
+    {
+        exos_group_tag(&group, tags[i]);
+    }
+    return group.skipped;
+}
+
+int main()
+{
+    exos_group_t publisher;
+    const uint32_t consecutive[] = {1, 2, 3};
+    const uint32_t gap[] = {5, 8};
+    const uint32_t wrap[] = {0xFFFFFFFE, 0xFFFFFFFF, 1, 2};
+    const uint32_t wrap_gap[] = {0xFFFFFFFE, 2};
+    const uint32_t wrap_first[] = {0xFFFFFFFF, 2};
+
+    exos_group_init(&publisher, 3);
+    publisher.sequence = 0xFFFFFFFE;
+    check("next before the wraparound", exos_group_next(&publisher), 0xFFFFFFFF);
+    check("next after the wraparound", exos_group_next(&publisher), 1);
+
+    check("skipped of consecutive tags", skipped(consecutive, 3), 0);
+    check("skipped of 5, 8", skipped(gap, 2), 2);
+    check("skipped across the wraparound", skipped(wrap, 4), 0);
+    check("skipped of 0xFFFFFFFE, 2", skipped(wrap_gap, 2), 2);
+    check("skipped of 0xFFFFFFFF, 2", skipped(wrap_first, 2), 1);
+
+    printf("group: %d cases ok\n", cases);
+    return 0;
+}
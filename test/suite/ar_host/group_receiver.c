@@ -0,0 +1,49 @@
+/* Linux application of the publish group test, replacing the generated main: the members of the Odom group hold the
+   same cycle count in each publish, which the group callback and the callbacks of the members must never see torn */
+
+#include <stdio.h>
+#include "libodometry.h"
+#include "termination.h"
+
+static libOdometry_t *odometry;
+static uint32_t groups = 0;
+static uint32_t members = 0;
+static uint32_t torn = 0;
+
+static void on_group_change(void)
+{
+    OdometryOdom_snapshot_t *snapshot = &odometry->Odom.snapshot;
+
+    groups++;
+    if (snapshot->Pose.X != snapshot->Twist || snapshot->Pose.Y != snapshot->Twist || (double)snapshot->Stamp != snapshot->Twist)
+        torn++;
+}
+
+static void on_change_member(void)
+{
+    members++;
+    if (odometry->Pose.value.X != odometry->Twist.value || odometry->Pose.value.Y != odometry->Twist.value || (double)odometry->Stamp.value != odometry->Twist.value)
+        torn++;
+}
+
+int main()
+{
+    odometry = libOdometry_init();
+    odometry->Odom.on_group_change = on_group_change;
+    odometry->Pose.on_change = on_change_member;
+    odometry->Twist.on_change = on_change_member;
+    odometry->Stamp.on_change = on_change_member;
+    odometry->connect();
+
+    catch_termination();
+    while (!is_terminated())
+    {
+        odometry->process();
+    }
+
+    printf("group: %u groups, %u member callbacks, %u torn\n", groups, members, torn);
+    odometry->disconnect();
+    odometry->dispose();
+
+    return 0;
+}
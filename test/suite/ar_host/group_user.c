@@ -0,0 +1,12 @@
+/* User code of the publish group test: the AR program writes its cycle count to all members of the Odom group */
+
+#include "ar_host.h"
+#include "exos_odometry.h"
+
+void ar_host_user_cyclic(const char *program, void *data, uint64_t cycle)
+{
+    ((Odometry *)data)->Pose.X = (double)cycle;
+    ((Odometry *)data)->Pose.Y = (double)cycle;
+    ((Odometry *)data)->Twist = (double)cycle;
+    ((Odometry *)data)->Stamp = (uint32_t)cycle;
+}
@@ -0,0 +1,35 @@
+/* Linux application of the load generator test, replacing the generated main: publishes Commands for every
+   Setpoints received, until terminated */
+
+#include <stdio.h>
+#include "libbudget.h"
+#include "termination.h"
+
+static libBudget_t *budget;
+static uint32_t responses = 0;
+
+static void on_change_setpoints(void)
+{
+    budget->Commands.value[0] = (int32_t)budget->Setpoints.value[0];
+    budget->Commands.value[1] = (int32_t)++responses;
+    budget->Commands.publish();
+}
+
+int main()
+{
+    budget = libBudget_init();
+    budget->Setpoints.on_change = on_change_setpoints;
+    budget->connect();
+
+    catch_termination();
+    while (!is_terminated())
+    {
+        budget->process();
+    }
+
+    printf("responder: %u responses\n", responses);
+    budget->disconnect();
+    budget->dispose();
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+/* Reader of the mirror test: waits until the Linux application mirrored a Status received from the AR program */
+
+#include <stdio.h>
+#include <time.h>
+#include "exos_budget_mirror.h"
+
+int main(int argc, char **argv)
+{
+    const exos_budget_mirror_t *mirror = NULL;
+
+    // 10 s
+    for (int i = 0; i < 1000; i++)
+    {
+        struct timespec ts = {.tv_sec = 0, .tv_nsec = 10000000};
+        uint32_t status = 0;
+        int32_t nettime = 0;
+
+        if (NULL == mirror)
+            mirror = exos_budget_mirror_open(EXOS_BUDGET_MIRROR_NAME);
+
+        if (NULL != mirror && exos_budget_mirror_alive(mirror) && exos_budget_mirror_read_Status(mirror, &status, &nettime) && status > 0)
+        {
+            printf("mirror: Status %u updates %u\n", status, EXOS_BUDGET_MIRROR_UPDATES(mirror, Status));
+            exos_budget_mirror_close(mirror);
+            return 0;
+        }
+        nanosleep(&ts, NULL);
+    }
+    fprintf(stderr, "mirror: no Status in %s\n", EXOS_BUDGET_MIRROR_NAME);
+    exos_budget_mirror_close(mirror);
+    return 1;
+}
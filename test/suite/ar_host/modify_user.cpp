@@ -0,0 +1,39 @@
+/* Linux application of the publish on modify test, replacing the generated main: every cycle Commands[0] is written
+   through modify() with a value that changes every 10th cycle, and Config is only read through modify(). process()
+   publishes the changed values and counts the others as suppressed */
+
+#include <cstdio>
+#include "BudgetDatamodel.hpp"
+#include "termination.h"
+
+int main()
+{
+    BudgetDatamodel budget;
+    uint32_t cycles = 0;
+    uint32_t changes = 0;
+
+    budget.connect();
+
+    catch_termination();
+    while (!is_terminated())
+    {
+        budget.process();
+
+        if (budget.isConnected)
+        {
+            int32_t command = (int32_t)(cycles / 10);
+            if (command != budget.Commands.value[0] || cycles == 0)
+                changes++;
+            budget.Commands.modify()[0] = command;
+            double gain = budget.Config.modify().Gain;
+            (void)gain;
+            cycles++;
+        }
+    }
+
+    printf("modify: %u cycles, %u changes, %u published, %u suppressed\n", cycles, changes,
+           budget.publishStats().published, budget.publishStats().suppressed);
+    budget.disconnect();
+
+    return 0;
+}
@@ -0,0 +1,20 @@
+/* Linux application of the N-API trace test, replacing the generated main: every Status received from the AR program
+   is answered by publishing it in Commands[0], so the trace has the onChange dispatch and the publish method */
+
+let budget = require('./l_Budget.node').Budget;
+
+// the N-API module expects every callback to be set
+budget.onConnectionChange(() => {});
+budget.onSyncChange(() => {});
+budget.onProcessed(() => {});
+for (let dataset of ["Setpoints", "Status", "Samples", "Commands", "Config"]) {
+    budget.datamodel[dataset].onConnectionChange(() => {});
+}
+for (let dataset of ["Setpoints", "Samples", "Config"]) {
+    budget.datamodel[dataset].onChange(() => {});
+}
+
+budget.datamodel.Status.onChange(() => {
+    budget.datamodel.Commands.value[0] = budget.datamodel.Status.value;
+    budget.datamodel.Commands.publish();
+});
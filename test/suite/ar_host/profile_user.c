@@ -0,0 +1,11 @@
+/* User code of the profile test: the AR program changes the first element of Setpoints every cycle,
+   the second one every 10th cycle, and leaves the others unchanged */
+
+#include "ar_host.h"
+#include "exos_budget.h"
+
+void ar_host_user_cyclic(const char *program, void *data, uint64_t cycle)
+{
+    ((Budget *)data)->Setpoints[0] = (double)cycle;
+    ((Budget *)data)->Setpoints[1] = (double)(cycle / 10);
+}
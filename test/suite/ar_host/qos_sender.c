@@ -0,0 +1,32 @@
+/* Linux application of the quality of service test, replacing the generated main: Feedback is published with
+   0.05 more every cycle (at most every 5 ms), so that the AR program only gets the values leaving its deadband of 1 */
+
+#include <stdio.h>
+#include "libsensor.h"
+#include "termination.h"
+
+int main()
+{
+    libSensor_t *sensor = libSensor_init();
+    uint32_t cycles = 0;
+
+    sensor->connect();
+
+    catch_termination();
+    while (!is_terminated())
+    {
+        sensor->process();
+
+        if (sensor->is_connected)
+        {
+            cycles++;
+            sensor->Feedback.value = cycles * 0.05;
+            sensor->Feedback.publish();
+        }
+    }
+
+    sensor->disconnect();
+    sensor->dispose();
+
+    return 0;
+}
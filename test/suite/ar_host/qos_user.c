@@ -0,0 +1,20 @@
+/* User code of the quality of service test: the AR program writes its cycle count to Level (RATE=10ms) and Counter
+   every cycle, and prints each Feedback value delivered through the DEADBAND=1 and LATEST of the c-api template */
+
+#include <stdio.h>
+#include "ar_host.h"
+#include "exos_sensor.h"
+
+void ar_host_user_cyclic(const char *program, void *data, uint64_t cycle)
+{
+    static double feedback = 0;
+    Sensor *sensor = (Sensor *)data;
+
+    sensor->Level = (double)cycle;
+    sensor->Counter = (uint32_t)cycle;
+    if (sensor->Feedback != feedback)
+    {
+        feedback = sensor->Feedback;
+        printf("qos: feedback %f\n", feedback);
+    }
+}
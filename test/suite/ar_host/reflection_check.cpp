@@ -0,0 +1,107 @@
+/* Checks the reflection header generated from typfiles/StringAndArray.typ: the member names, offsets and sizes of the
+   TypeInfo descriptors against offsetof()/sizeof(), and that for_each_member visits every member of StringAndArray and
+   of the nested structs, with a reference to the member at the described offset. Prints the checked members and
+   exits with 1 on the first mismatch */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <type_traits>
+#include "exos_stringandarray_reflection.hpp"
+
+using namespace exos_reflection;
+
+struct Expected
+{
+    const char *name;
+    std::size_t offset;
+    std::size_t size;
+    std::size_t arraySize;
+};
+
+#define EXPECT(type, member, arraySize) {#member, offsetof(type, member), sizeof(type::member), arraySize}
+
+static const Expected expectedStringAndArray[] = {
+    EXPECT(StringAndArray, MyInt1, 0),
+    EXPECT(StringAndArray, MyString, 3),
+    EXPECT(StringAndArray, MyInt2, 5),
+    EXPECT(StringAndArray, MyIntStruct, 6),
+    EXPECT(StringAndArray, MyIntStruct1, 0),
+    EXPECT(StringAndArray, MyIntStruct2, 0),
+    EXPECT(StringAndArray, MyEnum1, 0)};
+
+static const Expected expectedIntStruct[] = {
+    EXPECT(IntStruct_typ, MyInt13, 0),
+    EXPECT(IntStruct_typ, MyInt14, 3),
+    EXPECT(IntStruct_typ, MyInt133, 0),
+    EXPECT(IntStruct_typ, MyInt124, 3)};
+
+static const Expected expectedIntStruct1[] = {
+    EXPECT(IntStruct1_typ, MyInt13, 0)};
+
+static const Expected expectedIntStruct2[] = {
+    EXPECT(IntStruct2_typ, MyInt23, 0),
+    EXPECT(IntStruct2_typ, MyInt24, 4),
+    EXPECT(IntStruct2_typ, MyInt25, 0)};
+
+// the descriptors are usable at compile time
+static_assert(TypeInfo<StringAndArray>::memberCount == 7, "StringAndArray has 7 members");
+static_assert(TypeInfo<StringAndArray>::members[3].offset == offsetof(StringAndArray, MyIntStruct), "offset of MyIntStruct");
+static_assert(TypeInfo<StringAndArray>::members[1].stringLength == 81, "STRING[80] of MyString");
+static_assert(!is_reflected<int>::value, "int is not reflected");
+
+static unsigned checked = 0;
+
+static void fail(const char *type, const char *member, const char *what)
+{
+    printf("reflection: %s.%s: %s mismatch\n", type, member, what);
+    exit(1);
+}
+
+template <typename T>
+static void checkType(T &value, const Expected *expected, std::size_t count)
+{
+    typedef TypeInfo<T> Info;
+    std::size_t index = 0;
+
+    if (Info::size != sizeof(T))
+        fail(Info::name, "", "size");
+    if (Info::memberCount != count)
+        fail(Info::name, "", "member count");
+
+    for_each_member(value, [&](const MemberInfo &info, auto &member) {
+        if (index >= count)
+            fail(Info::name, info.name, "visited member count");
+        const Expected &e = expected[index++];
+        if (0 != strcmp(info.name, e.name))
+            fail(Info::name, e.name, "name");
+        if (info.offset != e.offset || (const char *)&member - (const char *)&value != (std::ptrdiff_t)e.offset)
+            fail(Info::name, e.name, "offset");
+        if (info.size != e.size || sizeof(member) != e.size)
+            fail(Info::name, e.name, "size");
+        if (info.arraySize != e.arraySize || info.elementSize * (e.arraySize ? e.arraySize : 1) != e.size)
+            fail(Info::name, e.name, "array size");
+        checked++;
+    });
+    if (index != count)
+        fail(Info::name, "", "visited member count");
+}
+
+int main()
+{
+    StringAndArray value;
+    memset(&value, 0, sizeof(value));
+
+    checkType(value, expectedStringAndArray, sizeof(expectedStringAndArray) / sizeof(expectedStringAndArray[0]));
+    for (auto &element : value.MyIntStruct)
+        checkType(element, expectedIntStruct, sizeof(expectedIntStruct) / sizeof(expectedIntStruct[0]));
+    checkType(value.MyIntStruct1, expectedIntStruct1, sizeof(expectedIntStruct1) / sizeof(expectedIntStruct1[0]));
+    checkType(value.MyIntStruct2, expectedIntStruct2, sizeof(expectedIntStruct2) / sizeof(expectedIntStruct2[0]));
+
+    if (TypeInfo<Enum_enum>::enumeratorCount != 2 || TypeInfo<Enum_enum>::enumerators[1].value != enum2
+        || 0 != strcmp(TypeInfo<Enum_enum>::enumerators[1].name, "enum2"))
+        fail("Enum_enum", "enum2", "enumerator");
+
+    printf("reflection: %u members ok\n", checked);
+    return 0;
+}
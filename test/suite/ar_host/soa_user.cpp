@@ -0,0 +1,81 @@
+/* Linux application of the structure-of-arrays test, replacing the generated main: the conversion kernels of MyIntStruct
+   are checked for a round trip first. Every even cycle MyInt13[0] is written in a soaModify() scope, and the
+   dataset is published through the base class while the scope is open, so the scope end leaves an unchanged value that
+   process() suppresses. Every odd cycle MyInt133[1] is written via soaModify(f), which process() publishes. Reading the
+   mirror via soa() must not mark the dataset as modified */
+
+#include <cstdio>
+#include <cstring>
+#include "StringAndArrayDatamodel.hpp"
+#include "termination.h"
+
+int main()
+{
+    StringAndArrayDatamodel datamodel;
+    uint32_t cycles = 0;
+    uint32_t stored = 0;
+    uint32_t written = 0;
+    uint32_t readModified = 0;
+
+    IntStruct_typ aos[6];
+    IntStruct_typ back[6];
+    StringAndArrayMyIntStruct_soa_t soa;
+    memset(aos, 0, sizeof(aos));
+    memset(back, 0, sizeof(back));
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        aos[i].MyInt13 = 1000 + i;
+        aos[i].MyInt133 = 2000 + i;
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            aos[i].MyInt14[j] = (uint8_t)(10 * i + j);
+            aos[i].MyInt124[j] = (uint8_t)(100 + 10 * i + j);
+        }
+    }
+    exos_soa_load(soa, aos);
+    exos_soa_store(soa, back);
+    // padding is zero on both sides, so the whole array compares
+    bool roundTrip = 0 == memcmp(aos, back, sizeof(aos)) && soa.MyInt13[5] == 1005 && soa.MyInt133[2] == 2002 && soa.MyInt124[4][2] == 142;
+
+    datamodel.connect();
+
+    catch_termination();
+    while (!is_terminated())
+    {
+        datamodel.process();
+
+        if (datamodel.isConnected)
+        {
+            uint32_t last = datamodel.MyIntStruct.soa().MyInt13[0];
+            (void)last;
+            if (datamodel.MyIntStruct.modified())
+                readModified++;
+
+            if (0 == cycles % 2)
+            {
+                auto mirror = datamodel.MyIntStruct.soaModify();
+                mirror->MyInt13[0] = cycles;
+                StringAndArrayDataset<IntStruct_typ[6]> &dataset = datamodel.MyIntStruct;
+                dataset.publish();
+                if (datamodel.MyIntStruct.value[0].MyInt13 == cycles)
+                    stored++;
+            }
+            else
+            {
+                datamodel.MyIntStruct.soaModify([cycles](StringAndArrayMyIntStruct_soa_t &mirror) {
+                    mirror.MyInt133[1] = cycles;
+                });
+                if (datamodel.MyIntStruct.value[1].MyInt133 == cycles && datamodel.MyIntStruct.modified())
+                    written++;
+            }
+            cycles++;
+        }
+    }
+
+    printf("soa: round trip %s, %u cycles, %u stored on publish, %u written, %u read modified, %u published, %u suppressed\n",
+           roundTrip ? "ok" : "failed", cycles, stored, written, readModified,
+           datamodel.publishStats().published, datamodel.publishStats().suppressed);
+    datamodel.disconnect();
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+/* Host stub of the Automation Studio PLC types, only what the generated AR library sources use */
+
+#ifndef _BUR_PLCTYPES_H_
+#define _BUR_PLCTYPES_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define _BUR_PUBLIC
+#define _EXIT
+
+typedef bool BOOL;
+typedef uint8_t USINT;
+typedef int8_t SINT;
+typedef uint16_t UINT;
+typedef int16_t INT;
+/* pointer sized on the host, as the FUBs pass their handle as UDINT (which works on the 32 bit AR) */
+typedef uintptr_t UDINT;
+typedef int32_t DINT;
+typedef float REAL;
+typedef double LREAL;
+
+#endif // _BUR_PLCTYPES_H_
@@ -0,0 +1,167 @@
+/* exOS API of the host DMR stand-in (dmr_host.c), for running generated AR and Linux sources on the host
+
+   Declares what the generated templates use. The datasets of a datamodel instance are exchanged between
+   the processes on the host through a shared memory object, see dmr_host.c */
+
+#ifndef _EXOS_API_H_
+#define _EXOS_API_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    EXOS_ERROR_OK = 0,
+    EXOS_ERROR_NOT_IMPLEMENTED = 5000,
+    EXOS_ERROR_PARAMETER_NULL,
+    EXOS_ERROR_BAD_DATAMODEL_HANDLE,
+    EXOS_ERROR_BAD_DATASET_HANDLE,
+    EXOS_ERROR_NOT_ALLOWED,
+    EXOS_ERROR_NOT_FOUND,
+    EXOS_ERROR_BUFFER_OVERFLOW,
+    EXOS_ERROR_BAD_DATASET_SIZE,
+    EXOS_ERROR_SYSTEM,
+    EXOS_ERROR_BAD_STATE
+} EXOS_ERROR_CODE;
+
+typedef enum
+{
+    EXOS_STATE_DISCONNECTED,
+    EXOS_STATE_CONNECTED,
+    EXOS_STATE_OPERATIONAL,
+    EXOS_STATE_ABORTED
+} EXOS_CONNECTION_STATE;
+
+typedef enum
+{
+    EXOS_DATASET_EVENT_CONNECTION_CHANGED,
+    EXOS_DATASET_EVENT_UPDATED,
+    EXOS_DATASET_EVENT_PUBLISHED,
+    EXOS_DATASET_EVENT_DELIVERED
+} EXOS_DATASET_EVENT_TYPE;
+
+typedef enum
+{
+    EXOS_DATAMODEL_EVENT_CONNECTION_CHANGED,
+    EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED
+} EXOS_DATAMODEL_EVENT_TYPE;
+
+typedef enum
+{
+    EXOS_DATASET_SUBSCRIBE = 1,
+    EXOS_DATASET_PUBLISH = 16
+} EXOS_DATASET_TYPE;
+
+typedef enum
+{
+    EXOS_DATAMODEL_PROCESS_BLOCKING,
+    EXOS_DATAMODEL_PROCESS_NON_BLOCKING
+} EXOS_DATAMODEL_PROCESS_MODE;
+
+typedef struct
+{
+    bool in_sync;
+    uint32_t missed_dmr_cycles;
+    uint32_t missed_ar_cycles;
+    EXOS_DATAMODEL_PROCESS_MODE process_mode;
+} exos_datamodel_sync_info_t;
+
+typedef struct
+{
+    uint32_t size;
+    uint32_t free;
+    uint32_t used;
+} exos_buffer_info_t;
+
+typedef struct exos_datamodel_handle exos_datamodel_handle_t;
+typedef struct exos_dataset_handle exos_dataset_handle_t;
+
+typedef void (*exos_datamodel_event_cb)(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info);
+typedef void (*exos_dataset_event_cb)(exos_dataset_handle_t *dataset, EXOS_DATASET_EVENT_TYPE event_type, void *info);
+
+struct exos_datamodel_handle
+{
+    char *name;
+    char *user_alias;
+    EXOS_CONNECTION_STATE connection_state;
+    EXOS_ERROR_CODE error;
+    void *user_context;
+    long user_tag;
+    exos_datamodel_sync_info_t sync_info;
+    exos_datamodel_event_cb datamodel_event_callback;
+    void *_private;
+};
+
+struct exos_dataset_handle
+{
+    const char *name;
+    EXOS_DATASET_TYPE type;
+    exos_datamodel_handle_t *datamodel;
+    void *data;
+    size_t size;
+    EXOS_ERROR_CODE error;
+    EXOS_CONNECTION_STATE connection_state;
+    exos_buffer_info_t send_buffer;
+    int32_t nettime;
+    void *user_context;
+    long user_tag;
+    exos_dataset_event_cb dataset_event_callback;
+    void *_private;
+};
+
+#define EXOS_ARRAY_DEPTH 10
+
+typedef struct
+{
+    const char *name;
+    void *adr;
+    size_t size;
+    long offset;
+    uint32_t arrayItems[EXOS_ARRAY_DEPTH];
+} exos_dataset_info_t;
+
+#define EXOS_DATASET_BROWSE_NAME_INIT "", &data, sizeof(data), 0
+#define EXOS_DATASET_BROWSE_NAME(_arg_) #_arg_, &data._arg_, sizeof(data._arg_), (long)&data._arg_ - (long)&data
+
+#ifndef EXOS_ASSERT_CALLBACK
+#define EXOS_ASSERT_CALLBACK
+#endif
+
+#define EXOS_ASSERT_OK(_exp_)                \
+    do                                       \
+    {                                        \
+        EXOS_ERROR_CODE _err_ = _exp_;       \
+        if (EXOS_ERROR_OK != _err_)          \
+        {                                    \
+            EXOS_ASSERT_CALLBACK;            \
+        }                                    \
+    } while (0)
+
+const char *exos_get_error_string(EXOS_ERROR_CODE error);
+const char *exos_get_state_string(EXOS_CONNECTION_STATE state);
+
+EXOS_ERROR_CODE exos_datamodel_init(exos_datamodel_handle_t *datamodel, const char *datamodel_instance_name, const char *user_alias);
+EXOS_ERROR_CODE exos_datamodel_connect(exos_datamodel_handle_t *datamodel, const char *config, const exos_dataset_info_t *info, size_t info_size, exos_datamodel_event_cb datamodel_event_callback);
+EXOS_ERROR_CODE exos_datamodel_set_operational(exos_datamodel_handle_t *datamodel);
+EXOS_ERROR_CODE exos_datamodel_set_process_mode(exos_datamodel_handle_t *datamodel, EXOS_DATAMODEL_PROCESS_MODE mode);
+EXOS_ERROR_CODE exos_datamodel_disconnect(exos_datamodel_handle_t *datamodel);
+EXOS_ERROR_CODE exos_datamodel_delete(exos_datamodel_handle_t *datamodel);
+EXOS_ERROR_CODE exos_datamodel_process(exos_datamodel_handle_t *datamodel);
+int32_t exos_datamodel_get_nettime(exos_datamodel_handle_t *datamodel);
+void exos_datamodel_calc_dataset_info(exos_dataset_info_t *info, size_t info_size);
+
+EXOS_ERROR_CODE exos_dataset_init(exos_dataset_handle_t *dataset, exos_datamodel_handle_t *datamodel, const char *browse_name, const void *data, size_t size);
+EXOS_ERROR_CODE exos_dataset_connect(exos_dataset_handle_t *dataset, EXOS_DATASET_TYPE type, exos_dataset_event_cb dataset_event_callback);
+EXOS_ERROR_CODE exos_dataset_publish(exos_dataset_handle_t *dataset);
+EXOS_ERROR_CODE exos_dataset_delete(exos_dataset_handle_t *dataset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EXOS_API_H_
@@ -0,0 +1,46 @@
+/* exOS logger of the host DMR stand-in, writes to stdout (errors to stderr), see dmr_host.c */
+
+#ifndef _EXOS_LOG_H_
+#define _EXOS_LOG_H_
+
+#include "exos_api.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    char name[36];
+} exos_log_handle_t;
+
+typedef enum
+{
+    EXOS_LOG_TYPE_USER = 1,
+    EXOS_LOG_TYPE_SYSTEM = 2,
+    EXOS_LOG_TYPE_VERBOSE = 4
+} EXOS_LOG_TYPE;
+
+typedef enum
+{
+    EXOS_LOG_LEVEL_ERROR,
+    EXOS_LOG_LEVEL_WARNING,
+    EXOS_LOG_LEVEL_SUCCESS,
+    EXOS_LOG_LEVEL_INFO,
+    EXOS_LOG_LEVEL_DEBUG
+} EXOS_LOG_LEVEL;
+
+EXOS_ERROR_CODE exos_log_init(exos_log_handle_t *log, const char *name);
+EXOS_ERROR_CODE exos_log_process(exos_log_handle_t *log);
+EXOS_ERROR_CODE exos_log_delete(exos_log_handle_t *log);
+EXOS_ERROR_CODE exos_log_error(const exos_log_handle_t *log, const char *format, ...);
+EXOS_ERROR_CODE exos_log_warning(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...);
+EXOS_ERROR_CODE exos_log_success(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...);
+EXOS_ERROR_CODE exos_log_info(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...);
+EXOS_ERROR_CODE exos_log_debug(const exos_log_handle_t *log, EXOS_LOG_TYPE type, const char *format, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EXOS_LOG_H_
@@ -0,0 +1,43 @@
+const assert = require('assert');
+const path = require('path');
+const { Datamodel } = require('../../../src/datamodel');
+
+suite('Datamodel layout analysis tests', () => {
+
+    // sizes and offsets are the ones produced by gcc for the generated exos_stringandarray.h
+    // (x86_64 for GPOS, i386 for AR) - they are the same for StringAndArray, as it has no LREAL members
+
+    let typFile = path.resolve(__dirname, '../typfiles/StringAndArray.typ');
+
+    test('Structure padding', function() {
+        let datamodel = new Datamodel(typFile, "StringAndArray");
+        let analysis = datamodel.analyzeLayout(Datamodel.LAYOUT_PLATFORMS.GPOS);
+
+        let intStruct = analysis.types.find(type => type.dataType == "IntStruct_typ");
+        assert.equal(intStruct.size, 16);
+        assert.equal(intStruct.alignment, 4);
+        assert.deepEqual(intStruct.members.map(member => member.offset), [0, 4, 8, 12]);
+        assert.deepEqual(intStruct.members.map(member => member.paddingBefore), [0, 0, 1, 0]);
+        assert.equal(intStruct.trailingPadding, 1);
+        assert.equal(intStruct.padding, 2);
+
+        let top = analysis.types[analysis.types.length - 1];
+        assert.equal(top.dataType, "StringAndArray");
+        assert.equal(top.size, 368);
+        assert.equal(top.totalPadding, 12);
+    });
+
+    test('Dataset padding weighted with publish rate', function() {
+        let datamodel = new Datamodel(typFile, "StringAndArray");
+        let analysis = datamodel.analyzeLayout(Datamodel.LAYOUT_PLATFORMS.AR, Datamodel.parseLayoutRates("MyIntStruct=100"));
+
+        assert.equal(analysis.datasets.length, 7);
+        let dataset = analysis.datasets.find(dataset => dataset.name == "MyIntStruct");
+        assert.equal(dataset.size, 96);
+        assert.equal(dataset.padding, 12);
+        assert.equal(dataset.rate, 100);
+        assert.equal(analysis.datasets.find(dataset => dataset.name == "MyInt1").rate, 1);
+
+        assert.throws(() => Datamodel.parseLayoutRates("MyIntStruct=fast"));
+    });
+});
@@ -0,0 +1,70 @@
+const assert = require('assert');
+const { Datamodel } = require('../../../src/datamodel');
+
+suite('Datamodel QoS annotation tests', () => {
+
+    test('Options apply to the preceding PUB or SUB', function() {
+        let qos = Datamodel.parseQos("PUB RATE=10ms SUB LATEST DEADBAND=0.01 PRIO=HIGH", "Temperature", "REAL", 0);
+
+        assert.deepEqual(qos.pub, {rate: 10000, latest: false, deadband: 0, relative: false, hysteresis: 0});
+        assert.deepEqual(qos.sub, {rate: 0, latest: true, deadband: 0.01, relative: false, hysteresis: 0});
+        assert.equal(qos.priority, "HIGH");
+        assert.equal(Datamodel.formatQos(qos), "PUB RATE=10ms SUB LATEST DEADBAND=0.01 PRIO=HIGH");
+    });
+
+    test('Relative deadband with hysteresis', function() {
+        let qos = Datamodel.parseQos("SUB DEADBAND=2% HYSTERESIS=0.5", "Setpoint", "LREAL", 0);
+
+        assert.deepEqual(qos.sub, {rate: 0, latest: false, deadband: 2, relative: true, hysteresis: 0.5});
+        assert.equal(Datamodel.formatQos(qos), "SUB DEADBAND=2% HYSTERESIS=0.5");
+    });
+
+    test('Member deadbands within structures', function() {
+        let qos = Datamodel.parseQos("max speed DEADBAND=0.01 HYSTERESIS=0.005", "maxSpeed", "LREAL", 0, true);
+
+        assert.deepEqual(qos.member, {deadband: 0.01, relative: false, hysteresis: 0.005});
+        assert.equal(Datamodel.formatQos(qos), "DEADBAND=0.01 HYSTERESIS=0.005");
+        assert.throws(() => Datamodel.parseQos("DEADBAND=0.01", "maxSpeed", "LREAL", 0), /must follow PUB or SUB/);
+        assert.throws(() => Datamodel.parseQos("LATEST", "maxSpeed", "LREAL", 0, true), /must follow PUB or SUB/);
+    });
+
+    test('Comments without annotations', function() {
+        assert.equal(Datamodel.parseQos("PUB SUB", "Enable", "BOOL", 0), undefined);
+        assert.equal(Datamodel.parseQos("this is a counter SUB", "Counter", "INT", 0), undefined);
+        assert.equal(Datamodel.formatQos(Datamodel.parseQos("this is a counter SUB RATE=1.5s", "Counter", "INT", 0)), "SUB RATE=1500ms");
+    });
+
+    test('Invalid annotations', function() {
+        assert.throws(() => Datamodel.parseQos("PUB SPEED=10", "Counter", "INT", 0), /Unknown QoS annotation "SPEED=10"/);
+        assert.throws(() => Datamodel.parseQos("PUB RATE=10", "Counter", "INT", 0), /RATE=<n>us/);
+        assert.throws(() => Datamodel.parseQos("LATEST PUB", "Counter", "INT", 0), /must follow PUB or SUB/);
+        assert.throws(() => Datamodel.parseQos("SUB LATEST LATEST", "Counter", "INT", 0), /given twice/);
+        assert.throws(() => Datamodel.parseQos("SUB DEADBAND=1", "Config", "MyConfig", 0), /only supported for numeric scalar types/);
+        assert.throws(() => Datamodel.parseQos("SUB DEADBAND=1", "Buffer", "INT", 10), /only supported for numeric scalar types/);
+        assert.throws(() => Datamodel.parseQos("SUB HYSTERESIS=1", "Counter", "INT", 0), /requires a DEADBAND/);
+        assert.throws(() => Datamodel.parseQos("SUB DEADBAND=-1%", "Counter", "INT", 0), /positive number or percentage/);
+        assert.throws(() => Datamodel.parseQos("PUB PRIO=URGENT", "Counter", "INT", 0), /PRIO=HIGH\|NORMAL\|LOW/);
+    });
+
+    test('Publish group annotations', function() {
+        let qos = Datamodel.parseQos("PUB GROUP=odom", "pose", "Pose", 0);
+        assert.deepEqual(qos.group, {name: "odom", tag: false});
+        assert.equal(Datamodel.formatQos(qos), "PUB GROUP=odom");
+        qos = Datamodel.parseQos("PUB GROUPTAG=odom", "odomSeq", "UDINT", 0);
+        assert.deepEqual(qos.group, {name: "odom", tag: true});
+
+        assert.throws(() => Datamodel.parseQos("PUB GROUPTAG=odom", "odomSeq", "INT", 0), /only supported for UDINT datasets/);
+        assert.throws(() => Datamodel.parseQos("PUB GROUP=1odom", "pose", "Pose", 0), /C identifier/);
+        assert.throws(() => Datamodel.parseQos("PUB RATE=10ms GROUP=odom", "pose", "Pose", 0), /cannot be combined/);
+        assert.throws(() => Datamodel.parseQos("GROUP=odom", "x", "LREAL", 0, true), /only supported for datasets/);
+    });
+
+    test('Publish group tags are generated', function() {
+        let typ = "TYPE\r\n\tOdom : \tSTRUCT \r\n\t\tpose : LREAL; (*PUB GROUP=odom*)\r\n\t\ttwist : LREAL; (*PUB GROUP=odom*)\r\n\tEND_STRUCT;\r\nEND_TYPE\r\n";
+        let tagged = Datamodel.addGroupTags(typ, "Odom");
+        assert.equal(tagged, typ.replace("\tEND_STRUCT", "\t\todomTag : UDINT; (*PUB GROUPTAG=odom*)\r\n\tEND_STRUCT"));
+        assert.equal(Datamodel.addGroupTags(tagged, "Odom"), tagged);
+        assert.equal(Datamodel.addGroupTags(typ, "Other"), typ);
+        assert.throws(() => Datamodel.addGroupTags(typ.replace("twist", "odomTag"), "Odom"), /needs the name odomTag/);
+    });
+});
@@ -144,6 +144,7 @@ static void datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMO
         }
         break;
     case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:
+        INFO("application sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);
         break;
 
     default:
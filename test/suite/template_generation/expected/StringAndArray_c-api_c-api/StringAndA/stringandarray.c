@@ -184,6 +184,10 @@ static void datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMO
         }
         break;
     case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:
+        INFO("application sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);
+
+        inst->InSync = datamodel->sync_info.in_sync;
+        inst->SyncChanges++;
         break;
 
     default:
@@ -336,6 +340,7 @@ _BUR_PUBLIC void StringAndArrayCyclic(struct StringAndArrayCyclic *inst)
         inst->Connected = 0;
         inst->Operational = 0;
         inst->Aborted = 0;
+        inst->InSync = 0;
 
         if (inst->Enable)
         {
@@ -377,6 +382,9 @@ _BUR_PUBLIC void StringAndArrayCyclic(struct StringAndArrayCyclic *inst)
         }
 
         EXOS_ASSERT_OK(exos_datamodel_process(stringandarray));
+        inst->InSync = stringandarray->sync_info.in_sync;
+        inst->MissedDmrCycles = stringandarray->sync_info.missed_dmr_cycles;
+        inst->MissedArCycles = stringandarray->sync_info.missed_ar_cycles;
         //put your cyclic code here!
 
         //publish the myint1 dataset as soon as there are changes
@@ -84,8 +84,15 @@ typedef struct libStringAndArray
     libStringAndArray_event_cb on_connected;
     libStringAndArray_event_cb on_disconnected;
     libStringAndArray_event_cb on_operational;
+    libStringAndArray_event_cb on_sync_change;
     bool is_connected;
     bool is_operational;
+    bool is_in_sync;
+    uint32_t missed_dmr_cycles;
+    uint32_t missed_ar_cycles;
+    EXOS_DATAMODEL_PROCESS_MODE process_mode;
+    uint32_t sync_changes;
+    int32_t sync_changed_nettime;
     libStringAndArrayMyInt1_t MyInt1;
     libStringAndArrayMyString_t MyString;
     libStringAndArrayMyInt2_t MyInt2;
@@ -16,11 +16,20 @@ void(void) user callbacks:
     stringandarray->on_connected
     stringandarray->on_disconnected
     stringandarray->on_operational
+    stringandarray->on_sync_change
 
 boolean values:
     stringandarray->is_connected
     stringandarray->is_operational
 
+sync diagnostics (updated in process() and before on_sync_change):
+    stringandarray->is_in_sync : (bool) datamodel is in sync with the DMR
+    stringandarray->missed_dmr_cycles : (uint32_t) cycles missed by the DMR
+    stringandarray->missed_ar_cycles : (uint32_t) cycles missed by AR
+    stringandarray->process_mode : (EXOS_DATAMODEL_PROCESS_MODE) current process mode
+    stringandarray->sync_changes : (uint32_t) number of sync state changes
+    stringandarray->sync_changed_nettime : (int32_t) nettime of the last sync state change
+
 logging methods:
     stringandarray->log.error(char *)
     stringandarray->log.warning(char *)
@@ -220,6 +229,10 @@ _BUR_PUBLIC void StringAndArrayCyclic(struct StringAndArrayCyclic *inst)
     }
     inst->Connected = stringandarray->is_connected;
     inst->Operational = stringandarray->is_operational;
+    inst->InSync = stringandarray->is_in_sync;
+    inst->MissedDmrCycles = stringandarray->missed_dmr_cycles;
+    inst->MissedArCycles = stringandarray->missed_ar_cycles;
+    inst->SyncChanges = stringandarray->sync_changes;
 }
 
 UINT _EXIT ProgramExit(unsigned long phase)
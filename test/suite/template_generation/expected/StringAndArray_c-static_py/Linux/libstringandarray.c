@@ -135,6 +135,15 @@ static void libStringAndArray_datasetEvent(exos_dataset_handle_t *dataset, EXOS_
     }
 }
 
+//copy the sync diagnostics of the datamodel to the libStringAndArray_t structure
+static void libStringAndArray_read_sync_info(exos_datamodel_handle_t *datamodel)
+{
+    h_StringAndArray.ext_stringandarray.is_in_sync = datamodel->sync_info.in_sync;
+    h_StringAndArray.ext_stringandarray.missed_dmr_cycles = datamodel->sync_info.missed_dmr_cycles;
+    h_StringAndArray.ext_stringandarray.missed_ar_cycles = datamodel->sync_info.missed_ar_cycles;
+    h_StringAndArray.ext_stringandarray.process_mode = datamodel->sync_info.process_mode;
+}
+
 static void libStringAndArray_datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info)
 {
     switch (event_type)
@@ -178,6 +187,15 @@ static void libStringAndArray_datamodelEvent(exos_datamodel_handle_t *datamodel,
         }
         break;
     case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:
+        INFO("application sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);
+
+        libStringAndArray_read_sync_info(datamodel);
+        h_StringAndArray.ext_stringandarray.sync_changes++;
+        h_StringAndArray.ext_stringandarray.sync_changed_nettime = exos_datamodel_get_nettime(datamodel);
+        if (NULL != h_StringAndArray.ext_stringandarray.on_sync_change)
+        {
+            h_StringAndArray.ext_stringandarray.on_sync_change();
+        }
         break;
 
     default:
@@ -225,6 +243,7 @@ static void libStringAndArray_disconnect(void)
 {
     h_StringAndArray.ext_stringandarray.is_connected = false;
     h_StringAndArray.ext_stringandarray.is_operational = false;
+    h_StringAndArray.ext_stringandarray.is_in_sync = false;
 
     EXOS_ASSERT_OK(exos_datamodel_disconnect(&(h_StringAndArray.stringandarray)));
 }
@@ -237,6 +256,7 @@ static void libStringAndArray_set_operational(void)
 static void libStringAndArray_process(void)
 {
     EXOS_ASSERT_OK(exos_datamodel_process(&(h_StringAndArray.stringandarray)));
+    libStringAndArray_read_sync_info(&(h_StringAndArray.stringandarray));
     exos_log_process(&logger);
 }
 
@@ -244,6 +264,7 @@ static void libStringAndArray_dispose(void)
 {
     h_StringAndArray.ext_stringandarray.is_connected = false;
     h_StringAndArray.ext_stringandarray.is_operational = false;
+    h_StringAndArray.ext_stringandarray.is_in_sync = false;
 
     EXOS_ASSERT_OK(exos_datamodel_delete(&(h_StringAndArray.stringandarray)));
     exos_log_delete(&logger);
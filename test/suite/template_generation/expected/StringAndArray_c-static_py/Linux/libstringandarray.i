@@ -17,6 +17,7 @@ struct StringAndArrayEventHandler
     virtual void on_connected(void) {}
     virtual void on_disconnected(void) {}
     virtual void on_operational(void) {}
+    virtual void on_sync_change(void) {}
 
     virtual void on_change_MyInt1() {}
     virtual void on_change_MyString() {}
@@ -49,6 +50,11 @@ static void libStringAndArray_on_operational()
     pStringAndArrayEventHandler->on_operational();
 }
 
+static void libStringAndArray_on_sync_change()
+{
+    pStringAndArrayEventHandler->on_sync_change();
+}
+
 static void libStringAndArray_on_change_MyInt1()
 {
     pStringAndArrayEventHandler->on_change_MyInt1();
@@ -87,6 +93,7 @@ void add_event_handler(libStringAndArray_t *stringandarray, StringAndArrayEventH
     stringandarray->on_connected = &libStringAndArray_on_connected;
     stringandarray->on_disconnected = &libStringAndArray_on_disconnected;
     stringandarray->on_operational = &libStringAndArray_on_operational;
+    stringandarray->on_sync_change = &libStringAndArray_on_sync_change;
     
     stringandarray->MyInt1.on_change = &libStringAndArray_on_change_MyInt1;
     stringandarray->MyString.on_change = &libStringAndArray_on_change_MyString;
@@ -453,8 +460,17 @@ typedef struct libStringAndArray
     void on_connected(void);
     void on_disconnected(void);
     void on_operational(void);
+    void on_sync_change(void);
     bool is_connected;
     bool is_operational;
+%immutable;
+    bool is_in_sync;
+    uint32_t missed_dmr_cycles;
+    uint32_t missed_ar_cycles;
+    int process_mode;
+    uint32_t sync_changes;
+    int32_t sync_changed_nettime;
+%mutable;
     libStringAndArrayMyInt1_t MyInt1;
     libStringAndArrayMyString_t MyString;
     libStringAndArrayMyInt2_t MyInt2;
@@ -24,11 +24,20 @@ def user callbacks in class StringAndArrayEventHandler:
     on_connected
     on_disconnected
     on_operational
+    on_sync_change
 
 boolean values:
     stringandarray.is_connected
     stringandarray.is_operational
 
+sync diagnostics (read-only, updated in process() and before on_sync_change):
+    stringandarray.is_in_sync : (bool) datamodel is in sync with the DMR
+    stringandarray.missed_dmr_cycles : (uint32_t) cycles missed by the DMR
+    stringandarray.missed_ar_cycles : (uint32_t) cycles missed by AR
+    stringandarray.process_mode : (int) 0 = blocking, 1 = non-blocking
+    stringandarray.sync_changes : (uint32_t) number of sync state changes
+    stringandarray.sync_changed_nettime : (int32_t) nettime of the last sync state change
+
 logging methods:
     stringandarray.log.error(str)
     stringandarray.log.warning(str)
@@ -92,6 +101,9 @@ class StringAndArrayEventHandler(libStringAndArray.StringAndArrayEventHandler):
     # def on_operational(self):
     #     self.stringandarray. ..
 
+    # def on_sync_change(self):
+    #     self.stringandarray.is_in_sync ..
+
     def on_change_MyInt1(self):
         self.stringandarray.log.verbose("python dataset MyInt1 changed!")
         # self.stringandarray.log.debug("on_change: stringandarray.MyInt1: " + str(self.stringandarray.MyInt1.value))
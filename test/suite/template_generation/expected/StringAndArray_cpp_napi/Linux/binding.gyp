@@ -14,7 +14,35 @@
           '-lexos-api',
           '-lzmq'
         ]
-      }
+      },
+      # Build profile and profile-guided optimization, passed by build.sh in the environment
+      "variables": {
+        "exos_build_profile%": "<!(echo ${EXOS_BUILD_PROFILE:-Release})",
+        "exos_march%": "<!(echo ${EXOS_MARCH:-x86-64-v2})",
+        "exos_pgo%": "<!(echo ${EXOS_PGO:-none})",
+        "exos_pgo_dir%": "<!(pwd)/pgo"
+      },
+      "conditions": [
+        ['exos_build_profile=="Debug"', {
+          "cflags!": ["-O3"],
+          "cflags": ["-O0", "-g"]
+        }],
+        ['exos_build_profile=="Release"', {
+          "cflags": ["-flto"],
+          "ldflags": ["-flto", "-O3"]
+        }],
+        ['exos_build_profile=="RelWithDebInfo"', {
+          "cflags!": ["-O3"],
+          "cflags": ["-O2", "-g", "-march=<(exos_march)"]
+        }],
+        ['exos_pgo=="generate"', {
+          "cflags": ["-fprofile-generate=<(exos_pgo_dir)", "-fprofile-update=atomic"],
+          "ldflags": ["-fprofile-generate=<(exos_pgo_dir)"]
+        }],
+        ['exos_pgo=="use"', {
+          "cflags": ["-fprofile-use=<(exos_pgo_dir)", "-fprofile-correction", "-Wno-missing-profile"]
+        }]
+      ]
     }
   ]
 }
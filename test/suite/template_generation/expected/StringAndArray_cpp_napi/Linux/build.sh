@@ -32,6 +32,22 @@ fi
 
 # Checks done, continue with the build
 
+# Build profile, passed as second parameter (after $(EXOS_VERSION) in the .exospkg BuildCommand Arguments):
+#   Debug           no optimization, with debug information
+#   Release         optimized with link time optimization
+#   RelWithDebInfo  optimized for the CPU of the target (EXOS_MARCH), with debug information
+BUILD_PROFILE=${2:-Release}
+case "$BUILD_PROFILE" in
+    Debug|Release|RelWithDebInfo) ;;
+    *)
+        echo "ERROR: Unknown build profile $BUILD_PROFILE, use Debug, Release or RelWithDebInfo"
+        exit 1
+        ;;
+esac
+EXOS_MARCH=${EXOS_MARCH:-x86-64-v2}
+PACKAGE_DIR=$(pwd)
+echo "Build profile: $BUILD_PROFILE"
+
 finalize() {
     cd ..
     rm -rf build/*
@@ -45,14 +61,27 @@ mkdir build > /dev/null 2>&1
 rm -f l_*.node
 rm -f *.deb
 
-npm install
-if [ "$?" -ne 0 ] ; then
-    cd build
+# Build the module, the profile-guided optimization (none, generate or use) is passed as parameter
+compile() {
+    EXOS_PGO=$1 npm install
+    if [ "$?" -ne 0 ] ; then
+        cd build
+
+        finalize 2
+    fi
+
+    cp -f build/Release/l_*.node .
+}
+
+export EXOS_BUILD_PROFILE=$BUILD_PROFILE EXOS_MARCH
 
-    finalize 2
+if [ "$3" = "pgo" ] ; then
+    echo "ERROR: No training workload for the profile-guided optimization of N-API modules, it needs the record or loadgen feature of the C API, C Interface or C++ Class templates"
+    cd "$PACKAGE_DIR/build"
+    finalize 5
 fi
 
-cp -f build/Release/l_*.node .
+compile none
 
 mkdir -p node_modules #make sure the folder exists even if no submodules are needed
 
@@ -47,6 +47,7 @@ typedef struct
     napi_threadsafe_function onchange_cb;
     napi_threadsafe_function connectiononchange_cb;
     napi_threadsafe_function onprocessed_cb; //used only for datamodel
+    napi_threadsafe_function syncchange_cb;  //used only for datamodel
     napi_value object_value; //volatile placeholder.
     napi_value value;        //volatile placeholder.
 } obj_handles;
@@ -77,6 +78,9 @@ obj_handles MyIntStruct1 = {};
 obj_handles MyIntStruct2 = {};
 obj_handles MyEnum1 = {};
 
+static uint32_t stringandarray_sync_changes = 0;
+static int32_t stringandarray_sync_changed_nettime = 0;
+
 napi_deferred deferred = NULL;
 uv_idle_t cyclic_h;
 
@@ -338,6 +342,16 @@ static void datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMO
         }
         break;
     case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:
+        INFO("application StringAndArray sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);
+        stringandarray_sync_changes++;
+        stringandarray_sync_changed_nettime = exos_datamodel_get_nettime(datamodel);
+
+        if (stringandarray.syncchange_cb != NULL)
+        {
+            napi_acquire_threadsafe_function(stringandarray.syncchange_cb);
+            napi_call_threadsafe_function(stringandarray.syncchange_cb, NULL, napi_tsfn_blocking);
+            napi_release_threadsafe_function(stringandarray.syncchange_cb, napi_tsfn_release);
+        }
         break;
 
     default:
@@ -460,6 +474,23 @@ static void stringandarray_connonchange_js_cb(napi_env env, napi_value js_cb, vo
         throw_fatal_exception_callbacks(env, "EINVAL", "Can't call onConnectionChange callback - stringandarray");
 }
 
+static void stringandarray_syncchange_js_cb(napi_env env, napi_value js_cb, void *context, void *data)
+{
+    napi_value in_sync, undefined;
+
+    napi_get_undefined(env, &undefined);
+    napi_get_boolean(env, stringandarray_datamodel.sync_info.in_sync, &in_sync);
+
+    if (napi_ok != napi_get_reference_value(env, stringandarray.ref, &stringandarray.object_value))
+        napi_throw_error(env, "EINVAL", "Can't get reference - stringandarray ");
+
+    if (napi_ok != napi_set_named_property(env, stringandarray.object_value, "isInSync", in_sync))
+        napi_throw_error(env, "EINVAL", "Can't set isInSync property - stringandarray");
+
+    if (napi_ok != napi_call_function(env, undefined, js_cb, 0, NULL, NULL))
+        throw_fatal_exception_callbacks(env, "EINVAL", "Can't call onSyncChange callback - stringandarray");
+}
+
 static void stringandarray_onprocessed_js_cb(napi_env env, napi_value js_cb, void *context, void *data)
 {
     napi_value undefined;
@@ -658,7 +689,7 @@ static void MyString_onchange_js_cb(napi_env env, napi_value js_cb, void *contex
 napi_create_array(env, &MyString.value);
 for (uint32_t i = 0; i < 3; i++)
 {
-        if (napi_ok != napi_create_string_utf8(env, ((char *)ctx->pData)[i], strlen(((char *)ctx->pData)[i]), &arrayItem))
+        if (napi_ok != napi_create_string_utf8(env, ((char (*)[81])ctx->pData)[i], strlen(((char (*)[81])ctx->pData)[i]), &arrayItem))
     {
         napi_throw_error(env, "EINVAL", "Can convert C-variable char* to utf8 string");
     }
@@ -915,6 +946,11 @@ static napi_value stringandarray_connonchange_init(napi_env env, napi_callback_i
     return init_napi_onchange(env, info, "StringAndArray connection change", stringandarray_connonchange_js_cb, &stringandarray.connectiononchange_cb);
 }
 
+static napi_value stringandarray_syncchange_init(napi_env env, napi_callback_info info)
+{
+    return init_napi_onchange(env, info, "StringAndArray sync change", stringandarray_syncchange_js_cb, &stringandarray.syncchange_cb);
+}
+
 static napi_value stringandarray_onprocessed_init(napi_env env, napi_callback_info info)
 {
     return init_napi_onchange(env, info, "StringAndArray onProcessed", stringandarray_onprocessed_js_cb, &stringandarray.onprocessed_cb);
@@ -1371,6 +1407,30 @@ static void cyclic(uv_idle_t * handle)
     exos_log_process(&logger);
 }
 
+//read sync diagnostics for DataModel
+static napi_value get_sync_info(napi_env env, napi_callback_info info)
+{
+    napi_value syncInfo, value;
+
+    if (napi_ok != napi_create_object(env, &syncInfo))
+        return NULL;
+
+    napi_get_boolean(env, stringandarray_datamodel.sync_info.in_sync, &value);
+    napi_set_named_property(env, syncInfo, "inSync", value);
+    napi_create_uint32(env, stringandarray_datamodel.sync_info.missed_dmr_cycles, &value);
+    napi_set_named_property(env, syncInfo, "missedDmrCycles", value);
+    napi_create_uint32(env, stringandarray_datamodel.sync_info.missed_ar_cycles, &value);
+    napi_set_named_property(env, syncInfo, "missedArCycles", value);
+    napi_create_string_utf8(env, stringandarray_datamodel.sync_info.process_mode == EXOS_DATAMODEL_PROCESS_NON_BLOCKING ? "NonBlocking" : "Blocking", NAPI_AUTO_LENGTH, &value);
+    napi_set_named_property(env, syncInfo, "processMode", value);
+    napi_create_uint32(env, stringandarray_sync_changes, &value);
+    napi_set_named_property(env, syncInfo, "syncChanges", value);
+    napi_create_int32(env, stringandarray_sync_changed_nettime, &value);
+    napi_set_named_property(env, syncInfo, "syncChangedNettime", value);
+
+    return syncInfo;
+}
+
 //read nettime for DataModel
 static napi_value get_net_time(napi_env env, napi_callback_info info)
 {
@@ -1389,12 +1449,12 @@ static napi_value get_net_time(napi_env env, napi_callback_info info)
 // init of module, called at "require"
 static napi_value init_stringandarray(napi_env env, napi_value exports)
 {
-    napi_value stringandarray_conn_change, stringandarray_onprocessed, MyInt1_conn_change, MyString_conn_change, MyInt2_conn_change, MyIntStruct_conn_change, MyIntStruct1_conn_change, MyIntStruct2_conn_change, MyEnum1_conn_change;
+    napi_value stringandarray_conn_change, stringandarray_sync_change, stringandarray_onprocessed, MyInt1_conn_change, MyString_conn_change, MyInt2_conn_change, MyIntStruct_conn_change, MyIntStruct1_conn_change, MyIntStruct2_conn_change, MyEnum1_conn_change;
     napi_value MyInt1_onchange, MyString_onchange, MyInt2_onchange, MyIntStruct_onchange, MyIntStruct1_onchange, MyIntStruct2_onchange, MyEnum1_onchange;
     napi_value MyInt2_publish, MyIntStruct_publish, MyIntStruct1_publish, MyIntStruct2_publish, MyEnum1_publish;
     napi_value MyInt1_value, MyString_value, MyInt2_value, MyIntStruct_value, MyIntStruct1_value, MyIntStruct2_value, MyEnum1_value;
 
-    napi_value dataModel, getNetTime, undefined, def_bool, def_number, def_string;
+    napi_value dataModel, getNetTime, getSyncInfo, undefined, def_bool, def_number, def_string;
     napi_value log, logError, logWarning, logSuccess, logInfo, logDebug, logVerbose;
     napi_value object0, object1;
 
@@ -1581,6 +1641,11 @@ MyEnum1_value = def_number;
     napi_set_named_property(env, stringandarray.value, "connectionState", def_string);
     napi_set_named_property(env, stringandarray.value, "isConnected", def_bool);
     napi_set_named_property(env, stringandarray.value, "isOperational", def_bool);
+    napi_create_function(env, NULL, 0, stringandarray_syncchange_init, NULL, &stringandarray_sync_change); 
+    napi_set_named_property(env, stringandarray.value, "onSyncChange", stringandarray_sync_change); 
+    napi_set_named_property(env, stringandarray.value, "isInSync", def_bool);
+    napi_create_function(env, NULL, 0, get_sync_info, NULL, &getSyncInfo);
+    napi_set_named_property(env, stringandarray.value, "syncInfo", getSyncInfo);
     napi_create_function(env, NULL, 0, stringandarray_onprocessed_init, NULL, &stringandarray_onprocessed); 
     napi_set_named_property(env, stringandarray.value, "onProcessed", stringandarray_onprocessed); 
     napi_create_function(env, NULL, 0, get_net_time, NULL, &getNetTime);
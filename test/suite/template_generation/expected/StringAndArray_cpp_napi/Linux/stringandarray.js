@@ -96,12 +96,23 @@
  * @property {StringAndArrayDatamodelLogMethod} debug
  * @property {StringAndArrayDatamodelLogMethod} verbose
  * 
+ * @typedef {Object} StringAndArraySyncInfo
+ * @property {boolean} inSync datamodel is in sync with the DMR
+ * @property {number} missedDmrCycles cycles missed by the DMR
+ * @property {number} missedArCycles cycles missed by AR
+ * @property {string} processMode `Blocking`|`NonBlocking`
+ * @property {number} syncChanges number of sync state changes
+ * @property {number} syncChangedNettime nettime of the last sync state change
+ * 
  * @typedef {Object} StringAndArray
  * @property {function():number} nettime get current nettime
  * @property {StringAndArrayDataModelCallback} onConnectionChange event fired when `connectionState` changes 
  * @property {string} connectionState `Connected`|`Operational`|`Disconnected`|`Aborted` - used in the `onConnectionChange` event
  * @property {boolean} isConnected
  * @property {boolean} isOperational
+ * @property {StringAndArrayDataModelCallback} onSyncChange event fired when the sync state to the DMR changes
+ * @property {boolean} isInSync true if the datamodel is in sync with the DMR - used in the `onSyncChange` event
+ * @property {function():StringAndArraySyncInfo} syncInfo get the current sync diagnostics
  * @property {StringAndArrayDatamodelLog} log
  * @property {StringAndArrayDatamodel} datamodel
  * 
@@ -121,10 +132,17 @@ state change events:
     stringandarray.onConnectionChange(() => {
         stringandarray.connectionState : (string) "Connected", "Operational", "Disconnected" or "Aborted" 
     })
+    stringandarray.onSyncChange(() => {
+        stringandarray.isInSync : (bool) datamodel is in sync with the DMR
+    })
 
 boolean values:
     stringandarray.isConnected
     stringandarray.isOperational
+    stringandarray.isInSync
+
+sync diagnostics:
+    stringandarray.syncInfo() : {inSync, missedDmrCycles, missedArCycles, processMode, syncChanges, syncChangedNettime}
 
 logging methods:
     stringandarray.log.error(string)
@@ -39,7 +39,19 @@ void StringAndArrayDatamodel::setOperational() {
 }
 
 void StringAndArrayDatamodel::process() {
+    // datasets changed with modify(), published once per cycle in declaration order
+    if (isConnected) {
+        publishModified(MyInt1);
+        publishModified(MyString);
+        publishModified(MyInt2);
+        publishModified(MyIntStruct);
+        publishModified(MyIntStruct1);
+        publishModified(MyIntStruct2);
+        publishModified(MyEnum1);
+    }
+
     exos_assert_ok((&log), exos_datamodel_process(&datamodel));
+    readSyncInfo();
     log.process();
 }
 
@@ -47,6 +59,13 @@ int StringAndArrayDatamodel::getNettime() {
     return exos_datamodel_get_nettime(&datamodel);
 }
 
+void StringAndArrayDatamodel::readSyncInfo() {
+    _syncInfo.inSync = datamodel.sync_info.in_sync;
+    _syncInfo.missedDmrCycles = datamodel.sync_info.missed_dmr_cycles;
+    _syncInfo.missedArCycles = datamodel.sync_info.missed_ar_cycles;
+    _syncInfo.processMode = datamodel.sync_info.process_mode;
+}
+
 void StringAndArrayDatamodel::datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info) {
     switch (event_type)
     {
@@ -75,6 +94,11 @@ void StringAndArrayDatamodel::datamodelEvent(exos_datamodel_handle_t *datamodel,
         }
         break;
     case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:
+        log.info << "application sync state changed to " << (datamodel->sync_info.in_sync ? "in sync" : "out of sync") << ", missed DMR cycles: " << datamodel->sync_info.missed_dmr_cycles << ", missed AR cycles: " << datamodel->sync_info.missed_ar_cycles << std::endl;
+        readSyncInfo();
+        _syncInfo.syncChanges++;
+        _syncInfo.syncChangedNettime = exos_datamodel_get_nettime(datamodel);
+        _onSyncChange();
         break;
 
     default:
@@ -6,13 +6,48 @@
 #include <string.h>
 #include <functional>
 #include "StringAndArrayDataset.hpp"
+#include "exos_stringandarray_reflection.hpp"
 
 class StringAndArrayDatamodel
 {
+public:
+    struct SyncInfo
+    {
+        bool inSync = false;
+        uint32_t missedDmrCycles = 0;
+        uint32_t missedArCycles = 0;
+        EXOS_DATAMODEL_PROCESS_MODE processMode = EXOS_DATAMODEL_PROCESS_BLOCKING;
+        uint32_t syncChanges = 0; // number of sync state changes
+        int32_t syncChangedNettime = 0; // nettime of the last sync state change
+    };
+    struct PublishStats
+    {
+        uint32_t published = 0; // modified datasets published by process()
+        uint32_t suppressed = 0; // modified datasets not published by process(), as their value equals the last published value
+    };
+
 private:
     exos_datamodel_handle_t datamodel = {};
+    SyncInfo _syncInfo;
+    PublishStats _publishStats;
     std::function<void()> _onConnectionChange = [](){};
+    std::function<void()> _onSyncChange = [](){};
 
+    void readSyncInfo();
+    template <typename D>
+    void publishModified(D &dataset) {
+        if (!dataset.modified()) {
+            return;
+        }
+        if (dataset.unchanged()) {
+            dataset.discard();
+            _publishStats.suppressed++;
+        }
+        else {
+            dataset.publish();
+            _publishStats.published++;
+        }
+    };
     void datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info);
     static void _datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info) {
         StringAndArrayDatamodel* inst = static_cast<StringAndArrayDatamodel*>(datamodel->user_context);
@@ -27,6 +62,9 @@ public:
     void setOperational();
     int getNettime();
     void onConnectionChange(std::function<void()> f) {_onConnectionChange = std::move(f);};
+    void onSyncChange(std::function<void()> f) {_onSyncChange = std::move(f);};
+    const SyncInfo &syncInfo() const {return _syncInfo;};
+    const PublishStats &publishStats() const {return _publishStats;};
 
     bool isOperational = false;
     bool isConnected = false;
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <string.h>
 #include <functional>
+#include <memory>
 
 extern "C" {
     #include "exos_stringandarray.h"
@@ -32,6 +33,9 @@ private:
     exos_dataset_handle_t dataset = {};
     StringAndArrayLogger* log;
     std::function<void()> _onChange = [](){};
+    bool _modified = false;
+    bool _tracked = false; // modify() was used, keep the last published value
+    std::unique_ptr<uint8_t[]> _published;
     void datasetEvent(exos_dataset_handle_t *dataset, EXOS_DATASET_EVENT_TYPE event_type, void *info) {
         switch (event_type)
         {
@@ -83,8 +87,24 @@ public:
         exos_assert_ok(log, exos_dataset_connect(&dataset, type, &StringAndArrayDataset::_datasetEvent));
     };
     void publish() {
+        _modified = false;
+        if (_tracked) {
+            if (!_published) {
+                _published.reset(new uint8_t[sizeof(T)]);
+            }
+            memcpy(_published.get(), &value, sizeof(T));
+        }
         exos_dataset_publish(&dataset);
     };
+    // the value for writing, marked as modified and published once in the next datamodel process(),
+    // unless it equals the last published value. Writes to value itself are not tracked and need publish()
+    T& modify() {_tracked = true; _modified = true; return value;};
+    void modify(std::function<void(T&)> f) {f(value); _tracked = true; _modified = true;};
+    bool modified() const {return _modified;};
+    // the value equals the last published value, so publishing it again would not change anything
+    bool unchanged() const {return _published && 0 == memcmp(_published.get(), &value, sizeof(T));};
+    // clear the modified mark without publishing
+    void discard() {_modified = false;};
     void onChange(std::function<void()> f) {_onChange = std::move(f);};
     
     ~StringAndArrayDataset() {
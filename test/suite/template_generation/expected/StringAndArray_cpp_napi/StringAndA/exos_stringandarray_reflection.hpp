@@ -0,0 +1,187 @@
+/*Automatically generated reflection header from StringAndArray.typ*/
+
+#ifndef _EXOS_COMP_STRINGANDARRAY_REFLECTION_HPP_
+#define _EXOS_COMP_STRINGANDARRAY_REFLECTION_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+extern "C" {
+    #include "exos_stringandarray.h"
+}
+
+#ifndef _EXOS_REFLECTION_BASE_
+#define _EXOS_REFLECTION_BASE_
+
+namespace exos_reflection {
+
+enum class MemberKind { Scalar, String, Enum, Struct };
+
+struct MemberInfo
+{
+    const char *name;        // member name as declared in the .typ file
+    const char *dataType;    // IEC type (UDINT, LREAL, STRING..) or the name of the struct/enum
+    MemberKind kind;
+    std::size_t offset;      // offsetof() the member within its parent
+    std::size_t size;        // sizeof() the complete member (all array elements)
+    std::size_t elementSize; // sizeof() one array element, equal to size for non-arrays
+    std::size_t arraySize;   // number of array elements, 0 if not an array
+    std::size_t stringLength; // allocated length of a STRING (including terminator), 0 otherwise
+};
+
+struct EnumeratorInfo
+{
+    const char *name;
+    int value;
+};
+
+// specialized for each datamodel struct and enum - the Tag is only used to allow definitions in headers
+template <typename T, typename Tag = void>
+struct TypeInfo
+{
+    static constexpr bool reflected = false;
+};
+
+template <typename T>
+struct is_reflected : std::integral_constant<bool, TypeInfo<typename std::remove_cv<T>::type>::reflected> {};
+
+// call visitor(const MemberInfo &, member) for each member of a datamodel struct
+template <typename T, typename Visitor>
+inline void for_each_member(T &value, Visitor &&visitor)
+{
+    static_assert(is_reflected<T>::value, "for_each_member: type is not part of a generated datamodel");
+    TypeInfo<typename std::remove_cv<T>::type>::forEachMember(value, std::forward<Visitor>(visitor));
+}
+
+} // namespace exos_reflection
+
+#endif // _EXOS_REFLECTION_BASE_
+
+namespace exos_reflection {
+
+template <typename Tag>
+struct TypeInfo<Enum_enum, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "Enum_enum";
+    static constexpr std::size_t size = sizeof(Enum_enum);
+    static constexpr std::size_t enumeratorCount = 2;
+    static constexpr EnumeratorInfo enumerators[2] = {
+        {"enum1", enum1},
+        {"enum2", enum2}
+    };
+};
+
+template <typename Tag> constexpr const char *TypeInfo<Enum_enum, Tag>::name;
+template <typename Tag> constexpr EnumeratorInfo TypeInfo<Enum_enum, Tag>::enumerators[];
+
+template <typename Tag>
+struct TypeInfo<IntStruct2_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "IntStruct2_typ";
+    static constexpr std::size_t size = sizeof(IntStruct2_typ);
+    static constexpr std::size_t memberCount = 3;
+    static constexpr MemberInfo members[3] = {
+        {"MyInt23", "UDINT", MemberKind::Scalar, offsetof(IntStruct2_typ, MyInt23), sizeof(IntStruct2_typ::MyInt23), sizeof(IntStruct2_typ::MyInt23), 0, 0},
+        {"MyInt24", "USINT", MemberKind::Scalar, offsetof(IntStruct2_typ, MyInt24), sizeof(IntStruct2_typ::MyInt24), sizeof(IntStruct2_typ::MyInt24[0]), 4, 0},
+        {"MyInt25", "UDINT", MemberKind::Scalar, offsetof(IntStruct2_typ, MyInt25), sizeof(IntStruct2_typ::MyInt25), sizeof(IntStruct2_typ::MyInt25), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.MyInt23);
+        visitor(members[1], value.MyInt24);
+        visitor(members[2], value.MyInt25);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<IntStruct2_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<IntStruct2_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<IntStruct1_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "IntStruct1_typ";
+    static constexpr std::size_t size = sizeof(IntStruct1_typ);
+    static constexpr std::size_t memberCount = 1;
+    static constexpr MemberInfo members[1] = {
+        {"MyInt13", "UDINT", MemberKind::Scalar, offsetof(IntStruct1_typ, MyInt13), sizeof(IntStruct1_typ::MyInt13), sizeof(IntStruct1_typ::MyInt13), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.MyInt13);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<IntStruct1_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<IntStruct1_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<IntStruct_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "IntStruct_typ";
+    static constexpr std::size_t size = sizeof(IntStruct_typ);
+    static constexpr std::size_t memberCount = 4;
+    static constexpr MemberInfo members[4] = {
+        {"MyInt13", "UDINT", MemberKind::Scalar, offsetof(IntStruct_typ, MyInt13), sizeof(IntStruct_typ::MyInt13), sizeof(IntStruct_typ::MyInt13), 0, 0},
+        {"MyInt14", "USINT", MemberKind::Scalar, offsetof(IntStruct_typ, MyInt14), sizeof(IntStruct_typ::MyInt14), sizeof(IntStruct_typ::MyInt14[0]), 3, 0},
+        {"MyInt133", "UDINT", MemberKind::Scalar, offsetof(IntStruct_typ, MyInt133), sizeof(IntStruct_typ::MyInt133), sizeof(IntStruct_typ::MyInt133), 0, 0},
+        {"MyInt124", "USINT", MemberKind::Scalar, offsetof(IntStruct_typ, MyInt124), sizeof(IntStruct_typ::MyInt124), sizeof(IntStruct_typ::MyInt124[0]), 3, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.MyInt13);
+        visitor(members[1], value.MyInt14);
+        visitor(members[2], value.MyInt133);
+        visitor(members[3], value.MyInt124);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<IntStruct_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<IntStruct_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<StringAndArray, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "StringAndArray";
+    static constexpr std::size_t size = sizeof(StringAndArray);
+    static constexpr std::size_t memberCount = 7;
+    static constexpr MemberInfo members[7] = {
+        {"MyInt1", "UDINT", MemberKind::Scalar, offsetof(StringAndArray, MyInt1), sizeof(StringAndArray::MyInt1), sizeof(StringAndArray::MyInt1), 0, 0},
+        {"MyString", "STRING", MemberKind::String, offsetof(StringAndArray, MyString), sizeof(StringAndArray::MyString), sizeof(StringAndArray::MyString[0]), 3, 81},
+        {"MyInt2", "USINT", MemberKind::Scalar, offsetof(StringAndArray, MyInt2), sizeof(StringAndArray::MyInt2), sizeof(StringAndArray::MyInt2[0]), 5, 0},
+        {"MyIntStruct", "IntStruct_typ", MemberKind::Struct, offsetof(StringAndArray, MyIntStruct), sizeof(StringAndArray::MyIntStruct), sizeof(StringAndArray::MyIntStruct[0]), 6, 0},
+        {"MyIntStruct1", "IntStruct1_typ", MemberKind::Struct, offsetof(StringAndArray, MyIntStruct1), sizeof(StringAndArray::MyIntStruct1), sizeof(StringAndArray::MyIntStruct1), 0, 0},
+        {"MyIntStruct2", "IntStruct2_typ", MemberKind::Struct, offsetof(StringAndArray, MyIntStruct2), sizeof(StringAndArray::MyIntStruct2), sizeof(StringAndArray::MyIntStruct2), 0, 0},
+        {"MyEnum1", "Enum_enum", MemberKind::Enum, offsetof(StringAndArray, MyEnum1), sizeof(StringAndArray::MyEnum1), sizeof(StringAndArray::MyEnum1), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.MyInt1);
+        visitor(members[1], value.MyString);
+        visitor(members[2], value.MyInt2);
+        visitor(members[3], value.MyIntStruct);
+        visitor(members[4], value.MyIntStruct1);
+        visitor(members[5], value.MyIntStruct2);
+        visitor(members[6], value.MyEnum1);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<StringAndArray, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<StringAndArray, Tag>::members[];
+
+} // namespace exos_reflection
+
+#endif // _EXOS_COMP_STRINGANDARRAY_REFLECTION_HPP_
@@ -16,11 +16,26 @@ void(void) user lambda callback:
     stringandarray->onConnectionChange([&] () {
         // stringandarray->connectionState ...
     })
+    stringandarray->onSyncChange([&] () {
+        // stringandarray->syncInfo().inSync ...
+    })
 
 boolean values:
     stringandarray->isConnected
     stringandarray->isOperational
 
+sync diagnostics (updated in process() and before onSyncChange):
+    stringandarray->syncInfo().inSync : (bool) datamodel is in sync with the DMR
+    stringandarray->syncInfo().missedDmrCycles : (uint32_t) cycles missed by the DMR
+    stringandarray->syncInfo().missedArCycles : (uint32_t) cycles missed by AR
+    stringandarray->syncInfo().processMode : (EXOS_DATAMODEL_PROCESS_MODE) current process mode
+    stringandarray->syncInfo().syncChanges : (uint32_t) number of sync state changes
+    stringandarray->syncInfo().syncChangedNettime : (int32_t) nettime of the last sync state change
+
+publish on modify (datasets changed with modify() are published once in the next process(), if their value changed):
+    stringandarray->publishStats().published : (uint32_t) modified datasets published by process()
+    stringandarray->publishStats().suppressed : (uint32_t) modified datasets not published, as their value equals the last published value
+
 logging methods:
     stringandarray->log.error << "some value:" << 1 << std::endl;
     stringandarray->log.warning << "some value:" << 1 << std::endl;
@@ -29,16 +44,27 @@ logging methods:
     stringandarray->log.debug << "some value:" << 1 << std::endl;
     stringandarray->log.verbose << "some value:" << 1 << std::endl;
 
+type reflection:
+    exos_reflection::for_each_member(stringandarray-><dataset>.value, [&] (const exos_reflection::MemberInfo &member, auto &field) {
+        // member.name, member.offset, member.arraySize ...
+    })
+
 dataset MyInt1:
     stringandarray->MyInt1.publish()
+    stringandarray->MyInt1.modify() : value for writing, published once in the next process() if it changed
+        (compared with the last published value, writes to value itself are not tracked)
     stringandarray->MyInt1.value : (uint32_t)  actual dataset value
 
 dataset MyString:
     stringandarray->MyString.publish()
+    stringandarray->MyString.modify() : value for writing, published once in the next process() if it changed
+        (compared with the last published value, writes to value itself are not tracked)
     stringandarray->MyString.value : (char[3][81])  actual dataset value
 
 dataset MyInt2:
     stringandarray->MyInt2.publish()
+    stringandarray->MyInt2.modify() : value for writing, published once in the next process() if it changed
+        (compared with the last published value, writes to value itself are not tracked)
     stringandarray->MyInt2.onChange([&] () {
         stringandarray->MyInt2.value ...
     })
@@ -47,6 +73,8 @@ dataset MyInt2:
 
 dataset MyIntStruct:
     stringandarray->MyIntStruct.publish()
+    stringandarray->MyIntStruct.modify() : value for writing, published once in the next process() if it changed
+        (compared with the last published value, writes to value itself are not tracked)
     stringandarray->MyIntStruct.onChange([&] () {
         stringandarray->MyIntStruct.value ...
     })
@@ -55,6 +83,8 @@ dataset MyIntStruct:
 
 dataset MyIntStruct1:
     stringandarray->MyIntStruct1.publish()
+    stringandarray->MyIntStruct1.modify() : value for writing, published once in the next process() if it changed
+        (compared with the last published value, writes to value itself are not tracked)
     stringandarray->MyIntStruct1.onChange([&] () {
         stringandarray->MyIntStruct1.value ...
     })
@@ -63,6 +93,8 @@ dataset MyIntStruct1:
 
 dataset MyIntStruct2:
     stringandarray->MyIntStruct2.publish()
+    stringandarray->MyIntStruct2.modify() : value for writing, published once in the next process() if it changed
+        (compared with the last published value, writes to value itself are not tracked)
     stringandarray->MyIntStruct2.onChange([&] () {
         stringandarray->MyIntStruct2.value ...
     })
@@ -71,6 +103,8 @@ dataset MyIntStruct2:
 
 dataset MyEnum1:
     stringandarray->MyEnum1.publish()
+    stringandarray->MyEnum1.modify() : value for writing, published once in the next process() if it changed
+        (compared with the last published value, writes to value itself are not tracked)
     stringandarray->MyEnum1.onChange([&] () {
         stringandarray->MyEnum1.value ...
     })
@@ -188,6 +222,10 @@ _BUR_PUBLIC void StringAndArrayCyclic(struct StringAndArrayCyclic *inst)
 
     inst->Connected = stringandarray->isConnected;
     inst->Operational = stringandarray->isOperational;
+    inst->InSync = stringandarray->syncInfo().inSync;
+    inst->MissedDmrCycles = stringandarray->syncInfo().missedDmrCycles;
+    inst->MissedArCycles = stringandarray->syncInfo().missedArCycles;
+    inst->SyncChanges = stringandarray->syncInfo().syncChanges;
 }
 
 _BUR_PUBLIC void StringAndArrayExit(struct StringAndArrayExit *inst)
@@ -120,6 +120,10 @@ static void datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMO
         }
         break;
     case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:
+        INFO("application sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);
+
+        inst->InSync = datamodel->sync_info.in_sync;
+        inst->SyncChanges++;
         break;
 
     default:
@@ -228,6 +232,7 @@ _BUR_PUBLIC void ros_topics_typCyclic(struct ros_topics_typCyclic *inst)
         inst->Connected = 0;
         inst->Operational = 0;
         inst->Aborted = 0;
+        inst->InSync = 0;
 
         if (inst->Enable)
         {
@@ -265,6 +270,9 @@ _BUR_PUBLIC void ros_topics_typCyclic(struct ros_topics_typCyclic *inst)
         }
 
         EXOS_ASSERT_OK(exos_datamodel_process(ros_topics_typ_datamodel));
+        inst->InSync = ros_topics_typ_datamodel->sync_info.in_sync;
+        inst->MissedDmrCycles = ros_topics_typ_datamodel->sync_info.missed_dmr_cycles;
+        inst->MissedArCycles = ros_topics_typ_datamodel->sync_info.missed_ar_cycles;
         //put your cyclic code here!
 
         //publish the odemetry_dataset dataset as soon as there are changes
@@ -0,0 +1,357 @@
+/*Automatically generated reflection header from ros_topics_typ.typ*/
+
+#ifndef _EXOS_COMP_ROS_TOPICS_TYP_REFLECTION_HPP_
+#define _EXOS_COMP_ROS_TOPICS_TYP_REFLECTION_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+extern "C" {
+    #include "exos_ros_topics_typ.h"
+}
+
+#ifndef _EXOS_REFLECTION_BASE_
+#define _EXOS_REFLECTION_BASE_
+
+namespace exos_reflection {
+
+enum class MemberKind { Scalar, String, Enum, Struct };
+
+struct MemberInfo
+{
+    const char *name;        // member name as declared in the .typ file
+    const char *dataType;    // IEC type (UDINT, LREAL, STRING..) or the name of the struct/enum
+    MemberKind kind;
+    std::size_t offset;      // offsetof() the member within its parent
+    std::size_t size;        // sizeof() the complete member (all array elements)
+    std::size_t elementSize; // sizeof() one array element, equal to size for non-arrays
+    std::size_t arraySize;   // number of array elements, 0 if not an array
+    std::size_t stringLength; // allocated length of a STRING (including terminator), 0 otherwise
+};
+
+struct EnumeratorInfo
+{
+    const char *name;
+    int value;
+};
+
+// specialized for each datamodel struct and enum - the Tag is only used to allow definitions in headers
+template <typename T, typename Tag = void>
+struct TypeInfo
+{
+    static constexpr bool reflected = false;
+};
+
+template <typename T>
+struct is_reflected : std::integral_constant<bool, TypeInfo<typename std::remove_cv<T>::type>::reflected> {};
+
+// call visitor(const MemberInfo &, member) for each member of a datamodel struct
+template <typename T, typename Visitor>
+inline void for_each_member(T &value, Visitor &&visitor)
+{
+    static_assert(is_reflected<T>::value, "for_each_member: type is not part of a generated datamodel");
+    TypeInfo<typename std::remove_cv<T>::type>::forEachMember(value, std::forward<Visitor>(visitor));
+}
+
+} // namespace exos_reflection
+
+#endif // _EXOS_REFLECTION_BASE_
+
+namespace exos_reflection {
+
+template <typename Tag>
+struct TypeInfo<ros_config_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_config_typ";
+    static constexpr std::size_t size = sizeof(ros_config_typ);
+    static constexpr std::size_t memberCount = 3;
+    static constexpr MemberInfo members[3] = {
+        {"maxSpeed", "LREAL", MemberKind::Scalar, offsetof(ros_config_typ, maxSpeed), sizeof(ros_config_typ::maxSpeed), sizeof(ros_config_typ::maxSpeed), 0, 0},
+        {"minSpeed", "LREAL", MemberKind::Scalar, offsetof(ros_config_typ, minSpeed), sizeof(ros_config_typ::minSpeed), sizeof(ros_config_typ::minSpeed), 0, 0},
+        {"baseWidth", "LREAL", MemberKind::Scalar, offsetof(ros_config_typ, baseWidth), sizeof(ros_config_typ::baseWidth), sizeof(ros_config_typ::baseWidth), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.maxSpeed);
+        visitor(members[1], value.minSpeed);
+        visitor(members[2], value.baseWidth);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_config_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_config_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_vector3_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_vector3_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_vector3_typ);
+    static constexpr std::size_t memberCount = 3;
+    static constexpr MemberInfo members[3] = {
+        {"y", "LREAL", MemberKind::Scalar, offsetof(ros_topic_vector3_typ, y), sizeof(ros_topic_vector3_typ::y), sizeof(ros_topic_vector3_typ::y), 0, 0},
+        {"z", "LREAL", MemberKind::Scalar, offsetof(ros_topic_vector3_typ, z), sizeof(ros_topic_vector3_typ::z), sizeof(ros_topic_vector3_typ::z), 0, 0},
+        {"x", "LREAL", MemberKind::Scalar, offsetof(ros_topic_vector3_typ, x), sizeof(ros_topic_vector3_typ::x), sizeof(ros_topic_vector3_typ::x), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.y);
+        visitor(members[1], value.z);
+        visitor(members[2], value.x);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_vector3_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_vector3_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_twist_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_twist_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_twist_typ);
+    static constexpr std::size_t memberCount = 2;
+    static constexpr MemberInfo members[2] = {
+        {"angular", "ros_topic_vector3_typ", MemberKind::Struct, offsetof(ros_topic_twist_typ, angular), sizeof(ros_topic_twist_typ::angular), sizeof(ros_topic_twist_typ::angular), 0, 0},
+        {"linear", "ros_topic_vector3_typ", MemberKind::Struct, offsetof(ros_topic_twist_typ, linear), sizeof(ros_topic_twist_typ::linear), sizeof(ros_topic_twist_typ::linear), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.angular);
+        visitor(members[1], value.linear);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_twist_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_twist_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_time_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_time_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_time_typ);
+    static constexpr std::size_t memberCount = 2;
+    static constexpr MemberInfo members[2] = {
+        {"nsec", "UDINT", MemberKind::Scalar, offsetof(ros_topic_time_typ, nsec), sizeof(ros_topic_time_typ::nsec), sizeof(ros_topic_time_typ::nsec), 0, 0},
+        {"sec", "UDINT", MemberKind::Scalar, offsetof(ros_topic_time_typ, sec), sizeof(ros_topic_time_typ::sec), sizeof(ros_topic_time_typ::sec), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.nsec);
+        visitor(members[1], value.sec);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_time_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_time_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_header_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_header_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_header_typ);
+    static constexpr std::size_t memberCount = 3;
+    static constexpr MemberInfo members[3] = {
+        {"stamp", "ros_topic_time_typ", MemberKind::Struct, offsetof(ros_topic_header_typ, stamp), sizeof(ros_topic_header_typ::stamp), sizeof(ros_topic_header_typ::stamp), 0, 0},
+        {"seq", "UDINT", MemberKind::Scalar, offsetof(ros_topic_header_typ, seq), sizeof(ros_topic_header_typ::seq), sizeof(ros_topic_header_typ::seq), 0, 0},
+        {"frame_id", "STRING", MemberKind::String, offsetof(ros_topic_header_typ, frame_id), sizeof(ros_topic_header_typ::frame_id), sizeof(ros_topic_header_typ::frame_id), 0, 21}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.stamp);
+        visitor(members[1], value.seq);
+        visitor(members[2], value.frame_id);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_header_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_header_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_twistCor_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_twistCor_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_twistCor_typ);
+    static constexpr std::size_t memberCount = 2;
+    static constexpr MemberInfo members[2] = {
+        {"twist", "ros_topic_twist_typ", MemberKind::Struct, offsetof(ros_topic_twistCor_typ, twist), sizeof(ros_topic_twistCor_typ::twist), sizeof(ros_topic_twistCor_typ::twist), 0, 0},
+        {"covariance", "LREAL", MemberKind::Scalar, offsetof(ros_topic_twistCor_typ, covariance), sizeof(ros_topic_twistCor_typ::covariance), sizeof(ros_topic_twistCor_typ::covariance[0]), 64, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.twist);
+        visitor(members[1], value.covariance);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_twistCor_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_twistCor_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_quaternion_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_quaternion_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_quaternion_typ);
+    static constexpr std::size_t memberCount = 4;
+    static constexpr MemberInfo members[4] = {
+        {"y", "LREAL", MemberKind::Scalar, offsetof(ros_topic_quaternion_typ, y), sizeof(ros_topic_quaternion_typ::y), sizeof(ros_topic_quaternion_typ::y), 0, 0},
+        {"z", "LREAL", MemberKind::Scalar, offsetof(ros_topic_quaternion_typ, z), sizeof(ros_topic_quaternion_typ::z), sizeof(ros_topic_quaternion_typ::z), 0, 0},
+        {"w", "LREAL", MemberKind::Scalar, offsetof(ros_topic_quaternion_typ, w), sizeof(ros_topic_quaternion_typ::w), sizeof(ros_topic_quaternion_typ::w), 0, 0},
+        {"x", "LREAL", MemberKind::Scalar, offsetof(ros_topic_quaternion_typ, x), sizeof(ros_topic_quaternion_typ::x), sizeof(ros_topic_quaternion_typ::x), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.y);
+        visitor(members[1], value.z);
+        visitor(members[2], value.w);
+        visitor(members[3], value.x);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_quaternion_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_quaternion_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_point_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_point_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_point_typ);
+    static constexpr std::size_t memberCount = 3;
+    static constexpr MemberInfo members[3] = {
+        {"y", "LREAL", MemberKind::Scalar, offsetof(ros_topic_point_typ, y), sizeof(ros_topic_point_typ::y), sizeof(ros_topic_point_typ::y), 0, 0},
+        {"z", "LREAL", MemberKind::Scalar, offsetof(ros_topic_point_typ, z), sizeof(ros_topic_point_typ::z), sizeof(ros_topic_point_typ::z), 0, 0},
+        {"x", "LREAL", MemberKind::Scalar, offsetof(ros_topic_point_typ, x), sizeof(ros_topic_point_typ::x), sizeof(ros_topic_point_typ::x), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.y);
+        visitor(members[1], value.z);
+        visitor(members[2], value.x);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_point_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_point_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_pose_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_pose_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_pose_typ);
+    static constexpr std::size_t memberCount = 2;
+    static constexpr MemberInfo members[2] = {
+        {"position", "ros_topic_point_typ", MemberKind::Struct, offsetof(ros_topic_pose_typ, position), sizeof(ros_topic_pose_typ::position), sizeof(ros_topic_pose_typ::position), 0, 0},
+        {"orientation", "ros_topic_quaternion_typ", MemberKind::Struct, offsetof(ros_topic_pose_typ, orientation), sizeof(ros_topic_pose_typ::orientation), sizeof(ros_topic_pose_typ::orientation), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.position);
+        visitor(members[1], value.orientation);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_pose_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_pose_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_poseCor_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_poseCor_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_poseCor_typ);
+    static constexpr std::size_t memberCount = 2;
+    static constexpr MemberInfo members[2] = {
+        {"pose", "ros_topic_pose_typ", MemberKind::Struct, offsetof(ros_topic_poseCor_typ, pose), sizeof(ros_topic_poseCor_typ::pose), sizeof(ros_topic_poseCor_typ::pose), 0, 0},
+        {"covariance", "LREAL", MemberKind::Scalar, offsetof(ros_topic_poseCor_typ, covariance), sizeof(ros_topic_poseCor_typ::covariance), sizeof(ros_topic_poseCor_typ::covariance[0]), 64, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.pose);
+        visitor(members[1], value.covariance);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_poseCor_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_poseCor_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topic_odemety_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topic_odemety_typ";
+    static constexpr std::size_t size = sizeof(ros_topic_odemety_typ);
+    static constexpr std::size_t memberCount = 3;
+    static constexpr MemberInfo members[3] = {
+        {"pose", "ros_topic_poseCor_typ", MemberKind::Struct, offsetof(ros_topic_odemety_typ, pose), sizeof(ros_topic_odemety_typ::pose), sizeof(ros_topic_odemety_typ::pose), 0, 0},
+        {"twist", "ros_topic_twistCor_typ", MemberKind::Struct, offsetof(ros_topic_odemety_typ, twist), sizeof(ros_topic_odemety_typ::twist), sizeof(ros_topic_odemety_typ::twist), 0, 0},
+        {"header", "ros_topic_header_typ", MemberKind::Struct, offsetof(ros_topic_odemety_typ, header), sizeof(ros_topic_odemety_typ::header), sizeof(ros_topic_odemety_typ::header), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.pose);
+        visitor(members[1], value.twist);
+        visitor(members[2], value.header);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topic_odemety_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topic_odemety_typ, Tag>::members[];
+
+template <typename Tag>
+struct TypeInfo<ros_topics_typ, Tag>
+{
+    static constexpr bool reflected = true;
+    static constexpr const char *name = "ros_topics_typ";
+    static constexpr std::size_t size = sizeof(ros_topics_typ);
+    static constexpr std::size_t memberCount = 3;
+    static constexpr MemberInfo members[3] = {
+        {"odemetry", "ros_topic_odemety_typ", MemberKind::Struct, offsetof(ros_topics_typ, odemetry), sizeof(ros_topics_typ::odemetry), sizeof(ros_topics_typ::odemetry), 0, 0},
+        {"twist", "ros_topic_twist_typ", MemberKind::Struct, offsetof(ros_topics_typ, twist), sizeof(ros_topics_typ::twist), sizeof(ros_topics_typ::twist), 0, 0},
+        {"config", "ros_config_typ", MemberKind::Struct, offsetof(ros_topics_typ, config), sizeof(ros_topics_typ::config), sizeof(ros_topics_typ::config), 0, 0}
+    };
+
+    template <typename S, typename Visitor>
+    static void forEachMember(S &value, Visitor &&visitor)
+    {
+        visitor(members[0], value.odemetry);
+        visitor(members[1], value.twist);
+        visitor(members[2], value.config);
+    }
+};
+
+template <typename Tag> constexpr const char *TypeInfo<ros_topics_typ, Tag>::name;
+template <typename Tag> constexpr MemberInfo TypeInfo<ros_topics_typ, Tag>::members[];
+
+} // namespace exos_reflection
+
+#endif // _EXOS_COMP_ROS_TOPICS_TYP_REFLECTION_HPP_
@@ -31,7 +31,14 @@ void ros_topics_typDatamodel::setOperational() {
 }
 
 void ros_topics_typDatamodel::process() {
+    // datasets changed with modify(), published once per cycle in declaration order
+    if (isConnected) {
+        publishModified(twist);
+        publishModified(config);
+    }
+
     exos_assert_ok((&log), exos_datamodel_process(&datamodel));
+    readSyncInfo();
     log.process();
 }
 
@@ -39,6 +46,13 @@ int ros_topics_typDatamodel::getNettime() {
     return exos_datamodel_get_nettime(&datamodel);
 }
 
+void ros_topics_typDatamodel::readSyncInfo() {
+    _syncInfo.inSync = datamodel.sync_info.in_sync;
+    _syncInfo.missedDmrCycles = datamodel.sync_info.missed_dmr_cycles;
+    _syncInfo.missedArCycles = datamodel.sync_info.missed_ar_cycles;
+    _syncInfo.processMode = datamodel.sync_info.process_mode;
+}
+
 void ros_topics_typDatamodel::datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info) {
     switch (event_type)
     {
@@ -67,6 +81,11 @@ void ros_topics_typDatamodel::datamodelEvent(exos_datamodel_handle_t *datamodel,
         }
         break;
     case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:
+        log.info << "application sync state changed to " << (datamodel->sync_info.in_sync ? "in sync" : "out of sync") << ", missed DMR cycles: " << datamodel->sync_info.missed_dmr_cycles << ", missed AR cycles: " << datamodel->sync_info.missed_ar_cycles << std::endl;
+        readSyncInfo();
+        _syncInfo.syncChanges++;
+        _syncInfo.syncChangedNettime = exos_datamodel_get_nettime(datamodel);
+        _onSyncChange();
         break;
 
     default:
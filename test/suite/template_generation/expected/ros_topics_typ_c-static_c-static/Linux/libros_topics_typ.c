@@ -65,6 +65,15 @@ static void libros_topics_typ_datasetEvent(exos_dataset_handle_t *dataset, EXOS_
     }
 }
 
+//copy the sync diagnostics of the datamodel to the libros_topics_typ_t structure
+static void libros_topics_typ_read_sync_info(exos_datamodel_handle_t *datamodel)
+{
+    h_ros_topics_typ.ext_ros_topics_typ_datamodel.is_in_sync = datamodel->sync_info.in_sync;
+    h_ros_topics_typ.ext_ros_topics_typ_datamodel.missed_dmr_cycles = datamodel->sync_info.missed_dmr_cycles;
+    h_ros_topics_typ.ext_ros_topics_typ_datamodel.missed_ar_cycles = datamodel->sync_info.missed_ar_cycles;
+    h_ros_topics_typ.ext_ros_topics_typ_datamodel.process_mode = datamodel->sync_info.process_mode;
+}
+
 static void libros_topics_typ_datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMODEL_EVENT_TYPE event_type, void *info)
 {
     switch (event_type)
@@ -108,6 +117,15 @@ static void libros_topics_typ_datamodelEvent(exos_datamodel_handle_t *datamodel,
         }
         break;
     case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:
+        INFO("application sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);
+
+        libros_topics_typ_read_sync_info(datamodel);
+        h_ros_topics_typ.ext_ros_topics_typ_datamodel.sync_changes++;
+        h_ros_topics_typ.ext_ros_topics_typ_datamodel.sync_changed_nettime = exos_datamodel_get_nettime(datamodel);
+        if (NULL != h_ros_topics_typ.ext_ros_topics_typ_datamodel.on_sync_change)
+        {
+            h_ros_topics_typ.ext_ros_topics_typ_datamodel.on_sync_change();
+        }
         break;
 
     default:
@@ -139,6 +157,7 @@ static void libros_topics_typ_disconnect(void)
 {
     h_ros_topics_typ.ext_ros_topics_typ_datamodel.is_connected = false;
     h_ros_topics_typ.ext_ros_topics_typ_datamodel.is_operational = false;
+    h_ros_topics_typ.ext_ros_topics_typ_datamodel.is_in_sync = false;
 
     EXOS_ASSERT_OK(exos_datamodel_disconnect(&(h_ros_topics_typ.ros_topics_typ_datamodel)));
 }
@@ -151,6 +170,7 @@ static void libros_topics_typ_set_operational(void)
 static void libros_topics_typ_process(void)
 {
     EXOS_ASSERT_OK(exos_datamodel_process(&(h_ros_topics_typ.ros_topics_typ_datamodel)));
+    libros_topics_typ_read_sync_info(&(h_ros_topics_typ.ros_topics_typ_datamodel));
     exos_log_process(&logger);
 }
 
@@ -158,6 +178,7 @@ static void libros_topics_typ_dispose(void)
 {
     h_ros_topics_typ.ext_ros_topics_typ_datamodel.is_connected = false;
     h_ros_topics_typ.ext_ros_topics_typ_datamodel.is_operational = false;
+    h_ros_topics_typ.ext_ros_topics_typ_datamodel.is_in_sync = false;
 
     EXOS_ASSERT_OK(exos_datamodel_delete(&(h_ros_topics_typ.ros_topics_typ_datamodel)));
     exos_log_delete(&logger);
@@ -49,8 +49,15 @@ typedef struct libros_topics_typ
     libros_topics_typ_event_cb on_connected;
     libros_topics_typ_event_cb on_disconnected;
     libros_topics_typ_event_cb on_operational;
+    libros_topics_typ_event_cb on_sync_change;
     bool is_connected;
     bool is_operational;
+    bool is_in_sync;
+    uint32_t missed_dmr_cycles;
+    uint32_t missed_ar_cycles;
+    EXOS_DATAMODEL_PROCESS_MODE process_mode;
+    uint32_t sync_changes;
+    int32_t sync_changed_nettime;
     libros_topics_typodemetry_t odemetry;
     libros_topics_typtwist_t twist;
     libros_topics_typconfig_t config;
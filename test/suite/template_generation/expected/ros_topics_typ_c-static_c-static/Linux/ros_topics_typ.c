@@ -17,11 +17,20 @@ void(void) user callbacks:
     ros_topics_typ_datamodel->on_connected
     ros_topics_typ_datamodel->on_disconnected
     ros_topics_typ_datamodel->on_operational
+    ros_topics_typ_datamodel->on_sync_change
 
 boolean values:
     ros_topics_typ_datamodel->is_connected
     ros_topics_typ_datamodel->is_operational
 
+sync diagnostics (updated in process() and before on_sync_change):
+    ros_topics_typ_datamodel->is_in_sync : (bool) datamodel is in sync with the DMR
+    ros_topics_typ_datamodel->missed_dmr_cycles : (uint32_t) cycles missed by the DMR
+    ros_topics_typ_datamodel->missed_ar_cycles : (uint32_t) cycles missed by AR
+    ros_topics_typ_datamodel->process_mode : (EXOS_DATAMODEL_PROCESS_MODE) current process mode
+    ros_topics_typ_datamodel->sync_changes : (uint32_t) number of sync state changes
+    ros_topics_typ_datamodel->sync_changed_nettime : (int32_t) nettime of the last sync state change
+
 logging methods:
     ros_topics_typ_datamodel->log.error(char *)
     ros_topics_typ_datamodel->log.warning(char *)
@@ -32,6 +32,22 @@ fi
 
 # Checks done, continue with the build
 
+# Build profile, passed as second parameter (after $(EXOS_VERSION) in the .exospkg BuildCommand Arguments):
+#   Debug           no optimization, with debug information
+#   Release         optimized with link time optimization
+#   RelWithDebInfo  optimized for the CPU of the target (EXOS_MARCH), with debug information
+BUILD_PROFILE=${2:-Release}
+case "$BUILD_PROFILE" in
+    Debug|Release|RelWithDebInfo) ;;
+    *)
+        echo "ERROR: Unknown build profile $BUILD_PROFILE, use Debug, Release or RelWithDebInfo"
+        exit 1
+        ;;
+esac
+EXOS_MARCH=${EXOS_MARCH:-x86-64-v2}
+PACKAGE_DIR=$(pwd)
+echo "Build profile: $BUILD_PROFILE"
+
 finalize() {
     cd ..
     rm -rf build/*
@@ -45,16 +61,31 @@ rm -rf build/*
 
 cd build
 
-cmake -Wno-dev ..
-if [ "$?" -ne 0 ] ; then
-    finalize 2
-fi
+# Build in the build folder, the profile-guided optimization (none, generate or use) is passed as parameter
+compile() {
+    rm -rf ./*
+    cmake -Wno-dev -DEXOS_BUILD_PROFILE=$BUILD_PROFILE -DEXOS_MARCH=$EXOS_MARCH ..
+    if [ "$?" -ne 0 ] ; then
+        finalize 2
+    fi
 
-make
-if [ "$?" -ne 0 ] ; then
-    finalize 3
+    make
+    if [ "$?" -ne 0 ] ; then
+        finalize 3
+    fi
+
+    cp -f _libros_topics_typ.so ..
+    cp -f libros_topics_typ.py ..
+}
+
+if [ "$3" = "pgo" ] ; then
+    echo "ERROR: No training workload for the profile-guided optimization of SWIG Python modules, generate the component with the record feature (replay of a recording)"
+    cd "$PACKAGE_DIR/build"
+    finalize 5
 fi
 
+compile none
+
 cpack
 if [ "$?" -ne 0 ] ; then
     finalize 4
@@ -62,8 +93,4 @@ fi
 
 cp -f exos-comp-ros_topics_typ_1.0.0_amd64.deb ..
 
-cp -f _libros_topics_typ.so ..
-
-cp -f libros_topics_typ.py ..
-
 finalize 0
@@ -17,6 +17,7 @@ struct ros_topics_typEventHandler
     virtual void on_connected(void) {}
     virtual void on_disconnected(void) {}
     virtual void on_operational(void) {}
+    virtual void on_sync_change(void) {}
 
     virtual void on_change_odemetry() {}
 
@@ -43,6 +44,11 @@ static void libros_topics_typ_on_operational()
     pros_topics_typEventHandler->on_operational();
 }
 
+static void libros_topics_typ_on_sync_change()
+{
+    pros_topics_typEventHandler->on_sync_change();
+}
+
 static void libros_topics_typ_on_change_odemetry()
 {
     pros_topics_typEventHandler->on_change_odemetry();
@@ -57,6 +63,7 @@ void add_event_handler(libros_topics_typ_t *ros_topics_typ_datamodel, ros_topics
     ros_topics_typ_datamodel->on_connected = &libros_topics_typ_on_connected;
     ros_topics_typ_datamodel->on_disconnected = &libros_topics_typ_on_disconnected;
     ros_topics_typ_datamodel->on_operational = &libros_topics_typ_on_operational;
+    ros_topics_typ_datamodel->on_sync_change = &libros_topics_typ_on_sync_change;
     
     ros_topics_typ_datamodel->odemetry.on_change = &libros_topics_typ_on_change_odemetry;
     
@@ -283,8 +290,17 @@ typedef struct libros_topics_typ
     void on_connected(void);
     void on_disconnected(void);
     void on_operational(void);
+    void on_sync_change(void);
     bool is_connected;
     bool is_operational;
+%immutable;
+    bool is_in_sync;
+    uint32_t missed_dmr_cycles;
+    uint32_t missed_ar_cycles;
+    int process_mode;
+    uint32_t sync_changes;
+    int32_t sync_changed_nettime;
+%mutable;
     libros_topics_typodemetry_t odemetry;
     libros_topics_typtwist_t twist;
     libros_topics_typconfig_t config;
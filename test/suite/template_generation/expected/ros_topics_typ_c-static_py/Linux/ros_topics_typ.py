@@ -24,11 +24,20 @@ def user callbacks in class ros_topics_typEventHandler:
     on_connected
     on_disconnected
     on_operational
+    on_sync_change
 
 boolean values:
     ros_topics_typ_datamodel.is_connected
     ros_topics_typ_datamodel.is_operational
 
+sync diagnostics (read-only, updated in process() and before on_sync_change):
+    ros_topics_typ_datamodel.is_in_sync : (bool) datamodel is in sync with the DMR
+    ros_topics_typ_datamodel.missed_dmr_cycles : (uint32_t) cycles missed by the DMR
+    ros_topics_typ_datamodel.missed_ar_cycles : (uint32_t) cycles missed by AR
+    ros_topics_typ_datamodel.process_mode : (int) 0 = blocking, 1 = non-blocking
+    ros_topics_typ_datamodel.sync_changes : (uint32_t) number of sync state changes
+    ros_topics_typ_datamodel.sync_changed_nettime : (int32_t) nettime of the last sync state change
+
 logging methods:
     ros_topics_typ_datamodel.log.error(str)
     ros_topics_typ_datamodel.log.warning(str)
@@ -65,6 +74,9 @@ class ros_topics_typEventHandler(libros_topics_typ.ros_topics_typEventHandler):
     # def on_operational(self):
     #     self.ros_topics_typ_datamodel. ..
 
+    # def on_sync_change(self):
+    #     self.ros_topics_typ_datamodel.is_in_sync ..
+
     def on_change_odemetry(self):
         self.ros_topics_typ_datamodel.log.verbose("python dataset odemetry changed!")
         # self.ros_topics_typ_datamodel.log.debug("on_change: ros_topics_typ_datamodel.odemetry: " + str(self.ros_topics_typ_datamodel.odemetry.value))
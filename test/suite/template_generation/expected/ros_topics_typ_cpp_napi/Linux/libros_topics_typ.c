@@ -23,7 +23,7 @@ The code generated is NOT yet fully formatted to ones normal liking. There are m
 #include <stdint.h>
 #include <exos_api.h>
 #include <exos_log.h>
-#include "exos_ros_topics_typ_datamodel.h"
+#include "exos_ros_topics_typ.h"
 #include <uv.h>
 #include <unistd.h>
 #include <string.h>
@@ -47,6 +47,7 @@ typedef struct
     napi_threadsafe_function onchange_cb;
     napi_threadsafe_function connectiononchange_cb;
     napi_threadsafe_function onprocessed_cb; //used only for datamodel
+    napi_threadsafe_function syncchange_cb;  //used only for datamodel
     napi_value object_value; //volatile placeholder.
     napi_value value;        //volatile placeholder.
 } obj_handles;
@@ -73,6 +74,9 @@ obj_handles odemetry = {};
 obj_handles twist = {};
 obj_handles config = {};
 
+static uint32_t ros_topics_typ_datamodel_sync_changes = 0;
+static int32_t ros_topics_typ_datamodel_sync_changed_nettime = 0;
+
 napi_deferred deferred = NULL;
 uv_idle_t cyclic_h;
 
@@ -216,6 +220,16 @@ static void datamodelEvent(exos_datamodel_handle_t *datamodel, const EXOS_DATAMO
         }
         break;
     case EXOS_DATAMODEL_EVENT_SYNC_STATE_CHANGED:
+        INFO("application ros_topics_typ sync state changed to %s, missed DMR cycles: %u, missed AR cycles: %u", datamodel->sync_info.in_sync ? "in sync" : "out of sync", datamodel->sync_info.missed_dmr_cycles, datamodel->sync_info.missed_ar_cycles);
+        ros_topics_typ_datamodel_sync_changes++;
+        ros_topics_typ_datamodel_sync_changed_nettime = exos_datamodel_get_nettime(datamodel);
+
+        if (ros_topics_typ_datamodel.syncchange_cb != NULL)
+        {
+            napi_acquire_threadsafe_function(ros_topics_typ_datamodel.syncchange_cb);
+            napi_call_threadsafe_function(ros_topics_typ_datamodel.syncchange_cb, NULL, napi_tsfn_blocking);
+            napi_release_threadsafe_function(ros_topics_typ_datamodel.syncchange_cb, napi_tsfn_release);
+        }
         break;
 
     default:
@@ -338,6 +352,23 @@ static void ros_topics_typ_datamodel_connonchange_js_cb(napi_env env, napi_value
         throw_fatal_exception_callbacks(env, "EINVAL", "Can't call onConnectionChange callback - ros_topics_typ_datamodel");
 }
 
+static void ros_topics_typ_datamodel_syncchange_js_cb(napi_env env, napi_value js_cb, void *context, void *data)
+{
+    napi_value in_sync, undefined;
+
+    napi_get_undefined(env, &undefined);
+    napi_get_boolean(env, ros_topics_typ_datamodel_datamodel.sync_info.in_sync, &in_sync);
+
+    if (napi_ok != napi_get_reference_value(env, ros_topics_typ_datamodel.ref, &ros_topics_typ_datamodel.object_value))
+        napi_throw_error(env, "EINVAL", "Can't get reference - ros_topics_typ_datamodel ");
+
+    if (napi_ok != napi_set_named_property(env, ros_topics_typ_datamodel.object_value, "isInSync", in_sync))
+        napi_throw_error(env, "EINVAL", "Can't set isInSync property - ros_topics_typ_datamodel");
+
+    if (napi_ok != napi_call_function(env, undefined, js_cb, 0, NULL, NULL))
+        throw_fatal_exception_callbacks(env, "EINVAL", "Can't call onSyncChange callback - ros_topics_typ_datamodel");
+}
+
 static void ros_topics_typ_datamodel_onprocessed_js_cb(napi_env env, napi_value js_cb, void *context, void *data)
 {
     napi_value undefined;
@@ -574,6 +605,11 @@ static napi_value ros_topics_typ_datamodel_connonchange_init(napi_env env, napi_
     return init_napi_onchange(env, info, "ros_topics_typ connection change", ros_topics_typ_datamodel_connonchange_js_cb, &ros_topics_typ_datamodel.connectiononchange_cb);
 }
 
+static napi_value ros_topics_typ_datamodel_syncchange_init(napi_env env, napi_callback_info info)
+{
+    return init_napi_onchange(env, info, "ros_topics_typ sync change", ros_topics_typ_datamodel_syncchange_js_cb, &ros_topics_typ_datamodel.syncchange_cb);
+}
+
 static napi_value ros_topics_typ_datamodel_onprocessed_init(napi_env env, napi_callback_info info)
 {
     return init_napi_onchange(env, info, "ros_topics_typ onProcessed", ros_topics_typ_datamodel_onprocessed_js_cb, &ros_topics_typ_datamodel.onprocessed_cb);
@@ -886,6 +922,30 @@ static void cyclic(uv_idle_t * handle)
     exos_log_process(&logger);
 }
 
+//read sync diagnostics for DataModel
+static napi_value get_sync_info(napi_env env, napi_callback_info info)
+{
+    napi_value syncInfo, value;
+
+    if (napi_ok != napi_create_object(env, &syncInfo))
+        return NULL;
+
+    napi_get_boolean(env, ros_topics_typ_datamodel_datamodel.sync_info.in_sync, &value);
+    napi_set_named_property(env, syncInfo, "inSync", value);
+    napi_create_uint32(env, ros_topics_typ_datamodel_datamodel.sync_info.missed_dmr_cycles, &value);
+    napi_set_named_property(env, syncInfo, "missedDmrCycles", value);
+    napi_create_uint32(env, ros_topics_typ_datamodel_datamodel.sync_info.missed_ar_cycles, &value);
+    napi_set_named_property(env, syncInfo, "missedArCycles", value);
+    napi_create_string_utf8(env, ros_topics_typ_datamodel_datamodel.sync_info.process_mode == EXOS_DATAMODEL_PROCESS_NON_BLOCKING ? "NonBlocking" : "Blocking", NAPI_AUTO_LENGTH, &value);
+    napi_set_named_property(env, syncInfo, "processMode", value);
+    napi_create_uint32(env, ros_topics_typ_datamodel_sync_changes, &value);
+    napi_set_named_property(env, syncInfo, "syncChanges", value);
+    napi_create_int32(env, ros_topics_typ_datamodel_sync_changed_nettime, &value);
+    napi_set_named_property(env, syncInfo, "syncChangedNettime", value);
+
+    return syncInfo;
+}
+
 //read nettime for DataModel
 static napi_value get_net_time(napi_env env, napi_callback_info info)
 {
@@ -904,12 +964,12 @@ static napi_value get_net_time(napi_env env, napi_callback_info info)
 // init of module, called at "require"
 static napi_value init_ros_topics_typ_datamodel(napi_env env, napi_value exports)
 {
-    napi_value ros_topics_typ_datamodel_conn_change, ros_topics_typ_datamodel_onprocessed, odemetry_conn_change, twist_conn_change, config_conn_change;
+    napi_value ros_topics_typ_datamodel_conn_change, ros_topics_typ_datamodel_sync_change, ros_topics_typ_datamodel_onprocessed, odemetry_conn_change, twist_conn_change, config_conn_change;
     napi_value odemetry_onchange;
     napi_value twist_publish, config_publish;
     napi_value odemetry_value, twist_value, config_value;
 
-    napi_value dataModel, getNetTime, undefined, def_bool, def_number, def_string;
+    napi_value dataModel, getNetTime, getSyncInfo, undefined, def_bool, def_number, def_string;
     napi_value log, logError, logWarning, logSuccess, logInfo, logDebug, logVerbose;
     napi_value object0, object1, object2, object3;
 
@@ -1053,6 +1113,11 @@ for (uint32_t j = 0; j < (sizeof(exos_data.odemetry.twist.covariance)/sizeof(exo
     napi_set_named_property(env, ros_topics_typ_datamodel.value, "connectionState", def_string);
     napi_set_named_property(env, ros_topics_typ_datamodel.value, "isConnected", def_bool);
     napi_set_named_property(env, ros_topics_typ_datamodel.value, "isOperational", def_bool);
+    napi_create_function(env, NULL, 0, ros_topics_typ_datamodel_syncchange_init, NULL, &ros_topics_typ_datamodel_sync_change); 
+    napi_set_named_property(env, ros_topics_typ_datamodel.value, "onSyncChange", ros_topics_typ_datamodel_sync_change); 
+    napi_set_named_property(env, ros_topics_typ_datamodel.value, "isInSync", def_bool);
+    napi_create_function(env, NULL, 0, get_sync_info, NULL, &getSyncInfo);
+    napi_set_named_property(env, ros_topics_typ_datamodel.value, "syncInfo", getSyncInfo);
     napi_create_function(env, NULL, 0, ros_topics_typ_datamodel_onprocessed_init, NULL, &ros_topics_typ_datamodel_onprocessed); 
     napi_set_named_property(env, ros_topics_typ_datamodel.value, "onProcessed", ros_topics_typ_datamodel_onprocessed); 
     napi_create_function(env, NULL, 0, get_net_time, NULL, &getNetTime);
@@ -1128,7 +1193,7 @@ for (uint32_t j = 0; j < (sizeof(exos_data.odemetry.twist.covariance)/sizeof(exo
 
     INFO("ros_topics_typ starting!")
     // exOS register datamodel
-    if (EXOS_ERROR_OK != exos_datamodel_connect_ros_topics_typ_datamodel(&ros_topics_typ_datamodel_datamodel, datamodelEvent)) 
+    if (EXOS_ERROR_OK != exos_datamodel_connect_ros_topics_typ(&ros_topics_typ_datamodel_datamodel, datamodelEvent)) 
     {
         napi_throw_error(env, "EINVAL", "Can't connect ros_topics_typ"); 
     } 
@@ -107,12 +107,23 @@
  * @property {ros_topics_typDatamodelLogMethod} debug
  * @property {ros_topics_typDatamodelLogMethod} verbose
  * 
+ * @typedef {Object} ros_topics_typSyncInfo
+ * @property {boolean} inSync datamodel is in sync with the DMR
+ * @property {number} missedDmrCycles cycles missed by the DMR
+ * @property {number} missedArCycles cycles missed by AR
+ * @property {string} processMode `Blocking`|`NonBlocking`
+ * @property {number} syncChanges number of sync state changes
+ * @property {number} syncChangedNettime nettime of the last sync state change
+ * 
  * @typedef {Object} ros_topics_typ
  * @property {function():number} nettime get current nettime
  * @property {ros_topics_typDataModelCallback} onConnectionChange event fired when `connectionState` changes 
  * @property {string} connectionState `Connected`|`Operational`|`Disconnected`|`Aborted` - used in the `onConnectionChange` event
  * @property {boolean} isConnected
  * @property {boolean} isOperational
+ * @property {ros_topics_typDataModelCallback} onSyncChange event fired when the sync state to the DMR changes
+ * @property {boolean} isInSync true if the datamodel is in sync with the DMR - used in the `onSyncChange` event
+ * @property {function():ros_topics_typSyncInfo} syncInfo get the current sync diagnostics
  * @property {ros_topics_typDatamodelLog} log
  * @property {ros_topics_typDatamodel} datamodel
  * 
@@ -132,10 +143,17 @@ state change events:
     ros_topics_typ_datamodel.onConnectionChange(() => {
         ros_topics_typ_datamodel.connectionState : (string) "Connected", "Operational", "Disconnected" or "Aborted" 
     })
+    ros_topics_typ_datamodel.onSyncChange(() => {
+        ros_topics_typ_datamodel.isInSync : (bool) datamodel is in sync with the DMR
+    })
 
 boolean values:
     ros_topics_typ_datamodel.isConnected
     ros_topics_typ_datamodel.isOperational
+    ros_topics_typ_datamodel.isInSync
+
+sync diagnostics:
+    ros_topics_typ_datamodel.syncInfo() : {inSync, missedDmrCycles, missedArCycles, processMode, syncChanges, syncChangedNettime}
 
 logging methods:
     ros_topics_typ_datamodel.log.error(string)
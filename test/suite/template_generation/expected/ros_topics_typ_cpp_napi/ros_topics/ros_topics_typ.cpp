@@ -16,11 +16,26 @@ void(void) user lambda callback:
     ros_topics_typ_datamodel->onConnectionChange([&] () {
         // ros_topics_typ_datamodel->connectionState ...
     })
+    ros_topics_typ_datamodel->onSyncChange([&] () {
+        // ros_topics_typ_datamodel->syncInfo().inSync ...
+    })
 
 boolean values:
     ros_topics_typ_datamodel->isConnected
     ros_topics_typ_datamodel->isOperational
 
+sync diagnostics (updated in process() and before onSyncChange):
+    ros_topics_typ_datamodel->syncInfo().inSync : (bool) datamodel is in sync with the DMR
+    ros_topics_typ_datamodel->syncInfo().missedDmrCycles : (uint32_t) cycles missed by the DMR
+    ros_topics_typ_datamodel->syncInfo().missedArCycles : (uint32_t) cycles missed by AR
+    ros_topics_typ_datamodel->syncInfo().processMode : (EXOS_DATAMODEL_PROCESS_MODE) current process mode
+    ros_topics_typ_datamodel->syncInfo().syncChanges : (uint32_t) number of sync state changes
+    ros_topics_typ_datamodel->syncInfo().syncChangedNettime : (int32_t) nettime of the last sync state change
+
+publish on modify (datasets changed with modify() are published once in the next process(), if their value changed):
+    ros_topics_typ_datamodel->publishStats().published : (uint32_t) modified datasets published by process()
+    ros_topics_typ_datamodel->publishStats().suppressed : (uint32_t) modified datasets not published, as their value equals the last published value
+
 logging methods:
     ros_topics_typ_datamodel->log.error << "some value:" << 1 << std::endl;
     ros_topics_typ_datamodel->log.warning << "some value:" << 1 << std::endl;
@@ -29,8 +44,15 @@ logging methods:
     ros_topics_typ_datamodel->log.debug << "some value:" << 1 << std::endl;
     ros_topics_typ_datamodel->log.verbose << "some value:" << 1 << std::endl;
 
+type reflection:
+    exos_reflection::for_each_member(ros_topics_typ_datamodel-><dataset>.value, [&] (const exos_reflection::MemberInfo &member, auto &field) {
+        // member.name, member.offset, member.arraySize ...
+    })
+
 dataset odemetry:
     ros_topics_typ_datamodel->odemetry.publish()
+    ros_topics_typ_datamodel->odemetry.modify() : value for writing, published once in the next process() if it changed
+        (compared with the last published value, writes to value itself are not tracked)
     ros_topics_typ_datamodel->odemetry.value : (ros_topic_odemety_typ)  actual dataset values
 
 dataset twist:
@@ -113,6 +135,10 @@ _BUR_PUBLIC void ros_topics_typCyclic(struct ros_topics_typCyclic *inst)
 
     inst->Connected = ros_topics_typ_datamodel->isConnected;
     inst->Operational = ros_topics_typ_datamodel->isOperational;
+    inst->InSync = ros_topics_typ_datamodel->syncInfo().inSync;
+    inst->MissedDmrCycles = ros_topics_typ_datamodel->syncInfo().missedDmrCycles;
+    inst->MissedArCycles = ros_topics_typ_datamodel->syncInfo().missedArCycles;
+    inst->SyncChanges = ros_topics_typ_datamodel->syncInfo().syncChanges;
 }
 
 _BUR_PUBLIC void ros_topics_typExit(struct ros_topics_typExit *inst)
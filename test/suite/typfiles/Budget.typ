@@ -0,0 +1,14 @@
+
+TYPE
+	BudgetConfig_typ : 	STRUCT 
+		Gain : LREAL;
+		Name : STRING[80];
+	END_STRUCT;
+	Budget : 	STRUCT 
+		Setpoints : ARRAY[0..99]OF LREAL; (*PUB*)
+		Status : UDINT; (*PUB*)
+		Samples : ARRAY[0..99]OF LREAL; (*PUB*)
+		Commands : ARRAY[0..49]OF DINT; (*SUB*)
+		Config : BudgetConfig_typ; (*PUB SUB*)
+	END_STRUCT;
+END_TYPE
@@ -0,0 +1,12 @@
+
+TYPE
+	Pose_typ : 	STRUCT 
+		X : LREAL;
+		Y : LREAL;
+	END_STRUCT;
+	Odometry : 	STRUCT 
+		Pose : Pose_typ; (*PUB GROUP=Odom*)
+		Twist : LREAL; (*PUB GROUP=Odom*)
+		Stamp : UDINT; (*PUB GROUP=Odom*)
+	END_STRUCT;
+END_TYPE
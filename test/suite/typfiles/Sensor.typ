@@ -0,0 +1,7 @@
+TYPE
+	Sensor : 	STRUCT 
+		Level : LREAL; (*PUB RATE=10ms DEADBAND=0.5 PRIO=HIGH*)
+		Counter : UDINT; (*PUB*)
+		Feedback : LREAL; (*SUB RATE=5ms LATEST DEADBAND=1*)
+	END_STRUCT;
+END_TYPE